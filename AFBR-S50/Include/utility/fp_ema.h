@@ -169,13 +169,13 @@ inline int32_t int_ema32(int32_t mean, int32_t x, uq0_8_t weight)
     if (weight == 0) return x;
     if (x > mean)
     {
-        const uint32_t dx = x - mean;
+        const uint32_t dx = (uint32_t)x - (uint32_t)mean;
         const uint32_t diff = fp_mulu(weight, dx, 8U);
         return mean + diff;
     }
     else
     {
-        const uint32_t dx = mean - x;
+        const uint32_t dx = (uint32_t)mean - (uint32_t)x;
         const uint32_t diff = fp_mulu(weight, dx, 8U);
         return mean - diff;
     }
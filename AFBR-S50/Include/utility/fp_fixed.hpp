@@ -0,0 +1,463 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides constexpr C++ fixed point types for the Qx.y formats.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FP_FIXED_HPP
+#define FP_FIXED_HPP
+
+/*!***************************************************************************
+ * @defgroup    fp_fixed C++ Fixed Point Types
+ * @ingroup     argus_fp
+ *
+ * @brief       Type safe C++ wrappers of the fixed point formats.
+ *
+ * @details     The #argus::fixed template represents a fixed point number
+ *              with IntBits integer bits, FracBits fractional bits and an
+ *              optional sign bit. Its only member is the raw integer value of
+ *              the corresponding C type, e.g. #argus::q9_22 wraps a #q9_22_t
+ *              and #argus::uq1_15 a #uq1_15_t. An alias is provided for each
+ *              format in fp_def.h and the raw value converts one-to-one by
+ *              #argus::fixed::raw and #argus::fixed::from_raw.
+ *
+ *              The shift counts of the multiplications, divisions and
+ *              conversions are derived from the formats at compile time:
+ *              @code
+ *              // C:   q9_22_t y = fp_muls(gain, x, 15);   (gain in UQ1.15)
+ *              argus::q9_22 y = argus::fixed_mul<argus::q9_22>(gain, x);
+ *              @endcode
+ *              Invalid combinations, e.g. a product that needs a negative
+ *              shift or a 32-bit unsigned operand of a signed product, are
+ *              rejected by static assertions.
+ *
+ *              All functions are constexpr (C++14). At run time they call
+ *              the C helpers (#fp_mulu, #fp_muls, #fp_div16, #fp_rndu and
+ *              #fp_rnds) with constant shift counts, i.e. the generated code
+ *              is identical to the hand-written C code and the configuration
+ *              of the helpers (#USE_64BIT_MUL, #USE_HW_DIV) applies. In
+ *              constant expressions, e.g. for the initialization of constexpr
+ *              coefficients, equivalent mirrors of the helpers are evaluated
+ *              by the compiler. This requires __builtin_is_constant_evaluated
+ *              (GCC 9, Clang 9 or newer); the mirrors are used at run time
+ *              too otherwise.
+ *
+ *              Like the C code, the additions and conversions wrap around on
+ *              overflows of the integer part; only #argus::fixed::from_double
+ *              saturates.
+ *
+ * @addtogroup  fp_fixed
+ * @{
+ *****************************************************************************/
+
+#include "utility/fp_def.h"
+#include "utility/fp_div.h"
+#include "utility/fp_mul.h"
+#include "utility/fp_rnd.h"
+
+#include <stdint.h>
+#include <type_traits>
+
+namespace argus
+{
+
+template <unsigned IntBits, unsigned FracBits, bool Signed> class fixed;
+
+template <class R, unsigned IA, unsigned FA, bool SA, unsigned IB, unsigned FB, bool SB>
+constexpr R fixed_mul(fixed<IA, FA, SA> a, fixed<IB, FB, SB> b) noexcept;
+
+namespace detail
+{
+
+/*! Determines whether the function is evaluated in a constant expression. */
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+#else
+    return true;
+#endif
+}
+
+/*! The raw integer type of a fixed point format. */
+template <unsigned Bits, bool Signed> struct fixed_storage
+{
+    static_assert(Bits == 8 || Bits == 16 || Bits == 32,
+                  "fixed point formats need 8, 16 or 32 bits incl. the sign bit");
+};
+template <> struct fixed_storage<8, false>  { using type = uint8_t; };
+template <> struct fixed_storage<8, true>   { using type = int8_t; };
+template <> struct fixed_storage<16, false> { using type = uint16_t; };
+template <> struct fixed_storage<16, true>  { using type = int16_t; };
+template <> struct fixed_storage<32, false> { using type = uint32_t; };
+template <> struct fixed_storage<32, true>  { using type = int32_t; };
+
+/*! Determines whether a type is an instance of #argus::fixed. */
+template <class T> struct is_fixed : std::false_type {};
+template <unsigned I, unsigned F, bool S> struct is_fixed<fixed<I, F, S>> : std::true_type {};
+
+/*! The constant expression mirror of #fp_rndu. */
+constexpr uint32_t rndu(uint32_t q, unsigned n) noexcept
+{
+    return n == 0 ? q : n > 32U ? 0 : ((q >> (n - 1U)) >> 1U) + ((q >> (n - 1U)) & 1U);
+}
+
+/*! The constant expression mirror of #fp_rnds. */
+constexpr int32_t rnds(int32_t q, unsigned n) noexcept
+{
+    return q < 0 ? (int32_t)(0U - rndu(0U - (uint32_t)q, n)) : (int32_t)rndu((uint32_t)q, n);
+}
+
+/*! The constant expression mirror of #fp_mulu; shift in [1, 32]. */
+constexpr uint32_t mulu(uint32_t u, uint32_t v, unsigned shift) noexcept
+{
+    return (uint32_t)((((uint64_t)u * v) >> shift) + ((((uint64_t)u * v) >> (shift - 1U)) & 1U));
+}
+
+/*! The constant expression mirror of #fp_muls; shift in [1, 32]. */
+constexpr int32_t muls(int32_t u, int32_t v, unsigned shift) noexcept
+{
+    return ((u < 0) != (v < 0))
+        ? (int32_t)(0U - mulu(u < 0 ? 0U - (uint32_t)u : (uint32_t)u,
+                              v < 0 ? 0U - (uint32_t)v : (uint32_t)v, shift))
+        : (int32_t)mulu(u < 0 ? 0U - (uint32_t)u : (uint32_t)u,
+                        v < 0 ? 0U - (uint32_t)v : (uint32_t)v, shift);
+}
+
+/*! The constant expression mirror of #fp_div16; a quotient of exactly
+ *  +2^31 saturates at INT32_MAX like with #USE_HW_DIV. */
+constexpr int32_t div16(int32_t a, int32_t b) noexcept
+{
+    if (b == 0) return a < 0 ? INT32_MIN : INT32_MAX;
+    const uint64_t ua = a < 0 ? 0U - (uint64_t)(int64_t)a : (uint64_t)a;
+    const uint64_t ub = b < 0 ? 0U - (uint64_t)(int64_t)b : (uint64_t)b;
+    const uint64_t q = (((ua << 30U) / ub) + (1U << 13U)) >> 14U;
+    if ((a < 0) != (b < 0)) return q >= 0x80000000U ? INT32_MIN : (int32_t)(0U - (uint32_t)q);
+    return q > (uint64_t)INT32_MAX ? INT32_MAX : (int32_t)q;
+}
+
+/* The helpers; the C functions at run time, the mirrors otherwise. */
+constexpr uint32_t fp_rndu(uint32_t q, unsigned n) noexcept
+{
+    return is_constant_evaluated() ? rndu(q, n) : ::fp_rndu(q, (uint_fast8_t)n);
+}
+constexpr int32_t fp_rnds(int32_t q, unsigned n) noexcept
+{
+    return is_constant_evaluated() ? rnds(q, n) : ::fp_rnds(q, (uint_fast8_t)n);
+}
+constexpr uint32_t fp_mulu(uint32_t u, uint32_t v, unsigned shift) noexcept
+{
+    return is_constant_evaluated() ? mulu(u, v, shift) : ::fp_mulu(u, v, (uint_fast8_t)shift);
+}
+constexpr int32_t fp_muls(int32_t u, int32_t v, unsigned shift) noexcept
+{
+    return is_constant_evaluated() ? muls(u, v, shift) : ::fp_muls(u, v, (uint_fast8_t)shift);
+}
+constexpr int32_t fp_div16(int32_t a, int32_t b) noexcept
+{
+    return is_constant_evaluated() ? div16(a, b) : ::fp_div16(a, b);
+}
+
+} // namespace detail
+
+/*!***************************************************************************
+ * @brief   A fixed point number in the (U)QIntBits.FracBits format.
+ *
+ * @tparam  IntBits The number of integer bits w/o the sign bit.
+ * @tparam  FracBits The number of fractional bits.
+ * @tparam  Signed Determines whether the format has a sign bit; the total
+ *          number of bits must be 8, 16 or 32.
+ *****************************************************************************/
+template <unsigned IntBits, unsigned FracBits, bool Signed>
+class fixed
+{
+public:
+    /*! The raw integer type, i.e. the C type of the format. */
+    using value_type = typename detail::fixed_storage<IntBits + FracBits + Signed, Signed>::type;
+
+    /*! The number of integer bits w/o the sign bit. */
+    static constexpr unsigned int_bits = IntBits;
+
+    /*! The number of fractional bits. */
+    static constexpr unsigned frac_bits = FracBits;
+
+    /*! Determines whether the format has a sign bit. */
+    static constexpr bool is_signed = Signed;
+
+    /*! Creates a zero value. */
+    constexpr fixed() noexcept : value_(0) {}
+
+    /*! Creates a value from the raw integer of the C type. */
+    static constexpr fixed from_raw(value_type raw) noexcept
+    {
+        return fixed(raw, 0);
+    }
+
+    /*! Creates a value from an integer; the integer part is not saturated. */
+    static constexpr fixed from_int(int32_t i) noexcept
+    {
+        return fixed((value_type)((uint32_t)i << FracBits), 0);
+    }
+
+    /*! Creates a value from a floating point number, typically a constant;
+     *  rounded half away from zero and saturated at #min and #max. */
+    static constexpr fixed from_double(double x) noexcept
+    {
+        return fixed(round_saturate(x * (double)(1ULL << FracBits)), 0);
+    }
+
+    /*! The minimum value. */
+    static constexpr fixed min() noexcept
+    {
+        return fixed(Signed ? (value_type)(~(uint32_t)0 << (IntBits + FracBits)) : 0, 0);
+    }
+
+    /*! The maximum value. */
+    static constexpr fixed max() noexcept
+    {
+        return fixed((value_type)~min().value_, 0);
+    }
+
+    /*! The value 1; requires at least one integer bit. */
+    static constexpr fixed one() noexcept
+    {
+        static_assert(IntBits > 0, "the format cannot represent 1");
+        return fixed((value_type)(1U << FracBits), 0);
+    }
+
+    /*! The raw integer value of the C type. */
+    constexpr value_type raw() const noexcept { return value_; }
+
+    /*! Converts to a floating point number, e.g. for printing. */
+    constexpr double to_double() const noexcept
+    {
+        return (double)value_ / (double)(1ULL << FracBits);
+    }
+
+    constexpr fixed & operator+=(fixed b) noexcept { return *this = *this + b; }
+    constexpr fixed & operator-=(fixed b) noexcept { return *this = *this - b; }
+    constexpr fixed & operator*=(fixed b) noexcept { return *this = *this * b; }
+
+    friend constexpr fixed operator+(fixed a, fixed b) noexcept
+    {
+        return fixed((value_type)((uint32_t)a.value_ + (uint32_t)b.value_), 0);
+    }
+
+    friend constexpr fixed operator-(fixed a, fixed b) noexcept
+    {
+        return fixed((value_type)((uint32_t)a.value_ - (uint32_t)b.value_), 0);
+    }
+
+    friend constexpr fixed operator-(fixed a) noexcept
+    {
+        static_assert(Signed, "the negation of an unsigned format");
+        return fixed((value_type)(0U - (uint32_t)a.value_), 0);
+    }
+
+    /*! The product in the same format, see #argus::fixed_mul. */
+    friend constexpr fixed operator*(fixed a, fixed b) noexcept
+    {
+        return fixed_mul<fixed>(a, b);
+    }
+
+    friend constexpr bool operator==(fixed a, fixed b) noexcept { return a.value_ == b.value_; }
+    friend constexpr bool operator!=(fixed a, fixed b) noexcept { return a.value_ != b.value_; }
+    friend constexpr bool operator<(fixed a, fixed b) noexcept { return a.value_ < b.value_; }
+    friend constexpr bool operator<=(fixed a, fixed b) noexcept { return a.value_ <= b.value_; }
+    friend constexpr bool operator>(fixed a, fixed b) noexcept { return a.value_ > b.value_; }
+    friend constexpr bool operator>=(fixed a, fixed b) noexcept { return a.value_ >= b.value_; }
+
+private:
+    constexpr fixed(value_type raw, int) noexcept : value_(raw) {}
+
+    static constexpr value_type round_saturate(double x) noexcept
+    {
+        return x >= (double)max().value_ ? max().value_
+             : x <= (double)min().value_ ? min().value_
+             : (value_type)(int64_t)(x < 0 ? x - 0.5 : x + 0.5);
+    }
+
+    /*! The raw integer value. */
+    value_type value_;
+};
+
+/*!***************************************************************************
+ * @brief   Multiplies two fixed point numbers.
+ *
+ * @details Evaluates #fp_mulu (both operands unsigned) or #fp_muls with a
+ *          shift of a::frac_bits + b::frac_bits - R::frac_bits, i.e. the
+ *          product is rounded half up (unsigned) or half away from zero
+ *          (signed). The shift must be within [1, 32]. An unsigned operand
+ *          of a signed product must have less than 32 bits.
+ *
+ * @tparam  R The result format.
+ * @param   a The first factor.
+ * @param   b The second factor.
+ * @return  The product a * b in the format R.
+ *****************************************************************************/
+template <class R, unsigned IA, unsigned FA, bool SA, unsigned IB, unsigned FB, bool SB>
+constexpr R fixed_mul(fixed<IA, FA, SA> a, fixed<IB, FB, SB> b) noexcept
+{
+    static_assert(detail::is_fixed<R>::value, "the result must be a fixed point type");
+    static_assert(FA + FB > R::frac_bits && FA + FB - R::frac_bits <= 32U,
+                  "the product needs a shift within [1, 32]");
+    static_assert(!(SA || SB) || ((SA || IA + FA < 32U) && (SB || IB + FB < 32U)),
+                  "an unsigned 32-bit operand does not fit into a signed product");
+
+    using value_type = typename R::value_type;
+    return R::from_raw((SA || SB)
+        ? (value_type)detail::fp_muls((int32_t)a.raw(), (int32_t)b.raw(), FA + FB - R::frac_bits)
+        : (value_type)detail::fp_mulu(a.raw(), b.raw(), FA + FB - R::frac_bits));
+}
+
+/*!***************************************************************************
+ * @brief   Divides two fixed point numbers.
+ *
+ * @details Evaluates #fp_div16, i.e. the quotient is rounded half away from
+ *          zero and saturated; a division by zero yields #min or #max
+ *          depending on the sign of a. The formats must be signed 32-bit
+ *          formats and fulfill R::frac_bits + b::frac_bits - a::frac_bits
+ *          = 16; e.g. a and R in the same format and b in Q15.16 (see the
+ *          operator /), or a and b in the same format and R in Q15.16.
+ *
+ * @tparam  R The result format.
+ * @param   a The numerator.
+ * @param   b The denominator.
+ * @return  The quotient a / b in the format R.
+ *****************************************************************************/
+template <class R, unsigned IA, unsigned FA, bool SA, unsigned IB, unsigned FB, bool SB>
+constexpr R fixed_div(fixed<IA, FA, SA> a, fixed<IB, FB, SB> b) noexcept
+{
+    static_assert(detail::is_fixed<R>::value, "the result must be a fixed point type");
+    static_assert(SA && SB && R::is_signed && IA + FA == 31U && IB + FB == 31U
+                  && R::int_bits + R::frac_bits == 31U,
+                  "fp_div16 requires signed 32-bit formats");
+    static_assert(R::frac_bits + FB == FA + 16U,
+                  "fp_div16 requires R::frac_bits + b::frac_bits - a::frac_bits = 16");
+
+    return R::from_raw(detail::fp_div16(a.raw(), b.raw()));
+}
+
+/*! Divides a signed 32-bit fixed point number by a Q15.16 number; the
+ *  quotient has the format of the numerator, see #argus::fixed_div. */
+template <unsigned I, unsigned F>
+constexpr fixed<I, F, true> operator/(fixed<I, F, true> a, fixed<15, 16, true> b) noexcept
+{
+    return fixed_div<fixed<I, F, true>>(a, b);
+}
+
+/*!***************************************************************************
+ * @brief   Converts a fixed point number into another format.
+ *
+ * @details Adds fractional bits by a left shift or removes them by #fp_rndu
+ *          (unsigned source) or #fp_rnds (signed source). The integer part
+ *          is not saturated; it wraps around like the C conversions.
+ *
+ * @tparam  R The result format.
+ * @param   x The value to be converted.
+ * @return  The value in the format R.
+ *****************************************************************************/
+template <class R, unsigned I, unsigned F, bool S>
+constexpr R fixed_cast(fixed<I, F, S> x) noexcept
+{
+    static_assert(detail::is_fixed<R>::value, "the result must be a fixed point type");
+
+    using value_type = typename R::value_type;
+    return R::from_raw((R::frac_bits >= F)
+        ? (value_type)((uint32_t)(int32_t)x.raw() << (R::frac_bits >= F ? R::frac_bits - F : 0))
+        : S ? (value_type)detail::fp_rnds((int32_t)x.raw(), F - R::frac_bits)
+            : (value_type)detail::fp_rndu((uint32_t)x.raw(), F - R::frac_bits));
+}
+
+/* The formats of fp_def.h. */
+using uq6_2   = fixed<6, 2, false>;    /*!< C type: #uq6_2_t */
+using uq4_4   = fixed<4, 4, false>;    /*!< C type: #uq4_4_t */
+using uq2_6   = fixed<2, 6, false>;    /*!< C type: #uq2_6_t */
+using uq1_7   = fixed<1, 7, false>;    /*!< C type: #uq1_7_t */
+using uq0_8   = fixed<0, 8, false>;    /*!< C type: #uq0_8_t */
+using q3_4    = fixed<3, 4, true>;     /*!< C type: #q3_4_t */
+using q1_6    = fixed<1, 6, true>;     /*!< C type: #q1_6_t */
+using uq12_4  = fixed<12, 4, false>;   /*!< C type: #uq12_4_t */
+using uq10_6  = fixed<10, 6, false>;   /*!< C type: #uq10_6_t */
+using uq1_15  = fixed<1, 15, false>;   /*!< C type: #uq1_15_t */
+using uq0_16  = fixed<0, 16, false>;   /*!< C type: #uq0_16_t */
+using q11_4   = fixed<11, 4, true>;    /*!< C type: #q11_4_t */
+using q7_8    = fixed<7, 8, true>;     /*!< C type: #q7_8_t */
+using q3_12   = fixed<3, 12, true>;    /*!< C type: #q3_12_t */
+using q0_15   = fixed<0, 15, true>;    /*!< C type: #q0_15_t */
+using uq28_4  = fixed<28, 4, false>;   /*!< C type: #uq28_4_t */
+using uq16_16 = fixed<16, 16, false>;  /*!< C type: #uq16_16_t */
+using uq10_22 = fixed<10, 22, false>;  /*!< C type: #uq10_22_t */
+using q27_4   = fixed<27, 4, true>;    /*!< C type: #q27_4_t */
+using q16_15  = fixed<16, 15, true>;   /*!< C type: #q16_15_t */
+using q15_16  = fixed<15, 16, true>;   /*!< C type: #q15_16_t */
+using q9_22   = fixed<9, 22, true>;    /*!< C type: #q9_22_t */
+
+static_assert(std::is_same<uq6_2::value_type, ::uq6_2_t>::value, "");
+static_assert(std::is_same<uq4_4::value_type, ::uq4_4_t>::value, "");
+static_assert(std::is_same<uq2_6::value_type, ::uq2_6_t>::value, "");
+static_assert(std::is_same<uq1_7::value_type, ::uq1_7_t>::value, "");
+static_assert(std::is_same<uq0_8::value_type, ::uq0_8_t>::value, "");
+static_assert(std::is_same<q3_4::value_type, ::q3_4_t>::value, "");
+static_assert(std::is_same<q1_6::value_type, ::q1_6_t>::value, "");
+static_assert(std::is_same<uq12_4::value_type, ::uq12_4_t>::value, "");
+static_assert(std::is_same<uq10_6::value_type, ::uq10_6_t>::value, "");
+static_assert(std::is_same<uq1_15::value_type, ::uq1_15_t>::value, "");
+static_assert(std::is_same<uq0_16::value_type, ::uq0_16_t>::value, "");
+static_assert(std::is_same<q11_4::value_type, ::q11_4_t>::value, "");
+static_assert(std::is_same<q7_8::value_type, ::q7_8_t>::value, "");
+static_assert(std::is_same<q3_12::value_type, ::q3_12_t>::value, "");
+static_assert(std::is_same<q0_15::value_type, ::q0_15_t>::value, "");
+static_assert(std::is_same<uq28_4::value_type, ::uq28_4_t>::value, "");
+static_assert(std::is_same<uq16_16::value_type, ::uq16_16_t>::value, "");
+static_assert(std::is_same<uq10_22::value_type, ::uq10_22_t>::value, "");
+static_assert(std::is_same<q27_4::value_type, ::q27_4_t>::value, "");
+static_assert(std::is_same<q16_15::value_type, ::q16_15_t>::value, "");
+static_assert(std::is_same<q15_16::value_type, ::q15_16_t>::value, "");
+static_assert(std::is_same<q9_22::value_type, ::q9_22_t>::value, "");
+
+static_assert(sizeof(q9_22) == sizeof(::q9_22_t), "no overhead in size");
+static_assert(std::is_trivially_copyable<q9_22>::value, "");
+static_assert(q15_16::one().raw() == Q15_16_ONE && q9_22::max().raw() == Q9_22_MAX
+              && q15_16::min().raw() == Q15_16_MIN && uq16_16::max().raw() == UQ16_16_MAX, "");
+
+} // namespace argus
+
+/*! @} */
+#endif /* FP_FIXED_HPP */
@@ -81,6 +81,7 @@ static status_t ReadEEPROM(s2pi_slave_t slave, uint8_t * eeprom);
 static status_t ReadRcoTrim(s2pi_slave_t slave, int8_t * RcoTrim);
 static status_t RunMeasurement(s2pi_slave_t slave, uint16_t samples);
 static status_t RunPITTest(uint32_t exp_dt_us, uint32_t n);
+static status_t RunPITMultiTest(uint32_t const * exp_dt_us, uint32_t count, uint32_t n);
 
 static void PIT_Callback(void * param);
 static void GPIO_Callback(void * param);
@@ -1205,6 +1206,9 @@ static status_t GpioModeTest(s2pi_slave_t slave)
     uint8_t eeprom2[16] = { 0 };
     uint8_t eeprom3[16] = { 0 };
 
+    ltc_t start;
+    Time_GetNow(&start);
+
     status_t status = ReadEEPROM(slave, eeprom1);
     if (status != STATUS_OK)
     {
@@ -1226,6 +1230,8 @@ static status_t GpioModeTest(s2pi_slave_t slave)
         return status;
     }
 
+    const uint32_t elapsed_usec = Time_GetElapsedUSec(&start) / 3U;
+
     /* Verify EEPROM data. */
     if ((memcmp(eeprom1, eeprom2, 16) != 0) ||
         (memcmp(eeprom1, eeprom3, 16) != 0))
@@ -1249,6 +1255,7 @@ static status_t GpioModeTest(s2pi_slave_t slave)
     print("EEPROM Readout succeeded!\n");
     print("- Module: %d\n", module);
     print("- Device ID: %d\n", chipID);
+    print("- Readout Time: %d us\n", elapsed_usec);
 
     return STATUS_OK;
 }
@@ -1522,6 +1529,12 @@ typedef struct pit_data_t
     /*! The time stamp of the last callback event. */
     ltc_t t_last;
 
+    /*! The minimum interval between two consecutive callback events. */
+    uint32_t dt_min;
+
+    /*! The maximum interval between two consecutive callback events. */
+    uint32_t dt_max;
+
 } pit_data_t;
 
 /*!***************************************************************************
@@ -1530,8 +1543,9 @@ typedef struct pit_data_t
  * @details The function that is invoked every time a specified interval elapses.
  *          An abstract parameter is passed to the function whenever it is called.
  *
- *          This implementation collects callback time stamps and counts the
- *          number of callback events using the abstract parameter.
+ *          This implementation collects callback time stamps, the minimum
+ *          and maximum interval between two events and counts the number of
+ *          callback events using the abstract parameter.
  *
  * @param   param An abstract parameter to be passed to the callback. This is
  *                  also the identifier of the given interval.
@@ -1553,7 +1567,14 @@ static void PIT_Callback(void * param)
         }
         else
         {
-            Time_GetNow(&data->t_last);
+            ltc_t t_now;
+            Time_GetNow(&t_now);
+
+            const uint32_t dt = Time_DiffUSec(&data->t_last, &t_now);
+            if (data->n == 1 || dt < data->dt_min) data->dt_min = dt;
+            if (data->n == 1 || dt > data->dt_max) data->dt_max = dt;
+
+            data->t_last = t_now;
         }
 
         data->n++;
@@ -1637,15 +1658,14 @@ static status_t RunPITTest(uint32_t exp_dt_us, uint32_t n)
         }
     }
 
-    if (status == STATUS_OK)
+    /* Disable the PIT timer callback in any case; the interval is identified
+     * by the stack-local data and must not outlive this function. */
+    const status_t s = Timer_SetInterval(0, &data);
+    if (s != STATUS_OK)
     {
-        /* Disable the PIT timer callback. */
-        status = Timer_SetInterval(0, &data);
-        if (status != STATUS_OK)
-        {
-            error_log("PIT test failed!\n"
-                      "Timer_SetInterval returned status code: %d", status);
-        }
+        error_log("PIT test failed!\n"
+                  "Timer_SetInterval returned status code: %d", s);
+        if (status == STATUS_OK) status = s;
     }
 
     if (status == STATUS_OK)
@@ -1693,6 +1713,134 @@ static status_t RunPITTest(uint32_t exp_dt_us, uint32_t n)
     return status;
 }
 
+/*!***************************************************************************
+ * @brief   Executes a PIT measurement with multiple concurrent intervals.
+ *
+ * @details The function configures the PIT with several intervals at the same
+ *          time, each identified by an individual callback parameter, and
+ *          waits until each interval has seen a given number of callback
+ *          events. The average interval of each is verified against the
+ *          expectations and the jitter, i.e. the minimum and maximum time
+ *          between two consecutive events, is reported.
+ *
+ *          Note that the AFBR-S50 API requires as many concurrent intervals
+ *          as devices are used.
+ *
+ * @param   exp_dt_us The array of expected timer intervals in microseconds.
+ * @param   count The number of concurrent intervals (max. 4).
+ * @param   n The number of PIT events to await for each interval.
+ *
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_FAIL if the measured intervals do not match the
+ *            expectations.
+ *          - #ERROR_TIMEOUT if either the PIT events do not occur within the
+ *            expected time.
+ *          - The PIT layer error code if #Timer_SetInterval return any
+ *            negative status.
+ *****************************************************************************/
+static status_t RunPITMultiTest(uint32_t const * exp_dt_us, uint32_t count, uint32_t n)
+{
+    /* Test parameter configuration: *****************************************/
+    const float rel_dt_error = 5e-3f; // Relative timer interval tolerance: 0.5 %.
+    const float abs_dt_error = 5.0f;  // Absolute timer interval tolerance: 5.0 us.
+    /*************************************************************************/
+    assert(count <= 4);
+
+    print("Run PIT Test (w/ %d concurrent intervals):\n", count);
+
+    pit_data_t data[4] = { { 0 } };
+    uint32_t max_exp_dt_us = 0;
+    status_t status = STATUS_OK;
+
+    /* Setup the PIT callbacks with specified intervals. */
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (exp_dt_us[i] > max_exp_dt_us) max_exp_dt_us = exp_dt_us[i];
+
+        status = Timer_SetInterval(exp_dt_us[i], &data[i]);
+        if (status != STATUS_OK)
+        {
+            error_log("PIT test failed!\n"
+                      "Timer_SetInterval returned status code: %d "
+                      "for interval #%d", status, i);
+            count = i;
+            break;
+        }
+    }
+
+    /* Wait until n PIT callback have been happened for all intervals. */
+    const uint32_t timeout_us = (n + 1) * max_exp_dt_us;
+
+    ltc_t start;
+    Time_GetNow(&start);
+    for (uint32_t i = 0; i < count && status == STATUS_OK; ++i)
+    {
+        while (data[i].n < n)
+        {
+            if (Time_CheckTimeoutUSec(&start, timeout_us))
+            {
+                error_log("PIT test failed!\n"
+                          "Waiting for the PIT interrupt events yielded a timeout.\n"
+                          "Timeout: %d us; Interval #%d: %d of %d events.",
+                          timeout_us, i, data[i].n, n);
+                status = ERROR_TIMEOUT;
+                break;
+            }
+        }
+    }
+
+    /* Disable all PIT timer callbacks. */
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const status_t s = Timer_SetInterval(0, &data[i]);
+        if (s != STATUS_OK)
+        {
+            error_log("PIT test failed!\n"
+                      "Timer_SetInterval returned status code: %d", s);
+            if (status == STATUS_OK) status = s;
+        }
+    }
+
+    if (status != STATUS_OK) return status;
+
+    /* Verify the measured average timer intervals and report the jitter. */
+    print("+---+----------+--------+---------+---------+---------+--------+\n");
+    print("| # | expected | events |    mean |     min |     max | jitter |\n");
+    print("+---+----------+--------+---------+---------+---------+--------+\n");
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float dt = (float) exp_dt_us[i] * rel_dt_error;
+        if (dt < abs_dt_error) dt = abs_dt_error;
+        const float max_dt = (float) exp_dt_us[i] + dt;
+        const float min_dt = (float) exp_dt_us[i] - dt;
+
+        const uint32_t events = data[i].n;
+        const float act_dt_us = (float) Time_DiffUSec(&data[i].t_first, &data[i].t_last)
+                              / (float) (events - 1);
+
+        print("| %d | %8d | %6d | %7d | %7d | %7d | %6d |\n",
+              i, exp_dt_us[i], events, (int)act_dt_us, data[i].dt_min,
+              data[i].dt_max, data[i].dt_max - data[i].dt_min);
+
+        if (status == STATUS_OK && (act_dt_us > max_dt || act_dt_us < min_dt))
+        {
+            status = ERROR_FAIL;
+        }
+    }
+    print("+---+----------+--------+---------+---------+---------+--------+\n");
+
+    if (status != STATUS_OK)
+    {
+        error_log("PIT test failed!\n"
+                  "The measured timer intervals do not match the expected values!");
+    }
+
+    print(" - test status: %d\n\n", status);
+
+    return status;
+}
+
 /*!***************************************************************************
  * @brief   Test for PIT HAL Implementation by comparing timings to the device.
  *
@@ -1753,6 +1901,30 @@ static status_t PITTest(void)
         }
     }
 
+    /* Multiple Interval Test with 2 and 4 concurrent intervals. If this fails,
+     * just print a message that multi-device setups might have issues. */
+    static const uint32_t multi_dt_us[] = { 5000, 7000, 11000, 13000 };
+    status = RunPITMultiTest(multi_dt_us, 2, 50);
+    if (status != STATUS_OK)
+    {
+        print("WARNING: PIT test failed for 2 concurrent intervals!\n"
+              "         This is only critical if multiple devices are\n"
+              "         operated. Otherwise, the error can be safely ignored.\n");
+        status = STATUS_IGNORE; // ignore
+    }
+
+    if (status == STATUS_OK) // only run if previous test succeeded!
+    {
+        status = RunPITMultiTest(multi_dt_us, 4, 50);
+        if (status != STATUS_OK)
+        {
+            print("WARNING: PIT test failed for 4 concurrent intervals!\n"
+                  "         This is only critical if more than 2 devices are\n"
+                  "         operated. Otherwise, the error can be safely ignored.\n");
+            status = STATUS_IGNORE; // ignore
+        }
+    }
+
     status = Timer_SetCallback(0);
     if (status != STATUS_OK)
     {
@@ -2212,6 +2384,8 @@ static status_t SpiTransferFromPitInterrupt(s2pi_slave_t slave)
             error_log("SPI transfer from PIT interrupt test failed:\n"
                       "The IRQ callback was not invoked within %d ms.",
                       timeout_ms);
+            Timer_SetInterval(0, &data);
+            Timer_SetCallback(0);
             return ERROR_TIMEOUT;
         }
     }
@@ -2308,4 +2482,647 @@ static status_t SpiTransferFromInterruptTest(s2pi_slave_t slave)
     return STATUS_OK;
 }
 
+/*******************************************************************************
+ * HAL Benchmark
+ ******************************************************************************/
+
+/*! The number of samples per benchmark run. */
+#ifndef HAL_BENCH_SAMPLES
+#define HAL_BENCH_SAMPLES 2000U
+#endif
+
+/*! The number of histogram bins of the benchmark report. */
+#define HAL_BENCH_HIST_BINS 16U
+
+/*! The width of the histogram bars in characters. */
+#define HAL_BENCH_HIST_WIDTH 40U
+
+/*! The PIT interval of the timer jitter benchmark in microseconds. */
+#define HAL_BENCH_PIT_INTERVAL_US 1000U
+
+/*! The PIT interval of the synthetic SPI load in microseconds. */
+#define HAL_BENCH_LOAD_INTERVAL_US 250U
+
+/*!***************************************************************************
+ * @brief   Data structure for a single benchmark run.
+ *****************************************************************************/
+typedef struct bench_run_t
+{
+    /*! The number of recorded samples. */
+    volatile uint32_t Count;
+
+    /*! The number of PIT events. */
+    volatile uint32_t Events;
+
+    /*! The expected PIT interval in clock ticks. */
+    uint32_t Expected;
+
+    /*! The timestamp of the last PIT event or GPIO callback in clock ticks. */
+    volatile uint64_t Last;
+
+    /*! The samples in clock ticks. */
+    uint32_t * Samples;
+
+} bench_run_t;
+
+/*!***************************************************************************
+ * @brief   Data structure for the synthetic UART and SPI load.
+ *****************************************************************************/
+typedef struct bench_load_t
+{
+    /*! The S2PI slave parameter passed to the S2PI HAL functions. */
+    s2pi_slave_t Slave;
+
+    /*! Enables the SPI transfers from the PIT callback. */
+    volatile bool Enabled;
+
+    /*! The number of SPI transfers started. */
+    volatile uint32_t Transfers;
+
+    /*! The SPI data buffer; writes the (cleared) laser pattern register. */
+    uint8_t Data[17U];
+
+} bench_load_t;
+
+/*!***************************************************************************
+ * @brief   Data structure for the SPI transfer benchmark.
+ *****************************************************************************/
+typedef struct bench_spi_t
+{
+    /*! Set by the SPI callback. */
+    volatile bool Done;
+
+    /*! The status passed to the SPI callback. */
+    volatile status_t Status;
+
+    /*! The timestamp of the SPI callback in clock ticks. */
+    volatile uint64_t End;
+
+} bench_spi_t;
+
+/*! The clock for the benchmark timestamps. */
+static argus_hal_bench_clock_t myBenchClock = NULL;
+
+/*! The frequency of the benchmark clock in Hz. */
+static uint32_t myBenchFrequency = 1000000U;
+
+/*! The synthetic load state. */
+static bench_load_t myBenchLoad;
+
+/*! The benchmark samples; static in order to keep them off the stack. */
+static uint32_t myBenchSamples[HAL_BENCH_SAMPLES];
+
+/*!***************************************************************************
+ * @brief   The default benchmark clock: the lifetime counter in microseconds.
+ *****************************************************************************/
+static uint64_t BenchClock_LTC(void)
+{
+    uint32_t hct = 0, lct = 0;
+    Timer_GetCounterValue(&hct, &lct);
+    return (uint64_t)hct * 1000000U + lct;
+}
+
+/*!***************************************************************************
+ * @brief   Converts benchmark clock ticks to nanoseconds.
+ *****************************************************************************/
+static uint32_t BenchTicksToNSec(uint32_t ticks)
+{
+    const uint64_t nsec = ((uint64_t)ticks * 1000000000U) / myBenchFrequency;
+    return nsec > UINT32_MAX ? UINT32_MAX : (uint32_t)nsec;
+}
+
+/*!***************************************************************************
+ * @brief   SPI callback of the synthetic load; does nothing.
+ *****************************************************************************/
+static status_t BenchLoad_SpiCallback(status_t status, void * param)
+{
+    (void)status;
+    (void)param;
+    return STATUS_OK;
+}
+
+/*!***************************************************************************
+ * @brief   Generates the SPI load; called from the PIT callback.
+ *
+ * @details Starts a 17 byte transfer to the laser pattern register unless the
+ *          previous one is still ongoing. The register is written with zeros,
+ *          i.e. with the same value as left by the #SpiConnectionTest.
+ *****************************************************************************/
+static void BenchLoad_Tick(void)
+{
+    if (!myBenchLoad.Enabled) return;
+    if (S2PI_GetStatus(myBenchLoad.Slave) != STATUS_IDLE) return;
+
+    for (uint8_t i = 1; i < 17U; ++i) myBenchLoad.Data[i] = 0;
+    myBenchLoad.Data[0] = 0x04; // Laser Pattern Register Address
+
+    if (S2PI_TransferFrame(myBenchLoad.Slave, myBenchLoad.Data, myBenchLoad.Data,
+                           sizeof(myBenchLoad.Data), BenchLoad_SpiCallback, NULL) == STATUS_OK)
+    {
+        myBenchLoad.Transfers++;
+    }
+}
+
+/*!***************************************************************************
+ * @brief   Generates the UART load from the thread level.
+ *
+ * @details Prints a progress line that is overwritten by the next one. The
+ *          print implementations wait for the previous transfer to finish,
+ *          i.e. the UART is kept busy continuously.
+ *****************************************************************************/
+static void BenchLoad_Print(uint32_t count)
+{
+    print("\r   load: %5d samples, %5d SPI transfers .......................\r",
+          count, myBenchLoad.Transfers);
+}
+
+/*!***************************************************************************
+ * @brief   Disables the SPI load and waits for the ongoing transfer.
+ *****************************************************************************/
+static status_t BenchLoad_Pause(void)
+{
+    myBenchLoad.Enabled = false;
+
+    ltc_t start;
+    Time_GetNow(&start);
+    while (S2PI_GetStatus(myBenchLoad.Slave) == STATUS_BUSY)
+    {
+        if (Time_CheckTimeoutMSec(&start, 100))
+        {
+            error_log("HAL benchmark failed! The SPI load transfer did not "
+                      "finish within 100 ms.");
+            return ERROR_TIMEOUT;
+        }
+    }
+    return STATUS_OK;
+}
+
+/*!***************************************************************************
+ * @brief   The PIT callback of the HAL benchmark.
+ *
+ * @details Dispatches the synthetic load interval and records the deviation
+ *          of the benchmark interval from its expected value.
+ *
+ * @param   param The #bench_load_t or #bench_run_t the interval belongs to.
+ *****************************************************************************/
+static void BenchPIT_Callback(void * param)
+{
+    const uint64_t now = myBenchClock();
+
+    if (param == &myBenchLoad)
+    {
+        BenchLoad_Tick();
+        return;
+    }
+
+    bench_run_t * run = (bench_run_t*)param;
+    if (run->Events++ > 0 && run->Count < HAL_BENCH_SAMPLES)
+    {
+        const uint32_t dt = (uint32_t)(now - run->Last);
+        run->Samples[run->Count++] = dt > run->Expected ? dt - run->Expected
+                                                        : run->Expected - dt;
+    }
+    run->Last = now;
+}
+
+/*!***************************************************************************
+ * @brief   The GPIO callback of the HAL benchmark; records the timestamp.
+ *****************************************************************************/
+static void BenchGPIO_Callback(void * param)
+{
+    bench_run_t * run = (bench_run_t*)param;
+    run->Last = myBenchClock();
+    run->Events++;
+}
+
+/*!***************************************************************************
+ * @brief   Sorts the benchmark samples in ascending order (shell sort).
+ *****************************************************************************/
+static void BenchSort(uint32_t * samples, uint32_t count)
+{
+    for (uint32_t gap = count / 2; gap > 0; gap /= 2)
+    {
+        for (uint32_t i = gap; i < count; ++i)
+        {
+            const uint32_t v = samples[i];
+            uint32_t j = i;
+            for (; j >= gap && samples[j - gap] > v; j -= gap)
+                samples[j] = samples[j - gap];
+            samples[j] = v;
+        }
+    }
+}
+
+/*!***************************************************************************
+ * @brief   Prints the statistics and histogram of a benchmark run.
+ *
+ * @param   run The benchmark run with the recorded samples.
+ *****************************************************************************/
+static void BenchReport(bench_run_t * run)
+{
+    const uint32_t n = run->Count;
+    if (n == 0)
+    {
+        print("   no samples recorded!\n\n");
+        return;
+    }
+
+    BenchSort(run->Samples, n);
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < n; ++i) sum += run->Samples[i];
+
+    const uint32_t min = run->Samples[0];
+    const uint32_t max = run->Samples[n - 1];
+    const uint32_t p99 = run->Samples[(n * 99U + 99U) / 100U - 1U];
+
+    print("   samples: %d, clock resolution: %d ns\n",
+          n, BenchTicksToNSec(1) > 0 ? BenchTicksToNSec(1) : 1);
+    print("   min: %d ns, mean: %d ns, p99: %d ns, max: %d ns\n",
+          BenchTicksToNSec(min), BenchTicksToNSec((uint32_t)(sum / n)),
+          BenchTicksToNSec(p99), BenchTicksToNSec(max));
+
+    uint32_t hist[HAL_BENCH_HIST_BINS] = { 0 };
+    const uint32_t width = (max - min) / HAL_BENCH_HIST_BINS + 1U;
+    uint32_t peak = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const uint32_t bin = (run->Samples[i] - min) / width;
+        if (++hist[bin] > peak) peak = hist[bin];
+    }
+
+    for (uint32_t b = 0; b < HAL_BENCH_HIST_BINS; ++b)
+    {
+        const uint32_t lo = min + b * width;
+        if (lo > max) break;
+
+        char bar[HAL_BENCH_HIST_WIDTH + 1U];
+        uint32_t len = (uint32_t)(((uint64_t)hist[b] * HAL_BENCH_HIST_WIDTH + peak - 1U) / peak);
+        for (uint32_t i = 0; i < len; ++i) bar[i] = '#';
+        bar[len] = '\0';
+
+        print("   %9d .. %9d ns | %5d | %s\n", BenchTicksToNSec(lo),
+              BenchTicksToNSec(lo + width - 1U), hist[b], bar);
+    }
+    print("\n");
+}
+
+/*!***************************************************************************
+ * @brief   Benchmarks the jitter of the periodic interrupt timer.
+ *
+ * @details Records the deviation of #HAL_BENCH_SAMPLES consecutive PIT
+ *          intervals from the expected interval of #HAL_BENCH_PIT_INTERVAL_US.
+ *          The load interval runs concurrently on the PIT if enabled.
+ *
+ * @param   load Enables the synthetic UART and SPI load.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+static status_t BenchPIT(bool load)
+{
+    bench_run_t run = { .Samples = myBenchSamples };
+    run.Expected = (uint32_t)(((uint64_t)HAL_BENCH_PIT_INTERVAL_US * myBenchFrequency) / 1000000U);
+
+    print("   PIT interval jitter: %d us interval, %s\n",
+          HAL_BENCH_PIT_INTERVAL_US, load ? "UART + SPI load" : "idle");
+
+    myBenchLoad.Enabled = load;
+    status_t status = load ? Timer_SetInterval(HAL_BENCH_LOAD_INTERVAL_US, &myBenchLoad) : STATUS_OK;
+    if (status == STATUS_OK) status = Timer_SetInterval(HAL_BENCH_PIT_INTERVAL_US, &run);
+    if (status != STATUS_OK)
+    {
+        error_log("HAL benchmark failed! Timer_SetInterval returned "
+                  "status code: %d", status);
+    }
+
+    const uint32_t timeout_ms = 2U * HAL_BENCH_SAMPLES * HAL_BENCH_PIT_INTERVAL_US / 1000U + 100U;
+    ltc_t start;
+    Time_GetNow(&start);
+    while (status == STATUS_OK && run.Count < HAL_BENCH_SAMPLES)
+    {
+        if (load) BenchLoad_Print(run.Count);
+        if (Time_CheckTimeoutMSec(&start, timeout_ms))
+        {
+            error_log("HAL benchmark failed! Only %d of %d PIT events "
+                      "occurred within %d ms.", run.Count, HAL_BENCH_SAMPLES, timeout_ms);
+            status = ERROR_TIMEOUT;
+        }
+    }
+
+    Timer_SetInterval(0, &run);
+    Timer_SetInterval(0, &myBenchLoad);
+    const status_t s = BenchLoad_Pause();
+    if (status == STATUS_OK) status = s;
+    if (load) print("\n");
+
+    if (status == STATUS_OK) BenchReport(&run);
+    return status;
+}
+
+/*!***************************************************************************
+ * @brief   Benchmarks the latency from the GPIO interrupt to its callback.
+ *
+ * @details Triggers #HAL_BENCH_SAMPLES single sample measurements on the
+ *          device. For each, the thread polls the IRQ pin via #S2PI_ReadIrqPin
+ *          and keeps the timestamp of the last read that found the pin
+ *          inactive. The latency is the time from that timestamp to the
+ *          timestamp taken in the GPIO callback. Thus, the reported latency
+ *          is an upper bound that is pessimistic by at most a single polling
+ *          loop iteration (see the reported polling period).
+ *
+ *          The SPI load is paused while the measurement is triggered.
+ *
+ * @param   slave The S2PI slave parameter passed to the S2PI HAL functions.
+ * @param   load Enables the synthetic UART and SPI load.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+static status_t BenchGPIO(s2pi_slave_t slave, bool load)
+{
+    /* Test parameter configuration: *****************************************/
+    const uint32_t timeout_ms = 100; // timeout for a single measurement.
+    /*************************************************************************/
+
+    bench_run_t run = { .Samples = myBenchSamples };
+
+    print("   GPIO interrupt latency: %s\n", load ? "UART + SPI load" : "idle");
+
+    status_t status = S2PI_SetIrqCallback(slave, BenchGPIO_Callback, &run);
+    if (status == STATUS_OK && load)
+        status = Timer_SetInterval(HAL_BENCH_LOAD_INTERVAL_US, &myBenchLoad);
+    if (status != STATUS_OK)
+    {
+        error_log("HAL benchmark failed! The setup of the callbacks "
+                  "yielded error code: %d", status);
+    }
+
+    uint64_t pollTime = 0;
+    uint32_t polls = 0;
+
+    while (status == STATUS_OK && run.Count < HAL_BENCH_SAMPLES)
+    {
+        status = BenchLoad_Pause();
+        if (status != STATUS_OK) break;
+
+        const uint32_t events = run.Events;
+        status = TriggerMeasurement(slave, 1, 0, 0);
+        if (status != STATUS_OK) break;
+
+        /* Wait until the trigger has been sent, i.e. the IRQ pin is released. */
+        ltc_t start;
+        Time_GetNow(&start);
+        while (S2PI_GetStatus(slave) == STATUS_BUSY || S2PI_ReadIrqPin(slave) == 0)
+        {
+            if (Time_CheckTimeoutMSec(&start, timeout_ms))
+            {
+                error_log("HAL benchmark failed! The IRQ pin was not released "
+                          "within %d ms.", timeout_ms);
+                status = ERROR_TIMEOUT;
+                break;
+            }
+        }
+        if (status != STATUS_OK) break;
+
+        myBenchLoad.Enabled = load;
+        if (load && (run.Count & 0x0FU) == 0) BenchLoad_Print(run.Count);
+
+        /* Poll the IRQ pin until the callback has been invoked. */
+        const uint64_t pollStart = myBenchClock();
+        uint64_t inactive = pollStart;
+        uint32_t n = 0;
+        while (run.Events == events)
+        {
+            const uint64_t now = myBenchClock();
+            if (S2PI_ReadIrqPin(slave)) inactive = now;
+            ++n;
+
+            if (Time_CheckTimeoutMSec(&start, timeout_ms))
+            {
+                error_log("HAL benchmark failed! The GPIO callback was not "
+                          "invoked within %d ms.", timeout_ms);
+                status = ERROR_TIMEOUT;
+                break;
+            }
+        }
+        if (status != STATUS_OK) break;
+
+        pollTime += run.Last - pollStart;
+        polls += n;
+        run.Samples[run.Count++] = run.Last > inactive ? (uint32_t)(run.Last - inactive) : 0;
+    }
+
+    Timer_SetInterval(0, &myBenchLoad);
+    const status_t s = BenchLoad_Pause();
+    if (status == STATUS_OK) status = s;
+    S2PI_SetIrqCallback(slave, 0, 0);
+    if (load) print("\n");
+
+    if (status == STATUS_OK)
+    {
+        print("   polling period: %d ns\n",
+              BenchTicksToNSec(polls ? (uint32_t)(pollTime / polls) : 0));
+        BenchReport(&run);
+    }
+    return status;
+}
+
+/*!***************************************************************************
+ * @brief   The SPI callback of the transfer benchmark; records the timestamp.
+ *****************************************************************************/
+static status_t BenchSPI_Callback(status_t status, void * param)
+{
+    bench_spi_t * spi = (bench_spi_t*)param;
+    spi->End = myBenchClock();
+    spi->Status = status;
+    spi->Done = true;
+    return STATUS_OK;
+}
+
+/*!***************************************************************************
+ * @brief   Spins until the SPI callback has been invoked.
+ *
+ * @details The number of loop iterations measures the CPU time that is left
+ *          to the thread, i.e. is not consumed by interrupt service routines.
+ *
+ * @param   spi The transfer to wait for.
+ * @param   timeout The timeout in clock ticks.
+ *
+ * @return  Returns the number of loop iterations.
+ *****************************************************************************/
+static uint32_t BenchSPI_Spin(bench_spi_t * spi, uint32_t timeout)
+{
+    const uint64_t start = myBenchClock();
+    uint32_t n = 0;
+    while (!spi->Done)
+    {
+        ++n;
+        if ((uint32_t)(myBenchClock() - start) > timeout) break;
+    }
+    return n;
+}
+
+/*!***************************************************************************
+ * @brief   Benchmarks the setup time and the CPU time of SPI transfers.
+ *
+ * @details Starts #HAL_BENCH_SAMPLES consecutive 17 byte transfers to the
+ *          laser pattern register (the register is written with zeros, see
+ *          #BenchLoad_Tick) and records the time spent in #S2PI_TransferFrame.
+ *          Afterwards, the thread spins until the SPI callback is invoked.
+ *          The spin loop is calibrated without a transfer before, i.e. the
+ *          time that is missing from the spin loop is the time consumed by
+ *          the interrupt service routines of the transfer. The CPU time per
+ *          transfer is the setup time plus the interrupt time.
+ *
+ * @param   slave The S2PI slave parameter passed to the S2PI HAL functions.
+ * @param   rx Enables the receive buffer, i.e. TX/RX or TX only transfers.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+static status_t BenchSPI(s2pi_slave_t slave, bool rx)
+{
+    /* Test parameter configuration: *****************************************/
+    const uint32_t timeout = myBenchFrequency / 100U; // 10 ms per transfer
+    /*************************************************************************/
+
+    bench_run_t run = { .Samples = myBenchSamples };
+    uint8_t data[17U] = { 0x04 }; // Laser Pattern Register Address
+
+    print("   S2PI transfer setup time: %d bytes, %s\n",
+          (int)sizeof(data), rx ? "TX/RX" : "TX only");
+
+    /* Calibrate the spin loop: the clock ticks per iteration w/o transfer. */
+    bench_spi_t spi = { .Done = false };
+    const uint64_t calStart = myBenchClock();
+    const uint32_t calCount = BenchSPI_Spin(&spi, timeout);
+    const uint64_t calTicks = myBenchClock() - calStart;
+
+    status_t status = STATUS_OK;
+    uint64_t cpuSum = 0, busSum = 0;
+    uint32_t cpuMin = UINT32_MAX, cpuMax = 0;
+
+    while (run.Count < HAL_BENCH_SAMPLES)
+    {
+        for (uint8_t i = 1; i < sizeof(data); ++i) data[i] = 0;
+        data[0] = 0x04;
+        spi.Done = false;
+
+        const uint64_t t0 = myBenchClock();
+        status = S2PI_TransferFrame(slave, data, rx ? data : NULL, sizeof(data),
+                                    BenchSPI_Callback, &spi);
+        const uint64_t t1 = myBenchClock();
+        if (status != STATUS_OK)
+        {
+            error_log("HAL benchmark failed! S2PI_TransferFrame returned "
+                      "status code: %d", status);
+            break;
+        }
+
+        const uint32_t n = BenchSPI_Spin(&spi, timeout);
+        const uint64_t t2 = myBenchClock();
+        if (!spi.Done)
+        {
+            error_log("HAL benchmark failed! The SPI callback was not "
+                      "invoked within 10 ms.");
+            status = ERROR_TIMEOUT;
+            break;
+        }
+        if (spi.Status != STATUS_OK)
+        {
+            error_log("HAL benchmark failed! The SPI callback was invoked "
+                      "with status code: %d", spi.Status);
+            status = spi.Status;
+            break;
+        }
+
+        const uint32_t setup = (uint32_t)(t1 - t0);
+        const uint32_t spin = (uint32_t)(t2 - t1);
+        const uint32_t idle = calCount ? (uint32_t)((n * calTicks) / calCount) : 0;
+        const uint32_t cpu = setup + (spin > idle ? spin - idle : 0);
+
+        run.Samples[run.Count++] = setup;
+        cpuSum += cpu;
+        busSum += (uint32_t)(spi.End - t0);
+        if (cpu < cpuMin) cpuMin = cpu;
+        if (cpu > cpuMax) cpuMax = cpu;
+    }
+
+    if (status == STATUS_OK)
+    {
+        print("   CPU time per transfer (setup + interrupts): "
+              "min: %d ns, mean: %d ns, max: %d ns\n",
+              BenchTicksToNSec(cpuMin), BenchTicksToNSec((uint32_t)(cpuSum / run.Count)),
+              BenchTicksToNSec(cpuMax));
+        print("   transfer time (call to callback): mean: %d ns\n",
+              BenchTicksToNSec((uint32_t)(busSum / run.Count)));
+        BenchReport(&run);
+    }
+    return status;
+}
+
+status_t Argus_RunHALBenchmark(s2pi_slave_t spi_slave,
+                               argus_hal_bench_clock_t clock,
+                               uint32_t frequency)
+{
+    myBenchClock = clock != NULL ? clock : BenchClock_LTC;
+    myBenchFrequency = clock != NULL ? frequency : 1000000U;
+    myBenchLoad.Slave = spi_slave;
+    myBenchLoad.Enabled = false;
+    myBenchLoad.Transfers = 0;
+
+    print("########################################################\n");
+    print("#   Running HAL Benchmark - " HAL_TEST_VERSION "\n");
+    print("########################################################\n");
+    print("- SPI Slave: %d \n", spi_slave);
+    print("- Clock: %d Hz\n\n", myBenchFrequency);
+
+    if (myBenchFrequency == 0)
+    {
+        error_log("HAL benchmark failed! Invalid clock frequency: 0 Hz");
+        return ERROR_INVALID_ARGUMENT;
+    }
+
+    status_t status = Timer_SetCallback(BenchPIT_Callback);
+    const bool hasPIT = status != ERROR_NOT_IMPLEMENTED;
+    if (hasPIT && status != STATUS_OK)
+    {
+        error_log("HAL benchmark failed! Timer_SetCallback returned "
+                  "status code: %d", status);
+        return status;
+    }
+
+    print("1 > Periodic Interrupt Timer (PIT) Jitter\n");
+    if (hasPIT)
+    {
+        status = BenchPIT(false);
+        if (status == STATUS_OK) status = BenchPIT(true);
+    }
+    else
+    {
+        print("1 > SKIPPED (PIT is not implemented)\n\n");
+    }
+
+    if (status == STATUS_OK)
+    {
+        print("2 > GPIO Interrupt Latency\n");
+        status = ConfigureDevice(spi_slave, 0);
+        if (status == STATUS_OK) status = BenchGPIO(spi_slave, false);
+        if (status == STATUS_OK && hasPIT) status = BenchGPIO(spi_slave, true);
+    }
+
+    if (status == STATUS_OK)
+    {
+        print("3 > SPI Transfer Setup and CPU Time\n");
+        status = BenchSPI(spi_slave, true);
+        if (status == STATUS_OK) status = BenchSPI(spi_slave, false);
+    }
+
+    if (hasPIT) Timer_SetCallback(0);
+
+    print("########################################################\n");
+    print("#   HAL Benchmark finished with status %d\n", status);
+    print("########################################################\n\n");
+
+    return status;
+}
+
 /*! @} */
@@ -77,9 +77,20 @@
  *              - Added verification of SPI callback invocation.
  *              - Updated GPIO interrupt test to verify if delayed interrupt
  *                pending states can be detected via #S2PI_ReadIrqPin.
+ *          * v1.5:
+ *              - Added PIT test cases with 2 and 4 concurrent intervals that
+ *                report the timer jitter of each interval.
+ *          * v1.6:
+ *              - Added the #Argus_RunHALBenchmark that reports the PIT jitter
+ *                and GPIO interrupt latency distributions with and without
+ *                synthetic UART and SPI load.
+ *              - Added the EEPROM readout time to the GPIO mode test output.
+ *          * v1.7:
+ *              - Added the SPI transfer setup and CPU time benchmark to the
+ *                #Argus_RunHALBenchmark.
  *
  *****************************************************************************/
-#define HAL_TEST_VERSION "v1.4"
+#define HAL_TEST_VERSION "v1.7"
 
 /*!***************************************************************************
  * @brief   Executes a series of tests in order to verify the HAL implementation.
@@ -162,6 +173,9 @@
  *          - Decode the EEPROM (using EEPROM_Decode in argus_cal_eeprom.c).
  *          - Check if Module Number and Chip ID is not 0.
  *
+ *          The average time of a single EEPROM readout is printed in order to
+ *          evaluate the GPIO mode performance of the HAL implementation.
+ *
  *          **7) Timer Test for Lifetime Counter:**
  *
  *          The test verifies the lifetime counter timer HAL implementation by
@@ -184,6 +198,13 @@
  *          is measured. Finally, the measured interval is compared to the
  *          expectations.
  *
+ *          Afterwards, 2 and 4 intervals are started concurrently, each
+ *          with an individual callback parameter, in order to verify the
+ *          multiple interval feature that is required for multi-device
+ *          setups. The minimum and maximum time between two consecutive
+ *          events, i.e. the jitter, is reported for each interval. A failure
+ *          of the concurrent intervals is only reported as a warning.
+ *
  *          Note that this test is only executed if the PIT is actually
  *          implemented. Otherwise, the test is skipped.
  *
@@ -221,5 +242,77 @@
  *****************************************************************************/
 status_t Argus_VerifyHALImplementation(s2pi_slave_t spi_slave);
 
+/*!***************************************************************************
+ * @brief   A clock function for the HAL benchmark timestamps.
+ *
+ * @details Returns a free running, monotonic 64-bit tick count, e.g.
+ *          #HRClock_Now of the hr_clock utility module.
+ *****************************************************************************/
+typedef uint64_t (*argus_hal_bench_clock_t)(void);
+
+/*!***************************************************************************
+ * @brief   Benchmarks the timer jitter and the interrupt latency of the HAL.
+ *
+ * @details In contrast to the pass/fail tests of the
+ *          #Argus_VerifyHALImplementation, this benchmark records the
+ *          distribution of the timing figures that determine the real-time
+ *          behavior of a HAL port and prints it via the print function. The
+ *          benchmark is intended to compare ports, compiler settings and
+ *          interrupt priority configurations against each other.
+ *
+ *          The following benchmarks are executed:
+ *
+ *          **1) Periodic Interrupt Timer Jitter (optional):**
+ *
+ *          A 1 ms interval is started and the deviation of the time between
+ *          two consecutive PIT callbacks from the expected interval is
+ *          recorded. Skipped if the PIT is not implemented.
+ *
+ *          **2) GPIO Interrupt Latency:**
+ *
+ *          The device is setup to run pseudo measurements (see the SPI
+ *          Interrupt Test). The thread polls the IRQ pin via #S2PI_ReadIrqPin
+ *          while waiting for the GPIO callback. The latency is the time from
+ *          the last poll that read the pin as inactive to the timestamp taken
+ *          in the callback. Thus, it is an upper bound that is pessimistic by
+ *          up to a single polling period, which is reported too.
+ *
+ *          **3) SPI Transfer Setup and CPU Time:**
+ *
+ *          Consecutive 17 byte SPI transfers (TX/RX and TX only) are started
+ *          from the thread. The time spent in #S2PI_TransferFrame (setup
+ *          time) is recorded. While waiting for the SPI callback, the thread
+ *          spins in a loop that has been calibrated before; the time missing
+ *          from the loop is the time consumed by the interrupts of the
+ *          transfer. The sum of both is reported as CPU time per transfer.
+ *          Use it to compare different S2PI implementations of a platform,
+ *          e.g. the HAL and the register level (S2PI_LL_DMA) path of the
+ *          STM32F4 port. Only executed idle, i.e. without synthetic load.
+ *
+ *          Each benchmark is executed twice: idle and under a synthetic load
+ *          that consists of a continuous UART output from the thread and a
+ *          17 byte SPI transfer to the device that is started from a 250 µs
+ *          PIT interval (only if the PIT is implemented).
+ *
+ *          For each run, #HAL_BENCH_SAMPLES (default: 2000) samples are
+ *          recorded and the minimum, mean, 99th percentile and maximum are
+ *          printed together with a histogram.
+ *
+ * @note    The device must be connected but not be initialized by the API,
+ *          i.e. call the benchmark before #Argus_Init.
+ *
+ * @param   spi_slave The SPI hardware slave, i.e. the specified CS and IRQ
+ *                    lines. See #Argus_VerifyHALImplementation.
+ * @param   clock The timestamp clock; pass null to use the lifetime counter,
+ *                i.e. microsecond resolution.
+ * @param   frequency The frequency of the timestamp clock in Hz; ignored if
+ *                    no clock is passed.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Argus_RunHALBenchmark(s2pi_slave_t spi_slave,
+                               argus_hal_bench_clock_t clock,
+                               uint32_t frequency);
+
 /*! @} */
 #endif /* ARGUS_HAL_TEST_H */
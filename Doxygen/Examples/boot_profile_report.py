@@ -0,0 +1,300 @@
+# #############################################################################
+# ###     Boot Phase Profile Report for the AFBR-S50 Explorer App           ###
+# #############################################################################
+#
+# Reads the boot phase profile (SCI command 0x0D) from a device running the
+# ExplorerApp and compares the profiles of several builds.
+#
+# Use Python 3 to run the script. The "read" mode requires the pySerial module.
+# To install, run: "pip install pyserial"
+#
+# Usage:
+#
+#   Read the profile of the current (or previous) boot and store it as JSON:
+#     python boot_profile_report.py read COM4 build_a.json [--previous]
+#
+#   Reset the device before reading to obtain a clean boot, e.g. by the
+#   MCU/Software Reset command (0x08) or the reset button. The profile is
+#   complete once the first measurement data frame has been sent, i.e. start
+#   the measurements before reading the profile.
+#
+#   Compare the profiles of several builds; the first is the reference:
+#     python boot_profile_report.py compare build_a.json build_b.json ...
+#
+# #############################################################################
+
+import json
+import struct
+import sys
+
+## The boot phase names, see boot_phase_t in Sources/Utility/boot_profile.h
+PHASES = {
+    1: "Startup",
+    2: "Board",
+    3: "Clocks",
+    4: "Timer",
+    5: "UART",
+    6: "S2PI",
+    7: "Flash",
+    8: "NVM Init",
+    9: "Discovery",
+    10: "Device",
+    11: "Find Device",
+    12: "Argus Init",
+    13: "NVM Read",
+    14: "SCI",
+    15: "Tasks",
+    16: "First Frame",
+}
+
+## SCI Start Byte
+START = 0x02
+## SCI Stop Byte
+STOP = 0x03
+## SCI Escape Byte
+ESC = 0x1B
+## SCI Acknowledge Command
+CMD_ACK = 0x0A
+## SCI Not-Acknowledge Command
+CMD_NAK = 0x0B
+## SCI Software Version Command
+CMD_SOFTWARE_VERSION = 0x0C
+## SCI Boot Profile Command
+CMD_BOOT_PROFILE = 0x0D
+
+
+def crc8(data: bytes):
+    """!
+    Calculates the CRC8 (SAE J1850 ZERO) checksum of the SCI frames.
+    @param data (bytes): The unescaped command and parameter bytes.
+    @return Returns the checksum byte.
+    """
+    crc = 0x00
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1D) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def encode(cmd: int, payload: bytes = b""):
+    """!
+    Composes a SCI frame incl. checksum and byte stuffing.
+    @param cmd (int): The command byte.
+    @param payload (bytes): The parameter bytes.
+    @return Returns the frame to be sent.
+    """
+    data = bytes([cmd]) + payload
+    data += bytes([crc8(data)])
+    tx = bytearray([START])
+    for b in data:
+        if b in (START, STOP, ESC):
+            tx += bytes([ESC, b ^ 0xFF])
+        else:
+            tx.append(b)
+    tx.append(STOP)
+    return bytes(tx)
+
+
+def decode(rx: bytes):
+    """!
+    Removes the byte stuffing from a received SCI frame and verifies the
+    checksum.
+    @param rx (bytes): The received frame incl. start and stop byte.
+    @return Returns the command and parameter bytes w/o checksum.
+    """
+    if len(rx) < 4 or rx[0] != START or rx[-1] != STOP:
+        raise Exception("Invalid data frame received (start or stop byte missing).")
+    data = bytearray()
+    escape = False
+    for b in rx[1:-1]:
+        if escape:
+            data.append(b ^ 0xFF)
+            escape = False
+        elif b == ESC:
+            escape = True
+        else:
+            data.append(b)
+    if crc8(data[:-1]) != data[-1]:
+        raise Exception("Invalid checksum received: " + rx.hex())
+    return bytes(data[:-1])
+
+
+def request(ser, cmd: int, payload: bytes = b""):
+    """!
+    Sends a command and waits for the answer and the acknowledge.
+    @param ser: The opened serial port.
+    @param cmd (int): The command byte.
+    @param payload (bytes): The parameter bytes.
+    @return Returns the parameter bytes of the answer.
+    """
+    ser.write(encode(cmd, payload))
+    answer = None
+    while True:
+        rx = ser.read_until(bytes([STOP]))
+        if len(rx) == 0:
+            raise Exception("No data was read from the RX line.")
+        data = decode(rx)
+        if data[0] == cmd:
+            answer = data[1:]
+        elif data[0] == CMD_ACK and data[1] == cmd:
+            return answer
+        elif data[0] == CMD_NAK and data[1] == cmd:
+            raise Exception("NAK received for command 0x%02X" % cmd)
+
+
+def parse_profile(data: bytes):
+    """!
+    Extracts the boot phase profile from the answer of the 0x0D command.
+    @param data (bytes): The parameter bytes of the answer.
+    @return Returns the profile as dictionary.
+    """
+    select, boot_count, reset_cause, finished, count = struct.unpack_from(">BIIBB", data, 0)
+    offset = 11
+    marks = []
+    for _ in range(count):
+        phase, param, level, start, duration = struct.unpack_from(">BBBII", data, offset)
+        offset += 11
+        marks.append({
+            "phase": phase,
+            "name": PHASES.get(phase, "Phase %d" % phase),
+            "param": param,
+            "level": level & 0x7F,
+            "finished": bool(level & 0x80),
+            "start": start,
+            "duration": duration,
+        })
+    return {
+        "previous": bool(select),
+        "boot_count": boot_count,
+        "reset_cause": reset_cause,
+        "finished": bool(finished),
+        "marks": marks,
+    }
+
+
+def read(port: str, filename: str, previous: bool, label: str = None):
+    """!
+    Reads the boot phase profile from the device and stores it as JSON file.
+    """
+    import serial
+
+    ser = serial.Serial(port, 115200, timeout=1.0)
+    try:
+        ser.reset_input_buffer()
+        version = request(ser, CMD_SOFTWARE_VERSION)
+        profile = parse_profile(request(ser, CMD_BOOT_PROFILE, bytes([1 if previous else 0])))
+    finally:
+        ser.close()
+
+    v = struct.unpack_from(">I", version, 0)[0]
+    profile["version"] = "v%d.%d.%d" % (v >> 24, (v >> 16) & 0xFF, v & 0xFFFF)
+    profile["build"] = version[4:].decode("ascii", "replace")
+    profile["label"] = label if label else profile["version"] + " " + profile["build"]
+
+    with open(filename, "w") as f:
+        json.dump(profile, f, indent=2)
+
+    print_profile(profile)
+
+
+def phase_key(mark):
+    """! The key to match the phases of different builds. """
+    return (mark["name"], mark["param"])
+
+
+def first_frame(profile):
+    """! The time to the first measurement data frame; None if not recorded. """
+    for m in profile["marks"]:
+        if m["phase"] == 16:
+            return m["start"]
+    return None
+
+
+def print_profile(profile):
+    """!
+    Prints a single boot phase profile.
+    """
+    print("%s: boot #%d, reset cause 0x%04X%s" % (
+        profile.get("label", "?"), profile["boot_count"], profile["reset_cause"],
+        "" if profile["finished"] else " (incomplete)"))
+    print("%-28s %12s %12s" % ("Phase", "Start [us]", "Duration [us]"))
+    for m in profile["marks"]:
+        name = "  " * m["level"] + m["name"]
+        if m["param"]:
+            name += " [%d]" % m["param"]
+        duration = "%12d" % m["duration"] if m["finished"] else "%12s" % "-"
+        print("%-28s %12d %s" % (name, m["start"], duration))
+
+
+def compare(filenames):
+    """!
+    Prints the phase durations of several builds side by side incl. the
+    deltas to the first (reference) build.
+    """
+    profiles = []
+    for filename in filenames:
+        with open(filename) as f:
+            profiles.append(json.load(f))
+
+    # Collect the phases in the order of the reference; append the new ones.
+    keys = []
+    for p in profiles:
+        for m in p["marks"]:
+            if phase_key(m) not in keys:
+                keys.append(phase_key(m))
+
+    labels = [p.get("label", fn) for p, fn in zip(profiles, filenames)]
+    header = "%-28s" % "Phase [us]"
+    for i, label in enumerate(labels):
+        header += " %14s" % label[:14]
+        if i > 0:
+            header += " %9s" % "delta"
+    print(header)
+
+    def row(name, values):
+        line = "%-28s" % name
+        ref = values[0]
+        for i, v in enumerate(values):
+            line += " %14s" % ("-" if v is None else v)
+            if i > 0:
+                if v is None or ref is None:
+                    line += " %9s" % "-"
+                else:
+                    line += " %+9d" % (v - ref)
+        print(line)
+
+    for key in keys:
+        values = []
+        level = 0
+        for p in profiles:
+            mark = next((m for m in p["marks"] if phase_key(m) == key), None)
+            if mark is not None:
+                level = mark["level"]
+            if mark is None or not mark["finished"] or mark["phase"] == 16:
+                values.append(None)
+            else:
+                values.append(mark["duration"])
+        if all(v is None for v in values):
+            continue
+        name = "  " * level + key[0] + (" [%d]" % key[1] if key[1] else "")
+        row(name, values)
+
+    row("Time to first frame", [first_frame(p) for p in profiles])
+
+
+if __name__ == "__main__":
+
+    if len(sys.argv) >= 4 and sys.argv[1] == "read":
+        label = None
+        if "--label" in sys.argv:
+            label = sys.argv[sys.argv.index("--label") + 1]
+        read(sys.argv[2], sys.argv[3], "--previous" in sys.argv, label)
+
+    elif len(sys.argv) >= 3 and sys.argv[1] == "compare":
+        compare(sys.argv[2:])
+
+    else:
+        print("usage: boot_profile_report.py read <port> <file.json> [--previous] [--label <name>]")
+        print("       boot_profile_report.py compare <file.json> [<file.json> ...]")
+        sys.exit(1)
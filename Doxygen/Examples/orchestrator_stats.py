@@ -0,0 +1,86 @@
+# #############################################################################
+# ###     Frame Orchestrator Statistics for the AFBR-S50 Explorer App        ###
+# #############################################################################
+#
+# Reads the statistics of the multi-device frame orchestrator (SCI command
+# 0x1A) from a device running the ExplorerApp, e.g. while the measurements
+# are running.
+#
+# Use Python 3 to run the script. It requires the pySerial module.
+# To install, run: "pip install pyserial"
+#
+# Usage:
+#
+#   Print the statistics since the device has joined:
+#     python orchestrator_stats.py COM4
+#
+#   Print the statistics every second; the statistics are reset after each
+#   read, i.e. the values refer to the last interval:
+#     python orchestrator_stats.py COM4 --watch
+#
+# #############################################################################
+
+import struct
+import sys
+import time
+
+from boot_profile_report import request
+
+## SCI Orchestrator Statistics Command
+CMD_ORCHESTRATOR_STATS = 0x1A
+
+## Flag: reset the statistics of all devices after reading.
+FLAG_RESET = 0x01
+
+## Interference flags, see orchestrator_flags_t.
+FLAGS = ((0x01, "busy"), (0x02, "refused"), (0x04, "late"))
+
+
+def parse_stats(data: bytes):
+    """!
+    Extracts the statistics from the answer of the 0x1A command.
+    @param data (bytes): The parameter bytes of the answer.
+    @return Returns the statistics as dictionary.
+    """
+    fields = struct.unpack_from(">BIIIIIIBI", data, 0)
+    keys = ("orchestrated", "phase_us", "period_us", "triggered", "finished",
+            "skipped", "rate_mhz", "flags", "aggregate_mhz")
+    return dict(zip(keys, fields))
+
+
+def print_stats(stats):
+    """!
+    Prints the statistics.
+    """
+    s = stats
+    if not s["orchestrated"]:
+        print("Device is not orchestrated.")
+        return
+
+    flags = [name for mask, name in FLAGS if s["flags"] & mask]
+    print("Slot @ %d/%d us: %d of %d frames, %.3f fps, %d skipped, flags: %s" % (
+        s["phase_us"], s["period_us"], s["finished"], s["triggered"],
+        s["rate_mhz"] / 1000.0, s["skipped"], ", ".join(flags) if flags else "none"))
+    print("  Aggregate frame rate: %.3f fps" % (s["aggregate_mhz"] / 1000.0))
+
+
+if __name__ == "__main__":
+
+    if len(sys.argv) < 2:
+        print("usage: orchestrator_stats.py <port> [--watch]")
+        sys.exit(1)
+
+    import serial
+
+    ser = serial.Serial(sys.argv[1], 115200, timeout=1.0)
+    try:
+        ser.reset_input_buffer()
+        if "--watch" in sys.argv:
+            request(ser, CMD_ORCHESTRATOR_STATS, bytes([FLAG_RESET]))
+            while True:
+                time.sleep(1.0)
+                print_stats(parse_stats(request(ser, CMD_ORCHESTRATOR_STATS, bytes([FLAG_RESET]))))
+        else:
+            print_stats(parse_stats(request(ser, CMD_ORCHESTRATOR_STATS)))
+    finally:
+        ser.close()
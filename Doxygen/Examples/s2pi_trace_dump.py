@@ -0,0 +1,114 @@
+# #############################################################################
+# ###     S2PI Bus Trace Dump for the AFBR-S50 Explorer App                  ###
+# #############################################################################
+#
+# Reads the S2PI bus statistics and the latest recorded S2PI transfers (SCI
+# command 0x09) from a device running the ExplorerApp, e.g. while the
+# measurements are running.
+#
+# Use Python 3 to run the script. It requires the pySerial module.
+# To install, run: "pip install pyserial"
+#
+# Usage:
+#
+#   Print the statistics and the recorded transfers:
+#     python s2pi_trace_dump.py COM4
+#
+#   Print the statistics every second; the statistics are reset after each
+#   read, i.e. the values refer to the last interval:
+#     python s2pi_trace_dump.py COM4 --watch
+#
+# #############################################################################
+
+import struct
+import sys
+import time
+
+from boot_profile_report import request
+
+## SCI S2PI Trace Command
+CMD_S2PI_TRACE = 0x09
+
+## Flag: include the recorded transfers.
+FLAG_RECORDS = 0x01
+## Flag: reset the statistics after reading.
+FLAG_RESET = 0x02
+
+
+def parse_trace(data: bytes):
+    """!
+    Extracts the statistics and records from the answer of the 0x09 command.
+    @param data (bytes): The parameter bytes of the answer.
+    @return Returns the trace as dictionary.
+    """
+    fields = struct.unpack_from(">BIIIIIHIIHHHII", data, 0)
+    keys = ("slave", "observation_ms", "transfers", "bytes", "busy_us",
+            "throughput", "utilization", "frames", "frame_transfers",
+            "per_frame_last", "per_frame_min", "per_frame_max", "errors",
+            "frequency")
+    trace = dict(zip(keys, fields))
+    offset = struct.calcsize(">BIIIIIHIIHHHII")
+    count = data[offset]
+    offset += 1
+    records = []
+    for _ in range(count):
+        slave, status, length, start, duration = struct.unpack_from(">BhHII", data, offset)
+        offset += 13
+        records.append({
+            "slave": slave,
+            "status": status,
+            "length": length,
+            "start": start,
+            "duration": duration,
+        })
+    trace["records"] = records
+    return trace
+
+
+def print_trace(trace):
+    """!
+    Prints the statistics and the recorded transfers.
+    """
+    t = trace
+    print("Slave %d: %d ms observed, %d transfers, %d bytes, %d errors" % (
+        t["slave"], t["observation_ms"], t["transfers"], t["bytes"], t["errors"]))
+    print("  Busy: %d us (%.1f %%), Throughput: %d B/s" % (
+        t["busy_us"], t["utilization"] / 10.0, t["throughput"]))
+    if t["frames"]:
+        print("  Transfers per frame: %.1f avg, %d last, %d min, %d max (%d frames)" % (
+            t["frame_transfers"] / t["frames"], t["per_frame_last"],
+            t["per_frame_min"], t["per_frame_max"], t["frames"]))
+
+    if not t["records"]:
+        return
+
+    # Print relative to the first record; the start times wrap around at 2^32.
+    us = 1e6 / t["frequency"]
+    t0 = t["records"][0]["start"]
+    print("  %6s %5s %6s %12s %10s" % ("Slave", "Size", "Status", "Start [us]", "Time [us]"))
+    for r in t["records"]:
+        start = ((r["start"] - t0) & 0xFFFFFFFF) * us
+        duration = "%10.1f" % (r["duration"] * us) if r["status"] != 1 else "%10s" % "busy"
+        print("  %6d %5d %6d %12.1f %s" % (r["slave"], r["length"], r["status"], start, duration))
+
+
+if __name__ == "__main__":
+
+    if len(sys.argv) < 2:
+        print("usage: s2pi_trace_dump.py <port> [--watch]")
+        sys.exit(1)
+
+    import serial
+
+    ser = serial.Serial(sys.argv[1], 115200, timeout=1.0)
+    try:
+        ser.reset_input_buffer()
+        if "--watch" in sys.argv:
+            request(ser, CMD_S2PI_TRACE, bytes([FLAG_RESET]))
+            while True:
+                time.sleep(1.0)
+                print_trace(parse_trace(request(ser, CMD_S2PI_TRACE, bytes([FLAG_RESET]))))
+        else:
+            print_trace(parse_trace(request(ser, CMD_S2PI_TRACE, bytes([FLAG_RECORDS]))))
+    finally:
+        ser.close()
@@ -27,6 +27,10 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN TD */
+#if S2PI_LL_DMA
+extern void S2PI_DmaRxIRQHandler(void);
+extern void S2PI_DmaTxIRQHandler(void);
+#endif
 extern void USER_UART_IRQHandler(UART_HandleTypeDef *huart);
 
 /* USER CODE END TD */
@@ -267,6 +271,10 @@ void USART2_IRQHandler(void)
 void DMA2_Stream0_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
+#if S2PI_LL_DMA
+  S2PI_DmaRxIRQHandler();
+  return;
+#endif
 
   /* USER CODE END DMA2_Stream0_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi1_rx);
@@ -281,6 +289,10 @@ void DMA2_Stream0_IRQHandler(void)
 void DMA2_Stream3_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream3_IRQn 0 */
+#if S2PI_LL_DMA
+  S2PI_DmaTxIRQHandler();
+  return;
+#endif
 
   /* USER CODE END DMA2_Stream3_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_spi1_tx);
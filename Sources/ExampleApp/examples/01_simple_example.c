@@ -40,10 +40,14 @@
 
 #include "platform/argus_print.h" // declaration of print()
 
-#if RUN_HAL_TESTS
+#if RUN_HAL_TESTS || RUN_HAL_BENCHMARK
 #include "argus_hal_test.h"
 #endif
 
+#if RUN_HAL_BENCHMARK
+#include "hr_clock.h"
+#endif
+
 #if RUN_XTALK_CALIBRATION
 #include "argus_xtalk_cal_cli.h"
 #endif
@@ -211,6 +215,12 @@ void ExampleMain(void)
     HandleError(status, "HAL Implementation verification failed on SPI_SLAVE!");
 #endif // RUN_HAL_TESTS
 
+#if RUN_HAL_BENCHMARK
+    /* Benchmark the timer jitter and interrupt latency of the HAL. */
+    status_t bench = Argus_RunHALBenchmark(SPI_SLAVE, HRClock_Now, HRClock_GetFrequency());
+    HandleError(bench, "HAL benchmark failed on SPI_SLAVE!");
+#endif // RUN_HAL_BENCHMARK
+
     /* Instantiate and initialize the device handlers. */
     argus_hnd_t * device = InitializeDevice(SPI_SLAVE);
 
@@ -40,10 +40,14 @@
 #include "board/board_config.h"    // declaration of S2PI slaves
 #include "platform/argus_print.h"  // declaration of print()
 
-#if RUN_HAL_TESTS
+#if RUN_HAL_TESTS || RUN_HAL_BENCHMARK
 #include "argus_hal_test.h"
 #endif
 
+#if RUN_HAL_BENCHMARK
+#include "hr_clock.h"
+#endif
+
 /*! The number of devices connected/used in the example. Range: 1 to 4. */
 #ifndef DEVICE_COUNT
 #define DEVICE_COUNT 4
@@ -256,6 +260,15 @@ void ExampleMain(void)
     }
 #endif // RUN_HAL_TESTS
 
+#if RUN_HAL_BENCHMARK
+    for (uint8_t d = 0; d < DEVICE_COUNT; d++)
+    {
+        /* Benchmark the timer jitter and interrupt latency of the HAL. */
+        status_t status = Argus_RunHALBenchmark(slaves[d], HRClock_Now, HRClock_GetFrequency());
+        HandleError(status, "HAL benchmark failed!");
+    }
+#endif // RUN_HAL_BENCHMARK
+
     /* Instantiate and initialize the device handlers. */
     argus_hnd_t * devices[DEVICE_COUNT] = { 0 };
 
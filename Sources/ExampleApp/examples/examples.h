@@ -86,6 +86,14 @@
 #define RUN_HAL_TESTS 1
 #endif
 
+/*! Selector for HAL benchmark demo:
+ *  - 0: no HAL benchmark is executed.
+ *  - 1: HAL benchmark (timer jitter and interrupt latency) is executed
+ *       before any API code is executed. */
+#ifndef RUN_HAL_BENCHMARK
+#define RUN_HAL_BENCHMARK 0
+#endif
+
 /*! Selector for XTALK calibration demo:
  *  - 0: no XTALK calibration is executed.
  *  - 1: XTALK calibration is executed before any API code is executed. */
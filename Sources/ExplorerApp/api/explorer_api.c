@@ -41,11 +41,16 @@
 #include "core/core_utils.h"
 #include "core/core_cfg.h"
 #include "core/core_cal.h"
+#include "core/core_orchestrator.h"
 #include "core/explorer_version.h"
 #include "core/explorer_config.h"
 #include "core/explorer_status.h"
 #include "explorer_api.h"
 #include "board/board.h"
+#include "boot_profile.h"
+#include "hr_clock.h"
+#include "s2pi_queue.h"
+#include "s2pi_trace.h"
 #include <assert.h>
 
 /*******************************************************************************
@@ -158,6 +163,147 @@ static status_t TxCmd_SoftwareVersion(sci_device_t deviceID, sci_frame_t * frame
     return STATUS_OK;
 }
 
+static status_t RxCmd_BootProfile(sci_device_t deviceID, sci_frame_t * frame)
+{
+    uint8_t select = 0; // 0: current boot, 1: previous boot
+    if (SCI_Frame_BytesToRead(frame) > 1)
+        select = SCI_Frame_Dequeue08u(frame);
+
+    if (select > 1) return ERROR_SCI_INVALID_CMD_PARAMETER;
+    if (BootProfile_GetRecord(select) == NULL) return ERROR_NOT_INITIALIZED;
+    return SCI_SendCommand(deviceID, CMD_BOOT_PROFILE, select, 0);
+}
+static status_t TxCmd_BootProfile(sci_device_t deviceID, sci_frame_t * frame, sci_param_t param, sci_data_t data)
+{
+    (void)data;
+    (void)deviceID;
+    boot_record_t const * record = BootProfile_GetRecord(param != 0);
+    if (record == NULL) return ERROR_NOT_INITIALIZED;
+
+    SCI_Frame_Queue08u(frame, (uint8_t)param);
+    SCI_Frame_Queue32u(frame, record->BootCount);
+    SCI_Frame_Queue32u(frame, record->ResetCause);
+    SCI_Frame_Queue08u(frame, (uint8_t)record->Finished);
+    SCI_Frame_Queue08u(frame, (uint8_t)record->Count);
+
+    for (uint32_t i = 0; i < record->Count; ++i)
+    {
+        boot_mark_t const * mark = &record->Marks[i];
+        SCI_Frame_Queue08u(frame, mark->Phase);
+        SCI_Frame_Queue08u(frame, mark->Param);
+        SCI_Frame_Queue08u(frame, (uint8_t)(mark->Level | (mark->Finished ? 0x80U : 0U)));
+        SCI_Frame_Queue32u(frame, mark->Start);
+        SCI_Frame_Queue32u(frame, mark->Duration);
+    }
+    return STATUS_OK;
+}
+
+static status_t RxCmd_S2PITrace(sci_device_t deviceID, sci_frame_t * frame)
+{
+    uint8_t flags = 0; // bit 0: include records; bit 1: reset after reading
+    if (SCI_Frame_BytesToRead(frame) > 1)
+        flags = SCI_Frame_Dequeue08u(frame);
+
+    if (flags > 3) return ERROR_SCI_INVALID_CMD_PARAMETER;
+    explorer_t * explorer = ExplorerApp_GetExplorerPtr(deviceID);
+    if (explorer == NULL) return ERROR_EXPLORER_UNINITIALIZED_DEVICE_ADDRESS;
+    return SCI_SendCommand(deviceID, CMD_S2PI_TRACE, flags, 0);
+}
+static status_t TxCmd_S2PITrace(sci_device_t deviceID, sci_frame_t * frame, sci_param_t param, sci_data_t data)
+{
+    (void)data;
+    explorer_t * explorer = ExplorerApp_GetExplorerPtr(deviceID);
+    if (explorer == NULL) return ERROR_EXPLORER_UNINITIALIZED_DEVICE_ADDRESS;
+    const s2pi_slave_t slave = explorer->Configuration.SPISlave;
+
+    s2pi_queue_stats_t bus = { 0 };
+    s2pi_trace_stats_t trace = { 0 };
+    status_t status = S2PIQueue_GetStats(slave, &bus);
+    if (status < STATUS_OK) return status;
+    status = S2PITrace_GetStats(slave, &trace);
+    if (status < STATUS_OK) return status;
+
+    SCI_Frame_Queue08u(frame, (uint8_t)slave);
+    SCI_Frame_Queue32u(frame, bus.ObservationTime);
+    SCI_Frame_Queue32u(frame, bus.Transfers);
+    SCI_Frame_Queue32u(frame, bus.Bytes);
+    SCI_Frame_Queue32u(frame, bus.BusyTime);
+    SCI_Frame_Queue32u(frame, bus.Throughput);
+    SCI_Frame_Queue16u(frame, (uint16_t)bus.Utilization);
+    SCI_Frame_Queue32u(frame, trace.Frames);
+    SCI_Frame_Queue32u(frame, trace.FrameTransfers);
+    SCI_Frame_Queue16u(frame, trace.LastPerFrame);
+    SCI_Frame_Queue16u(frame, trace.MinPerFrame);
+    SCI_Frame_Queue16u(frame, trace.MaxPerFrame);
+    SCI_Frame_Queue32u(frame, trace.Errors);
+    SCI_Frame_Queue32u(frame, HRClock_GetFrequency());
+
+    if (param & 0x01U)
+    {
+        /* The records of all slaves, i.e. the complete bus activity. */
+        s2pi_trace_record_t records[S2PI_TRACE_LENGTH];
+        const uint32_t count = S2PITrace_GetRecords(records, S2PI_TRACE_LENGTH);
+        SCI_Frame_Queue08u(frame, (uint8_t)count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            SCI_Frame_Queue08u(frame, records[i].Slave);
+            SCI_Frame_Queue16s(frame, records[i].Status);
+            SCI_Frame_Queue16u(frame, records[i].Length);
+            SCI_Frame_Queue32u(frame, records[i].Start);
+            SCI_Frame_Queue32u(frame, records[i].Duration);
+        }
+    }
+    else
+    {
+        SCI_Frame_Queue08u(frame, 0);
+    }
+
+    if (param & 0x02U)
+    {
+        S2PIQueue_ResetStats();
+        S2PITrace_Reset();
+    }
+    return STATUS_OK;
+}
+
+static status_t RxCmd_OrchestratorStats(sci_device_t deviceID, sci_frame_t * frame)
+{
+    uint8_t flags = 0; // bit 0: reset the statistics of all devices after reading
+    if (SCI_Frame_BytesToRead(frame) > 1)
+        flags = SCI_Frame_Dequeue08u(frame);
+
+    if (flags > 1) return ERROR_SCI_INVALID_CMD_PARAMETER;
+    argus_hnd_t * argus = ExplorerApp_GetArgusPtr(deviceID);
+    if (argus == NULL) return ERROR_EXPLORER_UNINITIALIZED_DEVICE_ADDRESS;
+    return SCI_SendCommand(deviceID, CMD_ORCHESTRATOR_STATS, flags, 0);
+}
+static status_t TxCmd_OrchestratorStats(sci_device_t deviceID, sci_frame_t * frame, sci_param_t param, sci_data_t data)
+{
+    (void)data;
+    argus_hnd_t * argus = ExplorerApp_GetArgusPtr(deviceID);
+    if (argus == NULL) return ERROR_EXPLORER_UNINITIALIZED_DEVICE_ADDRESS;
+
+    /* All zero if the device is not orchestrated. */
+    orchestrator_stats_t stats = { 0 };
+    const bool orchestrated = ExplorerApp_OrchestratorGetStats(argus, &stats) == STATUS_OK;
+
+    SCI_Frame_Queue08u(frame, (uint8_t)orchestrated);
+    SCI_Frame_Queue32u(frame, stats.PhaseOffset);
+    SCI_Frame_Queue32u(frame, stats.FramePeriod);
+    SCI_Frame_Queue32u(frame, stats.Triggered);
+    SCI_Frame_Queue32u(frame, stats.Finished);
+    SCI_Frame_Queue32u(frame, stats.Skipped);
+    SCI_Frame_Queue32u(frame, stats.FrameRate);
+    SCI_Frame_Queue08u(frame, stats.Flags);
+    SCI_Frame_Queue32u(frame, ExplorerApp_OrchestratorGetFrameRate());
+
+    if (param & 0x01U)
+    {
+        ExplorerApp_OrchestratorResetStats();
+    }
+    return STATUS_OK;
+}
+
 static status_t RxCmd_ModuleType(sci_device_t deviceID, sci_frame_t * frame)
 {
     (void)frame; // unused parameter
@@ -267,6 +413,12 @@ status_t ExplorerAPI_InitGeneral()
     if(status < STATUS_OK) return status;
     status = SCI_SetRxTxCommand(CMD_SOFTWARE_VERSION, RxCmd_SoftwareVersion, (sci_tx_cmd_fct_t)TxCmd_SoftwareVersion);
     if(status < STATUS_OK) return status;
+    status = SCI_SetRxTxCommand(CMD_BOOT_PROFILE, RxCmd_BootProfile, (sci_tx_cmd_fct_t)TxCmd_BootProfile);
+    if(status < STATUS_OK) return status;
+    status = SCI_SetRxTxCommand(CMD_S2PI_TRACE, RxCmd_S2PITrace, (sci_tx_cmd_fct_t)TxCmd_S2PITrace);
+    if(status < STATUS_OK) return status;
+    status = SCI_SetRxTxCommand(CMD_ORCHESTRATOR_STATS, RxCmd_OrchestratorStats, (sci_tx_cmd_fct_t)TxCmd_OrchestratorStats);
+    if(status < STATUS_OK) return status;
     status = SCI_SetRxTxCommand(CMD_MODULE_TYPE, RxCmd_ModuleType, (sci_tx_cmd_fct_t)TxCmd_ModuleType);
     if(status < STATUS_OK) return status;
     status = SCI_SetRxTxCommand(CMD_MODULE_UID, RxCmd_ModuleUID, (sci_tx_cmd_fct_t)TxCmd_ModuleUID);
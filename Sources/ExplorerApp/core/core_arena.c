@@ -0,0 +1,120 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 Explorer Demo Application.
+ * @details     This file contains the static memory arena for the per-device data of the
+ *              Explorer Application.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "core_arena.h"
+#include "explorer_config.h"
+#include "explorer_types.h"
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Rounds a size up to the arena alignment of 8 bytes. */
+#define ARENA_ALIGN(size) (((size) + 7U) & ~(size_t)7U)
+
+/*! The arena memory required by a single device. */
+#define ARENA_DEVICE_SIZE (ARENA_ALIGN(sizeof(explorer_t)) + \
+    EXPLORER_RESULT_BUFFER_COUNT * ARENA_ALIGN(sizeof(argus_resultsbuffer_t)))
+
+/*! The total size of the device arena in bytes. */
+#define ARENA_SIZE (EXPLORER_DEVICE_COUNT * ARENA_DEVICE_SIZE)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The arena memory; 64-bit words for the alignment. */
+static uint64_t myArena[ARENA_SIZE / sizeof(uint64_t)];
+
+/*! The number of allocated bytes. */
+static size_t myUsed = 0;
+
+/*! The offset of the latest allocation. */
+static size_t myLast = 0;
+
+/*! Determines whether the arena has been sealed. */
+static bool isSealed = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void * ExplorerApp_ArenaAlloc(size_t size)
+{
+    assert(!isSealed);
+    if (isSealed) return NULL;
+
+    size = ARENA_ALIGN(size);
+    if (size > sizeof(myArena) - myUsed) return NULL;
+
+    uint8_t * ptr = (uint8_t *)myArena + myUsed;
+    myLast = myUsed;
+    myUsed += size;
+
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void ExplorerApp_ArenaFree(void * ptr)
+{
+    assert(!isSealed);
+    assert(ptr == (uint8_t *)myArena + myLast);
+
+    if (!isSealed && ptr == (uint8_t *)myArena + myLast)
+    {
+        myUsed = myLast;
+    }
+}
+
+void * ExplorerApp_ArenaSeal(size_t * size)
+{
+    assert(size != NULL);
+    assert(!isSealed);
+
+    isSealed = true;
+    *size = sizeof(myArena) - myUsed;
+    return *size > 0 ? (uint8_t *)myArena + myUsed : NULL;
+}
@@ -0,0 +1,97 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 Explorer Demo Application.
+ * @details     This file contains the static memory arena for the per-device data of the
+ *              Explorer Application.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef CORE_ARENA_H
+#define CORE_ARENA_H
+
+/*!***************************************************************************
+ * @defgroup    core_arena AFBR-S50 Explorer Application - Device Arena
+ * @ingroup     explorer_app
+ * @brief       AFBR-S50 Explorer Application - Static Device Memory Arena
+ * @details     Provides the memory for the per-device data, i.e. the Explorer
+ *              control blocks (incl. the ping slots) and the measurement
+ *              result buffers, from a static arena.
+ *
+ *              The arena is sized for the maximum number of devices
+ *              (#EXPLORER_DEVICE_COUNT), but the memory is only claimed for
+ *              the devices that are actually found by the device discovery
+ *              at boot. Thus, a single firmware serves boards with any number
+ *              of sensors up to the maximum.
+ *
+ *              The arena is a simple bump allocator without individual free
+ *              operations, except for the latest allocation. After the
+ *              initialization, the arena is sealed and the remaining memory
+ *              is handed over to the SCI module as additional TX frames.
+ *
+ * @addtogroup  core_arena
+ * @{
+ *****************************************************************************/
+
+#include <stddef.h>
+
+/*!***************************************************************************
+ * @brief   Allocates a zero-initialized memory block from the device arena.
+ * @details The block is aligned to 8 bytes. Allocation is only possible
+ *          before the arena has been sealed.
+ * @param   size The size of the memory block in bytes.
+ * @return  Returns a pointer to the memory block; NULL if the arena is
+ *          exhausted or already sealed.
+ *****************************************************************************/
+void * ExplorerApp_ArenaAlloc(size_t size);
+
+/*!***************************************************************************
+ * @brief   Returns the latest allocated memory block to the device arena.
+ * @details Used to undo an allocation for a device that could not be
+ *          initialized. Only the latest allocation can be freed.
+ * @param   ptr The memory block obtained by the latest call to
+ *              #ExplorerApp_ArenaAlloc.
+ *****************************************************************************/
+void ExplorerApp_ArenaFree(void * ptr);
+
+/*!***************************************************************************
+ * @brief   Seals the device arena and returns the unused memory.
+ * @details No further allocations are possible after sealing the arena.
+ * @param   size Returns the size of the unused memory block in bytes.
+ * @return  Returns a pointer to the 8-byte aligned unused memory block
+ *          (NULL if no memory is left).
+ *****************************************************************************/
+void * ExplorerApp_ArenaSeal(size_t * size);
+
+/*! @} */
+#endif /* CORE_ARENA_H */
@@ -39,18 +39,44 @@
  ******************************************************************************/
 
 #include "core_device.h"
+#include "core_arena.h"
 #include "core_cfg.h"
 #include "core_flash.h"
 #include "core_utils.h"
 #include <assert.h>
+#include <string.h>
 #include "driver/s2pi.h"
 #include "debug.h"
+#include "boot_profile.h"
 #include "explorer_config.h"
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
+/*! The address of the register used for the S2PI integrity check;
+ *  a 16 byte read/write register that echos the previously written data. */
+#define PROBE_REGISTER          0x04U
+
+/*! The payload size of the S2PI integrity check in bytes. */
+#define PROBE_SIZE              16U
+
+/*! The number of test patterns of the S2PI integrity check. */
+#define PROBE_PATTERN_COUNT     4U
+
+/*! The baud rate in bps that is used to search for connected slaves. */
+#define PROBE_BAUDRATE          100000U
+
+/*! The timeout in ms for a single integrity check step of all slaves. */
+#define PROBE_TIMEOUT_MS        100U
+
+/*! The number of bisection steps to refine the baud rate between the
+ *  last passing and the first failing halving step. */
+#define BAUD_REFINE_STEPS       3U
+
+/*! The bit mask of all S2PI slaves (slave 0 is not a valid slave). */
+#define ALL_SLAVES              ((((uint32_t)1U << (EXPLORER_DEVICE_ID_MAX + 1U)) - 1U) & ~1U)
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -59,126 +85,342 @@
  * Variables
  ******************************************************************************/
 
-static explorer_t explorerArray[EXPLORER_DEVICE_COUNT] = { 0 };
+/*! The Explorer instances in the order of their discovery;
+ *  the control blocks are allocated from the device arena. */
+static explorer_t * explorerArray[EXPLORER_DEVICE_COUNT] = { 0 };
+
+/*! The number of allocated Explorer instances. */
+static uint8_t explorerCount = 0;
+
+/*! Maps the device ID (= initial S2PI slave) to the Explorer instance. */
 static explorer_t * explorerIDMap[S2PI_SLAVE_COUNT + 1] = { 0 };
 
+/*! Maps the S2PI slave currently used by a device to the Explorer instance;
+ *  differs from the device ID after a re-initialization on another slave. */
+static explorer_t * explorerSlaveMap[S2PI_SLAVE_COUNT + 1] = { 0 };
+
+/*! The results of the last S2PI slave discovery. */
+static explorer_discovery_t myDiscovery = { 0 };
+
+/*! The slaves that passed the integrity check during the discovery;
+ *  the check is skipped on their first initialization. */
+static uint32_t myVerifiedSlaves = 0;
+
 /*******************************************************************************
  * Local Functions
  ******************************************************************************/
 
-static status_t CheckConnectedDevice(uint8_t slave)
+/*! Updates the slave of an Explorer instance in #explorerSlaveMap;
+ *  slave 0 removes the instance. */
+static void MapSlave(explorer_t * explorer, s2pi_slave_t slave)
+{
+    for (s2pi_slave_t s = 1; s <= S2PI_SLAVE_COUNT; ++s)
+    {
+        if (explorerSlaveMap[s] == explorer) explorerSlaveMap[s] = NULL;
+    }
+    if (slave > 0 && slave <= S2PI_SLAVE_COUNT) explorerSlaveMap[slave] = explorer;
+}
+
+static inline uint8_t GetProbePattern(uint8_t pattern, uint8_t i)
 {
-    status_t status = STATUS_OK;
+    switch (pattern % PROBE_PATTERN_COUNT)
+    {
+        case 0: return (uint8_t)(i + 1U);                   /* incrementing */
+        case 1: return (i & 1U) ? 0xAAU : 0x55U;            /* alternating bits */
+        case 2: return (uint8_t)(1U << (i & 7U));           /* walking one */
+        default: return (uint8_t)~(1U << (i & 7U));         /* walking zero */
+    }
+}
 
-    uint8_t data[17U] = {0};
-    for (uint8_t i = 1; i < 17U; ++i) data[i] = i;
+/*!***************************************************************************
+ * @brief   Runs the S2PI integrity check on multiple slaves in parallel.
+ * @details Writes a sequence of test patterns to the echo register of each
+ *          slave and verifies the read-back of the previously written
+ *          pattern. The frames of all slaves are issued back to back in
+ *          chip-select order; the S2PI module queues them and runs the
+ *          transfers of slaves on different SPI instances concurrently.
+ *          Devices with inverted MISO line are accepted if all bytes of
+ *          all patterns are consistently inverted.
+ * @param   slaves The bit mask of the slaves to check.
+ * @return  Returns the bit mask of the slaves that passed the check.
+ *****************************************************************************/
+static uint32_t ProbeSlaves(uint32_t slaves)
+{
+    uint8_t data[EXPLORER_DEVICE_ID_MAX + 1][PROBE_SIZE + 1U];
+    uint8_t polarity[EXPLORER_DEVICE_ID_MAX + 1] = { 0 };
+    uint32_t passed = slaves & ALL_SLAVES;
 
-    for (uint8_t n = 0; n < 2; n++)
+    /* The first transfer reads back unknown data, hence one more transfer
+     * than patterns is required. */
+    for (uint8_t n = 0; n <= PROBE_PATTERN_COUNT && passed != 0; ++n)
     {
-        data[0] = 0x04;
-        status = S2PI_TransferFrame(slave, data, data, 17U, 0, 0);
-        if (status < STATUS_OK)
+        ltc_t start;
+        Time_GetNow(&start);
+
+        for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
         {
-            return status;
+            if (!(passed & (1U << s))) continue;
+
+            data[s][0] = PROBE_REGISTER;
+            for (uint8_t i = 0; i < PROBE_SIZE; ++i)
+                data[s][i + 1U] = GetProbePattern(n, i);
+
+            /* The S2PI queue may be full; retry until an entry becomes free. */
+            status_t status;
+            do
+            {
+                status = S2PI_TransferFrame(s, data[s], data[s], PROBE_SIZE + 1U, 0, 0);
+                if (status == STATUS_BUSY && Time_CheckTimeoutMSec(&start, PROBE_TIMEOUT_MS))
+                {
+                    status = ERROR_TIMEOUT;
+                }
+            }
+            while (status == STATUS_BUSY);
+
+            if (status < STATUS_OK) passed &= ~(1U << s);
         }
 
-        ltc_t start;
-        Time_GetNow(&start);
-        do
+        for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
         {
-            status = S2PI_GetStatus(slave);
-            if (Time_CheckTimeoutMSec(&start, 100))
+            if (!(passed & (1U << s))) continue;
+
+            status_t status;
+            do
+            {
+                status = S2PI_GetStatus(s);
+                if (Time_CheckTimeoutMSec(&start, PROBE_TIMEOUT_MS))
+                {
+                    status = ERROR_TIMEOUT;
+                }
+            }
+            while (status == STATUS_BUSY);
+
+            if (status < STATUS_OK)
+            {
+                S2PI_Abort(s);
+                passed &= ~(1U << s);
+                continue;
+            }
+
+            if (n == 0) continue;
+
+            /* The polarity is determined once by the first byte. */
+            if (n == 1)
+                polarity[s] = (data[s][1] == GetProbePattern(0, 0)) ? 0x00U : 0xFFU;
+
+            for (uint8_t i = 0; i < PROBE_SIZE; ++i)
             {
-                status = ERROR_TIMEOUT;
+                if (data[s][i + 1U] != (uint8_t)(GetProbePattern(n - 1U, i) ^ polarity[s]))
+                {
+                    passed &= ~(1U << s);
+                    break;
+                }
             }
         }
-        while (status == STATUS_BUSY);
+    }
 
-        if (status < STATUS_OK)
+    return passed;
+}
+
+/*!***************************************************************************
+ * @brief   Searches the maximum baud rate that passes the integrity check.
+ * @details Binary-searches the halving steps of the maximum baud rate and
+ *          refines the result by bisection towards the next faster step
+ *          until the S2PI module cannot resolve the difference anymore.
+ *          The slave must pass the check at the slowest step.
+ * @param   slave The S2PI slave.
+ * @param   maxBaudRate The maximum baud rate in bps.
+ * @param   steps The number of halving steps to the known good baud rate.
+ * @return  Returns the actual baud rate in bps, which is already applied.
+ *****************************************************************************/
+static uint32_t SearchBaudRate(s2pi_slave_t slave, uint32_t maxBaudRate, uint8_t steps)
+{
+    const uint32_t mask = 1U << slave;
+
+    /* Find the fastest passing halving step; step 'hi' is known to pass. */
+    uint8_t lo = 0;
+    uint8_t hi = steps;
+    while (lo < hi)
+    {
+        const uint8_t mid = (uint8_t)((lo + hi) / 2U);
+        S2PI_SetBaudRate(slave, maxBaudRate >> mid);
+        if (ProbeSlaves(mask)) hi = mid;
+        else lo = (uint8_t)(mid + 1U);
+    }
+
+    S2PI_SetBaudRate(slave, maxBaudRate >> hi);
+    uint32_t good = S2PI_GetBaudRate(slave);
+
+    if (hi > 0)
+    {
+        uint32_t bad = maxBaudRate >> (hi - 1U);
+        for (uint8_t k = 0; k < BAUD_REFINE_STEPS; ++k)
         {
-            S2PI_Abort(slave);
-            return status;
+            S2PI_SetBaudRate(slave, good + (bad - good) / 2U);
+            const uint32_t actual = S2PI_GetBaudRate(slave);
+            if (actual <= good || actual >= bad) break;
+
+            if (ProbeSlaves(mask)) good = actual;
+            else bad = actual;
         }
+
+        S2PI_SetBaudRate(slave, good);
     }
 
-    bool hasData = true;
-    for (uint8_t i = 1; i < 17U; ++i)
+    return good;
+}
+
+/*!***************************************************************************
+ * @brief   Probes the slaves at reduced baud rate and searches the maximum
+ *          baud rate of the connected ones.
+ * @param   slaves The bit mask of the slaves to search.
+ * @param   maxBaudRate The maximum baud rate in bps.
+ * @param   baudRates The baud rate per slave; filled for the found slaves.
+ * @return  Returns the bit mask of the found slaves.
+ *****************************************************************************/
+static uint32_t SearchSlaves(uint32_t slaves, uint32_t maxBaudRate, uint32_t * baudRates)
+{
+    uint8_t steps = 0;
+    while ((maxBaudRate >> steps) > PROBE_BAUDRATE) steps++;
+
+    for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
     {
-        uint8_t j = ~i; // devices w/ inverted MISO
-        if ((data[i] != i) && (data[i] != j))
-            hasData = false;
+        if (slaves & (1U << s)) S2PI_SetBaudRate(s, maxBaudRate >> steps);
     }
 
-    if (hasData) return STATUS_OK;
+    const uint32_t found = ProbeSlaves(slaves);
 
-    return ERROR_ARGUS_NOT_CONNECTED;
+    for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
+    {
+        if (found & (1U << s))
+            baudRates[s] = SearchBaudRate(s, maxBaudRate, steps);
+        else if (slaves & (1U << s))
+            S2PI_SetBaudRate(s, maxBaudRate);
+    }
+
+    return found;
 }
 
-static status_t FindConnectedDevices(int8_t * slave, uint32_t * maxBaudRate)
+static status_t FindConnectedDevices(explorer_t const * explorer,
+                                     int8_t * slave, uint32_t * maxBaudRate)
 {
     assert(slave != 0);
     assert(maxBaudRate != 0);
 
-    status_t status = STATUS_OK;
-    uint8_t r_max = 0;
-
     if (*slave == 0)
     {
         return ERROR_ARGUS_NOT_CONNECTED;
     }
     else if (*slave > 0)
     {
-        return CheckConnectedDevice(*slave);
+        /* Slaves verified by the discovery are not checked again. */
+        const uint32_t mask = 1U << *slave;
+        if (myVerifiedSlaves & mask)
+        {
+            myVerifiedSlaves &= ~mask;
+            return STATUS_OK;
+        }
+        return ProbeSlaves(mask) ? STATUS_OK : ERROR_ARGUS_NOT_CONNECTED;
     }
     else
     {
-        /* Reduce baud rate for search. */
-        while (((*maxBaudRate) >> r_max) > 100000U) r_max++;
-        S2PI_SetBaudRate(*slave, (*maxBaudRate) >> r_max);
+        /* Auto detect slave; skip the slaves occupied by other devices. */
+        uint32_t slaves = 0;
+        for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
+        {
+            if (explorerSlaveMap[s] == NULL || explorerSlaveMap[s] == explorer)
+                slaves |= 1U << s;
+        }
+
+        uint32_t baudRates[EXPLORER_DEVICE_ID_MAX + 1] = { 0 };
+        const uint32_t found = SearchSlaves(slaves, *maxBaudRate, baudRates);
+        if (found == 0) return ERROR_ARGUS_NOT_CONNECTED;
+
+        /* Select the first found slave. */
+        *slave = 1;
+        while (!(found & (1U << *slave))) (*slave)++;
+        *maxBaudRate = baudRates[*slave];
+        return STATUS_OK;
+    }
+}
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
 
-        /* Auto detect slave. */
-        *slave = 0;
-        for (uint8_t s = 1; s <= 4; s++)
+uint32_t ExplorerApp_DiscoverDevices(void)
+{
+    ltc_t start = Time_Now();
+
+    explorer_discovery_t cache = { 0 };
+    bool warm = false;
+#if EXPLORER_DISCOVERY_CACHE
+    warm = ExplorerApp_LoadDiscoveryFromFlash(&cache) == STATUS_OK;
+#endif
+
+    memset(&myDiscovery, 0, sizeof(myDiscovery));
+    uint32_t verified = 0;
+
+    /* Warm boot: verify the cached slaves once at their cached baud rates. */
+    if (warm)
+    {
+        cache.Slaves &= ALL_SLAVES;
+        for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
         {
-            status = CheckConnectedDevice(s);
-            if (status == STATUS_OK)
-            {
-                *slave = s;
-                break;
-            }
-            else if (status != ERROR_ARGUS_NOT_CONNECTED)
-            {
-                return status;
-            }
+            if (cache.Slaves & (1U << s)) S2PI_SetBaudRate(s, cache.BaudRate[s]);
         }
-        if (*slave == 0)
+
+        verified = ProbeSlaves(cache.Slaves);
+        for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
         {
-            return ERROR_ARGUS_NOT_CONNECTED;
+            if (verified & (1U << s)) myDiscovery.BaudRate[s] = S2PI_GetBaudRate(s);
         }
+
+        /* A cached slave failed: search all remaining slaves again. */
+        if (verified != cache.Slaves) warm = false;
     }
 
-    /* Auto detect max baud rate. */
-    for (uint8_t r = 0; r < r_max; ++r)
+    /* Probe the remaining slaves at the maximum baud rate; this is cheap and
+     * finds devices that have been connected since the last discovery. */
+    uint32_t remaining = ALL_SLAVES & ~verified;
+    for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
     {
-        S2PI_SetBaudRate(*slave, (*maxBaudRate) >> r);
-        status = CheckConnectedDevice(*slave);
-        if (status == STATUS_OK)
-        {
-            (*maxBaudRate) = (*maxBaudRate) >> r;
-            return STATUS_OK;
-        }
-        else if (status != ERROR_ARGUS_NOT_CONNECTED)
+        if (remaining & (1U << s)) S2PI_SetBaudRate(s, SPI_BAUDRATE);
+    }
+
+    const uint32_t fast = ProbeSlaves(remaining);
+    for (s2pi_slave_t s = 1; s <= EXPLORER_DEVICE_ID_MAX; ++s)
+    {
+        if (fast & (1U << s)) myDiscovery.BaudRate[s] = S2PI_GetBaudRate(s);
+    }
+    verified |= fast;
+    remaining &= ~fast;
+
+    /* Cold boot: search the slaves that require a reduced baud rate. */
+    if (!warm)
+    {
+        verified |= SearchSlaves(remaining, SPI_BAUDRATE, myDiscovery.BaudRate);
+    }
+
+    myDiscovery.Slaves = verified;
+    myVerifiedSlaves = verified;
+
+#if EXPLORER_DISCOVERY_CACHE
+    if (verified != 0)
+    {
+        status_t status = ExplorerApp_SaveDiscoveryToFlash(&myDiscovery);
+        if (status < STATUS_OK)
         {
-            return status;
+            error_log("Failed to save the device discovery to flash, error code: %d", status);
         }
     }
+#endif
 
-    return ERROR_ARGUS_NOT_CONNECTED;
-}
+    print("Discovery (%s): slaves 0x%02x, %d us",
+          warm ? "warm" : "cold", verified, Time_GetElapsedUSec(&start));
 
-/*******************************************************************************
- * Functions
- ******************************************************************************/
+    return verified;
+}
 
 argus_hnd_t * ExplorerApp_GetArgusPtr(sci_device_t deviceID)
 {
@@ -198,10 +440,15 @@ explorer_t * ExplorerApp_GetExplorerPtrFromArgus(argus_hnd_t * argus)
 {
     assert(argus != NULL);
 
-    for (uint8_t i = 0; i < EXPLORER_DEVICE_COUNT; i++)
+    /* The slave map is updated on each (re-)initialization of a device. */
+    const s2pi_slave_t slave = Argus_GetSPISlave(argus);
+    explorer_t * explorer = (slave > 0 && slave <= S2PI_SLAVE_COUNT) ? explorerSlaveMap[slave] : NULL;
+    if (explorer != NULL && explorer->Argus == argus) return explorer;
+
+    /* Fallback for a handle that is not (yet) mapped. */
+    for (uint8_t idx = 0; idx < explorerCount; ++idx)
     {
-        if (explorerArray[i].Argus == argus)
-            return &explorerArray[i];
+        if (explorerArray[idx]->Argus == argus) return explorerArray[idx];
     }
 
     assert(0);
@@ -211,9 +458,9 @@ explorer_t * ExplorerApp_GetExplorerPtrFromArgus(argus_hnd_t * argus)
 uint8_t ExplorerApp_GetInitializedExplorerCount()
 {
     uint8_t count = 0;
-    for (uint8_t idx = 0; idx < EXPLORER_DEVICE_COUNT; ++idx)
+    for (uint8_t idx = 0; idx < explorerCount; ++idx)
     {
-        if (explorerArray[idx].Argus != NULL)
+        if (explorerArray[idx]->Argus != NULL)
             count++;
     }
     return count;
@@ -221,9 +468,10 @@ uint8_t ExplorerApp_GetInitializedExplorerCount()
 
 explorer_t * ExplorerApp_GetInitializedExplorer(uint8_t index)
 {
-    assert(index < EXPLORER_DEVICE_COUNT);
+    assert(index < explorerCount);
+    if (index >= explorerCount) return NULL;
 
-    explorer_t * explorer = &explorerArray[index];
+    explorer_t * explorer = explorerArray[index];
     return explorer->Argus != NULL ? explorer : NULL;
 }
 
@@ -256,27 +504,35 @@ status_t ExplorerApp_InitDevice(explorer_t * explorer, argus_mode_t mode, bool r
     /* Check for connected devices. */
     int8_t slave = explorer->Configuration.SPISlave;
     uint32_t baudRate = explorer->Configuration.SPIBaudRate;
-    status_t status = FindConnectedDevices(&slave, &baudRate);
+    int32_t phase = BootProfile_Begin(BOOT_PHASE_FIND_DEVICE, (uint8_t)slave);
+    status_t status = FindConnectedDevices(explorer, &slave, &baudRate);
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         Argus_DestroyHandle(explorer->Argus);
         explorer->Argus = NULL;
+        MapSlave(explorer, 0);
         error_log("No suitable device connected, error code: %d", status);
         return status;
     }
+    explorer->Configuration.SPIBaudRate = baudRate;
 
     /* Device initialization */
     ltc_t start = Time_Now();
+    phase = BootProfile_Begin(BOOT_PHASE_ARGUS_INIT, (uint8_t)slave);
     status = Argus_InitMode(explorer->Argus, slave, mode);
+    BootProfile_End(phase);
     uint32_t elapsed = Time_GetElapsedUSec(&start);
     print("Init Time: %d us", elapsed);
     if (status < STATUS_OK)
     {
         Argus_DestroyHandle(explorer->Argus);
         explorer->Argus = NULL;
+        MapSlave(explorer, 0);
         error_log("Failed to initialize AFBR-S50 API, error code: %d", status);
         return status;
     }
+    MapSlave(explorer, slave);
 
     ExplorerApp_ResetDefaultDataStreamingMode(explorer);
     ExplorerApp_DisplayUnambiguousRange(explorer->Argus);
@@ -303,15 +559,11 @@ status_t ExplorerApp_InitExplorer(sci_device_t deviceID)
     /* ensure the uninitialized device starts with a null mapping */
     explorerIDMap[deviceID] = NULL;
 
-    /* find an unused memory block and allocate it for that instance. */
+    /* Allocate the memory block for that instance from the device arena. */
     explorer_t * pExplorer = NULL;
-    for (uint8_t idx = 0; idx < EXPLORER_DEVICE_COUNT; idx++)
+    if (explorerCount < EXPLORER_DEVICE_COUNT)
     {
-        if (explorerArray[idx].Argus == NULL)
-        {
-            pExplorer = &explorerArray[idx];
-            break;
-        }
+        pExplorer = ExplorerApp_ArenaAlloc(sizeof(explorer_t));
     }
 
     /* Make sure there is an empty Explorer object available. */
@@ -325,12 +577,33 @@ status_t ExplorerApp_InitExplorer(sci_device_t deviceID)
     ExplorerApp_GetDefaultConfiguration(&pExplorer->Configuration);
     pExplorer->Configuration.SPISlave = deviceID;
 
+    /* Use the baud rate found by the discovery. */
+    if (myDiscovery.Slaves & (1U << deviceID))
+    {
+        pExplorer->Configuration.SPIBaudRate = myDiscovery.BaudRate[deviceID];
+        S2PI_SetBaudRate(deviceID, myDiscovery.BaudRate[deviceID]);
+    }
+
     /* Initialize connected devices. */
     status = ExplorerApp_InitDevice(pExplorer, 0, false);
-    if (status < STATUS_OK) return status;
+    if (status < STATUS_OK)
+    {
+        /* Return the memory block to the arena for the next device. */
+        ExplorerApp_ArenaFree(pExplorer);
+        return status;
+    }
 
     status = ExplorerApp_SetConfiguration(pExplorer, &pExplorer->Configuration);
-    if (status < STATUS_OK) return status;
+    if (status < STATUS_OK)
+    {
+        Argus_Deinit(pExplorer->Argus);
+        Argus_DestroyHandle(pExplorer->Argus);
+        MapSlave(pExplorer, 0);
+        ExplorerApp_ArenaFree(pExplorer);
+        return status;
+    }
+
+    explorerArray[explorerCount++] = pExplorer;
 
     /* Only once all checks are completed map the Explorer device to its ID for usage
      * deviceID starts with 1, so a mapping is needed.
@@ -49,6 +49,27 @@
 
 #include "explorer_types.h"
 
+/*!***************************************************************************
+ * @brief   Discovers the devices connected to the S2PI slaves.
+ * @details All slaves are probed in parallel with a multi-pattern integrity
+ *          check. Slaves that do not pass at the maximum baud rate are
+ *          probed at a reduced baud rate and their maximum baud rate is
+ *          binary-searched.
+ *
+ *          The results are cached in the flash memory (see
+ *          #EXPLORER_DISCOVERY_CACHE). On a warm boot, the cached slaves are
+ *          verified once at their cached baud rate and only the remaining
+ *          slaves are probed at the maximum baud rate. If a cached slave
+ *          fails, the full search is done and the cache is updated.
+ *
+ *          The found slaves are not checked again when their Explorer
+ *          instance is initialized via #ExplorerApp_InitExplorer, which
+ *          also applies the discovered baud rate.
+ * @return  Returns the bit mask of the slaves with a connected device,
+ *          i.e. bit n is set if a device is connected to slave n.
+ *****************************************************************************/
+uint32_t ExplorerApp_DiscoverDevices(void);
+
 /*!***************************************************************************
  * @brief   Gets the Argus device instance handle pointer.
  * @param   deviceID The Device ID of the selected Argus sensor.
@@ -43,14 +43,37 @@
 #include "core_cfg.h"
 
 #include "driver/flash.h"
+#include "driver/nvm.h"
 #include "debug.h"
 #include <assert.h>
+#include <stddef.h>
+#include <string.h>
 
 
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
+/*! The header of the discovery record: 'D' 'S' 'C' + version. */
+#define DISCOVERY_HEADER    0x44534301U
+
+/*! The offset of the discovery record within the Explorer configuration block. */
+#define DISCOVERY_OFFSET    0U
+
+/*! The discovery record as stored in the flash memory. */
+typedef struct discovery_record_t
+{
+    /*! The record header, see #DISCOVERY_HEADER. */
+    uint32_t Header;
+
+    /*! The discovery results. */
+    explorer_discovery_t Data;
+
+    /*! The checksum, i.e. the inverted sum of all preceding words. */
+    uint32_t Checksum;
+
+} discovery_record_t;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -63,16 +86,79 @@
  * Local Functions
  ******************************************************************************/
 
+static uint32_t GetDiscoveryChecksum(discovery_record_t const * record)
+{
+    uint32_t const * words = (uint32_t const *)record;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < offsetof(discovery_record_t, Checksum) / sizeof(uint32_t); ++i)
+    {
+        sum += words[i];
+    }
+    return ~sum;
+}
+
 /*******************************************************************************
  * Functions
  ******************************************************************************/
 
+status_t ExplorerApp_LoadDiscoveryFromFlash(explorer_discovery_t * discovery)
+{
+    assert(discovery != NULL);
+
+    discovery_record_t record;
+    status_t status = Flash_Read(FLASH_EXPL_CFG_INDEX, DISCOVERY_OFFSET,
+                                 (uint8_t *)&record, sizeof(record));
+    if (status != STATUS_OK) return status;
+
+    if (record.Header != DISCOVERY_HEADER ||
+        record.Checksum != GetDiscoveryChecksum(&record))
+    {
+        return ERROR_NOT_INITIALIZED;
+    }
+
+    memcpy(discovery, &record.Data, sizeof(explorer_discovery_t));
+    return STATUS_OK;
+}
+
+status_t ExplorerApp_SaveDiscoveryToFlash(explorer_discovery_t const * discovery)
+{
+    assert(discovery != NULL);
+
+    /* Flash writes are slow and wear the memory; skip if nothing changed. */
+    explorer_discovery_t stored;
+    if (ExplorerApp_LoadDiscoveryFromFlash(&stored) == STATUS_OK &&
+        memcmp(&stored, discovery, sizeof(explorer_discovery_t)) == 0)
+    {
+        return STATUS_OK;
+    }
+
+    discovery_record_t record;
+    record.Header = DISCOVERY_HEADER;
+    memcpy(&record.Data, discovery, sizeof(explorer_discovery_t));
+    record.Checksum = GetDiscoveryChecksum(&record);
+
+    return Flash_Write(FLASH_EXPL_CFG_INDEX, DISCOVERY_OFFSET,
+                       (uint8_t const *)&record, sizeof(record));
+}
+
 status_t ExplorerApp_ClearFlash(void)
 {
     status_t status = Flash_ClearAll();
     if (status != STATUS_OK) return status;
 
+    /* The NVM module keeps a RAM directory of the cleared flash blocks. */
+    status = NVM_Init();
+    if (status != STATUS_OK) return status;
+
     print("Successfully cleared complete flash memory!");
+
+#if defined(CPU_MKL46Z256VLH4) || defined(CPU_MKL46Z256VLL4) || defined(CPU_MKL46Z256VMC4) || defined(CPU_MKL46Z256VMP4)
+    flash_stats_t stats;
+    Flash_GetStats(&stats);
+    print("Flash: %d commands (%d erases), max. IRQ lock time: %d us (erase), %d us (program)",
+          stats.Commands, stats.Erases, stats.MaxEraseLockTime, stats.MaxProgramLockTime);
+#endif
+
     return STATUS_OK;
 }
 
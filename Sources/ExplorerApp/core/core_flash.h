@@ -99,6 +99,23 @@ status_t ExplorerApp_SaveCalToFlash(explorer_t * explorer);
  *****************************************************************************/
 status_t ExplorerApp_SaveSettingsToFlash(explorer_t * explorer);
 
+/*!***************************************************************************
+ * @brief   Loads the cached S2PI slave discovery results from the flash memory.
+ * @details The record is validated by its header and checksum.
+ * @param   discovery The discovery results to be filled.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success);
+ *          #ERROR_NOT_INITIALIZED if no valid record is stored.
+ *****************************************************************************/
+status_t ExplorerApp_LoadDiscoveryFromFlash(explorer_discovery_t * discovery);
+
+/*!***************************************************************************
+ * @brief   Saves the S2PI slave discovery results to the flash memory.
+ * @details The flash memory is only written if the stored record differs.
+ * @param   discovery The discovery results to be stored.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t ExplorerApp_SaveDiscoveryToFlash(explorer_discovery_t const * discovery);
+
 /*!***************************************************************************
  * @brief   Deletes the configuration from the flash memory.
  * @details
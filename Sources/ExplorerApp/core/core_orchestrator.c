@@ -0,0 +1,343 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 Explorer Demo Application.
+ * @details     This file contains the multi-device frame orchestrator of the
+ *              Explorer Application.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "core_orchestrator.h"
+#include "core_device.h"
+#include "explorer_config.h"
+#include "explorer_tasks.h"
+#include "platform/argus_irq.h"
+#include "s2pi_queue.h"
+#include "timer_mux.h"
+#include "debug.h"
+#include <assert.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The orchestrator data of a participating device. */
+typedef struct orchestrator_device_t
+{
+    /*! The Argus device handler. */
+    argus_hnd_t * Argus;
+
+    /*! The device statistics. */
+    orchestrator_stats_t Stats;
+
+    /*! The time when the device has joined the orchestrated measurements. */
+    ltc_t JoinTime;
+
+    /*! The time when the last frame has been triggered. */
+    ltc_t TriggerTime;
+
+} orchestrator_device_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static status_t MeasurementReadyCallback(status_t status, argus_hnd_t * argus);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The participating devices in the order of their slots. */
+static orchestrator_device_t myDevices[EXPLORER_DEVICE_COUNT] = { 0 };
+
+/*! The number of participating devices. */
+static volatile uint8_t myCount = 0;
+
+/*! The index of the device to be triggered in the next slot. */
+static volatile uint8_t mySlot = 0;
+
+/*! The slot length in µs. */
+static volatile uint32_t mySlotTime = 0;
+
+/*******************************************************************************
+ * Local Functions
+ ******************************************************************************/
+
+static orchestrator_device_t * FindDevice(argus_hnd_t const * argus)
+{
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        if (myDevices[i].Argus == argus) return &myDevices[i];
+    }
+    return NULL;
+}
+
+static uint32_t GetFrameRate(orchestrator_device_t const * dev)
+{
+    const uint32_t elapsed_ms = Time_GetElapsedMSec(&dev->JoinTime);
+    if (elapsed_ms == 0) return 0;
+    return (uint32_t)(((uint64_t)dev->Stats.Finished * 1000000U) / elapsed_ms);
+}
+
+static void PrintStats(orchestrator_device_t const * dev)
+{
+    explorer_t const * explorer = ExplorerApp_GetExplorerPtrFromArgus(dev->Argus);
+    const uint32_t rate = GetFrameRate(dev);
+
+    print("Orchestrator: Device %d @ %d/%d us: %d of %d frames, %d.%03d fps, "
+          "%d skipped, flags: 0x%02x\n",
+          explorer ? explorer->Configuration.SPISlave : 0,
+          dev->Stats.PhaseOffset, dev->Stats.FramePeriod,
+          dev->Stats.Finished, dev->Stats.Triggered,
+          rate / 1000U, rate % 1000U,
+          dev->Stats.Skipped, dev->Stats.Flags);
+
+    s2pi_queue_stats_t s2pi;
+    if (explorer && S2PIQueue_GetStats(explorer->Configuration.SPISlave, &s2pi) == STATUS_OK)
+    {
+        print("Orchestrator: Device %d S2PI: %d frames, %d bytes, %d B/s, %d.%d %% busy, "
+              "%d queued, delay: %d us (mean) / %d us (max)\n",
+              explorer->Configuration.SPISlave, s2pi.Transfers, s2pi.Bytes, s2pi.Throughput,
+              s2pi.Utilization / 10U, s2pi.Utilization % 10U, s2pi.Queued,
+              s2pi.Queued ? s2pi.QueueDelay / s2pi.Queued : 0, s2pi.QueueDelayMax);
+    }
+}
+
+/*!***************************************************************************
+ * @brief   The slot timer callback; triggers the device of the current slot.
+ * @details Invoked from the timer interrupt service routine at the beginning
+ *          of each slot. The device is only triggered if all other devices
+ *          are idle, i.e. their read-out is finished.
+ * @param   param Not used.
+ *****************************************************************************/
+static void SlotCallback(void * param)
+{
+    (void)param;
+
+    if (myCount == 0) return;
+
+    const uint8_t slot = mySlot;
+    mySlot = (uint8_t)((slot + 1U) % myCount);
+
+    orchestrator_device_t * dev = &myDevices[slot];
+
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        if (i == slot) continue;
+        if (Argus_GetStatus(myDevices[i].Argus) == STATUS_BUSY)
+        {
+            myDevices[i].Stats.Flags |= ORCHESTRATOR_FLAG_LATE;
+            dev->Stats.Flags |= ORCHESTRATOR_FLAG_BUSY;
+            dev->Stats.Skipped++;
+            return;
+        }
+    }
+
+    Time_GetNow(&dev->TriggerTime);
+    status_t status = Argus_TriggerMeasurement(dev->Argus, MeasurementReadyCallback);
+    if (status == STATUS_OK)
+    {
+        dev->Stats.Triggered++;
+    }
+    else
+    {
+        dev->Stats.Flags |= ORCHESTRATOR_FLAG_REFUSED;
+        dev->Stats.Skipped++;
+    }
+}
+
+/*!***************************************************************************
+ * @brief   The measurement ready callback for orchestrated devices.
+ * @details Records the frame completion and checks it against the end of the
+ *          slot before forwarding to the #ExplorerApp_MeasurementReadyCallback.
+ *****************************************************************************/
+static status_t MeasurementReadyCallback(status_t status, argus_hnd_t * argus)
+{
+    orchestrator_device_t * dev = FindDevice(argus);
+    if (dev != NULL)
+    {
+        dev->Stats.Finished++;
+        if (Time_GetElapsedUSec(&dev->TriggerTime) > mySlotTime)
+        {
+            dev->Stats.Flags |= ORCHESTRATOR_FLAG_LATE;
+        }
+    }
+
+    return ExplorerApp_MeasurementReadyCallback(status, argus);
+}
+
+/*!***************************************************************************
+ * @brief   Reassigns the slots and restarts the slot timer.
+ * @details The slot length is the maximum frame time of all devices. The
+ *          common frame period is the slot length times the device count.
+ *****************************************************************************/
+static status_t UpdateSchedule(void)
+{
+    uint32_t slot_time = 0;
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        uint32_t frame_time = 0;
+        status_t status = Argus_GetConfigurationFrameTime(myDevices[i].Argus, &frame_time);
+        if (status < STATUS_OK) return status;
+        if (frame_time > slot_time) slot_time = frame_time;
+    }
+
+    IRQ_LOCK();
+    TimerMux_SetIntervalCallback(0, myDevices, SlotCallback);
+
+    mySlot = 0;
+    mySlotTime = slot_time;
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        myDevices[i].Stats.PhaseOffset = i * slot_time;
+        myDevices[i].Stats.FramePeriod = myCount * slot_time;
+    }
+
+    status_t status = STATUS_OK;
+    if (myCount > 0)
+    {
+        status = TimerMux_SetIntervalCallback(slot_time, myDevices, SlotCallback);
+    }
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+/*******************************************************************************
+ * Functions
+ ******************************************************************************/
+
+bool ExplorerApp_IsOrchestrated(void)
+{
+    return EXPLORER_FRAME_ORCHESTRATOR && ExplorerApp_GetInitializedExplorerCount() > 1;
+}
+
+status_t ExplorerApp_OrchestratorJoin(argus_hnd_t * argus)
+{
+    assert(argus != NULL);
+
+    IRQ_LOCK();
+    if (FindDevice(argus) == NULL)
+    {
+        if (myCount >= EXPLORER_DEVICE_COUNT)
+        {
+            IRQ_UNLOCK();
+            return ERROR_FAIL;
+        }
+
+        orchestrator_device_t * dev = &myDevices[myCount];
+        *dev = (orchestrator_device_t){ .Argus = argus };
+        Time_GetNow(&dev->JoinTime);
+        myCount++;
+    }
+    IRQ_UNLOCK();
+
+    return UpdateSchedule();
+}
+
+bool ExplorerApp_OrchestratorLeave(argus_hnd_t * argus)
+{
+    assert(argus != NULL);
+
+    IRQ_LOCK();
+    orchestrator_device_t * dev = FindDevice(argus);
+    if (dev == NULL)
+    {
+        IRQ_UNLOCK();
+        return false;
+    }
+
+    const orchestrator_device_t copy = *dev;
+    for (orchestrator_device_t * p = dev + 1; p < &myDevices[myCount]; p++)
+    {
+        *(p - 1) = *p;
+    }
+    myCount--;
+    IRQ_UNLOCK();
+
+    PrintStats(&copy);
+
+    const uint32_t aggregate = GetFrameRate(&copy) + ExplorerApp_OrchestratorGetFrameRate();
+    print("Orchestrator: Aggregate frame rate: %d.%03d fps, S2PI read-out: %d B/s\n",
+          aggregate / 1000U, aggregate % 1000U, S2PIQueue_GetThroughput());
+
+    UpdateSchedule();
+    return true;
+}
+
+status_t ExplorerApp_OrchestratorGetStats(argus_hnd_t * argus, orchestrator_stats_t * stats)
+{
+    assert(argus != NULL);
+    assert(stats != NULL);
+
+    IRQ_LOCK();
+    orchestrator_device_t const * dev = FindDevice(argus);
+    if (dev != NULL)
+    {
+        *stats = dev->Stats;
+        stats->FrameRate = GetFrameRate(dev);
+    }
+    IRQ_UNLOCK();
+
+    return dev != NULL ? STATUS_OK : ERROR_INVALID_ARGUMENT;
+}
+
+uint32_t ExplorerApp_OrchestratorGetFrameRate(void)
+{
+    uint32_t aggregate = 0;
+    IRQ_LOCK();
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        aggregate += GetFrameRate(&myDevices[i]);
+    }
+    IRQ_UNLOCK();
+    return aggregate;
+}
+
+void ExplorerApp_OrchestratorResetStats(void)
+{
+    IRQ_LOCK();
+    for (uint8_t i = 0; i < myCount; i++)
+    {
+        orchestrator_stats_t * stats = &myDevices[i].Stats;
+        stats->Triggered = 0;
+        stats->Finished = 0;
+        stats->Skipped = 0;
+        stats->Flags = ORCHESTRATOR_FLAG_NONE;
+        Time_GetNow(&myDevices[i].JoinTime);
+    }
+    IRQ_UNLOCK();
+}
@@ -0,0 +1,173 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 Explorer Demo Application.
+ * @details     This file contains the multi-device frame orchestrator of the
+ *              Explorer Application.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef CORE_ORCHESTRATOR_H
+#define CORE_ORCHESTRATOR_H
+
+/*!***************************************************************************
+ * @defgroup    core_orchestrator AFBR-S50 Explorer Application - Frame Orchestrator
+ * @ingroup     explorer_app
+ * @brief       AFBR-S50 Explorer Application - Multi-Device Frame Orchestrator
+ * @details     Schedules the timer based measurements of multiple devices
+ *              within a common frame period such that neither their S2PI
+ *              read-outs nor their laser pulses overlap.
+ *
+ *              Instead of running an individual measurement timer per device,
+ *              all participating devices are triggered from a single slot
+ *              timer. The common frame period is divided into one slot per
+ *              device, i.e. each device gets a phase offset of a multiple of
+ *              the slot length. The slot length is the maximum frame time
+ *              of all participating devices; the device measurement (incl.
+ *              the read-out) finishes within its frame time.
+ *
+ *              A device is only triggered at the beginning of its slot if all
+ *              other devices are idle. Otherwise the frame is skipped and the
+ *              interference is flagged for the device. Also, the completion
+ *              of each frame is checked against the end of its slot.
+ *
+ *              The achieved frame rate and the interference flags are
+ *              recorded per device. They are reported via #print whenever a
+ *              device leaves the orchestrated measurement and are available
+ *              while running via the orchestrator statistics command of the
+ *              serial interface (#CMD_ORCHESTRATOR_STATS).
+ *
+ * @addtogroup  core_orchestrator
+ * @{
+ *****************************************************************************/
+
+#include "explorer_types.h"
+
+/*! Interference flags of orchestrated devices. */
+typedef enum orchestrator_flags_t
+{
+    /*! No interference detected. */
+    ORCHESTRATOR_FLAG_NONE = 0,
+
+    /*! A frame was skipped since another device was still busy at the
+     *  beginning of the slot (i.e. overlapping read-out or laser activity
+     *  was prevented). */
+    ORCHESTRATOR_FLAG_BUSY = 1U << 0U,
+
+    /*! The API refused to trigger a frame (e.g. due to laser safety or a
+     *  pending data evaluation). */
+    ORCHESTRATOR_FLAG_REFUSED = 1U << 1U,
+
+    /*! A frame finished after the end of its slot, i.e. its read-out window
+     *  has spilled into the slot of the next device. */
+    ORCHESTRATOR_FLAG_LATE = 1U << 2U,
+
+} orchestrator_flags_t;
+
+/*! Statistics of an orchestrated device. */
+typedef struct orchestrator_stats_t
+{
+    /*! The phase offset of the device within the common frame period in µs. */
+    uint32_t PhaseOffset;
+
+    /*! The common frame period in µs. */
+    uint32_t FramePeriod;
+
+    /*! The number of triggered frames. */
+    uint32_t Triggered;
+
+    /*! The number of finished frames. */
+    uint32_t Finished;
+
+    /*! The number of skipped frames. */
+    uint32_t Skipped;
+
+    /*! The achieved frame rate in mHz. */
+    uint32_t FrameRate;
+
+    /*! The accumulated interference flags; see #orchestrator_flags_t. */
+    uint8_t Flags;
+
+} orchestrator_stats_t;
+
+/*!***************************************************************************
+ * @brief   Determines whether the orchestrator is used for timer measurements.
+ * @details The orchestrator is used if enabled (#EXPLORER_FRAME_ORCHESTRATOR)
+ *          and more than a single device is initialized.
+ * @return  Returns true if timer measurements are orchestrated.
+ *****************************************************************************/
+bool ExplorerApp_IsOrchestrated(void);
+
+/*!***************************************************************************
+ * @brief   Adds a device to the orchestrated measurements.
+ * @details The slots are reassigned and the slot timer is restarted.
+ * @param   argus The Argus device handler.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t ExplorerApp_OrchestratorJoin(argus_hnd_t * argus);
+
+/*!***************************************************************************
+ * @brief   Removes a device from the orchestrated measurements.
+ * @details The device statistics are printed and the slots of the remaining
+ *          devices are reassigned.
+ * @param   argus The Argus device handler.
+ * @return  Returns true if the device was part of the orchestrated
+ *          measurements.
+ *****************************************************************************/
+bool ExplorerApp_OrchestratorLeave(argus_hnd_t * argus);
+
+/*!***************************************************************************
+ * @brief   Gets the statistics of an orchestrated device.
+ * @param   argus The Argus device handler.
+ * @param   stats The statistics to be filled.
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_INVALID_ARGUMENT if the device is not orchestrated.
+ *****************************************************************************/
+status_t ExplorerApp_OrchestratorGetStats(argus_hnd_t * argus, orchestrator_stats_t * stats);
+
+/*!***************************************************************************
+ * @brief   Gets the aggregate frame rate of all orchestrated devices.
+ * @return  Returns the sum of the achieved frame rates in mHz.
+ *****************************************************************************/
+uint32_t ExplorerApp_OrchestratorGetFrameRate(void);
+
+/*!***************************************************************************
+ * @brief   Resets the statistics of all orchestrated devices.
+ * @details The frame counters and interference flags are cleared and the
+ *          frame rates are measured from now on. The phase offsets and the
+ *          frame period are kept.
+ *****************************************************************************/
+void ExplorerApp_OrchestratorResetStats(void);
+
+/*! @} */
+#endif /* CORE_ORCHESTRATOR_H */
@@ -38,6 +38,7 @@
  * Include Files
  ******************************************************************************/
 #include "core_utils.h"
+#include "core_orchestrator.h"
 #include <assert.h>
 #include "driver/s2pi.h"
 #include "debug.h"
@@ -74,6 +75,7 @@ bool ExplorerApp_SuspendTimerMeasurement(argus_hnd_t * argus)
 
     bool resume = Argus_IsTimerMeasurementActive(argus);
     if (resume) Argus_StopMeasurementTimer(argus);
+    if (ExplorerApp_OrchestratorLeave(argus)) resume = true;
 
     while (Argus_IsDataEvaluationPending(argus))
         ExplorerApp_SwitchContext(); // let evaluation task run...
@@ -85,7 +87,9 @@ status_t ExplorerApp_StartTimerMeasurement(argus_hnd_t * argus)
 {
     assert(argus != NULL);
 
-    status_t status = Argus_StartMeasurementTimer(argus, ExplorerApp_MeasurementReadyCallback);
+    status_t status = ExplorerApp_IsOrchestrated()
+                    ? ExplorerApp_OrchestratorJoin(argus)
+                    : Argus_StartMeasurementTimer(argus, ExplorerApp_MeasurementReadyCallback);
     ExplorerApp_DisplayUnambiguousRange(argus);
     return status;
 }
@@ -94,6 +98,7 @@ status_t ExplorerApp_StopTimerMeasurement(argus_hnd_t * argus)
 {
     assert(argus != NULL);
 
+    if (ExplorerApp_OrchestratorLeave(argus)) return STATUS_OK;
     return Argus_StopMeasurementTimer(argus);
 }
 
@@ -113,6 +118,7 @@ status_t ExplorerApp_DeviceAbort(argus_hnd_t * argus)
 {
     assert(argus != NULL);
 
+    ExplorerApp_OrchestratorLeave(argus);
     return Argus_Abort(argus);
 }
 
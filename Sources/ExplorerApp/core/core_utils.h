@@ -51,7 +51,8 @@
 /*!***************************************************************************
  * @brief   Suspends the current active measurement on the device.
  * @details Suspends the currently ongoing measurements on the device by calling
- *          the #Argus_StopMeasurementTimer method. Further it checks if data
+ *          the #Argus_StopMeasurementTimer method (or removing it from the
+ *          orchestrated measurements). Further it checks if data
  *          evaluation of any raw measurement data is pending and performs a
  *          context switch to the corresponding data evaluation task in the task
  *          scheduler.
@@ -68,6 +69,9 @@ bool ExplorerApp_SuspendTimerMeasurement(argus_hnd_t * argus);
 
 /*!***************************************************************************
  * @brief   Starts the measurements.
+ * @details If multiple devices are initialized, the device joins the
+ *          orchestrated measurements (see #core_orchestrator). Otherwise,
+ *          the measurement timer of the device is started.
  * @param   argus The Argus device handler.
  * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
  *****************************************************************************/
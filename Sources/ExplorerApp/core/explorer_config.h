@@ -52,11 +52,49 @@
 
 /*!***************************************************************************
  *  The maximum number of instantiated time-of-flight sensor devices.
+ *  The actual number of devices is determined by the device discovery at
+ *  boot; the per-device memory is taken from the device arena (see
+ *  #core_arena) which is sized for this maximum. The memory of devices that
+ *  are not discovered is handed over to the SCI frame pool.
+ *  Each device adds an explorer_t and #EXPLORER_RESULT_BUFFER_COUNT result
+ *  buffers to the static RAM; projects of targets with sufficient RAM raise
+ *  the maximum via their build settings (e.g. the STM32F401RE project).
  *****************************************************************************/
 #ifndef EXPLORER_DEVICE_COUNT
 #define EXPLORER_DEVICE_COUNT    2
 #endif
 
+#if EXPLORER_DEVICE_COUNT > S2PI_SLAVE_COUNT
+#undef EXPLORER_DEVICE_COUNT
+#define EXPLORER_DEVICE_COUNT    S2PI_SLAVE_COUNT
+#endif
+
+/*!***************************************************************************
+ *  The number of measurement result buffers per device.
+ *****************************************************************************/
+#ifndef EXPLORER_RESULT_BUFFER_COUNT
+#define EXPLORER_RESULT_BUFFER_COUNT    2
+#endif
+
+/*!***************************************************************************
+ *  Enables the frame orchestrator for timer based measurements of multiple
+ *  devices, see #core_orchestrator. If disabled, each device runs an
+ *  individual measurement timer.
+ *****************************************************************************/
+#ifndef EXPLORER_FRAME_ORCHESTRATOR
+#define EXPLORER_FRAME_ORCHESTRATOR    1
+#endif
+
+/*!***************************************************************************
+ *  Enables the caching of the S2PI slave discovery results (connected slaves
+ *  and their maximum baud rates) in the flash memory, see
+ *  #ExplorerApp_DiscoverDevices. With a valid cache, a warm boot only verifies
+ *  the cached slaves once instead of searching for the baud rates.
+ *****************************************************************************/
+#ifndef EXPLORER_DISCOVERY_CACHE
+#define EXPLORER_DISCOVERY_CACHE    1
+#endif
+
 /*!***************************************************************************
  *  The minimum device ID supported;
  *  Note: skips the 0 as default device address.
@@ -47,7 +47,9 @@
  *****************************************************************************/
 
 #include "argus.h"
+#include "explorer_config.h"
 #include "sci/sci.h"
+#include "utility/time.h"
 
 /*! Command byte definitions. */
 enum ExplorerApp_SerialCommandCodes
@@ -55,8 +57,12 @@ enum ExplorerApp_SerialCommandCodes
     /*! Gets the information about current software and device
      *  (e.g. version, device id, device family, ...) */
     CMD_SOFTWARE_INFO = 0x05,
+    /*! Gets the S2PI bus statistics and the latest recorded transfers. */
+    CMD_S2PI_TRACE = 0x09,
     /*! Gets the current software version number. */
     CMD_SOFTWARE_VERSION = 0x0C,
+    /*! Gets the boot phase profile of the current or previous boot. */
+    CMD_BOOT_PROFILE = 0x0D,
     /*! Gets the current module information. */
     CMD_MODULE_TYPE = 0x0E,
     /*! Gets the current module identification number. */
@@ -78,6 +84,8 @@ enum ExplorerApp_SerialCommandCodes
 
     /*! Executed a flash read/write/clear command. */
     CMD_FLASH = 0x19,
+    /*! Gets the statistics of the multi-device frame orchestrator. */
+    CMD_ORCHESTRATOR_STATS = 0x1A,
 
 //  /*! Gets a raw measurement data set containing the raw device readout samples. */
 //  CMD_MEASUREMENT_DATA_RAW = 0x30,
@@ -187,6 +195,19 @@ typedef enum data_output_mode_t
 
 } data_output_mode_t;
 
+/*! The results of the S2PI slave discovery, see #ExplorerApp_DiscoverDevices. */
+typedef struct explorer_discovery_t
+{
+    /*! The bit mask of the S2PI slaves with a connected device,
+     *  i.e. bit n is set if a device is connected to slave n. */
+    uint32_t Slaves;
+
+    /*! The maximum S2PI baud rate in bps that passed the integrity check,
+     *  indexed by the S2PI slave. */
+    uint32_t BaudRate[EXPLORER_DEVICE_ID_MAX + 1];
+
+} explorer_discovery_t;
+
 /*! AFBR-S50 Explorer Application configuration data. */
 typedef struct explorer_cfg_t
 {
@@ -213,8 +234,48 @@ typedef struct explorer_t
     /*! A pointer to the AFBR-S50 API handle that represent a physical device. */
     argus_hnd_t * Argus;
 
+    /*! The time of the last ping or activity of the device (idle task). */
+    ltc_t PingTime;
+
 } explorer_t;
 
+/*! Buffer status type. */
+typedef enum buffer_status_t
+{
+    /*! Data buffer empty. Ready to write. */
+    BUFFER_EMTPY = 0,
+
+    /*! Data buffer is currently processed. */
+    BUFFER_BUSY = 1,
+
+    /*! Data buffer is full. Ready to read. */
+    BUFFER_FULL = 2,
+
+    /*! An error occurred and needs to be handled. */
+    BUFFER_ERROR = -1,
+
+} buffer_status_t;
+
+/*! Buffer structure for measurement results. */
+typedef struct argus_resultsbuffer_t
+{
+    /*! The device ID associated with the buffer. */
+    sci_device_t deviceID;
+
+    /*! The current buffer status. */
+    buffer_status_t Status;
+
+    /*! The data output mode to be used for this buffer. */
+    data_output_mode_t DataOutputMode;
+
+    /*! The measurement results data structure. */
+    argus_results_t Result;
+
+    /*! The debug measurement results data structure. */
+    argus_results_debug_t DebugResults;
+
+} argus_resultsbuffer_t;
+
 
 /*! @} */
 #endif /* EXPLORER_API_TYPES_H */
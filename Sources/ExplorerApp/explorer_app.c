@@ -38,6 +38,7 @@
  * Include Files
  ******************************************************************************/
 #include "core/core_device.h"
+#include "core/core_arena.h"
 #include "core/core_flash.h"
 #include "core/core_utils.h"
 #include "api/explorer_api.h"
@@ -56,6 +57,7 @@
 #include "driver/MKL46Z/slcd.h"
 #endif
 #include "debug.h"
+#include "boot_profile.h"
 
 #include <assert.h>
 #include <string.h>
@@ -123,10 +125,18 @@ status_t ExplorerApp_Init()
 #endif
 
     /* Initialize Devices */
+    int32_t phase = BootProfile_Begin(BOOT_PHASE_DISCOVERY, 0);
+    const uint32_t slaves = ExplorerApp_DiscoverDevices();
+    BootProfile_End(phase);
+
     uint8_t devicesFound = 0;
     for (uint8_t deviceID = 1; deviceID <= EXPLORER_DEVICE_ID_MAX; deviceID++)
     {
+        if (!(slaves & (1U << deviceID))) continue;
+
+        phase = BootProfile_Begin(BOOT_PHASE_DEVICE, deviceID);
         status = ExplorerApp_InitExplorer(deviceID);
+        BootProfile_End(phase);
         if (status == STATUS_OK)
         {
             devicesFound++;
@@ -141,7 +151,9 @@ status_t ExplorerApp_Init()
     }
 
     /* Initialize the systems communication interface. */
+    phase = BootProfile_Begin(BOOT_PHASE_SCI, 0);
     status = ExplorerApp_InitCommands();
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         assert(0);
@@ -149,13 +161,22 @@ status_t ExplorerApp_Init()
     }
 
     /* Initialize the AFBR-S50 Explorer task scheduler. */
+    phase = BootProfile_Begin(BOOT_PHASE_TASKS, 0);
     status = ExplorerApp_InitTasks();
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         assert(0);
         return status;
     }
 
+    /* Hand the memory of the devices that are not connected to the SCI. */
+    size_t size = 0;
+    void * mem = ExplorerApp_ArenaSeal(&size);
+    uint32_t frames = SCI_AddTxFrameMemory(mem, size);
+    print("Devices: %d found, %d additional SCI frames (%d bytes)",
+          devicesFound, frames, (uint32_t)size);
+
     return status;
 }
 
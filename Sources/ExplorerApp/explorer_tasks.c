@@ -38,6 +38,7 @@
  * Include Files
  ******************************************************************************/
 #include "core/core_device.h"
+#include "core/core_arena.h"
 #include "core/core_cfg.h"
 #include "core/explorer_config.h"
 #include "api/explorer_api.h"
@@ -47,6 +48,8 @@
 #include "sci/sci.h"
 #include "tasks/task_scheduler.h"
 #include "debug.h"
+#include "boot_profile.h"
+#include "s2pi_trace.h"
 
 #if defined(CPU_MKL46Z256VLH4) || defined(CPU_MKL46Z256VLL4) || defined(CPU_MKL46Z256VMC4) || defined(CPU_MKL46Z256VMP4)
 #include "driver/MKL46Z/slcd.h"
@@ -61,48 +64,8 @@
  * Definitions
  ******************************************************************************/
 
-/*! Buffer status type. */
-typedef enum buffer_status_t
-{
-    /*! Data buffer empty. Ready to write. */
-    BUFFER_EMTPY = 0,
-
-    /*! Data buffer is currently processed. */
-    BUFFER_BUSY = 1,
-
-    /*! Data buffer is full. Ready to read. */
-    BUFFER_FULL = 2,
-
-    /*! An error occurred and needs to be handled. */
-    BUFFER_ERROR = -1,
-
-} buffer_status_t;
-
-/*! Buffer structure for measurement results. */
-typedef struct argus_resultsbuffer_t
-{
-    /*! The device ID associated with the buffer. */
-    sci_device_t deviceID;
-
-    /*! The current buffer status. */
-    buffer_status_t Status;
-
-    /*! The data output mode to be used for this buffer. */
-    data_output_mode_t DataOutputMode;
-
-    /*! The measurement results data structure. */
-    argus_results_t Result;
-
-    /*! The debug measurement results data structure. */
-    argus_results_debug_t DebugResults;
-
-} argus_resultsbuffer_t;
-
-/*! Size of the Argus results data buffer. */
-#define ARGUSRESULTBUFFER_SIZE (2U * EXPLORER_DEVICE_COUNT)
-
 /*! Size of the event queue. */
-#define EVENTQ_SIZE (2U + 2U * EXPLORER_DEVICE_COUNT)
+#define EVENTQ_SIZE (2U + EXPLORER_RESULT_BUFFER_COUNT * EXPLORER_DEVICE_COUNT)
 
 /*! The period to trigger a SPI ping signal to the device. */
 #define PING_PERIOD_MS  333U
@@ -132,7 +95,6 @@ typedef struct argus_resultsbuffer_t
 
 typedef struct idle_event_t
 {
-    ltc_t PingTime;
     status_t Status;
 
 } idle_event_t;
@@ -173,6 +135,12 @@ static void SCI_ErrorCallback(status_t status);
 
 static scheduler_t * myScheduler = NULL;
 
+/*! The measurement result buffers; allocated from the device arena. */
+static argus_resultsbuffer_t * myResultBuffers = NULL;
+
+/*! The number of measurement result buffers. */
+static uint8_t myResultBufferCount = 0;
+
 /* Event Queues */
 static task_event_t EventQ_Error[EVENTQ_SIZE] = {0};
 static task_event_t EventQ_Idle[EVENTQ_SIZE] = {0};
@@ -191,6 +159,13 @@ status_t ExplorerApp_InitTasks()
     assert(myScheduler != NULL);
     if (myScheduler == NULL) return ERROR_FAIL;
 
+    /* Allocate the result buffers for the discovered devices. */
+    const uint8_t count = EXPLORER_RESULT_BUFFER_COUNT * ExplorerApp_GetInitializedExplorerCount();
+    myResultBuffers = ExplorerApp_ArenaAlloc(count * sizeof(argus_resultsbuffer_t));
+    assert(myResultBuffers != NULL);
+    if (myResultBuffers == NULL) return ERROR_FAIL;
+    myResultBufferCount = count;
+
     /* Add tasks. */
     status_t
     status = Scheduler_AddTask(myScheduler, (task_function_t)Task_Error, TASK_ERROR, EventQ_Error,
@@ -256,15 +231,13 @@ static void Task_EvaluateMeasurementData(argus_hnd_t * argus)
     assert(argus != NULL);
     DEBUG_TASK_EVALUATEDATA_ENTER;
 
-    static argus_resultsbuffer_t buffer[ARGUSRESULTBUFFER_SIZE] = {{0}};
-
     /* Find free data buffer. */
     argus_resultsbuffer_t * buf = 0;
-    for(uint8_t i = 0; i < ARGUSRESULTBUFFER_SIZE; ++i)
+    for(uint8_t i = 0; i < myResultBufferCount; ++i)
     {
-        if(buffer[i].Status == BUFFER_EMTPY)
+        if(myResultBuffers[i].Status == BUFFER_EMTPY)
         {
-            buf = &buffer[i];
+            buf = &myResultBuffers[i];
             break;
         }
     }
@@ -284,6 +257,9 @@ static void Task_EvaluateMeasurementData(argus_hnd_t * argus)
     buf->Status = BUFFER_FULL;
     buf->deviceID = explorer->Configuration.SPISlave;
 
+    /* All S2PI transfers of the frame are done; count them as one frame. */
+    S2PITrace_MarkFrame(explorer->Configuration.SPISlave);
+
     Scheduler_PostEvent(myScheduler, TASK_SEND_DAT, buf);
 
     DEBUG_TASK_EVALUATEDATA_LEAVE;
@@ -332,6 +308,13 @@ static void Task_SendMeasurementData(argus_resultsbuffer_t * buffer)
             OnError(ERROR_FAIL, "Invalid Data Output Mode!");
     }
 
+    /* The first measurement data frame completes the boot phase record. */
+    if (BootProfile_IsRecording())
+    {
+        BootProfile_Event(BOOT_PHASE_FIRST_FRAME, buffer->deviceID);
+        BootProfile_Stop();
+    }
+
     buffer->Status = BUFFER_EMTPY;
     DEBUG_TASK_SENDRESULTS_LEAVE;
 }
@@ -393,14 +376,14 @@ static void Task_Idle(idle_event_t * e)
         }
 
         /* Trigger a ping from time to time if the device is idle
-         * Disable the ping if in DEBUG mode. */
+         * Disable the ping if in DEBUG mode.
+         * Each device has its own ping slot. */
         bool isDbgModeEnabled = ExplorerApp_GetDebugModeEnabled(explorer);
         if ((!isDbgModeEnabled) && (status == STATUS_IDLE))
         {
-            uint32_t timeout = PING_PERIOD_MS / devCount;
-            if (Time_CheckTimeoutMSec(&e->PingTime, timeout))
+            if (Time_CheckTimeoutMSec(&explorer->PingTime, PING_PERIOD_MS))
             {
-                Time_GetNow(&e->PingTime);
+                Time_GetNow(&explorer->PingTime);
 
                 status = Argus_Ping(explorer->Argus);
                 if (status < STATUS_OK)
@@ -411,7 +394,7 @@ static void Task_Idle(idle_event_t * e)
         }
         else
         {
-            Time_GetNow(&e->PingTime);
+            Time_GetNow(&explorer->PingTime);
         }
 
         if (status != ERROR_NOT_INITIALIZED) foundActiveDevice = true;
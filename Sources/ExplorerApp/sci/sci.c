@@ -125,6 +125,11 @@ status_t SCI_Init(void)
     return status;
 }
 
+uint32_t SCI_AddTxFrameMemory(void * mem, size_t size)
+{
+    return SCI_DataLink_AddTxFrames(mem, size);
+}
+
 void SCI_SetRxCommandCallback(sci_rx_cmd_cb_t cb)
 {
     SCI_RxCallback = cb;
@@ -166,6 +166,20 @@ typedef void (*sci_error_cb_t)(status_t status);
  *****************************************************************************/
 status_t SCI_Init(void);
 
+/*!***************************************************************************
+ * @brief   Adds memory for additional TX frames to the SCI frame pool.
+ *
+ * @details The memory block (e.g. the unused part of a static buffer) is
+ *          split into additional TX frames which are used once all static
+ *          TX frames are occupied. The memory can only be added once after
+ *          #SCI_Init and must stay valid forever.
+ *
+ * @param   mem The memory block for the additional frames.
+ * @param   size The size of the memory block in bytes.
+ * @return  Returns the number of additional TX frames.
+ *****************************************************************************/
+uint32_t SCI_AddTxFrameMemory(void * mem, size_t size);
+
 /*!***************************************************************************
  * @brief   Installs a callback routine for command received event.
  *
@@ -132,6 +132,9 @@ static sci_frame_queue_t SCI_RxFrameQueue;
 /*! The data frame queue for tx frames. */
 static sci_frame_queue_t SCI_TxFrameQueue;
 
+/*! The data frame queue for additional tx frames, see #SCI_DataLink_AddTxFrames. */
+static sci_frame_queue_t SCI_TxExtFrameQueue;
+
 /*! Callback function pointer for received frame event. */
 sci_rx_cmd_cb_t SCI_RxCallback = 0;
 
@@ -168,6 +171,11 @@ status_t SCI_DataLink_Init(void)
     SCI_TxFrameQueue.Buff = SCI_FrameBuffer + SCI_FRAME_BUF_RX_CT;
     SCI_TxFrameQueue.Size = SCI_FRAME_BUF_TX_CT;
 
+    SCI_TxExtFrameQueue.Load = 0;
+    SCI_TxExtFrameQueue.Head = 0;
+    SCI_TxExtFrameQueue.Buff = 0;
+    SCI_TxExtFrameQueue.Size = 0;
+
     SCI_CRC8_Init();
 
 #if AFBR_SCI_USB
@@ -184,6 +192,42 @@ status_t SCI_DataLink_Init(void)
     return status;
 }
 
+uint32_t SCI_DataLink_AddTxFrames(void * mem, size_t size)
+{
+    assert(SCI_TxExtFrameQueue.Size == 0);
+    if (mem == 0 || SCI_TxExtFrameQueue.Size != 0) return 0;
+
+    /* Align the frame control blocks. */
+    uintptr_t addr = (uintptr_t)mem;
+    uintptr_t offset = (sizeof(void*) - (addr % sizeof(void*))) % sizeof(void*);
+    if (size <= offset) return 0;
+    size -= offset;
+
+    /* Frame control blocks first, followed by the data buffers. */
+    const uint32_t count = (uint32_t)(size / (sizeof(sci_frame_t) + SCI_FRAME_SIZE));
+    if (count == 0) return 0;
+
+    sci_frame_t * frames = (sci_frame_t *)(addr + offset);
+    uint8_t * data = (uint8_t *)(frames + count);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        frames[i].Buffer = data + (i * SCI_FRAME_SIZE);
+        frames[i].RdPtr = 0;
+        frames[i].WrPtr = 0;
+        frames[i].Next = 0;
+    }
+
+    IRQ_LOCK();
+    SCI_TxExtFrameQueue.Load = 0;
+    SCI_TxExtFrameQueue.Head = frames;
+    SCI_TxExtFrameQueue.Buff = frames;
+    SCI_TxExtFrameQueue.Size = count;
+    IRQ_UNLOCK();
+
+    return count;
+}
+
 
 /*******************************************************************************
  * IRQ handler
@@ -374,7 +418,13 @@ static inline void SCI_DataLink_ReleaseFrame(sci_frame_t * frame)
         frame->WrPtr = 0;
         frame->RdPtr = 0;
         frame->Next = 0;
-        if (frame < SCI_FrameBuffer + SCI_FRAME_BUF_RX_CT)
+        if (frame >= SCI_TxExtFrameQueue.Buff &&
+            frame < SCI_TxExtFrameQueue.Buff + SCI_TxExtFrameQueue.Size)
+        {
+            assert(SCI_TxExtFrameQueue.Load);
+            SCI_TxExtFrameQueue.Load--;
+        }
+        else if (frame < SCI_FrameBuffer + SCI_FRAME_BUF_RX_CT)
         {
             assert(SCI_RxFrameQueue.Load);
             SCI_RxFrameQueue.Load--;
@@ -445,7 +495,8 @@ sci_frame_t * SCI_DataLink_RequestTxFrame(bool queueStartByte)
     ltc_t start = { 0 };
     Time_GetNow(&start);
 
-    while ((frame = SCI_DataLink_RequestFrame(&SCI_TxFrameQueue)) == 0)
+    while ((frame = SCI_DataLink_RequestFrame(&SCI_TxFrameQueue)) == 0 &&
+           (frame = SCI_DataLink_RequestFrame(&SCI_TxExtFrameQueue)) == 0)
     {
 #if AFBR_SCI_USB
         if (USB_CancelIfTimeOutElapsed())
@@ -91,6 +91,18 @@
  *****************************************************************************/
 status_t SCI_DataLink_Init(void);
 
+/*!***************************************************************************
+ * @brief   Adds memory for additional TX frames.
+ * @details The memory block is split into frame control blocks and data
+ *          buffers of #SCI_FRAME_SIZE bytes. The additional frames are used
+ *          once all static TX frames are occupied. The memory can only be
+ *          added once after #SCI_DataLink_Init and must stay valid forever.
+ * @param   mem The memory block for the additional frames.
+ * @param   size The size of the memory block in bytes.
+ * @return  Returns the number of additional TX frames.
+ *****************************************************************************/
+uint32_t SCI_DataLink_AddTxFrames(void * mem, size_t size);
+
 /*!***************************************************************************
  * @brief   Checks the CRC checksum for a RX frame.
  * @param   frame The RX frame which requires CRC checking.
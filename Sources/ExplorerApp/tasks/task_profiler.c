@@ -48,7 +48,7 @@
 #include <stdint.h>
 #include "task_status.h"
 #include "debug.h"
-#include "utility/time.h"
+#include "hr_clock.h"
 
 /*******************************************************************************
  * Definitions
@@ -62,8 +62,8 @@ typedef struct taskprofileinfo_t
 {
     uint32_t ExecutionCount;
     uint32_t FailedExecutionCount;
-    ltc_t ExecutionTime;
-    ltc_t LastStartTimeStamp;
+    uint64_t ExecutionTicks;
+    uint64_t LastStartTicks;
 } taskprofileinfo_t;
 
 /*******************************************************************************
@@ -99,15 +99,13 @@ static void ProfilerLog(char type, char id)
 void OnTaskStart(uint32_t priority)
 {
     ProfilerLog('S', (char)('a' + priority));
-    Time_GetNow(&(myTPI[priority].LastStartTimeStamp));
+    myTPI[priority].LastStartTicks = HRClock_Now();
 }
 void OnTaskFinished(uint32_t priority, status_t status)
 {
     if(status == STATUS_OK)
     {
-        ltc_t t = {0};
-        Time_GetElapsed(&t, &(myTPI[priority].LastStartTimeStamp));
-        Time_Add(&(myTPI[priority].ExecutionTime), &(myTPI[priority].ExecutionTime), &t);
+        myTPI[priority].ExecutionTicks += HRClock_Now() - myTPI[priority].LastStartTicks;
         myTPI[priority].ExecutionCount++;
         ProfilerLog('P', (char)('a' + priority));
     }
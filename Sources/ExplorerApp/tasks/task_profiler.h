@@ -50,8 +50,8 @@
  *
  *              This module is under construction and experimental.
  *              A function is called before and after executing a task. The
- *              consumed time is measured and summed via the platform time.h
- *              utility module. For now, a debugger breakpoint can be used to
+ *              consumed time is measured and summed in ticks of the high
+ *              resolution clock (see #hr_clock). For now, a debugger breakpoint can be used to
  *              read the data from the device...
  *
  * @addtogroup  profiler
@@ -0,0 +1,355 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides the multiplexing of the SCI streams of several serial
+ *              ports into a shared memory frame ring on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "aggregator.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The size of the receive buffer, i.e. the maximum chunk read at once. */
+#define AGGREGATOR_RX_SIZE 65536U
+
+/*! The maximum length of a port path. */
+#define AGGREGATOR_PATH_SIZE 128U
+
+/*! The state of a port. */
+typedef struct aggregator_port_t
+{
+    /*! The path of the port. */
+    char Path[AGGREGATOR_PATH_SIZE];
+
+    /*! The baud rate; 0 to keep the setting. */
+    uint32_t Baudrate;
+
+    /*! The file descriptor; < 0 if disconnected. */
+    int Fd;
+
+    /*! The index of the port. */
+    uint16_t Index;
+
+    /*! The time in ns of the last read, i.e. the receive time of the frames
+     *  that are completed by the current chunk. */
+    uint64_t Time;
+
+    /*! The time in ns of the next reopen attempt. */
+    uint64_t Reopen;
+
+    /*! The SCI decoder. */
+    sci_codec_t Codec;
+
+    /*! The decoder buffer. */
+    uint8_t Frame[AGGREGATOR_FRAME_SIZE];
+
+    /*! The statistics. */
+    aggregator_stats_t Stats;
+
+} aggregator_port_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The ports. */
+static aggregator_port_t myPorts[AGGREGATOR_MAX_PORTS];
+
+/*! The number of ports. */
+static uint32_t myPortCount = 0;
+
+/*! The epoll instance; < 0 if not initialized. */
+static int myEpoll = -1;
+
+/*! The frame ring to publish to. */
+static frame_ring_t * myRing = 0;
+
+/*! Determines whether all frames are published. */
+static bool isAllFrames = false;
+
+/*! The receive buffer. */
+static uint8_t myRxBuffer[AGGREGATOR_RX_SIZE];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static speed_t GetSpeed(uint32_t baudrate)
+{
+    switch (baudrate)
+    {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 500000: return B500000;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        case 3000000: return B3000000;
+        case 4000000: return B4000000;
+        default: return B0;
+    }
+}
+
+static void OnFrame(void * param, uint8_t cmd, uint8_t device,
+                    uint8_t const * data, uint32_t size)
+{
+    aggregator_port_t * port = param;
+
+    if (!isAllFrames && (cmd < AGGREGATOR_CMD_DATA_FIRST || cmd > AGGREGATOR_CMD_DATA_LAST))
+    {
+        port->Stats.Filtered++;
+        return;
+    }
+
+    const frame_ring_entry_t entry = {
+        .Time = port->Time,
+        .Port = port->Index,
+        .Command = cmd,
+        .Device = device,
+        .Length = size,
+    };
+
+    if (FrameRing_Publish(myRing, &entry, data) == STATUS_OK)
+        port->Stats.Published++;
+    else
+        port->Stats.Dropped++;
+}
+
+static status_t OpenPort(aggregator_port_t * port)
+{
+    const int fd = open(port->Path, O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return ERROR_FAIL;
+
+    /* Raw mode for terminals; other files are read as is. */
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        tio.c_cflag |= CLOCAL | CREAD;
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        if (port->Baudrate != 0) cfsetspeed(&tio, GetSpeed(port->Baudrate));
+
+        if (tcsetattr(fd, TCSANOW, &tio) < 0)
+        {
+            close(fd);
+            return ERROR_FAIL;
+        }
+        tcflush(fd, TCIFLUSH);
+    }
+
+    struct epoll_event ev = { .events = EPOLLIN, .data.u32 = port->Index };
+    if (epoll_ctl(myEpoll, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        close(fd);
+        return ERROR_FAIL;
+    }
+
+    SCI_Codec_Reset(&port->Codec);
+    port->Fd = fd;
+    port->Stats.isConnected = true;
+    return STATUS_OK;
+}
+
+static void ClosePort(aggregator_port_t * port)
+{
+    if (port->Fd >= 0)
+    {
+        /* Closing the descriptor removes it from the epoll set. */
+        close(port->Fd);
+        port->Fd = -1;
+    }
+    port->Stats.isConnected = false;
+    port->Reopen = Now() + AGGREGATOR_REOPEN_INTERVAL * 1000000ULL;
+}
+
+static void ReadPort(aggregator_port_t * port)
+{
+    const ssize_t n = read(port->Fd, myRxBuffer, sizeof(myRxBuffer));
+
+    if (n > 0)
+    {
+        port->Time = Now();
+        port->Stats.Bytes += (uint64_t)n;
+        port->Stats.Reads++;
+        SCI_Codec_Decode(&port->Codec, myRxBuffer, (uint32_t)n);
+    }
+    else if (n == 0 || (errno != EAGAIN && errno != EINTR))
+    {
+        /* End of file or I/O error, e.g. the device has been unplugged. */
+        ClosePort(port);
+    }
+}
+
+static void ReopenPorts(uint64_t now)
+{
+    for (uint32_t i = 0; i < myPortCount; ++i)
+    {
+        aggregator_port_t * port = &myPorts[i];
+        if (port->Fd >= 0 || now < port->Reopen) continue;
+
+        if (OpenPort(port) == STATUS_OK)
+            port->Stats.Reconnects++;
+        else
+            port->Reopen = now + AGGREGATOR_REOPEN_INTERVAL * 1000000ULL;
+    }
+}
+
+static int32_t GetTimeout(int32_t timeout, uint64_t now)
+{
+    for (uint32_t i = 0; i < myPortCount; ++i)
+    {
+        if (myPorts[i].Fd >= 0) continue;
+
+        const uint64_t wait = myPorts[i].Reopen > now
+                              ? (myPorts[i].Reopen - now + 999999U) / 1000000U : 0;
+        if (timeout < 0 || wait < (uint64_t)timeout) timeout = (int32_t)wait;
+    }
+    return timeout;
+}
+
+status_t Aggregator_Init(frame_ring_t * ring, bool allFrames)
+{
+    if (ring == 0 || ring->Header == 0) return ERROR_INVALID_ARGUMENT;
+    if (myEpoll >= 0) Aggregator_Deinit();
+
+    myEpoll = epoll_create1(EPOLL_CLOEXEC);
+    if (myEpoll < 0) return ERROR_FAIL;
+
+    myRing = ring;
+    isAllFrames = allFrames;
+    myPortCount = 0;
+    return STATUS_OK;
+}
+
+void Aggregator_Deinit(void)
+{
+    for (uint32_t i = 0; i < myPortCount; ++i)
+    {
+        if (myPorts[i].Fd >= 0) close(myPorts[i].Fd);
+        myPorts[i].Fd = -1;
+    }
+    myPortCount = 0;
+
+    if (myEpoll >= 0) close(myEpoll);
+    myEpoll = -1;
+    myRing = 0;
+}
+
+int32_t Aggregator_AddPort(char const * path, uint32_t baudrate)
+{
+    if (myEpoll < 0) return ERROR_NOT_INITIALIZED;
+    if (path == 0 || strlen(path) >= AGGREGATOR_PATH_SIZE) return ERROR_INVALID_ARGUMENT;
+    if (baudrate != 0 && GetSpeed(baudrate) == B0) return ERROR_INVALID_ARGUMENT;
+    if (myPortCount >= AGGREGATOR_MAX_PORTS) return ERROR_OUT_OF_RANGE;
+
+    aggregator_port_t * port = &myPorts[myPortCount];
+    memset(port, 0, sizeof(*port));
+    strcpy(port->Path, path);
+    port->Baudrate = baudrate;
+    port->Index = (uint16_t)myPortCount;
+    port->Fd = -1;
+    SCI_Codec_Init(&port->Codec, port->Frame, sizeof(port->Frame), OnFrame, port);
+
+    if (OpenPort(port) < STATUS_OK) ClosePort(port);
+    return (int32_t)myPortCount++;
+}
+
+uint32_t Aggregator_GetPortCount(void)
+{
+    return myPortCount;
+}
+
+status_t Aggregator_Poll(int32_t timeout)
+{
+    if (myEpoll < 0) return ERROR_NOT_INITIALIZED;
+
+    struct epoll_event events[AGGREGATOR_MAX_PORTS];
+    const int n = epoll_wait(myEpoll, events, AGGREGATOR_MAX_PORTS, GetTimeout(timeout, Now()));
+    if (n < 0 && errno != EINTR) return ERROR_FAIL;
+
+    for (int i = 0; i < n; ++i)
+    {
+        aggregator_port_t * port = &myPorts[events[i].data.u32];
+        if (port->Fd < 0) continue;
+
+        if (events[i].events & EPOLLIN)
+            ReadPort(port);
+        else if (events[i].events & (EPOLLHUP | EPOLLERR))
+            ClosePort(port);
+    }
+
+    ReopenPorts(Now());
+    return STATUS_OK;
+}
+
+status_t Aggregator_GetStats(uint32_t port, aggregator_stats_t * stats)
+{
+    if (port >= myPortCount || stats == 0) return ERROR_INVALID_ARGUMENT;
+
+    *stats = myPorts[port].Stats;
+    stats->Codec = myPorts[port].Codec.Stats;
+    return STATUS_OK;
+}
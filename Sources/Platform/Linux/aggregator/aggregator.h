@@ -0,0 +1,166 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides the multiplexing of the SCI streams of several serial
+ *              ports into a shared memory frame ring on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef AGGREGATOR_H
+#define AGGREGATOR_H
+
+/*!***************************************************************************
+ * @defgroup    aggregator SCI Aggregator
+ * @ingroup     platform
+ * @brief       Multi-Port SCI Aggregator
+ * @details     Multiplexes the serial ports (e.g. USB CDC devices) of many
+ *              ExplorerApp boards in a single thread with epoll: the data of
+ *              each readable port is read in large chunks, decoded
+ *              incrementally by a per-port \link sci_codec SCI decoder\endlink
+ *              and the decoded frames are published to a \link frame_ring
+ *              shared memory frame ring\endlink that any number of local
+ *              consumers read.
+ *
+ *              By default, only the measurement data frames (commands
+ *              #AGGREGATOR_CMD_DATA_FIRST to #AGGREGATOR_CMD_DATA_LAST) are
+ *              published. The ports are opened in raw mode; if a port is
+ *              disconnected (e.g. the USB device is unplugged), it is closed
+ *              and reopened periodically until the device is back.
+ *
+ *              The aggregator does not send to the ports, i.e. the boards
+ *              must be configured to stream measurement data, e.g. by a
+ *              start command from another application before.
+ *
+ *              The module is not thread safe; all functions must be called
+ *              from the same thread.
+ *
+ * @addtogroup  aggregator
+ * @{
+ *****************************************************************************/
+
+#include "frame_ring.h"
+#include "sci_codec.h"
+
+/*! The maximum number of ports. */
+#define AGGREGATOR_MAX_PORTS 64U
+
+/*! The maximum size of an unescaped frame. */
+#define AGGREGATOR_FRAME_SIZE 4096U
+
+/*! The interval in milliseconds to reopen disconnected ports. */
+#define AGGREGATOR_REOPEN_INTERVAL 1000U
+
+/*! The first measurement data command (the reserved raw data command). */
+#define AGGREGATOR_CMD_DATA_FIRST 0x30U
+
+/*! The last measurement data command (CMD_MEASUREMENT_DATA_1D). */
+#define AGGREGATOR_CMD_DATA_LAST 0x36U
+
+/*! The statistics of a port. */
+typedef struct aggregator_stats_t
+{
+    /*! The number of bytes read from the port. */
+    uint64_t Bytes;
+
+    /*! The number of frames that have been published. */
+    uint64_t Published;
+
+    /*! The number of valid frames that have been filtered out. */
+    uint64_t Filtered;
+
+    /*! The number of frames that did not fit into a ring slot. */
+    uint64_t Dropped;
+
+    /*! The number of read() calls. */
+    uint64_t Reads;
+
+    /*! The number of times the port has been reopened. */
+    uint32_t Reconnects;
+
+    /*! Determines whether the port is currently open. */
+    bool isConnected;
+
+    /*! The statistics of the SCI decoder. */
+    sci_codec_stats_t Codec;
+
+} aggregator_stats_t;
+
+/*!***************************************************************************
+ * @brief   Initializes the aggregator.
+ * @param   ring The frame ring to publish to; created by the caller.
+ * @param   allFrames Publishes all frames instead of the measurement data
+ *                    frames only.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Aggregator_Init(frame_ring_t * ring, bool allFrames);
+
+/*!***************************************************************************
+ * @brief   Closes all ports and releases the resources.
+ *****************************************************************************/
+void Aggregator_Deinit(void);
+
+/*!***************************************************************************
+ * @brief   Adds a serial port.
+ * @details If the port cannot be opened, it is retried periodically.
+ * @param   path The path of the port, e.g. "/dev/ttyACM0". Other character
+ *               devices and FIFOs are read as is.
+ * @param   baudrate The baud rate of a UART; 0 to keep the setting.
+ * @return  Returns the port index (>= 0) or an error status (< 0).
+ *****************************************************************************/
+int32_t Aggregator_AddPort(char const * path, uint32_t baudrate);
+
+/*!***************************************************************************
+ * @brief   Gets the number of added ports.
+ * @return  Returns the number of ports.
+ *****************************************************************************/
+uint32_t Aggregator_GetPortCount(void);
+
+/*!***************************************************************************
+ * @brief   Waits for data of any port and processes it.
+ * @param   timeout The maximum time to wait in milliseconds; < 0 to wait
+ *                  forever (or until a port is to be reopened).
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Aggregator_Poll(int32_t timeout);
+
+/*!***************************************************************************
+ * @brief   Gets the statistics of a port.
+ * @param   port The port index.
+ * @param   stats The statistics.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Aggregator_GetStats(uint32_t port, aggregator_stats_t * stats);
+
+/*! @} */
+#endif /* AGGREGATOR_H */
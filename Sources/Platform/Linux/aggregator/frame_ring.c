@@ -0,0 +1,330 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides a lock-free single producer, multiple consumer ring of
+ *              SCI frames in shared memory on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "frame_ring.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline frame_ring_slot_t * GetSlot(frame_ring_header_t * header, uint64_t seq)
+{
+    uint8_t * slots = (uint8_t *)(header + 1);
+    return (frame_ring_slot_t *)(slots + (seq & (header->SlotCount - 1U)) * header->SlotSize);
+}
+
+static bool IsValidLayout(uint32_t slots, uint32_t slotSize)
+{
+    return slots > 0 && (slots & (slots - 1U)) == 0
+           && slotSize > sizeof(frame_ring_slot_t) && (slotSize & 0x07U) == 0;
+}
+
+static void SetName(frame_ring_t * ring, char const * name)
+{
+    strncpy(ring->Name, name, sizeof(ring->Name) - 1U);
+    ring->Name[sizeof(ring->Name) - 1U] = '\0';
+}
+
+status_t FrameRing_Create(frame_ring_t * ring, char const * name,
+                          uint32_t slots, uint32_t slotSize)
+{
+    if (ring == 0 || name == 0) return ERROR_INVALID_ARGUMENT;
+    if (strlen(name) >= FRAME_RING_NAME_SIZE) return ERROR_INVALID_ARGUMENT;
+    if (!IsValidLayout(slots, slotSize)) return ERROR_INVALID_ARGUMENT;
+
+    memset(ring, 0, sizeof(*ring));
+    SetName(ring, name);
+    ring->Size = sizeof(frame_ring_header_t) + (uint64_t)slots * slotSize;
+
+    /* Replace a stale ring, e.g. from a crashed daemon; consumers that still
+     * map the old object keep reading it until they reopen. */
+    shm_unlink(name);
+    const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd < 0) return ERROR_FAIL;
+
+    if (ftruncate(fd, (off_t)ring->Size) < 0)
+    {
+        close(fd);
+        shm_unlink(name);
+        return ERROR_FAIL;
+    }
+
+    void * map = mmap(0, ring->Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        shm_unlink(name);
+        return ERROR_FAIL;
+    }
+
+    /* The object is zero filled, i.e. all slots have sequence number 0. The
+     * magic number is written last such that consumers see a valid ring. */
+    ring->Header = map;
+    ring->Header->Version = FRAME_RING_VERSION;
+    ring->Header->SlotCount = slots;
+    ring->Header->SlotSize = slotSize;
+    atomic_thread_fence(memory_order_release);
+    ring->Header->Magic = FRAME_RING_MAGIC;
+    ring->isOwner = true;
+    return STATUS_OK;
+}
+
+status_t FrameRing_Open(frame_ring_t * ring, char const * name)
+{
+    if (ring == 0 || name == 0) return ERROR_INVALID_ARGUMENT;
+    if (strlen(name) >= FRAME_RING_NAME_SIZE) return ERROR_INVALID_ARGUMENT;
+
+    memset(ring, 0, sizeof(*ring));
+    SetName(ring, name);
+
+    const int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+    if (fd < 0) return ERROR_FAIL;
+
+    struct stat st;
+    frame_ring_header_t header;
+    if (fstat(fd, &st) < 0 || (uint64_t)st.st_size < sizeof(header)
+        || pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+    {
+        close(fd);
+        return ERROR_FAIL;
+    }
+
+    if (header.Magic != FRAME_RING_MAGIC || header.Version != FRAME_RING_VERSION
+        || !IsValidLayout(header.SlotCount, header.SlotSize))
+    {
+        close(fd);
+        return ERROR_NOT_SUPPORTED;
+    }
+
+    ring->Size = sizeof(frame_ring_header_t) + (uint64_t)header.SlotCount * header.SlotSize;
+    if ((uint64_t)st.st_size < ring->Size)
+    {
+        close(fd);
+        return ERROR_NOT_SUPPORTED;
+    }
+
+    void * map = mmap(0, ring->Size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return ERROR_FAIL;
+
+    ring->Header = map;
+    ring->Next = atomic_load_explicit(&ring->Header->Head, memory_order_acquire);
+    return STATUS_OK;
+}
+
+void FrameRing_Close(frame_ring_t * ring)
+{
+    if (ring->Header == 0) return;
+
+    munmap(ring->Header, ring->Size);
+    if (ring->isOwner) shm_unlink(ring->Name);
+    ring->Header = 0;
+}
+
+status_t FrameRing_Publish(frame_ring_t * ring, frame_ring_entry_t const * entry,
+                           uint8_t const * data)
+{
+    frame_ring_header_t * header = ring->Header;
+    assert(header != 0);
+    assert(ring->isOwner);
+
+    if (entry->Length > header->SlotSize - sizeof(frame_ring_slot_t))
+        return ERROR_OUT_OF_RANGE;
+
+    const uint64_t seq = atomic_load_explicit(&header->Head, memory_order_relaxed);
+    frame_ring_slot_t * slot = GetSlot(header, seq);
+
+    /* Mark the slot as being written before touching the data. */
+    atomic_store_explicit(&slot->Sequence, 2U * seq + 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    slot->Time = entry->Time;
+    slot->Port = entry->Port;
+    slot->Command = entry->Command;
+    slot->Device = entry->Device;
+    slot->Length = entry->Length;
+    memcpy(slot + 1, data, entry->Length);
+
+    atomic_store_explicit(&slot->Sequence, 2U * seq + 2U, memory_order_release);
+    atomic_store_explicit(&header->Head, seq + 1U, memory_order_release);
+
+    /* Wake the blocked consumers; the sequentially consistent accesses pair
+     * with the ones in FrameRing_Wait such that no wake-up is lost. */
+    atomic_store(&header->Futex, (uint32_t)(seq + 1U));
+    if (atomic_load(&header->Waiters) > 0)
+    {
+        syscall(SYS_futex, &header->Futex, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+    }
+
+    return STATUS_OK;
+}
+
+status_t FrameRing_Read(frame_ring_t * ring, frame_ring_entry_t * entry,
+                        uint8_t * data, uint32_t size)
+{
+    frame_ring_header_t * header = ring->Header;
+    assert(header != 0);
+
+    const uint32_t capacity = header->SlotSize - (uint32_t)sizeof(frame_ring_slot_t);
+
+    for (;;)
+    {
+        const uint64_t head = atomic_load_explicit(&header->Head, memory_order_acquire);
+        if (ring->Next >= head) return ERROR_ARGUS_BUFFER_EMPTY;
+
+        /* Skip the frames that have already been overwritten. */
+        if (head - ring->Next > header->SlotCount)
+        {
+            ring->Lost += head - header->SlotCount - ring->Next;
+            ring->Next = head - header->SlotCount;
+        }
+
+        frame_ring_slot_t * slot = GetSlot(header, ring->Next);
+        const uint64_t expected = 2U * ring->Next + 2U;
+        const uint64_t seq = atomic_load_explicit(&slot->Sequence, memory_order_acquire);
+
+        if (seq == expected)
+        {
+            entry->Sequence = ring->Next;
+            entry->Time = slot->Time;
+            entry->Port = slot->Port;
+            entry->Command = slot->Command;
+            entry->Device = slot->Device;
+            entry->Length = slot->Length;
+
+            /* The length may be garbage if the slot is being overwritten. */
+            uint32_t length = entry->Length < capacity ? entry->Length : capacity;
+            if (length > size) length = size;
+            memcpy(data, slot + 1, length);
+
+            /* Verify that the slot has not been overwritten while copying. */
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->Sequence, memory_order_relaxed) == expected)
+            {
+                ring->Next++;
+                return STATUS_OK;
+            }
+        }
+
+        /* The slot has been overwritten by a newer frame. */
+        ring->Lost++;
+        ring->Next++;
+    }
+}
+
+status_t FrameRing_Wait(frame_ring_t * ring, int32_t timeout)
+{
+    frame_ring_header_t * header = ring->Header;
+    assert(header != 0);
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    if (timeout >= 0)
+    {
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+    }
+
+    for (;;)
+    {
+        if (atomic_load_explicit(&header->Head, memory_order_acquire) > ring->Next)
+            return STATUS_OK;
+
+        atomic_fetch_add(&header->Waiters, 1U);
+        const uint32_t futex = atomic_load(&header->Futex);
+        if (atomic_load(&header->Head) > ring->Next)
+        {
+            atomic_fetch_sub(&header->Waiters, 1U);
+            return STATUS_OK;
+        }
+
+        struct timespec rel;
+        struct timespec * prel = 0;
+        if (timeout >= 0)
+        {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            int64_t ns = (deadline.tv_sec - now.tv_sec) * 1000000000LL
+                         + (deadline.tv_nsec - now.tv_nsec);
+            if (ns <= 0)
+            {
+                atomic_fetch_sub(&header->Waiters, 1U);
+                return ERROR_TIMEOUT;
+            }
+            rel.tv_sec = ns / 1000000000LL;
+            rel.tv_nsec = ns % 1000000000LL;
+            prel = &rel;
+        }
+
+        /* The futex is shared between processes, i.e. no FUTEX_PRIVATE_FLAG. */
+        syscall(SYS_futex, &header->Futex, FUTEX_WAIT, futex, prel, 0, 0);
+        atomic_fetch_sub(&header->Waiters, 1U);
+    }
+}
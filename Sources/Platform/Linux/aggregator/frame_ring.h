@@ -0,0 +1,266 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides a lock-free single producer, multiple consumer ring of
+ *              SCI frames in shared memory on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+/*!***************************************************************************
+ * @defgroup    frame_ring Shared Memory Frame Ring
+ * @ingroup     aggregator
+ * @brief       Lock-Free Broadcast Ring of SCI Frames in Shared Memory
+ * @details     A POSIX shared memory object (see shm_open) that holds a
+ *              header and a power of two number of fixed size slots. The
+ *              \link aggregator aggregator\endlink is the only producer;
+ *              any number of local processes map the ring and read the
+ *              frames independently, i.e. each consumer sees every frame
+ *              (broadcast) as long as it keeps up.
+ *
+ *              The producer never waits for the consumers: frame s is
+ *              written to slot s % SlotCount, overwriting the oldest frame.
+ *              Each slot is protected by a sequence number (seqlock): it is
+ *              odd while the slot is being written and 2 * (s + 1) once
+ *              frame s is complete. A consumer copies the slot and verifies
+ *              that the sequence number did not change; if it has been
+ *              overwritten in the meantime, the consumer skips the frames
+ *              it has lost and counts them.
+ *
+ *              Consumers may busy poll (#FrameRing_Read) or block on a
+ *              futex (#FrameRing_Wait); the producer issues the wake-up
+ *              system call only if a consumer is waiting.
+ *
+ * @addtogroup  frame_ring
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_status.h"
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*! The magic number of the ring header ("SCIR"). */
+#define FRAME_RING_MAGIC 0x52494353U
+
+/*! The version of the ring layout. */
+#define FRAME_RING_VERSION 1U
+
+/*! The default number of slots. */
+#define FRAME_RING_SLOT_COUNT 4096U
+
+/*! The default slot size in bytes incl. the slot header, i.e. frames with
+ *  up to 4032 parameter bytes. */
+#define FRAME_RING_SLOT_SIZE 4096U
+
+/*! The maximum length of the shared memory object name. */
+#define FRAME_RING_NAME_SIZE 64U
+
+/*! The header of the shared memory ring. */
+typedef struct frame_ring_header_t
+{
+    /*! The magic number; #FRAME_RING_MAGIC. */
+    uint32_t Magic;
+
+    /*! The version; #FRAME_RING_VERSION. */
+    uint32_t Version;
+
+    /*! The number of slots; a power of two. */
+    uint32_t SlotCount;
+
+    /*! The size of each slot in bytes incl. the #frame_ring_slot_t header. */
+    uint32_t SlotSize;
+
+    /*! The number of published frames. */
+    _Atomic uint64_t Head;
+
+    /*! The lower 32 bits of the number of published frames; the futex word. */
+    _Atomic uint32_t Futex;
+
+    /*! The number of consumers that are blocked in #FrameRing_Wait. */
+    _Atomic uint32_t Waiters;
+
+    /*! Reserved; pads the header to a cache line. */
+    uint8_t Reserved[32];
+
+} frame_ring_header_t;
+
+/*! The header of a slot; followed by the parameter bytes. */
+typedef struct frame_ring_slot_t
+{
+    /*! The sequence number; odd while the slot is written. */
+    _Atomic uint64_t Sequence;
+
+    /*! The receive time in nanoseconds of CLOCK_MONOTONIC, i.e. the time
+     *  the chunk with the stop byte has been read from the port. */
+    uint64_t Time;
+
+    /*! The index of the port the frame has been received from. */
+    uint16_t Port;
+
+    /*! The command byte w/o the device ID flag. */
+    uint8_t Command;
+
+    /*! The device ID; 0 if not contained in the frame. */
+    uint8_t Device;
+
+    /*! The number of parameter bytes. */
+    uint32_t Length;
+
+    /*! Reserved; pads the slot header to 32 bytes. */
+    uint64_t Reserved;
+
+} frame_ring_slot_t;
+
+static_assert(sizeof(frame_ring_header_t) == 64U, "frame_ring_header_t size");
+static_assert(sizeof(frame_ring_slot_t) == 32U, "frame_ring_slot_t size");
+
+/*! A frame read from the ring. */
+typedef struct frame_ring_entry_t
+{
+    /*! The sequence number of the frame, i.e. the number of frames that
+     *  have been published before. */
+    uint64_t Sequence;
+
+    /*! The receive time in nanoseconds of CLOCK_MONOTONIC. */
+    uint64_t Time;
+
+    /*! The index of the port the frame has been received from. */
+    uint16_t Port;
+
+    /*! The command byte w/o the device ID flag. */
+    uint8_t Command;
+
+    /*! The device ID; 0 if not contained in the frame. */
+    uint8_t Device;
+
+    /*! The number of parameter bytes; may exceed the buffer size passed to
+     *  #FrameRing_Read, in which case the data is truncated. */
+    uint32_t Length;
+
+} frame_ring_entry_t;
+
+/*! A mapped frame ring; the members are private. */
+typedef struct frame_ring_t
+{
+    /*! The mapped ring header, followed by the slots. */
+    frame_ring_header_t * Header;
+
+    /*! The size of the mapping. */
+    uint64_t Size;
+
+    /*! The name of the shared memory object. */
+    char Name[FRAME_RING_NAME_SIZE];
+
+    /*! Determines whether the ring has been created, i.e. is unlinked on
+     *  close. */
+    bool isOwner;
+
+    /*! The sequence number of the next frame to be read (consumers). */
+    uint64_t Next;
+
+    /*! The number of frames that have been overwritten before they could
+     *  be read (consumers). */
+    uint64_t Lost;
+
+} frame_ring_t;
+
+/*!***************************************************************************
+ * @brief   Creates the shared memory ring (producer).
+ * @details An existing object of the same name is replaced.
+ * @param   ring The ring to be initialized.
+ * @param   name The name of the shared memory object, e.g. "/afbr_sci".
+ * @param   slots The number of slots; a power of two.
+ * @param   slotSize The size of each slot incl. the 32 byte slot header; a
+ *                   multiple of 8.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t FrameRing_Create(frame_ring_t * ring, char const * name,
+                          uint32_t slots, uint32_t slotSize);
+
+/*!***************************************************************************
+ * @brief   Opens an existing shared memory ring (consumer).
+ * @details The consumer starts reading with the next published frame.
+ * @param   ring The ring to be initialized.
+ * @param   name The name of the shared memory object.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t FrameRing_Open(frame_ring_t * ring, char const * name);
+
+/*!***************************************************************************
+ * @brief   Unmaps the ring; the producer also removes the shared memory
+ *          object.
+ * @param   ring The ring.
+ *****************************************************************************/
+void FrameRing_Close(frame_ring_t * ring);
+
+/*!***************************************************************************
+ * @brief   Publishes a frame (producer).
+ * @param   ring The ring.
+ * @param   entry The frame meta data; the sequence number is ignored.
+ * @param   data The parameter bytes.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          #ERROR_OUT_OF_RANGE if the frame exceeds the slot size.
+ *****************************************************************************/
+status_t FrameRing_Publish(frame_ring_t * ring, frame_ring_entry_t const * entry,
+                           uint8_t const * data);
+
+/*!***************************************************************************
+ * @brief   Reads the next frame without blocking (consumer).
+ * @param   ring The ring.
+ * @param   entry The frame meta data.
+ * @param   data The buffer for the parameter bytes.
+ * @param   size The size of the buffer.
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK if a frame has been read.
+ *          - #ERROR_ARGUS_BUFFER_EMPTY if no new frame is available.
+ *          .
+ *****************************************************************************/
+status_t FrameRing_Read(frame_ring_t * ring, frame_ring_entry_t * entry,
+                        uint8_t * data, uint32_t size);
+
+/*!***************************************************************************
+ * @brief   Blocks until a frame is available to be read (consumer).
+ * @param   ring The ring.
+ * @param   timeout The timeout in milliseconds; < 0 to wait forever.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          #ERROR_TIMEOUT if no frame has been published in time.
+ *****************************************************************************/
+status_t FrameRing_Wait(frame_ring_t * ring, int32_t timeout);
+
+/*! @} */
+#endif /* FRAME_RING_H */
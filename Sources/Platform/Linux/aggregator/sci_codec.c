@@ -0,0 +1,243 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides an incremental decoder and an encoder of the SCI framing
+ *              for host applications on Linux.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "sci_codec.h"
+#include "sci/sci_crc8.h"
+
+#include <assert.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline bool IsControlByte(uint8_t b)
+{
+    return b == SCI_START_BYTE || b == SCI_STOP_BYTE || b == SCI_ESCAPE_BYTE;
+}
+
+static void CompleteFrame(sci_codec_t * codec)
+{
+    uint8_t const * frame = codec->Buffer;
+    uint32_t length = codec->Length;
+
+    if (codec->isOverflow)
+    {
+        codec->Stats.Overflows++;
+        return;
+    }
+
+    /* Minimal 2 bytes required (command + CRC). */
+    if (length < 2U)
+    {
+        codec->Stats.FramingErrors++;
+        return;
+    }
+
+    if (SCI_CRC8_Compute(0, frame, length - 1U) != frame[length - 1U])
+    {
+        codec->Stats.CrcErrors++;
+        return;
+    }
+
+    uint8_t cmd = frame[0];
+    uint8_t device = 0;
+    frame++;
+    length -= 2U;
+
+    if (cmd & SCI_CODEC_DEVICE_FLAG)
+    {
+        if (length == 0)
+        {
+            codec->Stats.FramingErrors++;
+            return;
+        }
+        cmd &= (uint8_t)~SCI_CODEC_DEVICE_FLAG;
+        device = *frame++;
+        length--;
+    }
+
+    codec->Stats.Frames++;
+    codec->Callback(codec->Param, cmd, device, frame, length);
+}
+
+void SCI_Codec_Init(sci_codec_t * codec, uint8_t * buffer, uint32_t size,
+                    sci_codec_callback_t callback, void * param)
+{
+    assert(codec != 0);
+    assert(buffer != 0);
+    assert(size >= 2U);
+    assert(callback != 0);
+
+    SCI_CRC8_Init();
+
+    codec->Buffer = buffer;
+    codec->Size = size;
+    codec->Callback = callback;
+    codec->Param = param;
+    codec->Stats = (sci_codec_stats_t){ 0 };
+    SCI_Codec_Reset(codec);
+}
+
+void SCI_Codec_Reset(sci_codec_t * codec)
+{
+    codec->Length = 0;
+    codec->isInFrame = false;
+    codec->isEscaped = false;
+    codec->isOverflow = false;
+}
+
+void SCI_Codec_Decode(sci_codec_t * codec, uint8_t const * data, uint32_t size)
+{
+    uint8_t const * const end = data + size;
+
+    while (data < end)
+    {
+        if (!codec->isInFrame)
+        {
+            /* Skip everything up to the next start byte. */
+            while (data < end && *data != SCI_START_BYTE) data++;
+            if (data == end) break;
+
+            data++;
+            codec->isInFrame = true;
+            codec->isEscaped = false;
+            codec->isOverflow = false;
+            codec->Length = 0;
+            continue;
+        }
+
+        uint8_t rx = *data++;
+
+        if (codec->isEscaped)
+        {
+            codec->isEscaped = false;
+            rx = (uint8_t)~rx;
+
+            if (!IsControlByte(rx))
+            {
+                /* Invalid escape sequence: drop the frame. */
+                codec->Stats.FramingErrors++;
+                codec->isInFrame = false;
+                continue;
+            }
+        }
+        else if (rx == SCI_ESCAPE_BYTE)
+        {
+            codec->isEscaped = true;
+            continue;
+        }
+        else if (rx == SCI_START_BYTE)
+        {
+            /* Start byte within a frame: drop the frame and start a new one. */
+            codec->Stats.FramingErrors++;
+            codec->Length = 0;
+            codec->isOverflow = false;
+            continue;
+        }
+        else if (rx == SCI_STOP_BYTE)
+        {
+            codec->isInFrame = false;
+            CompleteFrame(codec);
+            continue;
+        }
+
+        if (codec->Length < codec->Size)
+            codec->Buffer[codec->Length++] = rx;
+        else
+            codec->isOverflow = true;
+    }
+}
+
+uint32_t SCI_Codec_Encode(uint8_t cmd, uint8_t device, uint8_t const * data,
+                          uint32_t size, uint8_t * frame, uint32_t capacity)
+{
+    assert(data != 0 || size == 0);
+    assert(frame != 0);
+
+    uint8_t header[2] = { cmd, device };
+    uint32_t headerSize = 1U;
+    if (device != 0)
+    {
+        header[0] |= SCI_CODEC_DEVICE_FLAG;
+        headerSize = 2U;
+    }
+
+    uint8_t crc = SCI_CRC8_Compute(0, header, headerSize);
+    crc = SCI_CRC8_Compute(crc, data, size);
+
+    uint32_t length = 0;
+    if (capacity < 2U) return 0;
+    frame[length++] = SCI_START_BYTE;
+
+    for (uint32_t i = 0; i < headerSize + size + 1U; ++i)
+    {
+        const uint8_t b = i < headerSize ? header[i]
+                          : i < headerSize + size ? data[i - headerSize] : crc;
+
+        if (length + 3U > capacity) return 0;
+        if (IsControlByte(b))
+        {
+            frame[length++] = SCI_ESCAPE_BYTE;
+            frame[length++] = (uint8_t)~b;
+        }
+        else
+        {
+            frame[length++] = b;
+        }
+    }
+
+    frame[length++] = SCI_STOP_BYTE;
+    return length;
+}
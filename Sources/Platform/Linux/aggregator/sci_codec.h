@@ -0,0 +1,180 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides an incremental decoder and an encoder of the SCI framing
+ *              for host applications on Linux.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef SCI_CODEC_H
+#define SCI_CODEC_H
+
+/*!***************************************************************************
+ * @defgroup    sci_codec SCI Frame Codec
+ * @ingroup     aggregator
+ * @brief       Incremental SCI Frame Decoder and Encoder
+ * @details     Host side implementation of the framing of the systems
+ *              communication interface (see sci_datalink.c):
+ *              - A frame starts with #SCI_START_BYTE and ends with
+ *                #SCI_STOP_BYTE.
+ *              - The start, stop and escape bytes within the frame are
+ *                preceded by #SCI_ESCAPE_BYTE and inverted.
+ *              - The frame consists of the command byte, the optional
+ *                device ID (if bit 7 of the command byte is set), the
+ *                parameters and the CRC8 (SAE J1850 ZERO) of the
+ *                preceding bytes.
+ *              .
+ *
+ *              The decoder is fed with arbitrary chunks of the byte stream,
+ *              e.g. as returned by read(), and invokes a callback for each
+ *              complete frame with a valid checksum. Invalid frames are
+ *              dropped and counted like the ExplorerApp does on the device
+ *              side. Bytes outside of frames are ignored, i.e. the decoder
+ *              resynchronizes at the next start byte.
+ *
+ * @addtogroup  sci_codec
+ * @{
+ *****************************************************************************/
+
+#include "sci/sci_byte_stuffing.h"
+#include "sci/sci_status.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*! The device ID flag of the command byte. */
+#define SCI_CODEC_DEVICE_FLAG 0x80U
+
+/*!***************************************************************************
+ * @brief   The callback for a decoded frame.
+ * @param   param The parameter passed to #SCI_Codec_Init.
+ * @param   cmd The command byte w/o the device ID flag.
+ * @param   device The device ID; 0 if not contained in the frame.
+ * @param   data The parameter bytes.
+ * @param   size The number of parameter bytes.
+ *****************************************************************************/
+typedef void (*sci_codec_callback_t)(void * param, uint8_t cmd, uint8_t device,
+                                     uint8_t const * data, uint32_t size);
+
+/*! The statistics of the decoder. */
+typedef struct sci_codec_stats_t
+{
+    /*! The number of decoded frames. */
+    uint32_t Frames;
+
+    /*! The number of frames with an invalid checksum. */
+    uint32_t CrcErrors;
+
+    /*! The number of framing errors, i.e. invalid start or escape bytes and
+     *  frames that are too short. */
+    uint32_t FramingErrors;
+
+    /*! The number of frames that exceed the buffer size. */
+    uint32_t Overflows;
+
+} sci_codec_stats_t;
+
+/*! The decoder state; the members are private. */
+typedef struct sci_codec_t
+{
+    /*! The buffer of the unescaped frame. */
+    uint8_t * Buffer;
+
+    /*! The size of the buffer. */
+    uint32_t Size;
+
+    /*! The number of bytes in the buffer. */
+    uint32_t Length;
+
+    /*! Determines whether a start byte has been received. */
+    bool isInFrame;
+
+    /*! Determines whether the next byte is escaped. */
+    bool isEscaped;
+
+    /*! Determines whether the current frame exceeds the buffer. */
+    bool isOverflow;
+
+    /*! The frame callback. */
+    sci_codec_callback_t Callback;
+
+    /*! The parameter of the frame callback. */
+    void * Param;
+
+    /*! The statistics. */
+    sci_codec_stats_t Stats;
+
+} sci_codec_t;
+
+/*!***************************************************************************
+ * @brief   Initializes the decoder.
+ * @param   codec The decoder.
+ * @param   buffer The buffer for a single unescaped frame incl. command byte,
+ *                 device ID and checksum.
+ * @param   size The size of the buffer, i.e. the maximum frame size.
+ * @param   callback The callback for the decoded frames.
+ * @param   param The parameter of the callback.
+ *****************************************************************************/
+void SCI_Codec_Init(sci_codec_t * codec, uint8_t * buffer, uint32_t size,
+                    sci_codec_callback_t callback, void * param);
+
+/*!***************************************************************************
+ * @brief   Discards a partially received frame, e.g. after reconnecting.
+ * @param   codec The decoder.
+ *****************************************************************************/
+void SCI_Codec_Reset(sci_codec_t * codec);
+
+/*!***************************************************************************
+ * @brief   Decodes the next chunk of the byte stream.
+ * @details Invokes the callback for each complete and valid frame.
+ * @param   codec The decoder.
+ * @param   data The received bytes.
+ * @param   size The number of received bytes.
+ *****************************************************************************/
+void SCI_Codec_Decode(sci_codec_t * codec, uint8_t const * data, uint32_t size);
+
+/*!***************************************************************************
+ * @brief   Encodes a frame incl. checksum and byte stuffing.
+ * @param   cmd The command byte w/o the device ID flag.
+ * @param   device The device ID; 0 to omit the device ID.
+ * @param   data The parameter bytes.
+ * @param   size The number of parameter bytes.
+ * @param   frame The output buffer; 2 * (size + 3) + 2 bytes are sufficient.
+ * @param   capacity The size of the output buffer.
+ * @return  Returns the frame length; 0 if the output buffer is too small.
+ *****************************************************************************/
+uint32_t SCI_Codec_Encode(uint8_t cmd, uint8_t device, uint8_t const * data,
+                          uint32_t size, uint8_t * frame, uint32_t capacity);
+
+/*! @} */
+#endif /* SCI_CODEC_H */
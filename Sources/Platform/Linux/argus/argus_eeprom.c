@@ -0,0 +1,173 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the EEPROM readout of the Argus API stand-in.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "argus_eeprom.h"
+
+#include "platform/argus_s2pi.h"
+
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of EEPROM bytes. */
+#define EEPROM_SIZE 16U
+
+/*! The command byte that precedes the read command and address. */
+#define EEPROM_CMD_ADDRESS 0x2CU
+
+/*! The command byte that precedes the data bits. */
+#define EEPROM_CMD_DATA 0x2FU
+
+/*! The 3 bit read command "110" followed by the 4 bit address. */
+#define EEPROM_READ(address) (0x60U | ((address) & 0x0FU))
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Clocks bits in SPI mode 3, MSB first.
+ * @param   slave The S2PI slave.
+ * @param   tx The bits to be written; right aligned.
+ * @param   count The number of bits.
+ * @param   rx The bits read; right aligned. May be 0.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+static status_t EEPROM_TransferBits(s2pi_slave_t slave, uint32_t tx, uint32_t count, uint32_t * rx)
+{
+    uint32_t bits = 0;
+    for (uint32_t i = count; i > 0; --i)
+    {
+        uint32_t miso = 0;
+        status_t status = S2PI_WriteGpioPin(slave, S2PI_CLK, 0);
+        if (status == STATUS_OK) status = S2PI_WriteGpioPin(slave, S2PI_MOSI, (tx >> (i - 1U)) & 1U);
+        if (status == STATUS_OK) status = S2PI_WriteGpioPin(slave, S2PI_CLK, 1U);
+        if (status == STATUS_OK) status = S2PI_ReadGpioPin(slave, S2PI_MISO, &miso);
+        if (status != STATUS_OK) return status;
+        bits = (bits << 1U) | miso;
+    }
+    if (rx) *rx = bits;
+    return STATUS_OK;
+}
+
+/*!***************************************************************************
+ * @brief   Transfers a command byte and subsequent bits in a CS low phase.
+ *****************************************************************************/
+static status_t EEPROM_Transfer(s2pi_slave_t slave, uint8_t command,
+                                uint32_t tx, uint32_t count, uint32_t * rx)
+{
+    status_t status = S2PI_WriteGpioPin(slave, S2PI_CS, 0);
+    if (status == STATUS_OK) status = EEPROM_TransferBits(slave, command, 8U, 0);
+    if (status == STATUS_OK && count > 0) status = EEPROM_TransferBits(slave, tx, count, rx);
+
+    const status_t s = S2PI_WriteGpioPin(slave, S2PI_CS, 1U);
+    return status == STATUS_OK ? s : status;
+}
+
+status_t EEPROM_Read(s2pi_slave_t slave, uint8_t address, uint8_t * data)
+{
+    if (data == 0 || address >= EEPROM_SIZE) return ERROR_INVALID_ARGUMENT;
+
+    status_t status = S2PI_CaptureGpioControl(slave);
+    if (status != STATUS_OK) return status;
+
+    uint32_t echo = 0;
+    uint32_t value = 0;
+    status = EEPROM_Transfer(slave, EEPROM_CMD_ADDRESS, EEPROM_READ(address), 7U, &echo);
+    if (status == STATUS_OK) status = EEPROM_Transfer(slave, EEPROM_CMD_ADDRESS, 0, 0, 0);
+    if (status == STATUS_OK) status = EEPROM_Transfer(slave, EEPROM_CMD_DATA, 0, 8U, &value);
+    if (status == STATUS_OK) status = EEPROM_Transfer(slave, EEPROM_CMD_ADDRESS, 0, 0, 0);
+
+    const status_t s = S2PI_ReleaseGpioControl(slave);
+    if (status == STATUS_OK) status = s;
+    if (status != STATUS_OK) return status;
+
+    /* The read command is echoed one bit later, i.e. after the last
+     * (zero) bit of the command byte. */
+    if (echo != (EEPROM_READ(address) >> 1U)) return ERROR_ARGUS_EEPROM_FAILURE;
+
+    *data = (uint8_t)value;
+    return STATUS_OK;
+}
+
+uint8_t hamming_decode(uint8_t const * code, uint8_t * data)
+{
+    /* Position p of the code is bit p - 1 (LSB first); the parity bits are
+     * at the power of two positions. */
+    uint8_t bits[EEPROM_SIZE];
+    memcpy(bits, code, EEPROM_SIZE);
+
+    uint32_t syndrome = 0;
+    for (uint32_t p = 1; p < 128U; ++p)
+    {
+        if ((bits[(p - 1U) / 8U] >> ((p - 1U) % 8U)) & 1U) syndrome ^= p;
+    }
+
+    if (syndrome != 0)
+    {
+        bits[(syndrome - 1U) / 8U] ^= (uint8_t)(1U << ((syndrome - 1U) % 8U));
+    }
+
+    memset(data, 0, EEPROM_SIZE - 1U);
+    uint32_t bit = 0;
+    for (uint32_t p = 1; p < 128U; ++p)
+    {
+        if ((p & (p - 1U)) == 0) continue;
+        if ((bits[(p - 1U) / 8U] >> ((p - 1U) % 8U)) & 1U)
+            data[bit / 8U] |= (uint8_t)(1U << (bit % 8U));
+        bit++;
+    }
+
+    return (uint8_t)syndrome;
+}
+
+uint32_t EEPROM_ReadChipId(uint8_t const * eeprom)
+{
+    return eeprom[2] | ((uint32_t)eeprom[3] << 8U) | ((uint32_t)(eeprom[4] & 0x0FU) << 16U);
+}
+
+uint8_t EEPROM_ReadModule(uint8_t const * eeprom)
+{
+    return eeprom[1] & 0x1FU;
+}
@@ -0,0 +1,95 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the EEPROM readout of the Argus API stand-in.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef ARGUS_EEPROM_H
+#define ARGUS_EEPROM_H
+
+/*!***************************************************************************
+ * @defgroup    argus_eeprom Argus API EEPROM Readout
+ * @ingroup     argus_replay
+ * @brief       EEPROM Readout of the Argus API Stand-In (Linux Host)
+ * @details     Host implementations of the internal EEPROM functions of the
+ *              AFBR-S50 API library that are used by the HAL verification
+ *              test (argus_hal_test.c). The EEPROM is read in the GPIO mode
+ *              of the S2PI module by the sequence that is described in the
+ *              troubleshooting guide; the data layout is the one of the
+ *              simulated devices, see #argus_sim.
+ * @addtogroup  argus_eeprom
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_api.h"
+
+/*!***************************************************************************
+ * @brief   Reads a byte from the EEPROM of a device.
+ * @details Bit-bangs the readout sequence in the GPIO mode, i.e. the S2PI
+ *          module must be idle. The echo of the read command is verified.
+ * @param   slave The S2PI slave of the device.
+ * @param   address The EEPROM address; 0 .. 15.
+ * @param   data The byte read.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          - #ERROR_ARGUS_EEPROM_FAILURE if the echo does not match.
+ *****************************************************************************/
+status_t EEPROM_Read(s2pi_slave_t slave, uint8_t address, uint8_t * data);
+
+/*!***************************************************************************
+ * @brief   Decodes the (127,120) Hamming code of the EEPROM.
+ * @details A single bit error is corrected but still reported.
+ * @param   code The 16 EEPROM bytes.
+ * @param   data The 15 decoded data bytes.
+ * @return  Returns the syndrome, i.e. 0 if no error is detected and the
+ *          position of the flipped bit otherwise.
+ *****************************************************************************/
+uint8_t hamming_decode(uint8_t const * code, uint8_t * data);
+
+/*!***************************************************************************
+ * @brief   Gets the chip ID from the decoded EEPROM data.
+ * @param   eeprom The decoded EEPROM data.
+ * @return  Returns the 20 bit chip ID.
+ *****************************************************************************/
+uint32_t EEPROM_ReadChipId(uint8_t const * eeprom);
+
+/*!***************************************************************************
+ * @brief   Gets the module number from the decoded EEPROM data.
+ * @param   eeprom The decoded EEPROM data.
+ * @return  Returns the module number, see #argus_module_version_t.
+ *****************************************************************************/
+uint8_t EEPROM_ReadModule(uint8_t const * eeprom);
+
+/*! @} */
+#endif /* ARGUS_EEPROM_H */
@@ -0,0 +1,115 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the external definitions of the inline utility functions.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "utility/fp_div.h"
+#include "utility/fp_ema.h"
+#include "utility/fp_mul.h"
+#include "utility/fp_rnd.h"
+#include "utility/int_math.h"
+#include "utility/time.h"
+
+/*******************************************************************************
+ * External Definitions
+ ******************************************************************************/
+
+/* The external definitions of the inline functions of the utility headers;
+ * provided by the API library on the MCU platforms (see C99 6.7.4). */
+extern inline uint32_t Time_ToUSec(ltc_t const * t);
+extern inline uint32_t Time_ToMSec(ltc_t const * t);
+extern inline uint32_t Time_ToSec(ltc_t const * t);
+extern inline void Time_FromUSec(ltc_t * t, uint32_t t_usec);
+extern inline void Time_FromMSec(ltc_t * t, uint32_t t_msec);
+extern inline void Time_FromSec(ltc_t * t, uint32_t t_sec);
+extern inline bool Time_GreaterEqual(ltc_t const * t1, ltc_t const * t2);
+extern inline void Time_GetNow(ltc_t * t_now);
+extern inline ltc_t Time_Now(void);
+extern inline uint32_t Time_GetNowUSec(void);
+extern inline uint32_t Time_GetNowMSec(void);
+extern inline uint32_t Time_GetNowSec(void);
+extern inline void Time_Diff(ltc_t * t_diff, ltc_t const * t_start, ltc_t const * t_end);
+extern inline uint32_t Time_DiffUSec(ltc_t const * t_start, ltc_t const * t_end);
+extern inline uint32_t Time_DiffMSec(ltc_t const * t_start, ltc_t const * t_end);
+extern inline uint32_t Time_DiffSec(ltc_t const * t_start, ltc_t const * t_end);
+extern inline void Time_GetElapsed(ltc_t * t_elapsed, ltc_t const * t_start);
+extern inline uint32_t Time_GetElapsedUSec(ltc_t const * t_start);
+extern inline uint32_t Time_GetElapsedMSec(ltc_t const * t_start);
+extern inline uint32_t Time_GetElapsedSec(ltc_t const * t_start);
+extern inline void Time_Add(ltc_t * t, ltc_t const * t1, ltc_t const * t2);
+extern inline void Time_AddUSec(ltc_t * t, ltc_t const * t1, uint32_t t2_usec);
+extern inline void Time_AddMSec(ltc_t * t, ltc_t const * t1, uint32_t t2_msec);
+extern inline void Time_AddSec(ltc_t * t, ltc_t const * t1, uint32_t t2_sec);
+extern inline bool Time_CheckWithin(ltc_t const * t_start, ltc_t const * t_end, ltc_t const * t);
+extern inline bool Time_CheckTimeout(ltc_t const * t_start, ltc_t const * t_timeout);
+extern inline bool Time_CheckTimeoutUSec(ltc_t const * t_start, uint32_t const t_timeout_usec);
+extern inline bool Time_CheckTimeoutMSec(ltc_t const * t_start, uint32_t const t_timeout_msec);
+extern inline bool Time_CheckTimeoutSec(ltc_t const * t_start, uint32_t const t_timeout_sec);
+extern inline void Time_Delay(ltc_t const * dt);
+extern inline void Time_DelayUSec(uint32_t dt_usec);
+extern inline void Time_DelayMSec(uint32_t dt_msec);
+extern inline void Time_DelaySec(uint32_t dt_sec);
+extern inline uint32_t fp_rndu(uint32_t Q, uint_fast8_t n);
+extern inline int32_t fp_rnds(int32_t Q, uint_fast8_t n);
+extern inline uint32_t fp_truncu(uint32_t Q, uint_fast8_t n);
+extern inline int32_t fp_truncs(int32_t Q, uint_fast8_t n);
+#if !USE_64BIT_MUL
+extern inline void muldwu(uint32_t w[], uint32_t u, uint32_t v);
+#endif
+extern inline uint32_t fp_mulu(uint32_t u, uint32_t v, uint_fast8_t shift);
+extern inline int32_t fp_muls(int32_t u, int32_t v, uint_fast8_t shift);
+extern inline uint32_t fp_mul_u32_u16(uint32_t u, uint16_t v, uint_fast8_t shift);
+extern inline int32_t fp_mul_s32_u16(int32_t u, uint16_t v, uint_fast8_t shift);
+extern inline uq1_15_t fp_ema15c(uq1_15_t mean, uq1_15_t x, uq0_8_t weight);
+extern inline q11_4_t fp_ema4(q11_4_t mean, q11_4_t x, uq0_8_t weight);
+extern inline q7_8_t fp_ema8(q7_8_t mean, q7_8_t x, uq0_8_t weight);
+extern inline uint32_t uint_ema32(uint32_t mean, uint32_t x, uq0_8_t weight);
+extern inline int32_t int_ema32(int32_t mean, int32_t x, uq0_8_t weight);
+extern inline q15_16_t fp_ema16(q15_16_t mean, q15_16_t x, uq0_8_t weight);
+extern inline uint32_t log2i(uint32_t x);
+extern inline uint32_t log2_round(uint32_t x);
+extern inline uint32_t binary_round(uint32_t x);
+extern inline uint32_t popcount(uint32_t x);
+extern inline uint32_t ispowoftwo(uint32_t x);
+extern inline uint32_t absval(int32_t x);
+extern inline uint32_t floor2(uint32_t x, uint_fast8_t n);
+extern inline uint32_t ceiling2(uint32_t x, uint_fast8_t n);
+extern inline uint32_t ceildiv(uint32_t x, uint32_t y);
+extern inline int32_t fp_div16(int32_t a, q15_16_t b);
@@ -0,0 +1,800 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a stand-in of the AFBR-S50 API that replays recorded measurement data on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "argus_replay.h"
+
+#include "board/board_config.h"
+#include "driver/irq.h"
+#include "driver/s2pi.h"
+#include "record/record.h"
+#include "timer_mux.h"
+#include "utility/fp_rnd.h"
+#include "utility/time.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of measurement frames that are buffered until evaluation. */
+#define REPLAY_BUFFER_COUNT 2U
+
+/*! The address of the raw data register that is read out. */
+#define REPLAY_DATA_REGISTER 0x32U
+
+/*! The default frame time in microseconds; a frame rate of 200 fps. */
+#define REPLAY_FRAME_TIME 5000U
+
+/*! The frame time of the high speed modes in microseconds. */
+#define REPLAY_FRAME_TIME_HIGH_SPEED 1000U
+
+/*! The minimum frame time in microseconds. */
+#define REPLAY_FRAME_TIME_MIN 500U
+
+/*! The echo register of the device, see #S2PI_Init. */
+#define REPLAY_ECHO_REGISTER 0x04U
+
+/*! The size of the echo register in bytes. */
+#define REPLAY_ECHO_SIZE 16U
+
+/*! The API handle. */
+struct argus_hnd_t
+{
+    /*! The SPI slave of the device. */
+    s2pi_slave_t Slave;
+
+    /*! The measurement mode. */
+    argus_mode_t Mode;
+
+    /*! The frame time in microseconds. */
+    uint32_t FrameTime;
+
+    /*! The smart power save feature. */
+    bool SmartPowerSave;
+
+    /*! The crosstalk monitor feature. */
+    bool CrosstalkMonitor;
+
+    /*! The dual frequency mode. */
+    argus_dfm_mode_t DFMMode;
+
+    /*! The shot noise monitor mode. */
+    argus_snm_mode_t SNMMode;
+
+    /*! The dynamic configuration adaption configuration. */
+    argus_cfg_dca_t DCA;
+
+    /*! The pixel binning configuration. */
+    argus_cfg_pba_t PBA;
+
+    /*! The global range offset calibration. */
+    q0_15_t GlobalRangeOffset;
+
+    /*! The pixel range offset calibration. */
+    argus_cal_offset_table_t RangeOffsets;
+
+    /*! The range offset calibration sequence sample time. */
+    uint16_t RangeOffsetSampleTime;
+
+    /*! The pixel-to-pixel crosstalk calibration. */
+    argus_cal_p2pxtalk_t Pixel2Pixel;
+
+    /*! The crosstalk vector table calibration. */
+    argus_cal_xtalk_table_t XtalkTable;
+
+    /*! The crosstalk calibration sequence sample time. */
+    uint16_t XtalkSampleTime;
+
+    /*! The crosstalk calibration sequence amplitude threshold. */
+    uq12_4_t XtalkThreshold;
+
+    /*! The measurement ready callback. */
+    argus_measurement_ready_callback_t Callback;
+
+    /*! Determines whether the measurement timer is active. */
+    volatile bool isTimerActive;
+
+    /*! Determines whether a measurement (i.e. the read-out) is ongoing. */
+    volatile bool isBusy;
+
+    /*! The number of measured frames that are pending for evaluation. */
+    volatile uint32_t Pending;
+
+    /*! The index of the buffer of the next measurement. */
+    uint32_t Head;
+
+    /*! The time stamps of the buffered frames. */
+    ltc_t TimeStamp[REPLAY_BUFFER_COUNT];
+
+    /*! The raw data buffers incl. the register address byte. */
+    uint8_t Data[REPLAY_BUFFER_COUNT][ARGUS_RAW_DATA_SIZE + 1U];
+
+    /*! The recording; unmapped for the synthetic target. */
+    record_reader_t Replay;
+
+    /*! The replayed device stream of the recording. */
+    uint8_t ReplayDevice;
+
+    /*! The index of the next replayed frame within the device stream. */
+    uint32_t ReplayIndex;
+
+    /*! The number of evaluated frames. */
+    uint32_t FrameCount;
+};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static status_t Replay_ReadoutCallback(status_t status, void * param)
+{
+    /* Invoked in the interrupt context by the S2PI bus simulation. */
+    argus_hnd_t * hnd = (argus_hnd_t *)param;
+
+    hnd->isBusy = false;
+    if (status < STATUS_OK)
+    {
+        return status;
+    }
+
+    hnd->Head = (hnd->Head + 1U) % REPLAY_BUFFER_COUNT;
+    hnd->Pending++;
+
+    if (hnd->Callback != 0)
+    {
+        return hnd->Callback(STATUS_OK, hnd);
+    }
+    return STATUS_OK;
+}
+
+static status_t Replay_StartMeasurement(argus_hnd_t * hnd)
+{
+    IRQ_LOCK();
+    if (hnd->isBusy)
+    {
+        IRQ_UNLOCK();
+        return STATUS_BUSY;
+    }
+    if (hnd->Pending >= REPLAY_BUFFER_COUNT)
+    {
+        IRQ_UNLOCK();
+        return STATUS_ARGUS_BUFFER_BUSY;
+    }
+    hnd->isBusy = true;
+    IRQ_UNLOCK();
+
+    uint8_t * data = hnd->Data[hnd->Head];
+    Time_GetNow(&hnd->TimeStamp[hnd->Head]);
+    data[0] = REPLAY_DATA_REGISTER;
+
+    status_t status = S2PI_TransferFrame(hnd->Slave, data, data, sizeof(hnd->Data[0]),
+                                         Replay_ReadoutCallback, hnd);
+    if (status < STATUS_OK)
+    {
+        hnd->isBusy = false;
+    }
+    return status;
+}
+
+static void Replay_TimerCallback(void * param)
+{
+    /* Frames are skipped if the previous one is still ongoing or the
+     * buffers are full, as in the original API. */
+    argus_hnd_t * hnd = (argus_hnd_t *)param;
+    if (hnd->isTimerActive)
+    {
+        (void)Replay_StartMeasurement(hnd);
+    }
+}
+
+static uint32_t Replay_GetFrameTime(argus_hnd_t const * hnd)
+{
+    char const * fps = getenv("AFBR_REPLAY_FPS");
+    if (fps != 0)
+    {
+        const uint32_t rate = (uint32_t)strtoul(fps, 0, 10);
+        if (rate > 0 && 1000000U / rate >= REPLAY_FRAME_TIME_MIN)
+        {
+            return 1000000U / rate;
+        }
+    }
+    return hnd->FrameTime;
+}
+
+static status_t Replay_Exchange(s2pi_slave_t slave, uint8_t * data, size_t size)
+{
+    /* A blocking transfer for the device communication test. */
+    status_t status = S2PI_TransferFrame(slave, data, data, size, 0, 0);
+    if (status < STATUS_OK) return status;
+
+    while ((status = S2PI_GetStatus(slave)) == STATUS_BUSY);
+    return status;
+}
+
+static void Replay_SyntheticFrame(argus_hnd_t * hnd, argus_results_t * res)
+{
+    /* A target that moves between 0.5 m and 2.5 m with 1 m/s; the amplitude
+     * decreases with the square of the distance. */
+    const uint32_t period = 4000U; // mm per cycle
+    const uint32_t phase = (hnd->FrameCount * (hnd->FrameTime / 1000U + 1U)) % period;
+    const uint32_t range_mm = 500U + (phase < period / 2U ? phase : period - phase);
+    const q9_22_t range = (q9_22_t)(((uint64_t)range_mm << 22U) / 1000U);
+    const uint32_t amplitude = 1000000U / range_mm * 1000U / range_mm; // LSB @ 1 m: 1000
+
+    memset(res, 0, sizeof(*res));
+    res->Frame.IntegrationTime = hnd->FrameTime / 4U;
+    res->Frame.PxEnMask = 0xFFFFFFFFU;
+    res->Frame.State = ARGUS_STATE_HAS_DATA | ARGUS_STATE_PLL_LOCKED;
+    res->Frame.DigitalIntegrationDepth = 1U;
+
+    for (uint32_t n = 0; n <= ARGUS_PIXELS; ++n)
+    {
+        argus_pixel_t * px = &res->Pixels[n];
+        const uint32_t a = n < ARGUS_PIXELS ? amplitude : 4000U;
+        px->Range = n < ARGUS_PIXELS ? range + (q9_22_t)(n << 10U) : 0;
+        px->Amplitude = (uq12_4_t)(a < 0xFFFU ? a << 4U : 0xFFF0U);
+        px->AmplitudeRaw = px->Amplitude;
+        px->Phase = (uq1_15_t)((uint32_t)range >> 10U);
+        px->Status = PIXEL_OK;
+    }
+
+    res->Bin.Range = range;
+    res->Bin.Amplitude = res->Pixels[0].Amplitude;
+    res->Bin.SignalQuality = 100U;
+
+    res->Auxiliary.VDD = 5U << 4U;
+    res->Auxiliary.TEMP = 25 << 4;
+    res->Auxiliary.VSUB = 0xFFFFU;
+    res->Auxiliary.VDDL = 0xFFFFU;
+    res->Auxiliary.IAPD = 0xFFFFU;
+    res->Auxiliary.BGL = 0xFFFFU;
+    res->Auxiliary.SNA = 0xFFFFU;
+}
+
+static bool Replay_NextFrame(argus_hnd_t * hnd, argus_results_t * res,
+                             argus_results_debug_t * dbg)
+{
+    if (hnd->Replay.Map != 0)
+    {
+        /* Restart at the end of the recording. */
+        if (hnd->ReplayIndex >= RecordReader_GetFrameCount(&hnd->Replay, hnd->ReplayDevice))
+            hnd->ReplayIndex = 0;
+
+        if (RecordReader_GetFrame(&hnd->Replay, hnd->ReplayDevice,
+                                  hnd->ReplayIndex++, res, dbg) == STATUS_OK)
+            return (RecordReader_GetHeader(&hnd->Replay)->Flags & RECORD_FLAG_DEBUG) != 0;
+    }
+
+    Replay_SyntheticFrame(hnd, res);
+    return false;
+}
+
+status_t ArgusReplay_Open(argus_hnd_t * hnd, char const * path)
+{
+    assert(hnd != 0);
+
+    RecordReader_Close(&hnd->Replay);
+    hnd->ReplayIndex = 0;
+
+    if (path == 0) return STATUS_OK;
+
+    status_t status = RecordReader_Open(&hnd->Replay, path);
+    if (status < STATUS_OK) return status;
+
+    /* Replay the stream of the own S2PI slave or the first recorded one. */
+    hnd->ReplayDevice = (uint8_t)hnd->Slave;
+    for (uint8_t dev = 0; dev < RECORD_DEVICE_COUNT
+         && RecordReader_GetFrameCount(&hnd->Replay, hnd->ReplayDevice) == 0; ++dev)
+    {
+        hnd->ReplayDevice = dev;
+    }
+
+    if (RecordReader_GetFrameCount(&hnd->Replay, hnd->ReplayDevice) == 0)
+    {
+        RecordReader_Close(&hnd->Replay);
+        return ERROR_FAIL;
+    }
+    return STATUS_OK;
+}
+
+uint32_t ArgusReplay_GetFrameCount(argus_hnd_t * hnd)
+{
+    assert(hnd != 0);
+    return hnd->FrameCount;
+}
+
+/*******************************************************************************
+ * Initialization
+ ******************************************************************************/
+
+argus_hnd_t * Argus_CreateHandle(void)
+{
+    argus_hnd_t * hnd = malloc(sizeof(argus_hnd_t));
+    if (hnd != 0) memset(hnd, 0, sizeof(argus_hnd_t));
+    return hnd;
+}
+
+status_t Argus_DestroyHandle(argus_hnd_t * hnd)
+{
+    if (hnd == 0) return ERROR_INVALID_ARGUMENT;
+    status_t status = Argus_Deinit(hnd);
+    free(hnd);
+    return status;
+}
+
+status_t Argus_Init(argus_hnd_t * hnd, s2pi_slave_t spi_slave)
+{
+    return Argus_InitMode(hnd, spi_slave, ARGUS_MODE_LONG_RANGE);
+}
+
+status_t Argus_InitMode(argus_hnd_t * hnd, s2pi_slave_t spi_slave, argus_mode_t mode)
+{
+    if (hnd == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (spi_slave <= 0 || spi_slave > S2PI_SLAVE_COUNT) return ERROR_ARGUS_INVALID_SLAVE;
+
+    (void)Argus_Deinit(hnd);
+    memset(hnd, 0, sizeof(argus_hnd_t));
+    hnd->Slave = spi_slave;
+
+    status_t status = Argus_Ping(hnd);
+    if (status < STATUS_OK) return status;
+
+    if (mode == 0) mode = Argus_GetDefaultMeasurementMode(AFBR_S50MV85G_V3);
+    status = Argus_SetMeasurementMode(hnd, mode);
+    if (status < STATUS_OK) return status;
+
+    hnd->SmartPowerSave = true;
+    hnd->CrosstalkMonitor = true;
+    hnd->DCA.Enabled = DCA_ENABLE_DYNAMIC;
+    hnd->PBA.Enabled = PBA_ENABLE;
+    hnd->RangeOffsetSampleTime = 1000U;
+    hnd->XtalkSampleTime = 1000U;
+    hnd->XtalkThreshold = 5U << 4U;
+
+    return ArgusReplay_Open(hnd, getenv("AFBR_REPLAY"));
+}
+
+status_t Argus_Reinit(argus_hnd_t * hnd)
+{
+    if (hnd == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return Argus_InitMode(hnd, hnd->Slave, hnd->Mode);
+}
+
+status_t Argus_ReinitMode(argus_hnd_t * hnd, argus_mode_t mode)
+{
+    if (hnd == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return Argus_InitMode(hnd, hnd->Slave, mode ? mode : hnd->Mode);
+}
+
+status_t Argus_Deinit(argus_hnd_t * hnd)
+{
+    if (hnd == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (hnd->Slave == 0) return STATUS_OK;
+
+    status_t status = Argus_Abort(hnd);
+    (void)ArgusReplay_Open(hnd, 0);
+    hnd->Slave = 0;
+    return status;
+}
+
+/*******************************************************************************
+ * Generic API
+ ******************************************************************************/
+
+uint32_t Argus_GetAPIVersion(void)
+{
+    return ARGUS_API_VERSION;
+}
+
+char const * Argus_GetBuildNumber(void)
+{
+    return ARGUS_API_VERSION_BUILD;
+}
+
+argus_module_version_t Argus_GetModuleVersion(argus_hnd_t * hnd)
+{
+    return (hnd != 0 && hnd->Slave != 0) ? AFBR_S50MV85G_V3 : MODULE_NONE;
+}
+
+char const * Argus_GetModuleName(argus_hnd_t * hnd)
+{
+    return (hnd != 0 && hnd->Slave != 0) ? "AFBR-S50MV85G" : "unknown";
+}
+
+argus_chip_version_t Argus_GetChipVersion(argus_hnd_t * hnd)
+{
+    return (hnd != 0 && hnd->Slave != 0) ? ADS0032_V1D : ADS0032_NONE;
+}
+
+argus_laser_type_t Argus_GetLaserType(argus_hnd_t * hnd)
+{
+    return (hnd != 0 && hnd->Slave != 0) ? LASER_H_V2X : LASER_NONE;
+}
+
+uint32_t Argus_GetChipID(argus_hnd_t * hnd)
+{
+    /* A unique identifier per slave, e.g. for the discovery cache. */
+    return (hnd != 0 && hnd->Slave != 0) ? 0x100000U + (uint32_t)hnd->Slave : 0;
+}
+
+s2pi_slave_t Argus_GetSPISlave(argus_hnd_t * hnd)
+{
+    return hnd != 0 ? hnd->Slave : 0;
+}
+
+/*******************************************************************************
+ * Measurement/Device Operation
+ ******************************************************************************/
+
+status_t Argus_StartMeasurementTimer(argus_hnd_t * hnd,
+                                     argus_measurement_ready_callback_t cb)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (cb == 0) return ERROR_INVALID_ARGUMENT;
+
+    IRQ_LOCK();
+    hnd->Callback = cb;
+    hnd->isTimerActive = true;
+    status_t status = TimerMux_SetIntervalCallback(Replay_GetFrameTime(hnd), hnd,
+                                                   Replay_TimerCallback);
+    if (status < STATUS_OK) hnd->isTimerActive = false;
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+status_t Argus_StopMeasurementTimer(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+
+    IRQ_LOCK();
+    hnd->isTimerActive = false;
+    status_t status = TimerMux_SetIntervalCallback(0, hnd, Replay_TimerCallback);
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+status_t Argus_TriggerMeasurement(argus_hnd_t * hnd,
+                                  argus_measurement_ready_callback_t cb)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (cb == 0) return ERROR_INVALID_ARGUMENT;
+    if (hnd->isTimerActive) return ERROR_ARGUS_BUSY;
+
+    hnd->Callback = cb;
+    return Replay_StartMeasurement(hnd);
+}
+
+bool Argus_IsDataEvaluationPending(argus_hnd_t * hnd)
+{
+    return hnd != 0 && hnd->Pending > 0;
+}
+
+bool Argus_IsTimerMeasurementActive(argus_hnd_t * hnd)
+{
+    return hnd != 0 && hnd->isTimerActive;
+}
+
+status_t Argus_Abort(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+
+    status_t status = Argus_StopMeasurementTimer(hnd);
+    if (status < STATUS_OK) return status;
+
+    status = S2PI_Abort(hnd->Slave);
+
+    IRQ_LOCK();
+    hnd->isBusy = false;
+    hnd->Pending = 0;
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+status_t Argus_GetStatus(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return hnd->isBusy ? STATUS_BUSY : STATUS_IDLE;
+}
+
+status_t Argus_Ping(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+
+    /* Write a pattern to the echo register and read it back. */
+    uint8_t data[REPLAY_ECHO_SIZE + 1U];
+    for (uint8_t pass = 0; pass < 2U; ++pass)
+    {
+        data[0] = REPLAY_ECHO_REGISTER;
+        for (uint8_t i = 0; i < REPLAY_ECHO_SIZE; ++i)
+        {
+            data[i + 1U] = (uint8_t)(0x5AU ^ (i * 0x11U));
+        }
+
+        status_t status = Replay_Exchange(hnd->Slave, data, sizeof(data));
+        if (status < STATUS_OK) return status;
+    }
+
+    for (uint8_t i = 0; i < REPLAY_ECHO_SIZE; ++i)
+    {
+        if (data[i + 1U] != (uint8_t)(0x5AU ^ (i * 0x11U)))
+            return ERROR_ARGUS_NOT_CONNECTED;
+    }
+    return STATUS_OK;
+}
+
+status_t Argus_EvaluateData(argus_hnd_t * hnd, argus_results_t * res)
+{
+    return Argus_EvaluateDataDebug(hnd, res, 0);
+}
+
+status_t Argus_EvaluateDataDebug(argus_hnd_t * hnd, argus_results_t * res,
+                                 argus_results_debug_t * dbg)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (res == 0) return ERROR_INVALID_ARGUMENT;
+    if (hnd->Pending == 0) return ERROR_ARGUS_BUFFER_EMPTY;
+
+    /* The oldest pending buffer. */
+    IRQ_LOCK();
+    const uint32_t index = (hnd->Head + REPLAY_BUFFER_COUNT - hnd->Pending) % REPLAY_BUFFER_COUNT;
+    IRQ_UNLOCK();
+
+    const bool hasDebug = Replay_NextFrame(hnd, res, dbg);
+    res->Status = STATUS_OK;
+    res->TimeStamp = hnd->TimeStamp[index];
+    res->Debug = dbg;
+
+    if (dbg != 0 && !hasDebug)
+    {
+        memset(dbg, 0, sizeof(*dbg));
+        dbg->DCAAmplitude = res->Bin.Amplitude;
+        for (uint32_t i = 0; i < ARGUS_RAW_DATA_VALUES; ++i)
+        {
+            uint8_t const * raw = &hnd->Data[index][1U + 3U * i];
+            dbg->Data[i] = ((uint32_t)raw[0] << 16U) | ((uint32_t)raw[1] << 8U) | raw[2];
+        }
+    }
+
+    hnd->FrameCount++;
+
+    IRQ_LOCK();
+    hnd->Pending--;
+    IRQ_UNLOCK();
+
+    return STATUS_OK;
+}
+
+status_t Argus_ExecuteXtalkCalibrationSequence(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return STATUS_OK;
+}
+
+status_t Argus_ExecuteRelativeRangeOffsetCalibrationSequence(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return STATUS_OK;
+}
+
+status_t Argus_ExecuteAbsoluteRangeOffsetCalibrationSequence(argus_hnd_t * hnd,
+                                                             q9_22_t targetRange)
+{
+    (void)targetRange;
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return STATUS_OK;
+}
+
+/*******************************************************************************
+ * Configuration API
+ ******************************************************************************/
+
+/*! Implements the getter and setter of a configuration or calibration value. */
+#define REPLAY_VALUE_ACCESSORS(name, type, member)                              \
+status_t Argus_Set##name(argus_hnd_t * hnd, type value)                         \
+{                                                                               \
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;          \
+    hnd->member = value;                                                        \
+    return STATUS_OK;                                                           \
+}                                                                               \
+status_t Argus_Get##name(argus_hnd_t * hnd, type * value)                       \
+{                                                                               \
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;          \
+    if (value == 0) return ERROR_INVALID_ARGUMENT;                              \
+    *value = hnd->member;                                                       \
+    return STATUS_OK;                                                           \
+}
+
+/*! Implements the getter and setter of a configuration or calibration table. */
+#define REPLAY_TABLE_ACCESSORS(name, type, member)                              \
+status_t Argus_Set##name(argus_hnd_t * hnd, type const * value)                 \
+{                                                                               \
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;          \
+    if (value == 0) return ERROR_INVALID_ARGUMENT;                              \
+    hnd->member = *value;                                                       \
+    return STATUS_OK;                                                           \
+}                                                                               \
+status_t Argus_Get##name(argus_hnd_t * hnd, type * value)                       \
+{                                                                               \
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;          \
+    if (value == 0) return ERROR_INVALID_ARGUMENT;                              \
+    *value = hnd->member;                                                       \
+    return STATUS_OK;                                                           \
+}
+
+argus_mode_t Argus_GetDefaultMeasurementMode(argus_module_version_t module)
+{
+    (void)module;
+    return ARGUS_MODE_LONG_RANGE;
+}
+
+status_t Argus_SetMeasurementMode(argus_hnd_t * hnd, argus_mode_t mode)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+
+    switch (mode)
+    {
+        case ARGUS_MODE_SHORT_RANGE:
+        case ARGUS_MODE_LONG_RANGE:
+            hnd->FrameTime = REPLAY_FRAME_TIME;
+            break;
+        case ARGUS_MODE_HIGH_SPEED_SHORT_RANGE:
+        case ARGUS_MODE_HIGH_SPEED_LONG_RANGE:
+            hnd->FrameTime = REPLAY_FRAME_TIME_HIGH_SPEED;
+            break;
+        default:
+            return ERROR_ARGUS_INVALID_MODE;
+    }
+
+    hnd->Mode = mode;
+    hnd->DFMMode = DFM_MODE_8X;
+    hnd->SNMMode = SNM_MODE_DYNAMIC;
+    return STATUS_OK;
+}
+
+status_t Argus_ResetMeasurementMode(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    return Argus_SetMeasurementMode(hnd, hnd->Mode);
+}
+
+status_t Argus_GetMeasurementMode(argus_hnd_t * hnd, argus_mode_t * mode)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (mode == 0) return ERROR_INVALID_ARGUMENT;
+    *mode = hnd->Mode;
+    return STATUS_OK;
+}
+
+status_t Argus_SetConfigurationFrameTime(argus_hnd_t * hnd, uint32_t value)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (value < REPLAY_FRAME_TIME_MIN) return ERROR_ARGUS_INVALID_CFG;
+    hnd->FrameTime = value;
+    return STATUS_OK;
+}
+
+status_t Argus_GetConfigurationFrameTime(argus_hnd_t * hnd, uint32_t * value)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (value == 0) return ERROR_INVALID_ARGUMENT;
+    *value = Replay_GetFrameTime(hnd);
+    return STATUS_OK;
+}
+
+REPLAY_VALUE_ACCESSORS(ConfigurationSmartPowerSaveEnabled, bool, SmartPowerSave)
+REPLAY_VALUE_ACCESSORS(ConfigurationDFMMode, argus_dfm_mode_t, DFMMode)
+REPLAY_VALUE_ACCESSORS(ConfigurationShotNoiseMonitorMode, argus_snm_mode_t, SNMMode)
+REPLAY_VALUE_ACCESSORS(ConfigurationCrosstalkMonitorMode, bool, CrosstalkMonitor)
+REPLAY_TABLE_ACCESSORS(ConfigurationDynamicAdaption, argus_cfg_dca_t, DCA)
+REPLAY_TABLE_ACCESSORS(ConfigurationPixelBinning, argus_cfg_pba_t, PBA)
+
+status_t Argus_GetConfigurationUnambiguousRange(argus_hnd_t * hnd, uint32_t * range_mm)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (range_mm == 0) return ERROR_INVALID_ARGUMENT;
+
+    /* The nominal values of the modulation frequencies. */
+    const uint32_t range = (hnd->Mode & ARGUS_MODE_FLAG_SHORT_RANGE) ? 5000U : 10000U;
+    *range_mm = hnd->DFMMode == DFM_MODE_OFF ? range
+              : hnd->DFMMode == DFM_MODE_4X ? 4U * range : 8U * range;
+    return STATUS_OK;
+}
+
+/*******************************************************************************
+ * Calibration API
+ ******************************************************************************/
+
+REPLAY_VALUE_ACCESSORS(CalibrationGlobalRangeOffset, q0_15_t, GlobalRangeOffset)
+REPLAY_TABLE_ACCESSORS(CalibrationPixelRangeOffsets, argus_cal_offset_table_t, RangeOffsets)
+REPLAY_VALUE_ACCESSORS(CalibrationRangeOffsetSequenceSampleTime, uint16_t, RangeOffsetSampleTime)
+REPLAY_TABLE_ACCESSORS(CalibrationCrosstalkPixel2Pixel, argus_cal_p2pxtalk_t, Pixel2Pixel)
+REPLAY_TABLE_ACCESSORS(CalibrationCrosstalkVectorTable, argus_cal_xtalk_table_t, XtalkTable)
+REPLAY_VALUE_ACCESSORS(CalibrationCrosstalkSequenceSampleTime, uint16_t, XtalkSampleTime)
+REPLAY_VALUE_ACCESSORS(CalibrationCrosstalkSequenceAmplitudeThreshold, uq12_4_t, XtalkThreshold)
+
+status_t Argus_ResetCalibrationPixelRangeOffsets(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    memset(&hnd->RangeOffsets, 0, sizeof(hnd->RangeOffsets));
+    return STATUS_OK;
+}
+
+status_t Argus_ResetCalibrationCrosstalkVectorTable(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    memset(&hnd->XtalkTable, 0, sizeof(hnd->XtalkTable));
+    return STATUS_OK;
+}
+
+status_t Argus_ClearUserCalibration(argus_hnd_t * hnd)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    hnd->GlobalRangeOffset = 0;
+    memset(&hnd->Pixel2Pixel, 0, sizeof(hnd->Pixel2Pixel));
+    (void)Argus_ResetCalibrationPixelRangeOffsets(hnd);
+    return Argus_ResetCalibrationCrosstalkVectorTable(hnd);
+}
+
+status_t Argus_GetCalibrationGoldenPixel(argus_hnd_t const * hnd, uint8_t * x, uint8_t * y)
+{
+    if (hnd == 0 || hnd->Slave == 0) return ERROR_ARGUS_NOT_CONNECTED;
+    if (x == 0 || y == 0) return ERROR_INVALID_ARGUMENT;
+
+    /* The center pixel of the nominal optics. */
+    *x = 3U;
+    *y = 1U;
+    return STATUS_OK;
+}
@@ -0,0 +1,100 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a stand-in of the AFBR-S50 API that replays recorded measurement data on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef ARGUS_REPLAY_H
+#define ARGUS_REPLAY_H
+
+/*!***************************************************************************
+ * @defgroup    argus_replay Argus API Replay
+ * @ingroup     platform
+ * @brief       AFBR-S50 API Stand-In for the Linux Host
+ * @details     Implements the functions of the AFBR-S50 API (argus_api.h)
+ *              that are used by the ExplorerApp, such that the complete
+ *              streaming pipeline (measurement timer, S2PI read-out, data
+ *              evaluation, SCI) runs as a host process, e.g. for soak and
+ *              performance tests.
+ *
+ *              Instead of evaluating the raw data of a device, the results
+ *              are replayed from a recording:
+ *              - A measurement is the read-out of the raw data frame from
+ *                the simulated device via #S2PI_TransferFrame. The
+ *                measurement ready callback is invoked from its completion
+ *                in the interrupt context, i.e. with the timing of the S2PI
+ *                bus simulation. Up to two frames are buffered until they
+ *                are evaluated, as in the original API.
+ *              - #Argus_EvaluateData returns the next frame of the
+ *                recording in the environment variable AFBR_REPLAY and
+ *                restarts at its end. The recording is a file of the
+ *                recording format (see record.h); the stream of the own
+ *                S2PI slave is replayed or, if not recorded, the first
+ *                recorded stream. Without a recording, a synthetic target
+ *                that moves between 0.5 m and 2.5 m is generated. The time
+ *                stamp is always set from the current measurement; the
+ *                debug data is replayed if recorded and taken from the
+ *                current raw data otherwise.
+ *              - The frame rate of the measurement timer is the configured
+ *                frame time or the environment variable AFBR_REPLAY_FPS.
+ *              - The configuration and calibration values are stored and
+ *                returned but not applied. The calibration sequences
+ *                finish immediately.
+ *              .
+ * @addtogroup  argus_replay
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_api.h"
+
+/*!***************************************************************************
+ * @brief   Opens a recording to be replayed by a device.
+ * @details Replaces the recording of the AFBR_REPLAY environment variable
+ *          and restarts at the first frame.
+ * @param   hnd The API handle; initialized by #Argus_InitMode.
+ * @param   path The path of the recording; 0 for the synthetic target.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t ArgusReplay_Open(argus_hnd_t * hnd, char const * path);
+
+/*!***************************************************************************
+ * @brief   Gets the number of frames that have been evaluated by a device.
+ * @param   hnd The API handle.
+ * @return  Returns the number of evaluated frames.
+ *****************************************************************************/
+uint32_t ArgusReplay_GetFrameCount(argus_hnd_t * hnd);
+
+/*! @} */
+#endif /* ARGUS_REPLAY_H */
@@ -0,0 +1,219 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the board support of the Linux host.
+ *
+ *              Build the ExplorerApp as host process and run it from the
+ *              repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  -ISources/Platform/Linux/argus -ISources/ExplorerApp \
+ *                  -ISources/ExplorerApp/core -ISources/ExplorerApp/sci \
+ *                  -ISources/ExplorerApp/tasks -ISources/ExplorerApp/api \
+ *                  Sources/ExplorerApp/{,api/,core/,sci/,tasks/}[a-z]*.c \
+ *                  Sources/Utility/{boot_profile,hr_clock,nvm_log,s2pi_queue}.c \
+ *                  Sources/Utility/{s2pi_trace,timer_mux}.c Sources/Utility/printf/printf.c \
+ *                  Sources/Platform/Linux/{argus,board,driver,record,sim}/[a-z]*.c \
+ *                  -lpthread -o explorer
+ *              AFBR_DEVICES=1,2 AFBR_FLASH=flash.bin ./explorer
+ *              @endcode
+ *              The pseudo terminal of the SCI is printed to stderr, see uart.h.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "board/board.h"
+#include "board/board_config.h"
+#include "driver/s2pi.h"
+#include "driver/uart.h"
+#include "driver/timer.h"
+#include "driver/flash.h"
+#include "driver/nvm.h"
+#include "debug.h" // declaration of print() and error_log()
+#include "boot_profile.h"
+#include "hr_clock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The maximum size of the command line that is restored by #Board_Reset. */
+#define BOARD_CMDLINE_SIZE 4096U
+
+/*! The maximum number of arguments that are restored by #Board_Reset. */
+#define BOARD_ARG_COUNT 64U
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The boot phase profiler handle of the startup phase. */
+static int32_t myStartupPhase = -1;
+
+/*! The process start time on CLOCK_MONOTONIC in microseconds. */
+static uint64_t myStartupTime = 0;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Board_GetMonotonicTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000U + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+static uint32_t Board_GetStartupTime(void)
+{
+    return (uint32_t)(Board_GetMonotonicTime() - myStartupTime);
+}
+
+static uint32_t Board_GetTime(void)
+{
+    return (uint32_t)HRClock_ToUSec(HRClock_Now());
+}
+
+__attribute__((constructor))
+void Board_Startup(void)
+{
+    myStartupTime = Board_GetMonotonicTime();
+
+    /* There is no reset cause register; the process always starts at power-on. */
+    BootProfile_Start(0);
+    BootProfile_SetClock(Board_GetStartupTime);
+    myStartupPhase = BootProfile_Begin(BOOT_PHASE_STARTUP, 0);
+}
+
+status_t Board_Init(void)
+{
+    BootProfile_End(myStartupPhase);
+    const int32_t board = BootProfile_Begin(BOOT_PHASE_BOARD, 0);
+
+    /* Initialize timer required by the API. */
+    int32_t phase = BootProfile_Begin(BOOT_PHASE_TIMER, 0);
+    Timer_Init();
+    BootProfile_SetClock(Board_GetTime);
+    BootProfile_End(phase);
+
+    /* Initialize UART for print functionality. */
+    phase = BootProfile_Begin(BOOT_PHASE_UART, 0);
+    status_t status = UART_Init();
+    BootProfile_End(phase);
+    if (status < STATUS_OK)
+    {
+        error_log("UART initialization failed, error code: %d", status);
+        return status;
+    }
+
+    /* Initialize the S2PI bus simulation required by the API. */
+    phase = BootProfile_Begin(BOOT_PHASE_S2PI, 0);
+    status = S2PI_Init(SPI_DEFAULT_SLAVE, SPI_BAUDRATE);
+    BootProfile_End(phase);
+    if (status < STATUS_OK)
+    {
+        error_log("S2PI initialization failed, error code: %d", status);
+        return status;
+    }
+
+    /* Initialize the Flash driver module; optionally persisted in a file. */
+    phase = BootProfile_Begin(BOOT_PHASE_FLASH, 0);
+    char const * flash = getenv("AFBR_FLASH");
+    status = flash ? Flash_Sim_Attach(flash) : STATUS_OK;
+    if (status == STATUS_OK) status = Flash_Init();
+    BootProfile_End(phase);
+    if (status < STATUS_OK)
+    {
+        error_log("Flash initialization failed, error code: %d", status);
+        return status;
+    }
+
+    /* Initialize the NVM module; mounts the record log. */
+    phase = BootProfile_Begin(BOOT_PHASE_NVM_INIT, 0);
+    status = NVM_Init();
+    BootProfile_End(phase);
+    if (status < STATUS_OK)
+    {
+        error_log("NVM initialization failed, error code: %d", status);
+        return status;
+    }
+
+    BootProfile_End(board);
+    return STATUS_OK;
+}
+
+void Board_Reset(void)
+{
+    /* Restart the process image with the original arguments. */
+    static char cmdline[BOARD_CMDLINE_SIZE];
+    char * argv[BOARD_ARG_COUNT + 1U];
+    size_t argc = 0;
+
+    FILE * f = fopen("/proc/self/cmdline", "rb");
+    if (f != 0)
+    {
+        const size_t size = fread(cmdline, 1, sizeof(cmdline) - 1U, f);
+        fclose(f);
+        cmdline[size] = '\0';
+
+        for (size_t i = 0; i < size && argc < BOARD_ARG_COUNT; i += strlen(cmdline + i) + 1U)
+        {
+            argv[argc++] = cmdline + i;
+        }
+    }
+    argv[argc] = 0;
+
+    if (argc > 0) execv("/proc/self/exe", argv);
+    exit(EXIT_FAILURE);
+}
+
+/* The stack usage of the MCU platforms is not available on the host. */
+uint32_t Debug_GetStackUsage(void)
+{
+    return 0;
+}
+
+void Debug_ResetStackUsage(void)
+{
+}
@@ -0,0 +1,89 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the board support of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef BOARD_H
+#define BOARD_H
+
+/*!***************************************************************************
+ * @defgroup    bsp Board Support Package
+ * @ingroup     platform
+ * @brief       Board Support Package
+ * @details     Board/Platform Depended Definitions of the Linux host port.
+ *
+ *              The simulated peripherals are configured by environment
+ *              variables:
+ *              - AFBR_UART: The serial device; a pseudo terminal otherwise.
+ *              - AFBR_UART_LINK: A symbolic link to the pseudo terminal.
+ *              - AFBR_DEVICES: The slaves with a connected device.
+ *              - AFBR_SIM_*: The timing of the simulated devices, see
+ *                argus_sim.h.
+ *              - AFBR_FLASH: A file that persists the flash memory.
+ *              - AFBR_REPLAY: The recording that is replayed by the Argus API
+ *                stand-in, see argus_replay.h.
+ *              .
+ * @addtogroup  bsp
+ * @{
+ *****************************************************************************/
+
+#include "utility/status.h"
+
+
+/*!***************************************************************************
+ * @brief   Starts the boot phase profiler.
+ * @details Called as a constructor before main(). Uses CLOCK_MONOTONIC for
+ *          the boot phases until the timer module is initialized.
+ *****************************************************************************/
+void Board_Startup(void);
+
+
+/*!***************************************************************************
+ * @brief   Initializes the board and its peripherals.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Board_Init(void);
+
+
+/*!***************************************************************************
+ * @brief   Enforce system reset!
+ * @details Restarts the process image with the same arguments.
+ *****************************************************************************/
+void Board_Reset(void);
+
+
+/*! @} */
+#endif /* BOARD_H */
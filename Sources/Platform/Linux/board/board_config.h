@@ -0,0 +1,109 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the board configuration of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef BOARD_CONFIG_H
+#define BOARD_CONFIG_H
+
+/*!***************************************************************************
+ * @defgroup    boardcfg Board Configuration
+ * @ingroup     platform
+ * @brief       Board Configuration
+ * @details     Board/Platform Depended Definitions of the Linux host port,
+ *              i.e. the simulated peripherals that run the ExplorerApp as a
+ *              host process.
+ * @addtogroup  boardcfg
+ * @{
+ *****************************************************************************/
+
+/*! The board name. */
+#define BOARD_NAME          "Linux Host"
+
+/*****************************************************************************
+ * Board UART configuration
+ *****************************************************************************/
+
+/*! The UART baud rate in bps; applied to the pseudo terminal. */
+#ifndef UART_BAUDRATE
+#define UART_BAUDRATE       115200U
+#endif
+
+
+/*****************************************************************************
+ * Board SPI configuration
+ *****************************************************************************/
+
+/*! The number of available S2PI slaves; mirrors the FRDM-KL46Z board. */
+#define S2PI_SLAVE_COUNT    6
+
+/*! Dummy Slave. */
+#define S2PI_SLAVE_NONE     0
+
+/*! Simulated Slave 1; Default Slave. */
+#define S2PI_SLAVE1         1
+
+/*! Simulated Slave 2. */
+#define S2PI_SLAVE2         2
+
+/*! Simulated Slave 3. */
+#define S2PI_SLAVE3         3
+
+/*! Simulated Slave 4. */
+#define S2PI_SLAVE4         4
+
+/*! Simulated Slave 5. */
+#define S2PI_SLAVE5         5
+
+/*! Simulated Slave 6. */
+#define S2PI_SLAVE6         6
+
+/*! The maximum SPI baud rate in bps of the simulated bus. */
+#ifndef SPI_MAX_BAUDRATE
+#define SPI_MAX_BAUDRATE    12000000U
+#endif
+
+/*! Define the default SPI slave for device. */
+#ifndef SPI_DEFAULT_SLAVE
+#define SPI_DEFAULT_SLAVE   (S2PI_SLAVE1)
+#endif
+
+#ifndef SPI_BAUDRATE
+#define SPI_BAUDRATE        SPI_MAX_BAUDRATE
+#endif
+
+/*! @} */
+#endif /* BOARD_CONFIG_H */
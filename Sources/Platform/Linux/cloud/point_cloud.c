@@ -0,0 +1,433 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides the conversion of the pixel data of measurement frames
+ *              into Cartesian point clouds on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "point_cloud.h"
+#include "api/argus_map.h"
+
+#include <assert.h>
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! Determines whether the AVX2 kernel is compiled in (via function attributes). */
+#if defined(__SSE2__) && defined(__GNUC__)
+#define POINT_CLOUD_HAS_AVX2 1
+#else
+#define POINT_CLOUD_HAS_AVX2 0
+#endif
+
+/*! The number of frames gathered from the measurement results at once. */
+#define POINT_CLOUD_BLOCK 16U
+
+/*! The scale factor of the #q9_22_t ranges. */
+#define RANGE_SCALE (1.0f / 4194304.0f)
+
+/*! The scale factor of the #uq12_4_t amplitudes. */
+#define AMPLITUDE_SCALE (1.0f / 16.0f)
+
+/*! The conversion kernel of a batch of frames. */
+typedef void (*kernel_t)(point_cloud_converter_t const * conv,
+                         q9_22_t const * range, uq12_4_t const * amplitude,
+                         uint8_t const * status, uint32_t stride,
+                         uint32_t frames, point_cloud_t const * cloud);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void ConvertScalar(point_cloud_converter_t const * conv,
+                          q9_22_t const * range, uq12_4_t const * amplitude,
+                          uint8_t const * status, uint32_t stride,
+                          uint32_t frames, point_cloud_t const * cloud)
+{
+    float * x = cloud->X;
+    float * y = cloud->Y;
+    float * z = cloud->Z;
+    float * i = cloud->I;
+
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t n = 0; n < ARGUS_PIXELS; ++n)
+        {
+            const float r = (float)range[n] * RANGE_SCALE;
+            const bool isValid = (status[n] & conv->StatusMask) == 0;
+            x[n] = isValid ? r * conv->DirX[n] : NAN;
+            y[n] = isValid ? r * conv->DirY[n] : NAN;
+            z[n] = isValid ? r * conv->DirZ[n] : NAN;
+            i[n] = (float)amplitude[n] * AMPLITUDE_SCALE;
+        }
+
+        range += stride;
+        amplitude += stride;
+        status += stride;
+        x += ARGUS_PIXELS;
+        y += ARGUS_PIXELS;
+        z += ARGUS_PIXELS;
+        i += ARGUS_PIXELS;
+    }
+}
+
+#if defined(__SSE2__)
+static void ConvertSse2(point_cloud_converter_t const * conv,
+                        q9_22_t const * range, uq12_4_t const * amplitude,
+                        uint8_t const * status, uint32_t stride,
+                        uint32_t frames, point_cloud_t const * cloud)
+{
+    const __m128 rscale = _mm_set1_ps(RANGE_SCALE);
+    const __m128 ascale = _mm_set1_ps(AMPLITUDE_SCALE);
+    const __m128 nan = _mm_set1_ps(NAN);
+    const __m128i mask = _mm_set1_epi32(conv->StatusMask);
+    const __m128i zero = _mm_setzero_si128();
+
+    float * x = cloud->X;
+    float * y = cloud->Y;
+    float * z = cloud->Z;
+    float * i = cloud->I;
+
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t n = 0; n < ARGUS_PIXELS; n += 4)
+        {
+            const __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(
+                _mm_loadu_si128((__m128i const *)(range + n))), rscale);
+
+            /* Zero extend the 16-bit amplitudes and the 8-bit status. */
+            const __m128i a = _mm_unpacklo_epi16(
+                _mm_loadl_epi64((__m128i const *)(amplitude + n)), zero);
+
+            int32_t s4;
+            memcpy(&s4, status + n, sizeof(s4));
+            const __m128i s = _mm_unpacklo_epi16(
+                _mm_unpacklo_epi8(_mm_cvtsi32_si128(s4), zero), zero);
+            const __m128 valid = _mm_castsi128_ps(
+                _mm_cmpeq_epi32(_mm_and_si128(s, mask), zero));
+
+            const __m128 px = _mm_mul_ps(r, _mm_load_ps(conv->DirX + n));
+            const __m128 py = _mm_mul_ps(r, _mm_load_ps(conv->DirY + n));
+            const __m128 pz = _mm_mul_ps(r, _mm_load_ps(conv->DirZ + n));
+
+            _mm_storeu_ps(x + n, _mm_or_ps(_mm_and_ps(valid, px), _mm_andnot_ps(valid, nan)));
+            _mm_storeu_ps(y + n, _mm_or_ps(_mm_and_ps(valid, py), _mm_andnot_ps(valid, nan)));
+            _mm_storeu_ps(z + n, _mm_or_ps(_mm_and_ps(valid, pz), _mm_andnot_ps(valid, nan)));
+            _mm_storeu_ps(i + n, _mm_mul_ps(_mm_cvtepi32_ps(a), ascale));
+        }
+
+        range += stride;
+        amplitude += stride;
+        status += stride;
+        x += ARGUS_PIXELS;
+        y += ARGUS_PIXELS;
+        z += ARGUS_PIXELS;
+        i += ARGUS_PIXELS;
+    }
+}
+#endif
+
+#if POINT_CLOUD_HAS_AVX2
+__attribute__((target("avx2")))
+static void ConvertAvx2(point_cloud_converter_t const * conv,
+                        q9_22_t const * range, uq12_4_t const * amplitude,
+                        uint8_t const * status, uint32_t stride,
+                        uint32_t frames, point_cloud_t const * cloud)
+{
+    const __m256 rscale = _mm256_set1_ps(RANGE_SCALE);
+    const __m256 ascale = _mm256_set1_ps(AMPLITUDE_SCALE);
+    const __m256 nan = _mm256_set1_ps(NAN);
+    const __m256i mask = _mm256_set1_epi32(conv->StatusMask);
+    const __m256i zero = _mm256_setzero_si256();
+
+    float * x = cloud->X;
+    float * y = cloud->Y;
+    float * z = cloud->Z;
+    float * i = cloud->I;
+
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t n = 0; n < ARGUS_PIXELS; n += 8)
+        {
+            const __m256 r = _mm256_mul_ps(_mm256_cvtepi32_ps(
+                _mm256_loadu_si256((__m256i const *)(range + n))), rscale);
+            const __m256i a = _mm256_cvtepu16_epi32(
+                _mm_loadu_si128((__m128i const *)(amplitude + n)));
+            const __m256i s = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64((__m128i const *)(status + n)));
+            const __m256 valid = _mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(_mm256_and_si256(s, mask), zero));
+
+            const __m256 px = _mm256_mul_ps(r, _mm256_load_ps(conv->DirX + n));
+            const __m256 py = _mm256_mul_ps(r, _mm256_load_ps(conv->DirY + n));
+            const __m256 pz = _mm256_mul_ps(r, _mm256_load_ps(conv->DirZ + n));
+
+            _mm256_storeu_ps(x + n, _mm256_blendv_ps(nan, px, valid));
+            _mm256_storeu_ps(y + n, _mm256_blendv_ps(nan, py, valid));
+            _mm256_storeu_ps(z + n, _mm256_blendv_ps(nan, pz, valid));
+            _mm256_storeu_ps(i + n, _mm256_mul_ps(_mm256_cvtepi32_ps(a), ascale));
+        }
+
+        range += stride;
+        amplitude += stride;
+        status += stride;
+        x += ARGUS_PIXELS;
+        y += ARGUS_PIXELS;
+        z += ARGUS_PIXELS;
+        i += ARGUS_PIXELS;
+    }
+}
+#endif
+
+#if defined(__ARM_NEON)
+static void ConvertNeon(point_cloud_converter_t const * conv,
+                        q9_22_t const * range, uq12_4_t const * amplitude,
+                        uint8_t const * status, uint32_t stride,
+                        uint32_t frames, point_cloud_t const * cloud)
+{
+    const float32x4_t nan = vdupq_n_f32(NAN);
+    const uint16x8_t mask = vdupq_n_u16(conv->StatusMask);
+
+    float * x = cloud->X;
+    float * y = cloud->Y;
+    float * z = cloud->Z;
+    float * i = cloud->I;
+
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t n = 0; n < ARGUS_PIXELS; n += 8)
+        {
+            const float32x4_t r0 = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(range + n)), RANGE_SCALE);
+            const float32x4_t r1 = vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(range + n + 4)), RANGE_SCALE);
+            const uint16x8_t a = vld1q_u16(amplitude + n);
+
+            /* The all-ones 16-bit compare results are sign extended to 32-bit. */
+            const uint16x8_t s = vceqq_u16(vandq_u16(vmovl_u8(vld1_u8(status + n)), mask),
+                                           vdupq_n_u16(0));
+            const uint32x4_t v0 = vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(vreinterpretq_s16_u16(s))));
+            const uint32x4_t v1 = vreinterpretq_u32_s32(vmovl_s16(vget_high_s16(vreinterpretq_s16_u16(s))));
+
+            vst1q_f32(x + n, vbslq_f32(v0, vmulq_f32(r0, vld1q_f32(conv->DirX + n)), nan));
+            vst1q_f32(x + n + 4, vbslq_f32(v1, vmulq_f32(r1, vld1q_f32(conv->DirX + n + 4)), nan));
+            vst1q_f32(y + n, vbslq_f32(v0, vmulq_f32(r0, vld1q_f32(conv->DirY + n)), nan));
+            vst1q_f32(y + n + 4, vbslq_f32(v1, vmulq_f32(r1, vld1q_f32(conv->DirY + n + 4)), nan));
+            vst1q_f32(z + n, vbslq_f32(v0, vmulq_f32(r0, vld1q_f32(conv->DirZ + n)), nan));
+            vst1q_f32(z + n + 4, vbslq_f32(v1, vmulq_f32(r1, vld1q_f32(conv->DirZ + n + 4)), nan));
+            vst1q_f32(i + n, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(a))), AMPLITUDE_SCALE));
+            vst1q_f32(i + n + 4, vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(a))), AMPLITUDE_SCALE));
+        }
+
+        range += stride;
+        amplitude += stride;
+        status += stride;
+        x += ARGUS_PIXELS;
+        y += ARGUS_PIXELS;
+        z += ARGUS_PIXELS;
+        i += ARGUS_PIXELS;
+    }
+}
+#endif
+
+static kernel_t GetKernel(point_cloud_kernel_t kernel)
+{
+    switch (kernel)
+    {
+        case POINT_CLOUD_KERNEL_SCALAR:
+            return ConvertScalar;
+#if defined(__SSE2__)
+        case POINT_CLOUD_KERNEL_SSE2:
+            return ConvertSse2;
+#endif
+#if POINT_CLOUD_HAS_AVX2
+        case POINT_CLOUD_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2") ? ConvertAvx2 : 0;
+#endif
+#if defined(__ARM_NEON)
+        case POINT_CLOUD_KERNEL_NEON:
+            return ConvertNeon;
+#endif
+        default:
+            return 0;
+    }
+}
+
+status_t PointCloud_Init(point_cloud_converter_t * conv,
+                         point_cloud_geometry_t const * geometry,
+                         point_cloud_order_t order)
+{
+    static const point_cloud_geometry_t myDefault = POINT_CLOUD_GEOMETRY_DEFAULT;
+
+    if (conv == 0) return ERROR_INVALID_ARGUMENT;
+    if (order != POINT_CLOUD_ORDER_N && order != POINT_CLOUD_ORDER_CH)
+        return ERROR_INVALID_ARGUMENT;
+    if (geometry == 0) geometry = &myDefault;
+
+    const double deg = M_PI / 180.0;
+    const double cx = (ARGUS_PIXELS_X - 1 + geometry->RowShift) * 0.5;
+    const double cy = (ARGUS_PIXELS_Y - 1) * 0.5;
+
+    for (uint32_t k = 0; k < ARGUS_PIXELS; ++k)
+    {
+        const uint32_t n = order == POINT_CLOUD_ORDER_CH ? PIXEL_CH2N(k) : k;
+        const uint32_t x = PIXEL_N2X(n);
+        const uint32_t y = PIXEL_N2Y(n);
+
+        const double ax = ((x + (y & 1U) * geometry->RowShift) - cx) * geometry->PitchX
+                          + geometry->CenterX;
+        const double ay = (y - cy) * geometry->PitchY + geometry->CenterY;
+        const double tx = tan(ax * deg);
+        const double ty = tan(ay * deg);
+        const double norm = sqrt(tx * tx + ty * ty + 1.0);
+
+        conv->DirX[k] = (float)(tx / norm);
+        conv->DirY[k] = (float)(ty / norm);
+        conv->DirZ[k] = (float)(1.0 / norm);
+        conv->Index[k] = (uint8_t)n;
+    }
+
+    conv->StatusMask = POINT_CLOUD_STATUS_MASK;
+    return PointCloud_SetKernel(conv, POINT_CLOUD_KERNEL_AUTO);
+}
+
+void PointCloud_SetStatusMask(point_cloud_converter_t * conv, uint8_t mask)
+{
+    conv->StatusMask = mask;
+}
+
+status_t PointCloud_SetKernel(point_cloud_converter_t * conv, point_cloud_kernel_t kernel)
+{
+    if (kernel == POINT_CLOUD_KERNEL_AUTO)
+    {
+        static const point_cloud_kernel_t order[] = {
+            POINT_CLOUD_KERNEL_AVX2, POINT_CLOUD_KERNEL_SSE2, POINT_CLOUD_KERNEL_NEON };
+
+        kernel = POINT_CLOUD_KERNEL_SCALAR;
+        for (uint32_t k = 0; k < sizeof(order) / sizeof(order[0]); ++k)
+        {
+            if (GetKernel(order[k]) != 0)
+            {
+                kernel = order[k];
+                break;
+            }
+        }
+    }
+
+    if (GetKernel(kernel) == 0) return ERROR_NOT_SUPPORTED;
+    conv->Kernel = kernel;
+    return STATUS_OK;
+}
+
+char const * PointCloud_GetKernelName(point_cloud_kernel_t kernel)
+{
+    switch (kernel)
+    {
+        case POINT_CLOUD_KERNEL_AUTO: return "auto";
+        case POINT_CLOUD_KERNEL_SCALAR: return "scalar";
+        case POINT_CLOUD_KERNEL_SSE2: return "sse2";
+        case POINT_CLOUD_KERNEL_AVX2: return "avx2";
+        case POINT_CLOUD_KERNEL_NEON: return "neon";
+        default: return "unknown";
+    }
+}
+
+void PointCloud_ConvertArrays(point_cloud_converter_t const * conv,
+                              q9_22_t const * range, uq12_4_t const * amplitude,
+                              uint8_t const * status, uint32_t stride,
+                              uint32_t frames, point_cloud_t const * cloud)
+{
+    assert(stride >= ARGUS_PIXELS);
+    GetKernel(conv->Kernel)(conv, range, amplitude, status, stride, frames, cloud);
+}
+
+void PointCloud_ConvertResults(point_cloud_converter_t const * conv,
+                               argus_results_t const * results, uint32_t frames,
+                               point_cloud_t const * cloud)
+{
+    q9_22_t range[POINT_CLOUD_BLOCK * ARGUS_PIXELS] __attribute__((aligned(32)));
+    uq12_4_t amplitude[POINT_CLOUD_BLOCK * ARGUS_PIXELS] __attribute__((aligned(32)));
+    uint8_t status[POINT_CLOUD_BLOCK * ARGUS_PIXELS] __attribute__((aligned(32)));
+
+    const kernel_t kernel = GetKernel(conv->Kernel);
+    point_cloud_t out = *cloud;
+
+    while (frames > 0)
+    {
+        const uint32_t count = frames < POINT_CLOUD_BLOCK ? frames : POINT_CLOUD_BLOCK;
+
+        /* Transpose the pixel structures into arrays for the vector kernels. */
+        for (uint32_t f = 0; f < count; ++f)
+        {
+            for (uint32_t k = 0; k < ARGUS_PIXELS; ++k)
+            {
+                argus_pixel_t const * px = &results[f].Pixels[conv->Index[k]];
+                range[f * ARGUS_PIXELS + k] = px->Range;
+                amplitude[f * ARGUS_PIXELS + k] = px->Amplitude;
+                status[f * ARGUS_PIXELS + k] = (uint8_t)px->Status;
+            }
+        }
+
+        kernel(conv, range, amplitude, status, ARGUS_PIXELS, count, &out);
+
+        results += count;
+        frames -= count;
+        out.X += count * ARGUS_PIXELS;
+        out.Y += count * ARGUS_PIXELS;
+        out.Z += count * ARGUS_PIXELS;
+        out.I += count * ARGUS_PIXELS;
+    }
+}
@@ -0,0 +1,271 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides the conversion of the pixel data of measurement frames
+ *              into Cartesian point clouds on the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef POINT_CLOUD_H
+#define POINT_CLOUD_H
+
+/*!***************************************************************************
+ * @defgroup    point_cloud Point Cloud Conversion
+ * @ingroup     platform
+ * @brief       Vectorized Fixed Point to Float Point Cloud Conversion
+ * @details     Converts the #q9_22_t ranges and #uq12_4_t amplitudes of the
+ *              pixels of batches of measurement frames into Cartesian points
+ *              with intensity, stored as structure of arrays (SoA) of floats.
+ *
+ *              The unit direction vector of each pixel is computed once from
+ *              the geometry of the pixel field (#point_cloud_geometry_t) and
+ *              stored in a per-pixel table, such that the conversion boils
+ *              down to an integer to float conversion and four
+ *              multiplications per pixel:
+ *              @code
+ *              r = Range / 2^22;  x = r * DirX[n];  y = r * DirY[n];  z = r * DirZ[n]
+ *              i = Amplitude / 2^4
+ *              @endcode
+ *
+ *              The coordinate system follows the pixel field sketched at
+ *              #argus_results_t: the z-axis is the optical axis, the x- and
+ *              y-axis point along the pixel x- and y-indices. The odd rows
+ *              are shifted by half a pixel in x-direction. Use negative
+ *              pitches to mirror the axes, e.g. for the image inversion of
+ *              the receiver optics.
+ *
+ *              The pixel order of the input arrays is selected by
+ *              #point_cloud_order_t; the direction table is permuted
+ *              accordingly (see \link argus_map ADC Channel Mapping\endlink),
+ *              i.e. point k of a frame always belongs to input element k.
+ *              The reference pixel is not converted. Pixels with any of the
+ *              status flags of the status mask set (see
+ *              #PointCloud_SetStatusMask) yield NaN coordinates, such that
+ *              each frame yields exactly #ARGUS_PIXELS points (organized
+ *              point cloud).
+ *
+ *              The kernels use SSE2 or AVX2 on x86 and NEON on ARM; a scalar
+ *              fallback is always available. The AVX2 kernel is compiled
+ *              via function attributes and selected at runtime if the CPU
+ *              supports it. All kernels yield bit-identical results.
+ *
+ *              The converter holds no global state; a converter may be used
+ *              by several threads concurrently once it is initialized.
+ *
+ * @addtogroup  point_cloud
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_def.h"
+#include "api/argus_res.h"
+
+/*!***************************************************************************
+ * @brief   The nominal geometry of the pixel field of the AFBR-S50MV85G,
+ *          i.e. a pixel pitch of 1.55° in both directions.
+ * @details Other modules have a different field of view; see the datasheet
+ *          of the module in use.
+ *****************************************************************************/
+#define POINT_CLOUD_GEOMETRY_DEFAULT { 1.55f, 1.55f, 0.5f, 0.0f, 0.0f }
+
+/*! The default status mask; disabled, saturated, invalid pixels and pixels
+ *  without signal yield NaN coordinates. */
+#define POINT_CLOUD_STATUS_MASK (PIXEL_OFF | PIXEL_SAT | PIXEL_INVALID | PIXEL_NO_SIGNAL)
+
+/*! The geometry of the pixel field. */
+typedef struct point_cloud_geometry_t
+{
+    /*! The angular pixel pitch in x-direction in degree. */
+    float PitchX;
+
+    /*! The angular pixel pitch in y-direction in degree. */
+    float PitchY;
+
+    /*! The x-shift of the odd rows in units of the pixel pitch. */
+    float RowShift;
+
+    /*! The angle of the optical axis to the center of the pixel field in
+     *  x-direction in degree, e.g. from a boresight calibration. */
+    float CenterX;
+
+    /*! The angle of the optical axis to the center of the pixel field in
+     *  y-direction in degree. */
+    float CenterY;
+
+} point_cloud_geometry_t;
+
+/*! The pixel order of the input arrays. */
+typedef enum point_cloud_order_t
+{
+    /*! The order of #argus_results_t::Pixels, i.e. n = #PIXEL_XY2N(x, y). */
+    POINT_CLOUD_ORDER_N = 0,
+
+    /*! The ADC channel order, i.e. ch = #PIXEL_XY2CH(x, y). */
+    POINT_CLOUD_ORDER_CH = 1
+
+} point_cloud_order_t;
+
+/*! The conversion kernels. */
+typedef enum point_cloud_kernel_t
+{
+    /*! Selects the fastest kernel that is supported. */
+    POINT_CLOUD_KERNEL_AUTO = 0,
+
+    /*! The portable scalar kernel. */
+    POINT_CLOUD_KERNEL_SCALAR = 1,
+
+    /*! The SSE2 kernel; 4 pixels per iteration. */
+    POINT_CLOUD_KERNEL_SSE2 = 2,
+
+    /*! The AVX2 kernel; 8 pixels per iteration. */
+    POINT_CLOUD_KERNEL_AVX2 = 3,
+
+    /*! The NEON kernel; 8 pixels per iteration. */
+    POINT_CLOUD_KERNEL_NEON = 4
+
+} point_cloud_kernel_t;
+
+/*! The point cloud output buffers. Each buffer holds #ARGUS_PIXELS
+ *  consecutive points per frame; alignment to 32 bytes is recommended. */
+typedef struct point_cloud_t
+{
+    /*! The x-coordinates in meter. */
+    float * X;
+
+    /*! The y-coordinates in meter. */
+    float * Y;
+
+    /*! The z-coordinates in meter. */
+    float * Z;
+
+    /*! The intensities, i.e. the amplitudes in LSB. */
+    float * I;
+
+} point_cloud_t;
+
+/*! The converter; the members are private. */
+typedef struct point_cloud_converter_t
+{
+    /*! The x-components of the pixel directions in input order. */
+    float DirX[ARGUS_PIXELS] __attribute__((aligned(32)));
+
+    /*! The y-components of the pixel directions in input order. */
+    float DirY[ARGUS_PIXELS] __attribute__((aligned(32)));
+
+    /*! The z-components of the pixel directions in input order. */
+    float DirZ[ARGUS_PIXELS] __attribute__((aligned(32)));
+
+    /*! The index into #argus_results_t::Pixels of input element k. */
+    uint8_t Index[ARGUS_PIXELS];
+
+    /*! The status flags that invalidate a point. */
+    uint8_t StatusMask;
+
+    /*! The selected kernel. */
+    point_cloud_kernel_t Kernel;
+
+} point_cloud_converter_t;
+
+/*!***************************************************************************
+ * @brief   Initializes the converter, i.e. computes the direction table.
+ * @details Selects the default status mask (#POINT_CLOUD_STATUS_MASK) and
+ *          the fastest kernel.
+ * @param   conv The converter to be initialized.
+ * @param   geometry The geometry of the pixel field; 0 for
+ *                   #POINT_CLOUD_GEOMETRY_DEFAULT.
+ * @param   order The pixel order of the input arrays.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t PointCloud_Init(point_cloud_converter_t * conv,
+                         point_cloud_geometry_t const * geometry,
+                         point_cloud_order_t order);
+
+/*!***************************************************************************
+ * @brief   Sets the pixel status flags that invalidate a point.
+ * @param   conv The converter.
+ * @param   mask The #argus_px_status_t flags; 0 converts all pixels.
+ *****************************************************************************/
+void PointCloud_SetStatusMask(point_cloud_converter_t * conv, uint8_t mask);
+
+/*!***************************************************************************
+ * @brief   Selects the conversion kernel, e.g. for benchmarking.
+ * @param   conv The converter.
+ * @param   kernel The kernel; #POINT_CLOUD_KERNEL_AUTO for the fastest.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          #ERROR_NOT_SUPPORTED if the kernel is not compiled in or not
+ *          supported by the CPU.
+ *****************************************************************************/
+status_t PointCloud_SetKernel(point_cloud_converter_t * conv, point_cloud_kernel_t kernel);
+
+/*!***************************************************************************
+ * @brief   Gets the name of a kernel.
+ * @param   kernel The kernel.
+ * @return  Returns the name, e.g. "avx2".
+ *****************************************************************************/
+char const * PointCloud_GetKernelName(point_cloud_kernel_t kernel);
+
+/*!***************************************************************************
+ * @brief   Converts a batch of frames given as pixel arrays (SoA input).
+ * @details The arrays hold the pixels of the frames at a fixed stride, e.g.
+ *          33 for the columnar layout of the \link record measurement
+ *          recording\endlink; only the first #ARGUS_PIXELS elements of each
+ *          frame are converted.
+ * @param   conv The converter.
+ * @param   range The pixel ranges.
+ * @param   amplitude The pixel amplitudes.
+ * @param   status The pixel status flags, see #argus_px_status_t.
+ * @param   stride The number of array elements per frame; >= #ARGUS_PIXELS.
+ * @param   frames The number of frames.
+ * @param   cloud The output buffers of frames * #ARGUS_PIXELS points.
+ *****************************************************************************/
+void PointCloud_ConvertArrays(point_cloud_converter_t const * conv,
+                              q9_22_t const * range, uq12_4_t const * amplitude,
+                              uint8_t const * status, uint32_t stride,
+                              uint32_t frames, point_cloud_t const * cloud);
+
+/*!***************************************************************************
+ * @brief   Converts a batch of measurement results.
+ * @details The pixel data is gathered from #argus_results_t::Pixels in
+ *          blocks of frames before the conversion; the points are stored in
+ *          the selected order (#point_cloud_order_t).
+ * @param   conv The converter.
+ * @param   results The array of measurement results.
+ * @param   frames The number of frames.
+ * @param   cloud The output buffers of frames * #ARGUS_PIXELS points.
+ *****************************************************************************/
+void PointCloud_ConvertResults(point_cloud_converter_t const * conv,
+                               argus_results_t const * results, uint32_t frames,
+                               point_cloud_t const * cloud);
+
+/*! @} */
+#endif /* POINT_CLOUD_H */
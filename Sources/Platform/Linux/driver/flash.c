@@ -0,0 +1,314 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a RAM based flash simulator for the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "flash.h"
+
+#include <assert.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The value of an erased flash word. */
+#define FLASH_ERASED 0xFFFFFFFFU
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The RAM buffer of the simulated flash memory. */
+static uint32_t myRam[FLASH_TOTAL_SIZE / sizeof(uint32_t)];
+
+/*! The simulated flash memory; the RAM buffer or a mapped file. */
+static uint32_t * myFlash = myRam;
+
+/*! The erase cycles per sector. */
+static uint32_t myEraseCount[FLASH_BLOCK_COUNT];
+
+/*! The statistics. */
+static flash_sim_stats_t myStats;
+
+/*! Determines whether the simulated flash has been erased initially. */
+static bool isInitialized = false;
+
+/*! The remaining operations until the injected power failure; < 0 if disabled. */
+static int32_t myPowerCut = -1;
+
+/*! Determines whether the power is lost. */
+static bool isPowerLost = false;
+
+/*! The state of the random number generator for undefined data. */
+static uint32_t myRandom = 0x12345678U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t Random(void)
+{
+    /* xorshift32 */
+    myRandom ^= myRandom << 13;
+    myRandom ^= myRandom >> 17;
+    myRandom ^= myRandom << 5;
+    return myRandom;
+}
+
+static bool PowerFails(void)
+{
+    if (isPowerLost) return true;
+    if (myPowerCut < 0) return false;
+    if (myPowerCut-- > 0) return false;
+    isPowerLost = true;
+    return true;
+}
+
+static status_t EraseSector(uint32_t index)
+{
+    uint32_t * sector = &myFlash[index * FLASH_BLOCK_SIZE / sizeof(uint32_t)];
+
+    if (PowerFails())
+    {
+        /* An interrupted erase leaves undefined data behind. */
+        for (uint32_t i = 0; i < FLASH_BLOCK_SIZE / sizeof(uint32_t); ++i)
+            sector[i] |= Random();
+        return ERROR_FAIL;
+    }
+
+    memset(sector, 0xFF, FLASH_BLOCK_SIZE);
+    myEraseCount[index]++;
+    myStats.Erases++;
+    myStats.BusyTime += FLASH_SIM_ERASE_TIME_US;
+    return STATUS_OK;
+}
+
+static status_t ProgramWords(uint32_t index, uint32_t offset, uint8_t const * data, uint32_t size)
+{
+    uint32_t * dst = &myFlash[(index * FLASH_BLOCK_SIZE + offset) / sizeof(uint32_t)];
+    status_t status = STATUS_OK;
+
+    for (uint32_t i = 0; i < size / sizeof(uint32_t); ++i)
+    {
+        uint32_t word;
+        memcpy(&word, data + i * sizeof(uint32_t), sizeof(word));
+
+        if (PowerFails())
+        {
+            /* An interrupted program operation clears only some bits. */
+            dst[i] &= word | Random();
+            return ERROR_FAIL;
+        }
+
+        /* Programming can only clear bits; the verification fails otherwise. */
+        dst[i] &= word;
+        if (dst[i] != word) status = ERROR_FAIL;
+
+        myStats.Words++;
+        myStats.BusyTime += FLASH_SIM_PROGRAM_TIME_US;
+    }
+
+    return status;
+}
+
+status_t Flash_Init(void)
+{
+    if (!isInitialized)
+    {
+        Flash_Sim_Reset(myRandom);
+    }
+    return STATUS_OK;
+}
+
+status_t Flash_Read(uint32_t index, uint32_t offset,
+                    uint8_t * data, uint32_t size)
+{
+    assert(isInitialized);
+
+    if (data == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+    if (index >= FLASH_BLOCK_COUNT || offset + size > FLASH_BLOCK_SIZE)
+        return ERROR_OUT_OF_RANGE;
+    if (isPowerLost) return ERROR_FAIL;
+
+    memcpy(data, (uint8_t const *)myFlash + index * FLASH_BLOCK_SIZE + offset, size);
+    return STATUS_OK;
+}
+
+status_t Flash_Write(uint32_t index, uint32_t offset,
+                     uint8_t const * data, uint32_t size)
+{
+    assert(isInitialized);
+
+    if (data == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+    if (index >= FLASH_BLOCK_COUNT || offset + size > FLASH_BLOCK_SIZE)
+        return ERROR_OUT_OF_RANGE;
+    if (isPowerLost) return ERROR_FAIL;
+
+    /* Read, erase and reprogram the whole sector like the MCU drivers do. */
+    uint8_t sector[FLASH_BLOCK_SIZE];
+    memcpy(sector, (uint8_t const *)myFlash + index * FLASH_BLOCK_SIZE, FLASH_BLOCK_SIZE);
+    memcpy(sector + offset, data, size);
+
+    status_t status = EraseSector(index);
+    if (status < STATUS_OK) return status;
+
+    return ProgramWords(index, 0, sector, FLASH_BLOCK_SIZE);
+}
+
+status_t Flash_Program(uint32_t index, uint32_t offset,
+                       uint8_t const * data, uint32_t size)
+{
+    assert(isInitialized);
+
+    if (data == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+    if (((uintptr_t)data | offset | size) & 0x03U) return ERROR_INVALID_ARGUMENT;
+    if (index >= FLASH_BLOCK_COUNT || offset + size > FLASH_BLOCK_SIZE)
+        return ERROR_OUT_OF_RANGE;
+    if (isPowerLost) return ERROR_FAIL;
+
+    return ProgramWords(index, offset, data, size);
+}
+
+status_t Flash_Erase(uint32_t index)
+{
+    assert(isInitialized);
+
+    if (index >= FLASH_BLOCK_COUNT) return ERROR_OUT_OF_RANGE;
+    if (isPowerLost) return ERROR_FAIL;
+
+    return EraseSector(index);
+}
+
+status_t Flash_Clear(uint32_t index, uint32_t offset, uint32_t size)
+{
+    uint8_t zeros[FLASH_BLOCK_SIZE] = { 0 };
+    if (size > FLASH_BLOCK_SIZE) return ERROR_OUT_OF_RANGE;
+    return Flash_Write(index, offset, zeros, size);
+}
+
+status_t Flash_ClearAll(void)
+{
+    status_t status = STATUS_OK;
+    for (uint8_t idx = 0; idx < FLASH_BLOCK_COUNT; idx++)
+    {
+        status = Flash_Clear(idx, 0, FLASH_BLOCK_SIZE);
+        if (status != STATUS_OK) return status;
+    }
+    return status;
+}
+
+void Flash_Sim_Reset(uint32_t seed)
+{
+    memset(myFlash, 0xFF, FLASH_TOTAL_SIZE);
+    memset(myEraseCount, 0, sizeof(myEraseCount));
+    memset(&myStats, 0, sizeof(myStats));
+    myRandom = seed ? seed : 0x12345678U;
+    myPowerCut = -1;
+    isPowerLost = false;
+    isInitialized = true;
+}
+
+status_t Flash_Sim_Attach(char const * path)
+{
+    assert(path != 0);
+    assert(myFlash == myRam);
+
+    const int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) return ERROR_FAIL;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || ftruncate(fd, FLASH_TOTAL_SIZE) < 0)
+    {
+        close(fd);
+        return ERROR_FAIL;
+    }
+
+    void * map = mmap(0, FLASH_TOTAL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return ERROR_FAIL;
+
+    myFlash = map;
+
+    /* A new or grown file reads zeros; erase it like a factory new device. */
+    if ((uint32_t)st.st_size != FLASH_TOTAL_SIZE)
+    {
+        Flash_Sim_Reset(myRandom);
+    }
+    isInitialized = true;
+    return STATUS_OK;
+}
+
+void Flash_Sim_SetPowerCut(int32_t operations)
+{
+    myPowerCut = operations;
+}
+
+void Flash_Sim_PowerCycle(void)
+{
+    myPowerCut = -1;
+    isPowerLost = false;
+}
+
+bool Flash_Sim_IsPowerLost(void)
+{
+    return isPowerLost;
+}
+
+uint32_t Flash_Sim_GetEraseCount(uint32_t index)
+{
+    return index < FLASH_BLOCK_COUNT ? myEraseCount[index] : 0;
+}
+
+void Flash_Sim_GetStats(flash_sim_stats_t * stats)
+{
+    assert(stats != 0);
+    *stats = myStats;
+}
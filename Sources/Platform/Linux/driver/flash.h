@@ -0,0 +1,248 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a RAM based flash simulator for the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FLASH_H
+#define FLASH_H
+
+/*!***************************************************************************
+ * @defgroup    flash : Flash Module.
+ * @ingroup     platform
+ * @brief       Flash Module Interface (RAM Simulator).
+ * @details     This module provides the flash interface of the MCU platforms
+ *              on top of a RAM buffer for the Linux host. It simulates the
+ *              properties of a NOR flash that are relevant for the
+ *              non-volatile memory module:
+ *              - Erasing sets all bytes of a sector to 0xFF.
+ *              - Programming can only clear bits; programming a word that
+ *                is not erased fails the verification.
+ *              - The erase cycles per sector and the busy time are counted;
+ *                the timings are the typical values of the Kinetis KL46Z.
+ *              - Power failures can be injected after a number of word
+ *                program or sector erase operations. The interrupted
+ *                operation leaves undefined data behind and all further
+ *                operations fail until #Flash_Sim_PowerCycle is called.
+ *              .
+ *              The contents persist over #Flash_Init, i.e. a simulated reset,
+ *              and over process restarts if a file is attached by
+ *              #Flash_Sim_Attach.
+ * @addtogroup  flash
+ * @{
+ *****************************************************************************/
+
+#include "nvm.h"
+#include "board/board_config.h"
+#include "api/argus_status.h"
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The size of a single (virtual) flash sector. */
+#define FLASH_BLOCK_SIZE 0x400
+
+/*! The number of devices whose NVM data (see #argus_nvm) is stored in the flash;
+ *  a record of #ARGUS_NVM_BLOCK_SIZE bytes occupies a whole flash sector.
+ *  Defaults to the number of S2PI slaves, at least 3 (the capacity of the
+ *  slot format of earlier firmware). */
+#ifndef FLASH_API_DEVICE_COUNT
+#if S2PI_SLAVE_COUNT > 3
+#define FLASH_API_DEVICE_COUNT S2PI_SLAVE_COUNT
+#else
+#define FLASH_API_DEVICE_COUNT 3
+#endif
+#endif
+
+/*! The number of flash blocks dedicated to the non-volatile memory module of the AFBR-S50 API;
+ *  the record log requires a spare block for the garbage collection (see #nvm_log). */
+#define FLASH_API_BLOCK_COUNT (FLASH_API_DEVICE_COUNT + 1)
+
+/*! The number of flash sectors; the layout of the NXP platform. */
+#define FLASH_BLOCK_COUNT (FLASH_API_BLOCK_COUNT + 1)
+
+/*! The total size in bytes of all flash sectors. */
+#define FLASH_TOTAL_SIZE (FLASH_BLOCK_COUNT * FLASH_BLOCK_SIZE)
+
+/*! The flash block index dedicated for the configuration data; located at
+ *  the 5th block from the end of the flash memory like in earlier firmware. */
+#define FLASH_EXPL_CFG_INDEX (FLASH_BLOCK_COUNT - 5)
+
+/*! The flash block index of the block \p n of the non-volatile memory module
+ *  of the AFBR-S50 API. The first four blocks are located above the
+ *  configuration block (the layout of earlier firmware), further blocks
+ *  below. */
+#define FLASH_API_BLOCK_INDEX(n) \
+    ((n) < 4U ? FLASH_EXPL_CFG_INDEX + 1U + (n) : (n) - 4U)
+
+/*! The simulated time to erase a sector in microseconds. */
+#define FLASH_SIM_ERASE_TIME_US 14000U
+
+/*! The simulated time to program a 32-bit word in microseconds. */
+#define FLASH_SIM_PROGRAM_TIME_US 65U
+
+/*! The statistics of the flash simulator. */
+typedef struct flash_sim_stats_t
+{
+    /*! The number of sector erase operations. */
+    uint32_t Erases;
+
+    /*! The number of programmed words. */
+    uint32_t Words;
+
+    /*! The simulated busy time in microseconds. */
+    uint64_t BusyTime;
+
+} flash_sim_stats_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!*****************************************************************************
+ * @brief   Initializes the flash module; the simulated flash is erased on
+ *          the first call only.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Init(void);
+
+/*!*****************************************************************************
+ * @brief   Reads data from a specified flash sector.
+ * @param   index The flash sector index.
+ * @param   offset The start address relative to the sector start.
+ * @param   data Pointer to the destination data buffer.
+ * @param   size The size of data to be read.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Read(uint32_t index, uint32_t offset,
+                    uint8_t * data, uint32_t size);
+
+/*!*****************************************************************************
+ * @brief   Programs flash with data to a specified flash sector, i.e. reads,
+ *          erases and reprograms the whole sector.
+ * @param   index The flash sector index.
+ * @param   offset The start address relative to the sector start.
+ * @param   data Pointer to the source data buffer.
+ * @param   size The size of data to be written.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Write(uint32_t index, uint32_t offset,
+                     uint8_t const * data, uint32_t size);
+
+/*!*****************************************************************************
+ * @brief   Programs data to an erased area of a specified flash sector.
+ * @param   index The flash sector index.
+ * @param   offset The start address relative to the sector start;
+ *                 a multiple of 4.
+ * @param   data Pointer to the word aligned source data buffer.
+ * @param   size The size of data to be programmed; a multiple of 4.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Program(uint32_t index, uint32_t offset,
+                       uint8_t const * data, uint32_t size);
+
+/*!*****************************************************************************
+ * @brief   Erases a specified flash sector, i.e. sets all bytes to 0xFF.
+ * @param   index The flash sector index.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Erase(uint32_t index);
+
+/*!*****************************************************************************
+ * @brief   Clears flash with zeros from a specified flash sector.
+ * @param   index The flash sector index.
+ * @param   offset The start address relative to the sector start.
+ * @param   size The size of data to be cleared.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Clear(uint32_t index, uint32_t offset, uint32_t size);
+
+/*!*****************************************************************************
+ * @brief   Clears complete user flash with zeros.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_ClearAll(void);
+
+/*!*****************************************************************************
+ * @brief   Erases the simulated flash and resets the statistics.
+ * @param   seed The seed of the random data of interrupted operations.
+ *****************************************************************************/
+void Flash_Sim_Reset(uint32_t seed);
+
+/*!*****************************************************************************
+ * @brief   Attaches a file that persists the simulated flash memory.
+ * @details The file is mapped into memory and replaces the RAM buffer; a new
+ *          file is created erased. Must be called before #Flash_Init.
+ * @param   path The path of the file.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Sim_Attach(char const * path);
+
+/*!*****************************************************************************
+ * @brief   Injects a power failure.
+ * @param   operations The number of word program or sector erase operations
+ *                     that succeed before the power fails; negative values
+ *                     disable the injection.
+ *****************************************************************************/
+void Flash_Sim_SetPowerCut(int32_t operations);
+
+/*!*****************************************************************************
+ * @brief   Restores the power after an injected power failure.
+ *****************************************************************************/
+void Flash_Sim_PowerCycle(void);
+
+/*!*****************************************************************************
+ * @brief   Determines whether an injected power failure has occurred.
+ * @return  Returns true if the power is lost.
+ *****************************************************************************/
+bool Flash_Sim_IsPowerLost(void);
+
+/*!*****************************************************************************
+ * @brief   Gets the number of erase cycles of a flash sector.
+ * @param   index The flash sector index.
+ * @return  Returns the number of erase cycles.
+ *****************************************************************************/
+uint32_t Flash_Sim_GetEraseCount(uint32_t index);
+
+/*!*****************************************************************************
+ * @brief   Gets the statistics of the flash simulator.
+ * @param   stats The statistics to be filled.
+ *****************************************************************************/
+void Flash_Sim_GetStats(flash_sim_stats_t * stats);
+
+/*! @} */
+#endif /* FLASH_H */
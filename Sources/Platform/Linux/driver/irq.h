@@ -0,0 +1,75 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the global interrupt control of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef IRQ_H
+#define IRQ_H
+
+/*!***************************************************************************
+ * @defgroup    IRQ IRQ: Global Interrupt Control
+ * @ingroup     driver
+ * @brief       Global IRQ Module (Linux Host)
+ * @details     This module emulates the global interrupt control of the MCU
+ *              platforms on a POSIX host.
+ *
+ *              The peripherals of the host port (timer, UART and S2PI) are
+ *              served by threads that invoke their "interrupt service
+ *              routines" with #IRQ_Enter / #IRQ_Leave. Both, the ISRs and
+ *              #IRQ_LOCK, acquire the same recursive mutex, i.e. locking the
+ *              interrupts blocks all ISRs and an ISR runs to completion
+ *              without the main thread interfering, just like a single core
+ *              MCU. The ISRs are not prioritized and do not preempt each
+ *              other.
+ * @addtogroup  IRQ
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_irq.h"
+
+/*!***************************************************************************
+ * @brief   Enters the interrupt context from a peripheral thread.
+ * @details Blocks while the interrupts are locked or another ISR is running.
+ *****************************************************************************/
+void IRQ_Enter(void);
+
+/*!***************************************************************************
+ * @brief   Leaves the interrupt context of a peripheral thread.
+ *****************************************************************************/
+void IRQ_Leave(void);
+
+/*! @} */
+#endif /* IRQ_H */
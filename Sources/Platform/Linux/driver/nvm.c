@@ -0,0 +1,256 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file contains implementations of the non-volatile memory module.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "nvm.h"
+#include "driver/flash.h"
+#include "nvm_log.h"
+#include "argus.h"
+
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The slot format of earlier firmware: three slots of a 16 byte header
+ *  (version, chip ID and slot count; big endian) and the data that are
+ *  packed into the blocks 1 to 3 of the API region. */
+#define NVM_LEGACY_SLOT_COUNT 3U
+
+/*! The first block of the slots of earlier firmware. */
+#define NVM_LEGACY_SECTOR 1U
+
+/*! The size of a slot header of earlier firmware. */
+#define NVM_LEGACY_HEADER_SIZE 16U
+
+/*! The size of a slot of earlier firmware. */
+#define NVM_LEGACY_SLOT_SIZE (NVM_LEGACY_HEADER_SIZE + ARGUS_NVM_BLOCK_SIZE)
+
+/*! Gets a big endian 32-bit value from the buffer \p buf at index \p idx. */
+#define NVM_LEGACY_GET32(buf, idx) \
+    (((uint32_t)(buf)[idx] << 24) | ((uint32_t)(buf)[(idx)+1] << 16) | \
+     ((uint32_t)(buf)[(idx)+2] << 8) | ((uint32_t)(buf)[(idx)+3]))
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static status_t NVM_FlashRead(uint32_t sector, uint32_t offset, uint8_t * data, uint32_t size);
+static status_t NVM_FlashProgram(uint32_t sector, uint32_t offset, uint8_t const * data, uint32_t size);
+static status_t NVM_FlashErase(uint32_t sector);
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The flash blocks of the AFBR-S50 API that hold the NVM record log;
+ *  the version is set at #NVM_Init. */
+static nvm_log_flash_t myFlash =
+{
+    .SectorSize = FLASH_BLOCK_SIZE,
+    .SectorCount = FLASH_API_BLOCK_COUNT,
+    .Read = NVM_FlashRead,
+    .Program = NVM_FlashProgram,
+    .Erase = NVM_FlashErase,
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static status_t NVM_FlashRead(uint32_t sector, uint32_t offset, uint8_t * data, uint32_t size)
+{
+    return Flash_Read(FLASH_API_BLOCK_INDEX(sector), offset, data, size);
+}
+
+static status_t NVM_FlashProgram(uint32_t sector, uint32_t offset, uint8_t const * data, uint32_t size)
+{
+    return Flash_Program(FLASH_API_BLOCK_INDEX(sector), offset, data, size);
+}
+
+static status_t NVM_FlashErase(uint32_t sector)
+{
+    return Flash_Erase(FLASH_API_BLOCK_INDEX(sector));
+}
+
+static status_t NVM_LegacyRead(uint32_t offset, uint8_t * data, uint32_t size)
+{
+    /* The slots span the block boundaries. */
+    while (size)
+    {
+        const uint32_t sector = NVM_LEGACY_SECTOR + offset / FLASH_BLOCK_SIZE;
+        const uint32_t pos = offset % FLASH_BLOCK_SIZE;
+        uint32_t n = FLASH_BLOCK_SIZE - pos;
+        if (n > size) n = size;
+
+        status_t status = NVM_FlashRead(sector, pos, data, n);
+        if (status < STATUS_OK) return status;
+
+        offset += n;
+        data += n;
+        size -= n;
+    }
+    return STATUS_OK;
+}
+
+static status_t NVM_LegacyIsLog(uint32_t offset, bool * isLog)
+{
+    /* A slot is ignored if any of its blocks belongs to the record log. */
+    *isLog = false;
+    for (uint32_t sector = NVM_LEGACY_SECTOR + offset / FLASH_BLOCK_SIZE;
+         sector <= NVM_LEGACY_SECTOR + (offset + NVM_LEGACY_SLOT_SIZE - 1U) / FLASH_BLOCK_SIZE;
+         ++sector)
+    {
+        uint32_t magic = 0;
+        status_t status = NVM_FlashRead(sector, 0, (uint8_t *)&magic, sizeof(magic));
+        if (status < STATUS_OK) return status;
+        if (magic == NVM_LOG_SECTOR_MAGIC) *isLog = true;
+    }
+    return STATUS_OK;
+}
+
+/*! The valid slots of earlier firmware, i.e. the newest slot per device. */
+typedef struct nvm_legacy_slots_t
+{
+    /*! The chip IDs of the devices. */
+    uint32_t ChipID[NVM_LEGACY_SLOT_COUNT];
+
+    /*! The slot count values; the higher the newer. */
+    uint32_t Count[NVM_LEGACY_SLOT_COUNT];
+
+    /*! The slot indices. */
+    uint32_t Slot[NVM_LEGACY_SLOT_COUNT];
+
+    /*! The number of devices. */
+    uint32_t Devices;
+
+} nvm_legacy_slots_t;
+
+static status_t NVM_ScanLegacySlots(nvm_legacy_slots_t * slots)
+{
+    memset(slots, 0, sizeof(nvm_legacy_slots_t));
+
+    for (uint32_t i = 0; i < NVM_LEGACY_SLOT_COUNT; ++i)
+    {
+        const uint32_t offset = i * NVM_LEGACY_SLOT_SIZE;
+
+        bool isLog = false;
+        status_t status = NVM_LegacyIsLog(offset, &isLog);
+        if (status < STATUS_OK) return status;
+        if (isLog) continue;
+
+        uint8_t header[NVM_LEGACY_HEADER_SIZE];
+        status = NVM_LegacyRead(offset, header, sizeof(header));
+        if (status < STATUS_OK) return status;
+
+        /* Slots of other API versions have been considered to be empty. */
+        const uint32_t id = NVM_LEGACY_GET32(header, 4);
+        const uint32_t count = NVM_LEGACY_GET32(header, 8);
+        if (NVM_LEGACY_GET32(header, 0) != myFlash.Version || id == 0 || id == 0xFFFFFFFFU)
+            continue;
+
+        /* Keep the newest slot per device. */
+        uint32_t k = 0;
+        while (k < slots->Devices && slots->ChipID[k] != id) k++;
+        if (k < slots->Devices && slots->Count[k] >= count) continue;
+        if (k == slots->Devices) slots->Devices++;
+
+        slots->ChipID[k] = id;
+        slots->Count[k] = count;
+        slots->Slot[k] = i;
+    }
+    return STATUS_OK;
+}
+
+static __attribute__((noinline)) status_t NVM_ImportLegacySlots(nvm_legacy_slots_t const * slots)
+{
+    /* The data is buffered since mounting the log erases the slots; this
+     * happens only once after an update from earlier firmware. A power
+     * failure before all slots are imported loses the erased ones. */
+    uint32_t data[NVM_LEGACY_SLOT_COUNT][ARGUS_NVM_BLOCK_SIZE / sizeof(uint32_t)];
+
+    for (uint32_t k = 0; k < slots->Devices; ++k)
+    {
+        status_t status = NVM_LegacyRead(slots->Slot[k] * NVM_LEGACY_SLOT_SIZE + NVM_LEGACY_HEADER_SIZE,
+                                         (uint8_t *)data[k], ARGUS_NVM_BLOCK_SIZE);
+        if (status < STATUS_OK) return status;
+    }
+
+    status_t status = NVMLog_Init(&myFlash);
+    if (status < STATUS_OK) return status;
+
+    /* Devices already in the log have been imported before a power failure
+     * or have been updated since; a remaining slot must not override them. */
+    for (uint32_t k = 0; k < slots->Devices; ++k)
+    {
+        if (NVMLog_Contains(slots->ChipID[k])) continue;
+
+        status = NVMLog_Write(slots->ChipID[k], ARGUS_NVM_BLOCK_SIZE, (uint8_t const *)data[k]);
+        if (status < STATUS_OK) return status;
+    }
+    return STATUS_OK;
+}
+
+status_t NVM_Init(void)
+{
+    /* Records of other API versions are considered to be empty. */
+    myFlash.Version = Argus_GetAPIVersion();
+
+    /* Import the slots of earlier firmware before the log erases them. */
+    nvm_legacy_slots_t slots;
+    status_t status = NVM_ScanLegacySlots(&slots);
+    if (status < STATUS_OK) return status;
+    if (slots.Devices > 0) return NVM_ImportLegacySlots(&slots);
+
+    return NVMLog_Init(&myFlash);
+}
+
+status_t NVM_WriteBlock(uint32_t device_id, uint32_t block_size, uint8_t const * buf)
+{
+    return NVMLog_Write(device_id, block_size, buf);
+}
+
+status_t NVM_ReadBlock(uint32_t device_id, uint32_t block_size, uint8_t * buf)
+{
+    return NVMLog_Read(device_id, block_size, buf);
+}
+
+status_t NVM_Clear(void)
+{
+    return NVMLog_Format();
+}
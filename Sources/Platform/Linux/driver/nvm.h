@@ -0,0 +1,77 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file contains implementations of the non-volatile memory module.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef NVM_H
+#define NVM_H
+
+/*!***************************************************************************
+ * @defgroup    nvm Non-Volatile Memory Module
+ * @ingroup     driver
+ * @brief       Non-Volatile Memory Module
+ * @details     An application specific wrapper around the flash module to
+ *              save/load the application specific settings.
+ *
+ * @addtogroup  nvm
+ * @{
+ *****************************************************************************/
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+
+#include "platform/argus_nvm.h"
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Initializes the non-volatile memory module.
+ * @details Mounts the record log (see #nvm_log) on the flash blocks of the
+ *          AFBR-S50 API, i.e. builds the RAM directory of the latest records.
+ *          Requires the flash module to be initialized (#Flash_Init).
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVM_Init(void);
+
+/*!***************************************************************************
+ * @brief   Erases all data of the non-volatile memory module.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVM_Clear(void);
+
+/*! @} */
+#endif /* NVM_H */
@@ -0,0 +1,563 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the S2PI driver of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "s2pi.h"
+
+#include "driver/irq.h"
+#include "sim/argus_sim.h"
+#include "s2pi_queue.h"
+#include "s2pi_trace.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The time in nanoseconds to set up a transfer, i.e. the chip select and
+ *  DMA setup of the MCU platforms. */
+#ifndef S2PI_SETUP_TIME_NS
+#define S2PI_SETUP_TIME_NS 2000U
+#endif
+
+/*! Enables the binary S2PI transfer trace, see #S2PITrace_Begin. */
+#ifndef S2PI_TRACE
+#define S2PI_TRACE 1
+#endif
+
+#if S2PI_TRACE
+#define S2PI_TRACE_BEGIN(slave, size) (myS2PIHnd.TraceId = S2PITrace_Begin(slave, size))
+#define S2PI_TRACE_END(status) S2PITrace_End(myS2PIHnd.TraceId, status)
+#else
+#define S2PI_TRACE_BEGIN(slave, size) (void)0
+#define S2PI_TRACE_END(status) (void)0
+#endif
+
+/*! The S2PI handle. */
+typedef struct s2pi_hnd_t
+{
+    /*! The current driver status. */
+    volatile status_t Status;
+
+    /*! The current slave, i.e. the last addressed one. */
+    s2pi_slave_t Slave;
+
+    /*! The transmit data of the ongoing transfer. */
+    uint8_t const * TxData;
+
+    /*! The receive data of the ongoing transfer; 0 if not required. */
+    uint8_t * RxData;
+
+    /*! The size of the ongoing transfer. */
+    size_t FrameSize;
+
+    /*! The callback of the ongoing transfer. */
+    s2pi_callback_t Callback;
+
+    /*! The callback parameter of the ongoing transfer. */
+    void * CallbackData;
+
+    /*! The sequence number of the ongoing transfer; identifies the transfer
+     *  that the bus thread completes. */
+    uint32_t Sequence;
+
+    /*! The end of the ongoing transfer on CLOCK_MONOTONIC in nanoseconds;
+     *  0 if no transfer is ongoing. */
+    uint64_t Deadline;
+
+    /*! The IRQ callbacks per slave. */
+    s2pi_irq_callback_t IrqCallback[S2PI_SLAVE_COUNT + 1];
+
+    /*! The IRQ callback parameters per slave. */
+    void * IrqCallbackData[S2PI_SLAVE_COUNT + 1];
+
+    /*! The baud rate per slave. */
+    uint32_t BaudRate[S2PI_SLAVE_COUNT + 1];
+
+    /*! The GPIO pin states in GPIO mode. */
+    uint32_t Pins[S2PI_IRQ + 1];
+
+    /*! A mutex used for queue operations. */
+    volatile bool SpiMutexBlocked;
+
+    /*! The identifier of the trace record of the ongoing transfer. */
+    uint32_t TraceId;
+
+} s2pi_hnd_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+static status_t S2PI_StartTransfer(s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData);
+static void S2PI_StartNext(void);
+static status_t S2PI_CompleteTransfer(status_t status);
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The S2PI handle. */
+static s2pi_hnd_t myS2PIHnd = { .Status = STATUS_IDLE };
+
+/*! Protects the deadline; never held while entering the interrupt context. */
+static pthread_mutex_t myMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Signals a new transfer to the bus thread. */
+static pthread_cond_t myCondition;
+
+/*! The bus thread. */
+static pthread_t myThread;
+
+static volatile bool isInitialized = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Host_GetNanoSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static inline bool S2PI_IsValidSlave(s2pi_slave_t slave)
+{
+    return slave > 0 && slave <= S2PI_SLAVE_COUNT;
+}
+
+/*! The IRQ handler of the simulated devices; in the interrupt context. */
+static void S2PI_IrqHandler(s2pi_slave_t slave)
+{
+    s2pi_irq_callback_t callback = myS2PIHnd.IrqCallback[slave];
+    if (callback != 0) callback(myS2PIHnd.IrqCallbackData[slave]);
+}
+
+static void * S2PI_BusThread(void * param)
+{
+    (void)param;
+
+    pthread_mutex_lock(&myMutex);
+    for (;;)
+    {
+        if (myS2PIHnd.Deadline == 0)
+        {
+            pthread_cond_wait(&myCondition, &myMutex);
+            continue;
+        }
+
+        if (Host_GetNanoSeconds() < myS2PIHnd.Deadline)
+        {
+            const struct timespec ts = {
+                .tv_sec = (time_t)(myS2PIHnd.Deadline / 1000000000U),
+                .tv_nsec = (long)(myS2PIHnd.Deadline % 1000000000U)
+            };
+            pthread_cond_timedwait(&myCondition, &myMutex, &ts);
+            continue;
+        }
+
+        const uint32_t sequence = myS2PIHnd.Sequence;
+        myS2PIHnd.Deadline = 0;
+        pthread_mutex_unlock(&myMutex);
+
+        /* The transfer may have been aborted in the meantime. */
+        IRQ_Enter();
+        if (myS2PIHnd.Status == STATUS_BUSY && myS2PIHnd.Sequence == sequence)
+        {
+            ArgusSim_Transfer(myS2PIHnd.Slave, myS2PIHnd.TxData,
+                              myS2PIHnd.RxData, myS2PIHnd.FrameSize);
+            S2PI_CompleteTransfer(STATUS_OK);
+        }
+        IRQ_Leave();
+
+        pthread_mutex_lock(&myMutex);
+    }
+
+    return 0;
+}
+
+status_t S2PI_Init(s2pi_slave_t defaultSlave, uint32_t baudRate_Bps)
+{
+    assert(!isInitialized);
+    if (!S2PI_IsValidSlave(defaultSlave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    S2PIQueue_Init();
+
+    myS2PIHnd.Status = STATUS_IDLE;
+    myS2PIHnd.Slave = defaultSlave;
+    for (uint32_t i = 0; i <= S2PI_IRQ; ++i) myS2PIHnd.Pins[i] = 1U;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&myCondition, &attr);
+    pthread_condattr_destroy(&attr);
+
+    isInitialized = true;
+
+    if (pthread_create(&myThread, 0, S2PI_BusThread, 0) != 0) return ERROR_FAIL;
+    if (ArgusSim_Init(S2PI_IrqHandler) != STATUS_OK) return ERROR_FAIL;
+
+    status_t status = STATUS_OK;
+    for (s2pi_slave_t slave = 1; slave <= S2PI_SLAVE_COUNT; ++slave)
+    {
+        const status_t s = S2PI_SetBaudRate(slave, baudRate_Bps);
+        if (s < STATUS_OK) status = s;
+    }
+    return status;
+}
+
+uint32_t S2PI_GetBaudRate(s2pi_slave_t slave)
+{
+    if (!S2PI_IsValidSlave(slave)) slave = myS2PIHnd.Slave;
+    return myS2PIHnd.BaudRate[slave];
+}
+
+status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps)
+{
+    assert(isInitialized);
+    if (!S2PI_IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+    if (baudRate_Bps == 0) return ERROR_S2PI_INVALID_BAUDRATE;
+
+    /* The closest integer divider that does not exceed the requested rate. */
+    uint32_t divider = (SPI_MAX_BAUDRATE + baudRate_Bps - 1U) / baudRate_Bps;
+    if (divider == 0) divider = 1;
+    const uint32_t actual = SPI_MAX_BAUDRATE / divider;
+    myS2PIHnd.BaudRate[slave] = actual;
+
+    /* Check if the actual baud rate is within 10 % of the desired baud rate. */
+    if (baudRate_Bps > SPI_MAX_BAUDRATE || actual < baudRate_Bps - baudRate_Bps / 10U)
+        return ERROR_S2PI_INVALID_BAUDRATE;
+
+    return STATUS_OK;
+}
+
+status_t S2PI_GetStatus(s2pi_slave_t slave)
+{
+    assert(isInitialized);
+
+    /* A slave is idle while the bus is occupied by another slave. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    if (S2PIQueue_IsPending(slave))
+        status = STATUS_BUSY;
+    else if (status == STATUS_BUSY && myS2PIHnd.Slave != slave)
+        status = STATUS_IDLE;
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+status_t S2PI_TransferFrame(s2pi_slave_t slave,
+                            uint8_t const * txData,
+                            uint8_t * rxData,
+                            size_t frameSize,
+                            s2pi_callback_t callback,
+                            void * callbackData)
+{
+    assert(isInitialized);
+
+    /* Verify arguments. */
+    if (!txData || frameSize == 0) return ERROR_INVALID_ARGUMENT;
+    if (!S2PI_IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    /* Check the driver status, lock if idle; queue the frame otherwise. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    if (status != STATUS_IDLE)
+    {
+        status = S2PIQueue_Push(slave, txData, rxData, frameSize, callback, callbackData);
+        IRQ_UNLOCK();
+        return status;
+    }
+    myS2PIHnd.Status = STATUS_BUSY;
+    status = S2PI_StartTransfer(slave, txData, rxData, frameSize, callback, callbackData);
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+static status_t S2PI_StartTransfer(s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData)
+{
+    myS2PIHnd.Slave = slave;
+    myS2PIHnd.TxData = txData;
+    myS2PIHnd.RxData = rxData;
+    myS2PIHnd.FrameSize = frameSize;
+    myS2PIHnd.Callback = callback;
+    myS2PIHnd.CallbackData = callbackData;
+
+    S2PIQueue_TransferStarted(slave, frameSize);
+    S2PI_TRACE_BEGIN(slave, frameSize);
+
+    const uint64_t duration = (uint64_t)frameSize * 8U * 1000000000U
+                            / myS2PIHnd.BaudRate[slave] + S2PI_SETUP_TIME_NS
+                            + ArgusSim_GetSpiLatency();
+
+    pthread_mutex_lock(&myMutex);
+    myS2PIHnd.Sequence++;
+    myS2PIHnd.Deadline = Host_GetNanoSeconds() + duration;
+    pthread_cond_signal(&myCondition);
+    pthread_mutex_unlock(&myMutex);
+
+    return STATUS_OK;
+}
+
+static void S2PI_StartNext(void)
+{
+    s2pi_queue_entry_t next;
+
+    IRQ_LOCK();
+    if (myS2PIHnd.Status == STATUS_IDLE && S2PIQueue_Pop(&next, S2PI_QUEUE_ALL_SLAVES))
+    {
+        myS2PIHnd.Status = STATUS_BUSY;
+        S2PI_StartTransfer(next.Slave, next.TxData, next.RxData,
+                           next.FrameSize, next.Callback, next.CallbackData);
+    }
+    IRQ_UNLOCK();
+}
+
+static status_t S2PI_CompleteTransfer(status_t status)
+{
+    S2PIQueue_TransferFinished(myS2PIHnd.Slave);
+    S2PI_TRACE_END(status);
+
+    s2pi_callback_t callback = myS2PIHnd.Callback;
+    void * callbackData = myS2PIHnd.CallbackData;
+    myS2PIHnd.Callback = 0;
+
+    myS2PIHnd.Status = STATUS_IDLE;
+
+    /* Start the next queued frame back to back, i.e. before the callback. */
+    S2PI_StartNext();
+
+    /* Invoke callback if there is one */
+    if (callback != 0)
+    {
+        status = callback(status, callbackData);
+    }
+    return status;
+}
+
+status_t S2PI_TryGetMutex(s2pi_slave_t slave)
+{
+    (void)slave; // not used in this implementation
+
+    status_t status;
+
+    IRQ_LOCK();
+    if (!myS2PIHnd.SpiMutexBlocked)
+    {
+        myS2PIHnd.SpiMutexBlocked = true;
+        status = STATUS_OK;
+    }
+    else
+    {
+        status = STATUS_BUSY;
+    }
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+void S2PI_ReleaseMutex(s2pi_slave_t slave)
+{
+    (void)slave; // not used in this implementation
+    myS2PIHnd.SpiMutexBlocked = false;
+}
+
+status_t S2PI_Abort(s2pi_slave_t slave)
+{
+    assert(isInitialized);
+
+    IRQ_LOCK();
+
+    /* Remove the queued frames of the slave. */
+    s2pi_queue_entry_t entry;
+    while (S2PIQueue_Remove(slave, &entry))
+    {
+        if (entry.Callback != 0) entry.Callback(ERROR_ABORTED, entry.CallbackData);
+    }
+
+    /* Check if something is ongoing for the slave. */
+    const status_t status = myS2PIHnd.Status;
+    if (status == STATUS_BUSY && myS2PIHnd.Slave == slave)
+    {
+        /* The bus thread ignores the completion of the aborted transfer. */
+        pthread_mutex_lock(&myMutex);
+        myS2PIHnd.Sequence++;
+        myS2PIHnd.Deadline = 0;
+        pthread_mutex_unlock(&myMutex);
+
+        S2PI_CompleteTransfer(ERROR_ABORTED);
+    }
+
+    IRQ_UNLOCK();
+    return STATUS_OK;
+}
+
+status_t S2PI_SetIrqCallback(s2pi_slave_t slave,
+                             s2pi_irq_callback_t callback,
+                             void * callbackData)
+{
+    if (!S2PI_IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    IRQ_LOCK();
+    myS2PIHnd.IrqCallback[slave] = callback;
+    myS2PIHnd.IrqCallbackData[slave] = callbackData;
+    IRQ_UNLOCK();
+
+    return STATUS_OK;
+}
+
+uint32_t S2PI_ReadIrqPin(s2pi_slave_t slave)
+{
+    return ArgusSim_ReadIrqPin(slave);
+}
+
+status_t S2PI_CycleCsPin(s2pi_slave_t slave)
+{
+    if (!S2PI_IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    /* Check the driver status. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    IRQ_UNLOCK();
+
+    return status == STATUS_IDLE ? STATUS_OK : status;
+}
+
+status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
+{
+    if (!S2PI_IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    /* Check if something is ongoing. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    if (status != STATUS_IDLE)
+    {
+        IRQ_UNLOCK();
+        return status;
+    }
+    myS2PIHnd.Status = STATUS_S2PI_GPIO_MODE;
+    myS2PIHnd.Slave = slave;
+    IRQ_UNLOCK();
+
+    /* Note: Clock must be HI after capturing */
+    for (uint32_t i = 0; i <= S2PI_MOSI; ++i)
+    {
+        myS2PIHnd.Pins[i] = 1U;
+        ArgusSim_WriteGpioPin(slave, (s2pi_pin_t)i, 1U);
+    }
+
+    return STATUS_OK;
+}
+
+status_t S2PI_ReleaseGpioControl(s2pi_slave_t slave)
+{
+    (void)slave; // not used in this implementation
+
+    /* Check if something is ongoing. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    if (status != STATUS_S2PI_GPIO_MODE)
+    {
+        IRQ_UNLOCK();
+        return status;
+    }
+    myS2PIHnd.Status = STATUS_IDLE;
+    IRQ_UNLOCK();
+
+    S2PI_StartNext();
+
+    return STATUS_OK;
+}
+
+status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
+{
+    (void)slave;
+
+    /* Check if pin is valid. */
+    if (pin > S2PI_IRQ || value > 1)
+        return ERROR_INVALID_ARGUMENT;
+
+    /* Check if in GPIO mode. */
+    if (myS2PIHnd.Status != STATUS_S2PI_GPIO_MODE)
+        return ERROR_S2PI_INVALID_STATE;
+
+    myS2PIHnd.Pins[pin] = value;
+    ArgusSim_WriteGpioPin(myS2PIHnd.Slave, pin, value);
+    return STATUS_OK;
+}
+
+status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
+{
+    (void)slave;
+
+    /* Check if pin is valid. */
+    if (pin > S2PI_IRQ || !value)
+        return ERROR_INVALID_ARGUMENT;
+
+    /* Check if in GPIO mode. */
+    if (myS2PIHnd.Status != STATUS_S2PI_GPIO_MODE)
+        return ERROR_S2PI_INVALID_STATE;
+
+    if (pin == S2PI_MISO)
+        *value = ArgusSim_ReadMisoPin(myS2PIHnd.Slave);
+    else if (pin == S2PI_IRQ)
+        *value = ArgusSim_ReadIrqPin(myS2PIHnd.Slave);
+    else
+        *value = myS2PIHnd.Pins[pin];
+    return STATUS_OK;
+}
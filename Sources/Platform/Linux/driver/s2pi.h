@@ -0,0 +1,103 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the S2PI driver of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef S2PI_H
+#define S2PI_H
+
+/*!***************************************************************************
+ * @defgroup    S2PI S2PI: Serial Peripheral Interface
+ * @ingroup     driver
+ * @brief       S2PI: SPI incl. GPIO Hardware Layer Module (Linux Host)
+ * @details     Implements the S2PI interface of the AFBR-S50 API on a POSIX
+ *              host with simulated devices behind a single SPI bus:
+ *              - The frames are transferred asynchronously by a bus thread
+ *                that completes each frame after the time the bits take at
+ *                the baud rate of the slave and invokes the callback in the
+ *                interrupt context (see #IRQ_Enter). Frames that are issued
+ *                while the bus is busy are queued by the #s2pi_queue module.
+ *              - The slaves listed in the environment variable AFBR_DEVICES
+ *                (comma separated, e.g. "1,2,5"; default: the
+ *                #SPI_DEFAULT_SLAVE) have a device connected that is
+ *                simulated on the register level by the #argus_sim module.
+ *                The MISO line of the other slaves is pulled up, i.e. they
+ *                read 0xFF.
+ *              - The GPIO mode pins and the IRQ lines are connected to the
+ *                simulated devices; the IRQ callbacks are invoked by the
+ *                simulator thread in the interrupt context.
+ *              - The duration of a frame includes the additional latency
+ *                of the simulator timing, see #argus_sim_timing_t.
+ *              .
+ * @addtogroup  S2PI
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_s2pi.h"
+#include "board/board_config.h"
+
+/*!***************************************************************************
+ * @brief   Initialize the S2PI module.
+ * @details Starts the bus thread and the device simulator, see
+ *          #ArgusSim_Init.
+ * @param   slave The default SPI slave to be addressed right after module
+ *                initialization.
+ * @param   baudRate_Bps The default SPI baud rate in bauds-per-second.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t S2PI_Init(s2pi_slave_t slave, uint32_t baudRate_Bps);
+
+/*!***************************************************************************
+ * @brief   Returns the currently set baud rate of a slave.
+ * @param   slave The specified S2PI slave.
+ * @return  The current baud rate in bps.
+ *****************************************************************************/
+uint32_t S2PI_GetBaudRate(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Sets the SPI baud rate in bps of a slave.
+ * @details The baud rate is derived from #SPI_MAX_BAUDRATE by an integer
+ *          divider like the MCU platforms do.
+ * @param   slave The specified S2PI slave.
+ * @param   baudRate_Bps The default SPI baud rate in bauds-per-second.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          - #STATUS_OK on success
+ *          - #ERROR_S2PI_INVALID_BAUDRATE on invalid baud rate value.
+ *****************************************************************************/
+status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps);
+
+/*! @} */
+#endif // S2PI_H
@@ -0,0 +1,198 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the timer interface of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "timer.h"
+
+#include "driver/irq.h"
+#include "timer_mux.h"
+#include "hr_clock.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The frequency of the host clock in Hz, i.e. nanoseconds. */
+#define HOST_CLOCK_FREQ 1000000000U
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The host clock time at initialization in nanoseconds. */
+static uint64_t myEpoch = 0;
+
+/*! The next deadline on the host clock in nanoseconds; 0 if stopped. */
+static uint64_t myDeadline = 0;
+
+/*! Protects the deadline; never held while entering the interrupt context. */
+static pthread_mutex_t myMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Signals a new deadline to the timer thread. */
+static pthread_cond_t myCondition;
+
+/*! The timer thread. */
+static pthread_t myThread;
+
+static volatile bool isInitialized = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Host_GetNanoSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * HOST_CLOCK_FREQ + (uint64_t)ts.tv_nsec;
+}
+
+/*! Reads the host clock relative to the initialization; used as #hr_clock counter. */
+static uint64_t Host_GetTicks(void)
+{
+    return Host_GetNanoSeconds() - myEpoch;
+}
+
+/*!***************************************************************************
+ * @brief   Starts the one-shot timer to elapse after a given time.
+ * @details Used by the #timer_mux module to schedule the next interval event.
+ * @param   dt_microseconds The time until the next event; 0 stops the timer.
+ *****************************************************************************/
+static void Host_StartTimer(uint32_t dt_microseconds)
+{
+    pthread_mutex_lock(&myMutex);
+    myDeadline = dt_microseconds
+               ? Host_GetNanoSeconds() + (uint64_t)dt_microseconds * 1000U
+               : 0;
+    pthread_cond_signal(&myCondition);
+    pthread_mutex_unlock(&myMutex);
+}
+
+static void * Host_TimerThread(void * param)
+{
+    (void)param;
+
+    pthread_mutex_lock(&myMutex);
+    for (;;)
+    {
+        if (myDeadline == 0)
+        {
+            pthread_cond_wait(&myCondition, &myMutex);
+            continue;
+        }
+
+        if (Host_GetNanoSeconds() < myDeadline)
+        {
+            const struct timespec ts = {
+                .tv_sec = (time_t)(myDeadline / HOST_CLOCK_FREQ),
+                .tv_nsec = (long)(myDeadline % HOST_CLOCK_FREQ)
+            };
+            pthread_cond_timedwait(&myCondition, &myMutex, &ts);
+            continue;
+        }
+
+        /* The handler restarts the timer for the next deadline. */
+        myDeadline = 0;
+        pthread_mutex_unlock(&myMutex);
+
+        IRQ_Enter();
+        TimerMux_Handler();
+        IRQ_Leave();
+
+        pthread_mutex_lock(&myMutex);
+    }
+
+    return 0;
+}
+
+void Timer_Init(void)
+{
+    assert(!isInitialized);
+
+    myEpoch = Host_GetNanoSeconds();
+    isInitialized = true;
+    HRClock_Init64(Host_GetTicks, HOST_CLOCK_FREQ);
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&myCondition, &attr);
+    pthread_condattr_destroy(&attr);
+
+    /* Multiplex all intervals on the timer thread. */
+    TimerMux_Init(Host_StartTimer);
+
+    int error = pthread_create(&myThread, 0, Host_TimerThread, 0);
+    assert(error == 0);
+    (void)error;
+}
+
+void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
+{
+    assert(isInitialized);
+    assert(hct != 0);
+    assert(lct != 0);
+
+    const uint64_t usec = Host_GetTicks() / 1000U;
+    *hct = (uint32_t)(usec / 1000000U);
+    *lct = (uint32_t)(usec % 1000000U);
+}
+
+status_t Timer_SetCallback(timer_cb_t f)
+{
+    assert(isInitialized);
+    return TimerMux_SetCallback(f);
+}
+
+status_t Timer_SetInterval(uint32_t dt_microseconds, void * param)
+{
+    assert(isInitialized);
+    return TimerMux_SetInterval(dt_microseconds, param);
+}
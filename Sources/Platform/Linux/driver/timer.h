@@ -0,0 +1,70 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the timer interface of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef TIMER_H
+#define TIMER_H
+
+/*!***************************************************************************
+ * @defgroup    timer Timer: Hardware Timer Interface
+ * @ingroup     driver
+ * @brief       Timer Hardware Interface (Linux Host)
+ * @details     Implements the lifetime counter and the periodic interrupt
+ *              timer of the AFBR-S50 API on a POSIX host:
+ *              - The lifetime counter and the #hr_clock are derived from
+ *                CLOCK_MONOTONIC; both start at zero on #Timer_Init.
+ *              - The periodic intervals are multiplexed by the #timer_mux
+ *                module on a single one-shot deadline. A timer thread waits
+ *                for the deadline and calls #TimerMux_Handler in the
+ *                interrupt context (see #IRQ_Enter).
+ *              .
+ *              The achievable interval accuracy depends on the scheduling
+ *              latency of the host, typically 50 to 100 microseconds on a
+ *              desktop kernel.
+ * @addtogroup  timer
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_timer.h"
+
+/*!***************************************************************************
+ * @brief   Initializes the timer hardware and starts the timer thread.
+ *****************************************************************************/
+void Timer_Init(void);
+
+/*! @} */
+#endif /* TIMER_H */
@@ -0,0 +1,386 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the UART driver of the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#define _GNU_SOURCE
+#include "uart.h"
+
+#include "board/board_config.h"
+#include "driver/irq.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The size of the receive buffer, i.e. the maximum chunk per Rx callback. */
+#define UART_RX_CHUNK_SIZE 256U
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/* The weak print function writes to stderr; the SCI provides its own. */
+status_t print(const char  *fmt_s, ...);
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uart_error_callback_t myErrorCallback = 0;
+static uart_rx_callback_t myRxCallback = 0;
+static uart_tx_callback_t myTxCallback = 0;
+static void * myTxCallbackState = 0;
+
+static volatile bool isTxOnGoing = false;
+static uart_baud_rates_t myBaudRate = UART_INVALID_BPS;
+
+/*! The file descriptor of the serial device or pseudo terminal master. */
+static int myFd = -1;
+
+/*! The file descriptor of the pseudo terminal slave; kept open in order to
+ *  keep the terminal alive while no host tool is connected. */
+static int mySlaveFd = -1;
+
+/*! The buffer of the ongoing transmission. */
+static uint8_t const * myTxBuffer = 0;
+
+/*! The size of the ongoing transmission. */
+static size_t myTxSize = 0;
+
+/*! Protects the transmission request; never held while entering the interrupt context. */
+static pthread_mutex_t myTxMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Signals a new transmission request to the transmitter thread. */
+static pthread_cond_t myTxCondition = PTHREAD_COND_INITIALIZER;
+
+static pthread_t myRxThread;
+static pthread_t myTxThread;
+
+static volatile bool isInitialized = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static speed_t GetSpeed(uart_baud_rates_t baudRate)
+{
+    switch (baudRate)
+    {
+        case UART_115200_BPS: return B115200;
+        case UART_500000_BPS: return B500000;
+        case UART_1000000_BPS: return B1000000;
+        case UART_2000000_BPS: return B2000000;
+        case UART_INVALID_BPS:
+        default: return B0;
+    }
+}
+
+static status_t SetRawMode(int fd, uart_baud_rates_t baudRate)
+{
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) return ERROR_FAIL;
+
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    if (cfsetspeed(&tio, GetSpeed(baudRate)) != 0)
+        return ERROR_UART_BAUDRATE_NOT_SUPPORTED;
+
+    return tcsetattr(fd, TCSANOW, &tio) == 0 ? STATUS_OK : ERROR_FAIL;
+}
+
+static status_t OpenPseudoTerminal(void)
+{
+    myFd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (myFd < 0) return ERROR_FAIL;
+    fcntl(myFd, F_SETFD, FD_CLOEXEC); // closed by the re-exec of Board_Reset
+    if (grantpt(myFd) != 0 || unlockpt(myFd) != 0) return ERROR_FAIL;
+
+    char const * name = ptsname(myFd);
+    if (name == 0) return ERROR_FAIL;
+
+    mySlaveFd = open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (mySlaveFd < 0) return ERROR_FAIL;
+
+    /* The line discipline is a property of the slave side. */
+    status_t status = SetRawMode(mySlaveFd, myBaudRate);
+    if (status < STATUS_OK) return status;
+
+    char const * link = getenv("AFBR_UART_LINK");
+    if (link != 0)
+    {
+        unlink(link);
+        if (symlink(name, link) != 0)
+        {
+            fprintf(stderr, "UART: failed to create the link %s (errno %d)\n", link, errno);
+        }
+    }
+
+    fprintf(stderr, "UART: %s\n", name);
+    return STATUS_OK;
+}
+
+static void * RxThread(void * param)
+{
+    (void)param;
+    uint8_t data[UART_RX_CHUNK_SIZE];
+
+    for (;;)
+    {
+        const ssize_t size = read(myFd, data, sizeof(data));
+        if (size < 0 && errno == EINTR) continue;
+
+        IRQ_Enter();
+        if (size > 0)
+        {
+            if (myRxCallback) myRxCallback(data, (uint32_t)size);
+        }
+        else if (myErrorCallback)
+        {
+            myErrorCallback(ERROR_FAIL);
+        }
+        IRQ_Leave();
+
+        /* The device has been closed or removed; wait for it to come back. */
+        if (size <= 0) usleep(100000);
+    }
+
+    return 0;
+}
+
+static void * TxThread(void * param)
+{
+    (void)param;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&myTxMutex);
+        while (myTxSize == 0) pthread_cond_wait(&myTxCondition, &myTxMutex);
+        uint8_t const * data = myTxBuffer;
+        size_t size = myTxSize;
+        pthread_mutex_unlock(&myTxMutex);
+
+        status_t status = STATUS_OK;
+        while (size > 0)
+        {
+            const ssize_t n = write(myFd, data, size);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                status = ERROR_UART_TX_DMA_ERR;
+                break;
+            }
+            data += n;
+            size -= (size_t)n;
+        }
+
+        pthread_mutex_lock(&myTxMutex);
+        myTxSize = 0;
+        pthread_mutex_unlock(&myTxMutex);
+
+        IRQ_Enter();
+        isTxOnGoing = false;
+        if (status < STATUS_OK && myErrorCallback) myErrorCallback(status);
+        if (myTxCallback) myTxCallback(status, myTxCallbackState);
+        IRQ_Leave();
+    }
+
+    return 0;
+}
+
+status_t UART_Init(void)
+{
+    if (isInitialized) return STATUS_OK;
+
+    myBaudRate = UART_BAUDRATE;
+
+    status_t status;
+    char const * device = getenv("AFBR_UART");
+    if (device != 0)
+    {
+        myFd = open(device, O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (myFd < 0)
+        {
+            fprintf(stderr, "UART: failed to open %s (errno %d)\n", device, errno);
+            return ERROR_FAIL;
+        }
+        status = SetRawMode(myFd, myBaudRate);
+    }
+    else
+    {
+        status = OpenPseudoTerminal();
+    }
+    if (status < STATUS_OK) return status;
+
+    isInitialized = true;
+
+    if (pthread_create(&myRxThread, 0, RxThread, 0) != 0) return ERROR_FAIL;
+    if (pthread_create(&myTxThread, 0, TxThread, 0) != 0) return ERROR_FAIL;
+
+    return STATUS_OK;
+}
+
+uart_baud_rates_t UART_GetBaudRate(void)
+{
+    assert(isInitialized);
+    return myBaudRate;
+}
+
+status_t UART_CheckBaudRate(uart_baud_rates_t baudRate)
+{
+    return GetSpeed(baudRate) != B0 ? STATUS_OK : ERROR_UART_BAUDRATE_NOT_SUPPORTED;
+}
+
+status_t UART_SetBaudRate(uart_baud_rates_t baudRate)
+{
+    assert(isInitialized);
+
+    status_t status = UART_CheckBaudRate(baudRate);
+    if (status != STATUS_OK) return status;
+
+    /* Check that we're not busy.*/
+    IRQ_LOCK();
+    if (isTxOnGoing)
+    {
+        IRQ_UNLOCK();
+        return STATUS_BUSY;
+    }
+    isTxOnGoing = true;
+    IRQ_UNLOCK();
+
+    status = SetRawMode(mySlaveFd >= 0 ? mySlaveFd : myFd, baudRate);
+    if (status == STATUS_OK) myBaudRate = baudRate;
+
+    isTxOnGoing = false;
+    return status;
+}
+
+status_t UART_SendBuffer(uint8_t const * txBuff, size_t txSize, uart_tx_callback_t f, void * state)
+{
+    assert(isInitialized);
+    if (!isInitialized) return ERROR_NOT_INITIALIZED;
+
+    /* Verify arguments. */
+    if (!txBuff || !txSize) return ERROR_INVALID_ARGUMENT;
+
+    /* Check that we're not busy.*/
+    IRQ_LOCK();
+    if (isTxOnGoing)
+    {
+        IRQ_UNLOCK();
+        return STATUS_BUSY;
+    }
+    isTxOnGoing = true;
+    IRQ_UNLOCK();
+
+    myTxCallback = f;
+    myTxCallbackState = state;
+
+    pthread_mutex_lock(&myTxMutex);
+    myTxBuffer = txBuff;
+    myTxSize = txSize;
+    pthread_cond_signal(&myTxCondition);
+    pthread_mutex_unlock(&myTxMutex);
+
+    return STATUS_OK;
+}
+
+bool UART_IsTxBusy(void)
+{
+    assert(isInitialized);
+    return isTxOnGoing;
+}
+
+void UART_SetRxCallback(uart_rx_callback_t f)
+{
+    myRxCallback = f;
+}
+
+void UART_RemoveRxCallback(void)
+{
+    myRxCallback = 0;
+}
+
+void UART_SetErrorCallback(uart_error_callback_t f)
+{
+    myErrorCallback = f;
+}
+
+void UART_RemoveErrorCallback(void)
+{
+    myErrorCallback = 0;
+}
+
+/*******************************************************************************
+ * Debug Console Functions
+ ******************************************************************************/
+
+__attribute__((weak)) status_t print(const char *fmt_s, ...)
+{
+    va_list ap;
+    va_start(ap, fmt_s);
+    int len = vfprintf(stderr, fmt_s, ap);
+    va_end(ap);
+
+    /* The log messages are terminated by the SCI frames otherwise. */
+    if (len >= 0 && (*fmt_s == '\0' || fmt_s[strlen(fmt_s) - 1] != '\n'))
+        fputc('\n', stderr);
+
+    return len < 0 ? ERROR_FAIL : STATUS_OK;
+}
+
+/* The character output of the embedded printf library (printf.h). */
+void _putchar(char character)
+{
+    fputc(character, stderr);
+}
@@ -0,0 +1,527 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the recording format of measurement results for the Linux host.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef RECORD_H
+#define RECORD_H
+
+/*!***************************************************************************
+ * @defgroup    record Measurement Recording
+ * @ingroup     platform
+ * @brief       Chunked Binary Recording of Measurement Results
+ * @details     A versioned binary file format that stores streams of
+ *              #argus_results_t (optionally incl. #argus_results_debug_t)
+ *              per device for offline analysis and regression replay.
+ *
+ *              File layout (all sections are aligned to #RECORD_ALIGNMENT):
+ *              - The file header (#record_file_header_t).
+ *              - A sequence of frame chunks (#record_chunk_header_t +
+ *                payload). Each chunk holds up to ChunkFrames (see the
+ *                file header) consecutive frames of a single device.
+ *              - An index chunk with an entry per frame chunk
+ *                (#record_index_entry_t); written on close and referenced
+ *                by the IndexOffset of the file header. If the index is
+ *                missing, e.g. after a crash of the writer, the reader
+ *                rebuilds it by scanning the chunks.
+ *              .
+ *              The frame chunk payload comes in two layouts:
+ *              - Row layout: the #argus_results_t structures as is, such
+ *                that the reader can return pointers into the mapped file.
+ *              - Columnar layout (#RECORD_FLAG_COLUMNAR): the frame meta
+ *                data (#record_meta_t) followed by the range, amplitude and
+ *                status of the 33 pixels as separate arrays of
+ *                [frames][33] values, i.e. the layout of numpy arrays. The
+ *                phase, range window and raw amplitude are dropped.
+ *              .
+ *              The debug data (#RECORD_FLAG_DEBUG) follows as an array of
+ *              #argus_results_debug_t in both layouts.
+ *
+ *              The structures are stored in the memory layout of the host
+ *              that writes the file (little endian, natural alignment); the
+ *              reader rejects files with a different layout. The major
+ *              version changes with incompatible changes of the format.
+ *
+ * @addtogroup  record
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_api.h"
+#include <assert.h>
+#include <stdint.h>
+
+/*! The magic number of a recording file. */
+#define RECORD_MAGIC "AFBRREC"
+
+/*! The major version of the format; incompatible changes. */
+#define RECORD_VERSION_MAJOR 1U
+
+/*! The minor version of the format; compatible additions. */
+#define RECORD_VERSION_MINOR 0U
+
+/*! The magic number of a chunk header. */
+#define RECORD_CHUNK_MAGIC 0x4B434641U // "AFCK"
+
+/*! The alignment of the chunks and payload sections in bytes. */
+#define RECORD_ALIGNMENT 64U
+
+/*! The maximum number of device streams; the device identifiers are
+ *  0 .. #RECORD_DEVICE_COUNT - 1, e.g. the S2PI slave. */
+#define RECORD_DEVICE_COUNT 16U
+
+/*! The default number of frames per chunk. */
+#ifndef RECORD_CHUNK_SIZE
+#define RECORD_CHUNK_SIZE 256U
+#endif
+
+/*! The number of pixel values per frame, incl. the reference pixel. */
+#define RECORD_PIXELS (ARGUS_PIXELS + 1U)
+
+/*! The recording flags. */
+typedef enum record_flags_t
+{
+    /*! The debug data is recorded. */
+    RECORD_FLAG_DEBUG = 1U << 0U,
+
+    /*! The frames are stored in the columnar layout. */
+    RECORD_FLAG_COLUMNAR = 1U << 1U,
+
+} record_flags_t;
+
+/*! The chunk types. */
+typedef enum record_chunk_type_t
+{
+    /*! A chunk of frames of a single device. */
+    RECORD_CHUNK_FRAMES = 1U,
+
+    /*! The chunk index. */
+    RECORD_CHUNK_INDEX = 2U,
+
+} record_chunk_type_t;
+
+/*! The file header. */
+typedef struct record_file_header_t
+{
+    /*! The magic number, see #RECORD_MAGIC. */
+    char Magic[8];
+
+    /*! The major version, see #RECORD_VERSION_MAJOR. */
+    uint16_t VersionMajor;
+
+    /*! The minor version, see #RECORD_VERSION_MINOR. */
+    uint16_t VersionMinor;
+
+    /*! The size of the file header in bytes. */
+    uint16_t HeaderSize;
+
+    /*! The size of a chunk header in bytes. */
+    uint16_t ChunkHeaderSize;
+
+    /*! The size of #argus_results_t in bytes. */
+    uint16_t ResultsSize;
+
+    /*! The size of #argus_results_debug_t in bytes. */
+    uint16_t DebugSize;
+
+    /*! The size of #record_meta_t in bytes. */
+    uint16_t MetaSize;
+
+    /*! The recording flags, see #record_flags_t. */
+    uint16_t Flags;
+
+    /*! The version of the AFBR-S50 API that defines the structures. */
+    uint32_t ApiVersion;
+
+    /*! The maximum number of frames per chunk. */
+    uint32_t ChunkFrames;
+
+    /*! The offset of the index chunk; 0 if the file has not been closed. */
+    uint64_t IndexOffset;
+
+    /*! The total number of frames; valid if the index is present. */
+    uint64_t FrameCount;
+
+    /*! The bit mask of the recorded devices; valid if the index is present. */
+    uint32_t DeviceMask;
+
+    /*! Reserved for future use; zero. */
+    uint8_t Reserved[12];
+
+} record_file_header_t;
+
+/*! The chunk header; followed by the payload. */
+typedef struct record_chunk_header_t
+{
+    /*! The magic number, see #RECORD_CHUNK_MAGIC. */
+    uint32_t Magic;
+
+    /*! The chunk type, see #record_chunk_type_t. */
+    uint16_t Type;
+
+    /*! The device identifier of a frame chunk. */
+    uint8_t Device;
+
+    /*! The recording flags of a frame chunk, see #record_flags_t. */
+    uint8_t Flags;
+
+    /*! The number of frames or index entries. */
+    uint32_t Count;
+
+    /*! The index of the first frame within the device stream. */
+    uint32_t First;
+
+    /*! The size of the payload in bytes, incl. padding. */
+    uint64_t Size;
+
+    /*! The time stamp of the first frame. */
+    ltc_t Begin;
+
+    /*! The time stamp of the last frame. */
+    ltc_t End;
+
+    /*! Reserved for future use; zero. */
+    uint8_t Reserved[24];
+
+} record_chunk_header_t;
+
+/*! An entry of the chunk index. */
+typedef struct record_index_entry_t
+{
+    /*! The file offset of the chunk header. */
+    uint64_t Offset;
+
+    /*! The index of the first frame within the device stream. */
+    uint32_t First;
+
+    /*! The number of frames. */
+    uint32_t Count;
+
+    /*! The device identifier. */
+    uint8_t Device;
+
+    /*! The recording flags of the chunk. */
+    uint8_t Flags;
+
+    /*! Reserved for future use; zero. */
+    uint8_t Reserved[6];
+
+} record_index_entry_t;
+
+/*! The frame meta data of the columnar layout; the results w/o pixels. */
+typedef struct record_meta_t
+{
+    /*! The status of the measurement frame. */
+    status_t Status;
+
+    /*! The time stamp of the measurement frame. */
+    ltc_t TimeStamp;
+
+    /*! The configuration of the measurement frame. */
+    argus_meas_frame_t Frame;
+
+    /*! The 1D measurement data. */
+    argus_results_bin_t Bin;
+
+    /*! The auxiliary ADC channel data. */
+    argus_results_aux_t Auxiliary;
+
+} record_meta_t;
+
+static_assert(sizeof(record_file_header_t) == RECORD_ALIGNMENT, "record_file_header_t size");
+static_assert(sizeof(record_chunk_header_t) == RECORD_ALIGNMENT, "record_chunk_header_t size");
+static_assert(sizeof(record_index_entry_t) == 24U, "record_index_entry_t size");
+
+/*! The offsets of the sections within a frame chunk payload. */
+typedef struct record_layout_t
+{
+    /*! The #argus_results_t array (row layout) or the #record_meta_t
+     *  array (columnar layout). */
+    uint64_t Results;
+
+    /*! The pixel range array (q9_22_t [frames][33]); columnar layout. */
+    uint64_t Range;
+
+    /*! The pixel amplitude array (uq12_4_t [frames][33]); columnar layout. */
+    uint64_t Amplitude;
+
+    /*! The pixel status array (uint8_t [frames][33]); columnar layout. */
+    uint64_t Status;
+
+    /*! The #argus_results_debug_t array; if recorded. */
+    uint64_t Debug;
+
+    /*! The total payload size. */
+    uint64_t Size;
+
+} record_layout_t;
+
+/*! The pixel columns of a frame of the columnar layout. */
+typedef struct record_columns_t
+{
+    /*! The frame meta data. */
+    record_meta_t const * Meta;
+
+    /*! The ranges of the 33 pixels. */
+    q9_22_t const * Range;
+
+    /*! The amplitudes of the 33 pixels. */
+    uq12_4_t const * Amplitude;
+
+    /*! The status of the 33 pixels, see #argus_px_status_t. */
+    uint8_t const * Status;
+
+} record_columns_t;
+
+/*! The writer of a recording; the members are private. */
+typedef struct record_writer_t
+{
+    /*! The file descriptor. */
+    int Fd;
+
+    /*! The recording flags. */
+    uint32_t Flags;
+
+    /*! The maximum number of frames per chunk. */
+    uint32_t ChunkFrames;
+
+    /*! The current file offset. */
+    uint64_t Offset;
+
+    /*! The chunk buffers per device; allocated with the first frame. */
+    uint8_t * Buffer[RECORD_DEVICE_COUNT];
+
+    /*! The headers of the current chunk per device. */
+    record_chunk_header_t Chunk[RECORD_DEVICE_COUNT];
+
+    /*! The number of frames per device stream. */
+    uint32_t Frames[RECORD_DEVICE_COUNT];
+
+    /*! The chunk index. */
+    record_index_entry_t * Index;
+
+    /*! The number of index entries. */
+    uint32_t IndexCount;
+
+    /*! The capacity of the index. */
+    uint32_t IndexCapacity;
+
+} record_writer_t;
+
+/*! The reader of a recording; the members are private. */
+typedef struct record_reader_t
+{
+    /*! The mapped file. */
+    uint8_t const * Map;
+
+    /*! The size of the mapped file. */
+    uint64_t Size;
+
+    /*! The chunk index, sorted by device and first frame. */
+    record_index_entry_t * Index;
+
+    /*! The number of index entries. */
+    uint32_t IndexCount;
+
+    /*! The first index entry per device. */
+    uint32_t Begin[RECORD_DEVICE_COUNT];
+
+    /*! The number of index entries per device. */
+    uint32_t Chunks[RECORD_DEVICE_COUNT];
+
+    /*! The number of frames per device. */
+    uint32_t Frames[RECORD_DEVICE_COUNT];
+
+    /*! Determines whether the index has been rebuilt by scanning. */
+    bool isRecovered;
+
+} record_reader_t;
+
+/*!***************************************************************************
+ * @brief   Aligns a size or offset to #RECORD_ALIGNMENT.
+ *****************************************************************************/
+static inline uint64_t Record_Align(uint64_t size)
+{
+    return (size + RECORD_ALIGNMENT - 1U) & ~(uint64_t)(RECORD_ALIGNMENT - 1U);
+}
+
+/*!***************************************************************************
+ * @brief   Gets the section offsets of a frame chunk payload.
+ * @param   layout The layout to be filled.
+ * @param   flags The recording flags of the chunk.
+ * @param   count The number of frames in the chunk.
+ *****************************************************************************/
+static inline void Record_GetLayout(record_layout_t * layout, uint32_t flags, uint32_t count)
+{
+    uint64_t offset = 0;
+    layout->Results = 0;
+    if (flags & RECORD_FLAG_COLUMNAR)
+    {
+        offset = Record_Align((uint64_t)count * sizeof(record_meta_t));
+        layout->Range = offset;
+        offset = Record_Align(offset + (uint64_t)count * RECORD_PIXELS * sizeof(q9_22_t));
+        layout->Amplitude = offset;
+        offset = Record_Align(offset + (uint64_t)count * RECORD_PIXELS * sizeof(uq12_4_t));
+        layout->Status = offset;
+        offset = Record_Align(offset + (uint64_t)count * RECORD_PIXELS);
+    }
+    else
+    {
+        offset = Record_Align((uint64_t)count * sizeof(argus_results_t));
+        layout->Range = layout->Amplitude = layout->Status = 0;
+    }
+
+    layout->Debug = offset;
+    if (flags & RECORD_FLAG_DEBUG)
+    {
+        offset = Record_Align(offset + (uint64_t)count * sizeof(argus_results_debug_t));
+    }
+    layout->Size = offset;
+}
+
+/*!***************************************************************************
+ * @brief   Creates a recording file.
+ * @param   writer The writer to be initialized.
+ * @param   path The path of the file; an existing file is replaced.
+ * @param   flags The recording flags, see #record_flags_t.
+ * @param   chunkFrames The maximum number of frames per chunk; 0 for the
+ *                      default (#RECORD_CHUNK_SIZE).
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordWriter_Open(record_writer_t * writer, char const * path,
+                           uint32_t flags, uint32_t chunkFrames);
+
+/*!***************************************************************************
+ * @brief   Appends a frame to the stream of a device.
+ * @details The frame is buffered and written with the chunk. The debug
+ *          pointer of the results is not recorded.
+ * @param   writer The writer.
+ * @param   device The device identifier (< #RECORD_DEVICE_COUNT).
+ * @param   res The measurement results.
+ * @param   dbg The debug data; 0 for zeros. Ignored if the debug data is
+ *              not recorded.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordWriter_Append(record_writer_t * writer, uint8_t device,
+                             argus_results_t const * res,
+                             argus_results_debug_t const * dbg);
+
+/*!***************************************************************************
+ * @brief   Writes the pending chunks and the index and closes the file.
+ * @param   writer The writer.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordWriter_Close(record_writer_t * writer);
+
+/*!***************************************************************************
+ * @brief   Opens and maps a recording file.
+ * @param   reader The reader to be initialized.
+ * @param   path The path of the file.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordReader_Open(record_reader_t * reader, char const * path);
+
+/*!***************************************************************************
+ * @brief   Unmaps and closes a recording file.
+ * @param   reader The reader.
+ *****************************************************************************/
+void RecordReader_Close(record_reader_t * reader);
+
+/*!***************************************************************************
+ * @brief   Gets the file header of a recording.
+ * @param   reader The reader.
+ * @return  Returns the file header within the mapped file.
+ *****************************************************************************/
+record_file_header_t const * RecordReader_GetHeader(record_reader_t const * reader);
+
+/*!***************************************************************************
+ * @brief   Gets the number of frames of a device stream.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @return  Returns the number of frames; 0 if the device is not recorded.
+ *****************************************************************************/
+uint32_t RecordReader_GetFrameCount(record_reader_t const * reader, uint8_t device);
+
+/*!***************************************************************************
+ * @brief   Gets a frame of the row layout without copying.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @param   index The frame index within the device stream.
+ * @return  Returns the results within the mapped file; 0 if the frame does
+ *          not exist or is stored in the columnar layout.
+ *****************************************************************************/
+argus_results_t const * RecordReader_GetResults(record_reader_t const * reader,
+                                                uint8_t device, uint32_t index);
+
+/*!***************************************************************************
+ * @brief   Gets the pixel columns of a frame of the columnar layout without
+ *          copying.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @param   index The frame index within the device stream.
+ * @param   columns The columns to be filled with pointers into the file.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordReader_GetColumns(record_reader_t const * reader, uint8_t device,
+                                 uint32_t index, record_columns_t * columns);
+
+/*!***************************************************************************
+ * @brief   Gets the debug data of a frame without copying.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @param   index The frame index within the device stream.
+ * @return  Returns the debug data within the mapped file; 0 if the frame
+ *          does not exist or the debug data is not recorded.
+ *****************************************************************************/
+argus_results_debug_t const * RecordReader_GetDebug(record_reader_t const * reader,
+                                                    uint8_t device, uint32_t index);
+
+/*!***************************************************************************
+ * @brief   Copies a frame of any layout.
+ * @details The values that are not stored in the columnar layout are zero.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @param   index The frame index within the device stream.
+ * @param   res The results to be filled; the debug pointer is cleared.
+ * @param   dbg The debug data to be filled; may be 0. Zeros if the debug data
+ *              is not recorded.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t RecordReader_GetFrame(record_reader_t const * reader, uint8_t device,
+                               uint32_t index, argus_results_t * res,
+                               argus_results_debug_t * dbg);
+
+/*! @} */
+#endif /* RECORD_H */
@@ -0,0 +1,358 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the memory mapped reader of the measurement recording format.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "record.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline record_file_header_t const * GetHeader(record_reader_t const * reader)
+{
+    return (record_file_header_t const *)reader->Map;
+}
+
+static bool IsValidChunk(record_reader_t const * reader, uint64_t offset,
+                         record_chunk_header_t const ** chunk)
+{
+    if (offset + sizeof(record_chunk_header_t) > reader->Size) return false;
+
+    record_chunk_header_t const * c = (record_chunk_header_t const *)(reader->Map + offset);
+    if (c->Magic != RECORD_CHUNK_MAGIC) return false;
+    if (c->Size > reader->Size - offset - sizeof(record_chunk_header_t)) return false;
+
+    *chunk = c;
+    return true;
+}
+
+static bool IsValidFrameChunk(record_reader_t const * reader, record_chunk_header_t const * chunk)
+{
+    if (chunk->Type != RECORD_CHUNK_FRAMES) return false;
+    if (chunk->Device >= RECORD_DEVICE_COUNT || chunk->Count == 0) return false;
+
+    record_layout_t layout;
+    Record_GetLayout(&layout, chunk->Flags, chunk->Count);
+    (void)reader;
+    return layout.Size <= chunk->Size;
+}
+
+static int CompareEntries(void const * a, void const * b)
+{
+    record_index_entry_t const * x = a;
+    record_index_entry_t const * y = b;
+    if (x->Device != y->Device) return x->Device < y->Device ? -1 : 1;
+    if (x->First != y->First) return x->First < y->First ? -1 : 1;
+    return 0;
+}
+
+static status_t LoadIndex(record_reader_t * reader)
+{
+    record_chunk_header_t const * index;
+    const uint64_t offset = GetHeader(reader)->IndexOffset;
+    if (offset == 0 || !IsValidChunk(reader, offset, &index)) return ERROR_FAIL;
+    if (index->Type != RECORD_CHUNK_INDEX) return ERROR_FAIL;
+    if ((uint64_t)index->Count * sizeof(record_index_entry_t) > index->Size) return ERROR_FAIL;
+
+    reader->IndexCount = index->Count;
+    reader->Index = malloc((index->Count + 1U) * sizeof(record_index_entry_t));
+    if (reader->Index == 0) return ERROR_FAIL;
+    memcpy(reader->Index, index + 1, index->Count * sizeof(record_index_entry_t));
+
+    /* Verify the referenced chunks. */
+    for (uint32_t i = 0; i < reader->IndexCount; ++i)
+    {
+        record_chunk_header_t const * chunk;
+        record_index_entry_t const * entry = &reader->Index[i];
+        if (!IsValidChunk(reader, entry->Offset, &chunk)) return ERROR_FAIL;
+        if (!IsValidFrameChunk(reader, chunk)) return ERROR_FAIL;
+        if (chunk->Device != entry->Device || chunk->Count != entry->Count) return ERROR_FAIL;
+    }
+    return STATUS_OK;
+}
+
+static status_t ScanChunks(record_reader_t * reader)
+{
+    /* Rebuild the index from the chunks up to the first incomplete one. */
+    uint32_t capacity = 1024U;
+    free(reader->Index);
+    reader->IndexCount = 0;
+    reader->Index = malloc(capacity * sizeof(record_index_entry_t));
+    if (reader->Index == 0) return ERROR_FAIL;
+
+    uint64_t offset = GetHeader(reader)->HeaderSize;
+    record_chunk_header_t const * chunk;
+    while (IsValidChunk(reader, offset, &chunk))
+    {
+        if (chunk->Type == RECORD_CHUNK_FRAMES)
+        {
+            if (!IsValidFrameChunk(reader, chunk)) break;
+
+            if (reader->IndexCount == capacity)
+            {
+                capacity *= 2U;
+                record_index_entry_t * index = realloc(reader->Index, capacity * sizeof(*index));
+                if (index == 0) return ERROR_FAIL;
+                reader->Index = index;
+            }
+
+            record_index_entry_t * entry = &reader->Index[reader->IndexCount++];
+            memset(entry, 0, sizeof(*entry));
+            entry->Offset = offset;
+            entry->First = chunk->First;
+            entry->Count = chunk->Count;
+            entry->Device = chunk->Device;
+            entry->Flags = chunk->Flags;
+        }
+        offset += sizeof(record_chunk_header_t) + chunk->Size;
+    }
+
+    reader->isRecovered = true;
+    return STATUS_OK;
+}
+
+status_t RecordReader_Open(record_reader_t * reader, char const * path)
+{
+    if (reader == 0 || path == 0) return ERROR_INVALID_ARGUMENT;
+    memset(reader, 0, sizeof(*reader));
+
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return ERROR_FAIL;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (uint64_t)st.st_size < sizeof(record_file_header_t))
+    {
+        close(fd);
+        return ERROR_FAIL;
+    }
+
+    void * map = mmap(0, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return ERROR_FAIL;
+
+    reader->Map = map;
+    reader->Size = (uint64_t)st.st_size;
+
+    /* Reject other formats and structure layouts. */
+    record_file_header_t const * header = GetHeader(reader);
+    if (memcmp(header->Magic, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0
+        || header->VersionMajor != RECORD_VERSION_MAJOR
+        || header->HeaderSize < sizeof(record_file_header_t)
+        || header->ChunkHeaderSize != sizeof(record_chunk_header_t)
+        || header->ResultsSize != sizeof(argus_results_t)
+        || header->DebugSize != sizeof(argus_results_debug_t)
+        || header->MetaSize != sizeof(record_meta_t))
+    {
+        RecordReader_Close(reader);
+        return ERROR_NOT_SUPPORTED;
+    }
+
+    status_t status = LoadIndex(reader);
+    if (status < STATUS_OK) status = ScanChunks(reader);
+    if (status < STATUS_OK)
+    {
+        RecordReader_Close(reader);
+        return status;
+    }
+
+    /* Group the chunks per device in the order of the frames. */
+    qsort(reader->Index, reader->IndexCount, sizeof(record_index_entry_t), CompareEntries);
+    for (uint32_t i = 0; i < reader->IndexCount; ++i)
+    {
+        record_index_entry_t const * entry = &reader->Index[i];
+        if (reader->Chunks[entry->Device] == 0) reader->Begin[entry->Device] = i;
+
+        /* A gap in the frame sequence ends the stream, e.g. if a chunk
+         * in the middle of a crashed recording is missing. */
+        if (entry->First != reader->Frames[entry->Device]) continue;
+        reader->Chunks[entry->Device]++;
+        reader->Frames[entry->Device] += entry->Count;
+    }
+
+    madvise((void *)reader->Map, reader->Size, MADV_RANDOM);
+    return STATUS_OK;
+}
+
+void RecordReader_Close(record_reader_t * reader)
+{
+    if (reader == 0) return;
+    if (reader->Map != 0) munmap((void *)reader->Map, reader->Size);
+    free(reader->Index);
+    memset(reader, 0, sizeof(*reader));
+}
+
+record_file_header_t const * RecordReader_GetHeader(record_reader_t const * reader)
+{
+    return GetHeader(reader);
+}
+
+uint32_t RecordReader_GetFrameCount(record_reader_t const * reader, uint8_t device)
+{
+    return device < RECORD_DEVICE_COUNT ? reader->Frames[device] : 0;
+}
+
+/*!***************************************************************************
+ * @brief   Finds the chunk of a frame.
+ * @param   reader The reader.
+ * @param   device The device identifier.
+ * @param   index The frame index; replaced by the index within the chunk.
+ * @param   layout The layout of the chunk to be filled.
+ * @return  Returns the chunk payload; 0 if the frame does not exist.
+ *****************************************************************************/
+static uint8_t const * FindChunk(record_reader_t const * reader, uint8_t device,
+                                 uint32_t * index, record_layout_t * layout,
+                                 uint8_t * flags)
+{
+    if (device >= RECORD_DEVICE_COUNT || *index >= reader->Frames[device]) return 0;
+
+    /* Binary search for the last chunk that starts before the frame. */
+    record_index_entry_t const * entries = &reader->Index[reader->Begin[device]];
+    uint32_t lo = 0;
+    uint32_t hi = reader->Chunks[device];
+    while (hi - lo > 1U)
+    {
+        const uint32_t mid = (lo + hi) / 2U;
+        if (entries[mid].First <= *index) lo = mid;
+        else hi = mid;
+    }
+
+    record_index_entry_t const * entry = &entries[lo];
+    *index -= entry->First;
+    *flags = entry->Flags;
+    Record_GetLayout(layout, entry->Flags, entry->Count);
+    return reader->Map + entry->Offset + sizeof(record_chunk_header_t);
+}
+
+argus_results_t const * RecordReader_GetResults(record_reader_t const * reader,
+                                                uint8_t device, uint32_t index)
+{
+    record_layout_t layout;
+    uint8_t flags;
+    uint8_t const * payload = FindChunk(reader, device, &index, &layout, &flags);
+    if (payload == 0 || (flags & RECORD_FLAG_COLUMNAR)) return 0;
+
+    return (argus_results_t const *)(payload + layout.Results) + index;
+}
+
+status_t RecordReader_GetColumns(record_reader_t const * reader, uint8_t device,
+                                 uint32_t index, record_columns_t * columns)
+{
+    if (columns == 0) return ERROR_INVALID_ARGUMENT;
+
+    record_layout_t layout;
+    uint8_t flags;
+    uint8_t const * payload = FindChunk(reader, device, &index, &layout, &flags);
+    if (payload == 0) return ERROR_OUT_OF_RANGE;
+    if (!(flags & RECORD_FLAG_COLUMNAR)) return ERROR_NOT_SUPPORTED;
+
+    columns->Meta = (record_meta_t const *)(payload + layout.Results) + index;
+    columns->Range = (q9_22_t const *)(payload + layout.Range) + index * RECORD_PIXELS;
+    columns->Amplitude = (uq12_4_t const *)(payload + layout.Amplitude) + index * RECORD_PIXELS;
+    columns->Status = payload + layout.Status + index * RECORD_PIXELS;
+    return STATUS_OK;
+}
+
+argus_results_debug_t const * RecordReader_GetDebug(record_reader_t const * reader,
+                                                    uint8_t device, uint32_t index)
+{
+    record_layout_t layout;
+    uint8_t flags;
+    uint8_t const * payload = FindChunk(reader, device, &index, &layout, &flags);
+    if (payload == 0 || !(flags & RECORD_FLAG_DEBUG)) return 0;
+
+    return (argus_results_debug_t const *)(payload + layout.Debug) + index;
+}
+
+status_t RecordReader_GetFrame(record_reader_t const * reader, uint8_t device,
+                               uint32_t index, argus_results_t * res,
+                               argus_results_debug_t * dbg)
+{
+    if (res == 0) return ERROR_INVALID_ARGUMENT;
+
+    record_layout_t layout;
+    uint8_t flags;
+    uint8_t const * payload = FindChunk(reader, device, &index, &layout, &flags);
+    if (payload == 0) return ERROR_OUT_OF_RANGE;
+
+    if (flags & RECORD_FLAG_COLUMNAR)
+    {
+        record_meta_t const * meta = (record_meta_t const *)(payload + layout.Results) + index;
+        q9_22_t const * range = (q9_22_t const *)(payload + layout.Range) + index * RECORD_PIXELS;
+        uq12_4_t const * amplitude = (uq12_4_t const *)(payload + layout.Amplitude) + index * RECORD_PIXELS;
+        uint8_t const * pxStatus = payload + layout.Status + index * RECORD_PIXELS;
+
+        memset(res, 0, sizeof(*res));
+        res->Status = meta->Status;
+        res->TimeStamp = meta->TimeStamp;
+        res->Frame = meta->Frame;
+        res->Bin = meta->Bin;
+        res->Auxiliary = meta->Auxiliary;
+
+        for (uint32_t i = 0; i < RECORD_PIXELS; ++i)
+        {
+            res->Pixels[i].Range = range[i];
+            res->Pixels[i].Amplitude = amplitude[i];
+            res->Pixels[i].AmplitudeRaw = amplitude[i];
+            res->Pixels[i].Status = (argus_px_status_t)pxStatus[i];
+        }
+    }
+    else
+    {
+        memcpy(res, (argus_results_t const *)(payload + layout.Results) + index, sizeof(*res));
+    }
+    res->Debug = 0;
+
+    if (dbg != 0)
+    {
+        if (flags & RECORD_FLAG_DEBUG)
+            memcpy(dbg, (argus_results_debug_t const *)(payload + layout.Debug) + index, sizeof(*dbg));
+        else
+            memset(dbg, 0, sizeof(*dbg));
+    }
+    return STATUS_OK;
+}
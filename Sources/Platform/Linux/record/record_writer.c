@@ -0,0 +1,312 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the writer of the measurement recording format.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "record.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The initial capacity of the chunk index. */
+#define RECORD_INDEX_CAPACITY 1024U
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static status_t WriteAll(record_writer_t * writer, void const * data, uint64_t size)
+{
+    uint8_t const * p = data;
+    while (size > 0)
+    {
+        const ssize_t n = write(writer->Fd, p, size);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return ERROR_FAIL;
+        }
+        p += n;
+        size -= (uint64_t)n;
+        writer->Offset += (uint64_t)n;
+    }
+    return STATUS_OK;
+}
+
+static status_t AddIndexEntry(record_writer_t * writer, record_chunk_header_t const * chunk)
+{
+    if (writer->IndexCount == writer->IndexCapacity)
+    {
+        const uint32_t capacity = writer->IndexCapacity ? 2U * writer->IndexCapacity
+                                                        : RECORD_INDEX_CAPACITY;
+        record_index_entry_t * index = realloc(writer->Index, capacity * sizeof(*index));
+        if (index == 0) return ERROR_FAIL;
+        writer->Index = index;
+        writer->IndexCapacity = capacity;
+    }
+
+    record_index_entry_t * entry = &writer->Index[writer->IndexCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->Offset = writer->Offset;
+    entry->First = chunk->First;
+    entry->Count = chunk->Count;
+    entry->Device = chunk->Device;
+    entry->Flags = chunk->Flags;
+    return STATUS_OK;
+}
+
+static status_t FlushChunk(record_writer_t * writer, uint8_t device)
+{
+    record_chunk_header_t * chunk = &writer->Chunk[device];
+    if (chunk->Count == 0) return STATUS_OK;
+
+    /* A partial chunk is compacted to the layout of its frame count; the
+     * sections only move towards the beginning, hence in order. */
+    record_layout_t full, layout;
+    Record_GetLayout(&full, writer->Flags, writer->ChunkFrames);
+    Record_GetLayout(&layout, writer->Flags, chunk->Count);
+    if (chunk->Count < writer->ChunkFrames)
+    {
+        uint8_t * buffer = writer->Buffer[device];
+        const uint32_t n = chunk->Count;
+        if (writer->Flags & RECORD_FLAG_COLUMNAR)
+        {
+            memmove(buffer + layout.Range, buffer + full.Range, n * RECORD_PIXELS * sizeof(q9_22_t));
+            memmove(buffer + layout.Amplitude, buffer + full.Amplitude, n * RECORD_PIXELS * sizeof(uq12_4_t));
+            memmove(buffer + layout.Status, buffer + full.Status, n * RECORD_PIXELS);
+        }
+        if (writer->Flags & RECORD_FLAG_DEBUG)
+        {
+            memmove(buffer + layout.Debug, buffer + full.Debug, n * sizeof(argus_results_debug_t));
+        }
+    }
+
+    chunk->Size = layout.Size;
+
+    status_t status = AddIndexEntry(writer, chunk);
+    if (status < STATUS_OK) return status;
+
+    status = WriteAll(writer, chunk, sizeof(*chunk));
+    if (status < STATUS_OK) return status;
+
+    status = WriteAll(writer, writer->Buffer[device], layout.Size);
+    if (status < STATUS_OK) return status;
+
+    writer->Frames[device] += chunk->Count;
+    chunk->Count = 0;
+    return STATUS_OK;
+}
+
+status_t RecordWriter_Open(record_writer_t * writer, char const * path,
+                           uint32_t flags, uint32_t chunkFrames)
+{
+    if (writer == 0 || path == 0) return ERROR_INVALID_ARGUMENT;
+    if (flags & ~(uint32_t)(RECORD_FLAG_DEBUG | RECORD_FLAG_COLUMNAR)) return ERROR_INVALID_ARGUMENT;
+
+    memset(writer, 0, sizeof(*writer));
+    writer->Flags = flags;
+    writer->ChunkFrames = chunkFrames ? chunkFrames : RECORD_CHUNK_SIZE;
+
+    writer->Fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (writer->Fd < 0) return ERROR_FAIL;
+
+    record_file_header_t header = { .Magic = RECORD_MAGIC };
+    header.VersionMajor = RECORD_VERSION_MAJOR;
+    header.VersionMinor = RECORD_VERSION_MINOR;
+    header.HeaderSize = sizeof(record_file_header_t);
+    header.ChunkHeaderSize = sizeof(record_chunk_header_t);
+    header.ResultsSize = sizeof(argus_results_t);
+    header.DebugSize = sizeof(argus_results_debug_t);
+    header.MetaSize = sizeof(record_meta_t);
+    header.Flags = (uint16_t)flags;
+    header.ApiVersion = ARGUS_API_VERSION;
+    header.ChunkFrames = writer->ChunkFrames;
+
+    status_t status = WriteAll(writer, &header, sizeof(header));
+    if (status < STATUS_OK)
+    {
+        close(writer->Fd);
+        writer->Fd = -1;
+    }
+    return status;
+}
+
+status_t RecordWriter_Append(record_writer_t * writer, uint8_t device,
+                             argus_results_t const * res,
+                             argus_results_debug_t const * dbg)
+{
+    if (writer == 0 || res == 0) return ERROR_INVALID_ARGUMENT;
+    if (device >= RECORD_DEVICE_COUNT) return ERROR_INVALID_ARGUMENT;
+    if (writer->Fd < 0) return ERROR_FAIL;
+
+    record_layout_t layout;
+    Record_GetLayout(&layout, writer->Flags, writer->ChunkFrames);
+
+    if (writer->Buffer[device] == 0)
+    {
+        writer->Buffer[device] = aligned_alloc(RECORD_ALIGNMENT, layout.Size);
+        if (writer->Buffer[device] == 0) return ERROR_FAIL;
+    }
+
+    record_chunk_header_t * chunk = &writer->Chunk[device];
+    if (chunk->Count == 0)
+    {
+        memset(chunk, 0, sizeof(*chunk));
+        chunk->Magic = RECORD_CHUNK_MAGIC;
+        chunk->Type = RECORD_CHUNK_FRAMES;
+        chunk->Device = device;
+        chunk->Flags = (uint8_t)writer->Flags;
+        chunk->First = writer->Frames[device];
+        chunk->Begin = res->TimeStamp;
+    }
+    chunk->End = res->TimeStamp;
+
+    uint8_t * buffer = writer->Buffer[device];
+    const uint32_t n = chunk->Count;
+
+    if (writer->Flags & RECORD_FLAG_COLUMNAR)
+    {
+        record_meta_t * meta = (record_meta_t *)(buffer + layout.Results) + n;
+        q9_22_t * range = (q9_22_t *)(buffer + layout.Range) + n * RECORD_PIXELS;
+        uq12_4_t * amplitude = (uq12_4_t *)(buffer + layout.Amplitude) + n * RECORD_PIXELS;
+        uint8_t * pxStatus = buffer + layout.Status + n * RECORD_PIXELS;
+
+        memset(meta, 0, sizeof(*meta));
+        meta->Status = res->Status;
+        meta->TimeStamp = res->TimeStamp;
+        meta->Frame = res->Frame;
+        meta->Bin = res->Bin;
+        meta->Auxiliary = res->Auxiliary;
+
+        for (uint32_t i = 0; i < RECORD_PIXELS; ++i)
+        {
+            range[i] = res->Pixels[i].Range;
+            amplitude[i] = res->Pixels[i].Amplitude;
+            pxStatus[i] = (uint8_t)res->Pixels[i].Status;
+        }
+    }
+    else
+    {
+        argus_results_t * row = (argus_results_t *)(buffer + layout.Results) + n;
+        memcpy(row, res, sizeof(*row));
+        row->Debug = 0;
+    }
+
+    if (writer->Flags & RECORD_FLAG_DEBUG)
+    {
+        argus_results_debug_t * d = (argus_results_debug_t *)(buffer + layout.Debug) + n;
+        if (dbg != 0) memcpy(d, dbg, sizeof(*d));
+        else memset(d, 0, sizeof(*d));
+    }
+
+    chunk->Count++;
+    return chunk->Count == writer->ChunkFrames ? FlushChunk(writer, device) : STATUS_OK;
+}
+
+status_t RecordWriter_Close(record_writer_t * writer)
+{
+    if (writer == 0) return ERROR_INVALID_ARGUMENT;
+    if (writer->Fd < 0) return ERROR_FAIL;
+
+    status_t status = STATUS_OK;
+    for (uint8_t device = 0; device < RECORD_DEVICE_COUNT && status == STATUS_OK; ++device)
+    {
+        status = FlushChunk(writer, device);
+    }
+
+    /* The index chunk, followed by the update of the file header. */
+    if (status == STATUS_OK)
+    {
+        const uint64_t offset = writer->Offset;
+        const uint64_t size = (uint64_t)writer->IndexCount * sizeof(record_index_entry_t);
+
+        record_chunk_header_t chunk = { .Magic = RECORD_CHUNK_MAGIC };
+        chunk.Type = RECORD_CHUNK_INDEX;
+        chunk.Count = writer->IndexCount;
+        chunk.Size = Record_Align(size);
+
+        static const uint8_t padding[RECORD_ALIGNMENT] = { 0 };
+        status = WriteAll(writer, &chunk, sizeof(chunk));
+        if (status == STATUS_OK && size > 0) status = WriteAll(writer, writer->Index, size);
+        if (status == STATUS_OK) status = WriteAll(writer, padding, chunk.Size - size);
+
+        if (status == STATUS_OK)
+        {
+            record_file_header_t header;
+            if (pread(writer->Fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+            {
+                status = ERROR_FAIL;
+            }
+            else
+            {
+                header.IndexOffset = offset;
+                header.FrameCount = 0;
+                header.DeviceMask = 0;
+                for (uint8_t device = 0; device < RECORD_DEVICE_COUNT; ++device)
+                {
+                    header.FrameCount += writer->Frames[device];
+                    if (writer->Frames[device]) header.DeviceMask |= 1U << device;
+                }
+                if (pwrite(writer->Fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header))
+                    status = ERROR_FAIL;
+            }
+        }
+    }
+
+    if (close(writer->Fd) != 0 && status == STATUS_OK) status = ERROR_FAIL;
+    writer->Fd = -1;
+
+    for (uint8_t device = 0; device < RECORD_DEVICE_COUNT; ++device)
+    {
+        free(writer->Buffer[device]);
+        writer->Buffer[device] = 0;
+    }
+    free(writer->Index);
+    writer->Index = 0;
+
+    return status;
+}
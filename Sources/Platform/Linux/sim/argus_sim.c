@@ -0,0 +1,588 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a register level simulator of the AFBR-S50 devices.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "argus_sim.h"
+
+#include "api/argus_meas.h"
+#include "driver/irq.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of registers; the address is 7 bits. */
+#define ARGUS_SIM_REGISTER_COUNT 0x80U
+
+/*! The DMA mode configuration register. */
+#define ARGUS_SIM_REG_DMA 0x10U
+
+/*! The DMA mode bit of the DMA mode configuration register. */
+#define ARGUS_SIM_DMA_MODE 0x02U
+
+/*! The configuration register that enables the EEPROM access. */
+#define ARGUS_SIM_REG_EEPROM 0x12U
+
+/*! The EEPROM enable bit of the low byte of the EEPROM register. */
+#define ARGUS_SIM_EEPROM_ENABLE 0x40U
+
+/*! The RCO configuration register. */
+#define ARGUS_SIM_REG_RCO 0x14U
+
+/*! The offset of the RCO trim value in the RCO configuration register. */
+#define ARGUS_SIM_RCO_OFFSET 34
+
+/*! The measurement trigger register. */
+#define ARGUS_SIM_REG_TRIGGER 0x1CU
+
+/*! The pattern register that becomes a pipeline in DMA mode. */
+#define ARGUS_SIM_REG_PIPELINE 0x1EU
+
+/*! The size of a pipeline word in DMA mode incl. the address byte. */
+#define ARGUS_SIM_PIPELINE_SIZE 4U
+
+/*! The raw data register. */
+#define ARGUS_SIM_REG_RAW_DATA 0x32U
+
+/*! The first EEPROM command byte; followed by the read command and address. */
+#define ARGUS_SIM_EEPROM_CMD_ADDRESS 0x2CU
+
+/*! The second EEPROM command byte; followed by the data bits. */
+#define ARGUS_SIM_EEPROM_CMD_DATA 0x2FU
+
+/*! The 3 bit EEPROM read command. */
+#define ARGUS_SIM_EEPROM_READ 0x06U
+
+/*! The state of a simulated device. */
+typedef struct argus_sim_dev_t
+{
+    /*! Determines whether a device is connected. */
+    bool isConnected;
+
+    /*! The calibration data. */
+    argus_sim_device_t Config;
+
+    /*! The EEPROM contents incl. the Hamming code. */
+    uint8_t EEPROM[ARGUS_SIM_EEPROM_SIZE];
+
+    /*! The register contents. */
+    uint8_t Registers[ARGUS_SIM_REGISTER_COUNT][ARGUS_SIM_REGISTER_SIZE];
+
+    /*! The pipeline of the pattern register in DMA mode. */
+    uint8_t Pipeline[ARGUS_SIM_PIPELINE_SIZE];
+
+    /*! The raw data of the last measurement. */
+    uint8_t RawData[ARGUS_RAW_DATA_SIZE];
+
+    /*! The level of the IRQ line. */
+    volatile uint32_t IrqPin;
+
+    /*! The time to assert the IRQ line in nanoseconds; 0 if not measuring. */
+    uint64_t AssertTime;
+
+    /*! The time to invoke the IRQ handler in nanoseconds; 0 if not pending. */
+    uint64_t NotifyTime;
+
+    /*! The levels of the pins driven by the MCU in GPIO mode. */
+    uint32_t Pins[S2PI_IRQ + 1];
+
+    /*! The level of the MISO line in GPIO mode. */
+    uint32_t Miso;
+
+    /*! The number of clocks since the CS has been asserted. */
+    uint32_t Clocks;
+
+    /*! The bits received since the command byte. */
+    uint32_t Shift;
+
+    /*! The command byte of the current CS phase. */
+    uint8_t Command;
+
+    /*! The address of the last EEPROM read command. */
+    uint8_t Address;
+
+} argus_sim_dev_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The simulated devices per slave. */
+static argus_sim_dev_t myDevices[S2PI_SLAVE_COUNT + 1];
+
+/*! The timing of the simulated devices. */
+static argus_sim_timing_t myTiming;
+
+/*! The IRQ handler of the S2PI driver. */
+static argus_sim_irq_handler_t myIrqHandler = 0;
+
+/*! Protects the IRQ times; never held while entering the interrupt context. */
+static pthread_mutex_t myMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*! Signals a new IRQ time to the simulator thread. */
+static pthread_cond_t myCondition;
+
+/*! The simulator thread. */
+static pthread_t myThread;
+
+/*! The state of the random number generator of the jitter. */
+static uint32_t myRandom = 0x12345678U;
+
+static volatile bool isInitialized = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Host_GetNanoSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t Random(uint32_t max)
+{
+    /* xorshift32 */
+    uint32_t x = myRandom;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    myRandom = x;
+    return max ? x % (max + 1U) : 0;
+}
+
+static uint32_t GetEnv(char const * name)
+{
+    char const * value = getenv(name);
+    return value ? (uint32_t)strtoul(value, 0, 0) : 0;
+}
+
+static inline bool IsValidSlave(s2pi_slave_t slave)
+{
+    return slave > 0 && slave <= S2PI_SLAVE_COUNT;
+}
+
+static inline uint16_t GetRegister16(argus_sim_dev_t const * dev, uint8_t address)
+{
+    return (uint16_t)((dev->Registers[address][0] << 8U) | dev->Registers[address][1]);
+}
+
+/*!***************************************************************************
+ * @brief   Programs the EEPROM with the calibration data.
+ * @details The 120 data bits (LSB first) are placed at the non power of two
+ *          positions 1 .. 127 of a Hamming code; the 7 parity bits at the
+ *          power of two positions. Position p is bit p - 1 of the EEPROM
+ *          (LSB first); the last bit of the EEPROM is not protected.
+ *
+ *          The calibration data: the RCO trim in bits 7:3 of byte 0, the
+ *          module number in bits 4:0 of byte 1 and the chip ID in bytes 2
+ *          to 4 (little endian, 20 bits).
+ *****************************************************************************/
+static void ProgramEEPROM(argus_sim_dev_t * dev)
+{
+    uint8_t data[ARGUS_SIM_EEPROM_SIZE] = { 0 };
+    data[0] = (uint8_t)((dev->Config.RcoTrim & 0x1F) << 3U);
+    data[1] = dev->Config.Module & 0x1FU;
+    data[2] = (uint8_t)dev->Config.ChipID;
+    data[3] = (uint8_t)(dev->Config.ChipID >> 8U);
+    data[4] = (uint8_t)((dev->Config.ChipID >> 16U) & 0x0FU);
+
+    uint8_t * code = dev->EEPROM;
+    memset(code, 0, ARGUS_SIM_EEPROM_SIZE);
+
+    uint32_t parity = 0;
+    uint32_t bit = 0;
+    for (uint32_t p = 1; p < 128U; ++p)
+    {
+        if ((p & (p - 1U)) == 0) continue;
+        if ((data[bit / 8U] >> (bit % 8U)) & 1U)
+        {
+            code[(p - 1U) / 8U] |= (uint8_t)(1U << ((p - 1U) % 8U));
+            parity ^= p;
+        }
+        bit++;
+    }
+
+    for (uint32_t p = 1; p < 128U; p <<= 1U)
+    {
+        if (parity & p) code[(p - 1U) / 8U] |= (uint8_t)(1U << ((p - 1U) % 8U));
+    }
+}
+
+static void StartMeasurement(argus_sim_dev_t * dev, uint16_t trigger)
+{
+    const uint32_t samples = ((trigger >> 5U) & 0x3FFU) + 1U;
+
+    /* The RCO frequency depends on the deviation from the calibrated trim. */
+    const int32_t trim = (int32_t)((GetRegister16(dev, ARGUS_SIM_REG_RCO) >> 6U) & 0x3FU)
+                       - ARGUS_SIM_RCO_OFFSET;
+    const float frequency = 1.0f + ARGUS_SIM_RCO_STEP / 100.0f
+                          * (float)(trim - dev->Config.RcoTrim);
+
+    /* A synthetic raw data pattern that scales with the number of samples. */
+    for (uint32_t i = 0; i < ARGUS_RAW_DATA_VALUES; ++i)
+    {
+        uint32_t value = samples * (64U + (i % 33U) * 16U);
+        if (value > 0xFFFFFFU) value = 0xFFFFFFU;
+        dev->RawData[3U * i + 0U] = (uint8_t)(value >> 16U);
+        dev->RawData[3U * i + 1U] = (uint8_t)(value >> 8U);
+        dev->RawData[3U * i + 2U] = (uint8_t)value;
+    }
+
+    pthread_mutex_lock(&myMutex);
+    const uint64_t duration = (uint64_t)((float)(samples * ARGUS_SIM_SAMPLE_TIME_NS) / frequency)
+                            + ((uint64_t)myTiming.IrqDelay + Random(myTiming.IrqJitter)) * 1000U;
+    dev->AssertTime = Host_GetNanoSeconds() + duration;
+    pthread_cond_signal(&myCondition);
+    pthread_mutex_unlock(&myMutex);
+}
+
+void ArgusSim_Transfer(s2pi_slave_t slave, uint8_t const * txData,
+                       uint8_t * rxData, size_t frameSize)
+{
+    assert(isInitialized);
+    assert(txData != 0 && frameSize > 0);
+
+    if (!ArgusSim_IsConnected(slave))
+    {
+        /* No device connected; MISO is pulled up. */
+        if (rxData) memset(rxData, 0xFF, frameSize);
+        return;
+    }
+
+    argus_sim_dev_t * dev = &myDevices[slave];
+
+    /* Any frame releases the IRQ line. */
+    dev->IrqPin = 1U;
+
+    /* The data is shifted out while the new data is shifted in; Tx and Rx
+     * may be the same buffer. */
+    const uint8_t address = txData[0] & 0x7FU;
+    if (rxData) rxData[0] = 0;
+
+    if (address == ARGUS_SIM_REG_RAW_DATA)
+    {
+        /* Read only. */
+        for (size_t i = 1; i < frameSize && rxData; ++i)
+            rxData[i] = i <= ARGUS_RAW_DATA_SIZE ? dev->RawData[i - 1U] : 0;
+        return;
+    }
+
+    if (address == ARGUS_SIM_REG_PIPELINE
+        && (dev->Registers[ARGUS_SIM_REG_DMA][0] & ARGUS_SIM_DMA_MODE))
+    {
+        /* The word written before is shifted out, incl. its address byte. */
+        for (size_t i = 0; i < frameSize; ++i)
+        {
+            const uint8_t in = txData[i];
+            const uint8_t out = dev->Pipeline[i % ARGUS_SIM_PIPELINE_SIZE];
+            dev->Pipeline[i % ARGUS_SIM_PIPELINE_SIZE] = in;
+            if (rxData && i > 0) rxData[i] = out;
+        }
+        return;
+    }
+
+    uint8_t * reg = dev->Registers[address];
+    for (size_t i = 1; i < frameSize; ++i)
+    {
+        uint8_t out = 0;
+        if (i <= ARGUS_SIM_REGISTER_SIZE)
+        {
+            out = reg[i - 1U];
+            reg[i - 1U] = txData[i];
+        }
+        if (rxData) rxData[i] = out;
+    }
+
+    if (address == ARGUS_SIM_REG_TRIGGER && frameSize >= 3U && (reg[0] & 0x80U))
+    {
+        StartMeasurement(dev, GetRegister16(dev, ARGUS_SIM_REG_TRIGGER));
+    }
+}
+
+void ArgusSim_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
+{
+    assert(isInitialized);
+    if (!IsValidSlave(slave) || pin > S2PI_MOSI) return;
+
+    argus_sim_dev_t * dev = &myDevices[slave];
+    const uint32_t previous = dev->Pins[pin];
+    dev->Pins[pin] = value;
+    if (!dev->isConnected || previous == value) return;
+
+    if (pin == S2PI_CS)
+    {
+        /* A new command starts with each CS low phase. */
+        dev->Clocks = 0;
+        dev->Shift = 0;
+        dev->Command = 0;
+        dev->Miso = value ? 1U : 0U;
+        return;
+    }
+
+    if (pin != S2PI_CLK || dev->Pins[S2PI_CS]) return;
+
+    const bool isEnabled = dev->Registers[ARGUS_SIM_REG_EEPROM][1] & ARGUS_SIM_EEPROM_ENABLE;
+
+    if (value == 0)
+    {
+        /* Falling edge: the device changes the MISO line. */
+        if (dev->Clocks < 8U) dev->Miso = 0;
+        else if (!isEnabled) dev->Miso = 1U;
+        else if (dev->Command == ARGUS_SIM_EEPROM_CMD_ADDRESS)
+            dev->Miso = dev->Shift & 1U; // echo of the previous bit
+        else if (dev->Command == ARGUS_SIM_EEPROM_CMD_DATA && dev->Clocks < 16U)
+            dev->Miso = (dev->EEPROM[dev->Address] >> (15U - dev->Clocks)) & 1U;
+        else dev->Miso = 0;
+        return;
+    }
+
+    /* Rising edge: the device samples the MOSI line. */
+    dev->Shift = (dev->Shift << 1U) | (dev->Pins[S2PI_MOSI] & 1U);
+    dev->Clocks++;
+
+    if (dev->Clocks == 8U)
+    {
+        dev->Command = (uint8_t)dev->Shift;
+    }
+    else if (dev->Clocks == 15U && dev->Command == ARGUS_SIM_EEPROM_CMD_ADDRESS
+             && ((dev->Shift >> 4U) & 0x07U) == ARGUS_SIM_EEPROM_READ)
+    {
+        dev->Address = dev->Shift & 0x0FU;
+    }
+}
+
+uint32_t ArgusSim_ReadMisoPin(s2pi_slave_t slave)
+{
+    if (!IsValidSlave(slave) || !myDevices[slave].isConnected) return 1U;
+    return myDevices[slave].Miso;
+}
+
+uint32_t ArgusSim_ReadIrqPin(s2pi_slave_t slave)
+{
+    if (!IsValidSlave(slave) || !myDevices[slave].isConnected) return 1U;
+    return myDevices[slave].IrqPin;
+}
+
+uint32_t ArgusSim_GetSpiLatency(void)
+{
+    return myTiming.SpiLatency + Random(myTiming.SpiJitter);
+}
+
+void ArgusSim_SetTiming(argus_sim_timing_t const * timing)
+{
+    assert(timing != 0);
+    pthread_mutex_lock(&myMutex);
+    myTiming = *timing;
+    pthread_mutex_unlock(&myMutex);
+}
+
+void ArgusSim_GetTiming(argus_sim_timing_t * timing)
+{
+    assert(timing != 0);
+    pthread_mutex_lock(&myMutex);
+    *timing = myTiming;
+    pthread_mutex_unlock(&myMutex);
+}
+
+status_t ArgusSim_Connect(s2pi_slave_t slave, argus_sim_device_t const * device)
+{
+    if (!IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    argus_sim_dev_t * dev = &myDevices[slave];
+
+    IRQ_LOCK();
+    pthread_mutex_lock(&myMutex);
+    memset(dev, 0, sizeof(*dev));
+    if (device != 0)
+    {
+        dev->Config = *device;
+    }
+    else
+    {
+        /* Distinct calibration data per slave. */
+        dev->Config.Module = AFBR_S50MV85G_V3;
+        dev->Config.ChipID = 0x1A5F0U + (uint32_t)slave;
+        dev->Config.RcoTrim = (int8_t)((slave * 5) % 9 - 4);
+    }
+    ProgramEEPROM(dev);
+    dev->IrqPin = 1U;
+    dev->Miso = 1U;
+    for (uint32_t i = 0; i <= S2PI_IRQ; ++i) dev->Pins[i] = 1U;
+    dev->isConnected = true;
+    pthread_mutex_unlock(&myMutex);
+    IRQ_UNLOCK();
+
+    return STATUS_OK;
+}
+
+void ArgusSim_Disconnect(s2pi_slave_t slave)
+{
+    if (!IsValidSlave(slave)) return;
+
+    IRQ_LOCK();
+    pthread_mutex_lock(&myMutex);
+    myDevices[slave].isConnected = false;
+    myDevices[slave].AssertTime = 0;
+    myDevices[slave].NotifyTime = 0;
+    pthread_mutex_unlock(&myMutex);
+    IRQ_UNLOCK();
+}
+
+bool ArgusSim_IsConnected(s2pi_slave_t slave)
+{
+    return IsValidSlave(slave) && myDevices[slave].isConnected;
+}
+
+static void * ArgusSim_Thread(void * param)
+{
+    (void)param;
+
+    pthread_mutex_lock(&myMutex);
+    for (;;)
+    {
+        const uint64_t now = Host_GetNanoSeconds();
+        uint64_t next = UINT64_MAX;
+        uint32_t notify = 0;
+
+        for (s2pi_slave_t slave = 1; slave <= S2PI_SLAVE_COUNT; ++slave)
+        {
+            argus_sim_dev_t * dev = &myDevices[slave];
+
+            /* The IRQ line is asserted without the interrupt lock, i.e. it
+             * can be read while the IRQ handler is still deferred. */
+            if (dev->AssertTime != 0 && dev->AssertTime <= now)
+            {
+                dev->AssertTime = 0;
+                dev->IrqPin = 0;
+                dev->NotifyTime = now + (uint64_t)myTiming.IrqLatency * 1000U;
+            }
+
+            if (dev->NotifyTime != 0 && dev->NotifyTime <= now)
+            {
+                dev->NotifyTime = 0;
+                notify |= 1U << slave;
+            }
+
+            if (dev->AssertTime != 0 && dev->AssertTime < next) next = dev->AssertTime;
+            if (dev->NotifyTime != 0 && dev->NotifyTime < next) next = dev->NotifyTime;
+        }
+
+        if (notify)
+        {
+            pthread_mutex_unlock(&myMutex);
+            for (s2pi_slave_t slave = 1; slave <= S2PI_SLAVE_COUNT; ++slave)
+            {
+                if (!(notify & (1U << slave))) continue;
+                IRQ_Enter();
+                if (myIrqHandler != 0) myIrqHandler(slave);
+                IRQ_Leave();
+            }
+            pthread_mutex_lock(&myMutex);
+        }
+        else if (next == UINT64_MAX)
+        {
+            pthread_cond_wait(&myCondition, &myMutex);
+        }
+        else
+        {
+            const struct timespec ts = {
+                .tv_sec = (time_t)(next / 1000000000U),
+                .tv_nsec = (long)(next % 1000000000U)
+            };
+            pthread_cond_timedwait(&myCondition, &myMutex, &ts);
+        }
+    }
+
+    return 0;
+}
+
+status_t ArgusSim_Init(argus_sim_irq_handler_t handler)
+{
+    assert(!isInitialized);
+
+    myIrqHandler = handler;
+    myTiming.SpiLatency = GetEnv("AFBR_SIM_SPI_LATENCY");
+    myTiming.SpiJitter = GetEnv("AFBR_SIM_SPI_JITTER");
+    myTiming.IrqDelay = GetEnv("AFBR_SIM_IRQ_DELAY");
+    myTiming.IrqJitter = GetEnv("AFBR_SIM_IRQ_JITTER");
+    myTiming.IrqLatency = GetEnv("AFBR_SIM_IRQ_LATENCY");
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&myCondition, &attr);
+    pthread_condattr_destroy(&attr);
+
+    isInitialized = true;
+
+    /* Connect the devices. */
+    char const * devices = getenv("AFBR_DEVICES");
+    if (devices == 0)
+    {
+        ArgusSim_Connect(SPI_DEFAULT_SLAVE, 0);
+    }
+    else
+    {
+        while (*devices != '\0')
+        {
+            char * end;
+            const unsigned long slave = strtoul(devices, &end, 10);
+            if (end == devices) break;
+            if (IsValidSlave((s2pi_slave_t)slave)) ArgusSim_Connect((s2pi_slave_t)slave, 0);
+            devices = (*end == ',') ? end + 1 : end;
+        }
+    }
+
+    if (pthread_create(&myThread, 0, ArgusSim_Thread, 0) != 0) return ERROR_FAIL;
+    return STATUS_OK;
+}
@@ -0,0 +1,251 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a register level simulator of the AFBR-S50 devices.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef ARGUS_SIM_H
+#define ARGUS_SIM_H
+
+/*!***************************************************************************
+ * @defgroup    argus_sim Device Simulator
+ * @ingroup     platform
+ * @brief       AFBR-S50 Device Simulator (Linux Host)
+ * @details     A behavioural model of the SPI register interface of the
+ *              AFBR-S50 devices behind the S2PI slaves of the host port.
+ *              It models the parts of the device that the HAL verification
+ *              test (#Argus_VerifyHALImplementation) relies on, such that the
+ *              test runs unmodified against the host HAL:
+ *              - Registers: the first byte of a frame is the register
+ *                address. The device shifts out the previous contents of
+ *                the register while the new data is shifted in, i.e. a
+ *                write reads back the data of the previous write (e.g. the
+ *                16 byte echo register 0x04 of the device discovery). Up to
+ *                #ARGUS_SIM_REGISTER_SIZE bytes are stored per register;
+ *                the remaining bytes read as zero.
+ *              - DMA mode (bit 1 of register 0x10): the pattern register
+ *                0x1E becomes a pipeline of 4 byte words (address + 3 data
+ *                bytes) that reads back the previous word, also across
+ *                frames; used by the maximum frame length test.
+ *              - RCO trim (bits 11:6 of register 0x14, offset by 34): the
+ *                oscillator runs at 24 MHz if the configured trim equals
+ *                the calibrated trim of the EEPROM; each step of deviation
+ *                changes the frequency by #ARGUS_SIM_RCO_STEP percent.
+ *              - Measurement trigger (bit 15 of register 0x1C; bits 14:5
+ *                are the number of samples - 1): the IRQ line is asserted
+ *                (low) after 102.4 us per sample at 24 MHz plus the IRQ
+ *                delay of the timing. The raw data register 0x32 is updated
+ *                and any following SPI frame releases the IRQ line.
+ *              - EEPROM readout in GPIO mode, enabled by bit 6 of register
+ *                0x12 (i.e. 0x004B instead of 0x002B): each CS low phase
+ *                starts with an 8 bit command (SPI mode 3, MSB first):
+ *                - 0x2C followed by the 7 bit read command "110" plus the
+ *                  4 bit address; the MOSI bits are echoed one bit later
+ *                  at the MISO line.
+ *                - 0x2F followed by 8 clocks that shift out the addressed
+ *                  EEPROM byte at the MISO line.
+ *                .
+ *                The 16 EEPROM bytes hold a (127,120) Hamming code of the
+ *                calibration data (see #ArgusSim_Connect); the MISO line
+ *                stays high if the EEPROM is not enabled.
+ *              .
+ *              The IRQ lines are served by a simulator thread that invokes
+ *              the IRQ handler of the S2PI driver in the interrupt context
+ *              (see #IRQ_Enter). The additional S2PI transfer latency and
+ *              the IRQ timing (#argus_sim_timing_t) are configurable in
+ *              order to stress test the timing sensitive parts of the HAL,
+ *              e.g. by the environment variables (all default to 0):
+ *              - AFBR_SIM_SPI_LATENCY, AFBR_SIM_SPI_JITTER: The additional
+ *                latency of each S2PI frame and its random jitter in ns.
+ *              - AFBR_SIM_IRQ_DELAY, AFBR_SIM_IRQ_JITTER: The additional
+ *                delay of the measurement IRQ and its random jitter in us.
+ *              - AFBR_SIM_IRQ_LATENCY: The latency from the assertion of
+ *                the IRQ line to the invocation of the IRQ handler in us,
+ *                i.e. a deferred GPIO interrupt.
+ *              .
+ *              The register semantics are limited to the sequences of the
+ *              HAL test and the discovery; they are not those of the actual
+ *              device, e.g. the EEPROM layout of the calibration data is a
+ *              simulator specific one.
+ *
+ * @addtogroup  argus_sim
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_s2pi.h"
+#include "board/board_config.h"
+
+/*! The number of bytes stored per register. */
+#define ARGUS_SIM_REGISTER_SIZE 16U
+
+/*! The frequency change of the RCO per trim step in percent. */
+#define ARGUS_SIM_RCO_STEP 1.0f
+
+/*! The measurement time per sample at 24 MHz in nanoseconds. */
+#define ARGUS_SIM_SAMPLE_TIME_NS 102400U
+
+/*! The number of EEPROM bytes. */
+#define ARGUS_SIM_EEPROM_SIZE 16U
+
+/*! The calibration data of a simulated device; stored in its EEPROM. */
+typedef struct argus_sim_device_t
+{
+    /*! The module number; 5 bits, see #argus_module_version_t. */
+    uint8_t Module;
+
+    /*! The chip identification number; 20 bits. */
+    uint32_t ChipID;
+
+    /*! The calibrated RCO trim value; -16 .. 15. */
+    int8_t RcoTrim;
+
+} argus_sim_device_t;
+
+/*! The timing of the simulated devices. */
+typedef struct argus_sim_timing_t
+{
+    /*! The additional latency of each S2PI frame in nanoseconds. */
+    uint32_t SpiLatency;
+
+    /*! The maximum random jitter added to the S2PI latency in nanoseconds. */
+    uint32_t SpiJitter;
+
+    /*! The additional delay from the end of the measurement to the
+     *  assertion of the IRQ line in microseconds. */
+    uint32_t IrqDelay;
+
+    /*! The maximum random jitter added to the IRQ delay in microseconds. */
+    uint32_t IrqJitter;
+
+    /*! The latency from the assertion of the IRQ line to the invocation of
+     *  the IRQ handler in microseconds. */
+    uint32_t IrqLatency;
+
+} argus_sim_timing_t;
+
+/*!***************************************************************************
+ * @brief   The IRQ handler that is invoked on the falling edge of the IRQ
+ *          line of a slave; in the interrupt context.
+ * @param   slave The S2PI slave.
+ *****************************************************************************/
+typedef void (*argus_sim_irq_handler_t)(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Initializes the simulator and starts the simulator thread.
+ * @details Connects the devices of the AFBR_DEVICES environment variable
+ *          (comma separated slaves, e.g. "1,2,5"; default: the
+ *          #SPI_DEFAULT_SLAVE) and reads the timing from the AFBR_SIM_*
+ *          environment variables.
+ * @param   handler The IRQ handler of the S2PI driver.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t ArgusSim_Init(argus_sim_irq_handler_t handler);
+
+/*!***************************************************************************
+ * @brief   Connects a device to a slave; resets a connected device.
+ * @param   slave The S2PI slave.
+ * @param   device The calibration data; 0 for the defaults of the slave.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t ArgusSim_Connect(s2pi_slave_t slave, argus_sim_device_t const * device);
+
+/*!***************************************************************************
+ * @brief   Disconnects the device of a slave; its MISO line is pulled up.
+ * @param   slave The S2PI slave.
+ *****************************************************************************/
+void ArgusSim_Disconnect(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Determines whether a device is connected to a slave.
+ * @param   slave The S2PI slave.
+ * @return  Returns true if a device is connected.
+ *****************************************************************************/
+bool ArgusSim_IsConnected(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Sets the timing of the simulated devices.
+ * @param   timing The timing.
+ *****************************************************************************/
+void ArgusSim_SetTiming(argus_sim_timing_t const * timing);
+
+/*!***************************************************************************
+ * @brief   Gets the timing of the simulated devices.
+ * @param   timing The timing to be filled.
+ *****************************************************************************/
+void ArgusSim_GetTiming(argus_sim_timing_t * timing);
+
+/*!***************************************************************************
+ * @brief   Gets the additional latency of the next S2PI frame.
+ * @return  Returns the latency incl. the random jitter in nanoseconds.
+ *****************************************************************************/
+uint32_t ArgusSim_GetSpiLatency(void);
+
+/*!***************************************************************************
+ * @brief   Exchanges the data of a S2PI frame with a device.
+ * @details Called by the S2PI driver at the end of the frame in the
+ *          interrupt context.
+ * @param   slave The S2PI slave.
+ * @param   txData The transmitted data; the first byte is the register address.
+ * @param   rxData The received data; may be the transmit buffer or 0.
+ * @param   frameSize The size of the frame.
+ *****************************************************************************/
+void ArgusSim_Transfer(s2pi_slave_t slave, uint8_t const * txData,
+                       uint8_t * rxData, size_t frameSize);
+
+/*!***************************************************************************
+ * @brief   Drives a pin of a device in GPIO mode.
+ * @param   slave The S2PI slave.
+ * @param   pin The pin driven by the MCU, i.e. #S2PI_CLK, #S2PI_CS or #S2PI_MOSI.
+ * @param   value The pin level.
+ *****************************************************************************/
+void ArgusSim_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value);
+
+/*!***************************************************************************
+ * @brief   Reads the MISO pin of a device in GPIO mode.
+ * @param   slave The S2PI slave.
+ * @return  Returns the pin level; 1 if no device is connected.
+ *****************************************************************************/
+uint32_t ArgusSim_ReadMisoPin(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Reads the IRQ pin of a device.
+ * @param   slave The S2PI slave.
+ * @return  Returns the pin level, i.e. 0 if the IRQ is asserted; 1 if no
+ *          device is connected.
+ *****************************************************************************/
+uint32_t ArgusSim_ReadIrqPin(s2pi_slave_t slave);
+
+/*! @} */
+#endif /* ARGUS_SIM_H */
@@ -0,0 +1,296 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Verifies the batched EMA kernels against the scalar fp_ema.h functions
+ *              and measures their execution time per frame on the Linux host.
+ *
+ *              Build and run from the repository root; add -DFP_EMA_SIMD32=1
+ *              to verify the SIMD code path by its C emulation:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/fp_ema_test.c \
+ *                  Sources/Utility/{fp_ema_array,hr_clock,timer_mux}.c \
+ *                  Sources/Platform/Linux/argus/argus_inline.c \
+ *                  Sources/Platform/Linux/driver/{irq,timer}.c \
+ *                  -lpthread -o fp_ema_test
+ *              ./fp_ema_test [random pairs per weight]
+ *              @endcode
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "fp_ema_array.h"
+
+#include "api/argus_def.h"
+#include "driver/timer.h"
+#include "utility/fp_ema.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The maximum array length of the length/alignment test. */
+#define TEST_MAX_COUNT 67U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The number of failed comparisons. */
+static uint32_t myErrors = 0;
+
+/*! The state of the random number generator. */
+static uint32_t mySeed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t Random(void)
+{
+    /* xorshift32 */
+    mySeed ^= mySeed << 13;
+    mySeed ^= mySeed >> 17;
+    mySeed ^= mySeed << 5;
+    return mySeed;
+}
+
+static void Fail(char const * kernel, int64_t mean, int64_t x, uint32_t weight,
+                 int64_t expected, int64_t actual)
+{
+    if (myErrors++ < 10U)
+    {
+        printf("  %s: mean=%lld x=%lld weight=%u: expected %lld, got %lld\n",
+               kernel, (long long)mean, (long long)x, weight,
+               (long long)expected, (long long)actual);
+    }
+}
+
+/* Checks a batch of pairs with all three kernels; the 16-bit values are
+ * taken from the lower bits of the 32-bit values. */
+static void Check(int32_t const * mean, int32_t const * x, uint32_t count, uq0_8_t weight)
+{
+    q11_4_t m4[TEST_MAX_COUNT], x4[TEST_MAX_COUNT] = { 0 };
+    uint16_t m16[TEST_MAX_COUNT], x16[TEST_MAX_COUNT];
+    int32_t m32[TEST_MAX_COUNT];
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        m4[i] = (q11_4_t)mean[i];
+        x4[i] = (q11_4_t)x[i];
+        m16[i] = (uint16_t)mean[i];
+        x16[i] = (uint16_t)x[i];
+        m32[i] = mean[i];
+    }
+
+    fp_ema4_array(m4, x4, count, weight);
+    uint_ema16_array(m16, x16, count, weight);
+    int_ema32_array(m32, x, count, weight);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const q11_4_t e4 = fp_ema4((q11_4_t)mean[i], (q11_4_t)x[i], weight);
+        if (m4[i] != e4) Fail("fp_ema4", (q11_4_t)mean[i], (q11_4_t)x[i], weight, e4, m4[i]);
+
+        const uint16_t e16 = (uint16_t)uint_ema32((uint16_t)mean[i], (uint16_t)x[i], weight);
+        if (m16[i] != e16) Fail("uint_ema32", (uint16_t)mean[i], (uint16_t)x[i], weight, e16, m16[i]);
+
+        const int32_t e32 = int_ema32(mean[i], x[i], weight);
+        if (m32[i] != e32) Fail("int_ema32", mean[i], x[i], weight, e32, m32[i]);
+    }
+}
+
+/* All combinations of the edge values for all weights. */
+static void TestEdges(void)
+{
+    int32_t edges[64];
+    uint32_t n = 0;
+
+    static const int32_t fixed[] = {
+        0, 1, -1, 2, -2, 127, -127, 128, -128, 129, -129, 255, 256, 257,
+        INT16_MAX, INT16_MIN, INT16_MAX - 1, INT16_MIN + 1, UINT16_MAX,
+        UINT16_MAX - 1, 0x8000, 0x7FFF0000, INT32_MAX, INT32_MIN,
+        INT32_MAX - 1, INT32_MIN + 1, 0x00100000, -0x00100000
+    };
+    for (uint32_t i = 0; i < sizeof(fixed) / sizeof(fixed[0]); ++i) edges[n++] = fixed[i];
+    for (uint32_t b = 2; b < 31 && n < 64; b += 2) edges[n++] = (int32_t)(1U << b) + (int32_t)b;
+
+    int32_t mean[TEST_MAX_COUNT], x[TEST_MAX_COUNT];
+    for (uint32_t w = 0; w < 256U; ++w)
+    {
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            for (uint32_t j = 0; j < n; ++j)
+            {
+                mean[j] = edges[i];
+                x[j] = edges[j];
+            }
+            Check(mean, x, n, (uq0_8_t)w);
+        }
+    }
+}
+
+/* Random pairs with full range and small differences for all weights. */
+static void TestRandom(uint32_t pairs)
+{
+    int32_t mean[TEST_MAX_COUNT - 3U], x[TEST_MAX_COUNT - 3U];
+    const uint32_t count = sizeof(mean) / sizeof(mean[0]);
+
+    for (uint32_t w = 0; w < 256U; ++w)
+    {
+        for (uint32_t k = 0; k < pairs; k += count)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                mean[i] = (int32_t)Random();
+                x[i] = (i & 1U) ? (int32_t)Random() : mean[i] + (int32_t)(Random() % 1025U) - 512;
+            }
+            Check(mean, x, count, (uq0_8_t)w);
+        }
+    }
+}
+
+/* All mean/x pairs of a 16-bit value grid (every 64th value incl. the
+ * neighbors of the grid points) for a selection of weights. */
+static void TestGrid(void)
+{
+    static const uq0_8_t weights[] = { 1, 2, 64, 127, 128, 129, 192, 254, 255 };
+    int32_t mean[TEST_MAX_COUNT - 3U], x[TEST_MAX_COUNT - 3U];
+    const uint32_t count = sizeof(mean) / sizeof(mean[0]);
+
+    for (uint32_t k = 0; k < sizeof(weights) / sizeof(weights[0]); ++k)
+    {
+        uint32_t n = 0;
+        for (int32_t m = INT16_MIN; m <= INT16_MAX; m += 63)
+        {
+            for (int32_t v = INT16_MIN; v <= INT16_MAX; v += 65)
+            {
+                mean[n] = m;
+                x[n] = v;
+                if (++n == count)
+                {
+                    Check(mean, x, n, weights[k]);
+                    n = 0;
+                }
+            }
+        }
+        Check(mean, x, n, weights[k]);
+    }
+}
+
+/* All lengths and alignments incl. the odd tails and in place filtering. */
+static void TestLayout(void)
+{
+    static q11_4_t m4[TEST_MAX_COUNT + 1U], x4[TEST_MAX_COUNT + 1U], e4[TEST_MAX_COUNT];
+    static uint16_t m16[TEST_MAX_COUNT + 1U], x16[TEST_MAX_COUNT + 1U], e16[TEST_MAX_COUNT];
+
+    for (uint32_t count = 0; count < TEST_MAX_COUNT; ++count)
+    {
+        for (uint32_t offset = 0; offset < 4U; ++offset)
+        {
+            const uint32_t om = offset & 1U;
+            const uint32_t ox = offset >> 1U;
+            const uq0_8_t weight = (uq0_8_t)Random();
+
+            for (uint32_t i = 0; i <= TEST_MAX_COUNT; ++i)
+            {
+                m4[i] = (q11_4_t)Random();
+                x4[i] = (q11_4_t)Random();
+                m16[i] = (uint16_t)Random();
+                x16[i] = (uint16_t)Random();
+            }
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                e4[i] = fp_ema4(m4[om + i], x4[ox + i], weight);
+                e16[i] = (uint16_t)uint_ema32(m16[om + i], x16[ox + i], weight);
+            }
+
+            const q11_4_t guard4 = m4[om + count];
+            const uint16_t guard16 = m16[om + count];
+            fp_ema4_array(&m4[om], &x4[ox], count, weight);
+            uint_ema16_array(&m16[om], &x16[ox], count, weight);
+
+            if (memcmp(&m4[om], e4, count * sizeof(e4[0])) != 0 || m4[om + count] != guard4)
+                Fail("fp_ema4_array layout", count, offset, weight, 0, 1);
+            if (memcmp(&m16[om], e16, count * sizeof(e16[0])) != 0 || m16[om + count] != guard16)
+                Fail("uint_ema16_array layout", count, offset, weight, 0, 1);
+
+            /* In place: mean == x must keep the values. */
+            memcpy(e4, &x4[ox], count * sizeof(e4[0]));
+            fp_ema4_array(&x4[ox], &x4[ox], count, weight);
+            if (memcmp(&x4[ox], e4, count * sizeof(e4[0])) != 0)
+                Fail("fp_ema4_array in place", count, offset, weight, 0, 1);
+        }
+    }
+}
+
+static void Report(char const * name, uint32_t scalar, uint32_t array)
+{
+    printf("  %-10s scalar: %6u ticks/frame   array: %6u ticks/frame   %.1fx\n",
+           name, scalar, array, array ? (double)scalar / array : 0.0);
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t pairs = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 100000U;
+
+    Timer_Init();
+
+    printf("fp_ema_array: %s kernels\n", FP_EMA_SIMD32 ? "SIMD32" : "portable C");
+
+    TestEdges();
+    TestGrid();
+    TestRandom(pairs);
+    TestLayout();
+    printf("equivalence: %s (%u mismatches)\n", myErrors ? "FAILED" : "passed", myErrors);
+
+    fp_ema_bench_t bench;
+    const status_t status = fp_ema_array_benchmark(&bench, 1000U);
+    printf("benchmark: %u pixels per frame, %u Hz ticks%s\n", ARGUS_PIXELS,
+           bench.Frequency, status == STATUS_OK ? "" : ", MISMATCH");
+    Report("fp_ema4", bench.Ema4Scalar, bench.Ema4Array);
+    Report("uint_ema16", bench.Ema16Scalar, bench.Ema16Array);
+    Report("int_ema32", bench.Ema32Scalar, bench.Ema32Array);
+
+    return (myErrors || status != STATUS_OK) ? 1 : 0;
+}
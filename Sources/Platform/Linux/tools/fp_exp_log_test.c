@@ -0,0 +1,197 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Verifies the fast exponential and logarithm functions against exp and log
+ *              in double precision for every input value and measures their
+ *              execution time on the Linux host.
+ *
+ *              Build and run from the repository root; add
+ *              -DFP_EXP_LOG_MUL64=0 to verify the Cortex-M0+ variant. Both
+ *              builds must print the same checksums:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/fp_exp_log_test.c \
+ *                  Sources/Utility/{fp_exp_log,hr_clock,timer_mux}.c \
+ *                  Sources/Platform/Linux/argus/argus_inline.c \
+ *                  Sources/Platform/Linux/driver/{irq,timer}.c \
+ *                  -lm -lpthread -o fp_exp_log_test
+ *              ./fp_exp_log_test [stride]
+ *              @endcode
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "fp_exp_log.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The statistics of a function over all tested inputs. */
+typedef struct test_stats_t
+{
+    /*! The maximum absolute error in ULP (2^-16). */
+    double MaxError;
+
+    /*! The input of the maximum error. */
+    int64_t MaxInput;
+
+    /*! The number of results that are not correctly rounded. */
+    uint64_t Misrounded;
+
+    /*! The number of tested inputs. */
+    uint64_t Count;
+
+    /*! The FNV-1a hash of all results. */
+    uint64_t Hash;
+
+} test_stats_t;
+
+/*! The number of calls of the timing loops. */
+#define TEST_TIMING_CALLS 10000000U
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void Update(test_stats_t * stats, int64_t input, int64_t result, double reference)
+{
+    const double error = fabs((double)result - reference);
+    if (error > stats->MaxError)
+    {
+        stats->MaxError = error;
+        stats->MaxInput = input;
+    }
+    if ((double)result != floor(reference + 0.5)) stats->Misrounded++;
+    stats->Count++;
+
+    for (uint32_t i = 0; i < 4U; ++i)
+    {
+        stats->Hash ^= (uint8_t)((uint64_t)result >> (8U * i));
+        stats->Hash *= 0x100000001B3ULL;
+    }
+}
+
+static void Print(char const * name, test_stats_t const * stats)
+{
+    printf("  %-13s max error %.4f ULP at x = %lld (0x%08llX), %llu of %llu misrounded, hash %016llX\n",
+           name, stats->MaxError, (long long)stats->MaxInput,
+           (unsigned long long)(uint32_t)stats->MaxInput,
+           (unsigned long long)stats->Misrounded, (unsigned long long)stats->Count,
+           (unsigned long long)stats->Hash);
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t stride = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 1U;
+    if (stride == 0)
+    {
+        fprintf(stderr, "usage: fp_exp_log_test [stride]\n");
+        return 1;
+    }
+
+    printf("fp_exp_log: %s multiplications, every %u. input\n",
+           FP_EXP_LOG_MUL64 ? "64-bit" : "16x16-bit", stride);
+
+    /* exp: Q15.16 -> UQ16.16, clamped to the output range. */
+    test_stats_t expStats = { .Hash = 0xCBF29CE484222325ULL };
+    for (int64_t x = INT32_MIN; x <= INT32_MAX; x += stride)
+    {
+        const uint32_t y = fp_exp16_fast((q15_16_t)x);
+        double ref = 0.0;
+        if (x > 800000) ref = UINT32_MAX;
+        else if (x > -800000) ref = fmin(exp((double)x / 65536.0) * 65536.0, UINT32_MAX);
+        Update(&expStats, x, y, ref);
+    }
+    Print("fp_exp16_fast", &expStats);
+
+    /* ln: UQ16.16 -> Q15.16; ln(0) is not defined. */
+    test_stats_t logStats = { .Hash = 0xCBF29CE484222325ULL };
+    for (uint64_t x = 1; x <= UINT32_MAX; x += stride)
+    {
+        const int32_t y = fp_log16_fast((uq16_16_t)x);
+        Update(&logStats, (int64_t)x, y, log((double)x / 65536.0) * 65536.0);
+    }
+    Print("fp_log16_fast", &logStats);
+
+    const bool isFailed = fp_log16_fast(0) != Q15_16_MIN
+                          || expStats.MaxError > 2.2 || logStats.MaxError > 0.51;
+
+    /* Timing with arguments that avoid the saturation shortcuts. */
+    volatile uint32_t sink = 0;
+    double t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i)
+        sink += fp_exp16_fast((q15_16_t)(i * 2654435761U) >> 12);
+    const double tExp = Now() - t;
+
+    t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i)
+        sink += (uint32_t)fp_log16_fast((i * 2654435761U) | 1U);
+    const double tLog = Now() - t;
+
+    t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i)
+        sink += (uint32_t)(exp((double)((q15_16_t)(i * 2654435761U) >> 12) / 65536.0) * 65536.0);
+    const double tExpF = Now() - t;
+
+    t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i)
+        sink += (uint32_t)(int32_t)(log((double)((i * 2654435761U) | 1U) / 65536.0) * 65536.0);
+    const double tLogF = Now() - t;
+
+    printf("timing: fp_exp16_fast %.2f ns (double exp %.2f ns), fp_log16_fast %.2f ns (double log %.2f ns)\n",
+           tExp / TEST_TIMING_CALLS * 1e9, tExpF / TEST_TIMING_CALLS * 1e9,
+           tLog / TEST_TIMING_CALLS * 1e9, tLogF / TEST_TIMING_CALLS * 1e9);
+
+    printf("%s\n", isFailed ? "FAILED" : "passed");
+    return isFailed ? 1 : 0;
+}
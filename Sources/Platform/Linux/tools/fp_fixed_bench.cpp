@@ -0,0 +1,356 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Benchmark and verification of the C++ fixed point types of
+ *              fp_fixed.hpp against the C helper functions.
+ *
+ *              Each operation is implemented twice by a non-inlined kernel
+ *              that processes #BENCH_SIZE elements: with the C helpers and
+ *              raw integers (e.g. fp_muls(a, b, 22) on q9_22_t) and with the
+ *              corresponding argus::fixed types (e.g. a * b on argus::q9_22).
+ *              Both kernels must yield identical results; the costs per
+ *              element and their ratio are printed for information. The
+ *              kernels are named *_C and *_Fixed to compare the generated
+ *              code, e.g. by "objdump -d --no-show-raw-insn fp_fixed_bench".
+ *
+ *              In addition, the constexpr mirrors of the helpers, which are
+ *              evaluated by the compiler in constant expressions, are
+ *              verified against the C helpers for random inputs; static
+ *              assertions check a few constant expressions.
+ *
+ *              Build and run on the host from the repository root, once per
+ *              configuration of the helpers (USE_64BIT_MUL, USE_HW_DIV):
+ *              @code
+ *              g++ -std=c++14 -O2 -fno-tree-vectorize -DNDEBUG \
+ *                  -DUSE_64BIT_MUL=1 -DUSE_HW_DIV=1 -IAFBR-S50/Include \
+ *                  Sources/Platform/Linux/tools/fp_fixed_bench.cpp \
+ *                  -o fp_fixed_bench
+ *              ./fp_fixed_bench
+ *              @endcode
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#ifndef NDEBUG
+#define NDEBUG // the random inputs violate the assertions of the helpers on purpose
+#endif
+
+#include "utility/fp_fixed.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of elements of the input arrays. */
+#define BENCH_SIZE 1024U
+
+/*! The repetitions of the input arrays per timing measurement. */
+#define BENCH_ROUNDS 200U
+
+/*! The number of timing measurements; the minimum is reported. */
+#define BENCH_REPEAT 5U
+
+/*! The number of random inputs per verification of the constexpr mirrors. */
+#define BENCH_CHECKS 1000000U
+
+/*! Prevents the inlining of the kernels to keep them comparable in the
+ *  disassembly. */
+#define BENCH_KERNEL extern "C" __attribute__((noinline))
+
+using namespace argus;
+
+/*******************************************************************************
+ * Compile Time Checks
+ ******************************************************************************/
+
+/* The products, quotients and conversions are evaluated by the compiler. */
+static_assert(fixed_mul<q9_22>(uq1_15::from_double(0.5), q9_22::from_int(-3))
+              == q9_22::from_double(-1.5), "");
+static_assert((q15_16::from_int(3) * q15_16::from_double(-0.25)).raw() == -0xC000, "");
+static_assert((uq16_16::from_int(3) * uq16_16::from_double(0.5)).raw() == 0x18000U, "");
+static_assert((q9_22::from_int(3) / q15_16::from_int(-2)) == q9_22::from_double(-1.5), "");
+static_assert(fixed_div<q15_16>(q9_22::from_int(1), q9_22::from_int(3)).raw() == 0x5555, "");
+static_assert((q15_16::from_int(1) / q15_16()) == q15_16::max(), "");
+static_assert(fixed_cast<uq12_4>(uq1_15::from_double(0.75)).raw() == 12U, "");
+static_assert(fixed_cast<q15_16>(q9_22::from_raw(-0x60)).raw() == -2, "");
+static_assert(fixed_cast<q9_22>(q15_16::from_int(-1)) == q9_22::from_int(-1), "");
+static_assert(q0_15::from_double(1.0) == q0_15::max() && uq0_8::from_double(-1.0) == uq0_8(), "");
+
+/* The type is a zero cost wrapper of the raw value. */
+static_assert(sizeof(q15_16[BENCH_SIZE]) == sizeof(q15_16_t[BENCH_SIZE]), "");
+static_assert(alignof(uq1_15) == alignof(uq1_15_t), "");
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static q9_22_t   myQ9_22[2][BENCH_SIZE];
+static q15_16_t  myQ15_16[BENCH_SIZE];
+static uq16_16_t myUQ16_16[2][BENCH_SIZE];
+static uq1_15_t  myUQ1_15[BENCH_SIZE];
+static int32_t   myOut[2][BENCH_SIZE];
+
+static q9_22   myFixedQ9_22[2][BENCH_SIZE];
+static q15_16  myFixedQ15_16[BENCH_SIZE];
+static uq16_16 myFixedUQ16_16[2][BENCH_SIZE];
+static uq1_15  myFixedUQ1_15[BENCH_SIZE];
+
+/*******************************************************************************
+ * Kernels
+ ******************************************************************************/
+
+BENCH_KERNEL void Mul_Q9_22_C(q9_22_t * y, q9_22_t const * a, q9_22_t const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fp_muls(a[i], b[i], 22);
+}
+BENCH_KERNEL void Mul_Q9_22_Fixed(q9_22 * y, q9_22 const * a, q9_22 const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = a[i] * b[i];
+}
+
+BENCH_KERNEL void Mul_UQ16_16_C(uq16_16_t * y, uq16_16_t const * a, uq16_16_t const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fp_mulu(a[i], b[i], 16);
+}
+BENCH_KERNEL void Mul_UQ16_16_Fixed(uq16_16 * y, uq16_16 const * a, uq16_16 const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = a[i] * b[i];
+}
+
+BENCH_KERNEL void Gain_C(q9_22_t * y, uq1_15_t const * g, q9_22_t const * x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fp_muls(x[i], (int32_t)g[i], 15);
+}
+BENCH_KERNEL void Gain_Fixed(q9_22 * y, uq1_15 const * g, q9_22 const * x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fixed_mul<q9_22>(x[i], g[i]);
+}
+
+BENCH_KERNEL void Div_C(q9_22_t * y, q9_22_t const * a, q15_16_t const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fp_div16(a[i], b[i]);
+}
+BENCH_KERNEL void Div_Fixed(q9_22 * y, q9_22 const * a, q15_16 const * b, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = a[i] / b[i];
+}
+
+BENCH_KERNEL void Cast_C(q15_16_t * y, q9_22_t const * x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fp_rnds(x[i], 6);
+}
+BENCH_KERNEL void Cast_Fixed(q15_16 * y, q9_22 const * x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i) y[i] = fixed_cast<q15_16>(x[i]);
+}
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+#if defined(__x86_64__) || defined(__i386__)
+static char const * Unit(void) { return "TSC cycles"; }
+static uint64_t Ticks(void) { return __rdtsc(); }
+#else
+static char const * Unit(void) { return "nanoseconds"; }
+static uint64_t Ticks(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/*! A 32-bit integer hash (lowbias32). */
+static uint32_t Hash(uint32_t x)
+{
+    x ^= x >> 16U;
+    x *= 0x7FEB352DU;
+    x ^= x >> 15U;
+    x *= 0x846CA68BU;
+    x ^= x >> 16U;
+    return x;
+}
+
+/*! A random number of log-uniformly distributed magnitude. */
+static uint32_t Random(uint32_t * seed)
+{
+    *seed += 0x9E3779B9U;
+    const uint32_t r = Hash(*seed);
+    return Hash(r) >> (r & 31U);
+}
+
+/*! A signed random number of log-uniformly distributed magnitude. */
+static int32_t RandomSigned(uint32_t * seed)
+{
+    const uint32_t r = Random(seed);
+    return (r & 1U) ? (int32_t)(0U - (r >> 1U)) : (int32_t)(r >> 1U);
+}
+
+static void Fill(void)
+{
+    uint32_t seed = 42U;
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i)
+    {
+        for (uint32_t k = 0; k < 2; ++k)
+        {
+            myQ9_22[k][i] = RandomSigned(&seed);
+            myUQ16_16[k][i] = Random(&seed);
+            myFixedQ9_22[k][i] = q9_22::from_raw(myQ9_22[k][i]);
+            myFixedUQ16_16[k][i] = uq16_16::from_raw(myUQ16_16[k][i]);
+        }
+        myQ15_16[i] = RandomSigned(&seed);
+        myUQ1_15[i] = (uq1_15_t)Random(&seed);
+        myFixedQ15_16[i] = q15_16::from_raw(myQ15_16[i]);
+        myFixedUQ1_15[i] = uq1_15::from_raw(myUQ1_15[i]);
+    }
+}
+
+/*! The minimum costs of a kernel per element. */
+template <class Kernel>
+static double Measure(Kernel kernel)
+{
+    uint64_t best = UINT64_MAX;
+    for (uint32_t r = 0; r < BENCH_REPEAT; ++r)
+    {
+        const uint64_t t0 = Ticks();
+        for (uint32_t k = 0; k < BENCH_ROUNDS; ++k) kernel();
+        const uint64_t t = Ticks() - t0;
+        if (t < best) best = t;
+    }
+    return (double)best / (BENCH_ROUNDS * BENCH_SIZE);
+}
+
+/*! Times the C and the C++ kernel and verifies the identity of the results. */
+template <class KernelC, class KernelFixed>
+static bool Compare(char const * name, KernelC kc, KernelFixed kf)
+{
+    const double c = Measure(kc);
+    const double f = Measure(kf);
+
+    bool ok = true;
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i)
+        ok = ok && myOut[0][i] == myOut[1][i];
+
+    printf("%-16s %10.2f %10.2f %8.3f %s\n", name, c, f, f / c, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/*! Verifies the constexpr mirrors against the C helpers for random inputs. */
+static bool VerifyMirrors(void)
+{
+    uint32_t seed = 7U;
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < BENCH_CHECKS; ++i)
+    {
+        const uint32_t u = Random(&seed), v = Random(&seed);
+        const int32_t a = RandomSigned(&seed), b = RandomSigned(&seed);
+        const unsigned shift = 1U + Random(&seed) % 32U;
+        const unsigned n = Random(&seed) % 34U;
+
+        if (detail::mulu(u, v, shift) != fp_mulu(u, v, (uint_fast8_t)shift)) errors++;
+        if (detail::muls(a, b, shift) != fp_muls(a, b, (uint_fast8_t)shift)) errors++;
+        if (detail::rndu(u, n) != fp_rndu(u, (uint_fast8_t)n)) errors++;
+        if (detail::rnds(a, n) != fp_rnds(a, (uint_fast8_t)n)) errors++;
+
+        /* The software division wraps a quotient of +2^31 to INT32_MIN. */
+        const int32_t q = fp_div16(a, b);
+        if (detail::div16(a, b) != q && !(q == INT32_MIN && detail::div16(a, b) == INT32_MAX))
+            errors++;
+    }
+    static const int32_t limits[] = { 0, 1, -1, INT32_MIN, INT32_MAX };
+    for (int32_t b : limits)
+    {
+        for (int32_t a : limits)
+        {
+            const int32_t q = fp_div16(a, b);
+            if (detail::div16(a, b) != q && !(q == INT32_MIN && detail::div16(a, b) == INT32_MAX))
+                errors++;
+        }
+    }
+
+    printf("constexpr mirrors: %u errors in %u inputs %s\n",
+           (unsigned)errors, (unsigned)BENCH_CHECKS, errors ? "FAILED" : "ok");
+    return errors == 0;
+}
+
+int main(void)
+{
+    printf("fixed point C++ types vs C helpers (USE_64BIT_MUL=%d, USE_HW_DIV=%d)\n",
+           (int)USE_64BIT_MUL, (int)USE_HW_DIV);
+
+    bool ok = VerifyMirrors();
+    Fill();
+
+    q9_22_t * const outQ9_22 = myOut[0];
+    q15_16_t * const outQ15_16 = myOut[0];
+    uq16_16_t * const outUQ16_16 = (uq16_16_t *)myOut[0];
+    q9_22 * const fixedQ9_22 = (q9_22 *)myOut[1];
+    q15_16 * const fixedQ15_16 = (q15_16 *)myOut[1];
+    uq16_16 * const fixedUQ16_16 = (uq16_16 *)myOut[1];
+
+    printf("%-16s %10s %10s %8s   [%s per element]\n", "operation", "C", "C++", "ratio", Unit());
+
+    ok &= Compare("q9_22 * q9_22",
+        [=] { Mul_Q9_22_C(outQ9_22, myQ9_22[0], myQ9_22[1], BENCH_SIZE); },
+        [=] { Mul_Q9_22_Fixed(fixedQ9_22, myFixedQ9_22[0], myFixedQ9_22[1], BENCH_SIZE); });
+    ok &= Compare("uq16_16 * uq16_16",
+        [=] { Mul_UQ16_16_C(outUQ16_16, myUQ16_16[0], myUQ16_16[1], BENCH_SIZE); },
+        [=] { Mul_UQ16_16_Fixed(fixedUQ16_16, myFixedUQ16_16[0], myFixedUQ16_16[1], BENCH_SIZE); });
+    ok &= Compare("uq1_15 * q9_22",
+        [=] { Gain_C(outQ9_22, myUQ1_15, myQ9_22[0], BENCH_SIZE); },
+        [=] { Gain_Fixed(fixedQ9_22, myFixedUQ1_15, myFixedQ9_22[0], BENCH_SIZE); });
+    ok &= Compare("q9_22 / q15_16",
+        [=] { Div_C(outQ9_22, myQ9_22[0], myQ15_16, BENCH_SIZE); },
+        [=] { Div_Fixed(fixedQ9_22, myFixedQ9_22[0], myFixedQ15_16, BENCH_SIZE); });
+    ok &= Compare("q9_22 -> q15_16",
+        [=] { Cast_C(outQ15_16, myQ9_22[1], BENCH_SIZE); },
+        [=] { Cast_Fixed(fixedQ15_16, myFixedQ9_22[1], BENCH_SIZE); });
+
+    printf("%s\n", ok ? "PASSED" : "FAILED");
+    return ok ? 0 : 1;
+}
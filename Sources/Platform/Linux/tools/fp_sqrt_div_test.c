@@ -0,0 +1,266 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Verifies the fast integer square root and the batched Q15.16 division
+ *              against exact references and measures their execution time
+ *              on the Linux host.
+ *
+ *              Build and run from the repository root; add
+ *              -DFP_SQRT_DIV_MUL64=0 to verify the Cortex-M0+ variant:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/fp_sqrt_div_test.c \
+ *                  Sources/Utility/{fp_sqrt_div,hr_clock,timer_mux}.c \
+ *                  Sources/Platform/Linux/argus/argus_inline.c \
+ *                  Sources/Platform/Linux/driver/{irq,timer}.c \
+ *                  -lm -lpthread -o fp_sqrt_div_test
+ *              ./fp_sqrt_div_test [sqrt stride] [random divisions]
+ *              @endcode
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#define INT_SQRT 1 // bit-by-bit isqrt as reference for the timing
+
+#include "fp_sqrt_div.h"
+#include "utility/fp_div.h"
+#include "utility/int_math.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of calls of the timing loops. */
+#define TEST_TIMING_CALLS 10000000U
+
+/*! The number of pixels of a frame, i.e. the batch size of the timing. */
+#define TEST_BATCH 32U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The number of failed comparisons. */
+static uint32_t myErrors = 0;
+
+/*! The state of the random number generator. */
+static uint32_t mySeed = 1U;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The external definition of the reference, that is disabled (INT_SQRT)
+ * in the other translation units. */
+extern inline uint32_t isqrt(uint32_t v);
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t Random(void)
+{
+    /* xorshift32 */
+    mySeed ^= mySeed << 13;
+    mySeed ^= mySeed >> 17;
+    mySeed ^= mySeed << 5;
+    return mySeed;
+}
+
+/* A random value with a random magnitude, i.e. all bit lengths are equally
+ * likely, and a random sign. */
+static int32_t RandomMagnitude(void)
+{
+    const int32_t v = (int32_t)(Random() >> (Random() & 31U));
+    return (Random() & 1U) ? v : -v;
+}
+
+static void TestSqrt(uint32_t stride)
+{
+    uint64_t count = 0;
+    for (uint64_t x = 0; x <= UINT32_MAX; x += stride)
+    {
+        const uint64_t y = isqrt_nr((uint32_t)x);
+        if (y * y > x || (y + 1U) * (y + 1U) <= x)
+        {
+            if (myErrors++ < 10U) printf("  isqrt_nr(%llu) = %llu\n",
+                                         (unsigned long long)x, (unsigned long long)y);
+        }
+        count++;
+    }
+
+    /* The neighbors of all perfect squares, where the estimate is critical. */
+    for (uint64_t k = 1; k <= 0x10000U; ++k)
+    {
+        for (uint64_t x = k * k - 1U; x <= k * k && x <= UINT32_MAX; ++x)
+        {
+            const uint64_t y = isqrt_nr((uint32_t)x);
+            if (y != (x == k * k ? k : k - 1U))
+            {
+                if (myErrors++ < 10U) printf("  isqrt_nr(%llu) = %llu\n",
+                                             (unsigned long long)x, (unsigned long long)y);
+            }
+            count++;
+        }
+    }
+    printf("isqrt_nr:     %llu inputs checked\n", (unsigned long long)count);
+}
+
+static void CheckDiv(int32_t a, int32_t b)
+{
+    fp_div16_rcp_t rcp;
+    fp_div16_init(&rcp, b);
+    const int32_t q = fp_div16_rcp(a, &rcp);
+
+    /* fp_div16 wraps a quotient of +2^31 to INT32_MIN instead of saturating. */
+    int32_t e = fp_div16(a, b);
+    if (e == INT32_MIN && b != 0 && (a ^ b) >= 0) e = INT32_MAX;
+
+    if (q != e)
+    {
+        if (myErrors++ < 10U) printf("  fp_div16_rcp(%d, %d) = %d, expected %d\n", a, b, q, e);
+    }
+}
+
+static void TestDiv(uint32_t count)
+{
+    /* All combinations of the edge values. */
+    int32_t edges[100];
+    uint32_t n = 0;
+    edges[n++] = 0;
+    edges[n++] = INT32_MIN;
+    edges[n++] = INT32_MAX;
+    for (uint32_t k = 0; k < 31U; ++k)
+    {
+        edges[n++] = (int32_t)(1U << k);
+        edges[n++] = -(int32_t)(1U << k);
+        edges[n++] = (int32_t)(1U << k) + 1;
+    }
+    for (uint32_t i = 0; i < n; ++i)
+        for (uint32_t j = 0; j < n; ++j)
+            CheckDiv(edges[i], edges[j]);
+
+    /* Random values of all magnitudes, incl. quotients next to the limits. */
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        CheckDiv(RandomMagnitude(), RandomMagnitude());
+
+        const int32_t b = RandomMagnitude();
+        const int64_t a = ((int64_t)INT32_MAX * b) >> 16;
+        if (a >= INT32_MIN && a <= INT32_MAX)
+        {
+            CheckDiv((int32_t)a, b);
+            CheckDiv((int32_t)a + 1, b);
+            CheckDiv((int32_t)a - 1, b);
+        }
+    }
+    printf("fp_div16_rcp: %u edge and %u random divisions checked\n", n * n, 4U * count);
+}
+
+static void Benchmark(void)
+{
+    static int32_t a[TEST_BATCH], q[TEST_BATCH];
+    volatile uint32_t sink = 0;
+
+    double t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i) sink += isqrt_nr(i * 2654435761U);
+    const double tNr = Now() - t;
+
+    t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i) sink += isqrt(i * 2654435761U);
+    const double tBit = Now() - t;
+
+    t = Now();
+    for (uint32_t i = 0; i < TEST_TIMING_CALLS; ++i) sink += (uint32_t)sqrt((double)(i * 2654435761U));
+    const double tSqrt = Now() - t;
+
+    printf("timing: isqrt_nr %.2f ns, isqrt (bit-by-bit) %.2f ns, double sqrt %.2f ns\n",
+           tNr / TEST_TIMING_CALLS * 1e9, tBit / TEST_TIMING_CALLS * 1e9,
+           tSqrt / TEST_TIMING_CALLS * 1e9);
+
+    for (uint32_t i = 0; i < TEST_BATCH; ++i) a[i] = RandomMagnitude() >> 4;
+    const uint32_t frames = TEST_TIMING_CALLS / TEST_BATCH;
+
+    t = Now();
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        fp_div16_array(q, a, TEST_BATCH, (q15_16_t)(0x18000 + f));
+        sink += (uint32_t)q[f % TEST_BATCH];
+    }
+    const double tArray = Now() - t;
+
+    t = Now();
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t i = 0; i < TEST_BATCH; ++i) q[i] = fp_div16(a[i], (q15_16_t)(0x18000 + f));
+        sink += (uint32_t)q[f % TEST_BATCH];
+    }
+    const double tDiv = Now() - t;
+
+    printf("timing: fp_div16_array %.2f ns, fp_div16 %.2f ns per division (%u per call)\n",
+           tArray / TEST_TIMING_CALLS * 1e9, tDiv / TEST_TIMING_CALLS * 1e9, TEST_BATCH);
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t stride = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 1U;
+    const uint32_t divisions = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 10000000U;
+    if (stride == 0)
+    {
+        fprintf(stderr, "usage: fp_sqrt_div_test [sqrt stride] [random divisions]\n");
+        return 1;
+    }
+
+    printf("fp_sqrt_div: %s multiplications\n", FP_SQRT_DIV_MUL64 ? "64-bit" : "16x16-bit");
+
+    TestSqrt(stride);
+    TestDiv(divisions);
+    printf("%s (%u mismatches)\n", myErrors ? "FAILED" : "passed", myErrors);
+
+    Benchmark();
+    return myErrors ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Runs the HAL verification test of the AFBR-S50 API against the host
+ *              HAL and the register level device simulator.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -IAFBR-S50/Test \
+ *                  -ISources/Utility -ISources/Platform/Linux \
+ *                  -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/hal_test.c \
+ *                  AFBR-S50/Test/argus_hal_test.c \
+ *                  Sources/Platform/Linux/argus/argus_{eeprom,inline}.c \
+ *                  Sources/Platform/Linux/driver/{irq,s2pi,timer}.c \
+ *                  Sources/Platform/Linux/sim/argus_sim.c \
+ *                  Sources/Utility/{hr_clock,s2pi_queue,s2pi_trace,timer_mux}.c \
+ *                  -lpthread -o hal_test
+ *              ./hal_test [slave] [runs]
+ *              AFBR_SIM_SPI_JITTER=200000 AFBR_SIM_IRQ_LATENCY=500 ./hal_test 1 100
+ *              @endcode
+ *
+ *              The test is repeated for the given number of runs (default:
+ *              1) and stops at the first failure; the exit code is the
+ *              number of failed runs. The simulator timing (see
+ *              #argus_sim_timing_t) is read from the AFBR_SIM_* environment
+ *              variables, e.g. to stress test the SPI transfers from the
+ *              interrupt callbacks with random latencies.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "argus_hal_test.h"
+
+#include "board/board_config.h"
+#include "driver/s2pi.h"
+#include "driver/timer.h"
+#include "sim/argus_sim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The print function of the HAL test writes to stdout. */
+status_t print(const char * fmt_s, ...)
+{
+    va_list ap;
+    va_start(ap, fmt_s);
+    vprintf(fmt_s, ap);
+    va_end(ap);
+    return STATUS_OK;
+}
+
+int main(int argc, char * argv[])
+{
+    const s2pi_slave_t slave = argc > 1 ? (s2pi_slave_t)strtol(argv[1], 0, 0) : SPI_DEFAULT_SLAVE;
+    const uint32_t runs = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1U;
+
+    Timer_Init();
+    status_t status = S2PI_Init(SPI_DEFAULT_SLAVE, SPI_BAUDRATE);
+    if (status != STATUS_OK)
+    {
+        fprintf(stderr, "S2PI initialization failed (error %d)\n", status);
+        return 1;
+    }
+
+    argus_sim_timing_t timing;
+    ArgusSim_GetTiming(&timing);
+    fprintf(stderr, "Simulator timing: SPI latency %u + %u ns, IRQ delay %u + %u us, "
+            "IRQ latency %u us\n", timing.SpiLatency, timing.SpiJitter,
+            timing.IrqDelay, timing.IrqJitter, timing.IrqLatency);
+
+    int failed = 0;
+    for (uint32_t run = 0; run < runs && failed == 0; ++run)
+    {
+        if (runs > 1) fprintf(stderr, "Run %u of %u\n", run + 1U, runs);
+        if (Argus_VerifyHALImplementation(slave) != STATUS_OK) failed++;
+    }
+    return failed;
+}
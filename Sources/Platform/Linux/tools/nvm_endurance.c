@@ -0,0 +1,412 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Power-failure and endurance test bench of the NVM record log on the
+ *              RAM flash simulator of the Linux host.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/nvm_endurance.c \
+ *                  Sources/Platform/Linux/driver/flash.c \
+ *                  Sources/Platform/Linux/driver/nvm.c \
+ *                  Sources/Utility/nvm_log.c -o nvm_endurance
+ *              ./nvm_endurance [iterations] [seed]
+ *              @endcode
+ *
+ *              The power-failure test writes random updates of the
+ *              calibration blocks of multiple devices and cuts the power at a
+ *              random flash operation, also during the garbage collection at
+ *              mount time. After each power failure, the log is mounted again
+ *              and each device must read either its last committed or (for
+ *              the interrupted write) its new data.
+ *
+ *              The endurance test compares the erase cycles and the busy time
+ *              of the record log with the previous slot based implementation
+ *              that rewrites the flash sectors of a slot on each update.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "driver/flash.h"
+#include "driver/nvm.h"
+#include "nvm_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of simulated devices. */
+#define DEVICE_COUNT 3U
+
+/*! The guaranteed number of erase cycles per sector (Kinetis KL46Z). */
+#define FLASH_ENDURANCE 10000U
+
+/*! The size of a slot of the previous implementation. */
+#define LEGACY_SLOT_SIZE (ARGUS_NVM_BLOCK_SIZE + 16U)
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The committed data per device. */
+static uint8_t myCommitted[DEVICE_COUNT][ARGUS_NVM_BLOCK_SIZE];
+
+/*! Determines whether data has been committed for a device. */
+static bool myHasData[DEVICE_COUNT];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/* The host has no AFBR-S50 API library; the NVM module only needs its version. */
+uint32_t Argus_GetAPIVersion(void)
+{
+    return 0x01040000U;
+}
+
+static uint32_t GetDeviceID(uint32_t device)
+{
+    return 0x00A5F000U + device;
+}
+
+static void UpdateData(uint8_t * data, uint32_t changes)
+{
+    for (uint32_t i = 0; i < changes; ++i)
+        data[(uint32_t)rand() % ARGUS_NVM_BLOCK_SIZE] = (uint8_t)rand();
+}
+
+static int Verify(uint32_t written, uint8_t const * pending)
+{
+    uint8_t data[ARGUS_NVM_BLOCK_SIZE];
+    for (uint32_t d = 0; d < DEVICE_COUNT; ++d)
+    {
+        status_t status = NVM_ReadBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, data);
+
+        if (!myHasData[d] && status == ERROR_NVM_EMPTY &&
+            !(d == written && pending != 0))
+            continue;
+
+        if (status == STATUS_OK && myHasData[d] &&
+            memcmp(data, myCommitted[d], sizeof(data)) == 0)
+            continue;
+
+        if (d == written && pending != 0)
+        {
+            /* The interrupted write is either committed or not. */
+            if (status == STATUS_OK && memcmp(data, pending, sizeof(data)) == 0)
+            {
+                memcpy(myCommitted[d], data, sizeof(data));
+                myHasData[d] = true;
+                continue;
+            }
+            if (status == ERROR_NVM_EMPTY && !myHasData[d]) continue;
+        }
+
+        printf("  device %u: unexpected data after power failure (status %d)\n", d, status);
+        return 1;
+    }
+    return 0;
+}
+
+static int TestPowerFailures(uint32_t iterations)
+{
+    Flash_Sim_Reset((uint32_t)rand());
+    Flash_Init();
+    memset(myHasData, 0, sizeof(myHasData));
+
+    status_t status = NVM_Init();
+    if (status != STATUS_OK) return 1;
+
+    uint32_t cuts = 0, mountCuts = 0, errors = 0;
+    uint8_t pending[ARGUS_NVM_BLOCK_SIZE];
+
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        const uint32_t d = (uint32_t)rand() % DEVICE_COUNT;
+        memcpy(pending, myCommitted[d], sizeof(pending));
+        UpdateData(pending, (uint32_t)rand() % 4U);
+
+        /* Cut the power within the next record or garbage collection. */
+        if (rand() % 2) Flash_Sim_SetPowerCut(rand() % 300);
+
+        status = NVM_WriteBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, pending);
+
+        if (!Flash_Sim_IsPowerLost())
+        {
+            Flash_Sim_SetPowerCut(-1);
+            if (status != STATUS_OK)
+            {
+                printf("  write failed w/o power failure (status %d)\n", status);
+                return 1;
+            }
+            memcpy(myCommitted[d], pending, sizeof(pending));
+            myHasData[d] = true;
+            errors += (uint32_t)Verify(d, 0);
+            continue;
+        }
+
+        /* Reboot; optionally with another power failure while mounting. */
+        cuts++;
+        Flash_Sim_PowerCycle();
+        if (rand() % 4 == 0)
+        {
+            Flash_Sim_SetPowerCut(rand() % 8);
+            NVM_Init();
+            if (Flash_Sim_IsPowerLost()) mountCuts++;
+            Flash_Sim_PowerCycle();
+        }
+
+        status = NVM_Init();
+        if (status != STATUS_OK)
+        {
+            printf("  mount failed after power failure (status %d)\n", status);
+            return 1;
+        }
+        errors += (uint32_t)Verify(d, pending);
+    }
+
+    printf("Power failures: %u writes, %u power cuts (%u while mounting), %u errors\n",
+           iterations, cuts, mountCuts, errors);
+    return errors ? 1 : 0;
+}
+
+static status_t LegacyWrite(uint32_t offset, uint32_t size, uint8_t const * buf)
+{
+    /* The previous NVM_Write: a read-erase-program per touched sector; the
+     * slots started at the second block of the API region. */
+    uint32_t idx = FLASH_API_BLOCK_INDEX(1U + offset / FLASH_BLOCK_SIZE);
+    offset %= FLASH_BLOCK_SIZE;
+    while (size)
+    {
+        uint32_t n = size;
+        if (offset + n > FLASH_BLOCK_SIZE) n = FLASH_BLOCK_SIZE - offset;
+
+        status_t status = Flash_Write(idx, offset, buf, n);
+        if (status < STATUS_OK) return status;
+
+        size -= n;
+        buf += n;
+        offset = 0;
+        idx++;
+    }
+    return STATUS_OK;
+}
+
+static status_t LegacyWriteSlot(uint32_t slot, uint32_t id, uint32_t count, uint8_t const * data)
+{
+    const uint32_t version = Argus_GetAPIVersion();
+    const uint8_t header[16] =
+    {
+        (uint8_t)(version >> 24), (uint8_t)(version >> 16), (uint8_t)(version >> 8), (uint8_t)version,
+        (uint8_t)(id >> 24), (uint8_t)(id >> 16), (uint8_t)(id >> 8), (uint8_t)id,
+        (uint8_t)(count >> 24), (uint8_t)(count >> 16), (uint8_t)(count >> 8), (uint8_t)count,
+    };
+    status_t status = LegacyWrite(slot * LEGACY_SLOT_SIZE, sizeof(header), header);
+    if (status == STATUS_OK)
+        status = LegacyWrite(slot * LEGACY_SLOT_SIZE + sizeof(header), ARGUS_NVM_BLOCK_SIZE, data);
+    return status;
+}
+
+static int TestLegacyImport(void)
+{
+    uint8_t data[DEVICE_COUNT][ARGUS_NVM_BLOCK_SIZE];
+    uint8_t cfg[FLASH_BLOCK_SIZE], read[FLASH_BLOCK_SIZE];
+    int errors = 0;
+
+    /* Earlier firmware: the slots of three devices and the configuration. */
+    Flash_Sim_Reset((uint32_t)rand());
+    for (uint32_t i = 0; i < sizeof(cfg); ++i) cfg[i] = (uint8_t)rand();
+    Flash_Write(FLASH_EXPL_CFG_INDEX, 0, cfg, sizeof(cfg));
+    for (uint32_t d = 0; d < DEVICE_COUNT; ++d)
+    {
+        UpdateData(data[d], ARGUS_NVM_BLOCK_SIZE);
+        if (LegacyWriteSlot(d, GetDeviceID(d), d + 1U, data[d]) != STATUS_OK) return 1;
+    }
+
+    if (NVM_Init() != STATUS_OK) return 1;
+    for (uint32_t d = 0; d < DEVICE_COUNT; ++d)
+    {
+        if (NVM_ReadBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, read) != STATUS_OK ||
+            memcmp(read, data[d], ARGUS_NVM_BLOCK_SIZE) != 0)
+        {
+            printf("  device %u: slot of earlier firmware not imported\n", d);
+            errors++;
+        }
+    }
+
+    /* A remaining slot must not override newer data on the next mount. */
+    UpdateData(data[0], 16);
+    if (NVM_WriteBlock(GetDeviceID(0), ARGUS_NVM_BLOCK_SIZE, data[0]) != STATUS_OK) return 1;
+    if (NVM_Init() != STATUS_OK) return 1;
+    if (NVM_ReadBlock(GetDeviceID(0), ARGUS_NVM_BLOCK_SIZE, read) != STATUS_OK ||
+        memcmp(read, data[0], ARGUS_NVM_BLOCK_SIZE) != 0)
+    {
+        printf("  device 0: newer data overridden by a slot of earlier firmware\n");
+        errors++;
+    }
+
+    if (Flash_Read(FLASH_EXPL_CFG_INDEX, 0, read, sizeof(read)) != STATUS_OK ||
+        memcmp(read, cfg, sizeof(cfg)) != 0)
+    {
+        printf("  configuration block modified\n");
+        errors++;
+    }
+
+    printf("Import of earlier firmware slots: %d errors\n", errors);
+    return errors ? 1 : 0;
+}
+
+static int TestCapacity(void)
+{
+    uint8_t data[ARGUS_NVM_BLOCK_SIZE], read[ARGUS_NVM_BLOCK_SIZE];
+    int errors = 0;
+
+    /* All devices fit; a further one is rejected w/o dropping any. */
+    Flash_Sim_Reset((uint32_t)rand());
+    if (NVM_Init() != STATUS_OK) return 1;
+    for (uint32_t d = 0; d <= FLASH_API_DEVICE_COUNT; ++d)
+    {
+        memset(data, (int)d, sizeof(data));
+        const status_t status = NVM_WriteBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, data);
+        const status_t expected = d < FLASH_API_DEVICE_COUNT ? STATUS_OK : ERROR_NVM_OUT_OF_RANGE;
+        if (status != expected)
+        {
+            printf("  device %u: write status %d, expected %d\n", d, status, expected);
+            errors++;
+        }
+    }
+
+    for (uint32_t round = 0; round < 2; ++round)
+    {
+        for (uint32_t d = 0; d < FLASH_API_DEVICE_COUNT; ++d)
+        {
+            memset(data, (int)d, sizeof(data));
+            if (NVM_ReadBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, read) != STATUS_OK ||
+                memcmp(read, data, sizeof(data)) != 0)
+            {
+                printf("  device %u: data lost\n", d);
+                errors++;
+            }
+        }
+        if (NVM_Init() != STATUS_OK) return 1;
+    }
+
+    printf("Capacity of %u devices: %d errors\n", FLASH_API_DEVICE_COUNT, errors);
+    return errors ? 1 : 0;
+}
+
+static void PrintEndurance(char const * name, uint32_t updates)
+{
+    flash_sim_stats_t stats;
+    Flash_Sim_GetStats(&stats);
+
+    uint32_t maxErase = 0;
+    for (uint32_t i = 0; i < FLASH_BLOCK_COUNT; ++i)
+    {
+        if (Flash_Sim_GetEraseCount(i) > maxErase) maxErase = Flash_Sim_GetEraseCount(i);
+    }
+
+    printf("  %-10s %8u erases, max %6u per sector, %7.2f ms per update, "
+           "lifetime %9.0f updates\n",
+           name, stats.Erases, maxErase, (double)stats.BusyTime / updates / 1000.0,
+           maxErase ? (double)FLASH_ENDURANCE * updates / maxErase : 0.0);
+}
+
+static int TestEndurance(uint32_t updates)
+{
+    uint8_t data[DEVICE_COUNT][ARGUS_NVM_BLOCK_SIZE] = { 0 };
+    uint8_t header[16] = { 0 };
+
+    printf("Endurance: %u updates of %u devices with %u byte blocks\n",
+           updates, DEVICE_COUNT, ARGUS_NVM_BLOCK_SIZE);
+
+    /* Previous implementation: a fixed slot per device, header and data
+     * are written separately. */
+    Flash_Sim_Reset((uint32_t)rand());
+    for (uint32_t i = 0; i < updates; ++i)
+    {
+        const uint32_t d = i % DEVICE_COUNT;
+        UpdateData(data[d], 1);
+        header[11] = (uint8_t)i; // the slot count
+        if (LegacyWrite(d * LEGACY_SLOT_SIZE, sizeof(header), header) != STATUS_OK ||
+            LegacyWrite(d * LEGACY_SLOT_SIZE + sizeof(header), ARGUS_NVM_BLOCK_SIZE, data[d]) != STATUS_OK)
+            return 1;
+    }
+    PrintEndurance("slots", updates);
+
+    /* Record log; every other update is unchanged and skipped. */
+    Flash_Sim_Reset((uint32_t)rand());
+    if (NVM_Init() != STATUS_OK) return 1;
+    for (uint32_t i = 0; i < updates; ++i)
+    {
+        const uint32_t d = i % DEVICE_COUNT;
+        if ((i / DEVICE_COUNT) % 2) UpdateData(data[d], 1);
+        if (NVM_WriteBlock(GetDeviceID(d), ARGUS_NVM_BLOCK_SIZE, data[d]) != STATUS_OK)
+            return 1;
+    }
+    PrintEndurance("log", updates);
+
+    nvm_log_stats_t stats;
+    NVMLog_GetStats(&stats);
+    printf("  log: %u records, %u skipped, %u relocated, %u rejected, "
+           "erase counts %u..%u\n", stats.Writes, stats.Skipped,
+           stats.Relocations, stats.Rejections, stats.MinEraseCount, stats.MaxEraseCount);
+
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t iterations = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 10000U;
+    const uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 1U;
+    srand(seed);
+
+    int result = TestLegacyImport();
+    result |= TestCapacity();
+    result |= TestPowerFailures(iterations);
+    result |= TestEndurance(iterations);
+    return result;
+}
@@ -0,0 +1,210 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Benchmark of the point cloud conversion kernels on the Linux host.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Platform/Linux \
+ *                  Sources/Platform/Linux/tools/point_cloud_bench.c \
+ *                  Sources/Platform/Linux/cloud/point_cloud.c -lm -o point_cloud_bench
+ *              ./point_cloud_bench [frames] [passes]
+ *              @endcode
+ *
+ *              Converts a batch of synthetic frames with each kernel that is
+ *              supported by the CPU, from pixel arrays with the stride of the
+ *              columnar recording layout and from #argus_results_t, and
+ *              reports the throughput in points per second. The output of
+ *              each kernel is verified to be bit-identical to the scalar
+ *              kernel.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "cloud/point_cloud.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The array stride of the synthetic frames, i.e. incl. the reference pixel
+ *  like the columnar recording layout. */
+#define BENCH_STRIDE (ARGUS_PIXELS + 1U)
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t Random(uint32_t * state)
+{
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void * Alloc(size_t size)
+{
+    void * p = aligned_alloc(32, (size + 31U) & ~(size_t)31U);
+    if (p == 0)
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+static void AllocCloud(point_cloud_t * cloud, uint32_t points)
+{
+    cloud->X = Alloc(points * sizeof(float));
+    cloud->Y = Alloc(points * sizeof(float));
+    cloud->Z = Alloc(points * sizeof(float));
+    cloud->I = Alloc(points * sizeof(float));
+}
+
+static void FreeCloud(point_cloud_t * cloud)
+{
+    free(cloud->X);
+    free(cloud->Y);
+    free(cloud->Z);
+    free(cloud->I);
+}
+
+static bool IsEqual(point_cloud_t const * a, point_cloud_t const * b, uint32_t points)
+{
+    const size_t size = points * sizeof(float);
+    return memcmp(a->X, b->X, size) == 0 && memcmp(a->Y, b->Y, size) == 0
+           && memcmp(a->Z, b->Z, size) == 0 && memcmp(a->I, b->I, size) == 0;
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t frames = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 100000U;
+    const uint32_t passes = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 10U;
+    if (frames == 0 || passes == 0)
+    {
+        fprintf(stderr, "usage: point_cloud_bench [frames] [passes]\n");
+        return 1;
+    }
+
+    const uint32_t points = frames * ARGUS_PIXELS;
+    q9_22_t * range = Alloc(frames * BENCH_STRIDE * sizeof(q9_22_t));
+    uq12_4_t * amplitude = Alloc(frames * BENCH_STRIDE * sizeof(uq12_4_t));
+    uint8_t * status = Alloc(frames * BENCH_STRIDE);
+    argus_results_t * results = Alloc(frames * sizeof(argus_results_t));
+
+    /* Ranges up to 64 m incl. negative values; about 1/8 of the pixels
+     * have a status flag set. */
+    uint32_t seed = 1U;
+    memset(results, 0, frames * sizeof(argus_results_t));
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        for (uint32_t n = 0; n < BENCH_STRIDE; ++n)
+        {
+            const uint32_t k = f * BENCH_STRIDE + n;
+            range[k] = (q9_22_t)(Random(&seed) & 0x0FFFFFFFU) - (q9_22_t)0x00100000;
+            amplitude[k] = (uq12_4_t)Random(&seed);
+            status[k] = (Random(&seed) & 0x07U) ? 0 : (uint8_t)(1U << (Random(&seed) & 0x07U));
+
+            argus_pixel_t * px = n < ARGUS_PIXELS ? &results[f].Pixels[n] : &results[f].PixelRef;
+            px->Range = range[k];
+            px->Amplitude = amplitude[k];
+            px->Status = status[k];
+        }
+    }
+
+    point_cloud_converter_t conv;
+    point_cloud_t ref, cloud;
+    AllocCloud(&ref, points);
+    AllocCloud(&cloud, points);
+
+    PointCloud_Init(&conv, 0, POINT_CLOUD_ORDER_N);
+    printf("%u frames, %u points, %u passes; auto selects %s\n",
+           frames, points, passes, PointCloud_GetKernelName(conv.Kernel));
+
+    PointCloud_SetKernel(&conv, POINT_CLOUD_KERNEL_SCALAR);
+    PointCloud_ConvertArrays(&conv, range, amplitude, status, BENCH_STRIDE, frames, &ref);
+
+    int result = 0;
+    for (point_cloud_kernel_t k = POINT_CLOUD_KERNEL_SCALAR; k <= POINT_CLOUD_KERNEL_NEON; ++k)
+    {
+        if (PointCloud_SetKernel(&conv, k) != STATUS_OK) continue;
+
+        /* Warm up, i.e. exclude the page faults of the first pass. */
+        PointCloud_ConvertArrays(&conv, range, amplitude, status, BENCH_STRIDE, frames, &cloud);
+
+        double t = Now();
+        for (uint32_t p = 0; p < passes; ++p)
+            PointCloud_ConvertArrays(&conv, range, amplitude, status, BENCH_STRIDE, frames, &cloud);
+        const double tArrays = Now() - t;
+        const bool isArraysOk = IsEqual(&ref, &cloud, points);
+
+        memset(cloud.X, 0, points * sizeof(float));
+        t = Now();
+        for (uint32_t p = 0; p < passes; ++p)
+            PointCloud_ConvertResults(&conv, results, frames, &cloud);
+        const double tResults = Now() - t;
+        const bool isResultsOk = IsEqual(&ref, &cloud, points);
+
+        printf("  %-7s arrays: %8.1f M points/s%s   results: %8.1f M points/s%s\n",
+               PointCloud_GetKernelName(k),
+               (double)points * passes / tArrays / 1e6, isArraysOk ? "" : " MISMATCH",
+               (double)points * passes / tResults / 1e6, isResultsOk ? "" : " MISMATCH");
+        if (!isArraysOk || !isResultsOk) result = 1;
+    }
+
+    FreeCloud(&ref);
+    FreeCloud(&cloud);
+    free(range);
+    free(amplitude);
+    free(status);
+    free(results);
+    return result;
+}
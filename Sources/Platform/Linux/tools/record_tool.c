@@ -0,0 +1,347 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Inspection, export and benchmark tool of the measurement recording
+ *              format on the Linux host.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/Platform/Linux \
+ *                  Sources/Platform/Linux/tools/record_tool.c \
+ *                  Sources/Platform/Linux/record/record_reader.c \
+ *                  Sources/Platform/Linux/record/record_writer.c -o record_tool
+ *              ./record_tool info <file>
+ *              ./record_tool csv <file> [device] [first] [count]
+ *              ./record_tool bench <file> [frames] [devices]
+ *              @endcode
+ *
+ *              The info command prints the header and the frame count of
+ *              each device stream. The csv command prints the range,
+ *              amplitude and status of the pixels of a device stream.
+ *
+ *              The bench command writes a recording of synthetic frames in
+ *              the row and in the columnar layout (incl. debug data) and
+ *              reports the write throughput, the random access rate of the
+ *              zero-copy and the copying reads and a sequential range scan.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "record/record.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of random reads of the benchmark. */
+#define BENCH_READS 1000000U
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint32_t Random(uint32_t * state)
+{
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void SyntheticFrame(argus_results_t * res, argus_results_debug_t * dbg,
+                           uint8_t device, uint32_t frame)
+{
+    memset(res, 0, sizeof(*res));
+    res->Status = STATUS_OK;
+    res->TimeStamp.sec = frame / 1000U;
+    res->TimeStamp.usec = (frame % 1000U) * 1000U;
+
+    for (uint32_t i = 0; i < RECORD_PIXELS; ++i)
+    {
+        argus_pixel_t * px = i < ARGUS_PIXELS ? &res->Pixels[i] : &res->PixelRef;
+        px->Range = (q9_22_t)((frame * 31U + i * 977U + device * 7919U) & 0x3FFFFFFU);
+        px->Amplitude = (uq12_4_t)(frame + i);
+        px->AmplitudeRaw = px->Amplitude;
+        px->Status = (argus_px_status_t)(i & 0x0FU);
+    }
+    res->Bin.Range = res->Pixels[0].Range;
+    res->Bin.Amplitude = res->Pixels[0].Amplitude;
+
+    if (dbg != 0)
+    {
+        memset(dbg, 0, sizeof(*dbg));
+        memcpy(dbg, &frame, sizeof(frame));
+    }
+}
+
+static int Info(char const * path)
+{
+    record_reader_t reader;
+    status_t status = RecordReader_Open(&reader, path);
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "cannot open %s (error %d)\n", path, status);
+        return 1;
+    }
+
+    record_file_header_t const * header = RecordReader_GetHeader(&reader);
+    printf("%s: version %u.%u, API v%u.%u.%u, %s layout%s, %u frames/chunk\n",
+           path, header->VersionMajor, header->VersionMinor,
+           header->ApiVersion >> 24U, (header->ApiVersion >> 16U) & 0xFFU,
+           header->ApiVersion & 0xFFFFU,
+           (header->Flags & RECORD_FLAG_COLUMNAR) ? "columnar" : "row",
+           (header->Flags & RECORD_FLAG_DEBUG) ? " incl. debug data" : "",
+           header->ChunkFrames);
+    if (reader.isRecovered)
+        printf("  index missing; recovered by scanning the chunks\n");
+
+    for (uint8_t dev = 0; dev < RECORD_DEVICE_COUNT; ++dev)
+    {
+        const uint32_t count = RecordReader_GetFrameCount(&reader, dev);
+        if (count > 0) printf("  device %u: %u frames\n", dev, count);
+    }
+
+    RecordReader_Close(&reader);
+    return 0;
+}
+
+static int Csv(char const * path, uint8_t device, uint32_t first, uint32_t count)
+{
+    record_reader_t reader;
+    status_t status = RecordReader_Open(&reader, path);
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "cannot open %s (error %d)\n", path, status);
+        return 1;
+    }
+
+    printf("frame;time");
+    for (uint32_t i = 0; i < RECORD_PIXELS; ++i) printf(";range%u;amplitude%u;status%u", i, i, i);
+    printf("\n");
+
+    const uint32_t frames = RecordReader_GetFrameCount(&reader, device);
+    for (uint32_t idx = first; idx < frames && idx - first < count; ++idx)
+    {
+        argus_results_t res;
+        status = RecordReader_GetFrame(&reader, device, idx, &res, 0);
+        if (status < STATUS_OK) break;
+
+        printf("%u;%u.%06u", idx, res.TimeStamp.sec, res.TimeStamp.usec);
+        for (uint32_t i = 0; i < RECORD_PIXELS; ++i)
+        {
+            argus_pixel_t const * px = i < ARGUS_PIXELS ? &res.Pixels[i] : &res.PixelRef;
+            printf(";%.6f;%.4f;%u", px->Range / 4194304.0, px->Amplitude / 16.0, px->Status);
+        }
+        printf("\n");
+    }
+
+    RecordReader_Close(&reader);
+    return status < STATUS_OK;
+}
+
+static int Bench(char const * path, uint32_t frames, uint32_t devices, uint32_t flags)
+{
+    argus_results_t res;
+    argus_results_debug_t dbg;
+    record_writer_t writer;
+
+    printf("%s layout%s, %u frames x %u devices:\n",
+           (flags & RECORD_FLAG_COLUMNAR) ? "columnar" : "row",
+           (flags & RECORD_FLAG_DEBUG) ? " incl. debug data" : "", frames, devices);
+
+    /* Write the frames of the devices interleaved, like a live recording. */
+    double t = Now();
+    status_t status = RecordWriter_Open(&writer, path, flags, 0);
+    for (uint32_t frame = 0; frame < frames && status == STATUS_OK; ++frame)
+    {
+        for (uint8_t dev = 0; dev < devices && status == STATUS_OK; ++dev)
+        {
+            SyntheticFrame(&res, &dbg, dev, frame);
+            status = RecordWriter_Append(&writer, dev, &res, &dbg);
+        }
+    }
+    if (status == STATUS_OK) status = RecordWriter_Close(&writer);
+    t = Now() - t;
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "writing %s failed (error %d)\n", path, status);
+        return 1;
+    }
+
+    struct stat st;
+    stat(path, &st);
+    const double total = (double)frames * devices;
+    printf("  write:      %8.1f MB/s, %10.0f frames/s, %.1f bytes/frame\n",
+           (double)st.st_size / t / 1e6, total / t, (double)st.st_size / total);
+
+    /* Open and verify a sample of frames. */
+    record_reader_t reader;
+    t = Now();
+    status = RecordReader_Open(&reader, path);
+    t = Now() - t;
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "reading %s failed (error %d)\n", path, status);
+        return 1;
+    }
+    printf("  open:       %8.3f ms\n", t * 1e3);
+
+    int result = 0;
+    argus_results_t ref;
+    argus_results_debug_t refDbg;
+    for (uint32_t i = 0; i < 1000U && result == 0; ++i)
+    {
+        const uint8_t dev = (uint8_t)(i % devices);
+        const uint32_t idx = (uint32_t)(((uint64_t)i * 2654435761U) % frames);
+        SyntheticFrame(&ref, &refDbg, dev, idx);
+        if (RecordReader_GetFrame(&reader, dev, idx, &res, &dbg) < STATUS_OK
+            || ((flags & RECORD_FLAG_DEBUG) && memcmp(&dbg, &refDbg, sizeof(dbg)) != 0)
+            || res.TimeStamp.usec != ref.TimeStamp.usec
+            || res.Pixels[5].Range != ref.Pixels[5].Range
+            || res.PixelRef.Amplitude != ref.PixelRef.Amplitude
+            || res.Pixels[31].Status != ref.Pixels[31].Status)
+        {
+            fprintf(stderr, "  frame %u of device %u does not match\n", idx, dev);
+            result = 1;
+        }
+    }
+
+    /* Random access; touch the data to include the page faults. */
+    uint32_t seed = 1U;
+    uint64_t sum = 0;
+    t = Now();
+    for (uint32_t i = 0; i < BENCH_READS; ++i)
+    {
+        const uint32_t r = Random(&seed);
+        const uint8_t dev = (uint8_t)(r % devices);
+        const uint32_t idx = (r >> 4U) % frames;
+        if (flags & RECORD_FLAG_COLUMNAR)
+        {
+            record_columns_t columns;
+            RecordReader_GetColumns(&reader, dev, idx, &columns);
+            sum += (uint32_t)columns.Range[i % RECORD_PIXELS];
+        }
+        else
+        {
+            sum += (uint32_t)RecordReader_GetResults(&reader, dev, idx)->Pixels[i % ARGUS_PIXELS].Range;
+        }
+    }
+    t = Now() - t;
+    printf("  zero-copy:  %8.2f M reads/s\n", BENCH_READS / t / 1e6);
+
+    t = Now();
+    for (uint32_t i = 0; i < BENCH_READS; ++i)
+    {
+        const uint32_t r = Random(&seed);
+        RecordReader_GetFrame(&reader, (uint8_t)(r % devices), (r >> 4U) % frames, &res, 0);
+        sum += (uint32_t)res.Pixels[i % ARGUS_PIXELS].Range;
+    }
+    t = Now() - t;
+    printf("  copy:       %8.2f M reads/s\n", BENCH_READS / t / 1e6);
+
+    /* Sequential scan of a single pixel column, e.g. for a range histogram. */
+    t = Now();
+    for (uint8_t dev = 0; dev < devices; ++dev)
+    {
+        for (uint32_t idx = 0; idx < frames; ++idx)
+        {
+            if (flags & RECORD_FLAG_COLUMNAR)
+            {
+                record_columns_t columns;
+                RecordReader_GetColumns(&reader, dev, idx, &columns);
+                sum += (uint32_t)columns.Range[16];
+            }
+            else
+            {
+                sum += (uint32_t)RecordReader_GetResults(&reader, dev, idx)->Pixels[16].Range;
+            }
+        }
+    }
+    t = Now() - t;
+    printf("  scan:       %8.2f M frames/s (checksum %08x)\n", total / t / 1e6, (uint32_t)sum);
+
+    RecordReader_Close(&reader);
+    return result;
+}
+
+int main(int argc, char * argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "info") == 0)
+    {
+        return Info(argv[2]);
+    }
+    else if (argc >= 3 && strcmp(argv[1], "csv") == 0)
+    {
+        const uint8_t device = argc > 3 ? (uint8_t)strtoul(argv[3], 0, 0) : 0;
+        const uint32_t first = argc > 4 ? (uint32_t)strtoul(argv[4], 0, 0) : 0;
+        const uint32_t count = argc > 5 ? (uint32_t)strtoul(argv[5], 0, 0) : UINT32_MAX;
+        return Csv(argv[2], device, first, count);
+    }
+    else if (argc >= 3 && strcmp(argv[1], "bench") == 0)
+    {
+        const uint32_t frames = argc > 3 ? (uint32_t)strtoul(argv[3], 0, 0) : 100000U;
+        const uint32_t devices = argc > 4 ? (uint32_t)strtoul(argv[4], 0, 0) : 1U;
+        if (frames == 0 || devices == 0 || devices > RECORD_DEVICE_COUNT)
+        {
+            fprintf(stderr, "invalid frame or device count\n");
+            return 1;
+        }
+
+        int result = Bench(argv[2], frames, devices, 0);
+        result |= Bench(argv[2], frames, devices, RECORD_FLAG_COLUMNAR | RECORD_FLAG_DEBUG);
+        return result;
+    }
+
+    fprintf(stderr, "usage: record_tool info <file>\n"
+                    "       record_tool csv <file> [device] [first] [count]\n"
+                    "       record_tool bench <file> [frames] [devices]\n");
+    return 1;
+}
@@ -0,0 +1,399 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Throughput and latency benchmark of the SCI aggregator with
+ *              pseudo terminal pairs on the Linux host.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/ExplorerApp \
+ *                  -ISources/Platform/Linux Sources/Platform/Linux/tools/sci_agg_bench.c \
+ *                  Sources/Platform/Linux/aggregator/[a-z]*.c \
+ *                  Sources/ExplorerApp/sci/sci_crc8.c -lpthread -o sci_agg_bench
+ *              ./sci_agg_bench [ports] [seconds] [rate] [consumers]
+ *              @endcode
+ *
+ *              Creates a pseudo terminal pair per port (default 12); the
+ *              aggregator reads the terminal side like a serial port while a
+ *              sender thread per port writes SCI frames of 3D measurement
+ *              data size to the master side, either at the given rate per
+ *              port or as fast as possible (rate 0, default). The frames
+ *              contain the send time and a per-port sequence number.
+ *
+ *              The consumer threads (default 2) read the frame ring and
+ *              verify the sequence numbers, i.e. that no frame is lost,
+ *              duplicated or reordered unless it is reported as overwritten
+ *              by the ring. The report contains the aggregate frame rate,
+ *              the CPU load of the aggregator thread and the latency from
+ *              the send call (end-to-end) and from the read by the
+ *              aggregator (ring hand-over) to the consumer. At the maximum
+ *              rate, the end-to-end latency is dominated by the frames that
+ *              queue up in the terminal buffers; use a rate below the
+ *              capacity to measure the latency added by the aggregator.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#define _GNU_SOURCE // ptsname_r
+#include "aggregator/aggregator.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of parameter bytes per frame; like CMD_MEASUREMENT_DATA_3D. */
+#define BENCH_PAYLOAD 243U
+
+/*! The command byte of the frames (CMD_MEASUREMENT_DATA_3D). */
+#define BENCH_CMD 0x34U
+
+/*! The latency histogram resolution in ns. */
+#define BENCH_BIN 1000U
+
+/*! The number of latency histogram bins, i.e. up to 100 ms. */
+#define BENCH_BINS 100000U
+
+/*! The maximum number of consumer threads. */
+#define BENCH_MAX_CONSUMERS 8U
+
+/*! A sender thread. */
+typedef struct sender_t
+{
+    pthread_t Thread;
+    int Master;
+    uint16_t Port;
+    uint32_t Rate;
+    uint64_t Sent;
+    uint64_t Bytes;
+} sender_t;
+
+/*! A consumer thread. */
+typedef struct consumer_t
+{
+    pthread_t Thread;
+    frame_ring_t Ring;
+    uint64_t Frames;
+    uint64_t Gaps;
+    uint64_t Errors;
+    uint32_t Next[AGGREGATOR_MAX_PORTS];
+    uint32_t EndToEnd[BENCH_BINS];
+    uint32_t HandOver[BENCH_BINS];
+} consumer_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+static sender_t mySenders[AGGREGATOR_MAX_PORTS];
+static consumer_t myConsumers[BENCH_MAX_CONSUMERS];
+
+static volatile bool isSending = true;
+static volatile bool isConsuming = true;
+static volatile bool isAggregating = true;
+
+/*! The CPU time of the aggregator thread in seconds. */
+static double myAggregatorCpu = 0;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static void * SenderThread(void * param)
+{
+    sender_t * s = param;
+    uint8_t payload[BENCH_PAYLOAD];
+    uint8_t frame[2U * (BENCH_PAYLOAD + 3U) + 2U];
+
+    /* Pseudo random data incl. the control bytes that need to be escaped. */
+    uint32_t seed = 0x9E3779B9U * (s->Port + 1U);
+    for (uint32_t i = 0; i < sizeof(payload); ++i)
+    {
+        seed = seed * 1103515245U + 12345U;
+        payload[i] = (uint8_t)(seed >> 24U);
+    }
+
+    const uint64_t period = s->Rate ? 1000000000U / s->Rate : 0;
+    uint64_t next = Now();
+    uint32_t seq = 0;
+
+    while (isSending)
+    {
+        if (period)
+        {
+            next += period;
+            const struct timespec ts = { (time_t)(next / 1000000000U), (long)(next % 1000000000U) };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0);
+        }
+
+        const uint64_t t = Now();
+        memcpy(payload, &t, sizeof(t));
+        memcpy(payload + 8, &seq, sizeof(seq));
+        memcpy(payload + 12, &s->Port, sizeof(s->Port));
+        const uint32_t size = SCI_Codec_Encode(BENCH_CMD, 1, payload, sizeof(payload),
+                                               frame, sizeof(frame));
+
+        for (uint32_t n = 0; n < size;)
+        {
+            const ssize_t w = write(s->Master, frame + n, size - n);
+            if (w < 0) return 0;
+            n += (uint32_t)w;
+        }
+
+        seq++;
+        s->Sent++;
+        s->Bytes += size;
+    }
+
+    return 0;
+}
+
+static void * ConsumerThread(void * param)
+{
+    consumer_t * c = param;
+    static __thread uint8_t data[FRAME_RING_SLOT_SIZE];
+
+    while (isConsuming)
+    {
+        if (FrameRing_Wait(&c->Ring, 50) != STATUS_OK) continue;
+
+        frame_ring_entry_t entry;
+        while (FrameRing_Read(&c->Ring, &entry, data, sizeof(data)) == STATUS_OK)
+        {
+            const uint64_t now = Now();
+            uint64_t t;
+            uint32_t seq;
+            uint16_t port;
+            memcpy(&t, data, sizeof(t));
+            memcpy(&seq, data + 8, sizeof(seq));
+            memcpy(&port, data + 12, sizeof(port));
+
+            if (entry.Length != BENCH_PAYLOAD || entry.Command != BENCH_CMD
+                || entry.Device != 1 || port != entry.Port || port >= AGGREGATOR_MAX_PORTS
+                || seq < c->Next[port])
+            {
+                c->Errors++;
+                continue;
+            }
+
+            c->Gaps += seq - c->Next[port];
+            c->Next[port] = seq + 1U;
+            c->Frames++;
+
+            const uint64_t e2e = (now - t) / BENCH_BIN;
+            const uint64_t ho = (now - entry.Time) / BENCH_BIN;
+            c->EndToEnd[e2e < BENCH_BINS ? e2e : BENCH_BINS - 1U]++;
+            c->HandOver[ho < BENCH_BINS ? ho : BENCH_BINS - 1U]++;
+        }
+    }
+
+    return 0;
+}
+
+static void * AggregatorThread(void * param)
+{
+    (void)param;
+    while (isAggregating) Aggregator_Poll(50);
+
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    myAggregatorCpu = (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+    return 0;
+}
+
+static double Percentile(uint32_t const * hist, uint64_t count, double p)
+{
+    const uint64_t rank = (uint64_t)(p * (double)count);
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < BENCH_BINS; ++i)
+    {
+        sum += hist[i];
+        if (sum > rank) return (i + 1U) * (BENCH_BIN * 1e-3);
+    }
+    return BENCH_BINS * (BENCH_BIN * 1e-3);
+}
+
+static void PrintLatency(char const * name, uint32_t const * hist, uint64_t count)
+{
+    printf("    %-12s p50 %7.0f us, p99 %7.0f us, p99.9 %7.0f us, max %7.0f us\n", name,
+           Percentile(hist, count, 0.5), Percentile(hist, count, 0.99),
+           Percentile(hist, count, 0.999), Percentile(hist, count, 1.0 - 1e-12));
+}
+
+static int OpenPty(char * path, size_t size)
+{
+    const int master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0
+        || ptsname_r(master, path, size) != 0)
+    {
+        return -1;
+    }
+
+    /* The master side must not translate the frames either. */
+    struct termios tio;
+    tcgetattr(master, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(master, TCSANOW, &tio);
+    return master;
+}
+
+int main(int argc, char * argv[])
+{
+    const uint32_t ports = argc > 1 ? (uint32_t)strtoul(argv[1], 0, 0) : 12U;
+    const uint32_t seconds = argc > 2 ? (uint32_t)strtoul(argv[2], 0, 0) : 5U;
+    const uint32_t rate = argc > 3 ? (uint32_t)strtoul(argv[3], 0, 0) : 0U;
+    const uint32_t consumers = argc > 4 ? (uint32_t)strtoul(argv[4], 0, 0) : 2U;
+    if (ports == 0 || ports > AGGREGATOR_MAX_PORTS || seconds == 0
+        || consumers == 0 || consumers > BENCH_MAX_CONSUMERS)
+    {
+        fprintf(stderr, "usage: sci_agg_bench [ports] [seconds] [rate] [consumers]\n");
+        return 1;
+    }
+
+    char name[FRAME_RING_NAME_SIZE];
+    snprintf(name, sizeof(name), "/afbr_sci_bench_%d", (int)getpid());
+
+    frame_ring_t ring;
+    if (FrameRing_Create(&ring, name, FRAME_RING_SLOT_COUNT, FRAME_RING_SLOT_SIZE) < STATUS_OK)
+    {
+        fprintf(stderr, "cannot create the frame ring\n");
+        return 1;
+    }
+
+    Aggregator_Init(&ring, false);
+    for (uint32_t i = 0; i < ports; ++i)
+    {
+        char path[64];
+        mySenders[i].Master = OpenPty(path, sizeof(path));
+        mySenders[i].Port = (uint16_t)i;
+        mySenders[i].Rate = rate;
+        if (mySenders[i].Master < 0 || Aggregator_AddPort(path, 0) != (int32_t)i)
+        {
+            fprintf(stderr, "cannot set up pseudo terminal %u\n", i);
+            return 1;
+        }
+    }
+
+    for (uint32_t i = 0; i < consumers; ++i)
+    {
+        if (FrameRing_Open(&myConsumers[i].Ring, name) < STATUS_OK)
+        {
+            fprintf(stderr, "cannot open the frame ring\n");
+            return 1;
+        }
+        pthread_create(&myConsumers[i].Thread, 0, ConsumerThread, &myConsumers[i]);
+    }
+
+    pthread_t aggregator;
+    pthread_create(&aggregator, 0, AggregatorThread, 0);
+
+    const uint64_t start = Now();
+    for (uint32_t i = 0; i < ports; ++i)
+        pthread_create(&mySenders[i].Thread, 0, SenderThread, &mySenders[i]);
+
+    sleep(seconds);
+    isSending = false;
+    for (uint32_t i = 0; i < ports; ++i) pthread_join(mySenders[i].Thread, 0);
+    const double duration = (double)(Now() - start) * 1e-9;
+
+    /* Drain the terminals and the ring. */
+    usleep(200000);
+    isAggregating = false;
+    pthread_join(aggregator, 0);
+    isConsuming = false;
+    for (uint32_t i = 0; i < consumers; ++i) pthread_join(myConsumers[i].Thread, 0);
+
+    uint64_t sent = 0, bytes = 0, published = 0, reads = 0, errors = 0;
+    for (uint32_t i = 0; i < ports; ++i)
+    {
+        aggregator_stats_t s;
+        Aggregator_GetStats(i, &s);
+        sent += mySenders[i].Sent;
+        bytes += mySenders[i].Bytes;
+        published += s.Published;
+        reads += s.Reads;
+        errors += s.Codec.CrcErrors + s.Codec.FramingErrors + s.Codec.Overflows + s.Dropped;
+    }
+
+    printf("%u ports, %s, %u consumers, %.1f s:\n", ports,
+           rate ? "rate limited" : "max. rate", consumers, duration);
+    if (rate) printf("  rate:        %u frames/s per port\n", rate);
+    printf("  sent:        %10llu frames, %10.0f frames/s, %6.1f MB/s\n",
+           (unsigned long long)sent, (double)sent / duration, (double)bytes / duration / 1e6);
+    printf("  published:   %10llu frames, %10.0f frames/s, %llu decoder errors\n",
+           (unsigned long long)published, (double)published / duration,
+           (unsigned long long)errors);
+    printf("  aggregator:  %5.1f %% CPU, %.1f frames per read()\n",
+           100.0 * myAggregatorCpu / duration, reads ? (double)published / (double)reads : 0.0);
+
+    int result = (published != sent || errors != 0);
+    for (uint32_t i = 0; i < consumers; ++i)
+    {
+        consumer_t * c = &myConsumers[i];
+        printf("  consumer %u:  %10llu frames, %llu lost, %llu gaps, %llu errors\n", i,
+               (unsigned long long)c->Frames, (unsigned long long)c->Ring.Lost,
+               (unsigned long long)c->Gaps, (unsigned long long)c->Errors);
+        PrintLatency("end-to-end", c->EndToEnd, c->Frames);
+        PrintLatency("hand-over", c->HandOver, c->Frames);
+
+        /* Gaps are only allowed for frames the ring reports as overwritten. */
+        if (c->Errors != 0 || c->Gaps != c->Ring.Lost || c->Frames + c->Gaps != published)
+            result = 1;
+        FrameRing_Close(&c->Ring);
+    }
+
+    for (uint32_t i = 0; i < ports; ++i) close(mySenders[i].Master);
+    Aggregator_Deinit();
+    FrameRing_Close(&ring);
+    printf("%s\n", result ? "FAILED" : "PASSED");
+    return result;
+}
@@ -0,0 +1,240 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Daemon that aggregates the SCI streams of several ExplorerApp
+ *              boards into a shared memory frame ring on the Linux host.
+ *
+ *              Build and run from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -IAFBR-S50/Include -ISources/ExplorerApp \
+ *                  -ISources/Platform/Linux Sources/Platform/Linux/tools/sci_aggregator.c \
+ *                  Sources/Platform/Linux/aggregator/[a-z]*.c \
+ *                  Sources/ExplorerApp/sci/sci_crc8.c -o sci_aggregator
+ *              ./sci_aggregator [-r ring] [-n slots] [-b baud] [-a] [-i secs] <port>...
+ *              ./sci_aggregator -l [-r ring]
+ *              @endcode
+ *
+ *              The first form runs the daemon: the measurement data frames
+ *              of the ports (or all frames with -a) are published to the
+ *              shared memory ring (default "/afbr_sci", 4096 slots) and the
+ *              per-port statistics are printed every -i seconds (default
+ *              10; 0 disables). It runs until SIGINT or SIGTERM.
+ *
+ *              The second form attaches to the ring as a consumer and prints
+ *              a line per frame incl. the latency since the frame has been
+ *              read by the daemon.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "aggregator/aggregator.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The default name of the shared memory ring. */
+#define DEFAULT_RING "/afbr_sci"
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! Determines whether a termination signal has been received. */
+static volatile sig_atomic_t isStopped = 0;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void OnSignal(int sig)
+{
+    (void)sig;
+    isStopped = 1;
+}
+
+static uint64_t Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+
+static void PrintStats(aggregator_stats_t * last, double interval)
+{
+    for (uint32_t i = 0; i < Aggregator_GetPortCount(); ++i)
+    {
+        aggregator_stats_t s;
+        Aggregator_GetStats(i, &s);
+        printf("  port %2u: %-12s %8.1f frames/s %8.1f kB/s, %llu published, "
+               "%u crc / %u framing / %u overflow errors, %u reconnects\n",
+               i, s.isConnected ? "connected" : "disconnected",
+               (double)(s.Published - last[i].Published) / interval,
+               (double)(s.Bytes - last[i].Bytes) / interval / 1e3,
+               (unsigned long long)s.Published, s.Codec.CrcErrors,
+               s.Codec.FramingErrors, s.Codec.Overflows, s.Reconnects);
+        last[i] = s;
+    }
+    fflush(stdout);
+}
+
+static int Run(char const * name, uint32_t slots, uint32_t baudrate, bool allFrames,
+               uint32_t interval, char * const ports[], int count)
+{
+    frame_ring_t ring;
+    status_t status = FrameRing_Create(&ring, name, slots, FRAME_RING_SLOT_SIZE);
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "cannot create ring %s (error %d)\n", name, status);
+        return 1;
+    }
+
+    Aggregator_Init(&ring, allFrames);
+    for (int i = 0; i < count; ++i)
+    {
+        const int32_t port = Aggregator_AddPort(ports[i], baudrate);
+        if (port < 0)
+        {
+            fprintf(stderr, "cannot add port %s (error %d)\n", ports[i], port);
+            Aggregator_Deinit();
+            FrameRing_Close(&ring);
+            return 1;
+        }
+        printf("port %2d: %s\n", port, ports[i]);
+    }
+    printf("publishing to %s (%u slots)\n", name, slots);
+    fflush(stdout);
+
+    static aggregator_stats_t last[AGGREGATOR_MAX_PORTS];
+    uint64_t next = Now() + interval * 1000000000ULL;
+    while (!isStopped)
+    {
+        Aggregator_Poll(250);
+
+        const uint64_t now = Now();
+        if (interval > 0 && now >= next)
+        {
+            PrintStats(last, interval);
+            next += interval * 1000000000ULL;
+        }
+    }
+
+    Aggregator_Deinit();
+    FrameRing_Close(&ring);
+    return 0;
+}
+
+static int Listen(char const * name)
+{
+    frame_ring_t ring;
+    status_t status = FrameRing_Open(&ring, name);
+    if (status < STATUS_OK)
+    {
+        fprintf(stderr, "cannot open ring %s (error %d)\n", name, status);
+        return 1;
+    }
+
+    static uint8_t data[FRAME_RING_SLOT_SIZE];
+    uint64_t lost = 0;
+    while (!isStopped)
+    {
+        if (FrameRing_Wait(&ring, 250) != STATUS_OK) continue;
+
+        frame_ring_entry_t entry;
+        while (FrameRing_Read(&ring, &entry, data, sizeof(data)) == STATUS_OK)
+        {
+            printf("%llu: port %u, cmd 0x%02X, device %u, %u bytes, %.1f us\n",
+                   (unsigned long long)entry.Sequence, entry.Port, entry.Command,
+                   entry.Device, entry.Length, (double)(Now() - entry.Time) * 1e-3);
+        }
+
+        if (ring.Lost != lost)
+        {
+            printf("%llu frames lost\n", (unsigned long long)(ring.Lost - lost));
+            lost = ring.Lost;
+        }
+    }
+
+    FrameRing_Close(&ring);
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+    char const * name = DEFAULT_RING;
+    uint32_t slots = FRAME_RING_SLOT_COUNT;
+    uint32_t baudrate = 0;
+    uint32_t interval = 10;
+    bool allFrames = false;
+    bool isListener = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:n:b:ai:l")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r': name = optarg; break;
+            case 'n': slots = (uint32_t)strtoul(optarg, 0, 0); break;
+            case 'b': baudrate = (uint32_t)strtoul(optarg, 0, 0); break;
+            case 'a': allFrames = true; break;
+            case 'i': interval = (uint32_t)strtoul(optarg, 0, 0); break;
+            case 'l': isListener = true; break;
+            default: optind = argc + 1; break;
+        }
+    }
+
+    if (optind > argc || (!isListener && optind == argc))
+    {
+        fprintf(stderr, "usage: sci_aggregator [-r ring] [-n slots] [-b baud] [-a] [-i secs] <port>...\n"
+                        "       sci_aggregator -l [-r ring]\n");
+        return 1;
+    }
+
+    struct sigaction sa = { .sa_handler = OnSignal };
+    sigaction(SIGINT, &sa, 0);
+    sigaction(SIGTERM, &sa, 0);
+
+    if (isListener) return Listen(name);
+    return Run(name, slots, baudrate, allFrames, interval, &argv[optind], argc - optind);
+}
@@ -0,0 +1,957 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Micro-benchmark and regression test of the fixed point and
+ *              integer utility functions, see util_bench.sh.
+ *
+ *              Each function is verified against a double precision
+ *              reference for a few thousand inputs of log-uniformly
+ *              distributed magnitude, incl. the saturation limits; the
+ *              program fails if any error exceeds the tolerance of the
+ *              function (e.g. 0.5 LSB for the correctly rounded results).
+ *              Afterwards, the function is called for the same #BENCH_SIZE
+ *              inputs in a loop; the loop overhead, measured with an empty
+ *              operation, is subtracted except for the array functions.
+ *
+ *              The configuration variants (USE_64BIT_MUL, USE_HW_DIV,
+ *              FP_EXP_LOG_MUL64, FP_SQRT_DIV_MUL64 and FP_EMA_SIMD32) are
+ *              selected at compile time and printed in the header.
+ *
+ *              The same source runs on the Linux host and on the QEMU
+ *              Cortex-M machines (see the qemu_port module); the unit of the
+ *              reported costs depends on the platform:
+ *              - x86 host: TSC cycles (the nominal, not the actual core
+ *                clock).
+ *              - QEMU: executed instructions, derived from the virtual
+ *                clock with "-icount shift=0".
+ *
+ *              Build and run on the host from the repository root:
+ *              @code
+ *              gcc -std=gnu11 -O2 -fno-tree-vectorize -DNDEBUG \
+ *                  -IAFBR-S50/Include -ISources/Utility \
+ *                  -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+ *                  Sources/Platform/Linux/tools/util_bench.c \
+ *                  Sources/Utility/{fp_ema_array,fp_exp_log,fp_sqrt_div}.c \
+ *                  Sources/Utility/{hr_clock,timer_mux}.c \
+ *                  Sources/Platform/Linux/argus/argus_inline.c \
+ *                  Sources/Platform/Linux/driver/{irq,timer}.c \
+ *                  -lm -lpthread -o util_bench
+ *              ./util_bench
+ *              @endcode
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#define INT_SQRT 1 // bit-by-bit isqrt of the int_math module
+
+#include "fp_ema_array.h"
+#include "fp_exp_log.h"
+#include "fp_sqrt_div.h"
+#include "utility/fp_div.h"
+#include "utility/fp_ema.h"
+#include "utility/fp_mul.h"
+#include "utility/fp_rnd.h"
+#include "utility/int_math.h"
+#include "utility/time.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__arm__)
+#include "driver/qemu_port.h"
+#include "printf/printf.h"
+#define printf printf_
+#elif defined(__x86_64__) || defined(__i386__)
+#include <stdio.h>
+#include <x86intrin.h>
+#else
+#include <stdio.h>
+#include <time.h>
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of elements of the input arrays, i.e. the batch size. */
+#define BENCH_SIZE 128U
+
+#if defined(__arm__)
+/*! The repetitions of the input arrays per timing measurement. */
+#define BENCH_ROUNDS 50U
+/*! The number of inputs verified per function; a multiple of #BENCH_SIZE. */
+#define BENCH_CHECKS 4096U
+#else
+#define BENCH_ROUNDS 2000U
+#define BENCH_CHECKS 65536U
+#endif
+
+/*! The number of timing measurements; the minimum is reported. */
+#define BENCH_REPEAT 3U
+
+/*! The slack of the error tolerances for the rounding of the references. */
+#define BENCH_SLACK (1.0 / (1U << 20U))
+
+/*! Hides the value of a pointer from the optimizer, e.g. to keep the rounds
+ *  of a timing loop from being merged. */
+#define BENCH_BARRIER(p) __asm__ volatile ("" : "+r"(p))
+
+/*! Defines the timing loop and the verification of a scalar operation. The
+ *  expression \p expr is evaluated from the arguments a, b and c. */
+#define BENCH_SCALAR(name, expr)                                            \
+    static inline int64_t Eval_##name(uint32_t a, uint32_t b, uint32_t c)   \
+    {                                                                       \
+        (void)a; (void)b; (void)c;                                          \
+        return (int64_t)(expr);                                             \
+    }                                                                       \
+    static uint32_t Run_##name(uint32_t rounds)                             \
+    {                                                                       \
+        uint32_t acc = 0;                                                   \
+        for (uint32_t r = 0; r < rounds; ++r)                               \
+        {                                                                   \
+            uint32_t const * pa = myA, * pb = myB, * pc = myC;              \
+            BENCH_BARRIER(pa); BENCH_BARRIER(pb); BENCH_BARRIER(pc);        \
+            for (uint32_t i = 0; i < BENCH_SIZE; ++i)                       \
+                acc += (uint32_t)Eval_##name(pa[i], pb[i], pc[i]);          \
+        }                                                                   \
+        return acc;                                                         \
+    }                                                                       \
+    static inline void Block_##name(void)                                   \
+    {                                                                       \
+        for (uint32_t i = 0; i < BENCH_SIZE; ++i)                           \
+            myY[i] = Eval_##name(myA[i], myB[i], myC[i]);                   \
+    }
+
+/*! An entry of the benchmark table. */
+#define BENCH_ENTRY(name, fill, tolerance) \
+    { #name, fill, Run_##name, Block_##name, Ref_##name, tolerance, false }
+
+/*! An entry of the benchmark table for an array function. */
+#define BENCH_ARRAY(name, fill, tolerance) \
+    { #name, fill, Run_##name, Block_##name, Ref_##name, tolerance, true }
+
+/*! A function under test. */
+typedef struct
+{
+    /*! The function name. */
+    char const * Name;
+
+    /*! Generates the arguments of the i-th input. */
+    void (*Fill)(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c);
+
+    /*! Evaluates the function for all inputs the given number of times;
+     *  returns a checksum of the results. */
+    uint32_t (*Run)(uint32_t rounds);
+
+    /*! Evaluates the function for all inputs and stores the results. */
+    void (*Block)(void);
+
+    /*! The reference result in double precision. */
+    double (*Ref)(uint32_t a, uint32_t b, uint32_t c);
+
+    /*! The maximum absolute error vs. the reference in LSB. */
+    double Tolerance;
+
+    /*! Determines whether the function processes an array by itself, i.e.
+     *  the loop overhead is part of the measured time. */
+    bool Batched;
+
+} bench_op_t;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The arguments of the current inputs. */
+static uint32_t myA[BENCH_SIZE];
+static uint32_t myB[BENCH_SIZE];
+static uint32_t myC[BENCH_SIZE];
+
+/*! The results of the current inputs. */
+static int64_t myY[BENCH_SIZE];
+
+/*! The working arrays of the array functions. */
+static int32_t myQ32[BENCH_SIZE];
+static int16_t myM16[BENCH_SIZE];
+static int16_t myX16[BENCH_SIZE];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*! The external definition of the inline isqrt, see #INT_SQRT. */
+extern inline uint32_t isqrt(uint32_t v);
+
+#if defined(__arm__)
+static char const * Platform(void)
+{
+    return QEMU_MACHINE == 0 ? "Cortex-M0+ (QEMU microbit)" : "Cortex-M4 (QEMU mps2-an386)";
+}
+static char const * Unit(void) { return "instructions (QEMU -icount)"; }
+static uint64_t Ticks(void) { return QEMU_GetInstructions(); }
+#elif defined(__x86_64__) || defined(__i386__)
+static char const * Platform(void) { return "x86 host"; }
+static char const * Unit(void) { return "TSC cycles"; }
+static uint64_t Ticks(void) { return __rdtsc(); }
+#else
+static char const * Platform(void) { return "host"; }
+static char const * Unit(void) { return "nanoseconds"; }
+static uint64_t Ticks(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000U + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+/*! A 32-bit integer hash (lowbias32). */
+static uint32_t Hash(uint32_t x)
+{
+    x ^= x >> 16U;
+    x *= 0x7FEB352DU;
+    x ^= x >> 15U;
+    x *= 0x846CA68BU;
+    x ^= x >> 16U;
+    return x;
+}
+
+/*! The next random number of a sequence (splitmix32 style). */
+static uint32_t Next(uint32_t * seed)
+{
+    *seed += 0x9E3779B9U;
+    return Hash(*seed);
+}
+
+/*! The number of significant bits. */
+static uint32_t BitLength(uint32_t x)
+{
+    return x ? log2i(x) + 1U : 0;
+}
+
+/*! A random number with a random bit length of up to \p bits bits, i.e.
+ *  a log-uniform distribution incl. zero and the maximum values. */
+static uint32_t RandBits(uint32_t * seed, uint32_t bits)
+{
+    const uint32_t r = Next(seed);
+    const uint32_t n = Next(seed) % (bits + 1U);
+    if (n == 0) return 0;
+    return ((r & 0x07U) ? r : UINT32_MAX) >> (32U - n);
+}
+
+/*! A random sign applied to a magnitude of up to 31 bits. */
+static uint32_t RandSign(uint32_t * seed, uint32_t x)
+{
+    return (Next(seed) & 1U) ? (uint32_t)(-(int32_t)x) : x;
+}
+
+/*! The seed of the i-th input. */
+static uint32_t Seed(uint32_t i)
+{
+    return Hash(i ^ 0xA5A5A5A5U);
+}
+
+/*! Packs an #ltc_t value: seconds * 2^20 + microseconds. */
+static inline int64_t Pack(ltc_t const * t)
+{
+    return ((int64_t)t->sec << 20U) + t->usec;
+}
+
+/*! The packed reference of a time in microseconds. */
+static double PackUSec(double t)
+{
+    const double usec = fmod(t, 1000000.0);
+    return (t - usec) / 1000000.0 * 1048576.0 + usec;
+}
+
+/*! Clamps a reference value to the int32 range. */
+static double ClampS32(double x)
+{
+    return fmin(fmax(x, (double)INT32_MIN), (double)INT32_MAX);
+}
+
+/*! The reference of an EMA: weight 0 copies x. */
+static double RefEma(double mean, double x, uint32_t weight)
+{
+    return weight == 0 ? x : mean + (x - mean) * weight / 256.0;
+}
+
+/*******************************************************************************
+ * Input Generators
+ ******************************************************************************/
+
+/* Unsigned product a * b >> c, c in [1, 32], that fits into 32 bits. */
+static void FillMulU(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *c = 1U + Next(&s) % 32U;
+    *a = RandBits(&s, 32U);
+    const uint32_t n = 31U + *c - BitLength(*a);
+    *b = RandBits(&s, n < 32U ? n : 32U);
+}
+
+/* Signed product a * b >> c, c in [1, 32], that fits into 31 bits. */
+static void FillMulS(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *c = 1U + Next(&s) % 32U;
+    const uint32_t u = RandBits(&s, 31U);
+    const uint32_t n = 30U + *c - BitLength(u);
+    *a = RandSign(&s, u);
+    *b = RandSign(&s, RandBits(&s, n < 31U ? n : 31U));
+}
+
+/* Unsigned product a * b >> c with a 16-bit b. */
+static void FillMul16U(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *c = 1U + Next(&s) % 32U;
+    *a = RandBits(&s, 32U);
+    const uint32_t n = 31U + *c - BitLength(*a);
+    *b = RandBits(&s, n < 16U ? n : 16U);
+}
+
+/* Signed product a * b >> c with an unsigned 16-bit b. */
+static void FillMul16S(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *c = 1U + Next(&s) % 32U;
+    const uint32_t u = RandBits(&s, 31U);
+    const uint32_t n = 30U + *c - BitLength(u);
+    *a = RandSign(&s, u);
+    *b = RandBits(&s, n < 16U ? n : 16U);
+}
+
+/* Signed a / b incl. b = 0 and saturated results. */
+static void FillDiv(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandSign(&s, RandBits(&s, 31U));
+    *b = RandSign(&s, RandBits(&s, 31U));
+    *c = 0;
+}
+
+/* Signed a / b with the same b for each block of inputs. */
+static void FillDivArray(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    uint32_t t = Seed(i / BENCH_SIZE) ^ 0x5A5A5A5AU;
+    *a = RandSign(&s, RandBits(&s, 31U));
+    *b = RandSign(&t, RandBits(&t, 31U));
+    *c = 0;
+}
+
+/* Unsigned a rounded by b in [0, 32] bits. */
+static void FillRndU(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandBits(&s, 32U);
+    *b = Next(&s) % 33U;
+    *c = 0;
+}
+
+/* Signed a rounded by b in [0, 32] bits. */
+static void FillRndS(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandSign(&s, RandBits(&s, 31U));
+    *b = Next(&s) % 33U;
+    *c = 0;
+}
+
+/* Signed 16-bit mean a and value b, weight c. */
+static void FillEma16S(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    uint32_t t = Seed(i / BENCH_SIZE);
+    *a = (uint32_t)(int32_t)(int16_t)Next(&s);
+    *b = (uint32_t)(int32_t)(int16_t)Next(&s);
+    *c = Next(&t) & 0xFFU;
+}
+
+/* Unsigned 16-bit mean a and value b, weight c. */
+static void FillEma16U(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    uint32_t t = Seed(i / BENCH_SIZE);
+    *a = Next(&s) & 0xFFFFU;
+    *b = Next(&s) & 0xFFFFU;
+    *c = Next(&t) & 0xFFU;
+}
+
+/* UQ1.15 mean a and value b within +/- 2^15 (no wrap around), weight c. */
+static void FillEma15c(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = Next(&s) & 0xFFFFU;
+    const int32_t x = (int32_t)*a + (int32_t)(Next(&s) % 65535U) - 32767;
+    *b = (uint32_t)(x < 0 ? 0 : x > 0xFFFF ? 0xFFFF : x);
+    *c = Next(&s) & 0xFFU;
+}
+
+/* Unsigned 32-bit mean a and value b, weight c. */
+static void FillEma32U(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    uint32_t t = Seed(i / BENCH_SIZE);
+    *a = RandBits(&s, 32U);
+    *b = RandBits(&s, 32U);
+    *c = Next(&t) & 0xFFU;
+}
+
+/* Signed 32-bit mean a and value b, weight c. */
+static void FillEma32S(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    uint32_t t = Seed(i / BENCH_SIZE);
+    *a = RandSign(&s, RandBits(&s, 31U));
+    *b = RandSign(&s, RandBits(&s, 31U));
+    *c = Next(&t) & 0xFFU;
+}
+
+/* Unsigned a > 0 (or >= 2 for log2_round), divisor b > 0. */
+static void FillUInt(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandBits(&s, 32U);
+    if (*a < 2U) *a = 2U + (i & 1U);
+    *b = RandBits(&s, 32U);
+    if (*b == 0) *b = 1U;
+    *c = 0;
+}
+
+/* Signed a incl. INT32_MIN. */
+static void FillSInt(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = (Next(&s) % 64U) ? RandSign(&s, RandBits(&s, 31U)) : 0x80000000U;
+    *b = 0;
+    *c = 0;
+}
+
+/* Time a.b (seconds, microseconds) around the saturation limits. */
+static void FillTime(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    switch (Next(&s) % 4U)
+    {
+        case 0:  *a = 4294U; break;
+        case 1:  *a = 4294967U; break;
+        default: *a = RandBits(&s, 32U); break;
+    }
+    *b = Next(&s) % 1000000U;
+    *c = 0;
+}
+
+/* Time a.b plus c = usec << 12 | sec with sec < 2^12. */
+static void FillTimeAdd(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandBits(&s, 31U);
+    *b = Next(&s) % 1000000U;
+    *c = (Next(&s) % 1000000U) << 12U | RandBits(&s, 12U);
+}
+
+/* Start time a.(b & 0xFFFFF), end time (a + (b >> 20)).c with end >= start. */
+static void FillTimeDiff(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    const uint32_t dsec = RandBits(&s, 12U);
+    const uint32_t usec = Next(&s) % 1000000U;
+    *a = RandBits(&s, 31U);
+    *b = dsec << 20U | usec;
+    *c = Next(&s) % 1000000U;
+    if (dsec == 0 && *c < usec) *c = usec;
+}
+
+/* Q15.16 exponent within and somewhat beyond the output range. */
+static void FillExp(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = (uint32_t)((int32_t)(Next(&s) % 1600000U) - 800000);
+    *b = 0;
+    *c = 0;
+}
+
+/* UQ16.16 argument > 0. */
+static void FillLog(uint32_t i, uint32_t * a, uint32_t * b, uint32_t * c)
+{
+    uint32_t s = Seed(i);
+    *a = RandBits(&s, 32U);
+    if (*a == 0) *a = 1U;
+    *b = 0;
+    *c = 0;
+}
+
+/*******************************************************************************
+ * Functions Under Test
+ ******************************************************************************/
+
+/* The empty operation to measure the loop overhead. */
+BENCH_SCALAR(Loop, a)
+
+/* fp_mul.h */
+BENCH_SCALAR(fp_mulu, fp_mulu(a, b, (uint_fast8_t)c))
+BENCH_SCALAR(fp_muls, fp_muls((int32_t)a, (int32_t)b, (uint_fast8_t)c))
+BENCH_SCALAR(fp_mul_u32_u16, fp_mul_u32_u16(a, (uint16_t)b, (uint_fast8_t)c))
+BENCH_SCALAR(fp_mul_s32_u16, fp_mul_s32_u16((int32_t)a, (uint16_t)b, (uint_fast8_t)c))
+
+static double Ref_fp_mulu(uint32_t a, uint32_t b, uint32_t c)
+{
+    return ldexp((double)a * (double)b, -(int)c);
+}
+static double Ref_fp_muls(uint32_t a, uint32_t b, uint32_t c)
+{
+    return ldexp((double)(int32_t)a * (double)(int32_t)b, -(int)c);
+}
+static double Ref_fp_mul_u32_u16(uint32_t a, uint32_t b, uint32_t c)
+{
+    return Ref_fp_mulu(a, b, c);
+}
+static double Ref_fp_mul_s32_u16(uint32_t a, uint32_t b, uint32_t c)
+{
+    return ldexp((double)(int32_t)a * (double)b, -(int)c);
+}
+
+/* fp_div.h */
+BENCH_SCALAR(fp_div16, fp_div16((int32_t)a, (q15_16_t)b))
+
+static double Ref_fp_div16(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    if (b == 0) return (int32_t)a < 0 ? INT32_MIN : INT32_MAX;
+    return ClampS32((double)(int32_t)a * 65536.0 / (double)(int32_t)b);
+}
+
+/* fp_rnd.h */
+BENCH_SCALAR(fp_rndu, fp_rndu(a, (uint_fast8_t)b))
+BENCH_SCALAR(fp_rnds, fp_rnds((int32_t)a, (uint_fast8_t)b))
+BENCH_SCALAR(fp_truncu, fp_truncu(a, (uint_fast8_t)b))
+BENCH_SCALAR(fp_truncs, fp_truncs((int32_t)a, (uint_fast8_t)b))
+
+static double Ref_fp_rndu(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    return ldexp((double)a, -(int)b);
+}
+static double Ref_fp_rnds(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    return ldexp((double)(int32_t)a, -(int)b);
+}
+static double Ref_fp_truncu(uint32_t a, uint32_t b, uint32_t c)
+{
+    return trunc(Ref_fp_rndu(a, b, c));
+}
+static double Ref_fp_truncs(uint32_t a, uint32_t b, uint32_t c)
+{
+    return trunc(Ref_fp_rnds(a, b, c));
+}
+
+/* fp_ema.h */
+BENCH_SCALAR(fp_ema4, fp_ema4((q11_4_t)a, (q11_4_t)b, (uq0_8_t)c))
+BENCH_SCALAR(fp_ema15c, fp_ema15c((uq1_15_t)a, (uq1_15_t)b, (uq0_8_t)c))
+BENCH_SCALAR(uint_ema32, uint_ema32(a, b, (uq0_8_t)c))
+BENCH_SCALAR(int_ema32, int_ema32((int32_t)a, (int32_t)b, (uq0_8_t)c))
+
+static double Ref_fp_ema4(uint32_t a, uint32_t b, uint32_t c)
+{
+    return RefEma((int32_t)a, (int32_t)b, c);
+}
+static double Ref_fp_ema15c(uint32_t a, uint32_t b, uint32_t c)
+{
+    return RefEma(a, b, c);
+}
+static double Ref_uint_ema32(uint32_t a, uint32_t b, uint32_t c)
+{
+    return RefEma(a, b, c);
+}
+static double Ref_int_ema32(uint32_t a, uint32_t b, uint32_t c)
+{
+    return RefEma((int32_t)a, (int32_t)b, c);
+}
+
+/* int_math.h */
+BENCH_SCALAR(log2i, log2i(a))
+BENCH_SCALAR(log2_round, log2_round(a))
+BENCH_SCALAR(popcount, popcount(a ^ b))
+BENCH_SCALAR(absval, absval((int32_t)a))
+BENCH_SCALAR(ceildiv, ceildiv(a, b))
+BENCH_SCALAR(isqrt, isqrt(a))
+
+static double Ref_log2i(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)b; (void)c;
+    int e;
+    frexp((double)a, &e);
+    return e - 1;
+}
+static double Ref_log2_round(uint32_t a, uint32_t b, uint32_t c)
+{
+    const double e = Ref_log2i(a, b, c);
+    return e + ((double)a >= 1.5 * ldexp(1.0, (int)e));
+}
+static double Ref_popcount(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    double n = 0;
+    for (uint32_t x = a ^ b; x; x >>= 1U) n += x & 1U;
+    return n;
+}
+static double Ref_absval(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)b; (void)c;
+    return fabs((double)(int32_t)a);
+}
+static double Ref_ceildiv(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    /* fmod is exact; a / b is not for quotients close to an integer. */
+    const double r = fmod((double)a, (double)b);
+    return ((double)a - r) / (double)b + (r != 0);
+}
+static double Ref_isqrt(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)b; (void)c;
+    return floor(sqrt((double)a));
+}
+
+/* time.h */
+static inline int64_t Op_Time_ToUSec(uint32_t a, uint32_t b)
+{
+    const ltc_t t = { a, b };
+    return Time_ToUSec(&t);
+}
+static inline int64_t Op_Time_ToMSec(uint32_t a, uint32_t b)
+{
+    const ltc_t t = { a, b };
+    return Time_ToMSec(&t);
+}
+static inline int64_t Op_Time_FromUSec(uint32_t a)
+{
+    ltc_t t;
+    Time_FromUSec(&t, a);
+    return Pack(&t);
+}
+static inline int64_t Op_Time_Add(uint32_t a, uint32_t b, uint32_t c)
+{
+    const ltc_t t1 = { a, b };
+    const ltc_t t2 = { c & 0xFFFU, c >> 12U };
+    ltc_t t;
+    Time_Add(&t, &t1, &t2);
+    return Pack(&t);
+}
+static inline int64_t Op_Time_DiffUSec(uint32_t a, uint32_t b, uint32_t c)
+{
+    const ltc_t t1 = { a, b & 0xFFFFFU };
+    const ltc_t t2 = { a + (b >> 20U), c };
+    return Time_DiffUSec(&t1, &t2);
+}
+
+BENCH_SCALAR(Time_ToUSec, Op_Time_ToUSec(a, b))
+BENCH_SCALAR(Time_ToMSec, Op_Time_ToMSec(a, b))
+BENCH_SCALAR(Time_FromUSec, Op_Time_FromUSec(a ^ b))
+BENCH_SCALAR(Time_Add, Op_Time_Add(a, b, c))
+BENCH_SCALAR(Time_DiffUSec, Op_Time_DiffUSec(a, b, c))
+
+static double Ref_Time_ToUSec(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    return fmin((double)a * 1e6 + b, UINT32_MAX);
+}
+static double Ref_Time_ToMSec(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    return fmin(((double)a * 1e6 + b) / 1000.0, UINT32_MAX);
+}
+static double Ref_Time_FromUSec(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)c;
+    return PackUSec(a ^ b);
+}
+static double Ref_Time_Add(uint32_t a, uint32_t b, uint32_t c)
+{
+    return PackUSec(((double)a + (c & 0xFFFU)) * 1e6 + b + (c >> 12U));
+}
+static double Ref_Time_DiffUSec(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)a;
+    return (double)(b >> 20U) * 1e6 + c - (b & 0xFFFFFU);
+}
+
+/* fp_exp_log.h */
+BENCH_SCALAR(fp_exp16_fast, fp_exp16_fast((q15_16_t)a))
+BENCH_SCALAR(fp_log16_fast, fp_log16_fast(a))
+
+static double Ref_fp_exp16_fast(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)b; (void)c;
+    return fmin(exp((int32_t)a / 65536.0) * 65536.0, UINT32_MAX);
+}
+static double Ref_fp_log16_fast(uint32_t a, uint32_t b, uint32_t c)
+{
+    (void)b; (void)c;
+    return log(a / 65536.0) * 65536.0;
+}
+
+/* fp_sqrt_div.h */
+BENCH_SCALAR(isqrt_nr, isqrt_nr(a))
+
+static double Ref_isqrt_nr(uint32_t a, uint32_t b, uint32_t c)
+{
+    return Ref_isqrt(a, b, c);
+}
+
+static uint32_t Run_fp_div16_array(uint32_t rounds)
+{
+    for (uint32_t r = 0; r < rounds; ++r)
+    {
+        int32_t const * pa = (int32_t const *)myA;
+        BENCH_BARRIER(pa);
+        fp_div16_array(myQ32, pa, BENCH_SIZE, (q15_16_t)myB[0]);
+    }
+    return (uint32_t)myQ32[0];
+}
+static void Block_fp_div16_array(void)
+{
+    fp_div16_array(myQ32, (int32_t const *)myA, BENCH_SIZE, (q15_16_t)myB[0]);
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i) myY[i] = myQ32[i];
+}
+static double Ref_fp_div16_array(uint32_t a, uint32_t b, uint32_t c)
+{
+    return Ref_fp_div16(a, b, c);
+}
+
+/* fp_ema_array.h; the mean values are updated in place. */
+static void Prepare16(void)
+{
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i)
+    {
+        myM16[i] = (int16_t)myA[i];
+        myX16[i] = (int16_t)myB[i];
+    }
+}
+
+static uint32_t Run_fp_ema4_array(uint32_t rounds)
+{
+    Prepare16();
+    for (uint32_t r = 0; r < rounds; ++r)
+    {
+        int16_t * pm = myM16;
+        BENCH_BARRIER(pm);
+        fp_ema4_array(pm, myX16, BENCH_SIZE, (uq0_8_t)myC[0]);
+    }
+    return (uint32_t)myM16[0];
+}
+static void Block_fp_ema4_array(void)
+{
+    Prepare16();
+    fp_ema4_array(myM16, myX16, BENCH_SIZE, (uq0_8_t)myC[0]);
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i) myY[i] = myM16[i];
+}
+static double Ref_fp_ema4_array(uint32_t a, uint32_t b, uint32_t c)
+{
+    return Ref_fp_ema4(a, b, c);
+}
+
+static uint32_t Run_uint_ema16_array(uint32_t rounds)
+{
+    Prepare16();
+    for (uint32_t r = 0; r < rounds; ++r)
+    {
+        uint16_t * pm = (uint16_t *)myM16;
+        BENCH_BARRIER(pm);
+        uint_ema16_array(pm, (uint16_t const *)myX16, BENCH_SIZE, (uq0_8_t)myC[0]);
+    }
+    return (uint32_t)myM16[0];
+}
+static void Block_uint_ema16_array(void)
+{
+    Prepare16();
+    uint_ema16_array((uint16_t *)myM16, (uint16_t const *)myX16, BENCH_SIZE, (uq0_8_t)myC[0]);
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i) myY[i] = (uint16_t)myM16[i];
+}
+static double Ref_uint_ema16_array(uint32_t a, uint32_t b, uint32_t c)
+{
+    return RefEma(a, b, c);
+}
+
+static uint32_t Run_int_ema32_array(uint32_t rounds)
+{
+    memcpy(myQ32, myA, sizeof(myQ32));
+    for (uint32_t r = 0; r < rounds; ++r)
+    {
+        int32_t * pm = myQ32;
+        BENCH_BARRIER(pm);
+        int_ema32_array(pm, (int32_t const *)myB, BENCH_SIZE, (uq0_8_t)myC[0]);
+    }
+    return (uint32_t)myQ32[0];
+}
+static void Block_int_ema32_array(void)
+{
+    memcpy(myQ32, myA, sizeof(myQ32));
+    int_ema32_array(myQ32, (int32_t const *)myB, BENCH_SIZE, (uq0_8_t)myC[0]);
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i) myY[i] = myQ32[i];
+}
+static double Ref_int_ema32_array(uint32_t a, uint32_t b, uint32_t c)
+{
+    return Ref_int_ema32(a, b, c);
+}
+
+/*! The functions under test; the tolerances are given in LSB of the result. */
+static const bench_op_t myOps[] =
+{
+    BENCH_ENTRY(fp_mulu,        FillMulU,     0.5),
+    BENCH_ENTRY(fp_muls,        FillMulS,     0.5),
+    BENCH_ENTRY(fp_mul_u32_u16, FillMul16U,   1.0), // two roundings for shift > 16
+    BENCH_ENTRY(fp_mul_s32_u16, FillMul16S,   1.0),
+    BENCH_ENTRY(fp_div16,       FillDiv,      0.5),
+    BENCH_ENTRY(fp_rndu,        FillRndU,     0.5),
+    BENCH_ENTRY(fp_rnds,        FillRndS,     0.5),
+    BENCH_ENTRY(fp_truncu,      FillRndU,     0.0),
+    BENCH_ENTRY(fp_truncs,      FillRndS,     0.0),
+    BENCH_ENTRY(fp_ema4,        FillEma16S,   0.5),
+    BENCH_ENTRY(fp_ema15c,      FillEma15c,   0.5),
+    BENCH_ENTRY(uint_ema32,     FillEma32U,   0.5),
+    BENCH_ENTRY(int_ema32,      FillEma32S,   0.5),
+    BENCH_ENTRY(log2i,          FillUInt,     0.0),
+    BENCH_ENTRY(log2_round,     FillUInt,     0.0),
+    BENCH_ENTRY(popcount,       FillUInt,     0.0),
+    BENCH_ENTRY(absval,         FillSInt,     0.0),
+    BENCH_ENTRY(ceildiv,        FillUInt,     0.0),
+    BENCH_ENTRY(isqrt,          FillLog,      0.0),
+    BENCH_ENTRY(Time_ToUSec,    FillTime,     0.0),
+    BENCH_ENTRY(Time_ToMSec,    FillTime,     0.5),
+    BENCH_ENTRY(Time_FromUSec,  FillUInt,     0.0),
+    BENCH_ENTRY(Time_Add,       FillTimeAdd,  0.0),
+    BENCH_ENTRY(Time_DiffUSec,  FillTimeDiff, 0.0),
+    BENCH_ENTRY(fp_exp16_fast,  FillExp,      2.2),
+    BENCH_ENTRY(fp_log16_fast,  FillLog,      0.51),
+    BENCH_ENTRY(isqrt_nr,       FillLog,      0.0),
+    BENCH_ARRAY(fp_div16_array, FillDivArray, 0.5),
+    BENCH_ARRAY(fp_ema4_array,  FillEma16S,   0.5),
+    BENCH_ARRAY(uint_ema16_array, FillEma16U, 0.5),
+    BENCH_ARRAY(int_ema32_array, FillEma32S,  0.5),
+};
+
+static void FillBlock(bench_op_t const * op, uint32_t block)
+{
+    for (uint32_t i = 0; i < BENCH_SIZE; ++i)
+        op->Fill(block * BENCH_SIZE + i, &myA[i], &myB[i], &myC[i]);
+}
+
+/*! Measures the minimum ticks of #BENCH_ROUNDS calls of a timing loop. */
+static uint64_t Measure(uint32_t (*run)(uint32_t))
+{
+    static volatile uint32_t sink = 0;
+    uint64_t best = UINT64_MAX;
+    for (uint32_t k = 0; k < BENCH_REPEAT; ++k)
+    {
+        const uint64_t t0 = Ticks();
+        sink += run(BENCH_ROUNDS);
+        const uint64_t dt = Ticks() - t0;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+/*! Verifies a function vs. its reference; returns the maximum error. */
+static double Verify(bench_op_t const * op)
+{
+    double maxError = 0;
+    for (uint32_t block = 0; block < BENCH_CHECKS / BENCH_SIZE; ++block)
+    {
+        FillBlock(op, block);
+        op->Block();
+        for (uint32_t i = 0; i < BENCH_SIZE; ++i)
+        {
+            const double error = fabs((double)myY[i] - op->Ref(myA[i], myB[i], myC[i]));
+            if (error > maxError) maxError = error;
+        }
+    }
+    return maxError;
+}
+
+/*! Prints a non-negative value with the given number of decimals. */
+static void PrintFixed(double x, uint32_t decimals, int width)
+{
+    uint32_t scale = 1;
+    for (uint32_t i = 0; i < decimals; ++i) scale *= 10U;
+    const uint32_t v = (uint32_t)(fmin(x, 999999.0) * scale + 0.5);
+    printf(" %*u.%0*u", width - (int)decimals - 1, (unsigned)(v / scale), (int)decimals, (unsigned)(v % scale));
+}
+
+int main(void)
+{
+    printf("util_bench: %s, %s per operation\n", Platform(), Unit());
+    printf("  USE_64BIT_MUL=%d USE_HW_DIV=%d FP_EXP_LOG_MUL64=%d FP_SQRT_DIV_MUL64=%d FP_EMA_SIMD32=%d\n",
+           USE_64BIT_MUL, USE_HW_DIV, FP_EXP_LOG_MUL64, FP_SQRT_DIV_MUL64, FP_EMA_SIMD32);
+
+    /* The loop overhead of the scalar functions. */
+    FillBlock(&myOps[0], 0);
+    const uint64_t overhead = Measure(Run_Loop);
+
+    printf("  %-18s %10s %10s %10s\n", "function", "cyc/op", "max error", "tolerance");
+
+    uint32_t failures = 0;
+    for (uint32_t k = 0; k < sizeof(myOps) / sizeof(myOps[0]); ++k)
+    {
+        bench_op_t const * op = &myOps[k];
+
+        const double error = Verify(op);
+        const bool isFailed = !(error <= op->Tolerance + BENCH_SLACK);
+        if (isFailed) failures++;
+
+        FillBlock(op, 0);
+        const uint64_t ticks = Measure(op->Run);
+        const uint64_t net = op->Batched ? ticks : ticks > overhead ? ticks - overhead : 0;
+        const double cycles = (double)net / ((double)BENCH_ROUNDS * BENCH_SIZE);
+
+        printf("  %-18s", op->Name);
+        PrintFixed(cycles, 2U, 10);
+        PrintFixed(error, 3U, 10);
+        PrintFixed(op->Tolerance, 3U, 10);
+        printf(" %s\n", isFailed ? "FAILED" : "ok");
+    }
+
+    if (failures) printf("FAILED: %u numerical regressions\n", (unsigned)failures);
+    else printf("passed\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,158 @@
+#!/bin/sh
+# #############################################################################
+# ###     Micro-Benchmark of the Fixed Point and Integer Utilities          ###
+# #############################################################################
+#
+# Builds util_bench.c for every configuration variant of the utility headers
+# and runs it natively on the Linux host and on the QEMU Cortex-M0+/M4
+# machines. Each run verifies the results against double precision
+# references; the costs per operation of all variants are printed side by
+# side per target.
+#
+# Usage (from the repository root):
+#
+#   Sources/Platform/Linux/tools/util_bench.sh [host] [m0plus] [m4]
+#
+# Requirements:
+#   - host:   gcc
+#   - m0plus: arm-none-eabi-gcc (newlib) and qemu-system-arm "-M microbit";
+#             QEMU has no Cortex-M0+ machine, the nRF51 Cortex-M0 executes
+#             the same ARMv6-M code.
+#   - m4:     arm-none-eabi-gcc (newlib) and qemu-system-arm "-M mps2-an386"
+#   Targets with missing tools are skipped.
+#
+# The QEMU machines run with "-icount shift=0", i.e. the reported costs are
+# executed instructions rather than core cycles: QEMU is not cycle accurate.
+# The costs on the host are TSC cycles.
+#
+# Exit status: 1 if any variant fails the numerical verification.
+#
+# #############################################################################
+
+set -u
+
+CC_HOST=${CC_HOST:-gcc}
+CC_ARM=${CC_ARM:-arm-none-eabi-gcc}
+QEMU=${QEMU:-qemu-system-arm}
+OUT=${OUT:-_util_bench}
+
+# The configuration variants: "<label>:<compiler flags>".
+VARIANTS="
+base:-DUSE_64BIT_MUL=0 -DUSE_HW_DIV=0
+mul64:-DUSE_64BIT_MUL=1 -DUSE_HW_DIV=0
+hwdiv:-DUSE_64BIT_MUL=0 -DUSE_HW_DIV=1
+mul64+hwdiv:-DUSE_64BIT_MUL=1 -DUSE_HW_DIV=1
+generic:-DFP_EXP_LOG_MUL64=0 -DFP_SQRT_DIV_MUL64=0 -DFP_EMA_SIMD32=0
+"
+
+CFLAGS="-std=gnu11 -O2 -fno-tree-vectorize -DNDEBUG -IAFBR-S50/Include -ISources/Utility"
+
+SOURCES="Sources/Platform/Linux/tools/util_bench.c
+         Sources/Utility/fp_ema_array.c Sources/Utility/fp_exp_log.c
+         Sources/Utility/fp_sqrt_div.c Sources/Utility/hr_clock.c
+         Sources/Platform/Linux/argus/argus_inline.c"
+
+HOST_SOURCES="Sources/Utility/timer_mux.c
+              Sources/Platform/Linux/driver/irq.c Sources/Platform/Linux/driver/timer.c"
+
+QEMU_SOURCES="Sources/Platform/QEMU/startup/startup_qemu.c
+              Sources/Platform/QEMU/driver/qemu_port.c
+              Sources/Utility/printf/printf.c"
+
+failed=0
+
+# build <target> <flags> <elf>
+build()
+{
+    case $1 in
+        host)
+            $CC_HOST $CFLAGS $2 -ISources/Platform/Linux -ISources/Platform/Linux/driver \
+                $SOURCES $HOST_SOURCES -lm -lpthread -o "$3" ;;
+        m0plus|m4)
+            if [ "$1" = m0plus ]; then
+                cpu=cortex-m0plus; ld=qemu_m0.ld
+            else
+                cpu=cortex-m4; ld=qemu_m4.ld
+            fi
+            $CC_ARM -mcpu=$cpu -mthumb -mfloat-abi=soft $CFLAGS $2 -ISources/Platform/QEMU \
+                -ffunction-sections -fdata-sections -nostartfiles \
+                --specs=nano.specs --specs=nosys.specs -Wl,--gc-sections \
+                -T Sources/Platform/QEMU/startup/$ld $SOURCES $QEMU_SOURCES -lm -o "$3" ;;
+    esac
+}
+
+# run <target> <elf>
+run()
+{
+    case $1 in
+        host)   "$2" ;;
+        m0plus) timeout 600 $QEMU -M microbit -display none -monitor none -serial null \
+                    -semihosting-config enable=on,target=native -icount shift=0 -kernel "$2" 2>&1 ;;
+        m4)     timeout 600 $QEMU -M mps2-an386 -display none -monitor none -serial null \
+                    -semihosting-config enable=on,target=native -icount shift=0 -kernel "$2" 2>&1 ;;
+    esac
+}
+
+# available <target>
+available()
+{
+    case $1 in
+        host) command -v "$CC_HOST" >/dev/null ;;
+        *)    command -v "$CC_ARM" >/dev/null && command -v "$QEMU" >/dev/null ;;
+    esac
+}
+
+# summary <target>: the costs per operation of all variants side by side.
+summary()
+{
+    echo
+    echo "== $1: costs per operation; '!' marks failed verifications"
+    echo "$VARIANTS" | while IFS=: read -r label flags; do
+        [ -f "$OUT/$1.$label.log" ] && echo "$OUT/$1.$label.log"
+    done | xargs awk '
+        FNR == 1 { n++; label[n] = FILENAME; sub(/^.*\/[^.]*\./, "", label[n]); sub(/\.log$/, "", label[n]) }
+        NF == 5 && ($5 == "ok" || $5 == "FAILED") {
+            if (!($1 in row)) { row[$1] = ++rows; name[rows] = $1 }
+            cost[$1, n] = $2 ($5 == "FAILED" ? "!" : "")
+        }
+        END {
+            printf "%-18s", "function"
+            for (i = 1; i <= n; i++) printf " %12s", label[i]
+            printf "\n"
+            for (r = 1; r <= rows; r++) {
+                printf "%-18s", name[r]
+                for (i = 1; i <= n; i++) printf " %12s", ((name[r], i) in cost) ? cost[name[r], i] : "-"
+                printf "\n"
+            }
+        }'
+}
+
+targets=${*:-host m0plus m4}
+mkdir -p "$OUT"
+
+for target in $targets; do
+    if ! available "$target"; then
+        echo "== $target: skipped, the toolchain or QEMU is not installed"
+        continue
+    fi
+    rm -f "$OUT/$target".*
+
+    echo "$VARIANTS" | while IFS=: read -r label flags; do
+        [ -n "$label" ] || continue
+        elf="$OUT/util_bench_${target}_$label"
+        log="$OUT/$target.$label.log"
+
+        if ! build "$target" "$flags" "$elf"; then
+            echo "== $target $label: build failed"
+            touch "$OUT/$target.failed"
+            continue
+        fi
+        run "$target" "$elf" > "$log" || touch "$OUT/$target.failed"
+        echo "== $target $label: $(tail -n 1 "$log")"
+    done
+
+    [ -f "$OUT/$target.failed" ] && failed=1
+    summary "$target"
+done
+
+exit $failed
@@ -305,6 +305,21 @@
 #define DMA_CHANNEL_SPI_RX          1U                  /*!< DMA Channel 1: SPI receiver */
 #define DMA_CHANNEL_UART_TX         2U                  /*!< DMA Channel 2: UART transmit */
 
+/* DMA Channels of the SPI instances.
+ * Note: the DMA has only 4 channels and channel 2 is occupied by the UART.
+ *       Thus, SPI0 shares the DMA channels with SPI1 by default and the S2PI
+ *       driver serializes the DMA transfers of both instances. Assign distinct
+ *       channels (e.g. if the UART does not require a DMA channel) to run the
+ *       transfers on both instances in parallel. */
+#ifndef DMA_CHANNEL_SPI1_TX
+#define DMA_CHANNEL_SPI1_TX         DMA_CHANNEL_SPI_TX  /*!< DMA Channel: SPI1 transmit */
+#define DMA_CHANNEL_SPI1_RX         DMA_CHANNEL_SPI_RX  /*!< DMA Channel: SPI1 receiver */
+#endif
+#ifndef DMA_CHANNEL_SPI0_TX
+#define DMA_CHANNEL_SPI0_TX         DMA_CHANNEL_SPI_TX  /*!< DMA Channel: SPI0 transmit */
+#define DMA_CHANNEL_SPI0_RX         DMA_CHANNEL_SPI_RX  /*!< DMA Channel: SPI0 receiver */
+#endif
+
 #define DMA_REQUEST_MUX_UART_TX     3U                  /*!< DMAMUX Channel 2: UART0 transmit complete */
 #define DMA_REQUEST_MUX_SPI0_TX     17U                 /*!< DMAMUX Channel 0: SPI0 transmit complete */
 #define DMA_REQUEST_MUX_SPI0_RX     16U                 /*!< DMAMUX Channel 1: SPI0 receive complete */
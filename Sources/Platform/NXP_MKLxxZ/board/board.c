@@ -42,7 +42,10 @@
 #include "driver/uart.h"
 #include "driver/timer.h"
 #include "driver/flash.h"
+#include "driver/nvm.h"
 #include "debug.h" // declaration of print() and error_log()
+#include "boot_profile.h"
+#include "hr_clock.h"
 
 #if defined(CPU_MKL46Z256VLL4)
 #include "driver/MKL46Z/slcd.h"
@@ -52,23 +55,77 @@
 #endif
 
 
+/*! The boot phase profiler handle of the startup phase. */
+static int32_t myStartupPhase = -1;
+
+/*! The last SysTick value of the startup clock. */
+static uint32_t myStartupTicks = 0;
+
+/*! The elapsed time of the startup clock in microseconds. */
+static uint32_t myStartupTime = 0;
+
+static uint32_t Board_GetStartupTime(void)
+{
+    /* The SysTick counts down core clock cycles; the cycles are converted
+     * with the current core clock, i.e. the time of the clock setup is
+     * approximated with the new core clock. */
+    const uint32_t ticks = SysTick->VAL;
+    const uint32_t elapsed = (myStartupTicks - ticks) & SysTick_VAL_CURRENT_Msk;
+    const uint32_t ticksPerUSec = SystemCoreClock / 1000000U;
+    const uint32_t usec = elapsed / ticksPerUSec;
+
+    myStartupTicks = (myStartupTicks - usec * ticksPerUSec) & SysTick_VAL_CURRENT_Msk;
+    myStartupTime += usec;
+    return myStartupTime;
+}
+
+static uint32_t Board_GetTime(void)
+{
+    return (uint32_t)HRClock_ToUSec(HRClock_Now());
+}
+
+void Board_Startup(void)
+{
+    /* Free running SysTick until the timer module takes it over. */
+    SysTick->CTRL = 0;
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+    myStartupTicks = SysTick->VAL;
+    myStartupTime = 0;
+
+    BootProfile_Start(((uint32_t)RCM->SRS1 << 8U) | RCM->SRS0);
+    BootProfile_SetClock(Board_GetStartupTime);
+    myStartupPhase = BootProfile_Begin(BOOT_PHASE_STARTUP, 0);
+}
+
 status_t Board_Init(void)
 {
+    BootProfile_End(myStartupPhase);
+    const int32_t board = BootProfile_Begin(BOOT_PHASE_BOARD, 0);
+
     /* Disable the watchdog timer. */
     COP_Disable();
 
     /* Initialize the board with clocks. */
+    int32_t phase = BootProfile_Begin(BOOT_PHASE_CLOCKS, 0);
     BOARD_ClockInit();
+    BootProfile_End(phase);
 
-    /* Initialize timer required by the API. */
+    /* Initialize timer required by the API; it takes over the SysTick. */
+    phase = BootProfile_Begin(BOOT_PHASE_TIMER, 0);
     Timer_Init();
+    BootProfile_SetClock(Board_GetTime);
+    BootProfile_End(phase);
 
 #if defined(CPU_MKL46Z256VLL4)
     SLCD_Init();
 #endif
 
     /* Initialize UART for print functionality. */
+    phase = BootProfile_Begin(BOOT_PHASE_UART, 0);
     status_t status = UART_Init();
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         error_log("UART initialization failed, error code: %d", status);
@@ -76,7 +133,9 @@ status_t Board_Init(void)
     }
 
     /* Initialize the S2PI hardware required by the API. */
+    phase = BootProfile_Begin(BOOT_PHASE_S2PI, 0);
     status = S2PI_Init(SPI_DEFAULT_SLAVE, SPI_BAUDRATE);
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         error_log("S2PI initialization failed, error code: %d", status);
@@ -84,13 +143,26 @@ status_t Board_Init(void)
     }
 
     /* Initialize the Flash driver module. */
+    phase = BootProfile_Begin(BOOT_PHASE_FLASH, 0);
     status = Flash_Init();
+    BootProfile_End(phase);
     if (status < STATUS_OK)
     {
         error_log("Flash initialization failed, error code: %d", status);
         return status;
     }
 
+    /* Initialize the NVM module; mounts the record log. */
+    phase = BootProfile_Begin(BOOT_PHASE_NVM_INIT, 0);
+    status = NVM_Init();
+    BootProfile_End(phase);
+    if (status < STATUS_OK)
+    {
+        error_log("NVM initialization failed, error code: %d", status);
+        return status;
+    }
+
+    BootProfile_End(board);
     return STATUS_OK;
 }
 
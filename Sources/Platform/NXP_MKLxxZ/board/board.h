@@ -49,6 +49,15 @@
 #include "utility/status.h"
 
 
+/*!***************************************************************************
+ * @brief   Starts the boot phase profiler.
+ * @details Called from the reset handler after the C runtime initialization,
+ *          before main(). Starts the SysTick timer as a free running clock
+ *          for the boot phases until the timer module is initialized.
+ *****************************************************************************/
+void Board_Startup(void);
+
+
 /*!***************************************************************************
  * @brief   Initializes the board and its peripherals.
  * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
@@ -59,6 +59,9 @@ __attribute__((__section__(".user_data"))) const volatile uint8_t userConfig[FLA
 #define FLASH_SECTOR_ADDRESS(index) \
     (((uint32_t)(FLASH_SECTOR_0_ADDRESS)) + ((index) * (FLASH_BLOCK_SIZE)) )
 
+/*! The value of an erased flash word. */
+#define FLASH_ERASED_WORD 0xFFFFFFFFU
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -73,6 +76,12 @@ static volatile bool isInitialized = false;
 /*! @brief Flash driver Structure */
 static flash_config_t s_flashDriver;
 
+/*! The sector buffer for read-modify-write operations. */
+static uint32_t mySector[FLASH_BLOCK_SIZE / sizeof(uint32_t)];
+
+/*! The statistics of the flash operations. */
+static flash_stats_t myStats = { 0 };
+
 
 /*******************************************************************************
  * Code
@@ -102,27 +111,80 @@ status_t Flash_Init(void)
     return STATUS_OK;
 }
 
-static status_t Flash_EraseSector(uint32_t index)
+static inline uint32_t Flash_GetTicks(void)
+{
+    /* The PIT lifetime timer counts down at the bus clock. */
+    return PIT->CHANNEL[0].CVAL;
+}
+
+static status_t Flash_Command(bool erase, uint32_t address, uint32_t data)
+{
+    /* The code and the interrupt service routines do not fit into the first
+     * program flash block, i.e. they are partly located in the block of the
+     * user flash that cannot be read while a command is active. Thus the
+     * interrupts are locked per command and the flash driver waits for the
+     * command completion from RAM. Note that this is the whole erase time
+     * (milliseconds) for a sector erase. */
+    IRQ_LOCK();
+    const uint32_t start = Flash_GetTicks();
+
+    status_t status = erase
+            ? FLASH_Erase(&s_flashDriver, address, FLASH_BLOCK_SIZE, kFLASH_ApiEraseKey)
+            : FLASH_Program(&s_flashDriver, address, &data, sizeof(data));
+
+    const uint32_t end = Flash_GetTicks();
+    IRQ_UNLOCK();
+
+    /* Down counter w/ reload at LDVAL. */
+    const uint32_t ticks = start >= end ? start - end : start + PIT->CHANNEL[0].LDVAL + 1U - end;
+    if (erase)
+    {
+        if (ticks > myStats.MaxEraseLockTicks) myStats.MaxEraseLockTicks = ticks;
+        myStats.Erases++;
+    }
+    else
+    {
+        if (ticks > myStats.MaxProgramLockTicks) myStats.MaxProgramLockTicks = ticks;
+    }
+    myStats.Commands++;
+
+    return status < STATUS_OK ? ERROR_FAIL : STATUS_OK;
+}
+
+static status_t Flash_Run(uint32_t index, bool erase, uint32_t const * data,
+                          uint32_t offset, uint32_t size)
 {
     assert(isInitialized);
 
-    /* Erase the flash sector.  */
-    status_t status = FLASH_Erase(
-            &s_flashDriver,
-            FLASH_SECTOR_ADDRESS(index),
-            FLASH_BLOCK_SIZE,
-            kFLASH_ApiEraseKey);
-    if(status < STATUS_OK) return status;
+    const uint32_t sector = FLASH_SECTOR_ADDRESS(index);
+    uint32_t const volatile * flash = (uint32_t const volatile *)(sector + offset);
 
-    /* Verify erased sector */
-    status = FLASH_VerifyErase(
-            &s_flashDriver,
-            FLASH_SECTOR_ADDRESS(index),
-            FLASH_BLOCK_SIZE,
-            kFLASH_MarginValueUser);
-    if(status < STATUS_OK) return status;
+    if (erase)
+    {
+        status_t status = Flash_Command(true, sector, 0);
+        if (status < STATUS_OK) return status;
+
+        /* Verify the erased sector. */
+        uint32_t const volatile * word = (uint32_t const volatile *)sector;
+        for (uint32_t i = 0; i < FLASH_BLOCK_SIZE / sizeof(uint32_t); ++i)
+        {
+            if (word[i] != FLASH_ERASED_WORD) return ERROR_FAIL;
+        }
+    }
 
-    return status;
+    /* Program and verify the words; erased words do not need to be programmed. */
+    for (uint32_t i = 0; i < size / sizeof(uint32_t); ++i)
+    {
+        if (data[i] != FLASH_ERASED_WORD)
+        {
+            status_t status = Flash_Command(false, (uint32_t)&flash[i], data[i]);
+            if (status < STATUS_OK) return status;
+        }
+
+        if (flash[i] != data[i]) return ERROR_FAIL;
+    }
+
+    return STATUS_OK;
 }
 
 status_t Flash_Read(uint32_t index, uint32_t offset,
@@ -149,49 +211,38 @@ status_t Flash_Write(uint32_t index, uint32_t offset,
     if (offset + size > FLASH_BLOCK_SIZE)
         return ERROR_OUT_OF_RANGE;
 
-    IRQ_LOCK(); // prevent read-while-write violation
-
     /* Read the current data: */
-    uint8_t sector[FLASH_BLOCK_SIZE];
-    status_t status = Flash_Read(index, 0, sector, FLASH_BLOCK_SIZE);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
+    status_t status = Flash_Read(index, 0, (uint8_t *)mySector, FLASH_BLOCK_SIZE);
+    if (status < STATUS_OK) return status;
 
     /* Insert new data into sector: */
-    memcpy(sector + offset, data, size);
+    memcpy((uint8_t *)mySector + offset, data, size);
 
-    /* Delete current data */
-    status = Flash_EraseSector(index);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
+    /* Erase, write back and verify the sector. */
+    return Flash_Run(index, true, mySector, 0, FLASH_BLOCK_SIZE);
+}
 
-    /* Write back the data: */
-    status = FLASH_Program(&s_flashDriver, FLASH_SECTOR_ADDRESS(index),
-                           (uint32_t*)sector, FLASH_BLOCK_SIZE);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
+status_t Flash_Program(uint32_t index, uint32_t offset,
+                       uint8_t const * data, uint32_t size)
+{
+    assert(isInitialized);
 
-    /* Verify the program process */
-    uint32_t failAddr, failDat;
-    status = FLASH_VerifyProgram(&s_flashDriver, FLASH_SECTOR_ADDRESS(index), FLASH_BLOCK_SIZE,
-            (const uint32_t *)sector, kFLASH_MarginValueUser, &failAddr, &failDat);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
+    if (data == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+    if (((uint32_t)data | offset | size) & 0x03U) return ERROR_INVALID_ARGUMENT;
+    if (index >= FLASH_BLOCK_COUNT || offset + size > FLASH_BLOCK_SIZE)
+        return ERROR_OUT_OF_RANGE;
 
-    IRQ_UNLOCK();
-    return status;
+    return Flash_Run(index, false, (uint32_t const *)data, offset, size);
+}
+
+status_t Flash_Erase(uint32_t index)
+{
+    assert(isInitialized);
+
+    if (index >= FLASH_BLOCK_COUNT) return ERROR_OUT_OF_RANGE;
+
+    return Flash_Run(index, true, mySector, 0, 0);
 }
 
 status_t Flash_Clear(uint32_t index, uint32_t offset, uint32_t size)
@@ -202,52 +253,15 @@ status_t Flash_Clear(uint32_t index, uint32_t offset, uint32_t size)
     if (offset + size > FLASH_BLOCK_SIZE)
         return ERROR_OUT_OF_RANGE;
 
-    IRQ_LOCK(); // prevent read-while-write violation
-
     /* Read the current data: */
-    uint8_t sector[FLASH_BLOCK_SIZE];
-
-    status_t status = Flash_Read(index, 0, sector, FLASH_BLOCK_SIZE);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
+    status_t status = Flash_Read(index, 0, (uint8_t *)mySector, FLASH_BLOCK_SIZE);
+    if (status < STATUS_OK) return status;
 
     /* Clear data from sector: */
-    memset(sector + offset, 0, size);
+    memset((uint8_t *)mySector + offset, 0, size);
 
-    /* Delete current data */
-    status = Flash_EraseSector(index);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
-
-    /* Write back the data: */
-    status = FLASH_Program(&s_flashDriver, FLASH_SECTOR_ADDRESS(index),
-                           (uint32_t*)sector,
-                           FLASH_BLOCK_SIZE);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
-
-    /* Verify the program process */
-    uint32_t failAddr, failDat;
-    status = FLASH_VerifyProgram(&s_flashDriver, FLASH_SECTOR_ADDRESS(index), FLASH_BLOCK_SIZE,
-                                 (const uint32_t*)sector,
-                                 kFLASH_MarginValueUser, &failAddr, &failDat);
-    if (status < STATUS_OK)
-    {
-        IRQ_UNLOCK();
-        return status;
-    }
-
-    IRQ_UNLOCK();
-    return status;
+    /* Erase, write back and verify the sector. */
+    return Flash_Run(index, true, mySector, 0, FLASH_BLOCK_SIZE);
 }
 
 status_t Flash_ClearAll(void)
@@ -262,3 +276,17 @@ status_t Flash_ClearAll(void)
     }
     return status;
 }
+
+void Flash_GetStats(flash_stats_t * stats)
+{
+    assert(stats != 0);
+
+    IRQ_LOCK();
+    *stats = myStats;
+    IRQ_UNLOCK();
+
+    /* Convert the bus clock ticks to microseconds. */
+    const uint32_t ticksPerUSec = (PIT->CHANNEL[0].LDVAL + 1U) / 1000000U;
+    stats->MaxEraseLockTime = ticksPerUSec ? (stats->MaxEraseLockTicks + ticksPerUSec - 1U) / ticksPerUSec : 0;
+    stats->MaxProgramLockTime = ticksPerUSec ? (stats->MaxProgramLockTicks + ticksPerUSec - 1U) / ticksPerUSec : 0;
+}
@@ -46,11 +46,26 @@
  * @details     This module provides an interface to the device flash memory.
  *              It control the read and write of data from/to the non-volatile
  *              flash memory.
+ *
+ *              The flash commands (sector erase and long word programming)
+ *              are executed one by one with the interrupts locked since the
+ *              code is partly located in the program flash block of the user
+ *              flash that is not readable while a command is active. The
+ *              interrupts are enabled between the commands.
+ *
+ * @warning     A sector erase locks the interrupts for the whole erase time,
+ *              i.e. for milliseconds. UART bytes received meanwhile are lost
+ *              (#ERROR_UART_RX_OVERRUN) and measurement ready IRQs are
+ *              delayed. Only the long word programming is short enough to
+ *              not interfere with the communication. Flash writes, clears
+ *              and the garbage collection of the NVM record log erase
+ *              sectors; see #Flash_GetStats for the measured lock times.
  * @addtogroup  flash
  * @{
  *****************************************************************************/
 
 #include "nvm.h"
+#include "board/board_config.h"
 #include "utility/status.h"
 
 /*******************************************************************************
@@ -60,49 +75,69 @@
 /*! The size of a single (virtual) flash sector. */
 #define FLASH_BLOCK_SIZE 0x400
 
-/*! The number of flash sectors. */
-#define FLASH_BLOCK_COUNT 5
+/*! The number of devices whose NVM data (see #argus_nvm) is stored in the flash;
+ *  a record of #ARGUS_NVM_BLOCK_SIZE bytes occupies a whole flash sector.
+ *  Defaults to the number of S2PI slaves, at least 3 (the capacity of the
+ *  slot format of earlier firmware). */
+#ifndef FLASH_API_DEVICE_COUNT
+#if S2PI_SLAVE_COUNT > 3
+#define FLASH_API_DEVICE_COUNT S2PI_SLAVE_COUNT
+#else
+#define FLASH_API_DEVICE_COUNT 3
+#endif
+#endif
+
+/*! The number of flash blocks dedicated to the non-volatile memory module of the AFBR-S50 API;
+ *  the record log requires a spare block for the garbage collection (see #nvm_log). */
+#define FLASH_API_BLOCK_COUNT (FLASH_API_DEVICE_COUNT + 1)
+
+/*! The number of flash sectors; the USER_DATA_FLASH region of the project
+ *  must have the same size (0x1400 for 3, 0x2000 for 6 devices). */
+#define FLASH_BLOCK_COUNT (FLASH_API_BLOCK_COUNT + 1)
 
 /*! The total size in bytes of all flash sectors. */
 #define FLASH_TOTAL_SIZE (FLASH_BLOCK_COUNT * FLASH_BLOCK_SIZE)
 
-/*! The flash block index dedicated for the configuration data. */
-#define FLASH_EXPL_CFG_INDEX 0
-
-/*! The flash block index dedicated for the calibration data. */
-#define FLASH_EXPL_CAL_INDEX 1
+/*! The flash block index dedicated for the configuration data; located at
+ *  the 5th block from the end of the flash memory like in earlier firmware. */
+#define FLASH_EXPL_CFG_INDEX (FLASH_BLOCK_COUNT - 5)
 
-/*! A flash block index dedicated to the non-volatile memory module of the AFBR-S50 API. */
-#define FLASH_API_BLOCK_INDEX 2
-
-/*! The number of flash blocks dedicated to the non-volatile memory module of the AFBR-S50 API. */
-#define FLASH_API_BLOCK_COUNT 3
+/*! The flash block index of the block \p n of the non-volatile memory module
+ *  of the AFBR-S50 API. The first four blocks are located above the
+ *  configuration block (the layout of earlier firmware), further blocks
+ *  below. */
+#define FLASH_API_BLOCK_INDEX(n) \
+    ((n) < 4U ? FLASH_EXPL_CFG_INDEX + 1U + (n) : (n) - 4U)
 
 /*! The size in bytes of the non-volatile memory module if the AFBR-S50 API. */
 #define FLASH_API_BLOCK_SIZE (FLASH_API_BLOCK_COUNT * FLASH_BLOCK_SIZE)
 
-/*! The size of the flash header. */
-#define NVM_HEADER_SIZE 16
+/*! The statistics of the flash operations. */
+typedef struct flash_stats_t
+{
+    /*! The number of launched flash commands. */
+    uint32_t Commands;
+
+    /*! The number of sector erase commands. */
+    uint32_t Erases;
 
-/*! The index position of the software version number in the NVM. */
-#define NVM_VERSION_IDX 0
+    /*! The maximum time in bus clock ticks the interrupts have been locked
+     *  for a sector erase. */
+    uint32_t MaxEraseLockTicks;
 
-/*! The index position of the chip ID in the NVM. */
-#define NVM_CHIP_ID_IDX 4
+    /*! The maximum time in microseconds the interrupts have been locked
+     *  for a sector erase. */
+    uint32_t MaxEraseLockTime;
 
-/*! The index position of the slot count value in the NVM. */
-#define NVM_SLOT_COUNT_IDX 8
+    /*! The maximum time in bus clock ticks the interrupts have been locked
+     *  for a long word program. */
+    uint32_t MaxProgramLockTicks;
 
-/*! Gets a 32-bit value from the NVM memory buffer \p buf at index position \p idx. */
-#define NVM_GET32(buf, idx) \
-    (uint32_t)(((buf)[idx] << 24) | ((buf)[(idx)+1] << 16) | ((buf)[(idx)+2] <<  8) | ((buf)[(idx)+3]))
+    /*! The maximum time in microseconds the interrupts have been locked
+     *  for a long word program. */
+    uint32_t MaxProgramLockTime;
 
-/*! Sets a 32-bit value (\p val) at index position \p idx to the NVM memory buffer \p buf. */
-#define NVM_SET32(buf, idx, val) do { \
-    for (uint32_t i = 0; i < 4; ++i) { \
-        uint8_t v = val >> (24 - 8 * i); \
-        if (buf[idx + i] != v) { buf[idx + i] = v; } \
-    } } while (0)
+} flash_stats_t;
 
 /*******************************************************************************
  * Prototypes
@@ -138,6 +173,29 @@ status_t Flash_Read(uint32_t index, uint32_t offset,
 status_t Flash_Write(uint32_t index, uint32_t offset,
                      uint8_t const * data, uint32_t size);
 
+/*!*****************************************************************************
+ * @brief   Programs data to an erased area of a specified flash sector.
+ * @details In contrast to #Flash_Write, the sector is not erased before, i.e.
+ *          only erased bits can be programmed. This is used for appending
+ *          data to a sector w/o rewriting it.
+ * @param   index The flash sector index from the end of memory.
+ * @param   offset The start address relative to the sector start;
+ *                 a multiple of 4.
+ * @param   data Pointer to the word aligned source data buffer.
+ * @param   size The size of data to be programmed; a multiple of 4.
+ *                Maximum is #FLASH_BLOCK_SIZE - offset.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Program(uint32_t index, uint32_t offset,
+                       uint8_t const * data, uint32_t size);
+
+/*!*****************************************************************************
+ * @brief   Erases a specified flash sector, i.e. sets all bytes to 0xFF.
+ * @param   index The flash sector index from the end of memory.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t Flash_Erase(uint32_t index);
+
 /*!*****************************************************************************
  * @brief   Clears flash with zeros from a specified flash sector.
  * @param   index The flash sector index from the end of memory.
@@ -154,5 +212,15 @@ status_t Flash_Clear(uint32_t index, uint32_t offset, uint32_t size);
  *****************************************************************************/
 status_t Flash_ClearAll(void);
 
+/*!*****************************************************************************
+ * @brief   Obtains the statistics of the flash operations.
+ * @details The maximum interrupt locked times are measured with the lifetime
+ *          counter of the timer module, i.e. it requires #Timer_Init. The
+ *          sector erases and the long word programs are reported separately
+ *          since an erase locks the interrupts for milliseconds.
+ * @param   stats The returned statistics.
+ *****************************************************************************/
+void Flash_GetStats(flash_stats_t * stats);
+
 /*! @} */
 #endif /* FLASH_H */
@@ -372,6 +372,17 @@ uint32_t GPIO_ReadPinInput(gpio_pin_t pin)
     return ((pin->base)->PDIR >> pin->pin) & 1U;
 }
 
+void GPIO_GetFastPin(gpio_pin_t pin, gpio_fast_pin_t * fast)
+{
+    /* The IOPORT aliases of the GPIO ports have the same layout and order. */
+    FGPIO_Type * base = (FGPIO_Type *)(FGPIOA_BASE + ((uint32_t)pin->base - GPIOA_BASE));
+    fast->PSOR = &base->PSOR;
+    fast->PCOR = &base->PCOR;
+    fast->PDIR = &base->PDIR;
+    fast->Mask = pin->mask;
+    fast->Shift = pin->pin;
+}
+
 uint32_t GPIO_GetInterruptStatus(gpio_pin_t pin)
 {
     return (PORT_GetPinsInterruptFlags(pin->port) >> pin->pin) & 1U;
@@ -187,6 +187,61 @@ uint32_t GPIO_ReadPinInput(gpio_pin_t pin);
  *****************************************************************************/
 uint32_t GPIO_GetInterruptStatus(gpio_pin_t pin);
 
+/*!***************************************************************************
+ * @brief   Direct register access to a single GPIO pin.
+ *
+ * @details Holds the set, clear and input registers of the pin on the single
+ *          cycle IOPORT interface (FGPIO) of the Cortex-M0+ core. Obtained via
+ *          #GPIO_GetFastPin and used by the GPIO_Fast* functions in order to
+ *          avoid the peripheral bridge wait states and the function call
+ *          overhead in bit-banging loops.
+ *****************************************************************************/
+typedef struct gpio_fast_pin_t
+{
+    /*! The port set output register. */
+    volatile uint32_t * PSOR;
+
+    /*! The port clear output register. */
+    volatile uint32_t * PCOR;
+
+    /*! The port data input register. */
+    volatile uint32_t const * PDIR;
+
+    /*! The pin mask. */
+    uint32_t Mask;
+
+    /*! The pin number, i.e. the shift of the pin in the input register. */
+    uint32_t Shift;
+
+} gpio_fast_pin_t;
+
+/*!***************************************************************************
+ * @brief   Obtains the direct (IOPORT) register access for a GPIO pin.
+ * @param   pin The address of the GPIO pin.
+ * @param   fast The fast pin structure to be filled.
+ *****************************************************************************/
+void GPIO_GetFastPin(gpio_pin_t pin, gpio_fast_pin_t * fast);
+
+/*!***************************************************************************
+ * @brief   Writes the output of a fast GPIO pin.
+ * @param   pin The fast GPIO pin obtained via #GPIO_GetFastPin.
+ * @param   value==0: clear pin; !=0: set pin.
+ *****************************************************************************/
+static inline void GPIO_FastWritePinOutput(gpio_fast_pin_t const * pin, uint32_t value)
+{
+    *(value ? pin->PSOR : pin->PCOR) = pin->Mask;
+}
+
+/*!***************************************************************************
+ * @brief   Reads the input of a fast GPIO pin.
+ * @param   pin The fast GPIO pin obtained via #GPIO_GetFastPin.
+ * @return  0 for low level, 1 for high level input signal.
+ *****************************************************************************/
+static inline uint32_t GPIO_FastReadPinInput(gpio_fast_pin_t const * pin)
+{
+    return (*pin->PDIR >> pin->Shift) & 1U;
+}
+
 /*!***************************************************************************
  * @brief   Sets the direction (input/output) of an GPIO pin.
  * @param   pin The address of the GPIO pin.
@@ -39,211 +39,222 @@
  ******************************************************************************/
 #include "nvm.h"
 #include "driver/flash.h"
+#include "nvm_log.h"
+#include "boot_profile.h"
 #include "argus.h"
 
+#include <string.h>
+
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
 
+/*! The slot format of earlier firmware: three slots of a 16 byte header
+ *  (version, chip ID and slot count; big endian) and the data that are
+ *  packed into the blocks 1 to 3 of the API region. */
+#define NVM_LEGACY_SLOT_COUNT 3U
+
+/*! The first block of the slots of earlier firmware. */
+#define NVM_LEGACY_SECTOR 1U
+
+/*! The size of a slot header of earlier firmware. */
+#define NVM_LEGACY_HEADER_SIZE 16U
 
+/*! The size of a slot of earlier firmware. */
+#define NVM_LEGACY_SLOT_SIZE (NVM_LEGACY_HEADER_SIZE + ARGUS_NVM_BLOCK_SIZE)
+
+/*! Gets a big endian 32-bit value from the buffer \p buf at index \p idx. */
+#define NVM_LEGACY_GET32(buf, idx) \
+    (((uint32_t)(buf)[idx] << 24) | ((uint32_t)(buf)[(idx)+1] << 16) | \
+     ((uint32_t)(buf)[(idx)+2] << 8) | ((uint32_t)(buf)[(idx)+3]))
 
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
-static status_t NVM_Write(uint32_t offset, uint32_t size, uint8_t const * buf);
-static status_t NVM_Read(uint32_t offset, uint32_t size, uint8_t * buf);
+static status_t NVM_FlashRead(uint32_t sector, uint32_t offset, uint8_t * data, uint32_t size);
+static status_t NVM_FlashProgram(uint32_t sector, uint32_t offset, uint8_t const * data, uint32_t size);
+static status_t NVM_FlashErase(uint32_t sector);
 
 /******************************************************************************
  * Variables
  ******************************************************************************/
 
+/*! The flash blocks of the AFBR-S50 API that hold the NVM record log;
+ *  the version is set at #NVM_Init. */
+static nvm_log_flash_t myFlash =
+{
+    .SectorSize = FLASH_BLOCK_SIZE,
+    .SectorCount = FLASH_API_BLOCK_COUNT,
+    .Read = NVM_FlashRead,
+    .Program = NVM_FlashProgram,
+    .Erase = NVM_FlashErase,
+};
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
-status_t NVM_WriteBlock(uint32_t device_id, uint32_t block_size, uint8_t const * buf)
+static status_t NVM_FlashRead(uint32_t sector, uint32_t offset, uint8_t * data, uint32_t size)
 {
-    assert(buf != 0);
-    if (device_id == 0) return ERROR_INVALID_ARGUMENT;
-    if (block_size == 0) return ERROR_INVALID_ARGUMENT;
-
-    /* Find empty slot or the one which is already used with the device.
-     *
-     *  - Each slot has a counter, version and device id written as identifier.
-     *  - If version is not the current, the slot is considered to be empty (or invalid due to out-dated version).
-     *  - If all slots are occupied, the oldest slot is used, determined by a counter.
-     *  - Each write to a slot increments a counter value to determine the oldest slot
-     *    (i.e. the one with the lowest counter value.)
-     *  */
-
-    int32_t slot_idx = -1;              // the index of the newest slot
-    int32_t oldest_idx = -1;            // the index of the oldest slot
-    uint32_t slot_count = 0;            // current slot count; must be increase if < max_count
-    uint32_t max_count = 0;             // max count of all slots; determines the newest slot
-    uint32_t min_count = UINT32_MAX;    // min count of all slots; determines the oldest slot;
-    uint8_t header[NVM_HEADER_SIZE] = { 0 };
-
-    const uint32_t slot_size = block_size + NVM_HEADER_SIZE;
-    for (uint32_t offset = 0; offset <= FLASH_API_BLOCK_SIZE - slot_size; offset += slot_size)
+    return Flash_Read(FLASH_API_BLOCK_INDEX(sector), offset, data, size);
+}
+
+static status_t NVM_FlashProgram(uint32_t sector, uint32_t offset, uint8_t const * data, uint32_t size)
+{
+    return Flash_Program(FLASH_API_BLOCK_INDEX(sector), offset, data, size);
+}
+
+static status_t NVM_FlashErase(uint32_t sector)
+{
+    return Flash_Erase(FLASH_API_BLOCK_INDEX(sector));
+}
+
+static status_t NVM_LegacyRead(uint32_t offset, uint8_t * data, uint32_t size)
+{
+    /* The slots span the block boundaries. */
+    while (size)
     {
-        /* Read slot header from NVM memory. */
-        status_t status = NVM_Read(offset, NVM_HEADER_SIZE, header);
+        const uint32_t sector = NVM_LEGACY_SECTOR + offset / FLASH_BLOCK_SIZE;
+        const uint32_t pos = offset % FLASH_BLOCK_SIZE;
+        uint32_t n = FLASH_BLOCK_SIZE - pos;
+        if (n > size) n = size;
+
+        status_t status = NVM_FlashRead(sector, pos, data, n);
         if (status < STATUS_OK) return status;
 
-        /* Slot empty? -> Save index as potential slot. */
-        if (NVM_GET32(header, NVM_VERSION_IDX) != Argus_GetAPIVersion())
-        {
-            if (slot_idx < 0)
-            {
-                slot_idx = offset;
-            }
-        }
-        else
-        {
-            /* Find current max. count. */
-            if (NVM_GET32(header, NVM_SLOT_COUNT_IDX) > max_count)
-            {
-                max_count = NVM_GET32(header, NVM_SLOT_COUNT_IDX);
-            }
-
-            /* Find min. count of all non-empty slots. */
-            if (NVM_GET32(header, NVM_SLOT_COUNT_IDX) <= min_count)
-            {
-                oldest_idx = offset;
-                min_count = NVM_GET32(header, NVM_SLOT_COUNT_IDX);
-            }
-
-            /* Slot already used for current device? -> Save index. */
-            if (NVM_GET32(header, NVM_CHIP_ID_IDX) == device_id)
-            {
-                slot_idx = offset;
-            }
-        }
+        offset += n;
+        data += n;
+        size -= n;
     }
+    return STATUS_OK;
+}
 
-    /* If no slot has been found -> use oldest */
-    if (slot_idx < 0)
+static status_t NVM_LegacyIsLog(uint32_t offset, bool * isLog)
+{
+    /* A slot is ignored if any of its blocks belongs to the record log. */
+    *isLog = false;
+    for (uint32_t sector = NVM_LEGACY_SECTOR + offset / FLASH_BLOCK_SIZE;
+         sector <= NVM_LEGACY_SECTOR + (offset + NVM_LEGACY_SLOT_SIZE - 1U) / FLASH_BLOCK_SIZE;
+         ++sector)
     {
-        slot_idx = oldest_idx;
+        uint32_t magic = 0;
+        status_t status = NVM_FlashRead(sector, 0, (uint8_t *)&magic, sizeof(magic));
+        if (status < STATUS_OK) return status;
+        if (magic == NVM_LOG_SECTOR_MAGIC) *isLog = true;
     }
+    return STATUS_OK;
+}
+
+/*! The valid slots of earlier firmware, i.e. the newest slot per device. */
+typedef struct nvm_legacy_slots_t
+{
+    /*! The chip IDs of the devices. */
+    uint32_t ChipID[NVM_LEGACY_SLOT_COUNT];
 
-    /* Increase the slot count . */
-    slot_count = max_count + 1;
+    /*! The slot count values; the higher the newer. */
+    uint32_t Count[NVM_LEGACY_SLOT_COUNT];
 
-    /* Write Header */
-    NVM_SET32(header, NVM_SLOT_COUNT_IDX, slot_count);
-    NVM_SET32(header, NVM_CHIP_ID_IDX, device_id);
-    NVM_SET32(header, NVM_VERSION_IDX, Argus_GetAPIVersion());
-    status_t status = NVM_Write(slot_idx, NVM_HEADER_SIZE, header);
-    if (status < STATUS_OK) return status;
+    /*! The slot indices. */
+    uint32_t Slot[NVM_LEGACY_SLOT_COUNT];
 
-    /* Write Data. */
-    return NVM_Write(slot_idx + NVM_HEADER_SIZE, block_size, buf);
-}
+    /*! The number of devices. */
+    uint32_t Devices;
+
+} nvm_legacy_slots_t;
 
-static status_t NVM_Write(uint32_t offset, uint32_t size, uint8_t const * buf)
+static status_t NVM_ScanLegacySlots(nvm_legacy_slots_t * slots)
 {
-    if (offset + size > FLASH_API_BLOCK_SIZE)
-        return ERROR_NVM_OUT_OF_RANGE;
+    memset(slots, 0, sizeof(nvm_legacy_slots_t));
 
-    status_t status = STATUS_OK;
-    uint32_t idx = FLASH_API_BLOCK_INDEX;
-    while (offset >= FLASH_BLOCK_SIZE)
+    for (uint32_t i = 0; i < NVM_LEGACY_SLOT_COUNT; ++i)
     {
-        idx++;
-        offset -= FLASH_BLOCK_SIZE;
-    }
+        const uint32_t offset = i * NVM_LEGACY_SLOT_SIZE;
 
-    while (size)
-    {
-        uint32_t size2 = size;
-        if (offset + size > FLASH_BLOCK_SIZE)
-            size2 = FLASH_BLOCK_SIZE - offset;
+        bool isLog = false;
+        status_t status = NVM_LegacyIsLog(offset, &isLog);
+        if (status < STATUS_OK) return status;
+        if (isLog) continue;
 
-        status = Flash_Write(idx, offset, buf, size2);
+        uint8_t header[NVM_LEGACY_HEADER_SIZE];
+        status = NVM_LegacyRead(offset, header, sizeof(header));
         if (status < STATUS_OK) return status;
 
-        size -= size2;
-        buf += size2;
-        offset = 0;
-        idx++;
+        /* Slots of other API versions have been considered to be empty. */
+        const uint32_t id = NVM_LEGACY_GET32(header, 4);
+        const uint32_t count = NVM_LEGACY_GET32(header, 8);
+        if (NVM_LEGACY_GET32(header, 0) != myFlash.Version || id == 0 || id == 0xFFFFFFFFU)
+            continue;
+
+        /* Keep the newest slot per device. */
+        uint32_t k = 0;
+        while (k < slots->Devices && slots->ChipID[k] != id) k++;
+        if (k < slots->Devices && slots->Count[k] >= count) continue;
+        if (k == slots->Devices) slots->Devices++;
+
+        slots->ChipID[k] = id;
+        slots->Count[k] = count;
+        slots->Slot[k] = i;
     }
-
-    return status;
+    return STATUS_OK;
 }
 
-status_t NVM_ReadBlock(uint32_t device_id, uint32_t block_size, uint8_t * buf)
+static __attribute__((noinline)) status_t NVM_ImportLegacySlots(nvm_legacy_slots_t const * slots)
 {
-    assert(buf != 0);
-    if (device_id == 0) return ERROR_INVALID_ARGUMENT;
-    if (block_size == 0) return ERROR_INVALID_ARGUMENT;
+    /* The data is buffered since mounting the log erases the slots; this
+     * happens only once after an update from earlier firmware. A power
+     * failure before all slots are imported loses the erased ones. */
+    uint32_t data[NVM_LEGACY_SLOT_COUNT][ARGUS_NVM_BLOCK_SIZE / sizeof(uint32_t)];
 
-    status_t status = STATUS_OK;
-
-    /* Read Non-Volatile memory from the platform. */
-    const uint32_t slot_size = block_size + NVM_HEADER_SIZE;
-    for (uint32_t offset = 0; offset <= FLASH_API_BLOCK_SIZE - slot_size; offset += slot_size)
+    for (uint32_t k = 0; k < slots->Devices; ++k)
     {
-        /* Read slot header from NVM memory. */
-        uint8_t header[NVM_HEADER_SIZE] = { 0 };
-        status = NVM_Read(offset, NVM_HEADER_SIZE, header);
-        if (status < STATUS_OK) break;
-
-        /* API Version and Device ID */
-        if (NVM_GET32(header, NVM_VERSION_IDX) == Argus_GetAPIVersion() &&
-            NVM_GET32(header, NVM_CHIP_ID_IDX) == device_id)
-        {
-            status = NVM_Read(offset + NVM_HEADER_SIZE, block_size, buf);
-            if (status < STATUS_OK) break;
-
-            return STATUS_OK;
-        }
-
-        status = ERROR_NVM_EMPTY;
+        status_t status = NVM_LegacyRead(slots->Slot[k] * NVM_LEGACY_SLOT_SIZE + NVM_LEGACY_HEADER_SIZE,
+                                         (uint8_t *)data[k], ARGUS_NVM_BLOCK_SIZE);
+        if (status < STATUS_OK) return status;
     }
 
-    /* Reset buffer in case of any error. */
-    memset(buf, 0, block_size);
-    return status;
-}
-
-static status_t NVM_Read(uint32_t offset, uint32_t size, uint8_t * buf)
-{
-    if (offset + size > FLASH_API_BLOCK_SIZE)
-        return ERROR_NVM_OUT_OF_RANGE;
+    status_t status = NVMLog_Init(&myFlash);
+    if (status < STATUS_OK) return status;
 
-    status_t status = STATUS_OK;
-    uint32_t idx = FLASH_API_BLOCK_INDEX;
-    while (offset >= FLASH_BLOCK_SIZE)
+    /* Devices already in the log have been imported before a power failure
+     * or have been updated since; a remaining slot must not override them. */
+    for (uint32_t k = 0; k < slots->Devices; ++k)
     {
-        idx++;
-        offset -= FLASH_BLOCK_SIZE;
+        if (NVMLog_Contains(slots->ChipID[k])) continue;
+
+        status = NVMLog_Write(slots->ChipID[k], ARGUS_NVM_BLOCK_SIZE, (uint8_t const *)data[k]);
+        if (status < STATUS_OK) return status;
     }
+    return STATUS_OK;
+}
 
-    while (size)
-    {
-        uint32_t size2 = size;
-        if (offset + size > FLASH_BLOCK_SIZE)
-            size2 = FLASH_BLOCK_SIZE - offset;
+status_t NVM_Init(void)
+{
+    /* Records of other API versions are considered to be empty. */
+    myFlash.Version = Argus_GetAPIVersion();
 
-        status = Flash_Read(idx, offset, buf, size2);
-        if (status < STATUS_OK) return status;
+    /* Import the slots of earlier firmware before the log erases them. */
+    nvm_legacy_slots_t slots;
+    status_t status = NVM_ScanLegacySlots(&slots);
+    if (status < STATUS_OK) return status;
+    if (slots.Devices > 0) return NVM_ImportLegacySlots(&slots);
 
-        size -= size2;
-        buf += size2;
-        offset = 0;
-        idx++;
-    }
+    return NVMLog_Init(&myFlash);
+}
+
+status_t NVM_WriteBlock(uint32_t device_id, uint32_t block_size, uint8_t const * buf)
+{
+    return NVMLog_Write(device_id, block_size, buf);
+}
 
+status_t NVM_ReadBlock(uint32_t device_id, uint32_t block_size, uint8_t * buf)
+{
+    const int32_t phase = BootProfile_Begin(BOOT_PHASE_NVM_READ, (uint8_t)device_id);
+    status_t status = NVMLog_Read(device_id, block_size, buf);
+    BootProfile_End(phase);
     return status;
 }
 
 status_t NVM_Clear(void)
 {
-    for (uint32_t idx = FLASH_API_BLOCK_INDEX; idx < FLASH_API_BLOCK_INDEX + FLASH_API_BLOCK_COUNT; idx++)
-    {
-        status_t status = Flash_Clear(idx, 0, FLASH_BLOCK_SIZE);
-        if (status < STATUS_OK) return status;
-    }
-    return STATUS_OK;
+    return NVMLog_Format();
 }
@@ -54,5 +54,24 @@
 
 #include "platform/argus_nvm.h"
 
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Initializes the non-volatile memory module.
+ * @details Mounts the record log (see #nvm_log) on the flash blocks of the
+ *          AFBR-S50 API, i.e. builds the RAM directory of the latest records.
+ *          Requires the flash module to be initialized (#Flash_Init).
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVM_Init(void);
+
+/*!***************************************************************************
+ * @brief   Erases all data of the non-volatile memory module.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVM_Clear(void);
+
 /*! @} */
 #endif /* NVM_H */
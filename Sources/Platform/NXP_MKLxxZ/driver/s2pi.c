@@ -46,6 +46,8 @@
 #include "driver/gpio.h"
 #include "driver/irq.h"
 #include "driver/fsl_clock.h"
+#include "s2pi_queue.h"
+#include "s2pi_trace.h"
 
 /*******************************************************************************
  * Definitions
@@ -102,29 +104,59 @@
  *****************************************************************************/
 #define S2PI_LOGGING 0
 
+/*!***************************************************************************
+ * @brief   Enables the binary S2PI transfer trace, see #S2PITrace_Begin.
+ * @details Other than #S2PI_LOGGING, the trace takes two clock reads per
+ *          transfer and can be left enabled.
+ *****************************************************************************/
+#ifndef S2PI_TRACE
+#define S2PI_TRACE 1
+#endif
+
 /*! Pin muxing for disable state. */
 #define S2PI_PIN_MUX_DISABLED 0
 
 
-typedef struct s2pi_instance_t
+/*! The configuration of a single S2PI slave. */
+typedef struct s2pi_slave_config_t
 {
     /*! The actual SPI baud rate in bps. */
     uint32_t BaudRate;
 
-    /*! The used SPI hardware instance. */
-    SPI_Type * SPI;
+    /*! The corresponding value of the SPI baud rate register. */
+    uint8_t BR;
 
-} s2pi_instance_t;
+} s2pi_slave_config_t;
 
-//static const s2pi_slave_hnd_t mySlaves[S2PI_SLAVE_COUNT + 1];
+/*! The number of SPI hardware instances. */
+#if defined(CPU_MKL17Z256VFM4)
+#define S2PI_INSTANCE_COUNT 1U
+#else
+#define S2PI_INSTANCE_COUNT 2U
+#endif
 
-/*! A structure to hold all internal data required by the S2PI module. */
-typedef struct s2pi_hnd_t
+/*! Determines whether all SPI instances share a single pair of DMA channels.
+ *  If so, the DMA transfers are serialized, i.e. only a single instance may
+ *  transfer data at a time. The GPIO mode and CS cycling are still executed
+ *  independently on each instance. */
+#if defined(CPU_MKL17Z256VFM4)
+#define S2PI_SHARED_DMA 0
+#else
+#define S2PI_SHARED_DMA (DMA_CHANNEL_SPI0_TX == DMA_CHANNEL_SPI1_TX)
+#if !S2PI_SHARED_DMA && ((DMA_CHANNEL_SPI0_RX == DMA_CHANNEL_SPI1_RX) || \
+                         (DMA_CHANNEL_SPI0_TX == DMA_CHANNEL_SPI1_RX) || \
+                         (DMA_CHANNEL_SPI0_RX == DMA_CHANNEL_SPI1_TX))
+#error SPI0 and SPI1 must either share both DMA channels or use distinct ones!
+#endif
+#endif
+
+/*! A structure to hold all internal data of a single SPI hardware instance. */
+typedef struct s2pi_instance_t
 {
-    /*! Determines the current driver status. */
+    /*! Determines the current instance status. */
     volatile status_t Status;
 
-    /*! Determines the current S2PI slave. */
+    /*! Determines the current S2PI slave of the instance. */
     volatile s2pi_slave_t Slave;
 
     /*! A callback function to be called after transfer/run mode is completed. */
@@ -133,33 +165,114 @@ typedef struct s2pi_hnd_t
     /*! A parameter to be passed to the callback function. */
     void * CallbackParam;
 
+    /*! The actual SPI baud rate in bps. */
+    uint32_t BaudRate;
+
+    /*! The used SPI hardware instance. */
+    SPI_Type * SPI;
+
+    /*! The DMA channel for the SPI transmitter. */
+    uint32_t DmaTx;
+
+    /*! The DMA channel for the SPI receiver. */
+    uint32_t DmaRx;
+
+    /*! The DMAMUX request source of the SPI transmitter. */
+    uint8_t DmaTxSource;
+
+    /*! The DMAMUX request source of the SPI receiver. */
+    uint8_t DmaRxSource;
+
     /*! Dummy variable for unused Rx data. */
     uint8_t RxSink;
 
+    /*! The bit mask of the S2PI slaves connected to the instance. */
+    uint32_t SlaveMask;
+
+    /*! The slave that has captured the GPIO mode, i.e. the one the cached
+     *  #GpioPins belong to. */
+    s2pi_slave_t GpioSlave;
+
+    /*! The direct register access of the pins of the #GpioSlave. */
+    gpio_fast_pin_t GpioPins[S2PI_IRQ + 1];
+
+    /*! The number of #S2PI_GpioDelay loops for #S2PI_GPIO_DELAY_NS. */
+    uint32_t GpioDelayLoops;
+
+    /*! The identifier of the trace record of the ongoing transfer. */
+    uint32_t TraceId;
+
+} s2pi_instance_t;
+
+/*! A structure to hold all internal data required by the S2PI module. */
+typedef struct s2pi_hnd_t
+{
+    /*! The SPI hardware instances. */
+    s2pi_instance_t Instance[S2PI_INSTANCE_COUNT];
+
+#if S2PI_SHARED_DMA
+    /*! The instance the shared DMA channels are currently configured for. */
+    s2pi_instance_t * DmaInstance;
+
+    /*! Determines whether the shared DMA channels are currently in use. */
+    volatile bool DmaBusy;
+#endif
+
     /*! A mutex used for queue operations. */
     volatile bool SpiMutexBlocked;
 
-    s2pi_instance_t Instance[2];
+    /*! The individual configuration of each slave; applied whenever a
+     *  transfer to the slave is started.
+     *  Note: slave index starts with 1, so the array size needs an extra element */
+    s2pi_slave_config_t Slaves[S2PI_SLAVE_COUNT + 1];
 
 } s2pi_hnd_t;
 
+/*!***************************************************************************
+ * @brief   Determines whether the shared DMA channels are occupied by a transfer.
+ * @details Always false if the SPI instances have their own DMA channels.
+ *****************************************************************************/
+#if S2PI_SHARED_DMA
+#define S2PI_DMA_IS_BUSY() (myS2PIHnd.DmaBusy)
+#else
+#define S2PI_DMA_IS_BUSY() (false)
+#endif
 
-/*! An additional delay to be added after each GPIO access in order to decrease
- *  the baud rate of the software EEPROM protocol. Increase the delay if timing
- *  issues occur while reading the EERPOM.
- *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz */
-#ifndef S2PI_GPIO_DELAY_US
-#define S2PI_GPIO_DELAY_US 10
+/*!***************************************************************************
+ * @brief   Marks the shared DMA channels as occupied or released.
+ * @details Releasing is only done by the instance that currently owns the
+ *          shared DMA channels. No-op if the instances have their own channels.
+ *****************************************************************************/
+#if S2PI_SHARED_DMA
+#define S2PI_DMA_SET_BUSY(hnd) (myS2PIHnd.DmaBusy = true)
+#define S2PI_DMA_RELEASE(hnd) do                                \
+{                                                               \
+    if (myS2PIHnd.DmaInstance == (hnd)) myS2PIHnd.DmaBusy = false; \
+} while (0)
+#else
+#define S2PI_DMA_SET_BUSY(hnd) ((void)(hnd))
+#define S2PI_DMA_RELEASE(hnd) ((void)(hnd))
 #endif
 
 
-#if (S2PI_GPIO_DELAY_US == 0)
-#define S2PI_GPIO_DELAY() ((void)0)
+/*! An additional delay in nanoseconds to be added after each GPIO write in
+ *  order to decrease the baud rate of the software EEPROM protocol. Increase
+ *  the delay if timing issues occur while reading the EERPOM.
+ *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz
+ *  The former #S2PI_GPIO_DELAY_US setting is still considered if defined. */
+#ifndef S2PI_GPIO_DELAY_NS
+#ifdef S2PI_GPIO_DELAY_US
+#define S2PI_GPIO_DELAY_NS (S2PI_GPIO_DELAY_US * 1000U)
 #else
-#include "utility/time.h"
-#define S2PI_GPIO_DELAY() Time_DelayUSec(S2PI_GPIO_DELAY_US)
+#define S2PI_GPIO_DELAY_NS 10000U
+#endif
 #endif
 
+/*! The minimum number of core cycles of a single #S2PI_GpioDelay loop; flash
+ *  wait states can only lengthen the loop, i.e. the delay is never shorter
+ *  than specified. */
+#define S2PI_GPIO_DELAY_LOOP_CYCLES 3U
+
 
 /*******************************************************************************
  * Prototypes
@@ -169,7 +282,19 @@ typedef struct s2pi_hnd_t
 static inline s2pi_instance_t * S2PI_GetHandleFromSlave(s2pi_slave_t slave);
 
 /*! Completes the current series of SPI transfers. */
-static inline status_t S2PI_CompleteTransfer(s2pi_hnd_t * hnd, status_t status);
+static inline status_t S2PI_CompleteTransfer(s2pi_instance_t * hnd, status_t status);
+
+/*! Starts a single SPI transfer; the instance status must be busy already. */
+static status_t S2PI_StartTransfer(s2pi_instance_t * hnd,
+                                   s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData);
+
+/*! Starts the next queued SPI transfers on all idle instances. */
+static void S2PI_StartNext(void);
 
 /*! Callback for DMA Tx interrupts. */
 static void S2PI_TxDmaCallbackFunction(status_t status, void * param);
@@ -181,13 +306,16 @@ static void S2PI_RxDmaCallbackFunction(status_t status, void * param);
 static inline void S2PI_InitSpi(s2pi_instance_t * hnd, uint32_t baudRate_Bps);
 
 /*! Initializes the required pins. */
-static inline void S2PI_InitPins(SPI_Type * spi);
+static inline void S2PI_InitPins(void);
 
-/*! Sets the SPI instance. */
+/*! Configures the DMA channels for the SPI instance. */
 static inline void S2PI_SetInstance(s2pi_instance_t * instance);
 
-/*! Sets the SPI baud rate in bps. */
-static status_t S2PI_SetBaudRateIntern(s2pi_instance_t * hnd, uint32_t baudRate_Bps);
+/*! Calculates the SPI baud rate register value for a baud rate in bps. */
+static status_t S2PI_CalcBaudRate(SPI_Type const * spi, uint32_t baudRate_Bps, s2pi_slave_config_t * cfg);
+
+/*! Applies the baud rate of a slave configuration to the SPI hardware. */
+static inline void S2PI_ApplyBaudRate(s2pi_instance_t * hnd, s2pi_slave_config_t const * cfg);
 
 /*!***************************************************************************
  * @brief   Gets the specified GPIO pin of the specified S2PI slave.
@@ -197,6 +325,9 @@ static status_t S2PI_SetBaudRateIntern(s2pi_instance_t * hnd, uint32_t baudRate_
  *****************************************************************************/
 static gpio_pin_t S2PI_GetGpioPin(s2pi_slave_t slave, s2pi_pin_t pin);
 
+/*! Leaves the GPIO mode of the instance and starts the next queued transfers. */
+static status_t S2PI_ReleaseGpioInternal(s2pi_instance_t * hnd, s2pi_slave_t slave);
+
 #if defined(CPU_MKL17Z256VFM4)
 
 #define S2PI_AssertSoftwareCS(slave) ((void)0)
@@ -204,7 +335,7 @@ static gpio_pin_t S2PI_GetGpioPin(s2pi_slave_t slave, s2pi_pin_t pin);
 
 #else
 /*! Helper function to set the current S2PI slave (i.e. CS and IRQ pins). */
-static inline status_t S2PI_SetSlaveInternal(s2pi_hnd_t * hnd, s2pi_slave_t slave);
+static inline status_t S2PI_SetSlaveInternal(s2pi_instance_t * hnd, s2pi_slave_t slave);
 
 /*! Sets/asserts GPIO for Software CS to LOW state. */
 static inline void S2PI_AssertSoftwareCS(s2pi_slave_t slave);
@@ -213,6 +344,9 @@ static inline void S2PI_AssertSoftwareCS(s2pi_slave_t slave);
 static inline void S2PI_ClearSoftwareCS(s2pi_slave_t slave);
 #endif
 
+/*! Busy waits for a number of cycle counted loops. */
+static inline void S2PI_GpioDelay(uint32_t loops);
+
 
 /******************************************************************************
  * Variables
@@ -220,6 +354,9 @@ static inline void S2PI_ClearSoftwareCS(s2pi_slave_t slave);
 /*! The S2PI data handle. */
 static s2pi_hnd_t myS2PIHnd = { 0 };
 
+/*! The core clock frequency in Hz; from the system startup code. */
+extern uint32_t SystemCoreClock;
+
 #ifdef DEBUG
 static volatile bool isInitialized = false;
 #endif
@@ -304,6 +441,14 @@ static void s2pi_log_send(void)
 #define s2pi_log_setup(...) (void)0
 #define s2pi_log_send(...)  (void)0
 #endif
+
+#if S2PI_TRACE
+#define S2PI_TRACE_BEGIN(hnd, slave, size) ((hnd)->TraceId = S2PITrace_Begin(slave, size))
+#define S2PI_TRACE_END(hnd, status) S2PITrace_End((hnd)->TraceId, status)
+#else
+#define S2PI_TRACE_BEGIN(hnd, slave, size) (void)0
+#define S2PI_TRACE_END(hnd, status) (void)0
+#endif
 /*! @endcond */
 
 status_t S2PI_Init(s2pi_slave_t defaultSlave,
@@ -314,32 +459,68 @@ status_t S2PI_Init(s2pi_slave_t defaultSlave,
     GPIO_Init();
     DMA_Init();
 
-    /* Register callback for DMA interrupt */
-    DMA_SetTransferDoneCallback(DMA_CHANNEL_SPI_TX, S2PI_TxDmaCallbackFunction, &myS2PIHnd);
-    DMA_SetTransferDoneCallback(DMA_CHANNEL_SPI_RX, S2PI_RxDmaCallbackFunction, &myS2PIHnd);
-
     memset(&myS2PIHnd, 0, sizeof(myS2PIHnd));
 
+    S2PIQueue_Init();
+
 #if defined(CPU_MKL17Z256VFM4)
     (void)defaultSlave;
     assert(defaultSlave == SPI_DEFAULT_SLAVE);
 
     myS2PIHnd.Instance[0].SPI = SPI1;
-    S2PI_InitPins(myS2PIHnd.Instance[0].SPI);
-    S2PI_InitSpi(&myS2PIHnd.Instance[0], baudRate_Bps);
-    S2PI_SetInstance(&myS2PIHnd.Instance[0]);
+    myS2PIHnd.Instance[0].Slave = defaultSlave;
+    myS2PIHnd.Instance[0].SlaveMask = 1U << SPI_DEFAULT_SLAVE;
+    myS2PIHnd.Instance[0].DmaTx = DMA_CHANNEL_SPI_TX;
+    myS2PIHnd.Instance[0].DmaRx = DMA_CHANNEL_SPI_RX;
+    myS2PIHnd.Instance[0].DmaTxSource = DMA_REQUEST_MUX_SPI1_TX;
+    myS2PIHnd.Instance[0].DmaRxSource = DMA_REQUEST_MUX_SPI1_RX;
 #else
     myS2PIHnd.Instance[0].SPI = SPI1;
+    myS2PIHnd.Instance[0].Slave = S2PI_SLAVE1;
+    myS2PIHnd.Instance[0].SlaveMask = (1U << S2PI_SLAVE1) | (1U << S2PI_SLAVE2)
+                                    | (1U << S2PI_SLAVE3) | (1U << S2PI_SLAVE4);
+    myS2PIHnd.Instance[0].DmaTx = DMA_CHANNEL_SPI1_TX;
+    myS2PIHnd.Instance[0].DmaRx = DMA_CHANNEL_SPI1_RX;
+    myS2PIHnd.Instance[0].DmaTxSource = DMA_REQUEST_MUX_SPI1_TX;
+    myS2PIHnd.Instance[0].DmaRxSource = DMA_REQUEST_MUX_SPI1_RX;
+
     myS2PIHnd.Instance[1].SPI = SPI0;
+    myS2PIHnd.Instance[1].Slave = S2PI_SLAVE5;
+    myS2PIHnd.Instance[1].SlaveMask = (1U << S2PI_SLAVE5) | (1U << S2PI_SLAVE6);
+    myS2PIHnd.Instance[1].DmaTx = DMA_CHANNEL_SPI0_TX;
+    myS2PIHnd.Instance[1].DmaRx = DMA_CHANNEL_SPI0_RX;
+    myS2PIHnd.Instance[1].DmaTxSource = DMA_REQUEST_MUX_SPI0_TX;
+    myS2PIHnd.Instance[1].DmaRxSource = DMA_REQUEST_MUX_SPI0_RX;
+#endif
 
-    s2pi_instance_t * instance = S2PI_GetHandleFromSlave(defaultSlave);
-    if (instance == NULL) instance = S2PI_GetHandleFromSlave(SPI_DEFAULT_SLAVE);
-    assert(instance != NULL);
-    S2PI_InitPins(instance->SPI);
-    S2PI_InitSpi(&myS2PIHnd.Instance[0], baudRate_Bps);
-    S2PI_InitSpi(&myS2PIHnd.Instance[1], baudRate_Bps);
+    S2PI_InitPins();
 
-    S2PI_SetSlaveInternal(&myS2PIHnd, defaultSlave);
+    for (uint32_t i = 0; i < S2PI_INSTANCE_COUNT; ++i)
+    {
+        S2PI_InitSpi(&myS2PIHnd.Instance[i], baudRate_Bps);
+#if !S2PI_SHARED_DMA
+        S2PI_SetInstance(&myS2PIHnd.Instance[i]);
+#endif
+    }
+
+#if S2PI_SHARED_DMA
+    S2PI_SetInstance(&myS2PIHnd.Instance[0]);
+    myS2PIHnd.DmaInstance = &myS2PIHnd.Instance[0];
+#endif
+
+    for (s2pi_slave_t slave = 1; slave <= S2PI_SLAVE_COUNT; ++slave)
+    {
+        S2PI_CalcBaudRate(S2PI_GetHandleFromSlave(slave)->SPI, baudRate_Bps, &myS2PIHnd.Slaves[slave]);
+    }
+
+#if !defined(CPU_MKL17Z256VFM4)
+    /* Select the default slave on its instance and the first slave on the other. */
+    for (uint32_t i = 0; i < S2PI_INSTANCE_COUNT; ++i)
+    {
+        s2pi_instance_t * instance = &myS2PIHnd.Instance[i];
+        if (instance->SlaveMask & (1U << defaultSlave)) instance->Slave = defaultSlave;
+        S2PI_SetSlaveInternal(instance, instance->Slave);
+    }
 #endif
 
 #ifdef DEBUG
@@ -386,7 +567,9 @@ static inline void S2PI_InitSpi(s2pi_instance_t * hnd, uint32_t baudRate_Bps)
     hnd->SPI->C1 |= SPI_C1_CPHA_MASK; // set phase
 
     /* Configure baud rate.*/
-    S2PI_SetBaudRateIntern(hnd, baudRate_Bps);
+    s2pi_slave_config_t cfg;
+    S2PI_CalcBaudRate(hnd->SPI, baudRate_Bps, &cfg);
+    S2PI_ApplyBaudRate(hnd, &cfg);
 
     /* Enable the S2PI RX DMA Request */
     hnd->SPI->C2 |= SPI_C2_RXDMAE_MASK;
@@ -398,10 +581,10 @@ static inline void S2PI_InitSpi(s2pi_instance_t * hnd, uint32_t baudRate_Bps)
     hnd->SPI->C1 |= SPI_C1_SPE_MASK;
 }
 
-static inline void S2PI_ResetPins(SPI_Type * spi)
+static inline void S2PI_ResetPins(s2pi_instance_t const * instance)
 {
 #if defined(CPU_MKL17Z256VFM4)
-    (void)spi;
+    (void)instance;
 
     /* Enable all SPI1 slaves. */
     GPIO_SetPinMux(Pin_SPI1_MISO, SPI1_MISO_MUX_SPI);
@@ -409,17 +592,10 @@ static inline void S2PI_ResetPins(SPI_Type * spi)
     GPIO_SetPinMux(Pin_SPI1_CLK, SPI1_CLK_MUX_SPI);
     GPIO_SetPinMux(Pin_S2PI_CS1, S2PI_CS1_MUX_SPI);
 #else
-    if (spi == SPI0)
+    /* Only the pins of the instance are touched; the other instance may be
+     * transferring data or be in GPIO mode at the same time. */
+    if (instance->SPI == SPI0)
     {
-        /* Disable all SPI1 slaves. */
-        GPIO_SetPinMux(Pin_SPI1_MISO, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI1_MOSI, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI1_CLK, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS1, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS2, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS3, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS4, S2PI_PIN_MUX_DISABLED);
-
         /* Enable all SPI0 slaves. */
         GPIO_SetPinMux(Pin_SPI0_MISO, SPI0_MISO_MUX_SPI);
         GPIO_SetPinMux(Pin_SPI0_MOSI, SPI0_MOSI_MUX_SPI);
@@ -437,18 +613,11 @@ static inline void S2PI_ResetPins(SPI_Type * spi)
         GPIO_SetPinMux(Pin_S2PI_CS2, S2PI_CS2_MUX_GPIO);
         GPIO_SetPinMux(Pin_S2PI_CS3, S2PI_CS3_MUX_GPIO);
         GPIO_SetPinMux(Pin_S2PI_CS4, S2PI_CS4_MUX_GPIO);
-
-        /* Disable all SPI0 slaves. */
-        GPIO_SetPinMux(Pin_SPI0_MISO, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI0_MOSI, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI0_CLK, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS5, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS6, S2PI_PIN_MUX_DISABLED);
     }
 #endif
 }
 
-static inline void S2PI_InitPins(SPI_Type * spi)
+static inline void S2PI_InitPins(void)
 {
 #if defined(CPU_MKL17Z256VFM4)
     /* Initialize Pins */
@@ -519,7 +688,10 @@ static inline void S2PI_InitPins(SPI_Type * spi)
     GPIO_SetPinMux(Pin_S2PI_IRQ6, S2PI_IRQ6_MUX);
 #endif
 
-    S2PI_ResetPins(spi);
+    for (uint32_t i = 0; i < S2PI_INSTANCE_COUNT; ++i)
+    {
+        S2PI_ResetPins(&myS2PIHnd.Instance[i]);
+    }
 }
 
 s2pi_instance_t * S2PI_GetHandleFromSlave(s2pi_slave_t slave)
@@ -552,41 +724,30 @@ static inline void S2PI_SetInstance(s2pi_instance_t * instance)
 {
     assert(instance != NULL);
 
-#if defined(CPU_MKL17Z256VFM4)
-    DMA_ClaimChannel(DMA_CHANNEL_SPI_TX, DMA_REQUEST_MUX_SPI1_TX);
-    DMA_ClaimChannel(DMA_CHANNEL_SPI_RX, DMA_REQUEST_MUX_SPI1_RX);
-#else
+    /* Register callback for DMA interrupt */
+    DMA_SetTransferDoneCallback(instance->DmaTx, S2PI_TxDmaCallbackFunction, instance);
+    DMA_SetTransferDoneCallback(instance->DmaRx, S2PI_RxDmaCallbackFunction, instance);
+
     /* Request DMA channel for TX/RX */
-    if (instance->SPI == SPI0)
-    {
-        DMA_ClaimChannel(DMA_CHANNEL_SPI_TX, DMA_REQUEST_MUX_SPI0_TX);
-        DMA_ClaimChannel(DMA_CHANNEL_SPI_RX, DMA_REQUEST_MUX_SPI0_RX);
-    }
-    else
-    {
-        DMA_ClaimChannel(DMA_CHANNEL_SPI_TX, DMA_REQUEST_MUX_SPI1_TX);
-        DMA_ClaimChannel(DMA_CHANNEL_SPI_RX, DMA_REQUEST_MUX_SPI1_RX);
-    }
-#endif
+    DMA_ClaimChannel(instance->DmaTx, instance->DmaTxSource);
+    DMA_ClaimChannel(instance->DmaRx, instance->DmaRxSource);
 
     /* Set up this channel's control which includes enabling the DMA interrupt */
-    DMA_ConfigTransfer(DMA_CHANNEL_SPI_TX, 1, DMA_MEMORY_TO_PERIPHERAL, 0, (uint32_t)(&instance->SPI->DL), 0); /* dest is data register */
-    DMA_ConfigTransfer(DMA_CHANNEL_SPI_RX, 1, DMA_PERIPHERAL_TO_MEMORY, (uint32_t)(&instance->SPI->DL), 0, 0); /* src is data register */
+    DMA_ConfigTransfer(instance->DmaTx, 1, DMA_MEMORY_TO_PERIPHERAL, 0, (uint32_t)(&instance->SPI->DL), 0); /* dest is data register */
+    DMA_ConfigTransfer(instance->DmaRx, 1, DMA_PERIPHERAL_TO_MEMORY, (uint32_t)(&instance->SPI->DL), 0, 0); /* src is data register */
 }
 
 #if defined(CPU_MKL17Z256VFM4)
 #else
-static inline status_t S2PI_SetSlaveInternal(s2pi_hnd_t * hnd, s2pi_slave_t slave)
+static inline status_t S2PI_SetSlaveInternal(s2pi_instance_t * hnd, s2pi_slave_t slave)
 {
     assert(hnd != 0);
+    assert(hnd == S2PI_GetHandleFromSlave(slave));
 
-    s2pi_instance_t * new_instance = S2PI_GetHandleFromSlave(slave);
-    assert(new_instance != NULL);
-    s2pi_instance_t * current_instance = S2PI_GetHandleFromSlave(hnd->Slave);
-    if (new_instance != current_instance)
-        S2PI_SetInstance(new_instance);
+    S2PI_ResetPins(hnd);
 
-    S2PI_ResetPins(new_instance->SPI);
+    if (slave > 0 && slave <= S2PI_SLAVE_COUNT)
+        S2PI_ApplyBaudRate(hnd, &myS2PIHnd.Slaves[slave]);
 
     switch (slave)
     {
@@ -631,7 +792,8 @@ status_t S2PI_SetSlave(s2pi_slave_t slave)
     assert(slave == SPI_DEFAULT_SLAVE);
     return STATUS_OK;
 #else
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
     if (hnd->Slave == slave) return STATUS_OK;
 
@@ -641,6 +803,7 @@ status_t S2PI_SetSlave(s2pi_slave_t slave)
     status_t status = S2PI_SetSlaveInternal(hnd, slave);
 
     S2PI_SET_IDLE(hnd);
+    S2PI_StartNext();
 
     return status;
 #endif
@@ -658,10 +821,50 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
     /* Verify arguments. */
     if (!txData || !frameSize) return ERROR_INVALID_ARGUMENT;
 
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
-    /* Check the driver status and set spi slave.*/
-    S2PI_SET_BUSY(hnd);
+    /* Check the instance status; queue the frame if the bus or DMA is occupied. */
+    IRQ_LOCK();
+    if (hnd->Status != STATUS_IDLE || S2PI_DMA_IS_BUSY())
+    {
+        status_t status = S2PIQueue_Push(slave, txData, rxData, frameSize, callback, callbackData);
+        IRQ_UNLOCK();
+        return status;
+    }
+    hnd->Status = STATUS_BUSY;
+    S2PI_DMA_SET_BUSY(hnd);
+    IRQ_UNLOCK();
+
+    status_t status = S2PI_StartTransfer(hnd, slave, txData, rxData, frameSize, callback, callbackData);
+    if (status < STATUS_OK)
+    {
+        IRQ_LOCK();
+        S2PI_DMA_RELEASE(hnd);
+        S2PI_SET_IDLE(hnd);
+        IRQ_UNLOCK();
+        S2PI_StartNext();
+    }
+
+    return status;
+}
+
+static status_t S2PI_StartTransfer(s2pi_instance_t * hnd,
+                                   s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData)
+{
+#if S2PI_SHARED_DMA
+    /* Route the shared DMA channels to the instance. */
+    if (myS2PIHnd.DmaInstance != hnd)
+    {
+        S2PI_SetInstance(hnd);
+        myS2PIHnd.DmaInstance = hnd;
+    }
+#endif
 
     s2pi_log_setup(slave, txData, rxData, frameSize);
 
@@ -672,11 +875,7 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
     if (hnd->Slave != slave)
     {
         status_t status = S2PI_SetSlaveInternal(hnd, slave);
-        if (status < STATUS_OK)
-        {
-            S2PI_SET_IDLE(hnd);
-            return status;
-        }
+        if (status < STATUS_OK) return status;
     }
 #endif
 
@@ -687,10 +886,10 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
     if (rxData)
     {
         /* Set up this channel's control which includes enabling the DMA interrupt */
-        DMA0->DMA[DMA_CHANNEL_SPI_RX].DAR = (uint32_t) rxData;      // set dest. address
+        DMA0->DMA[hnd->DmaRx].DAR = (uint32_t) rxData;      // set dest. address
 
         /* Set source address increment. */
-        DMA0->DMA[DMA_CHANNEL_SPI_RX].DCR |= DMA_DCR_DINC_MASK;
+        DMA0->DMA[hnd->DmaRx].DCR |= DMA_DCR_DINC_MASK;
     }
     else
     {
@@ -698,39 +897,95 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
          * Reason: Tx DMA IRQ occurs, when last transfers is still in progress. */
 
         /* Set up this channel's control which includes enabling the DMA interrupt */
-        DMA0->DMA[DMA_CHANNEL_SPI_RX].DAR = (uint32_t) (&hnd->RxSink);     // set pseudo dest. address
+        DMA0->DMA[hnd->DmaRx].DAR = (uint32_t) (&hnd->RxSink);     // set pseudo dest. address
 
         /* Unset source address increment. */
-        DMA0->DMA[DMA_CHANNEL_SPI_RX].DCR &= ~DMA_DCR_DINC_MASK;
+        DMA0->DMA[hnd->DmaRx].DCR &= ~DMA_DCR_DINC_MASK;
     }
 
+    S2PIQueue_TransferStarted(slave, frameSize);
+    S2PI_TRACE_BEGIN(hnd, slave, frameSize);
+
     S2PI_AssertSoftwareCS(slave);
 
     /* Set up the TX channel's control which includes enabling the DMA interrupt */
-    DMA0->DMA[DMA_CHANNEL_SPI_TX].SAR = (uint32_t) txData;
+    DMA0->DMA[hnd->DmaTx].SAR = (uint32_t) txData;
 
     /* Set up the RX channel's control which includes enabling the DMA interrupt */
-    DMA0->DMA[DMA_CHANNEL_SPI_RX].DSR_BCR = DMA_DSR_BCR_BCR(frameSize);
+    DMA0->DMA[hnd->DmaRx].DSR_BCR = DMA_DSR_BCR_BCR(frameSize);
 
     /* Enable the RX channel's DMA peripheral request */
-    DMA0->DMA[DMA_CHANNEL_SPI_RX].DCR |= DMA_DCR_ERQ_MASK;
+    DMA0->DMA[hnd->DmaRx].DCR |= DMA_DCR_ERQ_MASK;
 
     /* Set up the TX channel's control which includes enabling the DMA interrupt */
-    DMA0->DMA[DMA_CHANNEL_SPI_TX].DSR_BCR = DMA_DSR_BCR_BCR(frameSize);
+    DMA0->DMA[hnd->DmaTx].DSR_BCR = DMA_DSR_BCR_BCR(frameSize);
 
     /* Enable the TX channel's DMA peripheral request */
-    DMA0->DMA[DMA_CHANNEL_SPI_TX].DCR |= DMA_DCR_ERQ_MASK;
+    DMA0->DMA[hnd->DmaTx].DCR |= DMA_DCR_ERQ_MASK;
 
     return STATUS_OK;
 }
 
+static void S2PI_StartNext(void)
+{
+    s2pi_queue_entry_t next;
+
+    for (;;)
+    {
+        /* Collect the slaves whose instance is able to start a transfer. */
+        IRQ_LOCK();
+        uint32_t slaves = 0U;
+        if (!S2PI_DMA_IS_BUSY())
+        {
+            for (uint32_t i = 0; i < S2PI_INSTANCE_COUNT; ++i)
+            {
+                if (myS2PIHnd.Instance[i].Status == STATUS_IDLE)
+                    slaves |= myS2PIHnd.Instance[i].SlaveMask;
+            }
+        }
+
+        if (slaves == 0U || !S2PIQueue_Pop(&next, slaves))
+        {
+            IRQ_UNLOCK();
+            return;
+        }
+
+        s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(next.Slave);
+        hnd->Status = STATUS_BUSY;
+        S2PI_DMA_SET_BUSY(hnd);
+        IRQ_UNLOCK();
+
+        /* On success, continue with the other instance. */
+        status_t status = S2PI_StartTransfer(hnd, next.Slave, next.TxData, next.RxData,
+                                             next.FrameSize, next.Callback, next.CallbackData);
+        if (status == STATUS_OK) continue;
+
+        /* The queued frame could not be started; report to its caller. */
+        IRQ_LOCK();
+        S2PI_DMA_RELEASE(hnd);
+        S2PI_SET_IDLE(hnd);
+        IRQ_UNLOCK();
+        if (next.Callback != 0) next.Callback(status, next.CallbackData);
+    }
+}
+
 status_t S2PI_GetStatus(s2pi_slave_t slave)
 {
-    (void)slave;
     assert(isInitialized);
 
-    s2pi_hnd_t * hnd = &myS2PIHnd;
-    return hnd->Status;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
+
+    /* A slave is idle while the bus is occupied by another slave. */
+    IRQ_LOCK();
+    status_t status = hnd->Status;
+    if (S2PIQueue_IsPending(slave))
+        status = STATUS_BUSY;
+    else if (status == STATUS_BUSY && hnd->Slave != slave)
+        status = STATUS_IDLE;
+    IRQ_UNLOCK();
+
+    return status;
 }
 
 status_t S2PI_TryGetMutex(s2pi_slave_t slave)
@@ -768,26 +1023,45 @@ void S2PI_ReleaseMutex(s2pi_slave_t slave)
 
 status_t S2PI_Abort(s2pi_slave_t slave)
 {
-    (void)slave;
     assert(isInitialized);
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
-    /* Check if something is ongoing. */
+    /* Remove the queued frames of the slave. */
+    s2pi_queue_entry_t entry;
+    while (S2PIQueue_Remove(slave, &entry))
+    {
+        if (entry.Callback != 0) entry.Callback(ERROR_ABORTED, entry.CallbackData);
+    }
+
+    /* Check if something is ongoing for the slave; a transfer or the GPIO
+     * mode of another slave on the same instance is not touched. */
     IRQ_LOCK();
-    if (hnd->Status == STATUS_IDLE)
+    if (!((hnd->Status == STATUS_BUSY && hnd->Slave == slave) ||
+          (hnd->Status == STATUS_S2PI_GPIO_MODE && hnd->GpioSlave == slave)))
     {
         IRQ_UNLOCK();
         return STATUS_OK;
     }
 
-    /* Abort SPI transfer. */
-    if (hnd->Status == STATUS_BUSY)
+    /* Leave the GPIO mode, i.e. deselect the slave and restore the SPI pins
+     * before any queued transfer of another slave is started. */
+    if (hnd->Status == STATUS_S2PI_GPIO_MODE)
+    {
+        IRQ_UNLOCK();
+        return S2PI_ReleaseGpioInternal(hnd, slave);
+    }
+
+    /* Abort SPI transfer; the shared DMA channels may belong to the other instance. */
+#if S2PI_SHARED_DMA
+    if (myS2PIHnd.DmaInstance == hnd)
+#endif
     {
         /* Disable the DMA peripheral request */
-        DMA_StopChannel(DMA_CHANNEL_SPI_RX);
-        DMA_StopChannel(DMA_CHANNEL_SPI_TX);
-        DMA_ClearStatus(DMA_CHANNEL_SPI_RX);
-        DMA_ClearStatus(DMA_CHANNEL_SPI_TX);
+        DMA_StopChannel(hnd->DmaRx);
+        DMA_StopChannel(hnd->DmaTx);
+        DMA_ClearStatus(hnd->DmaRx);
+        DMA_ClearStatus(hnd->DmaTx);
     }
 
     IRQ_UNLOCK();
@@ -837,7 +1111,8 @@ static inline void S2PI_AssertSoftwareCS(s2pi_slave_t slave)
 status_t S2PI_CycleCsPin(s2pi_slave_t slave)
 {
     assert(isInitialized);
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_INVALID_ARGUMENT;
 
     /* Check the driver status. */
     S2PI_SET_BUSY(hnd);
@@ -901,12 +1176,14 @@ status_t S2PI_CycleCsPin(s2pi_slave_t slave)
         default:
         {
             S2PI_SET_IDLE(hnd);
+            S2PI_StartNext();
             return ERROR_INVALID_ARGUMENT;
         }
     }
 #endif
 
     S2PI_SET_IDLE(hnd);
+    S2PI_StartNext();
     return STATUS_OK;
 }
 
@@ -992,7 +1269,8 @@ uint32_t S2PI_ReadIrqPin(s2pi_slave_t slave)
 status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
 {
     assert(isInitialized);
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
     /* Check if something is ongoing. */
     S2PI_SET_GPIO(hnd);
@@ -1011,20 +1289,9 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
     GPIO_SetPinOutput(Pin_S2PI_CS1);
     GPIO_SetPinMux(Pin_S2PI_CS1, S2PI_CS1_MUX_GPIO);
 #else
-    s2pi_instance_t * instance = S2PI_GetHandleFromSlave(slave);
-
-    /* Output Pins */
-    if (instance->SPI == SPI0)
+    /* Output Pins; only the pins of the instance are touched. */
+    if (hnd->SPI == SPI0)
     {
-        /* Disable SPI1 Pins. */
-        GPIO_SetPinMux(Pin_SPI1_MOSI, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI1_MISO, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI1_CLK, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS1, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS2, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS3, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS4, S2PI_PIN_MUX_DISABLED);
-
         /* Enable SPI0 Pins as GPIO. */
         GPIO_SetPinOutput(Pin_SPI0_MOSI);
         GPIO_SetPinMux(Pin_SPI0_MOSI, SPI0_MOSI_MUX_GPIO);
@@ -1039,13 +1306,6 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
     }
     else
     {
-        /* Disable SPI0 Pins. */
-        GPIO_SetPinMux(Pin_SPI0_MOSI, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI0_MISO, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_SPI0_CLK, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS5, S2PI_PIN_MUX_DISABLED);
-        GPIO_SetPinMux(Pin_S2PI_CS6, S2PI_PIN_MUX_DISABLED);
-
         /* Enable SPI1 Pins as GPIO. */
         GPIO_SetPinOutput(Pin_SPI1_MOSI);
         GPIO_SetPinMux(Pin_SPI1_MOSI, SPI1_MOSI_MUX_GPIO);
@@ -1063,13 +1323,25 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
         GPIO_SetPinMux(Pin_S2PI_CS4, S2PI_CS4_MUX_GPIO);
     }
 #endif
+
+    /* Cache the direct register access of the pins for the bit-banging. */
+    for (uint32_t pin = 0; pin <= S2PI_IRQ; ++pin)
+    {
+        GPIO_GetFastPin(S2PI_GetGpioPin(slave, (s2pi_pin_t)pin), &hnd->GpioPins[pin]);
+    }
+    hnd->GpioSlave = slave;
+    hnd->GpioDelayLoops = ((SystemCoreClock / 1000000U) * S2PI_GPIO_DELAY_NS
+                           + S2PI_GPIO_DELAY_LOOP_CYCLES * 1000U - 1U)
+                          / (S2PI_GPIO_DELAY_LOOP_CYCLES * 1000U);
+
     return STATUS_OK;
 }
 
 status_t S2PI_ReleaseGpioControl(s2pi_slave_t slave)
 {
     assert(isInitialized);
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
     /* Check if in GPIO mode. */
     IRQ_LOCK();
@@ -1080,16 +1352,26 @@ status_t S2PI_ReleaseGpioControl(s2pi_slave_t slave)
     }
     IRQ_UNLOCK();
 
+    return S2PI_ReleaseGpioInternal(hnd, slave);
+}
+
+static status_t S2PI_ReleaseGpioInternal(s2pi_instance_t * hnd, s2pi_slave_t slave)
+{
+    /* Deselect the slave; the CS is still a GPIO output. */
+    GPIO_SetPinOutput(S2PI_GetGpioPin(slave, S2PI_CS));
+    hnd->GpioSlave = 0;
+
 #if defined(CPU_MKL17Z256VFM4)
     (void)slave;
     assert(slave == SPI_DEFAULT_SLAVE);
-    S2PI_ResetPins(NULL);
+    S2PI_ResetPins(hnd);
     status_t status = STATUS_OK;
 #else
     status_t status = S2PI_SetSlaveInternal(hnd, slave);
 #endif
 
     S2PI_SET_IDLE(hnd);
+    S2PI_StartNext();
     return status;
 }
 
@@ -1198,22 +1480,20 @@ status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
     if (!(pin == S2PI_CS || pin == S2PI_CLK || pin == S2PI_MOSI))
         return ERROR_INVALID_ARGUMENT;
 
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
-    /* Check if in GPIO mode. */
-    IRQ_LOCK();
+    /* Check if in GPIO mode; a single read, i.e. no lock required. */
     if (hnd->Status != STATUS_S2PI_GPIO_MODE)
-    {
-        IRQ_UNLOCK();
         return ERROR_S2PI_INVALID_STATE;
-    }
-    IRQ_UNLOCK();
 
-    gpio_pin_t gpio_pin = S2PI_GetGpioPin(slave, pin);
-    GPIO_WritePinOutput(gpio_pin, value);
+    if (hnd->GpioSlave == slave)
+        GPIO_FastWritePinOutput(&hnd->GpioPins[pin], value);
+    else
+        GPIO_WritePinOutput(S2PI_GetGpioPin(slave, pin), value);
 
     /* Decrease SW Protocol Speed by adding a delay. */
-    S2PI_GPIO_DELAY();
+    S2PI_GpioDelay(hnd->GpioDelayLoops);
 
     return STATUS_OK;
 }
@@ -1226,41 +1506,85 @@ status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
     if(!(pin == S2PI_MISO || pin == S2PI_IRQ))
         return ERROR_INVALID_ARGUMENT;
 
-    s2pi_hnd_t * hnd = &myS2PIHnd;
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
 
-    /* Check if in GPIO mode. */
-    IRQ_LOCK();
+    /* Check if in GPIO mode; a single read, i.e. no lock required. */
     if (hnd->Status != STATUS_S2PI_GPIO_MODE)
-    {
-        IRQ_UNLOCK();
         return ERROR_S2PI_INVALID_STATE;
-    }
-    IRQ_UNLOCK();
 
-    gpio_pin_t gpio_pin = S2PI_GetGpioPin(slave, pin);
-    *value = GPIO_ReadPinInput(gpio_pin);
+    if (hnd->GpioSlave == slave)
+        *value = GPIO_FastReadPinInput(&hnd->GpioPins[pin]);
+    else
+        *value = GPIO_ReadPinInput(S2PI_GetGpioPin(slave, pin));
 
     return STATUS_OK;
 }
 
+status_t S2PI_TransferGpioBits(s2pi_slave_t slave, uint32_t txData,
+                               uint32_t * rxData, uint32_t bitCount)
+{
+    assert(isInitialized);
+    assert(bitCount > 0 && bitCount <= 32U);
+
+    if (bitCount == 0 || bitCount > 32U) return ERROR_INVALID_ARGUMENT;
+
+    s2pi_instance_t * hnd = S2PI_GetHandleFromSlave(slave);
+    if (hnd == NULL) return ERROR_S2PI_INVALID_SLAVE;
+
+    if (hnd->Status != STATUS_S2PI_GPIO_MODE || hnd->GpioSlave != slave)
+        return ERROR_S2PI_INVALID_STATE;
+
+    gpio_fast_pin_t const * clk = &hnd->GpioPins[S2PI_CLK];
+    gpio_fast_pin_t const * mosi = &hnd->GpioPins[S2PI_MOSI];
+    gpio_fast_pin_t const * miso = &hnd->GpioPins[S2PI_MISO];
+    const uint32_t loops = hnd->GpioDelayLoops;
+
+    /* SPI mode 3, MSB first: shift out on the falling and sample on the
+     * rising CLK edge; the CLK idles high. */
+    uint32_t rx = 0;
+    for (uint32_t mask = 1U << (bitCount - 1U); mask; mask >>= 1U)
+    {
+        *clk->PCOR = clk->Mask;
+        GPIO_FastWritePinOutput(mosi, txData & mask);
+        S2PI_GpioDelay(loops);
+
+        *clk->PSOR = clk->Mask;
+        rx = (rx << 1U) | GPIO_FastReadPinInput(miso);
+        S2PI_GpioDelay(loops);
+    }
+
+    if (rxData) *rxData = rx;
+    return STATUS_OK;
+}
+
+static inline void S2PI_GpioDelay(uint32_t loops)
+{
+    if (loops == 0) return;
+    __asm volatile (
+        "1: subs %0, %0, #1 \n"
+        "   bne 1b          \n"
+        : "+l" (loops) : : "cc");
+}
+
 uint32_t S2PI_GetBaudRate(s2pi_slave_t slave)
 {
     assert(isInitialized);
-    s2pi_instance_t * instance = S2PI_GetHandleFromSlave(slave);
-    return instance->BaudRate;
+    assert(slave > 0 && slave <= S2PI_SLAVE_COUNT);
+    return myS2PIHnd.Slaves[slave].BaudRate;
 }
 
-static status_t S2PI_SetBaudRateIntern(s2pi_instance_t * hnd, uint32_t baudRate_Bps)
+static status_t S2PI_CalcBaudRate(SPI_Type const * spi, uint32_t baudRate_Bps, s2pi_slave_config_t * cfg)
 {
-    assert(hnd != 0);
-    assert(hnd->SPI == SPI0 || hnd->SPI == SPI1); // No correct S2PI_BASE definition!
+    assert(cfg != 0);
+    assert(spi == SPI0 || spi == SPI1); // No correct S2PI_BASE definition!
 
     if(baudRate_Bps > SPI_MAX_BAUDRATE)
     {
         return ERROR_S2PI_INVALID_BAUDRATE;
     }
 
-    const uint32_t srcClock_Hz = CLOCK_GetFreq(hnd->SPI == SPI0 ? kCLOCK_BusClk : kCLOCK_CoreSysClk);
+    const uint32_t srcClock_Hz = CLOCK_GetFreq(spi == SPI0 ? kCLOCK_BusClk : kCLOCK_CoreSysClk);
 
     /* Find combination of prescaler and scaler resulting in baud rate
      * closest to the requested value */
@@ -1296,13 +1620,13 @@ static status_t S2PI_SetBaudRateIntern(s2pi_instance_t * hnd, uint32_t baudRate_
                 min_diff = diff;
                 bestPrescaler = prescaler;
                 bestDivisor = rateDivisor;
-                hnd->BaudRate = realBaudrate;
+                cfg->BaudRate = realBaudrate;
             }
         }
     }
 
-    /* Write the best prescaler and baud rate scalar */
-    hnd->SPI->BR = (uint8_t)(SPI_BR_SPR(bestDivisor) | SPI_BR_SPPR(bestPrescaler));
+    /* Keep the best prescaler and baud rate scalar */
+    cfg->BR = (uint8_t)(SPI_BR_SPR(bestDivisor) | SPI_BR_SPPR(bestPrescaler));
 
     /* Check if the actual baud rate is within 10 % of the desired baud rate. */
     if(min_diff > baudRate_Bps / 10)
@@ -1310,29 +1634,59 @@ static status_t S2PI_SetBaudRateIntern(s2pi_instance_t * hnd, uint32_t baudRate_
 
     return STATUS_OK;
 }
+
+static inline void S2PI_ApplyBaudRate(s2pi_instance_t * hnd, s2pi_slave_config_t const * cfg)
+{
+    assert(hnd != 0);
+    assert(cfg != 0);
+
+    /* Baud Rate Register can be written at any time. */
+    if (hnd->SPI->BR != cfg->BR) hnd->SPI->BR = cfg->BR;
+    hnd->BaudRate = cfg->BaudRate;
+}
+
 status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps)
 {
     assert(isInitialized);
     s2pi_instance_t * instance = S2PI_GetHandleFromSlave(slave);
+    if (instance == NULL) return ERROR_S2PI_INVALID_SLAVE;
+
+    s2pi_hnd_t * hnd = &myS2PIHnd;
+    status_t status = S2PI_CalcBaudRate(instance->SPI, baudRate_Bps, &hnd->Slaves[slave]);
 
-    /* Baud Rate Register can be written at any time, no need to block the SPI handle */
-    return S2PI_SetBaudRateIntern(instance, baudRate_Bps);
+    /* Applied immediately for the current slave of the instance; no need to block
+     * the SPI handle. Other slaves get their baud rate when their next transfer
+     * is started. */
+    if (instance->Slave == slave) S2PI_ApplyBaudRate(instance, &hnd->Slaves[slave]);
+
+    return status;
 }
 
-static inline status_t S2PI_CompleteTransfer(s2pi_hnd_t * hnd, status_t status)
+static inline status_t S2PI_CompleteTransfer(s2pi_instance_t * hnd, status_t status)
 {
     S2PI_ClearSoftwareCS(hnd->Slave);
 
     s2pi_log_send();
 
+    S2PIQueue_TransferFinished(hnd->Slave);
+    S2PI_TRACE_END(hnd, status);
+
+    s2pi_callback_t callback = hnd->Callback;
+    void * callbackParam = hnd->CallbackParam;
+    hnd->Callback = 0;
+
+    IRQ_LOCK();
+    S2PI_DMA_RELEASE(hnd);
     S2PI_SET_IDLE(hnd);
+    IRQ_UNLOCK();
+
+    /* Start the next queued frames back to back, i.e. before the callback. */
+    S2PI_StartNext();
 
     /* Invoke callback if there is one */
-    if (hnd->Callback != 0)
+    if (callback != 0)
     {
-        s2pi_callback_t callback = hnd->Callback;
-        hnd->Callback = 0;
-        status = callback(status, hnd->CallbackParam);
+        status = callback(status, callbackParam);
         assert(status == STATUS_OK || status == ERROR_ABORTED);
     }
 
@@ -1348,13 +1702,13 @@ static void S2PI_TxDmaCallbackFunction(status_t status, void * param)
     if (status < STATUS_OK)
     {
         /* DMA error occurred. */
-        s2pi_hnd_t * hnd = (s2pi_hnd_t*)param;
+        s2pi_instance_t * hnd = (s2pi_instance_t*)param;
         S2PI_CompleteTransfer(hnd, status);
     }
 }
 
 static void S2PI_RxDmaCallbackFunction(status_t status, void * param)
 {
-    s2pi_hnd_t * hnd = (s2pi_hnd_t*)param;
+    s2pi_instance_t * hnd = (s2pi_instance_t*)param;
     S2PI_CompleteTransfer(hnd, status);
 }
@@ -102,6 +102,31 @@ status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps);
  *****************************************************************************/
 status_t S2PI_SetSlave(s2pi_slave_t slave);
 
+/*!***************************************************************************
+ * @brief   Clocks a sequence of bits in GPIO mode (bulk bit-banging).
+ *
+ * @details An optional extension to the GPIO mode of the #argus_s2pi
+ *          interface that clocks up to 32 bits in a single call instead of
+ *          a #S2PI_WriteGpioPin / #S2PI_ReadGpioPin call per edge. The bits
+ *          are transferred MSB first in SPI mode 3, i.e. MOSI is changed after
+ *          the falling CLK edge and MISO is sampled at the rising CLK edge.
+ *          The CS pin is not touched. Each CLK phase lasts at least
+ *          S2PI_GPIO_DELAY_NS.
+ *
+ *          The slave must have captured the GPIO mode via
+ *          #S2PI_CaptureGpioControl before.
+ *
+ * @param   slave The specified S2PI slave.
+ * @param   txData The bits to be written to the MOSI pin; right aligned.
+ * @param   rxData The bits read from the MISO pin; right aligned. May be null.
+ * @param   bitCount The number of bits to transfer; 1 to 32.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          - #ERROR_S2PI_INVALID_STATE if the slave is not in GPIO mode.
+ *****************************************************************************/
+status_t S2PI_TransferGpioBits(s2pi_slave_t slave, uint32_t txData,
+                               uint32_t * rxData, uint32_t bitCount);
+
 
 /*! @} */
 #endif // S2PI_H
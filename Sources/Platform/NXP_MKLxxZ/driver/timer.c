@@ -45,6 +45,8 @@
 #include "driver/fsl_clock.h"
 #include "driver/irq.h"
 #include "debug.h"
+#include "timer_mux.h"
+#include "hr_clock.h"
 
 #include <stdbool.h>
 
@@ -69,6 +71,8 @@
 /*! The system timer exception handler. */
 void SysTick_Handler(void);
 
+static uint64_t PIT_GetTicks(void);
+
 /******************************************************************************
  * Variables
  ******************************************************************************/
@@ -76,16 +80,6 @@ void SysTick_Handler(void);
 /*! External definition of the system timer core clock. */
 extern uint32_t SystemCoreClock;
 
-#if !DISABLE_PIT
-
-/*! A pointer to the ISR function to be called when the timer has elapsed. */
-static timer_cb_t myISR = 0;
-
-/*! The parameter to be passed to the callback. */
-static void * myParam = 0;
-
-#endif
-
 #ifdef DEBUG
 static volatile bool isInitialized = false;
 #endif
@@ -94,6 +88,39 @@ static volatile bool isInitialized = false;
 /*******************************************************************************
  * Code
  *******************************************************************************/
+#if !DISABLE_PIT
+/*!***************************************************************************
+ * @brief   Starts the SysTick timer to elapse after a given time.
+ *
+ * @details Used by the #timer_mux module to schedule the next interval event.
+ *          Intervals that exceed the 24-bit SysTick range are clamped to the
+ *          maximum period; the multiplexer ignores these early events.
+ *
+ * @param   dt_microseconds The time until the next event; 0 stops the timer.
+ *****************************************************************************/
+static void SysTick_Start(uint32_t dt_microseconds)
+{
+    if (dt_microseconds)
+    {
+        const uint32_t ticks = SystemCoreClock / 1000000U;
+        const uint32_t max_dt = (SysTick_LOAD_RELOAD_Msk + 1U) / ticks;
+        if (dt_microseconds > max_dt) dt_microseconds = max_dt;
+
+        SysTick->LOAD = (uint32_t) ((ticks * dt_microseconds) - 1);
+        SysTick->VAL = 0;
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    }
+    else
+    {
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = 0;
+        SysTick->VAL = 0;
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+    }
+}
+#endif
+
 void Timer_Init(void)
 {
     assert(!isInitialized);
@@ -125,14 +152,14 @@ void Timer_Init(void)
     PIT->CHANNEL[1].TCTRL |= PIT_TCTRL_TEN_MASK;
     PIT->CHANNEL[0].TCTRL |= PIT_TCTRL_TEN_MASK;
 
+    /* The 64-bit lifetime counter is the high resolution clock. */
+    HRClock_Init64(PIT_GetTicks, PIT_Freq);
+
 #if !DISABLE_PIT
     /******************************************************************
      ***  Initialize the SysTick timer as periodic interrupt timer. ***
      ******************************************************************/
 
-    myISR = 0;
-    myParam = 0;
-
     /* Reset reload register and stop timer. */
     SysTick->LOAD = 0;
 
@@ -145,6 +172,9 @@ void Timer_Init(void)
 
     /* Set Priority. */
     NVIC_SetPriority(SysTick_IRQn, IRQPRIO_SYSTICK);
+
+    /* Multiplex all intervals on the SysTick timer. */
+    TimerMux_Init(SysTick_Start);
 #endif
 
 #ifdef DEBUG
@@ -152,12 +182,15 @@ void Timer_Init(void)
 #endif
 }
 
-void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
+/*!***************************************************************************
+ * @brief   Reads the PIT lifetime counter.
+ *
+ * @param   sec The elapsed seconds (timer 1).
+ * @param   ticks The elapsed bus clock ticks within the current second
+ *                (timer 0); Range: 1, .., PIT_Freq - 1.
+ *****************************************************************************/
+static void PIT_ReadLifetime(uint32_t * sec, uint32_t * ticks)
 {
-    assert(isInitialized);
-    assert(hct != 0);
-    assert(lct != 0);
-
     /* PIT Issue Workaround:
      *
      * Source: https://www.nxp.com/docs/en/errata/IMXRT1050CE.pdf
@@ -201,7 +234,30 @@ void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
     }
     while (LTMR64L == 0);
 
-    *hct = LTMR64H;
+    *sec = LTMR64H;
+    *ticks = LTMR64L;
+}
+
+/*!***************************************************************************
+ * @brief   Reads the PIT lifetime counter as 64-bit bus clock tick count.
+ * @details Used as the #hr_clock counter; the Cortex-M0+ has no cycle counter.
+ *****************************************************************************/
+static uint64_t PIT_GetTicks(void)
+{
+    uint32_t sec, ticks;
+    PIT_ReadLifetime(&sec, &ticks);
+    return (uint64_t)sec * PIT_Freq + ticks;
+}
+
+void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
+{
+    assert(isInitialized);
+    assert(hct != 0);
+    assert(lct != 0);
+
+    uint32_t LTMR64L;
+    PIT_ReadLifetime(hct, &LTMR64L);
+
     /* Approx. Division by 24;
      *
      * Idea: Use division by factor of 2 and approximate the
@@ -216,52 +272,17 @@ void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
 status_t Timer_SetCallback(timer_cb_t f)
 {
     assert(isInitialized);
-
-    if (f == 0)
-    {
-        Timer_SetInterval(0, myParam);
-    }
-
-    myISR = f;
-    return STATUS_OK;
+    return TimerMux_SetCallback(f);
 }
 
 status_t Timer_SetInterval(uint32_t dt_microseconds, void * param)
 {
     assert(isInitialized);
-    assert(!(dt_microseconds != 0 && myISR == 0)); // Timer must not be enabled without IRS
-
-    if (dt_microseconds)
-    {
-        const uint32_t ticks = SystemCoreClock / 1000000U;
-        assert(dt_microseconds > 100); // check reasonable minimum interval
-        assert(dt_microseconds < (SysTick_VAL_CURRENT_Msk + 1U) / ticks); // check maximum interval
-
-        IRQ_LOCK();
-        myParam = param;
-
-        SysTick->VAL = 0;
-        SysTick->LOAD = (uint32_t) ((ticks * dt_microseconds) - 1);
-        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
-
-        IRQ_UNLOCK();
-    }
-    else
-    {
-        IRQ_LOCK();
-        myParam = 0;
-
-        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
-        SysTick->LOAD = 0;
-        SysTick->VAL = 0;
-
-        IRQ_UNLOCK();
-    }
-    return STATUS_OK;
+    return TimerMux_SetInterval(dt_microseconds, param);
 }
 
 void SysTick_Handler(void)
 {
-    if (myISR) myISR(myParam);
+    TimerMux_Handler();
 }
 #endif
@@ -48,9 +48,12 @@
  *              functionalities: A periodic interrupt/callback timer and
  *              an lifetime counter.
  *
- *              Note that the current implementation only features a single
- *              callback timer interval and does not yet support the feature
- *              of multiple intervalls at a time.
+ *              Multiple callback intervals at a time are supported by
+ *              multiplexing them on the SysTick timer (see #timer_mux).
+ *
+ *              The lifetime counter also serves as the high resolution clock
+ *              (see #hr_clock) with the 24 MHz bus clock resolution since the
+ *              Cortex-M0+ does not provide a cycle counter.
  *
  * @addtogroup  timer
  * @{
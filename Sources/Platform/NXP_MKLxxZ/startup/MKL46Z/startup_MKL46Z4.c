@@ -88,6 +88,11 @@ __attribute__ ((used,section(".FlashConfig"))) const struct {
 extern void SystemInit(void);
 #endif // (__USE_CMSIS)
 
+//*****************************************************************************
+// Declaration of the board startup hook (boot phase profiler)
+//*****************************************************************************
+extern void Board_Startup(void);
+
 //*****************************************************************************
 // Forward declaration of the core exception handlers.
 // When the application defines a handler (with the same name), this will
@@ -344,6 +349,9 @@ void ResetISR(void) {
         bss_init(ExeAddr, SectionLen);
     }
 
+    // Start the boot phase profiler; the C runtime is ready from here.
+    Board_Startup();
+
 #if !defined (__USE_CMSIS)
 // Assume that if __USE_CMSIS defined, then CMSIS SystemInit code
 // will setup the VTOR register
@@ -0,0 +1,200 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the bare-metal port for the QEMU Cortex-M machines.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "qemu_port.h"
+
+#include "platform/argus_irq.h"
+#include "platform/argus_timer.h"
+#include "printf/printf.h"
+
+#include <assert.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The SysTick registers (ARMv6-M and ARMv7-M). */
+#define SYST_CSR (*(volatile uint32_t *)0xE000E010U)
+#define SYST_RVR (*(volatile uint32_t *)0xE000E014U)
+#define SYST_CVR (*(volatile uint32_t *)0xE000E018U)
+
+/*! The interrupt control and state register and its SysTick pending bit. */
+#define SCB_ICSR (*(volatile uint32_t *)0xE000ED04U)
+#define SCB_ICSR_PENDSTSET 0x04000000U
+
+/*! The SysTick period: the full 24-bit range. */
+#define SYST_PERIOD 0x01000000U
+
+/*! The semihosting operations. */
+#define SYS_WRITE0 0x04U
+#define SYS_EXIT   0x18U
+
+/*! The semihosting exit reasons. */
+#define ADP_Stopped_ApplicationExit    0x20026U
+#define ADP_Stopped_RunTimeErrorUnknown 0x20023U
+
+/*! The size of the console line buffer. */
+#define QEMU_LINE_SIZE 128U
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The number of SysTick periods since #QEMU_Init. */
+static volatile uint32_t myPeriods = 0;
+
+/*! The global IRQ lock level counter. */
+static volatile int myIrqLock = 0;
+
+/*! The console line buffer. */
+static char myLine[QEMU_LINE_SIZE];
+
+/*! The number of characters in the console line buffer. */
+static uint32_t myLineLength = 0;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t Semihost(uint32_t op, void const * arg)
+{
+    register uint32_t r0 __asm__("r0") = op;
+    register void const * r1 __asm__("r1") = arg;
+    __asm__ volatile ("bkpt 0xAB" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+void SysTick_Handler(void)
+{
+    myPeriods++;
+}
+
+void QEMU_Init(void)
+{
+    SYST_CSR = 0;
+    SYST_RVR = SYST_PERIOD - 1U;
+    SYST_CVR = 0;
+    myPeriods = 0;
+    SYST_CSR = 0x07U; // processor clock, interrupt, enable
+}
+
+uint64_t QEMU_GetTicks(void)
+{
+    uint32_t periods, value, pending;
+
+    /* Retry if the interrupt has been served while reading. */
+    do
+    {
+        periods = myPeriods;
+        value = SYST_CVR;
+        pending = SCB_ICSR & SCB_ICSR_PENDSTSET;
+    } while (periods != myPeriods);
+
+    /* The interrupt is pending within IRQ_LOCK; a value close to the reload
+     * value indicates that the counter has wrapped before it was read. */
+    if (pending && value > SYST_PERIOD / 2U) periods++;
+
+    return (uint64_t)periods * SYST_PERIOD + (SYST_PERIOD - 1U - value);
+}
+
+uint64_t QEMU_GetInstructions(void)
+{
+    return QEMU_GetTicks() * 1000U / (QEMU_CPU_CLOCK / 1000000U) >> QEMU_ICOUNT_SHIFT;
+}
+
+void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
+{
+    assert(hct != 0);
+    assert(lct != 0);
+
+    const uint64_t usec = QEMU_GetTicks() / (QEMU_CPU_CLOCK / 1000000U);
+    *hct = (uint32_t)(usec / 1000000U);
+    *lct = (uint32_t)(usec % 1000000U);
+}
+
+void IRQ_UNLOCK(void)
+{
+    assert(myIrqLock > 0);
+    if (--myIrqLock <= 0)
+    {
+        myIrqLock = 0;
+        __asm__ volatile ("cpsie i" ::: "memory");
+    }
+}
+
+void IRQ_LOCK(void)
+{
+    __asm__ volatile ("cpsid i" ::: "memory");
+    myIrqLock++;
+}
+
+static void Flush(void)
+{
+    if (myLineLength)
+    {
+        myLine[myLineLength] = '\0';
+        Semihost(SYS_WRITE0, myLine);
+        myLineLength = 0;
+    }
+}
+
+void _putchar(char character)
+{
+    myLine[myLineLength++] = character;
+    if (character == '\n' || myLineLength == QEMU_LINE_SIZE - 1U) Flush();
+}
+
+void QEMU_Write(char const * s)
+{
+    Flush();
+    Semihost(SYS_WRITE0, s);
+}
+
+void QEMU_Exit(int status)
+{
+    Flush();
+    for (;;)
+    {
+        Semihost(SYS_EXIT, (void const *)(status ? ADP_Stopped_RunTimeErrorUnknown
+                                                 : ADP_Stopped_ApplicationExit));
+    }
+}
@@ -0,0 +1,138 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the bare-metal port for the QEMU Cortex-M machines.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef QEMU_PORT_H
+#define QEMU_PORT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!***************************************************************************
+ * @defgroup    qemu_port QEMU Port
+ * @ingroup     driver
+ *
+ * @brief       Minimal bare-metal port for the QEMU Cortex-M machines.
+ *
+ * @details     Provides the services that the utility modules and the host
+ *              tools require when they are executed on an emulated
+ *              Cortex-M core instead of the AFBR-S50 hardware:
+ *              - A free running tick counter based on the SysTick timer.
+ *              - The #Timer_GetCounterValue function derived from the tick
+ *                counter.
+ *              - The #IRQ_LOCK/#IRQ_UNLOCK functions.
+ *              - Console output (the _putchar function of the printf
+ *                module) and program termination via ARM semihosting.
+ *
+ *              Supported machines (select by #QEMU_MACHINE):
+ *              - 0: "-M microbit" (nRF51, Cortex-M0) executes the ARMv6-M
+ *                code of the Cortex-M0+ builds; QEMU has no M0+ machine.
+ *              - 1: "-M mps2-an386" (Cortex-M4).
+ *
+ *              QEMU is not cycle accurate. Run it with "-icount shift=0" in
+ *              order to advance the virtual clock by exactly 1 ns per
+ *              executed instruction; #QEMU_GetInstructions then returns the
+ *              number of executed instructions, which is a reproducible
+ *              approximation of the core cycles.
+ *
+ * @addtogroup  qemu_port
+ * @{
+ *****************************************************************************/
+
+#include <stdint.h>
+
+/*! The emulated machine: 0 = microbit (Cortex-M0), 1 = mps2-an386 (Cortex-M4). */
+#ifndef QEMU_MACHINE
+#if defined(__ARM_ARCH_ISA_THUMB) && (__ARM_ARCH_ISA_THUMB < 2)
+#define QEMU_MACHINE 0
+#else
+#define QEMU_MACHINE 1
+#endif
+#endif
+
+/*! The SysTick (CPU) clock frequency of the emulated machine in Hz. */
+#if QEMU_MACHINE == 0
+#define QEMU_CPU_CLOCK 16000000U
+#else
+#define QEMU_CPU_CLOCK 25000000U
+#endif
+
+/*! The "-icount shift=N" parameter of QEMU; 2^N ns per instruction. */
+#ifndef QEMU_ICOUNT_SHIFT
+#define QEMU_ICOUNT_SHIFT 0
+#endif
+
+/*!***************************************************************************
+ * @brief   Initializes the SysTick based tick counter.
+ *****************************************************************************/
+void QEMU_Init(void);
+
+/*!***************************************************************************
+ * @brief   Returns the SysTick ticks since #QEMU_Init.
+ * @return  The ticks at #QEMU_CPU_CLOCK.
+ *****************************************************************************/
+uint64_t QEMU_GetTicks(void);
+
+/*!***************************************************************************
+ * @brief   Returns the executed instructions since #QEMU_Init.
+ * @details Converts the virtual time of the tick counter into instructions;
+ *          valid only if QEMU runs with "-icount shift=#QEMU_ICOUNT_SHIFT".
+ *          The resolution is 1e9 / #QEMU_CPU_CLOCK / 2^#QEMU_ICOUNT_SHIFT
+ *          instructions.
+ * @return  The executed instructions.
+ *****************************************************************************/
+uint64_t QEMU_GetInstructions(void);
+
+/*!***************************************************************************
+ * @brief   Writes a zero terminated string to the console of the host.
+ * @param   s The string.
+ *****************************************************************************/
+void QEMU_Write(char const * s);
+
+/*!***************************************************************************
+ * @brief   Terminates QEMU.
+ * @details Flushes the console output; QEMU exits with code 0 if \p status
+ *          is 0 and with code 1 otherwise.
+ * @param   status The exit status of the program.
+ *****************************************************************************/
+void QEMU_Exit(int status) __attribute__((noreturn));
+
+/*! @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif /* QEMU_PORT_H */
@@ -0,0 +1,107 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides the startup code for the QEMU Cortex-M machines.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "driver/qemu_port.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*! The symbols of the linker script. */
+extern uint32_t _estack;
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+
+/*! The application entry point. */
+extern int main(void);
+
+void Reset_Handler(void);
+void Default_Handler(void);
+void SysTick_Handler(void);
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The vector table; no peripheral interrupts are used. */
+__attribute__((section(".isr_vector"), used))
+void (* const myVectors[16])(void) =
+{
+    (void (*)(void))&_estack,   // Initial Stack Pointer
+    Reset_Handler,              // Reset Handler
+    Default_Handler,            // NMI Handler
+    Default_Handler,            // Hard Fault Handler
+    Default_Handler,            // MPU Fault Handler
+    Default_Handler,            // Bus Fault Handler
+    Default_Handler,            // Usage Fault Handler
+    0, 0, 0, 0,                 // Reserved
+    Default_Handler,            // SVCall Handler
+    Default_Handler,            // Debug Monitor Handler
+    0,                          // Reserved
+    Default_Handler,            // PendSV Handler
+    SysTick_Handler,            // SysTick Handler
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+void Reset_Handler(void)
+{
+    memcpy(&_sdata, &_sidata, (uintptr_t)&_edata - (uintptr_t)&_sdata);
+    memset(&_sbss, 0, (uintptr_t)&_ebss - (uintptr_t)&_sbss);
+
+    QEMU_Init();
+    QEMU_Exit(main());
+}
+
+void Default_Handler(void)
+{
+    QEMU_Write("Unexpected exception, e.g. a hard fault.\n");
+    QEMU_Exit(1);
+}
@@ -59,21 +59,25 @@
 #define SPIx_IRQ_PIN                     BSP_IO_PORT_01_PIN_04
 
 
-/*! An additional delay to be added after each GPIO access in order to decrease
- *  the baud rate of the software EEPROM protocol. Increase the delay if timing
- *  issues occur while reading the EERPOM.
- *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz */
-#ifndef S2PI_GPIO_DELAY_US
-#define S2PI_GPIO_DELAY_US 10
+/*! An additional delay in nanoseconds to be added after each GPIO write in
+ *  order to decrease the baud rate of the software EEPROM protocol. Increase
+ *  the delay if timing issues occur while reading the EERPOM.
+ *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz
+ *  The former #S2PI_GPIO_DELAY_US setting is still considered if defined. */
+#ifndef S2PI_GPIO_DELAY_NS
+#ifdef S2PI_GPIO_DELAY_US
+#define S2PI_GPIO_DELAY_NS (S2PI_GPIO_DELAY_US * 1000U)
+#else
+#define S2PI_GPIO_DELAY_NS 10000U
+#endif
 #endif
 
+/*! The I/O port registers of a pin. */
+#define S2PI_GPIO_PORT(pin) \
+    ((R_PORT0_Type *)(R_PORT0_BASE + ((pin) >> 8U) * (R_PORT1_BASE - R_PORT0_BASE)))
 
-#if (S2PI_GPIO_DELAY_US == 0)
-#define S2PI_GPIO_DELAY() ((void)0)
-#else
-#include "utility/time.h"
-#define S2PI_GPIO_DELAY() Time_DelayUSec(S2PI_GPIO_DELAY_US)
-#endif
+/*! The bit mask of a pin within its I/O port registers. */
+#define S2PI_GPIO_MASK(pin) (1UL << ((pin) & 0xFFU))
 
 
 /* Event flags for master and slave */
@@ -108,6 +112,9 @@ typedef struct s2pi_handle_t
     /*! The actual SPI baud rate in bps. */
     uint32_t BaudRate;
 
+    /*! The number of core cycles for #S2PI_GPIO_DELAY_NS. */
+    uint32_t GpioDelayCycles;
+
 } s2pi_handle_t;
 
 static s2pi_handle_t spiHnd_ = {0};
@@ -310,6 +317,15 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
         return ERROR_FAIL;
     }
 
+    /* The delays run on the DWT cycle counter; it is usually started by the
+     * timer module already. */
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    spiHnd_.GpioDelayCycles = ((SystemCoreClock / 1000000U) * S2PI_GPIO_DELAY_NS + 999U) / 1000U;
+
     return STATUS_OK;
 }
 
@@ -357,6 +373,15 @@ static const S2PI_GPIOS s2pi_gpios_[] = { [ S2PI_CLK  ] = { SPIx_SCK_PIN },
                                           [ S2PI_MISO ] = { SPIx_MISO_PIN },
                                           [ S2PI_IRQ  ] = { SPIx_IRQ_PIN  } };
 
+/*!*****************************************************************************
+ * @brief   Busy waits for #S2PI_GPIO_DELAY_NS on the DWT cycle counter.
+ *****************************************************************************/
+static inline void S2PI_GpioDelay(void)
+{
+    const uint32_t start = DWT->CYCCNT;
+    while (DWT->CYCCNT - start < spiHnd_.GpioDelayCycles);
+}
+
 /*!*****************************************************************************
  * @brief   Writes the output for a specified SPI pin in GPIO mode.
  * @details This function writes the value of an SPI pin if the SPI pins are
@@ -369,7 +394,6 @@ static const S2PI_GPIOS s2pi_gpios_[] = { [ S2PI_CLK  ] = { SPIx_SCK_PIN },
 status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
 {
     (void)(slave);
-    fsp_err_t err = FSP_SUCCESS;     // Error status
     if ( pin > S2PI_IRQ )
     {
         return ERROR_INVALID_ARGUMENT;
@@ -381,13 +405,11 @@ status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
         return ERROR_S2PI_INVALID_STATE;
     }
 
-    //R_BSP_PinWrite( s2pi_gpios_[ pin ].pin, !!value );
-    err = R_IOPORT_PinWrite(&g_ioport_ctrl, (bsp_io_port_pin_t) s2pi_gpios_[ pin ].pin, value);
-    if(FSP_SUCCESS != err)
-    {
-        return ERROR_FAIL;
-    }
-    S2PI_GPIO_DELAY();
+    /* Set or reset the pin via the port output set/reset register. */
+    const uint32_t mask = S2PI_GPIO_MASK(s2pi_gpios_[ pin ].pin);
+    S2PI_GPIO_PORT(s2pi_gpios_[ pin ].pin)->PCNTR3 = value ? mask : mask << 16U;
+
+    S2PI_GpioDelay();
 
     return STATUS_OK;
 }
@@ -405,8 +427,6 @@ status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
 status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
 {
     (void)(slave);
-    //bsp_io_level_t value_pin;
-    fsp_err_t err = FSP_SUCCESS;     // Error status
     if ( pin > S2PI_IRQ )
         return ERROR_INVALID_ARGUMENT;
 
@@ -416,16 +436,11 @@ status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
         return ERROR_S2PI_INVALID_STATE;
     }
 
-    //*value = R_BSP_PinRead( s2pi_gpios_[ pin ].pin );
-    //err = R_IOPORT_PinRead(&g_ioport_ctrl, (bsp_io_port_pin_t) s2pi_gpios_[ pin ].pin, &value_pin);
-    //*value = (uint32_t)&value_pin;
-    *value = R_BSP_PinRead( s2pi_gpios_[ pin ].pin );
-    if(FSP_SUCCESS != err)
-    {
-        return ERROR_FAIL;
-    }
+    /* Read the pin via the port input data register. */
+    const uint32_t mask = S2PI_GPIO_MASK(s2pi_gpios_[ pin ].pin);
+    *value = (S2PI_GPIO_PORT(s2pi_gpios_[ pin ].pin)->PIDR & mask) ? 1U : 0U;
 
-    S2PI_GPIO_DELAY();
+    S2PI_GpioDelay();
 
     return STATUS_OK;
 }
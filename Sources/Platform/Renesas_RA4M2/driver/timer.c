@@ -42,22 +42,72 @@
 
 #include "driver/timer.h"
 #include "driver/irq.h"
+#include "timer_mux.h"
+#include "hr_clock.h"
 #include "bsp_api.h"
 #include "hal_data.h"
 
 /*******************************************************************************
- * Variables
- ******************************************************************************/
+ * Code
+ *******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Starts the GPT timer 1 to elapse after a given time.
+ *
+ * @details Used by the #timer_mux module to schedule the next interval event.
+ *
+ * @param   dt_microseconds The time until the next event; 0 stops the timer.
+ *****************************************************************************/
+static void GPT_Start(uint32_t dt_microseconds)
+{
+    fsp_err_t err = R_GPT_Stop(&g_pit_ctrl);
+    assert(err == FSP_SUCCESS);
+
+    if (dt_microseconds)
+    {
+        /* GPT is clocked by PCLKD. */
+        uint32_t pclkd = R_FSP_SystemClockHzGet(FSP_PRIV_CLOCK_PCLKD);
+        uint64_t ticks = ((uint64_t)dt_microseconds * (uint64_t)pclkd) / 1000000;
+        assert(g_pit_ctrl.variant == TIMER_VARIANT_32_BIT);
+        if (ticks == 0) ticks = 1;
+        if (ticks > UINT32_MAX) ticks = UINT32_MAX;
 
-/*! A pointer to the ISR function to be called when the timer has elapsed. */
-static timer_cb_t myISR = 0;
+        err = R_GPT_Reset(&g_pit_ctrl);
+        assert(err == FSP_SUCCESS);
 
-/*! The parameter to be passed to the callback. */
-static void * myParam = 0;
+        err = R_GPT_PeriodSet(&g_pit_ctrl, (uint32_t)ticks);
+        assert(err == FSP_SUCCESS);
 
-/*******************************************************************************
- * Code
- *******************************************************************************/
+        err = R_GPT_Start(&g_pit_ctrl);
+        assert(err == FSP_SUCCESS);
+    }
+    (void)err;
+}
+
+/*!***************************************************************************
+ * @brief   Reads the DWT cycle counter.
+ * @details Used as the 32-bit #hr_clock counter; extended to 64 bits there.
+ *****************************************************************************/
+static uint32_t DWT_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*!***************************************************************************
+ * @brief   Starts the DWT cycle counter and binds it to the #hr_clock.
+ * @details Requires the lifetime counter to be running. The clock falls back
+ *          to the lifetime counter if the core does not implement the cycle
+ *          counter.
+ *****************************************************************************/
+static void DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) return;
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    HRClock_Init32(DWT_GetCycles, SystemCoreClock);
+}
 
 void Timer_Init(void)
 {
@@ -73,12 +123,18 @@ void Timer_Init(void)
         err = R_GPT_Start(&g_ltc_ctrl);
         assert(err == FSP_SUCCESS);
 
+        /* The core cycle counter is the high resolution clock. */
+        DWT_Init();
+
         /********************************************************
          ***  Initialize timer 1 as periodic interrupt timer. ***
          ********************************************************/
         err = R_GPT_Open(&g_pit_ctrl, &g_pit_cfg);
         assert(err == FSP_SUCCESS);
 
+        /* Multiplex all intervals on timer 1. */
+        TimerMux_Init(GPT_Start);
+
         isInitialized = (err == FSP_SUCCESS);
     }
 }
@@ -98,6 +154,7 @@ void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
 
     const uint32_t cnt = g_ltc_ctrl.p_reg->GTCNT;
     if (cnt < prev_cnt) offset_sec += 4000;
+    prev_cnt = cnt;
 
     *lct = cnt % 1000000U;
     *hct = cnt / 1000000U + offset_sec;
@@ -105,58 +162,16 @@ void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
 
 status_t Timer_SetCallback(timer_cb_t f)
 {
-    myISR = f;
-    return STATUS_OK;
+    return TimerMux_SetCallback(f);
 }
 
 status_t Timer_SetInterval(uint32_t dt_microseconds, void * param)
 {
-    assert(dt_microseconds == 0 || dt_microseconds > 100);
-    if (dt_microseconds)
-    {
-        /* GPT is clocked by PCLKD. */
-        uint32_t pclkd = R_FSP_SystemClockHzGet(FSP_PRIV_CLOCK_PCLKD);
-        uint64_t ticks = ((uint64_t)dt_microseconds * (uint64_t)pclkd) / 1000000;
-        assert((ticks > 0) && (ticks < UINT32_MAX) && (g_pit_ctrl.variant == TIMER_VARIANT_32_BIT));
-
-        IRQ_LOCK();
-        myParam = param;
-
-        fsp_err_t err = R_GPT_PeriodSet(&g_pit_ctrl, (uint32_t)ticks);
-        if (FSP_SUCCESS != err)
-        {
-            IRQ_UNLOCK();
-            return ERROR_FAIL;
-        }
-
-        /* Starts GPT timer0 */
-        err = R_GPT_Start(&g_pit_ctrl);
-        if (FSP_SUCCESS != err)
-        {
-            IRQ_UNLOCK();
-            return ERROR_FAIL;
-        }
-
-        IRQ_UNLOCK();
-    }
-    else
-    {
-        IRQ_LOCK();
-        myParam = 0;
-
-        fsp_err_t err = R_GPT_Stop(&g_pit_ctrl);
-        if (FSP_SUCCESS != err)
-        {
-            IRQ_UNLOCK();
-            return ERROR_FAIL;
-        }
-        IRQ_UNLOCK();
-    }
-    return STATUS_OK;
+    return TimerMux_SetInterval(dt_microseconds, param);
 }
 
 void user_timer1_callback(timer_callback_args_t * p_args)
 {
     (void)p_args; //unused
-    myISR(myParam);
+    TimerMux_Handler();
 }
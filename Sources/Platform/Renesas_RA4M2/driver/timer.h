@@ -48,9 +48,11 @@
  *              functionalities: A periodic interrupt/callback timer and
  *              an lifetime counter.
  *
- *              Note that the current implementation only features a single
- *              callback timer interval and does not yet support the feature
- *              of multiple intervalls at a time.
+ *              Multiple callback intervals at a time are supported by
+ *              multiplexing them on the GPT timer 1 (see #timer_mux).
+ *
+ *              The DWT cycle counter of the core serves as the high
+ *              resolution clock (see #hr_clock) with core clock resolution.
  *
  * @addtogroup  timer
  * @{
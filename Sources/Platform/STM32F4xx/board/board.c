@@ -40,6 +40,7 @@
 #include "driver/uart.h"
 #include "driver/timer.h"
 #include "driver/flash.h"
+#include "driver/nvm.h"
 #include "debug.h" // declaration of print() and error_log()
 
 #if defined(STM32F401xE)
@@ -83,6 +84,14 @@ status_t Board_Init(void)
         return status;
     }
 
+    /* Initialize the NVM module; builds the slot directory. */
+    status = NVM_Init();
+    if (status < STATUS_OK)
+    {
+        error_log("NVM initialization failed, error code: %d", status);
+        return status;
+    }
+
     return STATUS_OK;
 }
 
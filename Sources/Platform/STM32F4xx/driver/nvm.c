@@ -77,6 +77,26 @@
         if (buf[idx + i] != v) { buf[idx + i] = v; } \
     } } while (0)
 
+/*! The maximum number of slots tracked by the slot directory. */
+#define NVM_DIRECTORY_SIZE (FLASH_API_BLOCK_SIZE / (ARGUS_NVM_BLOCK_SIZE + NVM_HEADER_SIZE))
+
+/*! The size of a slot, i.e. the header and the data block. */
+#define NVM_SLOT_SIZE (ARGUS_NVM_BLOCK_SIZE + NVM_HEADER_SIZE)
+
+/*! An entry of the slot directory, i.e. a copy of a slot header. */
+typedef struct nvm_slot_t
+{
+    /*! The chip ID of the device the slot belongs to. */
+    uint32_t ChipID;
+
+    /*! The slot count value; the higher the value, the newer the slot. */
+    uint32_t Count;
+
+    /*! True if the slot contains data of the current API version. */
+    bool Valid;
+
+} nvm_slot_t;
+
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -85,15 +105,69 @@
  * Variables
  ******************************************************************************/
 
+/*! The slot directory; built at #NVM_Init and updated on each write. This
+ *  avoids scanning the slot headers in the flash memory on each access. */
+static nvm_slot_t mySlots[NVM_DIRECTORY_SIZE] = { 0 };
+
+/*! Determines whether the slot directory is up to date. */
+static bool myDirectoryValid = false;
+
 /*******************************************************************************
  * Code
  ******************************************************************************/
 
+static status_t NVM_BuildDirectory(void)
+{
+    myDirectoryValid = false;
+
+    for (uint32_t i = 0; i < NVM_DIRECTORY_SIZE; ++i)
+    {
+        /* Read slot header from NVM memory. */
+        uint8_t header[NVM_HEADER_SIZE] = { 0 };
+        status_t status = Flash_Read(FLASH_API_BLOCK_INDEX, i * NVM_SLOT_SIZE, header, NVM_HEADER_SIZE);
+        if (status < STATUS_OK) return status;
+
+        /* If version is not the current, the slot is considered to be empty. */
+        mySlots[i].Valid = NVM_GET32(header, NVM_VERSION_IDX) == Argus_GetAPIVersion();
+        mySlots[i].ChipID = NVM_GET32(header, NVM_CHIP_ID_IDX);
+        mySlots[i].Count = NVM_GET32(header, NVM_SLOT_COUNT_IDX);
+    }
+
+    myDirectoryValid = true;
+    return STATUS_OK;
+}
+
+static int32_t NVM_FindSlot(uint32_t device_id)
+{
+    /* Find the newest valid slot of the device. */
+    int32_t slot_idx = -1;
+    for (uint32_t i = 0; i < NVM_DIRECTORY_SIZE; ++i)
+    {
+        if (mySlots[i].Valid && mySlots[i].ChipID == device_id &&
+            (slot_idx < 0 || mySlots[i].Count > mySlots[slot_idx].Count))
+        {
+            slot_idx = (int32_t)i;
+        }
+    }
+    return slot_idx;
+}
+
+status_t NVM_Init(void)
+{
+    return NVM_BuildDirectory();
+}
+
 status_t NVM_WriteBlock(uint32_t device_id, uint32_t block_size, uint8_t const * buf)
 {
     assert(block_size == ARGUS_NVM_BLOCK_SIZE);
     assert(FLASH_BLOCK_SIZE >= NVM_HEADER_SIZE + block_size);
 
+    if (!myDirectoryValid)
+    {
+        status_t status = NVM_BuildDirectory();
+        if (status < STATUS_OK) return status;
+    }
+
     /* Find empty slot or the one which is already used with the device.
      *
      *  - Each slot has a counter, version and device id written as identifier.
@@ -101,80 +175,83 @@ status_t NVM_WriteBlock(uint32_t device_id, uint32_t block_size, uint8_t const *
      *  - If all slots are occupied, the oldest slot is used, determined by a counter.
      *  - Each write to a slot increments a counter value to determine the oldest slot
      *    (i.e. the one with the lowest counter value.)
+     *
+     *  The slot headers are taken from the slot directory.
      *  */
 
-    int32_t slot_idx = -1;              // the index of the newest slot
+    int32_t slot_idx = NVM_FindSlot(device_id); // the index of the slot of the device
+    int32_t empty_idx = -1;             // the index of the first empty slot
     int32_t oldest_idx = -1;            // the index of the oldest slot
-    uint32_t slot_count = 0;            // current slot count; must be increase if < max_count
     uint32_t max_count = 0;             // max count of all slots; determines the newest slot
     uint32_t min_count = UINT32_MAX;    // min count of all slots; determines the oldest slot;
-    uint8_t data[FLASH_BLOCK_SIZE] = { 0 };
 
-    for (uint32_t offset = 0; offset < FLASH_API_BLOCK_SIZE; offset += (block_size + NVM_HEADER_SIZE))
+    for (uint32_t i = 0; i < NVM_DIRECTORY_SIZE; ++i)
     {
-        /* Read slot header from NVM memory. */
-        status_t status = Flash_Read(FLASH_API_BLOCK_INDEX, offset, data, NVM_HEADER_SIZE);
-        if (status < STATUS_OK) break;
-
-        /* Slot empty? -> Save index as potential slot. */
-        if (NVM_GET32(data, NVM_VERSION_IDX) != Argus_GetAPIVersion())
+        if (!mySlots[i].Valid)
         {
-            if (slot_idx < 0)
-            {
-                slot_idx = offset;
-            }
+            if (empty_idx < 0) empty_idx = (int32_t)i;
         }
         else
         {
-            /* Find current max. count. */
-            if (NVM_GET32(data, NVM_SLOT_COUNT_IDX) > max_count)
-            {
-                max_count = NVM_GET32(data, NVM_SLOT_COUNT_IDX);
-            }
-
-            /* Find min. count of all non-empty slots. */
-            if (NVM_GET32(data, NVM_SLOT_COUNT_IDX) <= min_count)
-            {
-                oldest_idx = offset;
-                min_count = NVM_GET32(data, NVM_SLOT_COUNT_IDX);
-            }
+            if (mySlots[i].Count > max_count) max_count = mySlots[i].Count;
 
-            /* Slot already used for current device? -> Save index. */
-            if (NVM_GET32(data, NVM_CHIP_ID_IDX) == device_id)
+            if (mySlots[i].Count <= min_count)
             {
-                slot_idx = offset;
+                oldest_idx = (int32_t)i;
+                min_count = mySlots[i].Count;
             }
         }
     }
 
-    /* If no slot has been found -> use oldest */
-    if (slot_idx < 0)
-    {
-        slot_idx = oldest_idx;
-    }
+    /* If no slot has been found -> use empty or oldest */
+    if (slot_idx < 0) slot_idx = empty_idx;
+    if (slot_idx < 0) slot_idx = oldest_idx;
 
     /* Increase the slot count . */
-    slot_count = max_count + 1;
+    const uint32_t slot_count = max_count + 1;
 
     /* Write Header */
+    uint8_t data[NVM_SLOT_SIZE] = { 0 };
     NVM_SET32(data, NVM_SLOT_COUNT_IDX, slot_count);
     NVM_SET32(data, NVM_CHIP_ID_IDX, device_id);
     NVM_SET32(data, NVM_VERSION_IDX, Argus_GetAPIVersion());
     memcpy(&(data[NVM_HEADER_SIZE]), buf, block_size);
 
-    /* Write Data. */
-    return Flash_Write(FLASH_API_BLOCK_INDEX, slot_idx, data, FLASH_BLOCK_SIZE);
+    /* Write Data; only the slot itself in order to keep the next slot's header. */
+    status_t status = Flash_Write(FLASH_API_BLOCK_INDEX, (uint32_t)slot_idx * NVM_SLOT_SIZE,
+                                  data, NVM_SLOT_SIZE);
+    if (status < STATUS_OK)
+    {
+        /* The flash contents are unknown; rebuild on next access. */
+        myDirectoryValid = false;
+        return status;
+    }
+
+    mySlots[slot_idx].Valid = true;
+    mySlots[slot_idx].ChipID = device_id;
+    mySlots[slot_idx].Count = slot_count;
+    return STATUS_OK;
 }
 
 status_t NVM_ReadBlock(uint32_t device_id, uint32_t block_size, uint8_t * buf)
 {
     assert(block_size == ARGUS_NVM_BLOCK_SIZE);
-    status_t status = STATUS_OK;
+    status_t status = myDirectoryValid ? STATUS_OK : NVM_BuildDirectory();
 
-    /* Read Non-Volatile memory from the platform. */
-    for (uint32_t offset = 0; offset < FLASH_API_BLOCK_SIZE; offset += (block_size + NVM_HEADER_SIZE))
+    /* The flash may have been cleared behind the directory (e.g. by
+     * #Flash_ClearAll); the slot header is verified and the directory is
+     * rebuilt once on mismatch. */
+    for (uint8_t attempt = 0; attempt < 2 && status == STATUS_OK; ++attempt)
     {
+        const int32_t slot_idx = NVM_FindSlot(device_id);
+        if (slot_idx < 0)
+        {
+            status = ERROR_NVM_EMPTY;
+            break;
+        }
+
         /* Read slot header from NVM memory. */
+        const uint32_t offset = (uint32_t)slot_idx * NVM_SLOT_SIZE;
         uint8_t header[NVM_HEADER_SIZE] = { 0 };
         status = Flash_Read(FLASH_API_BLOCK_INDEX, offset, header, NVM_HEADER_SIZE);
         if (status < STATUS_OK) break;
@@ -189,7 +266,7 @@ status_t NVM_ReadBlock(uint32_t device_id, uint32_t block_size, uint8_t * buf)
             return STATUS_OK;
         }
 
-        status = ERROR_NVM_EMPTY;
+        status = NVM_BuildDirectory();
     }
 
     /* Reset buffer in case of any error. */
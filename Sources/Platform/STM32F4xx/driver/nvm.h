@@ -54,5 +54,19 @@
 
 #include "platform/argus_nvm.h"
 
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Initializes the non-volatile memory module.
+ * @details Builds the RAM directory of the NVM slots by reading the slot
+ *          headers once. Subsequent reads and writes look up the slot of a
+ *          device in the directory instead of scanning the flash memory.
+ *          Requires the flash module to be initialized (#Flash_Init).
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVM_Init(void);
+
 /*! @} */
 #endif /* NVM_H */
@@ -45,6 +45,8 @@
 #include "gpio.h"
 #include "spi.h"
 #include "board/board_config.h"
+#include "s2pi_queue.h"
+#include "s2pi_trace.h"
 
 /*******************************************************************************
  * Definitions
@@ -103,23 +105,86 @@ typedef struct s2pi_hnd_t
     /*! A mutex used for queue operations. */
     volatile bool SpiMutexBlocked;
 
+    /*! The baud rate prescaler setting of each slave; applied whenever a
+     *  transfer to the slave is started.
+     * Note: slave index starts with 1, so the array size needs an extra element */
+    uint32_t BaudRatePrescaler[S2PI_SLAVE_COUNT+1];
+
+    /*! The number of core cycles for #S2PI_GPIO_DELAY_NS. */
+    uint32_t GpioDelayCycles;
+
+    /*! The slave that has captured the GPIO mode; 0 if not in GPIO mode. */
+    s2pi_slave_t GpioSlave;
+
+    /*! The identifier of the trace record of the ongoing transfer. */
+    uint32_t TraceId;
+
+#if S2PI_LL_DMA
+    /*! The preconfigured control register value of the RX DMA stream. */
+    uint32_t DmaRxCR;
+
+    /*! The preconfigured control register value of the TX DMA stream. */
+    uint32_t DmaTxCR;
+
+    /*! Dummy variable for unused Rx data. */
+    uint8_t RxSink;
+#endif
+
 } s2pi_hnd_t;
 
+/*! Enables the binary S2PI transfer trace, see #S2PITrace_Begin. The trace
+ *  takes two clock reads per transfer and can be left enabled. */
+#ifndef S2PI_TRACE
+#define S2PI_TRACE 1
+#endif
 
-/*! An additional delay to be added after each GPIO access in order to decrease
- *  the baud rate of the software EEPROM protocol. Increase the delay if timing
- *  issues occur while reading the EERPOM.
- *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz */
-#ifndef S2PI_GPIO_DELAY_US
-#define S2PI_GPIO_DELAY_US 10
+#if S2PI_TRACE
+#define S2PI_TRACE_BEGIN(slave, size) (myS2PIHnd.TraceId = S2PITrace_Begin(slave, size))
+#define S2PI_TRACE_END(status) S2PITrace_End(myS2PIHnd.TraceId, status)
+#else
+#define S2PI_TRACE_BEGIN(slave, size) (void)0
+#define S2PI_TRACE_END(status) (void)0
 #endif
 
 
-#if (S2PI_GPIO_DELAY_US == 0)
-#define S2PI_GPIO_DELAY() ((void)0)
+/*! An additional delay in nanoseconds to be added after each GPIO write in
+ *  order to decrease the baud rate of the software EEPROM protocol. Increase
+ *  the delay if timing issues occur while reading the EERPOM.
+ *  e.g. Delay = 10 µsec => Baud Rate < 100 kHz
+ *  The former #S2PI_GPIO_DELAY_US setting is still considered if defined. */
+#ifndef S2PI_GPIO_DELAY_NS
+#ifdef S2PI_GPIO_DELAY_US
+#define S2PI_GPIO_DELAY_NS (S2PI_GPIO_DELAY_US * 1000U)
 #else
-#include "utility/time.h"
-#define S2PI_GPIO_DELAY() Time_DelayUSec(S2PI_GPIO_DELAY_US)
+#define S2PI_GPIO_DELAY_NS 10000U
+#endif
+#endif
+
+/*! Writes a GPIO pin via the bit set/reset register. */
+#define S2PI_GPIO_WRITE(port, pin, value) \
+    ((port)->BSRR = (value) ? (uint32_t)(pin) : (uint32_t)(pin) << 16U)
+
+/*! Reads a GPIO pin via the input data register. */
+#define S2PI_GPIO_READ(port, pin) (((port)->IDR & (pin)) ? 1U : 0U)
+
+#if S2PI_LL_DMA
+/*! The DMA stream of the SPI receiver; must match the DMA setup of #MX_SPI1_Init. */
+#define S2PI_DMA_RX DMA2_Stream0
+
+/*! The DMA stream of the SPI transmitter; must match the DMA setup of #MX_SPI1_Init. */
+#define S2PI_DMA_TX DMA2_Stream3
+
+/*! All interrupt flags of the RX DMA stream (stream 0, i.e. in LISR/LIFCR). */
+#define S2PI_DMA_RX_FLAGS (DMA_LIFCR_CFEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CTEIF0 \
+                         | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTCIF0)
+
+/*! All interrupt flags of the TX DMA stream (stream 3, i.e. in LISR/LIFCR). */
+#define S2PI_DMA_TX_FLAGS (DMA_LIFCR_CFEIF3 | DMA_LIFCR_CDMEIF3 | DMA_LIFCR_CTEIF3 \
+                         | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTCIF3)
+
+/*! The DMA stream control bits that are not taken over from the HAL setup. */
+#define S2PI_DMA_CR_IRQ_MASK (DMA_SxCR_EN | DMA_SxCR_TCIE | DMA_SxCR_HTIE \
+                            | DMA_SxCR_TEIE | DMA_SxCR_DMEIE)
 #endif
 
 
@@ -131,9 +196,37 @@ static inline status_t S2PI_SetSlaveInternal(s2pi_slave_t slave);
 
 static inline void S2PI_SetGPIOMode(bool gpio_mode);
 
+/*! Leaves the GPIO mode and starts the next queued transfer. */
+static void S2PI_ReleaseGpioInternal(void);
+
+/*! Applies the baud rate prescaler of the specified slave to the SPI hardware. */
+static inline void S2PI_ApplyBaudRate(s2pi_slave_t slave);
+
+/*! Starts a single SPI transfer; the driver status must be busy already. */
+static status_t S2PI_StartTransfer(s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData);
+
+/*! Starts the next queued SPI transfer if the driver is idle. */
+static void S2PI_StartNext(void);
+
 /*! Initializes the required pins. */
 static inline void S2PI_InitPins();
 
+/*! Busy waits for #S2PI_GPIO_DELAY_NS on the DWT cycle counter. */
+static inline void S2PI_GpioDelay(void);
+
+#if S2PI_LL_DMA
+/*! Takes over the DMA streams from the HAL and keeps them preconfigured. */
+static void S2PI_InitDma(void);
+
+/*! Stops the DMA streams and drains the SPI receiver. */
+static void S2PI_StopDma(void);
+#endif
+
 
 /******************************************************************************
  * Variables
@@ -161,13 +254,26 @@ status_t S2PI_Init(s2pi_slave_t defaultSlave,
 
     S2PI_InitPins();
 
+#if S2PI_LL_DMA
+    S2PI_InitDma();
+#endif
+
     if (defaultSlave < 0)
         defaultSlave = S2PI_SLAVE1;
 
     if (defaultSlave > S2PI_SLAVE_COUNT)
         return ERROR_S2PI_INVALID_SLAVE;
 
-    return S2PI_SetBaudRate(defaultSlave, baudRate_Bps);
+    S2PIQueue_Init();
+
+    /* All slaves start with the default baud rate. */
+    for (s2pi_slave_t slave = 1; slave <= S2PI_SLAVE_COUNT; ++slave)
+    {
+        status_t status = S2PI_SetBaudRate(slave, baudRate_Bps);
+        if (status < STATUS_OK) return status;
+    }
+
+    return STATUS_OK;
 }
 static inline void S2PI_InitPins()
 {
@@ -298,6 +404,7 @@ static inline status_t S2PI_SetSlaveInternal(s2pi_slave_t slave)
     }
 
     myS2PIHnd.Slave = slave;
+    S2PI_ApplyBaudRate(slave);
 
     return STATUS_OK;
 }
@@ -335,33 +442,54 @@ static inline void S2PI_SetGPIOMode(bool gpio_mode)
 
 status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps)
 {
-    (void) slave; // not used in this implementation
+    if (slave <= 0 || slave > S2PI_SLAVE_COUNT)
+        return ERROR_S2PI_INVALID_SLAVE;
+
     uint32_t prescaler = 0;
     /* Determine the maximum value of the prescaler */
     for (; prescaler < 8; ++prescaler)
         if (SystemCoreClock >> (prescaler + 1) <= baudRate_Bps)
             break;
-    MODIFY_REG(hspi1.Instance->CR1, SPI_CR1_BR, prescaler << SPI_CR1_BR_Pos);
+    myS2PIHnd.BaudRatePrescaler[slave] = prescaler;
+
+    /* Applied immediately for the current slave; other slaves get
+     * their baud rate when their next transfer is started. */
+    if (slave == myS2PIHnd.Slave)
+        S2PI_ApplyBaudRate(slave);
+
     return STATUS_OK;
 }
 
+static inline void S2PI_ApplyBaudRate(s2pi_slave_t slave)
+{
+    const uint32_t br = myS2PIHnd.BaudRatePrescaler[slave] << SPI_CR1_BR_Pos;
+    if ((hspi1.Instance->CR1 & SPI_CR1_BR) != br)
+        MODIFY_REG(hspi1.Instance->CR1, SPI_CR1_BR, br);
+}
+
 uint32_t S2PI_GetBaudRate(s2pi_slave_t slave)
 {
-    (void) slave; // not used in this implementation
-    uint32_t prescaler = (hspi1.Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
-    return SystemCoreClock >> (prescaler + 1);
+    if (slave <= 0 || slave > S2PI_SLAVE_COUNT)
+        slave = myS2PIHnd.Slave;
+    return SystemCoreClock >> (myS2PIHnd.BaudRatePrescaler[slave] + 1);
 }
 
 status_t S2PI_GetStatus(s2pi_slave_t slave)
 {
-    (void) slave; // not used in this implementation
-    return myS2PIHnd.Status;
+    /* A slave is idle while the bus is occupied by another slave. */
+    IRQ_LOCK();
+    status_t status = myS2PIHnd.Status;
+    if (S2PIQueue_IsPending(slave))
+        status = STATUS_BUSY;
+    else if (status == STATUS_BUSY && myS2PIHnd.Slave != slave)
+        status = STATUS_IDLE;
+    IRQ_UNLOCK();
+
+    return status;
 }
 
 status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
 {
-    (void) slave; // not used in this implementation
-
     /* Check if something is ongoing. */
     IRQ_LOCK();
     status_t status = myS2PIHnd.Status;
@@ -371,6 +499,7 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
         return status;
     }
     myS2PIHnd.Status = STATUS_S2PI_GPIO_MODE;
+    myS2PIHnd.GpioSlave = slave;
     IRQ_UNLOCK();
 
     /* Note: Clock must be HI after capturing */
@@ -378,6 +507,15 @@ status_t S2PI_CaptureGpioControl(s2pi_slave_t slave)
 
     S2PI_SetGPIOMode(true);
 
+    /* The delays run on the DWT cycle counter; it is usually started by the
+     * timer module already. */
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    myS2PIHnd.GpioDelayCycles = ((SystemCoreClock / 1000000U) * S2PI_GPIO_DELAY_NS + 999U) / 1000U;
+
     return STATUS_OK;
 }
 
@@ -393,14 +531,26 @@ status_t S2PI_ReleaseGpioControl(s2pi_slave_t slave)
         IRQ_UNLOCK();
         return status;
     }
-    myS2PIHnd.Status = STATUS_IDLE;
     IRQ_UNLOCK();
 
-    S2PI_SetGPIOMode(false);
+    S2PI_ReleaseGpioInternal();
 
     return STATUS_OK;
 }
 
+static void S2PI_ReleaseGpioInternal(void)
+{
+    /* Deselect the slave; the CS is still driven via the GPIO. */
+    S2PI_WriteGpioPin(myS2PIHnd.GpioSlave, S2PI_CS, 1);
+
+    S2PI_SetGPIOMode(false);
+
+    myS2PIHnd.GpioSlave = 0;
+    myS2PIHnd.Status = STATUS_IDLE;
+
+    S2PI_StartNext();
+}
+
 status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
 {
     /* Check if pin is valid. */
@@ -413,28 +563,27 @@ status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
 
     if (pin == S2PI_CS)
     {
-        GPIO_PinState pinState = value ? GPIO_PIN_SET : GPIO_PIN_RESET;
         switch (slave)
         {
             case S2PI_SLAVE1:
-                HAL_GPIO_WritePin(S2PI_CS1_GPIO, S2PI_CS1_GPIO_PIN, pinState);
+                S2PI_GPIO_WRITE(S2PI_CS1_GPIO, S2PI_CS1_GPIO_PIN, value);
                 break;
 
 #if S2PI_SLAVE_COUNT >= 2
             case S2PI_SLAVE2:
-                HAL_GPIO_WritePin(S2PI_CS2_GPIO, S2PI_CS2_GPIO_PIN, pinState);
+                S2PI_GPIO_WRITE(S2PI_CS2_GPIO, S2PI_CS2_GPIO_PIN, value);
                 break;
 #endif
 
 #if S2PI_SLAVE_COUNT >= 3
             case S2PI_SLAVE3:
-                HAL_GPIO_WritePin(S2PI_CS3_GPIO, S2PI_CS3_GPIO_PIN, pinState);
+                S2PI_GPIO_WRITE(S2PI_CS3_GPIO, S2PI_CS3_GPIO_PIN, value);
                 break;
 #endif
 
 #if S2PI_SLAVE_COUNT >= 4
             case S2PI_SLAVE4:
-                HAL_GPIO_WritePin(S2PI_CS4_GPIO, S2PI_CS4_GPIO_PIN, pinState);
+                S2PI_GPIO_WRITE(S2PI_CS4_GPIO, S2PI_CS4_GPIO_PIN, value);
                 break;
 #endif
 
@@ -444,10 +593,10 @@ status_t S2PI_WriteGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t value)
     }
     else
     {
-        HAL_GPIO_WritePin(myS2PIHnd.GPIOs[pin].Port, myS2PIHnd.GPIOs[pin].Pin, value);
+        S2PI_GPIO_WRITE(myS2PIHnd.GPIOs[pin].Port, myS2PIHnd.GPIOs[pin].Pin, value);
     }
 
-    S2PI_GPIO_DELAY();
+    S2PI_GpioDelay();
 
     return STATUS_OK;
 }
@@ -467,24 +616,24 @@ status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
         switch (slave)
         {
             case S2PI_SLAVE1:
-                *value = HAL_GPIO_ReadPin(S2PI_CS1_GPIO, S2PI_CS1_GPIO_PIN);
+                *value = S2PI_GPIO_READ(S2PI_CS1_GPIO, S2PI_CS1_GPIO_PIN);
                 break;
 
 #if S2PI_SLAVE_COUNT >= 2
             case S2PI_SLAVE2:
-                *value = HAL_GPIO_ReadPin(S2PI_CS2_GPIO, S2PI_CS2_GPIO_PIN);
+                *value = S2PI_GPIO_READ(S2PI_CS2_GPIO, S2PI_CS2_GPIO_PIN);
                 break;
 #endif
 
 #if S2PI_SLAVE_COUNT >= 3
             case S2PI_SLAVE3:
-                *value = HAL_GPIO_ReadPin(S2PI_CS3_GPIO, S2PI_CS3_GPIO_PIN);
+                *value = S2PI_GPIO_READ(S2PI_CS3_GPIO, S2PI_CS3_GPIO_PIN);
                 break;
 #endif
 
 #if S2PI_SLAVE_COUNT >= 4
             case S2PI_SLAVE4:
-                *value = HAL_GPIO_ReadPin(S2PI_CS4_GPIO, S2PI_CS4_GPIO_PIN);
+                *value = S2PI_GPIO_READ(S2PI_CS4_GPIO, S2PI_CS4_GPIO_PIN);
                 break;
 #endif
 
@@ -494,14 +643,57 @@ status_t S2PI_ReadGpioPin(s2pi_slave_t slave, s2pi_pin_t pin, uint32_t * value)
     }
     else
     {
-        *value = HAL_GPIO_ReadPin(myS2PIHnd.GPIOs[pin].Port, myS2PIHnd.GPIOs[pin].Pin);
+        *value = S2PI_GPIO_READ(myS2PIHnd.GPIOs[pin].Port, myS2PIHnd.GPIOs[pin].Pin);
     }
 
-    S2PI_GPIO_DELAY();
+    S2PI_GpioDelay();
 
     return STATUS_OK;
 }
 
+status_t S2PI_TransferGpioBits(s2pi_slave_t slave, uint32_t txData,
+                               uint32_t * rxData, uint32_t bitCount)
+{
+    (void) slave; // not used in this implementation
+
+    if (bitCount == 0 || bitCount > 32U)
+        return ERROR_INVALID_ARGUMENT;
+
+    /* Check if in GPIO mode. */
+    if (myS2PIHnd.Status != STATUS_S2PI_GPIO_MODE)
+        return ERROR_S2PI_INVALID_STATE;
+
+    GPIO_TypeDef * const clkPort = myS2PIHnd.GPIOs[S2PI_CLK].Port;
+    GPIO_TypeDef * const mosiPort = myS2PIHnd.GPIOs[S2PI_MOSI].Port;
+    GPIO_TypeDef * const misoPort = myS2PIHnd.GPIOs[S2PI_MISO].Port;
+    const uint32_t clkPin = myS2PIHnd.GPIOs[S2PI_CLK].Pin;
+    const uint32_t mosiPin = myS2PIHnd.GPIOs[S2PI_MOSI].Pin;
+    const uint32_t misoPin = myS2PIHnd.GPIOs[S2PI_MISO].Pin;
+
+    /* SPI mode 3, MSB first: shift out on the falling and sample on the
+     * rising CLK edge; the CLK idles high. */
+    uint32_t rx = 0;
+    for (uint32_t mask = 1U << (bitCount - 1U); mask; mask >>= 1U)
+    {
+        S2PI_GPIO_WRITE(clkPort, clkPin, 0);
+        S2PI_GPIO_WRITE(mosiPort, mosiPin, txData & mask);
+        S2PI_GpioDelay();
+
+        S2PI_GPIO_WRITE(clkPort, clkPin, 1);
+        rx = (rx << 1U) | S2PI_GPIO_READ(misoPort, misoPin);
+        S2PI_GpioDelay();
+    }
+
+    if (rxData) *rxData = rx;
+    return STATUS_OK;
+}
+
+static inline void S2PI_GpioDelay(void)
+{
+    const uint32_t start = DWT->CYCCNT;
+    while (DWT->CYCCNT - start < myS2PIHnd.GpioDelayCycles);
+}
+
 status_t S2PI_CycleCsPin(s2pi_slave_t slave)
 {
     /* Check the driver status. */
@@ -550,6 +742,8 @@ status_t S2PI_CycleCsPin(s2pi_slave_t slave)
 
     myS2PIHnd.Status = STATUS_IDLE;
 
+    S2PI_StartNext();
+
     return status;
 }
 
@@ -564,28 +758,77 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
     if (!txData || frameSize == 0 || frameSize > UINT16_MAX)
         return ERROR_INVALID_ARGUMENT;
 
-    /* Check the driver status, lock if idle. */
+    /* Check the driver status, lock if idle; queue the frame otherwise. */
     IRQ_LOCK();
     status_t status = myS2PIHnd.Status;
     if (status != STATUS_IDLE)
     {
+        status = S2PIQueue_Push(slave, txData, rxData, frameSize, callback, callbackData);
         IRQ_UNLOCK();
         return status;
     }
     myS2PIHnd.Status = STATUS_BUSY;
     IRQ_UNLOCK();
 
+    status = S2PI_StartTransfer(slave, txData, rxData, frameSize, callback, callbackData);
+    if (status < STATUS_OK)
+    {
+        myS2PIHnd.Status = STATUS_IDLE;
+        S2PI_StartNext();
+    }
+
+    return status;
+}
+
+static status_t S2PI_StartTransfer(s2pi_slave_t slave,
+                                   uint8_t const * txData,
+                                   uint8_t * rxData,
+                                   size_t frameSize,
+                                   s2pi_callback_t callback,
+                                   void * callbackData)
+{
+    /* Manually set the chip select (active low) */
+    status_t status = S2PI_SetSlaveInternal(slave);
+    if (status < STATUS_OK)
+        return status;
+
     /* Set the callback information */
     myS2PIHnd.Callback = callback;
     myS2PIHnd.CallbackData = callbackData;
 
-    /* Manually set the chip select (active low) */
-    status = S2PI_SetSlaveInternal(slave);
-    if (status == STATUS_OK)
+    S2PIQueue_TransferStarted(slave, frameSize);
+    S2PI_TRACE_BEGIN(slave, frameSize);
+
+#if S2PI_LL_DMA
+    S2PI_GPIO_WRITE(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, 0);
+
+    /* Only the addresses and counts are reloaded; the streams have been
+     * disabled by the hardware at the end of the previous transfer. The RX
+     * stream runs for TX only transfers as well in order to complete all
+     * transfers with the RX stream interrupt. No interrupt lock is required
+     * since the transfer does not start before the TX stream is enabled. */
+    DMA2->LIFCR = S2PI_DMA_RX_FLAGS | S2PI_DMA_TX_FLAGS;
+
+    S2PI_DMA_RX->NDTR = frameSize;
+    if (rxData)
+    {
+        S2PI_DMA_RX->M0AR = (uint32_t)rxData;
+        S2PI_DMA_RX->CR = myS2PIHnd.DmaRxCR | DMA_SxCR_EN;
+    }
+    else
     {
-        HAL_GPIO_WritePin(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, GPIO_PIN_RESET);
+        S2PI_DMA_RX->M0AR = (uint32_t)&myS2PIHnd.RxSink;
+        S2PI_DMA_RX->CR = (myS2PIHnd.DmaRxCR & ~DMA_SxCR_MINC) | DMA_SxCR_EN;
     }
 
+    S2PI_DMA_TX->NDTR = frameSize;
+    S2PI_DMA_TX->M0AR = (uint32_t)txData;
+    S2PI_DMA_TX->CR = myS2PIHnd.DmaTxCR | DMA_SxCR_EN;
+
+    return STATUS_OK;
+#else
+    HAL_GPIO_WritePin(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, GPIO_PIN_RESET);
+
     HAL_StatusTypeDef hal_error;
 
     /* Lock interrupts to prevent completion interrupt before setup is complete */
@@ -597,10 +840,42 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
     IRQ_UNLOCK();
 
     if (hal_error != HAL_OK)
+    {
+        HAL_GPIO_WritePin(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, GPIO_PIN_SET);
+        S2PIQueue_TransferFinished(myS2PIHnd.Slave);
+        S2PI_TRACE_END(-1000-hal_error);
+        myS2PIHnd.Callback = 0;
         //return ERROR_FAIL;
         return -1000-hal_error;
+    }
 
-    return status;
+    return STATUS_OK;
+#endif
+}
+
+static void S2PI_StartNext(void)
+{
+    s2pi_queue_entry_t next;
+
+    for (;;)
+    {
+        IRQ_LOCK();
+        if (myS2PIHnd.Status != STATUS_IDLE || !S2PIQueue_Pop(&next, S2PI_QUEUE_ALL_SLAVES))
+        {
+            IRQ_UNLOCK();
+            return;
+        }
+        myS2PIHnd.Status = STATUS_BUSY;
+        IRQ_UNLOCK();
+
+        status_t status = S2PI_StartTransfer(next.Slave, next.TxData, next.RxData,
+                                             next.FrameSize, next.Callback, next.CallbackData);
+        if (status == STATUS_OK) return;
+
+        /* The queued frame could not be started; report to its caller. */
+        myS2PIHnd.Status = STATUS_IDLE;
+        if (next.Callback != 0) next.Callback(status, next.CallbackData);
+    }
 }
 
 
@@ -615,17 +890,29 @@ status_t S2PI_TransferFrame(s2pi_slave_t slave,
  ****************************************************************************/
 static inline status_t S2PI_CompleteTransfer(status_t status)
 {
-    myS2PIHnd.Status = STATUS_IDLE;
-
     /* Deactivate CS (set high), as we use GPIO pin */
+#if S2PI_LL_DMA
+    S2PI_GPIO_WRITE(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, 1);
+#else
     HAL_GPIO_WritePin(myS2PIHnd.GPIOs[S2PI_CS].Port, myS2PIHnd.GPIOs[S2PI_CS].Pin, GPIO_PIN_SET);
+#endif
+
+    S2PIQueue_TransferFinished(myS2PIHnd.Slave);
+    S2PI_TRACE_END(status);
+
+    s2pi_callback_t callback = myS2PIHnd.Callback;
+    void * callbackData = myS2PIHnd.CallbackData;
+    myS2PIHnd.Callback = 0;
+
+    myS2PIHnd.Status = STATUS_IDLE;
+
+    /* Start the next queued frame back to back, i.e. before the callback. */
+    S2PI_StartNext();
 
     /* Invoke callback if there is one */
-    if (myS2PIHnd.Callback != 0)
+    if (callback != 0)
     {
-        s2pi_callback_t callback = myS2PIHnd.Callback;
-        myS2PIHnd.Callback = 0;
-        status = callback(status, myS2PIHnd.CallbackData);
+        status = callback(status, callbackData);
     }
     return status;
 }
@@ -673,6 +960,83 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
         hspi->hdmatx->XferCpltCallback = SPI_DMATransmitReceiveCpltDelayed;
 }
 
+#if S2PI_LL_DMA
+static void S2PI_InitDma(void)
+{
+    /* Take over the stream setup of the HAL (direction, channel, data sizes,
+     * priority, ...) but replace the HAL interrupts by the transfer complete
+     * interrupt of the RX stream and the error interrupts. */
+    S2PI_DMA_RX->CR &= ~DMA_SxCR_EN;
+    S2PI_DMA_TX->CR &= ~DMA_SxCR_EN;
+    while ((S2PI_DMA_RX->CR | S2PI_DMA_TX->CR) & DMA_SxCR_EN);
+
+    myS2PIHnd.DmaRxCR = (S2PI_DMA_RX->CR & ~S2PI_DMA_CR_IRQ_MASK) | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    myS2PIHnd.DmaTxCR = (S2PI_DMA_TX->CR & ~S2PI_DMA_CR_IRQ_MASK) | DMA_SxCR_TEIE;
+    S2PI_DMA_RX->CR = myS2PIHnd.DmaRxCR;
+    S2PI_DMA_TX->CR = myS2PIHnd.DmaTxCR;
+    S2PI_DMA_RX->PAR = (uint32_t)&hspi1.Instance->DR;
+    S2PI_DMA_TX->PAR = (uint32_t)&hspi1.Instance->DR;
+    DMA2->LIFCR = S2PI_DMA_RX_FLAGS | S2PI_DMA_TX_FLAGS;
+
+    /* The SPI stays enabled with both DMA requests; the transfers are
+     * started by enabling the streams only. */
+    SET_BIT(hspi1.Instance->CR2, SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    __HAL_SPI_ENABLE(&hspi1);
+    S2PI_StopDma();
+}
+
+static void S2PI_StopDma(void)
+{
+    /* Stop the transmitter first and let the SPI shift out the pending data. */
+    S2PI_DMA_TX->CR &= ~DMA_SxCR_EN;
+    while (S2PI_DMA_TX->CR & DMA_SxCR_EN);
+    while (hspi1.Instance->SR & SPI_SR_BSY);
+
+    S2PI_DMA_RX->CR &= ~DMA_SxCR_EN;
+    while (S2PI_DMA_RX->CR & DMA_SxCR_EN);
+
+    /* Drain the receiver; a stale byte would be the first of the next frame.
+     * Reading DR and SR also clears a pending overrun. */
+    while (hspi1.Instance->SR & SPI_SR_RXNE) (void)hspi1.Instance->DR;
+    (void)hspi1.Instance->SR;
+
+    DMA2->LIFCR = S2PI_DMA_RX_FLAGS | S2PI_DMA_TX_FLAGS;
+}
+
+void S2PI_DmaRxIRQHandler(void)
+{
+    const uint32_t flags = DMA2->LISR;
+    DMA2->LIFCR = S2PI_DMA_RX_FLAGS;
+
+    if (myS2PIHnd.Status != STATUS_BUSY) return;
+
+    if (flags & DMA_LISR_TEIF0)
+    {
+        S2PI_StopDma();
+        S2PI_CompleteTransfer(ERROR_FAIL);
+    }
+    else if (flags & DMA_LISR_TCIF0)
+    {
+        /* All data has been received, i.e. the transmitter is done as well. */
+        S2PI_CompleteTransfer(STATUS_OK);
+    }
+}
+
+void S2PI_DmaTxIRQHandler(void)
+{
+    const uint32_t flags = DMA2->LISR;
+    DMA2->LIFCR = S2PI_DMA_TX_FLAGS;
+
+    if (myS2PIHnd.Status != STATUS_BUSY) return;
+
+    if (flags & DMA_LISR_TEIF3)
+    {
+        S2PI_StopDma();
+        S2PI_CompleteTransfer(ERROR_FAIL);
+    }
+}
+#endif
+
 status_t S2PI_TryGetMutex(s2pi_slave_t slave)
 {
     (void) slave; // not used in this implementation
@@ -703,20 +1067,39 @@ void S2PI_ReleaseMutex(s2pi_slave_t slave)
 
 status_t S2PI_Abort(s2pi_slave_t slave)
 {
-    (void) slave; // not used in this implementation
+    /* Remove the queued frames of the slave. */
+    s2pi_queue_entry_t entry;
+    while (S2PIQueue_Remove(slave, &entry))
+    {
+        if (entry.Callback != 0) entry.Callback(ERROR_ABORTED, entry.CallbackData);
+    }
 
     status_t status = myS2PIHnd.Status;
 
-    /* Check if something is ongoing. */
-    if(status == STATUS_IDLE)
+    /* Check if something is ongoing for the slave; a transfer or the GPIO
+     * mode of another slave is not touched. */
+    if (!((status == STATUS_BUSY && myS2PIHnd.Slave == slave) ||
+          (status == STATUS_S2PI_GPIO_MODE && myS2PIHnd.GpioSlave == slave)))
+    {
+        return STATUS_OK;
+    }
+
+    /* Leave the GPIO mode, i.e. deselect the slave and restore the SPI pins
+     * before any queued transfer is started. */
+    if (status == STATUS_S2PI_GPIO_MODE)
     {
+        S2PI_ReleaseGpioInternal();
         return STATUS_OK;
     }
 
     /* Abort SPI transfer. */
     if(status == STATUS_BUSY)
     {
+#if S2PI_LL_DMA
+        S2PI_StopDma();
+#else
         HAL_SPI_Abort(&hspi1);
+#endif
         myS2PIHnd.Status = STATUS_IDLE;
     }
 
@@ -61,6 +61,27 @@
 #include "platform/argus_s2pi.h"
 #include "board/board_config.h"
 
+/*!***************************************************************************
+ * @brief   Selects the register level (LL) transfer path.
+ *
+ * @details If enabled, the DMA streams of the SPI are configured once at
+ *          #S2PI_Init and only the addresses and counts are reloaded per
+ *          transfer. Each transfer completes with a single interrupt of the
+ *          RX DMA stream that calls the Argus callback directly. Otherwise,
+ *          the transfers are started via #HAL_SPI_TransmitReceive_DMA and
+ *          completed by the HAL callbacks, i.e. with up to four DMA
+ *          interrupts per transfer (half and full transfer of both streams).
+ *
+ *          The LL path requires the DMA stream interrupt handlers to call
+ *          #S2PI_DmaRxIRQHandler and #S2PI_DmaTxIRQHandler instead of the HAL
+ *          DMA interrupt handler, see the DMA2_Stream0_IRQHandler and
+ *          DMA2_Stream3_IRQHandler in the stm32f4xx_it.c file. Thus, the
+ *          symbol must be defined in the project wide preprocessor settings.
+ *****************************************************************************/
+#ifndef S2PI_LL_DMA
+#define S2PI_LL_DMA 0
+#endif
+
 
 /*!***************************************************************************
  * @brief   Initializes the S2PI module.
@@ -101,6 +122,45 @@ status_t S2PI_SetBaudRate(s2pi_slave_t slave, uint32_t baudRate_Bps);
  *****************************************************************************/
 status_t S2PI_SetSlave(s2pi_slave_t slave);
 
+/*!***************************************************************************
+ * @brief   Clocks a sequence of bits in GPIO mode (bulk bit-banging).
+ *
+ * @details An optional extension to the GPIO mode of the #argus_s2pi
+ *          interface that clocks up to 32 bits in a single call instead of
+ *          a #S2PI_WriteGpioPin / #S2PI_ReadGpioPin call per edge. The bits
+ *          are transferred MSB first in SPI mode 3, i.e. MOSI is changed after
+ *          the falling CLK edge and MISO is sampled at the rising CLK edge.
+ *          The CS pin is not touched. Each CLK phase lasts at least
+ *          S2PI_GPIO_DELAY_NS.
+ *
+ *          The GPIO mode must have been captured via #S2PI_CaptureGpioControl
+ *          before.
+ *
+ * @param   slave The specified S2PI slave.
+ * @param   txData The bits to be written to the MOSI pin; right aligned.
+ * @param   rxData The bits read from the MISO pin; right aligned. May be null.
+ * @param   bitCount The number of bits to transfer; 1 to 32.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *          - #ERROR_S2PI_INVALID_STATE if the driver is not in GPIO mode.
+ *****************************************************************************/
+status_t S2PI_TransferGpioBits(s2pi_slave_t slave, uint32_t txData,
+                               uint32_t * rxData, uint32_t bitCount);
+
+#if S2PI_LL_DMA
+/*!***************************************************************************
+ * @brief   The interrupt handler of the RX DMA stream of the #S2PI_LL_DMA path.
+ * @details Completes the ongoing transfer and invokes its callback.
+ *****************************************************************************/
+void S2PI_DmaRxIRQHandler(void);
+
+/*!***************************************************************************
+ * @brief   The interrupt handler of the TX DMA stream of the #S2PI_LL_DMA path.
+ * @details Completes the ongoing transfer with an error on DMA errors.
+ *****************************************************************************/
+void S2PI_DmaTxIRQHandler(void);
+#endif
+
 
 /*! @} */
 #endif // S2PI_H
@@ -36,14 +36,79 @@
 
 #include "timer.h"
 #include "tim.h"
+#include "timer_mux.h"
+#include "hr_clock.h"
 #include <assert.h>
 
+/*!***************************************************************************
+ * @brief   Starts the TIM4 timer to elapse after a given time.
+ *
+ * @details Used by the #timer_mux module to schedule the next interval event.
+ *          TIM4 is clocked with 1 MHz (see #Timer_Init), thus intervals that
+ *          exceed the 16-bit range are clamped to the maximum period; the
+ *          multiplexer ignores these early events.
+ *
+ *          The registers are accessed directly (instead of via the HAL state
+ *          machine) since the function is also called from the TIM4 ISR.
+ *
+ * @param   dt_microseconds The time until the next event; 0 stops the timer.
+ *****************************************************************************/
+static void TIM4_Start(uint32_t dt_microseconds)
+{
+    /* Disable interrupt and timer */
+    __HAL_TIM_DISABLE_IT(&htim4, TIM_IT_UPDATE);
+    __HAL_TIM_DISABLE(&htim4);
+
+    if (dt_microseconds)
+    {
+        if (dt_microseconds > 0x10000U) dt_microseconds = 0x10000U;
+
+        /* Set period value and reset counter. */
+        __HAL_TIM_SET_AUTORELOAD(&htim4, dt_microseconds - 1);
+        __HAL_TIM_SET_COUNTER(&htim4, 0);
+
+        /* The following generates an update event that triggers and update
+         * of the auto-reload into the internal shadow registers. This is
+         * required to update the timer configuration before the next update
+         * event (i.e. under/overflow). Unfortunately this also generates
+         * and immediate interrupt wich is cleared in the next statement. */
+        htim4.Instance->EGR = TIM_EGR_UG;
+        __HAL_TIM_CLEAR_IT(&htim4, TIM_IT_UPDATE); // clear interrupt
 
-/*! Storage for the callback parameter */
-static void * callback_param_;
+        /* Enable interrupt and timer */
+        __HAL_TIM_ENABLE_IT(&htim4, TIM_IT_UPDATE);
+        __HAL_TIM_ENABLE(&htim4);
+    }
+    else
+    {
+        __HAL_TIM_CLEAR_IT(&htim4, TIM_IT_UPDATE); // clear interrupt
+    }
+}
 
-/*! Callback function for PIT timer */
-static timer_cb_t timer_callback_;
+/*!***************************************************************************
+ * @brief   Reads the DWT cycle counter.
+ * @details Used as the 32-bit #hr_clock counter; extended to 64 bits there.
+ *****************************************************************************/
+static uint32_t DWT_GetCycles(void)
+{
+    return DWT->CYCCNT;
+}
+
+/*!***************************************************************************
+ * @brief   Starts the DWT cycle counter and binds it to the #hr_clock.
+ * @details Requires the lifetime counter to be running. The clock falls back
+ *          to the lifetime counter if the core does not implement the cycle
+ *          counter.
+ *****************************************************************************/
+static void DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    if (DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk) return;
+
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    HRClock_Init32(DWT_GetCycles, SystemCoreClock);
+}
 
 /*!***************************************************************************
  * @brief   Initializes the timer hardware.
@@ -63,6 +128,15 @@ void Timer_Init(void)
     __HAL_DBGMCU_FREEZE_TIM2();
     __HAL_DBGMCU_FREEZE_TIM4();
     __HAL_DBGMCU_FREEZE_TIM5();
+
+    /* The core cycle counter is the high resolution clock. */
+    DWT_Init();
+
+    /* Clock the periodic interrupt timer with 1 MHz and multiplex
+     * all intervals on it. */
+    assert(SystemCoreClock / 1000000U < 0x10000U);
+    __HAL_TIM_SET_PRESCALER(&htim4, SystemCoreClock / 1000000U - 1);
+    TimerMux_Init(TIM4_Start);
 }
 
 #define DEBUG_TIMER 0
@@ -123,47 +197,7 @@ void Timer_GetCounterValue(uint32_t * hct, uint32_t * lct)
  *****************************************************************************/
 status_t Timer_SetInterval(uint32_t dt_microseconds, void * param)
 {
-    assert(dt_microseconds == 0 || dt_microseconds > 100);
-
-    /* Disable interrupt and timer */
-    callback_param_ = 0;
-    HAL_TIM_Base_Stop_IT(&htim4);
-    __HAL_TIM_CLEAR_IT(&htim4, TIM_IT_UPDATE);
-
-    if (dt_microseconds)
-    {
-        /* Determine the prescaler and counter period values such that
-         * the period fits into 16-bits. */
-        uint32_t prescaler = SystemCoreClock / 1000000U;
-        uint32_t period = dt_microseconds;
-
-        while (period > 0xFFFF)
-        {
-            period >>= 1U;
-            prescaler <<= 1U;
-        }
-
-        assert(prescaler < 0x10000U);
-
-        /* Set prescaler and period values and reset counter. */
-        __HAL_TIM_SET_PRESCALER(&htim4, prescaler - 1);
-        __HAL_TIM_SET_AUTORELOAD(&htim4, period - 1);
-        __HAL_TIM_SET_COUNTER(&htim4, period - 1);
-
-        /* The following generates an update event that triggers and update
-         * of the auto-reload into the internal shadow registers. This is
-         * required to update the timer configuration before the next update
-         * event (i.e. under/overflow). Unfortunately this also generates
-         * and immediate interrupt wich is cleared in the next statement. */
-        HAL_TIM_GenerateEvent(&htim4, TIM_EVENTSOURCE_UPDATE);
-        __HAL_TIM_CLEAR_IT(&htim4, TIM_IT_UPDATE); // clear interrupt
-
-        /* Enable interrupt and timer */
-        callback_param_ = param;
-        HAL_TIM_Base_Start_IT(&htim4);
-    }
-
-    return STATUS_OK;
+    return TimerMux_SetInterval(dt_microseconds, param);
 }
 
 /*!***************************************************************************
@@ -178,8 +212,7 @@ status_t Timer_SetInterval(uint32_t dt_microseconds, void * param)
  *****************************************************************************/
 status_t Timer_SetCallback(timer_cb_t f)
 {
-    timer_callback_ = f;
-    return STATUS_OK;
+    return TimerMux_SetCallback(f);
 }
 
 /**
@@ -189,9 +222,9 @@ status_t Timer_SetCallback(timer_cb_t f)
   */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
-    /* Trigger callback if the interrupt belongs to TIM4 and there is a callback */
-    if (htim == &htim4 && timer_callback_)
+    /* Trigger the interval handler if the interrupt belongs to TIM4 */
+    if (htim == &htim4)
     {
-        timer_callback_(callback_param_);
+        TimerMux_Handler();
     }
 }
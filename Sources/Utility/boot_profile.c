@@ -0,0 +1,206 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides a boot phase profiler that records timestamps in a
+ *              RAM region that survives resets.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "boot_profile.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The magic number of a valid no-init region ('BOOT'). */
+#define BOOT_PROFILE_MAGIC 0x424F4F54U
+
+/*! The region that survives resets. */
+typedef struct boot_region_t
+{
+    /*! The magic number, see #BOOT_PROFILE_MAGIC. */
+    uint32_t Magic;
+
+    /*! The inverted magic number xor the region size. */
+    uint32_t Check;
+
+    /*! The record of the current boot. */
+    boot_record_t Current;
+
+    /*! The record of the previous boot. */
+    boot_record_t Previous;
+
+    /*! Determines whether the previous record is valid. */
+    uint32_t HasPrevious;
+
+} boot_region_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The boot records; not initialized by the C runtime. */
+__attribute__((section(".noinit"))) static boot_region_t myRegion;
+
+/*! The clock. */
+static boot_profile_clock_t myClock = 0;
+
+/*! The offset that is added to the clock to keep the time scale continuous. */
+static uint32_t myOffset = 0;
+
+/*! The current nesting level. */
+static uint8_t myLevel = 0;
+
+/*! Determines whether the profiler has been started in this boot. */
+static bool isStarted = false;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline uint32_t GetCheck(void)
+{
+    return ~BOOT_PROFILE_MAGIC ^ (uint32_t)sizeof(boot_region_t);
+}
+
+static inline bool IsValid(boot_record_t const * record)
+{
+    return record->Count <= BOOT_PROFILE_MARK_COUNT;
+}
+
+static uint32_t GetTime(void)
+{
+    return myClock != 0 ? myClock() + myOffset : myOffset;
+}
+
+void BootProfile_Start(uint32_t resetCause)
+{
+    if (myRegion.Magic != BOOT_PROFILE_MAGIC || myRegion.Check != GetCheck() ||
+        !IsValid(&myRegion.Current))
+    {
+        /* Power-on reset or a different firmware layout. */
+        memset(&myRegion, 0, sizeof(myRegion));
+        myRegion.Magic = BOOT_PROFILE_MAGIC;
+        myRegion.Check = GetCheck();
+    }
+    else
+    {
+        myRegion.Previous = myRegion.Current;
+        myRegion.HasPrevious = 1;
+    }
+
+    const uint32_t bootCount = myRegion.Current.BootCount + 1U;
+    memset(&myRegion.Current, 0, sizeof(boot_record_t));
+    myRegion.Current.BootCount = bootCount;
+    myRegion.Current.ResetCause = resetCause;
+
+    myClock = 0;
+    myOffset = 0;
+    myLevel = 0;
+    isStarted = true;
+}
+
+void BootProfile_SetClock(boot_profile_clock_t clock)
+{
+    const uint32_t now = GetTime();
+    myClock = clock;
+    myOffset = 0;
+    myOffset = now - GetTime();
+}
+
+int32_t BootProfile_Begin(boot_phase_t phase, uint8_t param)
+{
+    if (!BootProfile_IsRecording()) return -1;
+
+    boot_record_t * record = &myRegion.Current;
+    if (record->Count >= BOOT_PROFILE_MARK_COUNT) return -1;
+
+    boot_mark_t * mark = &record->Marks[record->Count];
+    mark->Phase = (uint8_t)phase;
+    mark->Param = param;
+    mark->Level = myLevel++;
+    mark->Finished = 0;
+    mark->Start = GetTime();
+    mark->Duration = 0;
+
+    return (int32_t)record->Count++;
+}
+
+void BootProfile_End(int32_t mark)
+{
+    if (mark < 0 || !isStarted) return;
+
+    boot_record_t * record = &myRegion.Current;
+    assert((uint32_t)mark < record->Count);
+    if ((uint32_t)mark >= record->Count) return;
+
+    boot_mark_t * m = &record->Marks[mark];
+    if (m->Finished) return;
+
+    m->Duration = GetTime() - m->Start;
+    m->Finished = 1;
+    if (myLevel > 0) myLevel--;
+}
+
+void BootProfile_Event(boot_phase_t phase, uint8_t param)
+{
+    BootProfile_End(BootProfile_Begin(phase, param));
+}
+
+void BootProfile_Stop(void)
+{
+    if (isStarted) myRegion.Current.Finished = 1;
+}
+
+bool BootProfile_IsRecording(void)
+{
+    return isStarted && !myRegion.Current.Finished;
+}
+
+boot_record_t const * BootProfile_GetRecord(bool previous)
+{
+    if (!isStarted) return 0;
+    if (!previous) return &myRegion.Current;
+    return myRegion.HasPrevious ? &myRegion.Previous : 0;
+}
@@ -0,0 +1,247 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     Provides a boot phase profiler that records timestamps in a
+ *              RAM region that survives resets.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+/*!***************************************************************************
+ * @defgroup    boot_profile Boot Phase Profiler
+ * @ingroup     platform
+ * @brief       Boot Phase Timestamp Recorder
+ * @details     Records the start time and the duration of the boot phases
+ *              (e.g. clock setup, peripheral initialization, device discovery
+ *              and API initialization) until the first measurement frame.
+ *
+ *              The records are stored in a RAM region that is not
+ *              initialized by the C runtime (section ".noinit"). Thus, the
+ *              record of the previous boot is still available after a reset,
+ *              e.g. after a watchdog reset that interrupted the boot. The
+ *              linker script must place the ".noinit" section in RAM without
+ *              load data; the region is validated by a magic number and
+ *              cleared after a power-on reset.
+ *
+ *              The platform starts the profiler from its reset handler
+ *              (#BootProfile_Start) and provides a microsecond clock
+ *              (#BootProfile_SetClock). The clock can be replaced during the
+ *              boot, e.g. if an early clock is used until the timer module is
+ *              initialized; the time scale is kept continuous. The time zero
+ *              is the call of #BootProfile_Start.
+ *
+ *              Phases are recorded by #BootProfile_Begin and #BootProfile_End
+ *              and may be nested. The recording is finished by
+ *              #BootProfile_Stop; further calls are ignored.
+ *
+ * @addtogroup  boot_profile
+ * @{
+ *****************************************************************************/
+
+#include "utility/status.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*!***************************************************************************
+ * @brief   The maximum number of recorded phases per boot.
+ *****************************************************************************/
+#ifndef BOOT_PROFILE_MARK_COUNT
+#define BOOT_PROFILE_MARK_COUNT 24U
+#endif
+
+/*! The boot phases. */
+typedef enum boot_phase_t
+{
+    /*! The reset handler until the board initialization. */
+    BOOT_PHASE_STARTUP = 1,
+
+    /*! The board initialization, see #Board_Init. */
+    BOOT_PHASE_BOARD = 2,
+
+    /*! The clock setup. */
+    BOOT_PHASE_CLOCKS = 3,
+
+    /*! The timer module initialization. */
+    BOOT_PHASE_TIMER = 4,
+
+    /*! The UART module initialization. */
+    BOOT_PHASE_UART = 5,
+
+    /*! The S2PI module initialization. */
+    BOOT_PHASE_S2PI = 6,
+
+    /*! The flash module initialization. */
+    BOOT_PHASE_FLASH = 7,
+
+    /*! The NVM module initialization. */
+    BOOT_PHASE_NVM_INIT = 8,
+
+    /*! The device discovery. */
+    BOOT_PHASE_DISCOVERY = 9,
+
+    /*! The initialization of a device; the parameter is the device ID. */
+    BOOT_PHASE_DEVICE = 10,
+
+    /*! The search for a connected device; the parameter is the device ID. */
+    BOOT_PHASE_FIND_DEVICE = 11,
+
+    /*! The AFBR-S50 API initialization; the parameter is the device ID. */
+    BOOT_PHASE_ARGUS_INIT = 12,
+
+    /*! A NVM block read; the parameter is the lower byte of the ID. */
+    BOOT_PHASE_NVM_READ = 13,
+
+    /*! The systems communication interface initialization. */
+    BOOT_PHASE_SCI = 14,
+
+    /*! The task scheduler initialization. */
+    BOOT_PHASE_TASKS = 15,
+
+    /*! The first measurement frame has been sent; the parameter is the device ID. */
+    BOOT_PHASE_FIRST_FRAME = 16,
+
+} boot_phase_t;
+
+/*! A recorded boot phase. */
+typedef struct boot_mark_t
+{
+    /*! The boot phase, see #boot_phase_t. */
+    uint8_t Phase;
+
+    /*! A phase specific parameter, e.g. the device ID. */
+    uint8_t Param;
+
+    /*! The nesting level of the phase. */
+    uint8_t Level;
+
+    /*! Determines whether the phase has been finished. */
+    uint8_t Finished;
+
+    /*! The start time in microseconds since #BootProfile_Start. */
+    uint32_t Start;
+
+    /*! The duration in microseconds. */
+    uint32_t Duration;
+
+} boot_mark_t;
+
+/*! The record of a single boot. */
+typedef struct boot_record_t
+{
+    /*! The number of boots since the last power-on reset. */
+    uint32_t BootCount;
+
+    /*! The platform specific reset cause. */
+    uint32_t ResetCause;
+
+    /*! The number of recorded phases. */
+    uint32_t Count;
+
+    /*! Determines whether the recording has been finished (#BootProfile_Stop). */
+    uint32_t Finished;
+
+    /*! The recorded phases in the order of their start. */
+    boot_mark_t Marks[BOOT_PROFILE_MARK_COUNT];
+
+} boot_record_t;
+
+/*!***************************************************************************
+ * @brief   The clock function type.
+ * @return  Returns the elapsed time in microseconds on an arbitrary scale.
+ *****************************************************************************/
+typedef uint32_t (*boot_profile_clock_t)(void);
+
+/*!***************************************************************************
+ * @brief   Starts the recording of a new boot.
+ *
+ * @details Called from the reset handler after the C runtime initialization.
+ *          The current record is moved to the previous one (if valid) and a
+ *          new one is started. The clock is removed, i.e. all times are zero
+ *          until #BootProfile_SetClock is called.
+ *
+ * @param   resetCause The platform specific reset cause.
+ *****************************************************************************/
+void BootProfile_Start(uint32_t resetCause);
+
+/*!***************************************************************************
+ * @brief   Sets or replaces the clock.
+ * @details The new clock continues the time scale of the previous one.
+ * @param   clock The microsecond clock function.
+ *****************************************************************************/
+void BootProfile_SetClock(boot_profile_clock_t clock);
+
+/*!***************************************************************************
+ * @brief   Records the start of a boot phase.
+ * @param   phase The boot phase.
+ * @param   param A phase specific parameter.
+ * @return  Returns the handle of the phase that is passed to #BootProfile_End;
+ *          -1 if not recorded (stopped or all marks used).
+ *****************************************************************************/
+int32_t BootProfile_Begin(boot_phase_t phase, uint8_t param);
+
+/*!***************************************************************************
+ * @brief   Records the end of a boot phase.
+ * @param   mark The handle returned by #BootProfile_Begin; -1 is ignored.
+ *****************************************************************************/
+void BootProfile_End(int32_t mark);
+
+/*!***************************************************************************
+ * @brief   Records a single event, i.e. a phase w/o duration.
+ * @param   phase The boot phase.
+ * @param   param A phase specific parameter.
+ *****************************************************************************/
+void BootProfile_Event(boot_phase_t phase, uint8_t param);
+
+/*!***************************************************************************
+ * @brief   Finishes the recording; further phases are ignored.
+ *****************************************************************************/
+void BootProfile_Stop(void);
+
+/*!***************************************************************************
+ * @brief   Determines whether the recording is active.
+ * @return  Returns true if phases are recorded.
+ *****************************************************************************/
+bool BootProfile_IsRecording(void);
+
+/*!***************************************************************************
+ * @brief   Obtains a boot record.
+ * @param   previous False for the current boot, true for the previous one.
+ * @return  Returns the boot record; 0 if not available.
+ *****************************************************************************/
+boot_record_t const * BootProfile_GetRecord(bool previous);
+
+/*! @} */
+#endif /* BOOT_PROFILE_H */
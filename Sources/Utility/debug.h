@@ -69,7 +69,7 @@
  * @details Stops the debugger at the corresponding line of code.
  *          Only active in debug configuration.
  *****************************************************************************/
-#ifdef NDEBUG           /* required by ANSI standard */
+#if defined(NDEBUG) || !defined(__arm__)   /* required by ANSI standard; no bkpt on the host */
 #define BREAKPOINT() ((void)0)
 #else
 #define BREAKPOINT() __asm__ __volatile__ ("bkpt #0")
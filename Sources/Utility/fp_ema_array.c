@@ -0,0 +1,342 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides batched exponentially weighted moving averages.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "fp_ema_array.h"
+#include "hr_clock.h"
+
+#include "api/argus_def.h"
+#include "utility/fp_ema.h"
+
+#include <assert.h>
+#include <string.h>
+
+#if FP_EMA_SIMD32 && defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#endif
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The number of frames that are filtered back to back per sample of the
+ *  benchmark, i.e. the sample reflects the time of warm caches/pipelines. */
+#define FP_EMA_BENCH_REPEAT 4U
+
+#if FP_EMA_SIMD32
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+
+/* The ACLE intrinsics of the DSP extension (same as the CMSIS __SMUAD etc.). */
+#define SMUAD(a, b)     ((int32_t)__smuad((int16x2_t)(a), (int16x2_t)(b)))
+#define UHSUB16(a, b)   ((uint32_t)__uhsub16((uint16x2_t)(a), (uint16x2_t)(b)))
+
+#else
+
+/* C emulation of the DSP instructions; allows to verify the SIMD code path
+ * on a host (-DFP_EMA_SIMD32=1). */
+static inline int32_t SMUAD(uint32_t a, uint32_t b)
+{
+    return (int16_t)a * (int16_t)b + (int16_t)(a >> 16U) * (int16_t)(b >> 16U);
+}
+
+static inline uint32_t UHSUB16(uint32_t a, uint32_t b)
+{
+    const uint32_t lo = ((a & 0xFFFFU) - (b & 0xFFFFU)) >> 1U;
+    const uint32_t hi = ((a >> 16U) - (b >> 16U)) >> 1U;
+    return (lo & 0xFFFFU) | (hi << 16U);
+}
+
+#endif
+
+/*! Packs the lower halfwords of a and b: b[15:0]:a[15:0] (PKHBT). */
+#define PKHBT(a, b)     (((a) & 0xFFFFU) | ((b) << 16U))
+
+/*! Packs the upper halfwords of a and b: b[31:16]:a[31:16] (PKHTB). */
+#define PKHTB(a, b)     (((a) >> 16U) | ((b) & 0xFFFF0000U))
+
+#endif // FP_EMA_SIMD32
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Rounds mean * 256 + weight * (x - mean) like #fp_rnds(v, 8).
+ * @details Symmetric rounding, i.e. half away from zero: adds 128 to the
+ *          magnitude. Assumes an arithmetic right shift of signed values.
+ *****************************************************************************/
+static inline int32_t RoundS8(int32_t v)
+{
+    return (v + 128 + (v >> 31)) >> 8;
+}
+
+#if FP_EMA_SIMD32
+static inline uint32_t Load32(void const * p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void Store32(void * p, uint32_t v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+#endif
+
+void fp_ema4_array(q11_4_t * mean, q11_4_t const * x, uint32_t count, uq0_8_t weight)
+{
+    assert(mean != 0 || count == 0);
+    assert(x != 0 || count == 0);
+
+    if (weight == 0)
+    {
+        if (mean != x) memcpy(mean, x, count * sizeof(*mean));
+        return;
+    }
+
+    const int32_t w1 = weight;
+    const int32_t w0 = 256 - w1;
+    uint32_t i = 0;
+
+#if FP_EMA_SIMD32
+    /* Both weights fit into a signed halfword: w0 * mean + w1 * x. */
+    const uint32_t w = PKHBT((uint32_t)w0, (uint32_t)w1);
+
+    for (; i + 2U <= count; i += 2U)
+    {
+        const uint32_t m = Load32(&mean[i]);
+        const uint32_t v = Load32(&x[i]);
+
+        const int32_t v0 = SMUAD(PKHBT(m, v), w);
+        const int32_t v1 = SMUAD(PKHTB(m, v), w);
+
+        Store32(&mean[i], PKHBT((uint32_t)RoundS8(v0), (uint32_t)RoundS8(v1)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        mean[i] = (q11_4_t)RoundS8(mean[i] * w0 + x[i] * w1);
+    }
+}
+
+void uint_ema16_array(uint16_t * mean, uint16_t const * x, uint32_t count, uq0_8_t weight)
+{
+    assert(mean != 0 || count == 0);
+    assert(x != 0 || count == 0);
+
+    if (weight == 0)
+    {
+        if (mean != x) memcpy(mean, x, count * sizeof(*mean));
+        return;
+    }
+
+    /* The scalar #uint_ema32 rounds half up if x > mean and half down
+     * otherwise, i.e. the rounding offset is 128 - (x <= mean). */
+    const uint32_t w1 = weight;
+    const uint32_t w0 = 256U - w1;
+    uint32_t i = 0;
+
+#if FP_EMA_SIMD32
+    /* The unsigned halfwords are biased by -0x8000 to the signed range of
+     * SMUAD; the bias (-0x8000 * 256) is compensated by the offset. */
+    const uint32_t w = PKHBT(w0, w1);
+    const uint32_t bias = 0x80008000U;
+    const int32_t offset = 0x8000 * 256 + 127;
+
+    for (; i + 2U <= count; i += 2U)
+    {
+        const uint32_t m = Load32(&mean[i]);
+        const uint32_t v = Load32(&x[i]);
+
+        /* The MSB of each halfword of (mean - x) / 2 is the borrow, i.e.
+         * set if x > mean; this avoids the GE flags of USUB16/SEL. */
+        const uint32_t c = UHSUB16(m, v);
+
+        const uint32_t mb = m ^ bias;
+        const uint32_t vb = v ^ bias;
+        const int32_t v0 = SMUAD(PKHBT(mb, vb), w) + offset + (int32_t)((c >> 15U) & 1U);
+        const int32_t v1 = SMUAD(PKHTB(mb, vb), w) + offset + (int32_t)(c >> 31U);
+
+        Store32(&mean[i], PKHBT((uint32_t)v0 >> 8U, (uint32_t)v1 >> 8U));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        const uint32_t v = mean[i] * w0 + x[i] * w1 + 128U - (x[i] <= mean[i]);
+        mean[i] = (uint16_t)(v >> 8U);
+    }
+}
+
+void int_ema32_array(int32_t * mean, int32_t const * x, uint32_t count, uq0_8_t weight)
+{
+    assert(mean != 0 || count == 0);
+    assert(x != 0 || count == 0);
+
+    if (weight == 0)
+    {
+        if (mean != x) memcpy(mean, x, count * sizeof(*mean));
+        return;
+    }
+
+    /* Same rounding as #uint_ema32, see #uint_ema16_array. The 64-bit sum
+     * cannot overflow: |mean * w0 + x * w1| < 2^39. */
+    const int32_t w1 = weight;
+    const int32_t w0 = 256 - w1;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const int64_t v = (int64_t)mean[i] * w0 + (int64_t)x[i] * w1
+                          + 128 - (x[i] <= mean[i]);
+        mean[i] = (int32_t)(uint32_t)(uint64_t)(v >> 8U);
+    }
+}
+
+static uint32_t Random(uint32_t * state)
+{
+    /* xorshift32 */
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static uint32_t Elapsed(uint64_t start)
+{
+    const uint64_t ticks = HRClock_Now() - start;
+    return ticks > UINT32_MAX ? UINT32_MAX : (uint32_t)ticks;
+}
+
+static inline uint32_t Min(uint32_t a, uint32_t b)
+{
+    return a < b ? a : b;
+}
+
+status_t fp_ema_array_benchmark(fp_ema_bench_t * result, uint32_t frames)
+{
+    assert(result != 0);
+    if (frames == 0) return ERROR_INVALID_ARGUMENT;
+
+    static q11_4_t mean4[2][ARGUS_PIXELS];
+    static uint16_t mean16[2][ARGUS_PIXELS];
+    static int32_t mean32[2][ARGUS_PIXELS];
+    static q11_4_t x4[ARGUS_PIXELS];
+    static uint16_t x16[ARGUS_PIXELS];
+    static int32_t x32[ARGUS_PIXELS];
+
+    memset(mean4, 0, sizeof(mean4));
+    memset(mean16, 0, sizeof(mean16));
+    memset(mean32, 0, sizeof(mean32));
+
+    result->Frequency = HRClock_GetFrequency();
+    result->Ema4Scalar = result->Ema4Array = UINT32_MAX;
+    result->Ema16Scalar = result->Ema16Array = UINT32_MAX;
+    result->Ema32Scalar = result->Ema32Array = UINT32_MAX;
+
+    const uq0_8_t weight = 0xC0U;
+    uint32_t seed = 0x2545F491U;
+    status_t status = STATUS_OK;
+
+    for (uint32_t f = 0; f < frames; ++f)
+    {
+        /* Synthetic frame: Q9.22 ranges incl. negative values, UQ12.4
+         * amplitudes and Q11.4 values over the full range. */
+        for (uint32_t n = 0; n < ARGUS_PIXELS; ++n)
+        {
+            const uint32_t r = Random(&seed);
+            x4[n] = (q11_4_t)r;
+            x16[n] = (uint16_t)(r >> 16U);
+            x32[n] = (int32_t)(Random(&seed) & 0x0FFFFFFFU) - 0x00100000;
+        }
+
+        uint64_t t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            for (uint32_t n = 0; n < ARGUS_PIXELS; ++n)
+                mean4[0][n] = fp_ema4(mean4[0][n], x4[n], weight);
+        result->Ema4Scalar = Min(result->Ema4Scalar, Elapsed(t));
+
+        t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            fp_ema4_array(mean4[1], x4, ARGUS_PIXELS, weight);
+        result->Ema4Array = Min(result->Ema4Array, Elapsed(t));
+
+        t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            for (uint32_t n = 0; n < ARGUS_PIXELS; ++n)
+                mean16[0][n] = (uint16_t)uint_ema32(mean16[0][n], x16[n], weight);
+        result->Ema16Scalar = Min(result->Ema16Scalar, Elapsed(t));
+
+        t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            uint_ema16_array(mean16[1], x16, ARGUS_PIXELS, weight);
+        result->Ema16Array = Min(result->Ema16Array, Elapsed(t));
+
+        t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            for (uint32_t n = 0; n < ARGUS_PIXELS; ++n)
+                mean32[0][n] = int_ema32(mean32[0][n], x32[n], weight);
+        result->Ema32Scalar = Min(result->Ema32Scalar, Elapsed(t));
+
+        t = HRClock_Now();
+        for (uint32_t k = 0; k < FP_EMA_BENCH_REPEAT; ++k)
+            int_ema32_array(mean32[1], x32, ARGUS_PIXELS, weight);
+        result->Ema32Array = Min(result->Ema32Array, Elapsed(t));
+
+        if (memcmp(mean4[0], mean4[1], sizeof(mean4[0])) != 0
+            || memcmp(mean16[0], mean16[1], sizeof(mean16[0])) != 0
+            || memcmp(mean32[0], mean32[1], sizeof(mean32[0])) != 0)
+        {
+            status = ERROR_FAIL;
+        }
+    }
+
+    /* Report the time per single frame. */
+    result->Ema4Scalar /= FP_EMA_BENCH_REPEAT;
+    result->Ema4Array /= FP_EMA_BENCH_REPEAT;
+    result->Ema16Scalar /= FP_EMA_BENCH_REPEAT;
+    result->Ema16Array /= FP_EMA_BENCH_REPEAT;
+    result->Ema32Scalar /= FP_EMA_BENCH_REPEAT;
+    result->Ema32Array /= FP_EMA_BENCH_REPEAT;
+
+    return status;
+}
@@ -0,0 +1,198 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides batched exponentially weighted moving averages.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FP_EMA_ARRAY_H
+#define FP_EMA_ARRAY_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!***************************************************************************
+ * @defgroup    fp_ema_array Batched EMA Filters
+ * @ingroup     argus_fp
+ * @brief       Exponentially Weighted Moving Averages over Pixel Arrays
+ * @details     Applies the exponentially weighted moving average of the
+ *              fp_ema.h module to whole arrays, e.g. the ranges and
+ *              amplitudes of all 32 pixels of a frame, in a single call.
+ *
+ *              The results are bit-identical to calling the scalar function
+ *              for each element:
+ *              - #fp_ema4_array: #fp_ema4 / #fp_ema8 (Q11.4, Q7.8).
+ *              - #uint_ema16_array: #uint_ema32 for 16-bit unsigned values,
+ *                e.g. UQ12.4 amplitudes.
+ *              - #int_ema32_array: #int_ema32 / #fp_ema16, e.g. Q9.22
+ *                ranges or Q15.16 values.
+ *
+ *              The rounding is folded into a single multiply-accumulate per
+ *              element, i.e. mean * (256 - weight) + x * weight, instead of
+ *              the sign dependent branches of the scalar functions.
+ *
+ *              On cores with the DSP extension (Cortex-M4/M7/M33, i.e. if
+ *              the compiler defines __ARM_FEATURE_SIMD32), the 16-bit kernels
+ *              process two elements per SMUAD instruction. The portable C
+ *              code is used otherwise (e.g. Cortex-M0+), see
+ *              #FP_EMA_SIMD32.
+ *
+ * @addtogroup  fp_ema_array
+ * @{
+ *****************************************************************************/
+
+#include "utility/fp_def.h"
+#include "utility/status.h"
+#include <stdint.h>
+
+/*!***************************************************************************
+ * @brief   Enables the dual 16-bit SIMD kernels.
+ * @details Defaults to the availability of the ARM DSP extension. Set to 0
+ *          to force the portable C code.
+ *****************************************************************************/
+#ifndef FP_EMA_SIMD32
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#define FP_EMA_SIMD32 1
+#else
+#define FP_EMA_SIMD32 0
+#endif
+#endif
+
+/*!***************************************************************************
+ * @brief   The execution times of the EMA kernels per frame.
+ * @details See #fp_ema_array_benchmark. All values are ticks of the
+ *          hr_clock module (i.e. core clock cycles on Cortex-M4) to filter
+ *          all pixels of a single frame.
+ *****************************************************************************/
+typedef struct fp_ema_bench_t
+{
+    /*! The tick frequency in Hz, see #HRClock_GetFrequency. */
+    uint32_t Frequency;
+
+    /*! The ticks for #fp_ema4 called for each pixel. */
+    uint32_t Ema4Scalar;
+
+    /*! The ticks for a single #fp_ema4_array call. */
+    uint32_t Ema4Array;
+
+    /*! The ticks for #uint_ema32 called for each pixel. */
+    uint32_t Ema16Scalar;
+
+    /*! The ticks for a single #uint_ema16_array call. */
+    uint32_t Ema16Array;
+
+    /*! The ticks for #int_ema32 called for each pixel. */
+    uint32_t Ema32Scalar;
+
+    /*! The ticks for a single #int_ema32_array call. */
+    uint32_t Ema32Array;
+
+} fp_ema_bench_t;
+
+/*!***************************************************************************
+ * @brief   Exponentially weighted moving average of a Q11.4 array.
+ *
+ * @details Updates each mean value: mean[i] = #fp_ema4(mean[i], x[i], weight).
+ *          Also applies to Q7.8 data (#fp_ema8) and any other 16-bit signed
+ *          fixed point format.
+ *
+ *          The arrays may be unaligned; \p mean and \p x must either be
+ *          identical or not overlap.
+ *
+ * @param   mean The previous mean values; updated in place.
+ * @param   x The current values to be added to the averages.
+ * @param   count The number of elements.
+ * @param   weight The EMA weight in UQ0.8 format; 0 copies \p x.
+ *****************************************************************************/
+void fp_ema4_array(q11_4_t * mean, q11_4_t const * x, uint32_t count, uq0_8_t weight);
+
+/*!***************************************************************************
+ * @brief   Exponentially weighted moving average of an unsigned 16-bit array.
+ *
+ * @details Updates each mean value: mean[i] = #uint_ema32(mean[i], x[i], weight),
+ *          e.g. for UQ12.4 amplitudes.
+ *
+ *          The arrays may be unaligned; \p mean and \p x must either be
+ *          identical or not overlap.
+ *
+ * @param   mean The previous mean values; updated in place.
+ * @param   x The current values to be added to the averages.
+ * @param   count The number of elements.
+ * @param   weight The EMA weight in UQ0.8 format; 0 copies \p x.
+ *****************************************************************************/
+void uint_ema16_array(uint16_t * mean, uint16_t const * x, uint32_t count, uq0_8_t weight);
+
+/*!***************************************************************************
+ * @brief   Exponentially weighted moving average of a signed 32-bit array.
+ *
+ * @details Updates each mean value: mean[i] = #int_ema32(mean[i], x[i], weight),
+ *          e.g. for Q9.22 ranges or Q15.16 values (#fp_ema16).
+ *
+ *          Uses a single 32x32->64-bit multiply-accumulate per element
+ *          (SMULL/SMLAL on Cortex-M3/M4); the wrap around behavior of
+ *          #int_ema32 for differences beyond the int32 range is preserved.
+ *
+ * @param   mean The previous mean values; updated in place.
+ * @param   x The current values to be added to the averages.
+ * @param   count The number of elements.
+ * @param   weight The EMA weight in UQ0.8 format; 0 copies \p x.
+ *****************************************************************************/
+void int_ema32_array(int32_t * mean, int32_t const * x, uint32_t count, uq0_8_t weight);
+
+/*!***************************************************************************
+ * @brief   Measures the execution time of the EMA kernels per frame.
+ *
+ * @details Filters synthetic frames of #ARGUS_PIXELS elements with the scalar
+ *          functions of fp_ema.h and with the array kernels, compares the
+ *          results and reports the minimum time per frame of each variant.
+ *          Timestamps are taken by #HRClock_Now, i.e. the values are core
+ *          clock cycles on Cortex-M4 (DWT) and bus clock ticks on
+ *          Cortex-M0+ (PIT).
+ *
+ *          Run it with interrupts enabled but without measurements being
+ *          active, since the minimum over all frames is reported anyway.
+ *
+ * @param   result The measured ticks per frame.
+ * @param   frames The number of frames to measure; e.g. 100.
+ * @return  Returns the \link #status_t status\endlink: #STATUS_OK on success
+ *          or #ERROR_FAIL if an array kernel result differs from the scalar
+ *          function.
+ *****************************************************************************/
+status_t fp_ema_array_benchmark(fp_ema_bench_t * result, uint32_t frames);
+
+/*! @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif /* FP_EMA_ARRAY_H */
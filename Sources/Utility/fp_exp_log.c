@@ -0,0 +1,259 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides fast fixed point exponential and logarithm functions.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "fp_exp_log.h"
+
+#include "utility/int_math.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The largest argument of exp that does not saturate: 16 ln2 in Q15.16. */
+#define EXP_X_MAX 726817
+
+/*! The smallest argument of exp that does not round to zero: -17 ln2. */
+#define EXP_X_MIN (-772243)
+
+/*! 1 / ln2 in UQ1.10 format; estimates n = floor(x / ln2) for |x| < 2^20. */
+#define EXP_INV_LN2_Q10 1477
+
+/*! ln2 in UQ0.48 format, split into three 16-bit parts. */
+#define LN2_Q48_HI 0xB172U
+#define LN2_Q48_MID 0x17F7U
+#define LN2_Q48_LO 0xD1CFU
+
+/*! ln2 in UQ0.48 format. */
+#define LN2_Q48 0xB17217F7D1CFULL
+
+/*! ln2 in Q1.30 format (744261118), split into the Q15.16 part and the
+ *  remaining 14 fractional bits. */
+#define LN2_Q16 45426
+#define LN2_Q30_LO 1534
+
+/*! The Taylor coefficients of exp(s) - 1 in UQ0.32 format: 1/2, 1/6, 1/24. */
+#define EXP_C2 0x80000000U
+#define EXP_C3 715827883U
+#define EXP_C4 178956971U
+
+/*! The Taylor coefficients of ln(1 + z) in Q1.30 format: 1, -1/2, 1/3, -1/4. */
+#define LOG_C1 (1 << 30)
+#define LOG_C2 (-(1 << 29))
+#define LOG_C3 357913941
+#define LOG_C4 (-(1 << 28))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The table of exp(j/64) in UQ1.31 format for j = 0..44, i.e. up to ln2. */
+static const uint32_t myExpTable[45] =
+{
+    0x80000000U, 0x8204055BU, 0x84102B01U, 0x862491B4U,
+    0x88415ABCU, 0x8A66A7E5U, 0x8C949B84U, 0x8ECB5878U,
+    0x910B022EU, 0x9353BCA0U, 0x95A5AC5AU, 0x9800F67BU,
+    0x9A65C0B8U, 0x9CD4315FU, 0x9F4C6F55U, 0xA1CEA220U,
+    0xA45AF1E2U, 0xA6F18761U, 0xA9928C06U, 0xAC3E29E3U,
+    0xAEF48BB0U, 0xB1B5DCD5U, 0xB4824966U, 0xB759FE2BU,
+    0xBA3D289FU, 0xBD2BF6F5U, 0xC026981AU, 0xC32D3BB9U,
+    0xC640123CU, 0xC95F4CD0U, 0xCC8B1D6AU, 0xCFC3B6C7U,
+    0xD3094C71U, 0xD65C12C1U, 0xD9BC3EE4U, 0xDD2A06DDU,
+    0xE0A5A189U, 0xE42F46A2U, 0xE7C72EC2U, 0xEB6D9369U,
+    0xEF22AEFCU, 0xF2E6BCCEU, 0xF6B9F920U, 0xFA9CA127U,
+    0xFE8EF30CU
+};
+
+/*! The table of the reciprocals R_j = 1 / (1 + (j + 0.5) / 64) in UQ0.32 format. */
+static const uint32_t myLogRcpTable[64] =
+{
+    0xFE03F810U, 0xFA232CF2U, 0xF6603D98U, 0xF2B9D648U,
+    0xEF2EB720U, 0xEBBDB2A6U, 0xE865AC7BU, 0xE525982BU,
+    0xE1FC780EU, 0xDEE95C4DU, 0xDBEB61EFU, 0xD901B203U,
+    0xD62B80D6U, 0xD3680D37U, 0xD0B69FCCU, 0xCE168A77U,
+    0xCB8727C0U, 0xC907DA4FU, 0xC6980C6AU, 0xC4372F85U,
+    0xC1E4BBD6U, 0xBFA02FE8U, 0xBD691047U, 0xBB3EE722U,
+    0xB92143FAU, 0xB70FBB5AU, 0xB509E68BU, 0xB30F6353U,
+    0xB11FD3B8U, 0xAF3ADDC7U, 0xAD602B58U, 0xAB8F69E3U,
+    0xA9C84A48U, 0xA80A80A8U, 0xA655C439U, 0xA4A9CF1EU,
+    0xA3065E40U, 0xA16B312FU, 0x9FD809FEU, 0x9E4CAD24U,
+    0x9CC8E161U, 0x9B4C6F9FU, 0x99D722DBU, 0x9868C80AU,
+    0x97012E02U, 0x95A02568U, 0x94458094U, 0x92F11384U,
+    0x91A2B3C5U, 0x905A3863U, 0x8F1779DAU, 0x8DDA5202U,
+    0x8CA29C04U, 0x8B70344AU, 0x8A42F870U, 0x891AC73BU,
+    0x87F78088U, 0x86D90544U, 0x85BF3761U, 0x84A9F9C8U,
+    0x83993052U, 0x828CBFBFU, 0x81848DA9U, 0x80808081U
+};
+
+/*! The table of -ln(R_j) in Q1.30 format, with R_j as rounded in #myLogRcpTable. */
+static const int32_t myLogTable[64] =
+{
+    8356010, 24875441, 41144567, 57170862,
+    72961468, 88523216, 103862646, 118986020,
+    133899340, 148608362, 163118608, 177435378,
+    191563764, 205508658, 219274768, 232866618,
+    246288566, 259544806, 272639381, 285576186,
+    298358977, 310991380, 323476891, 335818886,
+    348020630, 360085271, 372015859, 383815338,
+    395486560, 407032282, 418455175, 429757825,
+    440942737, 452012338, 462968983, 473814952,
+    484552459, 495183653, 505710618, 516135378,
+    526459898, 536686088, 546815803, 556850846,
+    566792972, 576643883, 586405240, 596078655,
+    605665699, 615167901, 624586750, 633923694,
+    643180146, 652357483, 661457044, 670480138,
+    679428038, 688301988, 697103200, 705832856,
+    714492111, 723082091, 731603897, 740058600
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   The upper 32 bits of the unsigned 64-bit product: (a * b) >> 32.
+ *****************************************************************************/
+static inline uint32_t MulHi(uint32_t a, uint32_t b)
+{
+#if FP_EXP_LOG_MUL64
+    return (uint32_t)(((uint64_t)a * b) >> 32U);
+#else
+    const uint32_t al = a & 0xFFFFU, ah = a >> 16U;
+    const uint32_t bl = b & 0xFFFFU, bh = b >> 16U;
+    const uint32_t lh = al * bh, hl = ah * bl;
+    const uint32_t carry = ((al * bl) >> 16U) + (lh & 0xFFFFU) + (hl & 0xFFFFU);
+    return ah * bh + (lh >> 16U) + (hl >> 16U) + (carry >> 16U);
+#endif
+}
+
+/*!***************************************************************************
+ * @brief   The upper 32 bits of the signed 64-bit product: (a * b) >> 32.
+ * @details The unsigned product is corrected by the two's complement of the
+ *          negative factors, i.e. the result equals floor(a * b / 2^32).
+ *****************************************************************************/
+static inline int32_t MulHiS(int32_t a, int32_t b)
+{
+#if FP_EXP_LOG_MUL64
+    return (int32_t)(((int64_t)a * b) >> 32U);
+#else
+    uint32_t hi = MulHi((uint32_t)a, (uint32_t)b);
+    if (a < 0) hi -= (uint32_t)b;
+    if (b < 0) hi -= (uint32_t)a;
+    return (int32_t)hi;
+#endif
+}
+
+/*!***************************************************************************
+ * @brief   n ln2 in UQ0.48 format, two's complement for negative n.
+ *****************************************************************************/
+static inline uint64_t MulLn2(int32_t n)
+{
+#if FP_EXP_LOG_MUL64
+    return (uint64_t)((int64_t)n * (int64_t)LN2_Q48);
+#else
+    /* |n| < 2^5, i.e. each partial product fits into 32 bits. */
+    return ((uint64_t)(int64_t)(n * (int32_t)LN2_Q48_HI) << 32U)
+           + ((uint64_t)(int64_t)(n * (int32_t)LN2_Q48_MID) << 16U)
+           + (uint64_t)(int64_t)(n * (int32_t)LN2_Q48_LO);
+#endif
+}
+
+uq16_16_t fp_exp16_fast(q15_16_t x)
+{
+    if (x > EXP_X_MAX) return UQ16_16_MAX;
+    if (x < EXP_X_MIN) return 0;
+
+    /* Range reduction: x = n ln2 + r with 0 <= r < ln2. The estimate of n
+     * is off by at most one and corrected with the exact remainder. */
+    int32_t n = (x * EXP_INV_LN2_Q10) >> 26;
+    int64_t r = (int64_t)(((uint64_t)(int64_t)x << 32U) - MulLn2(n));
+    if (r < 0)
+    {
+        n--;
+        r += (int64_t)LN2_Q48;
+    }
+    else if (r >= (int64_t)LN2_Q48)
+    {
+        n++;
+        r -= (int64_t)LN2_Q48;
+    }
+
+    /* r = j/64 + s in UQ0.32 format; exp(r) = exp(j/64) * (1 + (exp(s) - 1)). */
+    const uint32_t r32 = (uint32_t)((r + 0x8000) >> 16U);
+    const uint32_t j = r32 >> 26U;
+    const uint32_t s = r32 & 0x03FFFFFFU;
+
+    uint32_t p = EXP_C3 + MulHi(s, EXP_C4);
+    p = EXP_C2 + MulHi(s, p);
+    p = s + MulHi(s, MulHi(s, p));
+
+    /* exp(r) in UQ1.31; saturates if r is rounded up to ln2. */
+    uint32_t e = myExpTable[j] + MulHi(myExpTable[j], p);
+    if (e < myExpTable[j]) e = UINT32_MAX;
+
+    /* Scale by 2^n from UQ1.31 to UQ16.16 with rounding; n in [-17, 15]. */
+    const uint32_t shift = (uint32_t)(15 - n);
+    if (shift == 0) return e;
+    return ((e >> (shift - 1U)) + 1U) >> 1U;
+}
+
+q15_16_t fp_log16_fast(uq16_16_t x)
+{
+    if (x == 0) return Q15_16_MIN;
+
+    /* Normalization: x = 2^e * m with m in [1, 2) in UQ1.31 format. */
+    const uint32_t k = 31U - log2i(x);
+    const uint32_t m = x << k;
+    const int32_t e = 15 - (int32_t)k;
+
+    /* 1 + z = m * R_j with |z| < 1/128; z in Q0.32 format. */
+    const uint32_t j = (m >> 25U) & 0x3FU;
+    const int32_t z = (int32_t)(MulHi(m, myLogRcpTable[j]) << 1U);
+
+    /* ln(1 + z) in Q1.30 format. */
+    int32_t p = LOG_C3 + MulHiS(z, LOG_C4);
+    p = LOG_C2 + MulHiS(z, p);
+    p = LOG_C1 + MulHiS(z, p);
+    const int32_t f = myLogTable[j] + MulHiS(z, p);
+
+    /* ln(x) = e ln2 + ln(1/R_j) + ln(1 + z); rounded from Q1.30 to Q15.16. */
+    return e * LN2_Q16 + ((e * LN2_Q30_LO + f + (1 << 13)) >> 14);
+}
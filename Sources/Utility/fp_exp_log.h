@@ -0,0 +1,129 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides fast fixed point exponential and logarithm functions.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FP_EXP_LOG_H
+#define FP_EXP_LOG_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!***************************************************************************
+ * @defgroup    fp_exp_log Fast Exponential and Logarithm
+ * @ingroup     argus_fp
+ * @brief       Table and Polynomial based exp(x) and ln(x) in Q15.16/UQ16.16
+ * @details     Provides drop-in replacements of #fp_exp16 and #fp_log16 for
+ *              application code, with the same fixed point formats, that do
+ *              not require a floating point unit.
+ *
+ *              Both functions reduce the argument to a small interval by a
+ *              table lookup and evaluate a short polynomial in 32-bit fixed
+ *              point arithmetic:
+ *              - exp: x = n ln2 + j/64 + s, with a table of exp(j/64) and a
+ *                4th order Taylor polynomial of exp(s) - 1 for s < 1/64.
+ *              - ln: x = 2^e (1 + f) and 1 + f = (1 + z) / R_j, with a table
+ *                of 64 reciprocals R_j and ln(1/R_j) and a 4th order Taylor
+ *                polynomial of ln(1 + z) for |z| < 1/128.
+ *
+ *              The maximum errors, measured against exp and log in double
+ *              precision for every input value, are (1 ULP = 2^-16):
+ *              - #fp_exp16_fast: 0.95 ULP for results below 2^15 (x < 10.4)
+ *                and 2.1 ULP above, where the UQ1.31 intermediate limits the
+ *                accuracy; 0.001 % of the results are not correctly rounded.
+ *              - #fp_log16_fast: 0.5001 ULP, i.e. at most 1 ULP off the
+ *                correctly rounded result (0.003 % of the inputs).
+ *
+ *              Cortex-M0/M0+ have no 32x32->64-bit multiplication (UMULL/
+ *              SMULL); a 64-bit product is a call to the __aeabi_lmul
+ *              library function. Thus, the upper 32 bits of the products are
+ *              assembled from four 16x16->32-bit MULS instead, see
+ *              #FP_EXP_LOG_MUL64. Both variants yield bit-identical results.
+ *
+ *              The functions use distinct names since the API library
+ *              provides (and internally uses) #fp_exp16 and #fp_log16.
+ *
+ * @addtogroup  fp_exp_log
+ * @{
+ *****************************************************************************/
+
+#include "utility/fp_def.h"
+
+/*!***************************************************************************
+ * @brief   Enables the 32x32->64-bit multiplications.
+ * @details Defaults to 0 for the Thumb-1 only cores (Cortex-M0/M0+/M1),
+ *          where the upper half of each product is computed from 16-bit
+ *          multiplications, and to 1 otherwise (e.g. UMULL on Cortex-M3/M4).
+ *****************************************************************************/
+#ifndef FP_EXP_LOG_MUL64
+#if defined(__ARM_ARCH_ISA_THUMB) && (__ARM_ARCH_ISA_THUMB < 2)
+#define FP_EXP_LOG_MUL64 0
+#else
+#define FP_EXP_LOG_MUL64 1
+#endif
+#endif
+
+/*!***************************************************************************
+ * @brief   Calculates the exponential of a fixed point number.
+ *
+ * @details Calculates y = exp(x) in fixed point representation.
+ *
+ *          The result saturates at #UQ16_16_MAX for x > 16 ln2 (about
+ *          11.09) and is 0 for x < -17 ln2 (about -11.78).
+ *
+ * @param   x The input parameter in fixed point format Q15.16.
+ * @return  Result y = exp(x) in the UQ16.16 format.
+ *****************************************************************************/
+uq16_16_t fp_exp16_fast(q15_16_t x);
+
+/*!***************************************************************************
+ * @brief   Calculates the natural logarithm (base e) of a fixed point number.
+ *
+ * @details Calculates y = ln(x) = log_e(x) in fixed point representation.
+ *
+ *          The result covers the whole input range, i.e. -16 ln2 to
+ *          16 ln2; ln(0) returns #Q15_16_MIN.
+ *
+ * @param   x The input parameter in unsigned fixed point format UQ16.16.
+ * @return  Result y = ln(x) in the Q15.16 format.
+ *****************************************************************************/
+q15_16_t fp_log16_fast(uq16_16_t x);
+
+/*! @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif /* FP_EXP_LOG_H */
@@ -0,0 +1,191 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a fast integer square root and batched fixed point divisions.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "fp_sqrt_div.h"
+
+#include "utility/int_math.h"
+
+#include <assert.h>
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The seeds of the reciprocal square root 1/sqrt(X) in UQ1.15 format for
+ *  X in [1, 4), indexed by the 6 leading bits of X in UQ2.30 format (16..63),
+ *  evaluated at the center of each interval. */
+static const uint16_t myRsqrtTable[48] =
+{
+    32268, 31332, 30474, 29682, 28949, 28268, 27632, 27038,
+    26481, 25956, 25462, 24994, 24552, 24132, 23733, 23354,
+    22992, 22646, 22315, 21999, 21695, 21404, 21124, 20855,
+    20596, 20346, 20106, 19873, 19649, 19431, 19221, 19018,
+    18821, 18630, 18444, 18264, 18090, 17920, 17755, 17594,
+    17438, 17285, 17137, 16992, 16851, 16714, 16579, 16448
+};
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   The unsigned 64-bit product a * b.
+ *****************************************************************************/
+static inline uint64_t Mul64(uint32_t a, uint32_t b)
+{
+#if FP_SQRT_DIV_MUL64
+    return (uint64_t)a * b;
+#else
+    const uint32_t al = a & 0xFFFFU, ah = a >> 16U;
+    const uint32_t bl = b & 0xFFFFU, bh = b >> 16U;
+    return ((uint64_t)(ah * bh) << 32U) + ((uint64_t)(al * bh) << 16U)
+           + ((uint64_t)(ah * bl) << 16U) + al * bl;
+#endif
+}
+
+/*!***************************************************************************
+ * @brief   The upper 32 bits of the unsigned 64-bit product: (a * b) >> 32.
+ *****************************************************************************/
+static inline uint32_t MulHi(uint32_t a, uint32_t b)
+{
+#if FP_SQRT_DIV_MUL64
+    return (uint32_t)(((uint64_t)a * b) >> 32U);
+#else
+    const uint32_t al = a & 0xFFFFU, ah = a >> 16U;
+    const uint32_t bl = b & 0xFFFFU, bh = b >> 16U;
+    const uint32_t lh = al * bh, hl = ah * bl;
+    const uint32_t carry = ((al * bl) >> 16U) + (lh & 0xFFFFU) + (hl & 0xFFFFU);
+    return ah * bh + (lh >> 16U) + (hl >> 16U) + (carry >> 16U);
+#endif
+}
+
+uint32_t isqrt_nr(uint32_t x)
+{
+    if (x == 0) return 0;
+
+    /* Normalization: x = X * 4^e with X in [1, 4) in UQ2.30 format. */
+    const uint32_t e = log2i(x) >> 1U;
+    const uint32_t xn = x << (30U - 2U * e);
+
+    /* The seed r0 = 1/sqrt(X) in UQ1.15 format; relative error < 2^-7. */
+    const uint32_t r0 = myRsqrtTable[(xn >> 26U) - 16U];
+
+    /* First iteration r1 = r0 (3 - X r0^2) / 2 with 16x16-bit products;
+     * X r0^2 and the factor (3 - X r0^2) in UQ4.28 format, r1 in UQ1.31. */
+    uint32_t d = (3U << 28U) - (xn >> 16U) * ((r0 * r0) >> 16U);
+    const uint32_t r1 = (r0 * (d >> 14U)) << 1U;
+
+    /* Second iteration in 32-bit precision. The iteration converges from
+     * below, i.e. r2 <= 1/sqrt(X) <= 1 fits into UQ1.31. */
+    d = (3U << 28U) - MulHi(xn, MulHi(r1, r1));
+    const uint32_t r2 = MulHi(r1, d) << 3U;
+
+    /* sqrt(x) = X r2 2^e; X r2 in UQ3.29 format. The truncations of the
+     * products leave an error of at most one next to perfect squares. */
+    uint32_t y = MulHi(xn, r2) >> (29U - e);
+    if (y > 0xFFFFU || y * y > x) y--;
+    else if (y < 0xFFFFU && (y + 1U) * (y + 1U) <= x) y++;
+    return y;
+}
+
+void fp_div16_init(fp_div16_rcp_t * rcp, q15_16_t b)
+{
+    assert(rcp != 0);
+
+    rcp->Negative = b < 0;
+    rcp->Divisor = absval(b);
+    if (rcp->Divisor == 0)
+    {
+        rcp->Half = 0;
+        rcp->Factor = 0;
+        rcp->Shift = 0;
+        return;
+    }
+
+    /* 2^30 < Factor <= 2^31, i.e. a relative error below 2^-30. */
+    const uint32_t l = log2i(rcp->Divisor);
+    rcp->Factor = (uint32_t)((1ULL << (31U + l)) / rcp->Divisor);
+    rcp->Shift = (uint8_t)(15U + l);
+    rcp->Half = (rcp->Divisor >> 1U) + (rcp->Divisor & 1U);
+}
+
+int32_t fp_div16_rcp(int32_t a, fp_div16_rcp_t const * rcp)
+{
+    assert(rcp != 0);
+
+    if (rcp->Divisor == 0) return a < 0 ? INT32_MIN : INT32_MAX;
+
+    const bool negative = (a < 0) != rcp->Negative;
+    const uint32_t ua = absval(a);
+
+    /* The estimate is at most 3 below the quotient floor(|a| 2^16 / |b|);
+     * a quotient above 2^31 + 3 yields an estimate above 2^31. */
+    const uint64_t e = Mul64(ua, rcp->Factor) >> rcp->Shift;
+    if (e > 0x80000000U) return negative ? INT32_MIN : INT32_MAX;
+
+    /* Correction by the exact remainder and rounding half up. */
+    uint32_t q = (uint32_t)e;
+    uint64_t r = ((uint64_t)ua << 16U) - Mul64(q, rcp->Divisor);
+    while (r >= rcp->Divisor)
+    {
+        r -= rcp->Divisor;
+        q++;
+    }
+    if (r >= rcp->Half) q++;
+
+    if (negative) return q >= 0x80000000U ? INT32_MIN : -(int32_t)q;
+    return q > (uint32_t)INT32_MAX ? INT32_MAX : (int32_t)q;
+}
+
+void fp_div16_array(int32_t * q, int32_t const * a, uint32_t count, q15_16_t b)
+{
+    assert(q != 0 || count == 0);
+    assert(a != 0 || count == 0);
+
+    fp_div16_rcp_t rcp;
+    fp_div16_init(&rcp, b);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        q[i] = fp_div16_rcp(a[i], &rcp);
+    }
+}
@@ -0,0 +1,177 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a fast integer square root and batched fixed point divisions.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef FP_SQRT_DIV_H
+#define FP_SQRT_DIV_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!***************************************************************************
+ * @defgroup    fp_sqrt_div Fast Square Root and Division
+ * @ingroup     argus_fp
+ * @brief       Division Free Integer Square Root and Batched Q15.16 Division
+ * @details     Provides alternatives to #isqrt (int_math.h) and #fp_div16
+ *              (fp_div.h) for cores without a hardware divider, e.g. the
+ *              Cortex-M0+, that need many of them per frame:
+ *
+ *              - #isqrt_nr: the integer square root by a Newton-Raphson
+ *                iteration of the reciprocal square root. The seed is read
+ *                from a 48 entry table that is indexed by the leading bits
+ *                of the argument, normalized via #log2i. Two iterations and a
+ *                final integer correction yield floor(sqrt(x)) for every
+ *                32-bit input, i.e. the same result as #isqrt, using only
+ *                multiplications.
+ *
+ *              - #fp_div16_init / #fp_div16_rcp / #fp_div16_array: divides
+ *                many values by the same Q15.16 divisor. The reciprocal of
+ *                the divisor is calculated once; each quotient is then
+ *                estimated by a single multiplication and corrected by its
+ *                exact remainder. The results are identical to #fp_div16,
+ *                i.e. correctly rounded (half away from zero) and saturated.
+ *
+ *              As for the fp_exp_log module, the 32x32->64-bit products are
+ *              assembled from 16x16->32-bit multiplications on Thumb-1 cores
+ *              (Cortex-M0/M0+), see #FP_SQRT_DIV_MUL64, with identical
+ *              results.
+ *
+ * @addtogroup  fp_sqrt_div
+ * @{
+ *****************************************************************************/
+
+#include "utility/fp_def.h"
+#include <stdbool.h>
+
+/*!***************************************************************************
+ * @brief   Enables the 32x32->64-bit multiplications.
+ * @details Defaults to 0 for the Thumb-1 only cores (Cortex-M0/M0+/M1) and
+ *          to 1 otherwise (e.g. UMULL on Cortex-M3/M4).
+ *****************************************************************************/
+#ifndef FP_SQRT_DIV_MUL64
+#if defined(__ARM_ARCH_ISA_THUMB) && (__ARM_ARCH_ISA_THUMB < 2)
+#define FP_SQRT_DIV_MUL64 0
+#else
+#define FP_SQRT_DIV_MUL64 1
+#endif
+#endif
+
+/*!***************************************************************************
+ * @brief   The precomputed reciprocal of a Q15.16 divisor.
+ * @details Initialized by #fp_div16_init; used by #fp_div16_rcp and
+ *          #fp_div16_array.
+ *****************************************************************************/
+typedef struct fp_div16_rcp_t
+{
+    /*! The absolute value of the divisor; 0 for a division by zero. */
+    uint32_t Divisor;
+
+    /*! The rounding threshold of the remainder: ceil(Divisor / 2). */
+    uint32_t Half;
+
+    /*! The reciprocal floor(2^(31 + l) / Divisor) with l = log2i(Divisor). */
+    uint32_t Factor;
+
+    /*! The shift of the quotient estimate: 15 + l. */
+    uint8_t Shift;
+
+    /*! True if the divisor is negative. */
+    bool Negative;
+
+} fp_div16_rcp_t;
+
+/*!***************************************************************************
+ * @brief   Calculates the integer square root of x.
+ *
+ * @details Returns floor(sqrt(x)) for all 32-bit inputs, see the module
+ *          description. Unlike #isqrt, it is always available, i.e. it does
+ *          not depend on #INT_SQRT.
+ *
+ * @param   x Input parameter.
+ * @return  isqrt(x)
+ *****************************************************************************/
+uint32_t isqrt_nr(uint32_t x);
+
+/*!***************************************************************************
+ * @brief   Precomputes the reciprocal of a Q15.16 divisor.
+ *
+ * @details Uses a single 64-bit division; all subsequent divisions by \p b
+ *          are evaluated by multiplications only.
+ *
+ * @param   rcp The reciprocal to be initialized.
+ * @param   b The denominator in Q15.16 format; 0 is allowed, see
+ *            #fp_div16_rcp.
+ *****************************************************************************/
+void fp_div16_init(fp_div16_rcp_t * rcp, q15_16_t b);
+
+/*!***************************************************************************
+ * @brief   Divides by a precomputed Q15.16 divisor.
+ *
+ * @details Evaluates a/b with the same result as #fp_div16(a, b): the result
+ *          is correctly rounded (half away from zero) and saturated at
+ *          INT32_MIN/INT32_MAX. A division by 0 yields INT32_MIN for negative
+ *          numerators and INT32_MAX otherwise.
+ *
+ *          The only exception is a quotient of exactly +2^31, that
+ *          #fp_div16 returns as INT32_MIN; this function saturates it at
+ *          INT32_MAX.
+ *
+ * @param   a Numerator in any Qx.y format.
+ * @param   rcp The reciprocal of the denominator, see #fp_div16_init.
+ * @return  Result = a/b in the same Qx.y format as the input parameter a.
+ *****************************************************************************/
+int32_t fp_div16_rcp(int32_t a, fp_div16_rcp_t const * rcp);
+
+/*!***************************************************************************
+ * @brief   Divides an array of values by the same Q15.16 divisor.
+ *
+ * @details Evaluates q[i] = #fp_div16_rcp(a[i], rcp) with rcp initialized
+ *          for \p b, i.e. a single reciprocal and a multiplication per
+ *          element instead of a division per element.
+ *
+ * @param   q The quotients; may be identical to \p a.
+ * @param   a The numerators in any Qx.y format.
+ * @param   count The number of elements.
+ * @param   b The denominator in Q15.16 format.
+ *****************************************************************************/
+void fp_div16_array(int32_t * q, int32_t const * a, uint32_t count, q15_16_t b);
+
+/*! @} */
+#ifdef __cplusplus
+} // extern "C"
+#endif
+#endif /* FP_SQRT_DIV_H */
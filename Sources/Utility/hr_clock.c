@@ -0,0 +1,187 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a high resolution time base with 64-bit ticks.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "hr_clock.h"
+
+#include "platform/argus_irq.h"
+#include "platform/argus_timer.h"
+
+#include <assert.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The frequency of the lifetime counter fallback in Hz. */
+#define HR_CLOCK_LTC_FREQUENCY 1000000U
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The bound 32-bit hardware counter; null if not used. */
+static hr_clock_read32_t myRead32 = NULL;
+
+/*! The bound 64-bit hardware counter; null if not used. */
+static hr_clock_read64_t myRead64 = NULL;
+
+/*! The tick frequency in Hz. */
+static uint32_t myFrequency = HR_CLOCK_LTC_FREQUENCY;
+
+/*! The ticks per microsecond of the 32-bit hardware counter. */
+static uint32_t myTicksPerUSec = 1U;
+
+/*! The nanoseconds per tick in Q16.16 format. */
+static uint32_t myNSecPerTick = 1000U << 16U;
+
+/*! The hardware counter value at initialization. */
+static uint64_t myStart = 0;
+
+/*! The lifetime counter value at initialization (32-bit counter only). */
+static ltc_t myStartLTC = { 0, 0 };
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static void HRClock_SetFrequency(uint32_t frequency)
+{
+    assert(frequency > 0);
+    myFrequency = frequency;
+    myNSecPerTick = (uint32_t)(((1000000000ULL << 16U) + frequency / 2U) / frequency);
+}
+
+void HRClock_Init32(hr_clock_read32_t read, uint32_t frequency)
+{
+    assert(read != NULL);
+    assert(frequency >= 1000000U && frequency % 1000000U == 0);
+
+    IRQ_LOCK();
+    Timer_GetCounterValue(&myStartLTC.sec, &myStartLTC.usec);
+    myStart = read();
+    myTicksPerUSec = frequency / 1000000U;
+    HRClock_SetFrequency(frequency);
+    myRead64 = NULL;
+    myRead32 = read;
+    IRQ_UNLOCK();
+}
+
+void HRClock_Init64(hr_clock_read64_t read, uint32_t frequency)
+{
+    assert(read != NULL);
+
+    IRQ_LOCK();
+    myStart = read();
+    HRClock_SetFrequency(frequency);
+    myRead32 = NULL;
+    myRead64 = read;
+    IRQ_UNLOCK();
+}
+
+uint64_t HRClock_Now(void)
+{
+    if (myRead64 != NULL)
+    {
+        return myRead64() - myStart;
+    }
+
+    ltc_t now;
+    uint32_t count = 0;
+
+    IRQ_LOCK();
+    Timer_GetCounterValue(&now.sec, &now.usec);
+    if (myRead32 != NULL) count = myRead32() - (uint32_t)myStart;
+    IRQ_UNLOCK();
+
+    if (myRead32 == NULL)
+    {
+        return (uint64_t)now.sec * 1000000U + now.usec;
+    }
+
+    /* The lifetime counter estimates the elapsed ticks with an error far
+     * below half the wrap-around period of the 32-bit counter; the number of
+     * wrap-arounds is the one that brings the counter closest to it. */
+    const uint64_t usec = (uint64_t)(now.sec - myStartLTC.sec) * 1000000U
+                        + now.usec - myStartLTC.usec;
+    const uint64_t estimate = usec * myTicksPerUSec + 0x80000000U;
+    const uint64_t wraps = estimate > count ? (estimate - count) >> 32U : 0;
+
+    return (wraps << 32U) | count;
+}
+
+uint32_t HRClock_GetFrequency(void)
+{
+    return myFrequency;
+}
+
+uint32_t HRClock_TicksToNSec(uint32_t ticks)
+{
+    const uint64_t nsec = ((uint64_t)ticks * myNSecPerTick + 0x8000U) >> 16U;
+    return nsec > UINT32_MAX ? UINT32_MAX : (uint32_t)nsec;
+}
+
+uint32_t HRClock_GetElapsedNSec(uint64_t start)
+{
+    const uint64_t ticks = HRClock_Now() - start;
+    return ticks > UINT32_MAX ? UINT32_MAX : HRClock_TicksToNSec((uint32_t)ticks);
+}
+
+uint64_t HRClock_ToUSec(uint64_t ticks)
+{
+    return (ticks / myFrequency) * 1000000U
+         + ((ticks % myFrequency) * 1000000U) / myFrequency;
+}
+
+void HRClock_ToLTC(ltc_t * t, uint64_t ticks)
+{
+    assert(t != NULL);
+    t->sec = (uint32_t)(ticks / myFrequency);
+    t->usec = (uint32_t)(((ticks % myFrequency) * 1000000U) / myFrequency);
+}
+
+uint64_t HRClock_FromLTC(ltc_t const * t)
+{
+    assert(t != NULL);
+    return (uint64_t)t->sec * myFrequency
+         + ((uint64_t)t->usec * myFrequency) / 1000000U;
+}
@@ -0,0 +1,159 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a high resolution time base with 64-bit ticks.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef HR_CLOCK_H
+#define HR_CLOCK_H
+
+/*!***************************************************************************
+ * @defgroup    hr_clock High Resolution Clock
+ * @ingroup     platform
+ * @brief       Monotonic 64-bit High Resolution Time Base
+ * @details     Provides sub-microsecond, monotonic timestamps for latency
+ *              measurements, profiling and tracing, in addition to the
+ *              microsecond lifetime counter (#Timer_GetCounterValue).
+ *
+ *              The platform binds a hardware counter at #Timer_Init:
+ *              - Cortex-M4 (STM32F4, RA4M2): the DWT cycle counter that runs
+ *                at the core clock. Its 32 bits wrap within a minute; they
+ *                are extended to 64 bits by #HRClock_Init32.
+ *              - Cortex-M0+ (NXP MKLxxZ): no cycle counter is available;
+ *                the 64-bit PIT lifetime counter at the bus clock is used
+ *                directly by #HRClock_Init64.
+ *
+ *              The clock is optional: if no counter is bound, the lifetime
+ *              counter is used at 1 MHz, i.e. all functions are available on
+ *              every platform with reduced resolution.
+ *
+ *              The ticks start at zero on initialization. Conversions to
+ *              nanoseconds and to the #ltc_t type use the frequency reported
+ *              by #HRClock_GetFrequency.
+ *
+ * @addtogroup  hr_clock
+ * @{
+ *****************************************************************************/
+
+#include "utility/time.h"
+#include <stdint.h>
+
+/*!***************************************************************************
+ * @brief   The function type to read a free running 32-bit hardware counter.
+ * @details The counter counts up and wraps from 0xFFFFFFFF to 0.
+ *****************************************************************************/
+typedef uint32_t (*hr_clock_read32_t)(void);
+
+/*!***************************************************************************
+ * @brief   The function type to read a free running 64-bit hardware counter.
+ * @details The counter counts up and does not wrap in practice.
+ *****************************************************************************/
+typedef uint64_t (*hr_clock_read64_t)(void);
+
+/*!***************************************************************************
+ * @brief   Binds a 32-bit hardware counter, e.g. the DWT cycle counter.
+ *
+ * @details The counter is extended to 64 bits by resolving the number of
+ *          wrap-arounds with the lifetime counter (#Timer_GetCounterValue),
+ *          i.e. #HRClock_Now does not need to be called periodically. This
+ *          requires that the counter runs continuously at \p frequency
+ *          (e.g. the core does not enter sleep modes that halt the core
+ *          clock) and that the lifetime counter is already running.
+ *
+ * @param   read The function to read the hardware counter.
+ * @param   frequency The counter frequency in Hz; must be a multiple of 1 MHz.
+ *****************************************************************************/
+void HRClock_Init32(hr_clock_read32_t read, uint32_t frequency);
+
+/*!***************************************************************************
+ * @brief   Binds a 64-bit hardware counter, e.g. the PIT lifetime counter.
+ *
+ * @param   read The function to read the hardware counter.
+ * @param   frequency The counter frequency in Hz.
+ *****************************************************************************/
+void HRClock_Init64(hr_clock_read64_t read, uint32_t frequency);
+
+/*!***************************************************************************
+ * @brief   Gets the current time in ticks since initialization.
+ * @details Can be called from any context, including interrupt handlers.
+ * @return  The monotonic 64-bit tick count.
+ *****************************************************************************/
+uint64_t HRClock_Now(void);
+
+/*!***************************************************************************
+ * @brief   Gets the tick frequency of #HRClock_Now in Hz.
+ * @return  The tick frequency; 1000000 if no hardware counter is bound.
+ *****************************************************************************/
+uint32_t HRClock_GetFrequency(void);
+
+/*!***************************************************************************
+ * @brief   Converts a tick difference to nanoseconds.
+ * @details Fast conversion for short intervals; uses a single 64-bit
+ *          multiplication with a Q16.16 scaling factor.
+ * @param   ticks The tick difference; up to 2^32-1 ticks.
+ * @return  The time in nanoseconds; saturated at 0xFFFFFFFF.
+ *****************************************************************************/
+uint32_t HRClock_TicksToNSec(uint32_t ticks);
+
+/*!***************************************************************************
+ * @brief   Gets the elapsed time since a given tick count in nanoseconds.
+ * @param   start The start tick count obtained by #HRClock_Now.
+ * @return  The elapsed time in nanoseconds; saturated at 0xFFFFFFFF.
+ *****************************************************************************/
+uint32_t HRClock_GetElapsedNSec(uint64_t start);
+
+/*!***************************************************************************
+ * @brief   Converts a tick count to microseconds.
+ * @param   ticks The tick count.
+ * @return  The time in microseconds.
+ *****************************************************************************/
+uint64_t HRClock_ToUSec(uint64_t ticks);
+
+/*!***************************************************************************
+ * @brief   Converts a tick count to the #ltc_t time format.
+ * @param   t The converted time.
+ * @param   ticks The tick count.
+ *****************************************************************************/
+void HRClock_ToLTC(ltc_t * t, uint64_t ticks);
+
+/*!***************************************************************************
+ * @brief   Converts a #ltc_t time to a tick count.
+ * @param   t The time to convert.
+ * @return  The tick count.
+ *****************************************************************************/
+uint64_t HRClock_FromLTC(ltc_t const * t);
+
+/*! @} */
+#endif /* HR_CLOCK_H */
@@ -0,0 +1,807 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a log-structured, wear-levelled record store
+ *              for the non-volatile memory module on top of a raw flash.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "nvm_log.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! The magic number of a record header ('NVLR'). */
+#define NVM_LOG_RECORD_MAGIC 0x4E564C52U
+
+/*! The commit marker that is programmed after the record data ('NVLC'). */
+#define NVM_LOG_COMMIT_MARK 0x4E564C43U
+
+/*! The value of an erased flash word. */
+#define NVM_LOG_ERASED 0xFFFFFFFFU
+
+/*! The size of the buffer for copying data to the flash; a multiple of 4. */
+#define NVM_LOG_CHUNK_SIZE 64U
+
+/*! Aligns a size to the flash word size. */
+#define NVM_LOG_ALIGN(size) (((size) + 3U) & ~3U)
+
+/*! The header of a sector. */
+typedef struct nvm_log_sector_hdr_t
+{
+    /*! The magic number, see #NVM_LOG_SECTOR_MAGIC. */
+    uint32_t Magic;
+
+    /*! The number of erase cycles of the sector. */
+    uint32_t EraseCount;
+
+    /*! The check value: ~(Magic ^ EraseCount). */
+    uint32_t Check;
+
+    /*! The sector sequence number; programmed when the sector is taken
+     *  into use, i.e. erased (0xFFFFFFFF) for free sectors. */
+    uint32_t Sequence;
+
+} nvm_log_sector_hdr_t;
+
+/*! The header of a record; followed by the data (padded to the flash word
+ *  size) and the commit marker. */
+typedef struct nvm_log_record_hdr_t
+{
+    /*! The magic number, see #NVM_LOG_RECORD_MAGIC. */
+    uint32_t Magic;
+
+    /*! The record sequence number; the higher the newer. */
+    uint32_t Sequence;
+
+    /*! The ID of the record. */
+    uint32_t ID;
+
+    /*! The version of the record. */
+    uint32_t Version;
+
+    /*! The data size in bytes. */
+    uint32_t Size;
+
+    /*! The CRC-32 of the ID, version, size and data. */
+    uint32_t Crc;
+
+} nvm_log_record_hdr_t;
+
+/*! The size of a record with \p size bytes of data in the flash. */
+#define NVM_LOG_RECORD_SIZE(size) \
+    (sizeof(nvm_log_record_hdr_t) + NVM_LOG_ALIGN(size) + sizeof(uint32_t))
+
+/*! The state of a sector. */
+typedef enum nvm_log_sector_state_t
+{
+    /*! The sector is erased and can be taken into use. */
+    SECTOR_FREE,
+
+    /*! The sector contains records. */
+    SECTOR_USED,
+
+    /*! The sector contents are unknown and it needs to be erased. */
+    SECTOR_DIRTY,
+
+} nvm_log_sector_state_t;
+
+/*! The RAM state of a sector. */
+typedef struct nvm_log_sector_t
+{
+    /*! The number of erase cycles of the sector. */
+    uint32_t EraseCount;
+
+    /*! The sector sequence number. */
+    uint32_t Sequence;
+
+    /*! The offset of the next record; the sector size if it is closed. */
+    uint32_t Append;
+
+    /*! The state of the sector. */
+    nvm_log_sector_state_t State;
+
+    /*! True if the erase count of a free sector is already programmed. */
+    bool Formatted;
+
+} nvm_log_sector_t;
+
+/*! An entry of the RAM directory, i.e. the location of the latest record of an ID. */
+typedef struct nvm_log_entry_t
+{
+    /*! The ID of the record; 0 if the entry is unused. */
+    uint32_t ID;
+
+    /*! The record sequence number. */
+    uint32_t Sequence;
+
+    /*! The data size in bytes. */
+    uint32_t Size;
+
+    /*! The CRC-32 of the record. */
+    uint32_t Crc;
+
+    /*! The sector of the record. */
+    uint32_t Sector;
+
+    /*! The offset of the record within its sector. */
+    uint32_t Offset;
+
+} nvm_log_entry_t;
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The flash access functions. */
+static nvm_log_flash_t const * myFlash = 0;
+
+/*! The RAM state of the sectors. */
+static nvm_log_sector_t mySectors[NVM_LOG_SECTOR_COUNT_MAX] = { 0 };
+
+/*! The RAM directory of the latest records. */
+static nvm_log_entry_t myEntries[NVM_LOG_ID_COUNT] = { 0 };
+
+/*! The index of the head sector, i.e. the one that records are appended to. */
+static int32_t myHead = -1;
+
+/*! The last record sequence number. */
+static uint32_t mySequence = 0;
+
+/*! The last sector sequence number. */
+static uint32_t mySectorSequence = 0;
+
+/*! The statistics. */
+static nvm_log_stats_t myStats = { 0 };
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static uint32_t Crc32(uint32_t crc, uint8_t const * data, uint32_t size)
+{
+    /* Nibble-wise CRC-32 (IEEE 802.3, reflected); small table for the M0+. */
+    static const uint32_t table[16] =
+    {
+        0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+        0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+        0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+        0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU,
+    };
+
+    crc = ~crc;
+    while (size--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+        crc = (crc >> 4) ^ table[crc & 0x0FU];
+    }
+    return ~crc;
+}
+
+static inline uint32_t GetHeaderCrc(nvm_log_record_hdr_t const * hdr)
+{
+    return Crc32(0, (uint8_t const *)&hdr->ID,
+                 offsetof(nvm_log_record_hdr_t, Crc) - offsetof(nvm_log_record_hdr_t, ID));
+}
+
+static uint32_t GetRecordCrc(uint32_t id, uint32_t size, uint8_t const * buf)
+{
+    nvm_log_record_hdr_t hdr = { .ID = id, .Version = myFlash->Version, .Size = size };
+    return Crc32(GetHeaderCrc(&hdr), buf, size);
+}
+
+static nvm_log_entry_t * FindEntry(uint32_t id)
+{
+    for (uint32_t i = 0; i < NVM_LOG_ID_COUNT; ++i)
+    {
+        if (myEntries[i].ID == id) return &myEntries[i];
+    }
+    return 0;
+}
+
+static uint32_t GetLiveBytes(uint32_t sector)
+{
+    uint32_t live = 0;
+    for (uint32_t i = 0; i < NVM_LOG_ID_COUNT; ++i)
+    {
+        if (myEntries[i].ID != 0 && myEntries[i].Sector == sector)
+            live += NVM_LOG_RECORD_SIZE(myEntries[i].Size);
+    }
+    return live;
+}
+
+static bool HasCapacity(uint32_t size)
+{
+    /* The records of all IDs must fit into the sectors but the spare one;
+     * estimated with the largest record size for the packing. */
+    uint32_t count = 1;
+    uint32_t recordSize = NVM_LOG_RECORD_SIZE(size);
+    for (uint32_t i = 0; i < NVM_LOG_ID_COUNT; ++i)
+    {
+        if (myEntries[i].ID == 0) continue;
+        count++;
+        if (NVM_LOG_RECORD_SIZE(myEntries[i].Size) > recordSize)
+            recordSize = NVM_LOG_RECORD_SIZE(myEntries[i].Size);
+    }
+
+    const uint32_t perSector = (myFlash->SectorSize - sizeof(nvm_log_sector_hdr_t)) / recordSize;
+    return (count + perSector - 1U) / perSector <= myFlash->SectorCount - 1U;
+}
+
+static uint32_t GetFreeCount(void)
+{
+    uint32_t count = 0;
+    for (uint32_t s = 0; s < myFlash->SectorCount; ++s)
+    {
+        if (mySectors[s].State == SECTOR_FREE) count++;
+    }
+    return count;
+}
+
+static status_t IsErased(uint32_t sector, uint32_t offset, bool * erased)
+{
+    uint32_t chunk[NVM_LOG_CHUNK_SIZE / sizeof(uint32_t)];
+
+    *erased = true;
+    while (offset < myFlash->SectorSize)
+    {
+        uint32_t n = myFlash->SectorSize - offset;
+        if (n > NVM_LOG_CHUNK_SIZE) n = NVM_LOG_CHUNK_SIZE;
+
+        status_t status = myFlash->Read(sector, offset, (uint8_t *)chunk, n);
+        if (status < STATUS_OK) return status;
+
+        for (uint32_t i = 0; i < n / sizeof(uint32_t); ++i)
+        {
+            if (chunk[i] != NVM_LOG_ERASED)
+            {
+                *erased = false;
+                return STATUS_OK;
+            }
+        }
+        offset += n;
+    }
+    return STATUS_OK;
+}
+
+static status_t GetFlashCrc(nvm_log_record_hdr_t const * hdr, uint32_t sector,
+                            uint32_t offset, uint32_t * crc)
+{
+    uint32_t chunk[NVM_LOG_CHUNK_SIZE / sizeof(uint32_t)];
+
+    *crc = GetHeaderCrc(hdr);
+    for (uint32_t pos = 0; pos < hdr->Size; pos += NVM_LOG_CHUNK_SIZE)
+    {
+        uint32_t n = hdr->Size - pos;
+        if (n > NVM_LOG_CHUNK_SIZE) n = NVM_LOG_CHUNK_SIZE;
+
+        status_t status = myFlash->Read(sector, offset + pos, (uint8_t *)chunk, n);
+        if (status < STATUS_OK) return status;
+
+        *crc = Crc32(*crc, (uint8_t const *)chunk, n);
+    }
+    return STATUS_OK;
+}
+
+static status_t IsEqual(nvm_log_entry_t const * entry, uint8_t const * buf, bool * equal)
+{
+    uint32_t chunk[NVM_LOG_CHUNK_SIZE / sizeof(uint32_t)];
+    const uint32_t offset = entry->Offset + sizeof(nvm_log_record_hdr_t);
+
+    *equal = true;
+    for (uint32_t pos = 0; pos < entry->Size; pos += NVM_LOG_CHUNK_SIZE)
+    {
+        uint32_t n = entry->Size - pos;
+        if (n > NVM_LOG_CHUNK_SIZE) n = NVM_LOG_CHUNK_SIZE;
+
+        status_t status = myFlash->Read(entry->Sector, offset + pos, (uint8_t *)chunk, n);
+        if (status < STATUS_OK) return status;
+
+        if (memcmp(chunk, buf + pos, n) != 0)
+        {
+            *equal = false;
+            break;
+        }
+    }
+    return STATUS_OK;
+}
+
+static void AddEntry(nvm_log_record_hdr_t const * hdr, uint32_t sector, uint32_t offset)
+{
+    nvm_log_entry_t * entry = FindEntry(hdr->ID);
+    if (entry != 0 && entry->Sequence > hdr->Sequence) return;
+    if (entry == 0) entry = FindEntry(0);
+    if (entry == 0) return; // directory full; the record is ignored
+
+    entry->ID = hdr->ID;
+    entry->Sequence = hdr->Sequence;
+    entry->Size = hdr->Size;
+    entry->Crc = hdr->Crc;
+    entry->Sector = sector;
+    entry->Offset = offset;
+}
+
+static status_t ScanSector(uint32_t s)
+{
+    nvm_log_sector_t * sector = &mySectors[s];
+    memset(sector, 0, sizeof(nvm_log_sector_t));
+    sector->State = SECTOR_DIRTY;
+
+    nvm_log_sector_hdr_t hdr;
+    status_t status = myFlash->Read(s, 0, (uint8_t *)&hdr, sizeof(hdr));
+    if (status < STATUS_OK) return status;
+
+    bool erased = false;
+    if (hdr.Magic == NVM_LOG_ERASED && hdr.EraseCount == NVM_LOG_ERASED &&
+        hdr.Check == NVM_LOG_ERASED && hdr.Sequence == NVM_LOG_ERASED)
+    {
+        /* Erased w/o header; e.g. power failure right after the erase. */
+        status = IsErased(s, sizeof(hdr), &erased);
+        if (status < STATUS_OK) return status;
+        if (erased) sector->State = SECTOR_FREE;
+        return STATUS_OK;
+    }
+
+    /* Unknown contents, e.g. a previous format or an interrupted erase. */
+    if (hdr.Magic != NVM_LOG_SECTOR_MAGIC || hdr.Check != ~(hdr.Magic ^ hdr.EraseCount))
+        return STATUS_OK;
+
+    sector->EraseCount = hdr.EraseCount;
+    sector->Formatted = true;
+
+    if (hdr.Sequence == NVM_LOG_ERASED)
+    {
+        status = IsErased(s, sizeof(hdr), &erased);
+        if (status < STATUS_OK) return status;
+        if (erased) sector->State = SECTOR_FREE;
+        return STATUS_OK;
+    }
+
+    sector->State = SECTOR_USED;
+
+    /* Scan the records; stop at the first erased or invalid one. A record
+     * w/o commit marker or w/ wrong CRC has been interrupted by a power
+     * failure; the sector is closed, i.e. nothing is appended anymore. */
+    uint32_t offset = sizeof(nvm_log_sector_hdr_t);
+    uint32_t records = 0;
+    sector->Append = myFlash->SectorSize;
+    while (offset + NVM_LOG_RECORD_SIZE(0) <= myFlash->SectorSize)
+    {
+        nvm_log_record_hdr_t rec;
+        status = myFlash->Read(s, offset, (uint8_t *)&rec, sizeof(rec));
+        if (status < STATUS_OK) return status;
+
+        if (rec.Magic == NVM_LOG_ERASED)
+        {
+            status = IsErased(s, offset, &erased);
+            if (status < STATUS_OK) return status;
+            if (erased) sector->Append = offset;
+            break;
+        }
+
+        if (rec.Magic != NVM_LOG_RECORD_MAGIC || rec.Size == 0 ||
+            rec.Size > myFlash->SectorSize ||
+            offset + NVM_LOG_RECORD_SIZE(rec.Size) > myFlash->SectorSize)
+            break;
+
+        uint32_t commit = 0;
+        status = myFlash->Read(s, offset + sizeof(rec) + NVM_LOG_ALIGN(rec.Size),
+                               (uint8_t *)&commit, sizeof(commit));
+        if (status < STATUS_OK) return status;
+        if (commit != NVM_LOG_COMMIT_MARK) break;
+
+        uint32_t crc = 0;
+        status = GetFlashCrc(&rec, s, offset + sizeof(rec), &crc);
+        if (status < STATUS_OK) return status;
+        if (crc != rec.Crc) break;
+
+        if (rec.Sequence > mySequence) mySequence = rec.Sequence;
+        if (rec.Version == myFlash->Version && rec.ID != 0) AddEntry(&rec, s, offset);
+
+        offset += NVM_LOG_RECORD_SIZE(rec.Size);
+        records++;
+    }
+
+    if (offset + NVM_LOG_RECORD_SIZE(0) > myFlash->SectorSize)
+        sector->Append = myFlash->SectorSize;
+
+    /* A sector w/o records may have been interrupted while programming its
+     * sequence number, i.e. the number is undefined; close it for reclaiming. */
+    if (records == 0)
+    {
+        sector->Append = myFlash->SectorSize;
+        return STATUS_OK;
+    }
+
+    sector->Sequence = hdr.Sequence;
+    if (hdr.Sequence > mySectorSequence) mySectorSequence = hdr.Sequence;
+
+    return STATUS_OK;
+}
+
+static status_t EraseSector(uint32_t s)
+{
+    nvm_log_sector_t * sector = &mySectors[s];
+    sector->State = SECTOR_DIRTY;
+    if (myHead == (int32_t)s) myHead = -1;
+
+    status_t status = myFlash->Erase(s);
+    myStats.Erases++;
+    if (status < STATUS_OK) return status;
+
+    /* Keep the erase count; the sequence number remains erased until the
+     * sector is taken into use. */
+    sector->EraseCount++;
+    nvm_log_sector_hdr_t hdr =
+    {
+        .Magic = NVM_LOG_SECTOR_MAGIC,
+        .EraseCount = sector->EraseCount,
+        .Check = ~(NVM_LOG_SECTOR_MAGIC ^ sector->EraseCount),
+    };
+    status = myFlash->Program(s, 0, (uint8_t const *)&hdr, offsetof(nvm_log_sector_hdr_t, Sequence));
+    if (status < STATUS_OK) return status;
+
+    sector->State = SECTOR_FREE;
+    sector->Formatted = true;
+    sector->Sequence = 0;
+    sector->Append = sizeof(nvm_log_sector_hdr_t);
+    return STATUS_OK;
+}
+
+static status_t OpenSector(void)
+{
+    /* Take the free sector with the lowest erase count. */
+    int32_t s = -1;
+    for (uint32_t i = 0; i < myFlash->SectorCount; ++i)
+    {
+        if (mySectors[i].State == SECTOR_FREE &&
+            (s < 0 || mySectors[i].EraseCount < mySectors[s].EraseCount))
+            s = (int32_t)i;
+    }
+    if (s < 0) return ERROR_NVM_OUT_OF_RANGE;
+
+    nvm_log_sector_t * sector = &mySectors[s];
+    nvm_log_sector_hdr_t hdr =
+    {
+        .Magic = NVM_LOG_SECTOR_MAGIC,
+        .EraseCount = sector->EraseCount,
+        .Check = ~(NVM_LOG_SECTOR_MAGIC ^ sector->EraseCount),
+        .Sequence = mySectorSequence + 1,
+    };
+
+    /* Formatted sectors only need the sequence number. */
+    const uint32_t offset = sector->Formatted ? offsetof(nvm_log_sector_hdr_t, Sequence) : 0;
+    status_t status = myFlash->Program((uint32_t)s, offset, (uint8_t const *)&hdr + offset,
+                                       sizeof(hdr) - offset);
+    if (status < STATUS_OK)
+    {
+        sector->State = SECTOR_DIRTY;
+        return status;
+    }
+
+    sector->State = SECTOR_USED;
+    sector->Sequence = hdr.Sequence;
+    sector->Append = sizeof(nvm_log_sector_hdr_t);
+    mySectorSequence = hdr.Sequence;
+    myHead = s;
+    return STATUS_OK;
+}
+
+static status_t ProgramRecord(nvm_log_entry_t * entry, uint32_t id, uint32_t size, uint32_t crc,
+                              uint8_t const * buf, nvm_log_entry_t const * from)
+{
+    assert(myHead >= 0);
+    const uint32_t s = (uint32_t)myHead;
+    const uint32_t offset = mySectors[s].Append;
+    assert(offset + NVM_LOG_RECORD_SIZE(size) <= myFlash->SectorSize);
+
+    /* The space is consumed even if programming fails. */
+    mySectors[s].Append = offset + NVM_LOG_RECORD_SIZE(size);
+
+    nvm_log_record_hdr_t hdr =
+    {
+        .Magic = NVM_LOG_RECORD_MAGIC,
+        .Sequence = mySequence + 1,
+        .ID = id,
+        .Version = myFlash->Version,
+        .Size = size,
+        .Crc = crc,
+    };
+
+    status_t status = myFlash->Program(s, offset, (uint8_t const *)&hdr, sizeof(hdr));
+
+    /* Copy the data from RAM or from the previous record in flash. */
+    uint32_t chunk[NVM_LOG_CHUNK_SIZE / sizeof(uint32_t)];
+    for (uint32_t pos = 0; pos < size && status == STATUS_OK; pos += NVM_LOG_CHUNK_SIZE)
+    {
+        uint32_t n = size - pos;
+        if (n > NVM_LOG_CHUNK_SIZE) n = NVM_LOG_CHUNK_SIZE;
+
+        if (from != 0)
+            status = myFlash->Read(from->Sector, from->Offset + sizeof(hdr) + pos, (uint8_t *)chunk, n);
+        else
+            memcpy(chunk, buf + pos, n);
+
+        memset((uint8_t *)chunk + n, 0xFF, NVM_LOG_ALIGN(n) - n);
+        if (status == STATUS_OK)
+            status = myFlash->Program(s, offset + sizeof(hdr) + pos, (uint8_t const *)chunk, NVM_LOG_ALIGN(n));
+    }
+
+    /* Commit the record. */
+    const uint32_t commit = NVM_LOG_COMMIT_MARK;
+    if (status == STATUS_OK)
+        status = myFlash->Program(s, offset + sizeof(hdr) + NVM_LOG_ALIGN(size),
+                                  (uint8_t const *)&commit, sizeof(commit));
+
+    mySequence = hdr.Sequence;
+    if (status < STATUS_OK)
+    {
+        /* The sector contents are undefined from here; close it. */
+        mySectors[s].Append = myFlash->SectorSize;
+        return status;
+    }
+
+    entry->ID = id;
+    entry->Sequence = hdr.Sequence;
+    entry->Size = size;
+    entry->Crc = crc;
+    entry->Sector = s;
+    entry->Offset = offset;
+    return STATUS_OK;
+}
+
+static status_t Reclaim(void)
+{
+    /* Select the victim: least live data first (i.e. dirty or obsolete
+     * sectors), then lowest erase count for wear levelling. The head is
+     * only spared while it is open; after a power failure it is closed. */
+    int32_t victim = -1;
+    uint32_t victimLive = UINT32_MAX;
+    for (uint32_t s = 0; s < myFlash->SectorCount; ++s)
+    {
+        if (mySectors[s].State == SECTOR_FREE) continue;
+        if ((int32_t)s == myHead && mySectors[s].Append < myFlash->SectorSize) continue;
+
+        const uint32_t live = mySectors[s].State == SECTOR_DIRTY ? 0 : GetLiveBytes(s);
+        if (victim < 0 || live < victimLive ||
+            (live == victimLive && mySectors[s].EraseCount < mySectors[victim].EraseCount))
+        {
+            victim = (int32_t)s;
+            victimLive = live;
+        }
+    }
+    if (victim < 0) return ERROR_NVM_OUT_OF_RANGE;
+    if (victim == myHead) myHead = -1;
+
+    /* Move its live records to the head sector; the sector is kept if they
+     * do not fit, i.e. live records are never dropped. */
+    for (uint32_t i = 0; i < NVM_LOG_ID_COUNT && victimLive > 0; ++i)
+    {
+        nvm_log_entry_t * entry = &myEntries[i];
+        if (entry->ID == 0 || entry->Sector != (uint32_t)victim) continue;
+
+        if (myHead < 0 || mySectors[myHead].Append +
+            NVM_LOG_RECORD_SIZE(entry->Size) > myFlash->SectorSize)
+            return ERROR_NVM_OUT_OF_RANGE;
+
+        const nvm_log_entry_t from = *entry;
+        status_t status = ProgramRecord(entry, from.ID, from.Size, from.Crc, 0, &from);
+        if (status < STATUS_OK) return status;
+        myStats.Relocations++;
+    }
+
+    return EraseSector((uint32_t)victim);
+}
+
+static status_t Collect(void)
+{
+    /* Keep a single sector erased. */
+    while (GetFreeCount() == 0)
+    {
+        status_t status = Reclaim();
+        if (status < STATUS_OK) return status;
+    }
+    return STATUS_OK;
+}
+
+status_t NVMLog_Init(nvm_log_flash_t const * flash)
+{
+    assert(flash != 0);
+    assert(flash->Read != 0 && flash->Program != 0 && flash->Erase != 0);
+
+    if (flash->SectorCount < 2 || flash->SectorCount > NVM_LOG_SECTOR_COUNT_MAX)
+        return ERROR_INVALID_ARGUMENT;
+    if ((flash->SectorSize & 3U) ||
+        flash->SectorSize < sizeof(nvm_log_sector_hdr_t) + NVM_LOG_RECORD_SIZE(4U))
+        return ERROR_INVALID_ARGUMENT;
+
+    myFlash = flash;
+    myHead = -1;
+    mySequence = 0;
+    mySectorSequence = 0;
+    memset(myEntries, 0, sizeof(myEntries));
+    memset(&myStats, 0, sizeof(myStats));
+
+    uint32_t maxEraseCount = 0;
+    for (uint32_t s = 0; s < flash->SectorCount; ++s)
+    {
+        status_t status = ScanSector(s);
+        if (status < STATUS_OK) return status;
+
+        if (mySectors[s].EraseCount > maxEraseCount)
+            maxEraseCount = mySectors[s].EraseCount;
+
+        /* The head is the sector that has been taken into use last. */
+        if (mySectors[s].State == SECTOR_USED &&
+            (myHead < 0 || mySectors[s].Sequence > mySectors[myHead].Sequence))
+            myHead = (int32_t)s;
+    }
+
+    /* The erase count of sectors w/o valid header is unknown; the maximum
+     * is a conservative estimate for wear levelling. */
+    for (uint32_t s = 0; s < flash->SectorCount; ++s)
+    {
+        if (!mySectors[s].Formatted) mySectors[s].EraseCount = maxEraseCount;
+    }
+
+    return Collect();
+}
+
+status_t NVMLog_Write(uint32_t id, uint32_t size, uint8_t const * buf)
+{
+    assert(myFlash != 0);
+    assert(buf != 0);
+    if (id == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+    if (NVM_LOG_RECORD_SIZE(size) > myFlash->SectorSize - sizeof(nvm_log_sector_hdr_t))
+        return ERROR_NVM_OUT_OF_RANGE;
+
+    const uint32_t crc = GetRecordCrc(id, size, buf);
+    nvm_log_entry_t * entry = FindEntry(id);
+
+    /* Skip writes of unchanged data. */
+    if (entry != 0 && entry->Size == size && entry->Crc == crc)
+    {
+        bool equal = false;
+        status_t status = IsEqual(entry, buf, &equal);
+        if (status < STATUS_OK) return status;
+        if (equal)
+        {
+            myStats.Skipped++;
+            return STATUS_OK;
+        }
+    }
+
+    if (entry == 0)
+    {
+        entry = FindEntry(0);
+        if (entry == 0 || !HasCapacity(size))
+        {
+            myStats.Rejections++;
+            return ERROR_NVM_OUT_OF_RANGE;
+        }
+    }
+
+    if (myHead < 0 || mySectors[myHead].Append + NVM_LOG_RECORD_SIZE(size) > myFlash->SectorSize)
+    {
+        status_t status = Collect();
+        if (status < STATUS_OK) return status;
+
+        status = OpenSector();
+        if (status < STATUS_OK) return status;
+    }
+
+    status_t status = ProgramRecord(entry, id, size, crc, buf, 0);
+    if (status < STATUS_OK) return status;
+    myStats.Writes++;
+
+    return Collect();
+}
+
+status_t NVMLog_Read(uint32_t id, uint32_t size, uint8_t * buf)
+{
+    assert(myFlash != 0);
+    assert(buf != 0);
+    if (id == 0) return ERROR_INVALID_ARGUMENT;
+    if (size == 0) return ERROR_INVALID_ARGUMENT;
+
+    status_t status = ERROR_NVM_EMPTY;
+    nvm_log_entry_t const * entry = FindEntry(id);
+    if (entry != 0 && entry->Size == size)
+    {
+        status = myFlash->Read(entry->Sector, entry->Offset + sizeof(nvm_log_record_hdr_t), buf, size);
+
+        /* The flash may have been modified behind the log. */
+        if (status == STATUS_OK && GetRecordCrc(id, size, buf) == entry->Crc)
+            return STATUS_OK;
+
+        if (status == STATUS_OK) status = ERROR_NVM_EMPTY;
+    }
+
+    /* Reset buffer in case of any error. */
+    memset(buf, 0, size);
+    return status;
+}
+
+bool NVMLog_Contains(uint32_t id)
+{
+    assert(myFlash != 0);
+    return id != 0 && FindEntry(id) != 0;
+}
+
+status_t NVMLog_Format(void)
+{
+    assert(myFlash != 0);
+
+    memset(myEntries, 0, sizeof(myEntries));
+    myHead = -1;
+
+    for (uint32_t s = 0; s < myFlash->SectorCount; ++s)
+    {
+        status_t status = EraseSector(s);
+        if (status < STATUS_OK) return status;
+    }
+    return STATUS_OK;
+}
+
+void NVMLog_GetStats(nvm_log_stats_t * stats)
+{
+    assert(stats != 0);
+    *stats = myStats;
+
+    stats->MinEraseCount = UINT32_MAX;
+    stats->MaxEraseCount = 0;
+    for (uint32_t s = 0; myFlash != 0 && s < myFlash->SectorCount; ++s)
+    {
+        if (mySectors[s].EraseCount < stats->MinEraseCount)
+            stats->MinEraseCount = mySectors[s].EraseCount;
+        if (mySectors[s].EraseCount > stats->MaxEraseCount)
+            stats->MaxEraseCount = mySectors[s].EraseCount;
+    }
+    if (stats->MinEraseCount == UINT32_MAX) stats->MinEraseCount = 0;
+}
@@ -0,0 +1,225 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a log-structured, wear-levelled record store
+ *              for the non-volatile memory module on top of a raw flash.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef NVM_LOG_H
+#define NVM_LOG_H
+
+/*!***************************************************************************
+ * @defgroup    nvm_log NVM Record Log
+ * @ingroup     platform
+ * @brief       Log-Structured, Wear-Levelled NVM Record Store
+ * @details     Implements the #argus_nvm interface as an append-only record
+ *              log over a ring of flash sectors. Instead of erasing and
+ *              rewriting a sector for each update, a new record is appended
+ *              to the current head sector. Old records become obsolete and
+ *              their sectors are erased by the garbage collection once they
+ *              do not contain any live record anymore.
+ *
+ *              Each sector starts with a header that contains its erase
+ *              count and the sequence number of its first use. Each record
+ *              consists of a header (record sequence number, ID, version,
+ *              size and CRC-32), the data and a commit marker. The commit
+ *              marker is programmed last; records without valid marker or
+ *              CRC are the result of a power failure and are ignored. Thus,
+ *              a previous record is valid until its successor is committed.
+ *
+ *              A small RAM directory maps each ID to its latest record; it
+ *              is built when the log is mounted (#NVMLog_Init) and updated
+ *              on each write. Writes with unchanged data are skipped.
+ *
+ *              The garbage collection keeps at least a single sector erased.
+ *              Whenever the last erased sector is taken into use, the sector
+ *              with the least live data (and the lowest erase count) is
+ *              reclaimed: its live records are copied to the head sector and
+ *              it is erased. The records of all IDs must fit into the sectors
+ *              but the spare one; a write of a new ID that exceeds this
+ *              capacity fails with #ERROR_NVM_OUT_OF_RANGE. Live records are
+ *              never dropped.
+ *
+ *              The flash is accessed via a set of functions provided by the
+ *              platform (see #nvm_log_flash_t). The flash must be erased to
+ *              0xFF and must be programmable in 32-bit words.
+ *
+ * @addtogroup  nvm_log
+ * @{
+ *****************************************************************************/
+
+#include "api/argus_status.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*! The magic number at the start of each formatted sector of the log ('NVLS');
+ *  allows the platform to tell the log from data of a previous format. */
+#define NVM_LOG_SECTOR_MAGIC 0x4E564C53U
+
+/*!***************************************************************************
+ * @brief   The maximum number of flash sectors of the log.
+ *****************************************************************************/
+#ifndef NVM_LOG_SECTOR_COUNT_MAX
+#define NVM_LOG_SECTOR_COUNT_MAX 8U
+#endif
+
+/*!***************************************************************************
+ * @brief   The maximum number of IDs (i.e. devices) in the log.
+ * @details Records of further IDs are ignored when mounting the log and
+ *          writes of further IDs fail.
+ *****************************************************************************/
+#ifndef NVM_LOG_ID_COUNT
+#define NVM_LOG_ID_COUNT 8U
+#endif
+
+/*! The flash access functions and geometry for the NVM record log. */
+typedef struct nvm_log_flash_t
+{
+    /*! The size of a flash sector in bytes; a multiple of 4. */
+    uint32_t SectorSize;
+
+    /*! The number of flash sectors; at least 2 and up to #NVM_LOG_SECTOR_COUNT_MAX. */
+    uint32_t SectorCount;
+
+    /*! The version of the records; records with other version are ignored. */
+    uint32_t Version;
+
+    /*! Reads \p size bytes at \p offset of the \p sector into \p data. */
+    status_t (*Read)(uint32_t sector, uint32_t offset, uint8_t * data, uint32_t size);
+
+    /*! Programs \p size bytes at \p offset of the erased \p sector w/o erase;
+     *  \p offset and \p size are multiples of 4 and \p data is word aligned. */
+    status_t (*Program)(uint32_t sector, uint32_t offset, uint8_t const * data, uint32_t size);
+
+    /*! Erases the \p sector to 0xFF. */
+    status_t (*Erase)(uint32_t sector);
+
+} nvm_log_flash_t;
+
+/*! The statistics of the NVM record log since it has been mounted. */
+typedef struct nvm_log_stats_t
+{
+    /*! The number of appended records. */
+    uint32_t Writes;
+
+    /*! The number of writes that have been skipped due to unchanged data. */
+    uint32_t Skipped;
+
+    /*! The number of sector erases. */
+    uint32_t Erases;
+
+    /*! The number of records copied by the garbage collection. */
+    uint32_t Relocations;
+
+    /*! The number of writes rejected due to exhausted capacity. */
+    uint32_t Rejections;
+
+    /*! The minimum erase count of all sectors. */
+    uint32_t MinEraseCount;
+
+    /*! The maximum erase count of all sectors. */
+    uint32_t MaxEraseCount;
+
+} nvm_log_stats_t;
+
+/*!***************************************************************************
+ * @brief   Mounts the NVM record log.
+ *
+ * @details Scans all sectors, builds the RAM directory of the latest valid
+ *          records and determines the head sector. Sectors with unknown
+ *          contents (e.g. data of a previous format or an interrupted erase)
+ *          are erased by the garbage collection.
+ *
+ * @param   flash The flash access functions; must remain valid.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVMLog_Init(nvm_log_flash_t const * flash);
+
+/*!***************************************************************************
+ * @brief   Appends a record to the NVM record log.
+ *
+ * @details See #NVM_WriteBlock. The record supersedes the previous record
+ *          of the same ID once it is committed. Nothing is written if the
+ *          data equals the current record. A new ID is rejected if its
+ *          record does not fit into the log besides the records of all
+ *          other IDs.
+ *
+ * @param   id The ID of the record, e.g. the chip ID; must not be 0.
+ * @param   size The size of the data in bytes.
+ * @param   buf The data to be written.
+ *
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_NVM_OUT_OF_RANGE if the capacity of the log is exhausted.
+ *****************************************************************************/
+status_t NVMLog_Write(uint32_t id, uint32_t size, uint8_t const * buf);
+
+/*!***************************************************************************
+ * @brief   Reads the latest record of an ID from the NVM record log.
+ *
+ * @details See #NVM_ReadBlock. The buffer is cleared in case of any error.
+ *
+ * @param   id The ID of the record, e.g. the chip ID; must not be 0.
+ * @param   size The size of the data in bytes.
+ * @param   buf The buffer to be filled with the data.
+ *
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_NVM_EMPTY if no valid record of the \p size is found.
+ *****************************************************************************/
+status_t NVMLog_Read(uint32_t id, uint32_t size, uint8_t * buf);
+
+/*!***************************************************************************
+ * @brief   Determines whether the NVM record log holds a record of an ID.
+ * @param   id The ID of the record.
+ * @return  Returns true if a valid record of the \p id exists.
+ *****************************************************************************/
+bool NVMLog_Contains(uint32_t id);
+
+/*!***************************************************************************
+ * @brief   Erases all sectors of the NVM record log.
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t NVMLog_Format(void);
+
+/*!***************************************************************************
+ * @brief   Gets the statistics of the NVM record log.
+ * @param   stats The statistics to be filled.
+ *****************************************************************************/
+void NVMLog_GetStats(nvm_log_stats_t * stats);
+
+/*! @} */
+#endif /* NVM_LOG_H */
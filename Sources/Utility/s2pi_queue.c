@@ -0,0 +1,273 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a transaction queue for S2PI drivers that
+ *              serve multiple slaves on a single SPI bus.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "s2pi_queue.h"
+
+#include "platform/argus_irq.h"
+
+#include <assert.h>
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The ring buffer of queued transfer frames. */
+static s2pi_queue_entry_t myQueue[S2PI_QUEUE_LENGTH];
+
+/*! The index of the first queued frame. */
+static volatile uint32_t myHead = 0;
+
+/*! The number of queued frames. */
+static volatile uint32_t myCount = 0;
+
+/*! The transfer statistics; slave index starts with 1. */
+static s2pi_queue_stats_t myStats[S2PI_QUEUE_SLAVE_COUNT + 1];
+
+/*! The start time of the statistics. */
+static ltc_t myStatsTime;
+
+/*! The start time of the currently ongoing transfer of each slave. */
+static ltc_t myActiveTime[S2PI_QUEUE_SLAVE_COUNT + 1];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline s2pi_queue_stats_t * GetStats(s2pi_slave_t slave)
+{
+    return (slave > 0 && slave <= S2PI_QUEUE_SLAVE_COUNT) ? &myStats[slave] : NULL;
+}
+
+static inline s2pi_queue_entry_t * GetEntry(uint32_t i)
+{
+    return &myQueue[(myHead + i) % S2PI_QUEUE_LENGTH];
+}
+
+/*! Removes the i-th queued frame; must be called with interrupts locked. */
+static void RemoveEntry(uint32_t i, s2pi_queue_entry_t * entry)
+{
+    *entry = *GetEntry(i);
+
+    if (i == 0)
+    {
+        myHead = (myHead + 1) % S2PI_QUEUE_LENGTH;
+    }
+    else
+    {
+        /* Close the gap by moving the subsequent frames forward. */
+        for (uint32_t j = i + 1; j < myCount; j++)
+        {
+            *GetEntry(j - 1) = *GetEntry(j);
+        }
+    }
+    myCount--;
+}
+
+void S2PIQueue_Init(void)
+{
+    IRQ_LOCK();
+    myHead = 0;
+    myCount = 0;
+    IRQ_UNLOCK();
+
+    S2PIQueue_ResetStats();
+}
+
+status_t S2PIQueue_Push(s2pi_slave_t slave,
+                        uint8_t const * txData,
+                        uint8_t * rxData,
+                        size_t frameSize,
+                        s2pi_callback_t callback,
+                        void * callbackData)
+{
+    IRQ_LOCK();
+    if (myCount >= S2PI_QUEUE_LENGTH)
+    {
+        IRQ_UNLOCK();
+        return STATUS_BUSY;
+    }
+
+    s2pi_queue_entry_t * entry = GetEntry(myCount);
+    entry->Slave = slave;
+    entry->TxData = txData;
+    entry->RxData = rxData;
+    entry->FrameSize = frameSize;
+    entry->Callback = callback;
+    entry->CallbackData = callbackData;
+    Time_GetNow(&entry->QueueTime);
+    myCount++;
+    IRQ_UNLOCK();
+
+    return STATUS_OK;
+}
+
+bool S2PIQueue_Pop(s2pi_queue_entry_t * entry, uint32_t slaves)
+{
+    assert(entry != NULL);
+
+    IRQ_LOCK();
+    for (uint32_t i = 0; i < myCount; i++)
+    {
+        if (slaves & (1U << GetEntry(i)->Slave))
+        {
+            RemoveEntry(i, entry);
+
+            s2pi_queue_stats_t * stats = GetStats(entry->Slave);
+            if (stats != NULL)
+            {
+                const uint32_t delay = Time_GetElapsedUSec(&entry->QueueTime);
+                stats->Queued++;
+                stats->QueueDelay += delay;
+                if (delay > stats->QueueDelayMax) stats->QueueDelayMax = delay;
+            }
+
+            IRQ_UNLOCK();
+            return true;
+        }
+    }
+    IRQ_UNLOCK();
+
+    return false;
+}
+
+bool S2PIQueue_Remove(s2pi_slave_t slave, s2pi_queue_entry_t * entry)
+{
+    assert(entry != NULL);
+
+    IRQ_LOCK();
+    for (uint32_t i = 0; i < myCount; i++)
+    {
+        if (GetEntry(i)->Slave == slave)
+        {
+            RemoveEntry(i, entry);
+            IRQ_UNLOCK();
+            return true;
+        }
+    }
+    IRQ_UNLOCK();
+
+    return false;
+}
+
+bool S2PIQueue_IsPending(s2pi_slave_t slave)
+{
+    bool pending = false;
+
+    IRQ_LOCK();
+    for (uint32_t i = 0; i < myCount && !pending; i++)
+    {
+        pending = GetEntry(i)->Slave == slave;
+    }
+    IRQ_UNLOCK();
+
+    return pending;
+}
+
+void S2PIQueue_TransferStarted(s2pi_slave_t slave, size_t frameSize)
+{
+    s2pi_queue_stats_t * stats = GetStats(slave);
+    if (stats == NULL) return;
+
+    IRQ_LOCK();
+    Time_GetNow(&myActiveTime[slave]);
+    stats->Transfers++;
+    stats->Bytes += (uint32_t)frameSize;
+    IRQ_UNLOCK();
+}
+
+void S2PIQueue_TransferFinished(s2pi_slave_t slave)
+{
+    s2pi_queue_stats_t * stats = GetStats(slave);
+    if (stats == NULL) return;
+
+    IRQ_LOCK();
+    stats->BusyTime += Time_GetElapsedUSec(&myActiveTime[slave]);
+    IRQ_UNLOCK();
+}
+
+status_t S2PIQueue_GetStats(s2pi_slave_t slave, s2pi_queue_stats_t * stats)
+{
+    assert(stats != NULL);
+
+    s2pi_queue_stats_t const * s = GetStats(slave);
+    if (s == NULL) return ERROR_S2PI_INVALID_SLAVE;
+
+    IRQ_LOCK();
+    *stats = *s;
+    stats->ObservationTime = Time_GetElapsedMSec(&myStatsTime);
+    IRQ_UNLOCK();
+
+    /* µs per ms equals ‰ */
+    stats->Utilization = stats->ObservationTime > 0
+                       ? stats->BusyTime / stats->ObservationTime : 0;
+    stats->Throughput = stats->ObservationTime > 0
+                      ? (uint32_t)(((uint64_t)stats->Bytes * 1000U) / stats->ObservationTime) : 0;
+
+    return STATUS_OK;
+}
+
+uint32_t S2PIQueue_GetThroughput(void)
+{
+    uint64_t bytes = 0;
+
+    IRQ_LOCK();
+    for (uint32_t i = 1; i <= S2PI_QUEUE_SLAVE_COUNT; i++)
+    {
+        bytes += myStats[i].Bytes;
+    }
+    const uint32_t elapsed_ms = Time_GetElapsedMSec(&myStatsTime);
+    IRQ_UNLOCK();
+
+    return elapsed_ms > 0 ? (uint32_t)((bytes * 1000U) / elapsed_ms) : 0;
+}
+
+void S2PIQueue_ResetStats(void)
+{
+    IRQ_LOCK();
+    for (uint32_t i = 0; i <= S2PI_QUEUE_SLAVE_COUNT; i++)
+    {
+        myStats[i] = (s2pi_queue_stats_t){ 0 };
+    }
+    Time_GetNow(&myStatsTime);
+    IRQ_UNLOCK();
+}
@@ -0,0 +1,244 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a transaction queue for S2PI drivers that
+ *              serve multiple slaves on a single SPI bus.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef S2PI_QUEUE_H
+#define S2PI_QUEUE_H
+
+/*!***************************************************************************
+ * @defgroup    s2pi_queue S2PI Transaction Queue
+ * @ingroup     platform
+ * @brief       S2PI Transaction Queue for Multiple Slaves on a single Bus
+ * @details     Queues S2PI transfer frames that can not be started immediately
+ *              because the SPI bus is occupied by another slave (or is in GPIO
+ *              mode). Instead of returning #STATUS_BUSY to the caller, the
+ *              #S2PI_TransferFrame implementation pushes the frame to the
+ *              queue and returns #STATUS_OK. The S2PI driver pops the next
+ *              frame whenever the bus becomes idle, i.e. directly from the
+ *              transfer complete interrupt, and starts it before invoking the
+ *              callback of the finished frame. Thus, queued frames are
+ *              transferred back to back without involving their callers.
+ *
+ *              Chip select and baud rate are a per-slave setting of the S2PI
+ *              driver and are applied whenever a frame is started.
+ *
+ *              Drivers with multiple SPI instances (i.e. independent buses)
+ *              share a single queue. They pop the first queued frame that
+ *              addresses an idle instance, see #S2PIQueue_Pop. Thus, the
+ *              transfers on different instances may run concurrently.
+ *
+ *              In addition, the queue records the bus utilization, the
+ *              throughput and the queueing delay per slave, see
+ *              #S2PIQueue_GetStats and #S2PIQueue_GetThroughput.
+ *
+ *              All functions lock the interrupts internally and may be
+ *              called from the interrupt service routines of the driver.
+ *
+ * @addtogroup  s2pi_queue
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_s2pi.h"
+#include "utility/time.h"
+#include <stdbool.h>
+
+/*!***************************************************************************
+ * @brief   The maximum number of queued transfer frames.
+ * @details Must be at least the number of AFBR-S50 devices that share a
+ *          single SPI bus minus one.
+ *****************************************************************************/
+#ifndef S2PI_QUEUE_LENGTH
+#define S2PI_QUEUE_LENGTH 4U
+#endif
+
+/*!***************************************************************************
+ * @brief   The maximum S2PI slave identifier to record statistics for.
+ *****************************************************************************/
+#ifndef S2PI_QUEUE_SLAVE_COUNT
+#define S2PI_QUEUE_SLAVE_COUNT 6
+#endif
+
+/*! The slave mask to pop the next frame of any slave, see #S2PIQueue_Pop. */
+#define S2PI_QUEUE_ALL_SLAVES 0xFFFFFFFFU
+
+/*! A queued S2PI transfer frame, see #S2PI_TransferFrame. */
+typedef struct s2pi_queue_entry_t
+{
+    /*! The S2PI slave. */
+    s2pi_slave_t Slave;
+
+    /*! The data to be written to the MOSI line. */
+    uint8_t const * TxData;
+
+    /*! The buffer for the data read from the MISO line; may be null. */
+    uint8_t * RxData;
+
+    /*! The number of bytes to be transferred. */
+    size_t FrameSize;
+
+    /*! The callback to be invoked after the transfer; may be null. */
+    s2pi_callback_t Callback;
+
+    /*! The parameter to be passed to the callback. */
+    void * CallbackData;
+
+    /*! The time when the frame has been queued. */
+    ltc_t QueueTime;
+
+} s2pi_queue_entry_t;
+
+/*! The S2PI transfer statistics of a single slave. */
+typedef struct s2pi_queue_stats_t
+{
+    /*! The number of transferred frames. */
+    uint32_t Transfers;
+
+    /*! The number of transferred bytes. */
+    uint32_t Bytes;
+
+    /*! The number of frames that have been queued before their transfer. */
+    uint32_t Queued;
+
+    /*! The accumulated bus busy time in µs. */
+    uint32_t BusyTime;
+
+    /*! The accumulated queueing delay of all queued frames in µs. */
+    uint32_t QueueDelay;
+
+    /*! The maximum queueing delay of a single frame in µs. */
+    uint32_t QueueDelayMax;
+
+    /*! The observation time (i.e. time since the last reset) in ms. */
+    uint32_t ObservationTime;
+
+    /*! The bus utilization by the slave in ‰, i.e. the ratio of bus busy
+     *  time and observation time. */
+    uint32_t Utilization;
+
+    /*! The average throughput of the slave in bytes per second. */
+    uint32_t Throughput;
+
+} s2pi_queue_stats_t;
+
+/*!***************************************************************************
+ * @brief   Initializes the S2PI transaction queue.
+ * @details Removes all queued frames and resets the statistics.
+ *****************************************************************************/
+void S2PIQueue_Init(void);
+
+/*!***************************************************************************
+ * @brief   Pushes a transfer frame to the end of the queue.
+ * @details See #S2PI_TransferFrame for the parameters.
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK if the frame has been queued.
+ *          - #STATUS_BUSY if the queue is full.
+ *****************************************************************************/
+status_t S2PIQueue_Push(s2pi_slave_t slave,
+                        uint8_t const * txData,
+                        uint8_t * rxData,
+                        size_t frameSize,
+                        s2pi_callback_t callback,
+                        void * callbackData);
+
+/*!***************************************************************************
+ * @brief   Pops the first queued transfer frame of a set of slaves.
+ * @details The queue order is preserved for the remaining frames.
+ * @param   entry The popped frame.
+ * @param   slaves The bit mask of the slaves to be considered, i.e. bit n
+ *                 is set for slave n; see #S2PI_QUEUE_ALL_SLAVES.
+ * @return  Returns false if no frame of the specified slaves is queued.
+ *****************************************************************************/
+bool S2PIQueue_Pop(s2pi_queue_entry_t * entry, uint32_t slaves);
+
+/*!***************************************************************************
+ * @brief   Removes the first queued transfer frame of a specified slave.
+ * @details Used to abort the queued frames of a slave; the driver invokes
+ *          the callbacks of the removed frames with #ERROR_ABORTED.
+ * @param   slave The S2PI slave.
+ * @param   entry The removed frame.
+ * @return  Returns false if no frame of the slave is queued.
+ *****************************************************************************/
+bool S2PIQueue_Remove(s2pi_slave_t slave, s2pi_queue_entry_t * entry);
+
+/*!***************************************************************************
+ * @brief   Checks whether transfer frames of a specified slave are queued.
+ * @param   slave The S2PI slave.
+ * @return  Returns true if at least one frame of the slave is queued.
+ *****************************************************************************/
+bool S2PIQueue_IsPending(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Records the start of a transfer frame on the bus.
+ * @param   slave The S2PI slave.
+ * @param   frameSize The number of bytes to be transferred.
+ *****************************************************************************/
+void S2PIQueue_TransferStarted(s2pi_slave_t slave, size_t frameSize);
+
+/*!***************************************************************************
+ * @brief   Records the end of the current transfer frame of a slave.
+ * @param   slave The S2PI slave.
+ *****************************************************************************/
+void S2PIQueue_TransferFinished(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Gets the transfer statistics of a specified slave.
+ * @param   slave The S2PI slave.
+ * @param   stats The statistics.
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_S2PI_INVALID_SLAVE if no statistics are recorded for
+ *            the slave.
+ *****************************************************************************/
+status_t S2PIQueue_GetStats(s2pi_slave_t slave, s2pi_queue_stats_t * stats);
+
+/*!***************************************************************************
+ * @brief   Gets the aggregate throughput of all slaves.
+ * @details The sum of transferred bytes of all slaves over the observation
+ *          time. Transfers on different SPI instances run concurrently, thus
+ *          the aggregate throughput may exceed the baud rate of a single bus.
+ * @return  Returns the aggregate throughput in bytes per second.
+ *****************************************************************************/
+uint32_t S2PIQueue_GetThroughput(void);
+
+/*!***************************************************************************
+ * @brief   Resets the transfer statistics of all slaves.
+ *****************************************************************************/
+void S2PIQueue_ResetStats(void);
+
+/*! @} */
+#endif /* S2PI_QUEUE_H */
@@ -0,0 +1,170 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a binary recorder for S2PI transfers.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "s2pi_trace.h"
+#include "hr_clock.h"
+
+#include "platform/argus_irq.h"
+
+#include <assert.h>
+#include <string.h>
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The ring buffer of recorded transfer frames. */
+static s2pi_trace_record_t myRecords[S2PI_TRACE_LENGTH];
+
+/*! The identifier of the next record; counts all recorded frames. */
+static uint32_t myNextId = 0;
+
+/*! The transfer counters; slave index starts with 1. */
+static s2pi_trace_stats_t myStats[S2PI_TRACE_SLAVE_COUNT + 1];
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+static inline bool IsValidSlave(s2pi_slave_t slave)
+{
+    return slave > 0 && slave <= S2PI_TRACE_SLAVE_COUNT;
+}
+
+void S2PITrace_Reset(void)
+{
+    static_assert((S2PI_TRACE_LENGTH & (S2PI_TRACE_LENGTH - 1U)) == 0,
+                  "S2PI_TRACE_LENGTH must be a power of two!");
+
+    IRQ_LOCK();
+    memset(myRecords, 0, sizeof(myRecords));
+    memset(myStats, 0, sizeof(myStats));
+    myNextId = 0;
+    IRQ_UNLOCK();
+}
+
+uint32_t S2PITrace_Begin(s2pi_slave_t slave, size_t length)
+{
+    const uint32_t now = (uint32_t)HRClock_Now();
+
+    IRQ_LOCK();
+    const uint32_t id = myNextId++;
+    s2pi_trace_record_t * record = &myRecords[id & (S2PI_TRACE_LENGTH - 1U)];
+    record->Start = now;
+    record->Duration = 0;
+    record->Length = length > UINT16_MAX ? UINT16_MAX : (uint16_t)length;
+    record->Status = STATUS_BUSY;
+    record->Slave = (uint8_t)slave;
+
+    if (IsValidSlave(slave) && myStats[slave].Current < UINT16_MAX)
+        myStats[slave].Current++;
+    IRQ_UNLOCK();
+
+    return id;
+}
+
+void S2PITrace_End(uint32_t id, status_t status)
+{
+    const uint32_t now = (uint32_t)HRClock_Now();
+
+    IRQ_LOCK();
+    s2pi_trace_record_t * record = &myRecords[id & (S2PI_TRACE_LENGTH - 1U)];
+    const s2pi_slave_t slave = (s2pi_slave_t)record->Slave;
+
+    /* The record is still in the ring if no more than LENGTH frames have
+     * been started since; the unsigned difference handles the wrap around. */
+    if (myNextId - id <= S2PI_TRACE_LENGTH)
+    {
+        record->Duration = now - record->Start;
+        record->Status = (int16_t)status;
+
+        if (status < STATUS_OK && IsValidSlave(slave))
+            myStats[slave].Errors++;
+    }
+    IRQ_UNLOCK();
+}
+
+void S2PITrace_MarkFrame(s2pi_slave_t slave)
+{
+    if (!IsValidSlave(slave)) return;
+
+    IRQ_LOCK();
+    s2pi_trace_stats_t * stats = &myStats[slave];
+    const uint16_t count = stats->Current;
+
+    stats->LastPerFrame = count;
+    if (stats->Frames == 0 || count < stats->MinPerFrame) stats->MinPerFrame = count;
+    if (count > stats->MaxPerFrame) stats->MaxPerFrame = count;
+    stats->FrameTransfers += count;
+    stats->Frames++;
+    stats->Current = 0;
+    IRQ_UNLOCK();
+}
+
+status_t S2PITrace_GetStats(s2pi_slave_t slave, s2pi_trace_stats_t * stats)
+{
+    assert(stats != 0);
+    if (!IsValidSlave(slave)) return ERROR_S2PI_INVALID_SLAVE;
+
+    IRQ_LOCK();
+    *stats = myStats[slave];
+    IRQ_UNLOCK();
+
+    return STATUS_OK;
+}
+
+uint32_t S2PITrace_GetRecords(s2pi_trace_record_t * records, uint32_t count)
+{
+    assert(records != 0 || count == 0);
+
+    IRQ_LOCK();
+    const uint32_t next = myNextId;
+    uint32_t n = next < S2PI_TRACE_LENGTH ? next : S2PI_TRACE_LENGTH;
+    if (n > count) n = count;
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        records[i] = myRecords[(next - n + i) & (S2PI_TRACE_LENGTH - 1U)];
+    }
+    IRQ_UNLOCK();
+
+    return n;
+}
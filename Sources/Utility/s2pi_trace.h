@@ -0,0 +1,181 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a binary recorder for S2PI transfers.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+#ifndef S2PI_TRACE_H
+#define S2PI_TRACE_H
+
+/*!***************************************************************************
+ * @defgroup    s2pi_trace S2PI Bus Trace
+ * @ingroup     platform
+ * @brief       Binary S2PI Transaction Recorder
+ * @details     Records each S2PI transfer frame (slave, length, start time,
+ *              duration and completion status) in a ring buffer that keeps
+ *              the latest #S2PI_TRACE_LENGTH frames. The timestamps are taken
+ *              from the high resolution clock (#HRClock_Now), i.e. a record
+ *              costs two clock reads and a few stores; the trace can be left
+ *              enabled at high frame rates without distorting the timing.
+ *
+ *              In addition, the transfers per measurement frame are counted
+ *              per slave. The application marks the end of each measurement
+ *              frame via #S2PITrace_MarkFrame. The bus busy time and the
+ *              throughput per slave are recorded by the transaction queue,
+ *              see #S2PIQueue_GetStats.
+ *
+ *              The S2PI driver calls #S2PITrace_Begin when a frame is started
+ *              and #S2PITrace_End when it is completed. All functions lock
+ *              the interrupts internally and may be called from the
+ *              interrupt service routines of the driver.
+ *
+ * @addtogroup  s2pi_trace
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_s2pi.h"
+#include <stdint.h>
+
+/*!***************************************************************************
+ * @brief   The number of recorded transfer frames; must be a power of two.
+ *****************************************************************************/
+#ifndef S2PI_TRACE_LENGTH
+#define S2PI_TRACE_LENGTH 32U
+#endif
+
+/*!***************************************************************************
+ * @brief   The maximum S2PI slave identifier to count frames for.
+ *****************************************************************************/
+#ifndef S2PI_TRACE_SLAVE_COUNT
+#define S2PI_TRACE_SLAVE_COUNT 6
+#endif
+
+/*! A recorded S2PI transfer frame. */
+typedef struct s2pi_trace_record_t
+{
+    /*! The start time in high resolution clock ticks (lower 32 bits). */
+    uint32_t Start;
+
+    /*! The duration in high resolution clock ticks; 0 while ongoing. */
+    uint32_t Duration;
+
+    /*! The number of transferred bytes. */
+    uint16_t Length;
+
+    /*! The completion status; #STATUS_BUSY while ongoing. */
+    int16_t Status;
+
+    /*! The S2PI slave. */
+    uint8_t Slave;
+
+} s2pi_trace_record_t;
+
+/*! The S2PI transfer counters of a single slave. */
+typedef struct s2pi_trace_stats_t
+{
+    /*! The number of completed measurement frames, see #S2PITrace_MarkFrame. */
+    uint32_t Frames;
+
+    /*! The number of transfers within all completed measurement frames. */
+    uint32_t FrameTransfers;
+
+    /*! The number of transfers within the last measurement frame. */
+    uint16_t LastPerFrame;
+
+    /*! The minimum number of transfers per measurement frame. */
+    uint16_t MinPerFrame;
+
+    /*! The maximum number of transfers per measurement frame. */
+    uint16_t MaxPerFrame;
+
+    /*! The number of transfers within the current measurement frame. */
+    uint16_t Current;
+
+    /*! The number of transfers that completed with an error. */
+    uint32_t Errors;
+
+} s2pi_trace_stats_t;
+
+/*!***************************************************************************
+ * @brief   Removes all records and resets the counters.
+ *****************************************************************************/
+void S2PITrace_Reset(void);
+
+/*!***************************************************************************
+ * @brief   Records the start of a transfer frame.
+ * @param   slave The S2PI slave.
+ * @param   length The number of bytes to be transferred.
+ * @return  Returns the identifier of the record that is passed to
+ *          #S2PITrace_End.
+ *****************************************************************************/
+uint32_t S2PITrace_Begin(s2pi_slave_t slave, size_t length);
+
+/*!***************************************************************************
+ * @brief   Records the completion of a transfer frame.
+ * @details The record may have been overwritten by newer frames already;
+ *          only the counters are updated in that case.
+ * @param   id The identifier returned by #S2PITrace_Begin.
+ * @param   status The completion status of the transfer.
+ *****************************************************************************/
+void S2PITrace_End(uint32_t id, status_t status);
+
+/*!***************************************************************************
+ * @brief   Marks the end of a measurement frame of a slave.
+ * @details The transfers of the slave since the previous mark are counted
+ *          as a single measurement frame.
+ * @param   slave The S2PI slave.
+ *****************************************************************************/
+void S2PITrace_MarkFrame(s2pi_slave_t slave);
+
+/*!***************************************************************************
+ * @brief   Gets the transfer counters of a specified slave.
+ * @param   slave The S2PI slave.
+ * @param   stats The counters.
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_S2PI_INVALID_SLAVE if no counters are kept for the slave.
+ *****************************************************************************/
+status_t S2PITrace_GetStats(s2pi_slave_t slave, s2pi_trace_stats_t * stats);
+
+/*!***************************************************************************
+ * @brief   Copies the latest records, oldest first.
+ * @param   records The buffer for the records.
+ * @param   count The maximum number of records to copy.
+ * @return  Returns the number of copied records.
+ *****************************************************************************/
+uint32_t S2PITrace_GetRecords(s2pi_trace_record_t * records, uint32_t count);
+
+/*! @} */
+#endif /* S2PI_TRACE_H */
@@ -0,0 +1,269 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a multiplexer for periodic timer intervals.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+
+/*******************************************************************************
+ * Include Files
+ ******************************************************************************/
+#include "timer_mux.h"
+
+#include "platform/argus_irq.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*! An entry of the timer interval queue. */
+typedef struct timer_interval_t
+{
+    /*! The callback parameter; identifies the interval. */
+    void * Param;
+
+    /*! The individual callback function; 0 for the common callback. */
+    timer_cb_t Callback;
+
+    /*! The callback interval in microseconds. */
+    uint32_t Interval;
+
+    /*! The next deadline in microseconds on the lifetime counter time scale. */
+    uint32_t Deadline;
+
+} timer_interval_t;
+
+/******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*! The interval queue, sorted by ascending deadlines. */
+static timer_interval_t myQueue[TIMER_MUX_INTERVAL_COUNT];
+
+/*! The number of active intervals in the queue. */
+static volatile uint32_t myCount = 0;
+
+/*! A pointer to the ISR function to be called when an interval has elapsed. */
+static timer_cb_t myISR = 0;
+
+/*! The function that starts the hardware timer. */
+static timer_mux_start_t myStart = 0;
+
+/*******************************************************************************
+ * Code
+ *******************************************************************************/
+
+/*!***************************************************************************
+ * @brief   Returns the current lifetime counter value in microseconds.
+ * @details The value wraps around every 2^32 microseconds which is handled
+ *          by the signed difference in #IsDue.
+ *****************************************************************************/
+static inline uint32_t GetNowUSec(void)
+{
+    uint32_t hct, lct;
+    Timer_GetCounterValue(&hct, &lct);
+    return hct * 1000000U + lct;
+}
+
+/*! Checks if a deadline \p t has been reached at time \p now. */
+static inline bool IsDue(uint32_t t, uint32_t now)
+{
+    return (int32_t)(now - t) >= 0;
+}
+
+/*! Finds the queue index of the interval with parameter \p param or -1. */
+static int32_t FindInterval(void const * param)
+{
+    for (uint32_t i = 0; i < myCount; ++i)
+    {
+        if (myQueue[i].Param == param) return (int32_t)i;
+    }
+    return -1;
+}
+
+/*! Removes the entry at queue index \p idx. */
+static void RemoveInterval(uint32_t idx)
+{
+    assert(idx < myCount);
+    for (uint32_t i = idx + 1; i < myCount; ++i)
+    {
+        myQueue[i - 1] = myQueue[i];
+    }
+    myCount--;
+}
+
+/*! Inserts a new entry into the queue, keeping the deadline order. */
+static void InsertInterval(timer_interval_t const * entry)
+{
+    assert(myCount < TIMER_MUX_INTERVAL_COUNT);
+
+    /* Use the signed difference to be robust against counter wrap-around. */
+    uint32_t i = myCount;
+    while (i > 0 && (int32_t)(myQueue[i - 1].Deadline - entry->Deadline) > 0)
+    {
+        myQueue[i] = myQueue[i - 1];
+        i--;
+    }
+    myQueue[i] = *entry;
+    myCount++;
+}
+
+/*! Starts the hardware timer for the earliest deadline in the queue. */
+static void StartNext(uint32_t now)
+{
+    if (myStart == 0) return;
+
+    if (myCount == 0)
+    {
+        myStart(0);
+    }
+    else
+    {
+        /* Overdue deadlines are triggered as soon as possible. */
+        uint32_t dt = myQueue[0].Deadline - now;
+        if ((int32_t)dt <= 0) dt = 1U;
+        myStart(dt);
+    }
+}
+
+void TimerMux_Init(timer_mux_start_t start)
+{
+    IRQ_LOCK();
+    myStart = start;
+    myISR = 0;
+    myCount = 0;
+    if (myStart) myStart(0);
+    IRQ_UNLOCK();
+}
+
+status_t TimerMux_SetCallback(timer_cb_t f)
+{
+    IRQ_LOCK();
+    if (f == 0)
+    {
+        /* Remove all intervals that use the common callback. */
+        uint32_t i = myCount;
+        while (i-- > 0)
+        {
+            if (myQueue[i].Callback == 0) RemoveInterval(i);
+        }
+        StartNext(GetNowUSec());
+    }
+    myISR = f;
+    IRQ_UNLOCK();
+    return STATUS_OK;
+}
+
+status_t TimerMux_SetInterval(uint32_t dt_microseconds, void * param)
+{
+    assert(!(dt_microseconds != 0 && myISR == 0)); // Timer must not be enabled without IRS
+    return TimerMux_SetIntervalCallback(dt_microseconds, param, 0);
+}
+
+status_t TimerMux_SetIntervalCallback(uint32_t dt_microseconds, void * param, timer_cb_t f)
+{
+    assert(dt_microseconds == 0 || dt_microseconds > 100); // check reasonable minimum interval
+
+    status_t status = STATUS_OK;
+
+    IRQ_LOCK();
+    const int32_t idx = FindInterval(param);
+
+    if (idx >= 0 && myQueue[idx].Interval == dt_microseconds && myQueue[idx].Callback == f)
+    {
+        /* Nothing to do, same interval is already set. */
+        IRQ_UNLOCK();
+        return STATUS_OK;
+    }
+
+    if (idx >= 0) RemoveInterval((uint32_t)idx);
+
+    const uint32_t now = GetNowUSec();
+
+    if (dt_microseconds)
+    {
+        if (myCount < TIMER_MUX_INTERVAL_COUNT)
+        {
+            const timer_interval_t entry = {
+                .Param = param,
+                .Callback = f,
+                .Interval = dt_microseconds,
+                .Deadline = now + dt_microseconds
+            };
+            InsertInterval(&entry);
+        }
+        else
+        {
+            status = ERROR_FAIL;
+        }
+    }
+
+    StartNext(now);
+    IRQ_UNLOCK();
+
+    return status;
+}
+
+void TimerMux_Handler(void)
+{
+    IRQ_LOCK();
+    uint32_t now = GetNowUSec();
+
+    while (myCount > 0 && IsDue(myQueue[0].Deadline, now))
+    {
+        timer_interval_t entry = myQueue[0];
+        RemoveInterval(0);
+
+        /* Advance on the absolute time scale to avoid accumulation of the
+         * interrupt latency. Skip events that have been missed entirely. */
+        entry.Deadline += entry.Interval;
+        if (IsDue(entry.Deadline, now)) entry.Deadline = now + entry.Interval;
+        InsertInterval(&entry);
+
+        /* The callback may modify the queue via TimerMux_SetInterval. */
+        timer_cb_t isr = entry.Callback ? entry.Callback : myISR;
+        IRQ_UNLOCK();
+        if (isr) isr(entry.Param);
+        IRQ_LOCK();
+
+        now = GetNowUSec();
+    }
+
+    StartNext(now);
+    IRQ_UNLOCK();
+}
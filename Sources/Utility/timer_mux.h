@@ -0,0 +1,170 @@
+/*************************************************************************//**
+ * @file
+ * @brief       This file is part of the AFBR-S50 API.
+ * @details     This file provides a multiplexer for periodic timer intervals.
+ *
+ * @copyright
+ *
+ * Copyright (c) 2023, Broadcom Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *****************************************************************************/
+
+#ifndef TIMER_MUX_H
+#define TIMER_MUX_H
+
+/*!***************************************************************************
+ * @defgroup    timer_mux Timer Interval Multiplexer
+ * @ingroup     platform
+ * @brief       Multiple Periodic Intervals on a single Hardware Timer
+ * @details     Implements the multiple interval feature of the #argus_timer
+ *              interface on top of a single hardware timer.
+ *
+ *              All active intervals are kept in a small queue that is sorted
+ *              by their next deadline. The hardware timer is always programmed
+ *              to elapse at the earliest deadline. Whenever it elapses, the
+ *              platform calls #TimerMux_Handler which invokes the callback for
+ *              all due intervals, advances their deadlines by their period and
+ *              reprograms the hardware timer for the next deadline.
+ *
+ *              The deadlines are kept on the absolute time scale of the
+ *              lifetime counter (#Timer_GetCounterValue). Thus, the interrupt
+ *              latency does not accumulate over time. If an interval has
+ *              missed more than a single deadline (e.g. due to a blocked
+ *              interrupt), the missed events are skipped.
+ *
+ *              The platform layer needs to provide a function to start the
+ *              hardware timer for a single interval (see #timer_mux_start_t).
+ *              Note that the hardware is allowed to elapse before the requested
+ *              time, e.g. if the requested interval exceeds its maximum
+ *              period. Such early events are ignored by the handler.
+ *
+ * @addtogroup  timer_mux
+ * @{
+ *****************************************************************************/
+
+#include "platform/argus_timer.h"
+
+/*!***************************************************************************
+ * @brief   The maximum number of concurrent timer intervals.
+ * @details Must be at least the number of AFBR-S50 devices that are
+ *          served by the platform (e.g. EXPLORER_DEVICE_COUNT).
+ *****************************************************************************/
+#ifndef TIMER_MUX_INTERVAL_COUNT
+#define TIMER_MUX_INTERVAL_COUNT 4U
+#endif
+
+/*!***************************************************************************
+ * @brief   The function type to start the hardware timer.
+ *
+ * @details Starts or restarts the hardware timer such that it elapses after
+ *          \p dt_microseconds and invokes #TimerMux_Handler from its interrupt
+ *          service routine. Passing 0 stops the hardware timer.
+ *
+ *          The function is called with interrupts locked.
+ *
+ * @param   dt_microseconds The time until the next timer event in
+ *                          microseconds; 0 stops the timer.
+ *****************************************************************************/
+typedef void (*timer_mux_start_t)(uint32_t dt_microseconds);
+
+/*!***************************************************************************
+ * @brief   Initializes the timer interval multiplexer.
+ *
+ * @details Removes all intervals and the callback and installs the hardware
+ *          timer start function.
+ *
+ * @param   start The function that starts the hardware timer.
+ *****************************************************************************/
+void TimerMux_Init(timer_mux_start_t start);
+
+/*!***************************************************************************
+ * @brief   Installs the periodic timer callback function.
+ *
+ * @details See #Timer_SetCallback. Passing a zero-pointer also removes all
+ *          active intervals that use this callback.
+ *
+ * @param   f The timer callback function.
+ *
+ * @return  Returns the \link #status_t status\endlink (#STATUS_OK on success).
+ *****************************************************************************/
+status_t TimerMux_SetCallback(timer_cb_t f);
+
+/*!***************************************************************************
+ * @brief   Sets the timer interval for a specified callback parameter.
+ *
+ * @details See #Timer_SetInterval. The interval is identified by the \p param
+ *          pointer. A new interval is added to the queue, an existing one is
+ *          restarted with the new interval and 0 removes it. The first event
+ *          occurs after the specified interval. If the same interval is
+ *          already set, nothing happens.
+ *
+ * @param   dt_microseconds The callback interval in microseconds.
+ * @param   param An abstract parameter to be passed to the callback. This is
+ *                also the identifier of the given interval.
+ *
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_FAIL if already #TIMER_MUX_INTERVAL_COUNT intervals
+ *            are active.
+ *****************************************************************************/
+status_t TimerMux_SetInterval(uint32_t dt_microseconds, void * param);
+
+/*!***************************************************************************
+ * @brief   Sets a timer interval with an individual callback function.
+ *
+ * @details Same as #TimerMux_SetInterval but the interval invokes the given
+ *          callback \p f instead of the one installed via
+ *          #TimerMux_SetCallback. This allows the platform or application
+ *          to schedule own intervals on the same hardware timer without
+ *          interfering with the intervals of the AFBR-S50 API. Such intervals
+ *          are not removed by #TimerMux_SetCallback.
+ *
+ * @param   dt_microseconds The callback interval in microseconds.
+ * @param   param An abstract parameter to be passed to the callback. This is
+ *                also the identifier of the given interval.
+ * @param   f The callback function for this interval.
+ *
+ * @return  Returns the \link #status_t status\endlink:
+ *          - #STATUS_OK on success.
+ *          - #ERROR_FAIL if already #TIMER_MUX_INTERVAL_COUNT intervals
+ *            are active.
+ *****************************************************************************/
+status_t TimerMux_SetIntervalCallback(uint32_t dt_microseconds, void * param, timer_cb_t f);
+
+/*!***************************************************************************
+ * @brief   The timer event handler.
+ *
+ * @details Must be called by the platform from the hardware timer interrupt
+ *          service routine. Invokes the callback for all due intervals and
+ *          restarts the hardware timer for the next deadline.
+ *****************************************************************************/
+void TimerMux_Handler(void);
+
+/*! @} */
+#endif /* TIMER_MUX_H */